@@ -0,0 +1,533 @@
+// Command benchreport runs the benchmark suite under fixed conditions, stores
+// the results as JSON and regenerates BENCHMARK_RESULTS.md from them, with
+// the change of every benchmark against a checked-in baseline.
+//
+// Run it from the repository root:
+//
+//	go run ./bench/cmd/benchreport                  # run, compare, write the report
+//	go run ./bench/cmd/benchreport -update-baseline # also replace the baseline
+//	go run ./bench/cmd/benchreport -from results.json
+//	go run ./bench/cmd/benchreport -bench Parallel -pkgs ./bench -cpu 1,2,4,8 \
+//		-baseline "" -out bench/scaling.json -report BENCHMARK_SCALING.md
+//
+// The benchmarks run with GOMAXPROCS fixed by -cpu and, on Linux when
+// taskset is available, pinned to as many CPUs as the largest GOMAXPROCS
+// starting at -pin, so that runs on the same machine are comparable. With
+// more than one GOMAXPROCS the report gets a table of the throughput at each. Each benchmark is run -count times; the
+// report shows the median and the largest deviation from it, and compares
+// against the baseline with a two-sided Mann-Whitney U test as benchstat
+// does. Changes with p above -alpha are reported as ~.
+package main
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/json"
+	"flag"
+	"fmt"
+	"io"
+	"log"
+	"math"
+	"os"
+	"os/exec"
+	"runtime"
+	"sort"
+	"strconv"
+	"strings"
+	"time"
+)
+
+// defaultBench selects the signature operations and the primitive suite
+const defaultBench = "^Benchmark(ECDSASign|ECDSAVerify|SchnorrSign|SchnorrVerify|ECPubkeyCreate|ECDHX|Internal)$"
+
+// Run is one invocation of the suite, as stored in the JSON files
+type Run struct {
+	Date       string      `json:"date"`
+	Commit     string      `json:"commit,omitempty"`
+	GoVersion  string      `json:"go_version"`
+	GOOS       string      `json:"goos"`
+	GOARCH     string      `json:"goarch"`
+	CPU        string      `json:"cpu"`
+	CPUs       []int       `json:"cpus"`
+	Pinned     string      `json:"pinned,omitempty"`
+	Args       []string    `json:"args"`
+	Benchmarks []Benchmark `json:"benchmarks"`
+}
+
+// Benchmark holds every sample of one benchmark at one GOMAXPROCS, keyed by
+// unit
+type Benchmark struct {
+	Name    string               `json:"name"`
+	Procs   int                  `json:"procs"`
+	Metrics map[string][]float64 `json:"metrics"`
+}
+
+func (b *Benchmark) key() string {
+	return b.Name + "-" + strconv.Itoa(b.Procs)
+}
+
+func main() {
+	var (
+		bench     = flag.String("bench", defaultBench, "benchmarks to run, as for go test -bench")
+		pkgs      = flag.String("pkgs", ".", "space separated packages to benchmark")
+		count     = flag.Int("count", 6, "samples per benchmark")
+		benchtime = flag.String("benchtime", "200ms", "time per sample, as for go test -benchtime")
+		cpu       = flag.String("cpu", "1", "comma separated GOMAXPROCS values, as for go test -cpu")
+		pin       = flag.Int("pin", 0, "first CPU to pin the benchmarks to with taskset, -1 to not pin")
+		out       = flag.String("out", "bench/results.json", "where to store the results")
+		from      = flag.String("from", "", "render the report from this results file instead of running")
+		baseline  = flag.String("baseline", "bench/baseline.json", "results to compare against, empty for none")
+		update    = flag.Bool("update-baseline", false, "store the results as the new baseline")
+		report    = flag.String("report", "BENCHMARK_RESULTS.md", "markdown report to write")
+		alpha     = flag.Float64("alpha", 0.05, "significance level for reporting a change")
+	)
+	flag.Parse()
+	log.SetFlags(0)
+
+	var cpus []int
+	for _, f := range strings.Split(*cpu, ",") {
+		n, err := strconv.Atoi(strings.TrimSpace(f))
+		if err != nil || n < 1 {
+			log.Fatalf("invalid -cpu value %q", f)
+		}
+		cpus = append(cpus, n)
+	}
+
+	var cur *Run
+	var err error
+	if *from != "" {
+		cur, err = readRun(*from)
+	} else {
+		cur, err = runSuite(*bench, strings.Fields(*pkgs), *count, *benchtime, cpus, *pin)
+		if err == nil {
+			err = writeRun(*out, cur)
+		}
+	}
+	if err != nil {
+		log.Fatal(err)
+	}
+
+	if *baseline == "" && *update {
+		log.Fatal("-update-baseline needs -baseline")
+	}
+	var base *Run
+	if !*update && *baseline != "" {
+		if base, err = readRun(*baseline); err != nil && !os.IsNotExist(err) {
+			log.Fatal(err)
+		}
+	}
+	if *update {
+		if err := writeRun(*baseline, cur); err != nil {
+			log.Fatal(err)
+		}
+	}
+
+	var buf bytes.Buffer
+	writeReport(&buf, cur, base, *baseline, *alpha)
+	if err := os.WriteFile(*report, buf.Bytes(), 0o644); err != nil {
+		log.Fatal(err)
+	}
+}
+
+// runSuite runs the benchmarks and parses the output of go test
+func runSuite(bench string, pkgs []string, count int, benchtime string, cpus []int, pin int) (*Run, error) {
+	maxProcs := 0
+	for _, n := range cpus {
+		maxProcs = max(maxProcs, n)
+	}
+	if maxProcs > runtime.NumCPU() {
+		log.Printf("GOMAXPROCS %d is more than the %d CPUs of this machine", maxProcs, runtime.NumCPU())
+	}
+
+	args := []string{"test", "-run", "^$", "-bench", bench, "-benchmem",
+		"-count", strconv.Itoa(count), "-benchtime", benchtime, "-cpu", joinInts(cpus)}
+	args = append(args, pkgs...)
+
+	name, cmdArgs := "go", args
+	pinned := ""
+	if pin >= 0 && runtime.GOOS == "linux" {
+		if taskset, err := exec.LookPath("taskset"); err == nil {
+			set := strconv.Itoa(pin)
+			if maxProcs > 1 {
+				set += "-" + strconv.Itoa(pin+maxProcs-1)
+			}
+			name, cmdArgs = taskset, append([]string{"-c", set, "go"}, args...)
+			pinned = "cpus " + set
+		}
+	}
+	if pinned == "" {
+		log.Print("benchmarks are not pinned to a CPU")
+	}
+
+	cmd := exec.Command(name, cmdArgs...)
+	cmd.Env = append(os.Environ(), "GOMAXPROCS="+strconv.Itoa(maxProcs))
+	cmd.Stderr = os.Stderr
+	var stdout bytes.Buffer
+	cmd.Stdout = io.MultiWriter(&stdout, os.Stderr)
+	log.Printf("%s %s", name, strings.Join(cmdArgs, " "))
+	if err := cmd.Run(); err != nil {
+		return nil, fmt.Errorf("go test: %w", err)
+	}
+
+	r := &Run{
+		Date:      time.Now().UTC().Format(time.RFC3339),
+		Commit:    gitOutput("rev-parse", "--short", "HEAD"),
+		GoVersion: goOutput("env", "GOVERSION"),
+		CPUs:      cpus,
+		Pinned:    pinned,
+		Args:      args,
+	}
+	parseBenchOutput(r, &stdout)
+	if len(r.Benchmarks) == 0 {
+		return nil, fmt.Errorf("no benchmarks matched %q", bench)
+	}
+	return r, nil
+}
+
+// parseBenchOutput reads the text output of go test -bench into r. The goos,
+// goarch and cpu header lines fill in the environment.
+func parseBenchOutput(r *Run, out io.Reader) {
+	index := map[string]int{}
+	sc := bufio.NewScanner(out)
+	for sc.Scan() {
+		line := sc.Text()
+		if k, v, ok := strings.Cut(line, ": "); ok {
+			switch k {
+			case "goos":
+				r.GOOS = v
+			case "goarch":
+				r.GOARCH = v
+			case "cpu":
+				r.CPU = v
+			}
+			continue
+		}
+		f := strings.Fields(line)
+		// BenchmarkName-N iterations value unit [value unit]...
+		if len(f) < 4 || !strings.HasPrefix(f[0], "Benchmark") || len(f)%2 != 0 {
+			continue
+		}
+		if _, err := strconv.Atoi(f[1]); err != nil {
+			continue
+		}
+		// go test appends -GOMAXPROCS to the name unless it is 1
+		b := Benchmark{Name: f[0], Procs: 1}
+		if i := strings.LastIndexByte(b.Name, '-'); i > 0 {
+			if n, err := strconv.Atoi(b.Name[i+1:]); err == nil {
+				b.Name, b.Procs = b.Name[:i], n
+			}
+		}
+		i, ok := index[b.key()]
+		if !ok {
+			i = len(r.Benchmarks)
+			index[b.key()] = i
+			b.Metrics = map[string][]float64{}
+			r.Benchmarks = append(r.Benchmarks, b)
+		}
+		for j := 2; j+1 < len(f); j += 2 {
+			v, err := strconv.ParseFloat(f[j], 64)
+			if err != nil {
+				continue
+			}
+			r.Benchmarks[i].Metrics[f[j+1]] = append(r.Benchmarks[i].Metrics[f[j+1]], v)
+		}
+	}
+}
+
+func joinInts(v []int) string {
+	s := make([]string, len(v))
+	for i, n := range v {
+		s[i] = strconv.Itoa(n)
+	}
+	return strings.Join(s, ",")
+}
+
+func gitOutput(args ...string) string {
+	out, err := exec.Command("git", args...).Output()
+	if err != nil {
+		return ""
+	}
+	return strings.TrimSpace(string(out))
+}
+
+func goOutput(args ...string) string {
+	out, err := exec.Command("go", args...).Output()
+	if err != nil {
+		return runtime.Version()
+	}
+	return strings.TrimSpace(string(out))
+}
+
+func readRun(path string) (*Run, error) {
+	data, err := os.ReadFile(path)
+	if err != nil {
+		return nil, err
+	}
+	r := new(Run)
+	if err := json.Unmarshal(data, r); err != nil {
+		return nil, fmt.Errorf("%s: %w", path, err)
+	}
+	return r, nil
+}
+
+func writeRun(path string, r *Run) error {
+	data, err := json.MarshalIndent(r, "", "\t")
+	if err != nil {
+		return err
+	}
+	return os.WriteFile(path, append(data, '\n'), 0o644)
+}
+
+// writeReport renders cur, compared with base if it is not nil, as markdown
+func writeReport(w io.Writer, cur, base *Run, basePath string, alpha float64) {
+	fmt.Fprintf(w, "# Benchmark Results\n\n")
+	fmt.Fprintf(w, "Generated by `go run ./bench/cmd/benchreport`; do not edit by hand.\n\n")
+
+	fmt.Fprintf(w, "| | This run |")
+	if base != nil {
+		fmt.Fprintf(w, " Baseline (`%s`) |", basePath)
+	}
+	fmt.Fprintf(w, "\n|---|---|")
+	if base != nil {
+		fmt.Fprintf(w, "---|")
+	}
+	fmt.Fprintln(w)
+	cell := strings.NewReplacer("|", `\|`).Replace
+	row := func(label string, get func(r *Run) string) {
+		fmt.Fprintf(w, "| %s | %s |", label, cell(get(cur)))
+		if base != nil {
+			fmt.Fprintf(w, " %s |", cell(get(base)))
+		}
+		fmt.Fprintln(w)
+	}
+	row("Date", func(r *Run) string { return r.Date })
+	row("Commit", func(r *Run) string { return r.Commit })
+	row("Go", func(r *Run) string { return r.GoVersion })
+	row("Platform", func(r *Run) string { return r.GOOS + "/" + r.GOARCH })
+	row("CPU", func(r *Run) string { return r.CPU })
+	row("GOMAXPROCS", func(r *Run) string { return joinInts(r.CPUs) })
+	row("Pinned", func(r *Run) string {
+		if r.Pinned == "" {
+			return "no"
+		}
+		return r.Pinned
+	})
+	row("Command", func(r *Run) string { return "`go " + strings.Join(r.Args, " ") + "`" })
+	fmt.Fprintln(w)
+
+	if base != nil && (base.CPU != cur.CPU || joinInts(base.CPUs) != joinInts(cur.CPUs)) {
+		fmt.Fprintf(w, "**The baseline was recorded on a different CPU or GOMAXPROCS; the deltas are not meaningful.**\n\n")
+	}
+
+	fmt.Fprintf(w, "Values are the median of the samples ± the largest deviation from it.")
+	if base != nil {
+		fmt.Fprintf(w, " The delta is against the baseline median; ~ marks changes that are not significant (Mann-Whitney U, p > %g).", alpha)
+	}
+	fmt.Fprintf(w, "\n")
+
+	baseBy := map[string]*Benchmark{}
+	if base != nil {
+		for i := range base.Benchmarks {
+			baseBy[base.Benchmarks[i].key()] = &base.Benchmarks[i]
+		}
+	}
+
+	// One table per top-level benchmark function, in the order they ran
+	var group string
+	for i := range cur.Benchmarks {
+		b := &cur.Benchmarks[i]
+		top, sub, _ := strings.Cut(strings.TrimPrefix(b.Name, "Benchmark"), "/")
+		if top != group {
+			group = top
+			fmt.Fprintf(w, "\n## %s\n\n", top)
+			fmt.Fprintf(w, "| Benchmark | time/op |")
+			if base != nil {
+				fmt.Fprintf(w, " Δ time |")
+			}
+			fmt.Fprintf(w, " B/op | allocs/op |\n|---|--:|")
+			if base != nil {
+				fmt.Fprintf(w, "--:|")
+			}
+			fmt.Fprintf(w, "--:|--:|\n")
+		}
+		if sub == "" {
+			sub = top
+		}
+		label := "`" + sub + "`"
+		if len(cur.CPUs) > 1 {
+			label += fmt.Sprintf(" (%d)", b.Procs)
+		}
+		fmt.Fprintf(w, "| %s | %s |", label, summary(b.Metrics["ns/op"], formatTime))
+		if base != nil {
+			fmt.Fprintf(w, " %s |", delta(b, baseBy[b.key()], "ns/op", alpha))
+		}
+		fmt.Fprintf(w, " %s | %s |\n", median(b.Metrics["B/op"], formatCount), median(b.Metrics["allocs/op"], formatCount))
+	}
+
+	if len(cur.CPUs) > 1 {
+		writeScaling(w, cur)
+	}
+}
+
+// writeScaling renders the throughput of every benchmark at each GOMAXPROCS
+// of r, with the speedup over the first one
+func writeScaling(w io.Writer, r *Run) {
+	fmt.Fprintf(w, "\n## Scaling\n\n")
+	fmt.Fprintf(w, "Operations per second at each GOMAXPROCS, with the speedup over GOMAXPROCS=%d.\n\n", r.CPUs[0])
+	fmt.Fprintf(w, "| Benchmark |")
+	for _, n := range r.CPUs {
+		fmt.Fprintf(w, " %d |", n)
+	}
+	fmt.Fprintf(w, "\n|---|%s\n", strings.Repeat("--:|", len(r.CPUs)))
+
+	by := map[string]*Benchmark{}
+	var names []string
+	for i := range r.Benchmarks {
+		b := &r.Benchmarks[i]
+		if _, ok := by[b.Name+"-"+strconv.Itoa(r.CPUs[0])]; !ok && b.Procs == r.CPUs[0] {
+			names = append(names, b.Name)
+		}
+		by[b.key()] = b
+	}
+	for _, name := range names {
+		fmt.Fprintf(w, "| `%s` |", strings.TrimPrefix(name, "Benchmark"))
+		first := 0.0
+		for _, n := range r.CPUs {
+			b, ok := by[name+"-"+strconv.Itoa(n)]
+			if !ok || len(b.Metrics["ns/op"]) == 0 {
+				fmt.Fprintf(w, " |")
+				continue
+			}
+			ops := 1e9 / medianOf(b.Metrics["ns/op"])
+			if first == 0 {
+				first = ops
+			}
+			fmt.Fprintf(w, " %s (%.2f×) |", formatRate(ops), ops/first)
+		}
+		fmt.Fprintln(w)
+	}
+}
+
+func summary(v []float64, format func(float64) string) string {
+	if len(v) == 0 {
+		return ""
+	}
+	m := medianOf(v)
+	dev := 0.0
+	for _, x := range v {
+		dev = math.Max(dev, math.Abs(x-m))
+	}
+	if m == 0 {
+		return format(m)
+	}
+	return fmt.Sprintf("%s ± %.0f%%", format(m), 100*dev/m)
+}
+
+func median(v []float64, format func(float64) string) string {
+	if len(v) == 0 {
+		return ""
+	}
+	return format(medianOf(v))
+}
+
+// delta formats the change of the median of unit from base to cur, with the
+// p-value of the difference
+func delta(cur, base *Benchmark, unit string, alpha float64) string {
+	if base == nil || len(base.Metrics[unit]) == 0 {
+		return "new"
+	}
+	x, y := base.Metrics[unit], cur.Metrics[unit]
+	p := mannWhitneyP(x, y)
+	if p > alpha {
+		return fmt.Sprintf("~ (p=%.3f)", p)
+	}
+	mx, my := medianOf(x), medianOf(y)
+	return fmt.Sprintf("%+.1f%% (p=%.3f)", 100*(my-mx)/mx, p)
+}
+
+func formatTime(ns float64) string {
+	switch {
+	case ns >= 1e6:
+		return fmt.Sprintf("%.2f ms", ns/1e6)
+	case ns >= 1e3:
+		return fmt.Sprintf("%.2f µs", ns/1e3)
+	}
+	return fmt.Sprintf("%.1f ns", ns)
+}
+
+func formatRate(ops float64) string {
+	switch {
+	case ops >= 1e6:
+		return fmt.Sprintf("%.2fM", ops/1e6)
+	case ops >= 1e3:
+		return fmt.Sprintf("%.1fk", ops/1e3)
+	}
+	return fmt.Sprintf("%.0f", ops)
+}
+
+func formatCount(v float64) string {
+	return strconv.FormatFloat(v, 'f', -1, 64)
+}
+
+func medianOf(v []float64) float64 {
+	s := append([]float64(nil), v...)
+	sort.Float64s(s)
+	n := len(s)
+	if n%2 == 1 {
+		return s[n/2]
+	}
+	return (s[n/2-1] + s[n/2]) / 2
+}
+
+// mannWhitneyP returns the two-sided p-value of the Mann-Whitney U test of x
+// against y, using the normal approximation with tie and continuity
+// corrections
+func mannWhitneyP(x, y []float64) float64 {
+	n1, n2 := float64(len(x)), float64(len(y))
+	if n1 == 0 || n2 == 0 {
+		return 1
+	}
+	type obs struct {
+		v float64
+		x bool
+	}
+	all := make([]obs, 0, len(x)+len(y))
+	for _, v := range x {
+		all = append(all, obs{v, true})
+	}
+	for _, v := range y {
+		all = append(all, obs{v, false})
+	}
+	sort.Slice(all, func(i, j int) bool { return all[i].v < all[j].v })
+
+	// Rank sum of x with ties given their average rank
+	var rx, ties float64
+	for i := 0; i < len(all); {
+		j := i
+		for j < len(all) && all[j].v == all[i].v {
+			j++
+		}
+		rank := float64(i+j+1) / 2
+		for k := i; k < j; k++ {
+			if all[k].x {
+				rx += rank
+			}
+		}
+		t := float64(j - i)
+		ties += t*t*t - t
+		i = j
+	}
+
+	u := rx - n1*(n1+1)/2
+	mu := n1 * n2 / 2
+	n := n1 + n2
+	sigma := math.Sqrt(n1 * n2 / 12 * ((n + 1) - ties/(n*(n-1))))
+	if sigma == 0 {
+		return 1
+	}
+	z := (math.Abs(u-mu) - 0.5) / sigma
+	if z < 0 {
+		z = 0
+	}
+	return math.Erfc(z / math.Sqrt2)
+}
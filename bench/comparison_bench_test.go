@@ -107,6 +107,7 @@ func BenchmarkSign(b *testing.B) {
 	}
 
 	b.ResetTimer()
+	b.ReportAllocs()
 	for i := 0; i < b.N; i++ {
 		if compBenchSignerP256K1 == nil {
 			initComparisonBenchData()
@@ -161,3 +162,66 @@ func BenchmarkECDH(b *testing.B) {
 		}
 	}
 }
+
+// BenchmarkParallel runs the signer operations from GOMAXPROCS goroutines at
+// once, with the same work per operation as the benchmarks above. Run it
+// with -cpu 1,2,4,... (or make bench-scaling) to see where throughput stops
+// growing with the core count.
+func BenchmarkParallel(b *testing.B) {
+	if compBenchSignerP256K1 == nil || compBenchSigP256K1 == nil {
+		initComparisonBenchData()
+	}
+
+	b.Run("PubkeyDerivation", func(b *testing.B) {
+		b.ReportAllocs()
+		b.RunParallel(func(pb *testing.PB) {
+			for pb.Next() {
+				s := signer.NewP256K1Signer()
+				if err := s.InitSec(benchSeckey); err != nil {
+					b.Errorf("failed to create signer: %v", err)
+					return
+				}
+				_ = s.Pub()
+			}
+		})
+	})
+	b.Run("Sign", func(b *testing.B) {
+		b.ReportAllocs()
+		b.RunParallel(func(pb *testing.PB) {
+			for pb.Next() {
+				if _, err := compBenchSignerP256K1.Sign(benchMsghash); err != nil {
+					b.Errorf("failed to sign: %v", err)
+					return
+				}
+			}
+		})
+	})
+	b.Run("Verify", func(b *testing.B) {
+		b.ReportAllocs()
+		b.RunParallel(func(pb *testing.PB) {
+			for pb.Next() {
+				verifier := signer.NewP256K1Signer()
+				if err := verifier.InitPub(compBenchSignerP256K1.Pub()); err != nil {
+					b.Errorf("failed to create verifier: %v", err)
+					return
+				}
+				valid, err := verifier.Verify(benchMsghash, compBenchSigP256K1)
+				if err != nil || !valid {
+					b.Errorf("verification failed: %v", err)
+					return
+				}
+			}
+		})
+	})
+	b.Run("ECDH", func(b *testing.B) {
+		b.ReportAllocs()
+		b.RunParallel(func(pb *testing.PB) {
+			for pb.Next() {
+				if _, err := compBenchSignerP256K1.ECDH(compBenchSignerP256K12.Pub()); err != nil {
+					b.Errorf("ECDH failed: %v", err)
+					return
+				}
+			}
+		})
+	})
+}
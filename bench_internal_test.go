@@ -0,0 +1,309 @@
+package p256k1
+
+import (
+	"testing"
+)
+
+// BenchmarkInternal times the arithmetic primitives one at a time, after
+// src/bench_internal.c. Sub-benchmarks are named layer/primitive/variant, so
+// a single layer or primitive can be selected with -bench, and the output is
+// the standard benchmark format read by benchstat; add -json for a JSON
+// event stream. Implementations that are picked at build time (the assembly
+// field multiply, the IFMA lanes) are timed next to their generic fallbacks
+// so that both can be compared on the same machine.
+//
+// Each iteration feeds its result back into the next one, as the C
+// benchmarks do, so that the measured time is latency rather than
+// throughput.
+func BenchmarkInternal(b *testing.B) {
+	b.Run("scalar", benchInternalScalar)
+	b.Run("field", benchInternalField)
+	b.Run("group", benchInternalGroup)
+	b.Run("ecmult", benchInternalEcmult)
+}
+
+func benchInternalScalar(b *testing.B) {
+	x, y := randomScalar(b), randomScalar(b)
+
+	b.Run("add", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.add(&x, &y)
+		}
+	})
+	b.Run("negate", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.negate(&x)
+		}
+	})
+	b.Run("half", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.half(&x)
+		}
+	})
+	b.Run("mul", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.mul(&x, &y)
+		}
+	})
+	b.Run("mul/generic", func(b *testing.B) {
+		var l [8]uint64
+		for i := 0; i < b.N; i++ {
+			scalarMul512Generic(&l, &x, &y)
+			scalarReduce512Generic(&x, &l)
+		}
+	})
+	b.Run("mul512", func(b *testing.B) {
+		var l [8]uint64
+		for i := 0; i < b.N; i++ {
+			scalarMul512Inner(&l, &x, &y)
+			x.d[0] = l[0]
+		}
+	})
+	b.Run("mul512/generic", func(b *testing.B) {
+		var l [8]uint64
+		for i := 0; i < b.N; i++ {
+			scalarMul512Generic(&l, &x, &y)
+			x.d[0] = l[0]
+		}
+	})
+	b.Run("reduce512", func(b *testing.B) {
+		var l [8]uint64
+		scalarMul512Inner(&l, &x, &y)
+		for i := 0; i < b.N; i++ {
+			scalarReduce512Inner(&x, &l)
+			l[0] = x.d[0]
+		}
+	})
+	b.Run("reduce512/generic", func(b *testing.B) {
+		var l [8]uint64
+		scalarMul512Inner(&l, &x, &y)
+		for i := 0; i < b.N; i++ {
+			scalarReduce512Generic(&x, &l)
+			l[0] = x.d[0]
+		}
+	})
+	b.Run("split", func(b *testing.B) {
+		var r2 Scalar
+		for i := 0; i < b.N; i++ {
+			x.splitLambda(&r2, &x)
+			x.add(&x, &r2)
+		}
+	})
+	b.Run("inverse/const", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.inverse(&x)
+			x.add(&x, &y)
+		}
+	})
+	b.Run("inverse/var", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.inverseVar(&x)
+			x.add(&x, &y)
+		}
+	})
+}
+
+func benchInternalField(b *testing.B) {
+	x, y := GeneratorX, GeneratorY
+
+	b.Run("normalize", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			// Clear the flag so that the reduction is not skipped
+			x.normalized = false
+			x.normalize()
+		}
+	})
+	b.Run("normalizeWeak", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.normalized = false
+			x.normalizeWeak()
+		}
+	})
+	b.Run("half", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.half(&x)
+			x.normalizeWeak()
+		}
+	})
+	b.Run("mul/default", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.mul(&x, &y)
+		}
+	})
+	b.Run("mul/generic", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldMulInnerGeneric(&x.n, &x.n, &y.n)
+		}
+	})
+	b.Run("sqr/default", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.sqr(&x)
+		}
+	})
+	b.Run("sqr/generic", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldSqrInnerGeneric(&x.n, &x.n)
+		}
+	})
+
+	// Per call, i.e. per fieldLaneCount multiplications
+	var u, v fieldLanes
+	for l := 0; l < fieldLaneCount; l++ {
+		u.set(l, &GeneratorX)
+		v.set(l, &GeneratorY)
+	}
+	b.Run("mulLanes/default", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldMulLanes(&u, &u, &v)
+		}
+	})
+	b.Run("mulLanes/generic", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldMulLanesGeneric(&u, &u, &v)
+		}
+	})
+
+	b.Run("inverse/const", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.inv(&x)
+			x.add(&y)
+		}
+	})
+	b.Run("inverse/var", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.invVar(&x)
+			x.add(&y)
+		}
+	})
+	b.Run("sqrt", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.sqrt(&x)
+			x.add(&y)
+		}
+	})
+	b.Run("isSquareVar", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			if x.isSquareVar() {
+				x.add(&y)
+			}
+			x.add(&y)
+		}
+	})
+
+	// Per call on 64 elements
+	const n = 64
+	var in, out [n]FieldElement
+	in[0] = GeneratorX
+	for i := 1; i < n; i++ {
+		in[i].mul(&in[i-1], &GeneratorY)
+	}
+	b.Run("batchInverse", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			batchInverse(out[:], in[:])
+		}
+	})
+}
+
+func benchInternalGroup(b *testing.B) {
+	ga, gb := randomPoint(b), randomPoint(b)
+	var a, c GroupElementJacobian
+	a.setGE(&ga)
+	// Give a a non-trivial z so that the formulas do not see z = 1
+	a.double(&a)
+	c.setGE(&gb)
+	c.double(&c)
+	var zinv FieldElement
+	zinv.inv(&c.z)
+
+	b.Run("double", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			a.double(&a)
+		}
+	})
+	b.Run("add/var", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			a.addVar(&a, &c)
+		}
+	})
+	b.Run("addGE/const", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			a.addGEConst(&a, &gb)
+		}
+	})
+	b.Run("addGE/var", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			a.addGE(&a, &gb)
+		}
+	})
+	b.Run("addZinv/var", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			a.addZinvVar(&a, &gb, &zinv)
+		}
+	})
+	b.Run("toAffine/const", func(b *testing.B) {
+		var r GroupElementAffine
+		for i := 0; i < b.N; i++ {
+			r.setGEJ(&a)
+			a.x.add(&r.x)
+		}
+	})
+	b.Run("toAffine/var", func(b *testing.B) {
+		var r GroupElementAffine
+		for i := 0; i < b.N; i++ {
+			r.setGEJVar(&a)
+			a.x.add(&r.x)
+		}
+	})
+
+	// Per call on 64 points
+	const n = 64
+	var pj [n]GroupElementJacobian
+	var p [n]GroupElementAffine
+	pj[0] = a
+	for i := 1; i < n; i++ {
+		pj[i].addVar(&pj[i-1], &c)
+	}
+	b.Run("toAffineAll", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			geSetAllGEJVar(p[:], pj[:])
+		}
+	})
+}
+
+func benchInternalEcmult(b *testing.B) {
+	x := randomScalar(b)
+	ga := randomPoint(b)
+	var a GroupElementJacobian
+	a.setGE(&ga)
+
+	b.Run("wnaf/var", func(b *testing.B) {
+		var wnaf [256]int
+		for i := 0; i < b.N; i++ {
+			x.wNAF(wnaf[:], 5)
+		}
+	})
+	b.Run("wnaf/fixed", func(b *testing.B) {
+		var wnaf [52]int
+		for i := 0; i < b.N; i++ {
+			x.wnafFixed(wnaf[:], 256, 5)
+		}
+	})
+
+	// The odd multiples table of one point, as built for every point of a
+	// variable-base multiplication
+	b.Run("oddMultiples/var", func(b *testing.B) {
+		var pre [8]GroupElementAffine
+		var zr [8]FieldElement
+		var z FieldElement
+		for i := 0; i < b.N; i++ {
+			ecmultOddMultiplesTable(pre[:], zr[:], &z, &a)
+		}
+	})
+	b.Run("oddMultiples/const", func(b *testing.B) {
+		var pre [ecmultConstTableSize]GroupElementAffine
+		var z FieldElement
+		for i := 0; i < b.N; i++ {
+			ecmultConstOddMultiplesTableGlobalZ(pre[:], &z, &a)
+		}
+	})
+}
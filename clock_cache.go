@@ -0,0 +1,147 @@
+package p256k1
+
+import "sync"
+
+// CacheStats reports the activity of a PubkeyCache, VerifyCache or
+// ConversationKeyCache
+type CacheStats struct {
+	Hits    uint64
+	Misses  uint64
+	Entries int
+}
+
+// HitRate returns the fraction of lookups that found a cached entry, or 0
+// before the first lookup
+func (st CacheStats) HitRate() float64 {
+	if st.Hits+st.Misses == 0 {
+		return 0
+	}
+	return float64(st.Hits) / float64(st.Hits+st.Misses)
+}
+
+// clockCache is a bounded map from K to V split into independently locked
+// shards. Each shard holds a fixed number of entries and evicts with the
+// CLOCK algorithm, an approximation of LRU that only sets a bit on a hit.
+// The caller picks the shard of a key, so it decides how keys are spread.
+type clockCache[K comparable, V any] struct {
+	shards []clockShard[K, V]
+	// wipe, if not nil, is called on a value before it is evicted or
+	// cleared
+	wipe func(*V)
+}
+
+type clockEntry[K comparable, V any] struct {
+	key   K
+	value V
+	ref   bool
+}
+
+type clockShard[K comparable, V any] struct {
+	mu      sync.Mutex
+	index   map[K]int
+	entries []clockEntry[K, V]
+	hand    int
+	hits    uint64
+	misses  uint64
+}
+
+// init sets up shards shards, a power of two, holding up to about capacity
+// entries in all; the bound is rounded up to a multiple of shards
+func (c *clockCache[K, V]) init(shards, capacity int, wipe func(*V)) {
+	perShard := (capacity + shards - 1) / shards
+	if perShard < 1 {
+		perShard = 1
+	}
+	c.shards = make([]clockShard[K, V], shards)
+	for i := range c.shards {
+		c.shards[i].index = make(map[K]int, perShard)
+		c.shards[i].entries = make([]clockEntry[K, V], 0, perShard)
+	}
+	c.wipe = wipe
+}
+
+// shard returns the shard selected by the low bits of h
+func (c *clockCache[K, V]) shard(h uint64) *clockShard[K, V] {
+	return &c.shards[h&uint64(len(c.shards)-1)]
+}
+
+// lookup reports whether key is cached in sh, copying its value to value
+// unless that is nil, and counts a hit or a miss
+func (sh *clockShard[K, V]) lookup(key *K, value *V) bool {
+	sh.mu.Lock()
+	i, ok := sh.index[*key]
+	if ok {
+		e := &sh.entries[i]
+		e.ref = true
+		if value != nil {
+			*value = e.value
+		}
+		sh.hits++
+	} else {
+		sh.misses++
+	}
+	sh.mu.Unlock()
+	return ok
+}
+
+// insert adds key to sh, evicting with the CLOCK hand when full. A key that
+// is already cached keeps its value.
+func (c *clockCache[K, V]) insert(sh *clockShard[K, V], key *K, value *V) {
+	sh.mu.Lock()
+	defer sh.mu.Unlock()
+	if _, ok := sh.index[*key]; ok {
+		return
+	}
+
+	if len(sh.entries) < cap(sh.entries) {
+		sh.index[*key] = len(sh.entries)
+		sh.entries = append(sh.entries, clockEntry[K, V]{key: *key, value: *value})
+		return
+	}
+
+	// Sweep until an entry that has not been referenced since the last pass
+	for sh.entries[sh.hand].ref {
+		sh.entries[sh.hand].ref = false
+		sh.hand = (sh.hand + 1) % len(sh.entries)
+	}
+	victim := &sh.entries[sh.hand]
+	delete(sh.index, victim.key)
+	if c.wipe != nil {
+		c.wipe(&victim.value)
+	}
+	victim.key = *key
+	victim.value = *value
+	sh.index[*key] = sh.hand
+	sh.hand = (sh.hand + 1) % len(sh.entries)
+}
+
+// stats sums the hit and miss counts and the entries of all shards
+func (c *clockCache[K, V]) stats() CacheStats {
+	var st CacheStats
+	for i := range c.shards {
+		sh := &c.shards[i]
+		sh.mu.Lock()
+		st.Hits += sh.hits
+		st.Misses += sh.misses
+		st.Entries += len(sh.entries)
+		sh.mu.Unlock()
+	}
+	return st
+}
+
+// clear empties every shard, wiping the values
+func (c *clockCache[K, V]) clear() {
+	for i := range c.shards {
+		sh := &c.shards[i]
+		sh.mu.Lock()
+		if c.wipe != nil {
+			for j := range sh.entries {
+				c.wipe(&sh.entries[j].value)
+			}
+		}
+		clear(sh.index)
+		sh.entries = sh.entries[:0]
+		sh.hand = 0
+		sh.mu.Unlock()
+	}
+}
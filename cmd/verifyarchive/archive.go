@@ -0,0 +1,290 @@
+package main
+
+import (
+	"bufio"
+	"bytes"
+	"encoding/hex"
+	"encoding/json"
+	"fmt"
+	"os"
+	"strconv"
+
+	sha256simd "github.com/minio/sha256-simd"
+	"p256k1.mleku.dev"
+)
+
+// binaryRecordSize is the size of a sig64 || msg32 || pubkey32 record
+const binaryRecordSize = 128
+
+// progress is how far a run has got: the offset of the next record, and the
+// number of records verified and failed before it
+type progress struct {
+	offset          int
+	records, failed int64
+}
+
+// archiveFormat splits an archive into records and parses them
+type archiveFormat struct {
+	// next returns the record at off and the offset after it; a nil record
+	// with no error is skipped
+	next func(data []byte, off int) (rec []byte, end int, err error)
+
+	// parse fills slot k of a from rec and returns why rec cannot be
+	// verified, or "" if it was queued as a job
+	parse func(a *archiveVerifier, k int, rec []byte) string
+}
+
+var formats = map[string]archiveFormat{
+	"bin":   {nextBinary, parseBinary},
+	"jsonl": {nextJSONLine, parseJSONLine},
+}
+
+// archiveVerifier verifies an archive one batch of records at a time. Its
+// buffers are sized to the batch and reused.
+type archiveVerifier struct {
+	v      *p256k1.Verifier
+	batch  int
+	format archiveFormat
+
+	offsets []int
+	reasons []string
+	jobOf   []int
+	jobs    []p256k1.VerifyJob
+	valid   []bool
+	keys    []p256k1.XOnlyPubkey
+	sigs    [][64]byte
+	msgs    [][32]byte
+	buf     []byte
+}
+
+func newArchiveVerifier(v *p256k1.Verifier, batch int, format archiveFormat) *archiveVerifier {
+	return &archiveVerifier{
+		v:       v,
+		batch:   batch,
+		format:  format,
+		offsets: make([]int, 0, batch),
+		reasons: make([]string, 0, batch),
+		jobOf:   make([]int, 0, batch),
+		jobs:    make([]p256k1.VerifyJob, 0, batch),
+		valid:   make([]bool, batch),
+		keys:    make([]p256k1.XOnlyPubkey, batch),
+		sigs:    make([][64]byte, batch),
+		msgs:    make([][32]byte, batch),
+	}
+}
+
+// queue adds a job for slot k
+func (a *archiveVerifier) queue(k int, sig, msg []byte) {
+	a.jobOf[k] = len(a.jobs)
+	a.jobs = append(a.jobs, p256k1.VerifyJob{ID: uint64(k), Sig: sig, Msg: msg, Pubkey: &a.keys[k]})
+}
+
+// verifyBatch verifies the records of data from p.offset up to the batch
+// size, prints the failing ones to out and returns the progress after them
+func (a *archiveVerifier) verifyBatch(out *bufio.Writer, data []byte, p progress) (progress, error) {
+	a.offsets = a.offsets[:0]
+	a.reasons = a.reasons[:0]
+	a.jobOf = a.jobOf[:0]
+	a.jobs = a.jobs[:0]
+
+	off := p.offset
+	for len(a.offsets) < a.batch && off < len(data) {
+		rec, end, err := a.format.next(data, off)
+		if err != nil {
+			return p, err
+		}
+		if rec != nil {
+			k := len(a.offsets)
+			a.offsets = append(a.offsets, off)
+			a.jobOf = append(a.jobOf, -1)
+			a.reasons = append(a.reasons, a.format.parse(a, k, rec))
+		}
+		off = end
+	}
+
+	a.v.VerifyAll(a.jobs, a.valid)
+	for k, reason := range a.reasons {
+		if reason == "" && !a.valid[a.jobOf[k]] {
+			reason = "invalid signature"
+		}
+		if reason != "" {
+			fmt.Fprintf(out, "%d %d %s\n", p.records+int64(k), a.offsets[k], reason)
+			p.failed++
+		}
+	}
+	p.records += int64(len(a.offsets))
+	p.offset = off
+	return p, nil
+}
+
+func nextBinary(data []byte, off int) ([]byte, int, error) {
+	end := off + binaryRecordSize
+	if end > len(data) {
+		return nil, off, fmt.Errorf("truncated record at offset %d", off)
+	}
+	return data[off:end], end, nil
+}
+
+// parseBinary verifies the signature and message in place in the archive
+func parseBinary(a *archiveVerifier, k int, rec []byte) string {
+	key, err := p256k1.XOnlyPubkeyParseValue(rec[96:])
+	if err != nil {
+		return "invalid public key"
+	}
+	a.keys[k] = key
+	a.queue(k, rec[:64], rec[64:96])
+	return ""
+}
+
+func nextJSONLine(data []byte, off int) ([]byte, int, error) {
+	line, end := data[off:], len(data)
+	if i := bytes.IndexByte(line, '\n'); i >= 0 {
+		line, end = line[:i], off+i+1
+	}
+	line = bytes.TrimSpace(line)
+	if len(line) == 0 {
+		return nil, end, nil
+	}
+	return line, end, nil
+}
+
+// jsonRecord is a Nostr event, or a bare signature if Msg is set
+type jsonRecord struct {
+	ID        string     `json:"id"`
+	Pubkey    string     `json:"pubkey"`
+	CreatedAt int64      `json:"created_at"`
+	Kind      int        `json:"kind"`
+	Tags      [][]string `json:"tags"`
+	Content   string     `json:"content"`
+	Sig       string     `json:"sig"`
+	Msg       string     `json:"msg"`
+}
+
+func parseJSONLine(a *archiveVerifier, k int, rec []byte) string {
+	var r jsonRecord
+	if err := json.Unmarshal(rec, &r); err != nil {
+		return "malformed JSON"
+	}
+	if !decodeHex(a.sigs[k][:], r.Sig) {
+		return "malformed sig"
+	}
+	var pk [32]byte
+	if !decodeHex(pk[:], r.Pubkey) {
+		return "malformed pubkey"
+	}
+	key, err := p256k1.XOnlyPubkeyParseValue(pk[:])
+	if err != nil {
+		return "invalid public key"
+	}
+	a.keys[k] = key
+
+	if r.Msg != "" {
+		if !decodeHex(a.msgs[k][:], r.Msg) {
+			return "malformed msg"
+		}
+	} else {
+		a.buf = appendEvent(a.buf[:0], pk[:], &r)
+		a.msgs[k] = sha256simd.Sum256(a.buf)
+		var id [32]byte
+		if r.ID != "" && (!decodeHex(id[:], r.ID) || id != a.msgs[k]) {
+			return "id mismatch"
+		}
+	}
+	a.queue(k, a.sigs[k][:], a.msgs[k][:])
+	return ""
+}
+
+// decodeHex decodes s into exactly len(dst) bytes
+func decodeHex(dst []byte, s string) bool {
+	if len(s) != 2*len(dst) {
+		return false
+	}
+	_, err := hex.Decode(dst, []byte(s))
+	return err == nil
+}
+
+// appendEvent appends the canonical serialization
+// [0,pubkey,created_at,kind,tags,content] of NIP-01, whose SHA-256 is the id
+// of the event
+func appendEvent(b []byte, pk []byte, r *jsonRecord) []byte {
+	b = append(b, `[0,"`...)
+	for _, c := range pk {
+		b = append(b, "0123456789abcdef"[c>>4], "0123456789abcdef"[c&15])
+	}
+	b = append(b, `",`...)
+	b = strconv.AppendInt(b, r.CreatedAt, 10)
+	b = append(b, ',')
+	b = strconv.AppendInt(b, int64(r.Kind), 10)
+	b = append(b, ",["...)
+	for i, tag := range r.Tags {
+		if i > 0 {
+			b = append(b, ',')
+		}
+		b = append(b, '[')
+		for j, s := range tag {
+			if j > 0 {
+				b = append(b, ',')
+			}
+			b = appendEventString(b, s)
+		}
+		b = append(b, ']')
+	}
+	b = append(b, "],"...)
+	b = appendEventString(b, r.Content)
+	return append(b, ']')
+}
+
+// appendEventString appends s as a JSON string escaped as NIP-01 requires:
+// only the line break, quote, backslash, carriage return, tab, backspace
+// and form feed are escaped, everything else is copied as is
+func appendEventString(b []byte, s string) []byte {
+	b = append(b, '"')
+	for i := 0; i < len(s); i++ {
+		switch c := s[i]; c {
+		case '\n':
+			b = append(b, `\n`...)
+		case '"':
+			b = append(b, `\"`...)
+		case '\\':
+			b = append(b, `\\`...)
+		case '\r':
+			b = append(b, `\r`...)
+		case '\t':
+			b = append(b, `\t`...)
+		case '\b':
+			b = append(b, `\b`...)
+		case '\f':
+			b = append(b, `\f`...)
+		default:
+			b = append(b, c)
+		}
+	}
+	return append(b, '"')
+}
+
+// readCheckpoint returns the progress saved in path, or none if it does not
+// exist
+func readCheckpoint(path string) (progress, error) {
+	var p progress
+	data, err := os.ReadFile(path)
+	if os.IsNotExist(err) {
+		return p, nil
+	}
+	if err != nil {
+		return p, err
+	}
+	if _, err := fmt.Sscanf(string(data), "%d %d %d", &p.offset, &p.records, &p.failed); err != nil || p.offset < 0 {
+		return progress{}, fmt.Errorf("%s: malformed checkpoint", path)
+	}
+	return p, nil
+}
+
+// writeCheckpoint saves p to path, replacing it atomically so that an
+// interrupted write leaves the previous checkpoint
+func writeCheckpoint(path string, p progress) error {
+	tmp := path + ".tmp"
+	if err := os.WriteFile(tmp, []byte(fmt.Sprintf("%d %d %d\n", p.offset, p.records, p.failed)), 0o644); err != nil {
+		return err
+	}
+	return os.Rename(tmp, path)
+}
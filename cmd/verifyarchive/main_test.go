@@ -0,0 +1,183 @@
+package main
+
+import (
+	"bufio"
+	"bytes"
+	"crypto/rand"
+	"encoding/hex"
+	"fmt"
+	"path/filepath"
+	"strings"
+	"testing"
+
+	sha256simd "github.com/minio/sha256-simd"
+	"p256k1.mleku.dev"
+)
+
+// signed returns the x-only key and the signature of msg by a fresh key
+func signed(tb testing.TB, msg []byte) (pk [32]byte, sig []byte) {
+	kp, err := p256k1.KeyPairGenerate()
+	if err != nil {
+		tb.Fatal(err)
+	}
+	xonly, err := kp.XOnlyPubkey()
+	if err != nil {
+		tb.Fatal(err)
+	}
+	sig = make([]byte, 64)
+	if err := p256k1.SchnorrSign(sig, msg, kp, nil); err != nil {
+		tb.Fatal(err)
+	}
+	return xonly.Serialize(), sig
+}
+
+// verifyAll verifies data from p in batches of batch records, and returns
+// the failures printed and the final progress
+func verifyAll(tb testing.TB, data []byte, format string, batch int, p progress) (string, progress) {
+	v := p256k1.NewVerifier(2, 0)
+	defer v.Close()
+	a := newArchiveVerifier(v, batch, formats[format])
+	var out bytes.Buffer
+	w := bufio.NewWriter(&out)
+	for p.offset < len(data) {
+		var err error
+		if p, err = a.verifyBatch(w, data, p); err != nil {
+			tb.Fatal(err)
+		}
+	}
+	w.Flush()
+	return out.String(), p
+}
+
+func TestBinaryArchive(t *testing.T) {
+	const n = 300
+	var data []byte
+	for i := 0; i < n; i++ {
+		msg := make([]byte, 32)
+		rand.Read(msg)
+		pk, sig := signed(t, msg)
+		data = append(data, sig...)
+		data = append(data, msg...)
+		data = append(data, pk[:]...)
+	}
+	data[5*binaryRecordSize+70] ^= 1         // message
+	data[130*binaryRecordSize+63] ^= 1       // s
+	for i := 96; i < binaryRecordSize; i++ { // x = 0 is not on the curve
+		data[257*binaryRecordSize+i] = 0
+	}
+	want := fmt.Sprintf("5 %d invalid signature\n130 %d invalid signature\n257 %d invalid public key\n",
+		5*binaryRecordSize, 130*binaryRecordSize, 257*binaryRecordSize)
+
+	for _, batch := range []int{1, 64, 1000} {
+		out, p := verifyAll(t, data, "bin", batch, progress{})
+		if out != want || p != (progress{len(data), n, 3}) {
+			t.Errorf("batch=%d: got %q with %+v", batch, out, p)
+		}
+	}
+
+	// Resuming from a checkpoint reports only what follows it
+	ckpt := filepath.Join(t.TempDir(), "ckpt")
+	if err := writeCheckpoint(ckpt, progress{100 * binaryRecordSize, 100, 1}); err != nil {
+		t.Fatal(err)
+	}
+	start, err := readCheckpoint(ckpt)
+	if err != nil {
+		t.Fatal(err)
+	}
+	out, p := verifyAll(t, data, "bin", 64, start)
+	if out != want[strings.IndexByte(want, '\n')+1:] || p != (progress{len(data), n, 3}) {
+		t.Errorf("resumed: got %q with %+v", out, p)
+	}
+
+	a := newArchiveVerifier(nil, 1, formats["bin"])
+	if _, err := a.verifyBatch(nil, data[:200], progress{offset: binaryRecordSize}); err == nil {
+		t.Error("accepted a truncated record")
+	}
+}
+
+func TestJSONLinesArchive(t *testing.T) {
+	var lines []string
+	addEvent := func(r jsonRecord, corrupt func(*jsonRecord)) {
+		kp, err := p256k1.KeyPairGenerate()
+		if err != nil {
+			t.Fatal(err)
+		}
+		xonly, err := kp.XOnlyPubkey()
+		if err != nil {
+			t.Fatal(err)
+		}
+		pk := xonly.Serialize()
+		r.Pubkey = hex.EncodeToString(pk[:])
+		id := sha256simd.Sum256(appendEvent(nil, pk[:], &r))
+		sig := make([]byte, 64)
+		if err := p256k1.SchnorrSign(sig, id[:], kp, nil); err != nil {
+			t.Fatal(err)
+		}
+		r.ID, r.Sig = hex.EncodeToString(id[:]), hex.EncodeToString(sig)
+		if corrupt != nil {
+			corrupt(&r)
+		}
+		line := fmt.Sprintf(`{"id":%q,"pubkey":%q,"created_at":%d,"kind":%d,"tags":%s,"content":%q,"sig":%q}`,
+			r.ID, r.Pubkey, r.CreatedAt, r.Kind, tagsJSON(r.Tags), r.Content, r.Sig)
+		lines = append(lines, line)
+	}
+
+	addEvent(jsonRecord{CreatedAt: 1700000000, Kind: 1, Content: "hello"}, nil)
+	addEvent(jsonRecord{CreatedAt: 1700000001, Kind: 1, Tags: [][]string{{"e", "abc"}, {"p", "d\"ef"}}, Content: "line\nbreak \\ <&> \u2028 \u00e9"}, nil)
+	addEvent(jsonRecord{CreatedAt: 1700000002, Kind: 7, Content: "+"}, func(r *jsonRecord) { r.Content = "-" })
+	addEvent(jsonRecord{CreatedAt: 1700000003, Kind: 1}, func(r *jsonRecord) { r.ID = strings.Repeat("0", 64) })
+
+	msg := make([]byte, 32)
+	rand.Read(msg)
+	pk, sig := signed(t, msg)
+	lines = append(lines, fmt.Sprintf(`{"sig":"%x","msg":"%x","pubkey":"%x"}`, sig, msg, pk))
+	lines = append(lines, "", "{not json", fmt.Sprintf(`{"sig":"%x","msg":"%x","pubkey":"00"}`, sig, msg))
+
+	data := []byte(strings.Join(lines, "\n") + "\n")
+	offsetOf := func(line int) int {
+		return len(strings.Join(lines[:line], "\n")) + 1
+	}
+	want := fmt.Sprintf("2 %d id mismatch\n3 %d id mismatch\n5 %d malformed JSON\n6 %d malformed pubkey\n",
+		offsetOf(2), offsetOf(3), offsetOf(6), offsetOf(7))
+	for _, batch := range []int{1, 3, 100} {
+		out, p := verifyAll(t, data, "jsonl", batch, progress{})
+		if out != want || p != (progress{len(data), 7, 4}) {
+			t.Errorf("batch=%d: got %q with %+v, want %q", batch, out, p, want)
+		}
+	}
+}
+
+// TestAppendEvent checks the NIP-01 escaping, which unlike encoding/json
+// leaves U+2028 and HTML characters as they are
+func TestAppendEvent(t *testing.T) {
+	var pk [32]byte
+	pk[31] = 0xab
+	r := jsonRecord{CreatedAt: 1, Kind: 2, Tags: [][]string{{"t", "a\tb"}, {}}, Content: "\"q\"\r\n\\\b\f<\u2028>"}
+	want := `[0,"` + strings.Repeat("00", 31) + `ab",1,2,[["t","a\tb"],[]],"\"q\"\r\n\\\b\f<` + "\u2028" + `>"]`
+	if got := string(appendEvent(nil, pk[:], &r)); got != want {
+		t.Errorf("got  %s\nwant %s", got, want)
+	}
+}
+
+// tagsJSON encodes tags as a JSON array of arrays of strings
+func tagsJSON(tags [][]string) string {
+	if tags == nil {
+		return "[]"
+	}
+	var b []byte
+	b = append(b, '[')
+	for i, tag := range tags {
+		if i > 0 {
+			b = append(b, ',')
+		}
+		b = append(b, '[')
+		for j, s := range tag {
+			if j > 0 {
+				b = append(b, ',')
+			}
+			b = append(b, fmt.Sprintf("%q", s)...)
+		}
+		b = append(b, ']')
+	}
+	return string(append(b, ']'))
+}
@@ -0,0 +1,51 @@
+package main
+
+import (
+	"errors"
+	"os"
+	"syscall"
+)
+
+// mapping is an archive mapped read-only into memory. Pages are read on
+// demand, and those behind the verified offset are dropped with release, so
+// only about a batch of the archive is resident at a time.
+type mapping struct {
+	data     []byte
+	released int
+}
+
+func mapFile(f *os.File) (*mapping, error) {
+	fi, err := f.Stat()
+	if err != nil {
+		return nil, err
+	}
+	size := fi.Size()
+	if size == 0 {
+		return &mapping{}, nil
+	}
+	if int64(int(size)) != size {
+		return nil, errors.New("archive too large to map")
+	}
+	data, err := syscall.Mmap(int(f.Fd()), 0, int(size), syscall.PROT_READ, syscall.MAP_SHARED)
+	if err != nil {
+		return nil, err
+	}
+	syscall.Madvise(data, syscall.MADV_SEQUENTIAL)
+	return &mapping{data: data}, nil
+}
+
+// release drops the pages wholly below offset, which are not read again
+func (m *mapping) release(offset int) {
+	end := offset &^ (os.Getpagesize() - 1)
+	if end > m.released {
+		syscall.Madvise(m.data[m.released:end], syscall.MADV_DONTNEED)
+		m.released = end
+	}
+}
+
+func (m *mapping) close() error {
+	if m.data == nil {
+		return nil
+	}
+	return syscall.Munmap(m.data)
+}
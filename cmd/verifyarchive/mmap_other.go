@@ -0,0 +1,26 @@
+//go:build !linux
+
+package main
+
+import (
+	"io"
+	"os"
+)
+
+// mapping holds an archive in memory. Without mmap the whole file is read
+// up front, so memory use is the size of the archive.
+type mapping struct {
+	data []byte
+}
+
+func mapFile(f *os.File) (*mapping, error) {
+	data, err := io.ReadAll(f)
+	if err != nil {
+		return nil, err
+	}
+	return &mapping{data: data}, nil
+}
+
+func (m *mapping) release(offset int) {}
+
+func (m *mapping) close() error { return nil }
@@ -3,6 +3,8 @@ package p256k1
 import (
 	"crypto/rand"
 	"errors"
+	"sync"
+	"unsafe"
 )
 
 // Context flags
@@ -10,16 +12,38 @@ const (
 	ContextSign   = 1 << 0
 	ContextVerify = 1 << 1
 	ContextNone   = 0
+
+	// ContextConstantTime makes a signing context multiply by the generator
+	// with the blinded constant-time comb instead of the faster
+	// variable-time byte table. Use ContextRandomize to blind it.
+	ContextConstantTime = 1 << 2
+
+	// ContextHugePages gives the context private copies of its precomputed
+	// tables in memory backed by transparent huge pages, so table lookups
+	// miss the TLB less often. It is honoured on Linux amd64 and arm64 and
+	// ignored elsewhere. The copies are never freed, so it is meant for a
+	// few long-lived contexts.
+	ContextHugePages = 1 << 3
 )
 
 // Context represents a secp256k1 context
 type Context struct {
-	flags       uint
+	flags        uint
 	ecmultGenCtx *EcmultGenContext
-	// In a real implementation, this would also contain:
-	// - ecmult context for verification
-	// - callback functions
-	// - randomization state
+
+	// Verification state: the generator tables (nil uses the global ones),
+	// an optional cache of decompressed public keys, and a pool of scratch
+	// arenas bound to the tables
+	ecmult      *ecmultTables
+	pubkeyCache *PubkeyCache
+	scratch     *sync.Pool
+
+	// verifyCache remembers signatures that verified, nil for none
+	verifyCache *VerifyCache
+
+	// batchBackend performs the multiplications of SchnorrVerifyBatch, nil
+	// for the multi-scalar multiplication
+	batchBackend SchnorrBatchBackend
 }
 
 // CallbackFunction represents an error callback
@@ -43,17 +67,110 @@ func ContextCreate(flags uint) *Context {
 	
 	// Initialize generator context if needed for signing
 	if flags&ContextSign != 0 {
-		ctx.ecmultGenCtx = NewEcmultGenContext()
+		if flags&ContextConstantTime != 0 {
+			// The default configuration is always valid
+			ctx.ecmultGenCtx, _ = NewEcmultGenCombContext(CombDefaultBlocks, CombDefaultTeeth)
+		} else {
+			ctx.ecmultGenCtx = NewEcmultGenContext()
+		}
 	}
 	
-	// Initialize verification context if needed
+	// Verification contexts reference the global generator tables; a deep
+	// clone gives them a private copy
 	if flags&ContextVerify != 0 {
-		// In a real implementation, this would initialize ecmult tables
+		preG, preG128 := getEcmultTables()
+		ctx.setEcmultTables(&ecmultTables{preG: preG, preG128: preG128})
+	}
+
+	if flags&ContextHugePages != 0 {
+		ctx.copyTables()
 	}
 	
 	return ctx
 }
 
+// setEcmultTables binds the context and its scratch pool to tables
+func (ctx *Context) setEcmultTables(tables *ecmultTables) {
+	ctx.ecmult = tables
+	ctx.scratch = &sync.Pool{
+		New: func() interface{} { return &Scratch{tables: tables} },
+	}
+}
+
+// ContextClone returns a copy of ctx, as secp256k1_context_clone. The
+// precomputed tables are read-only and shared with ctx, so a clone is cheap;
+// the blinding state is copied, so ContextRandomize on either context does
+// not affect the other. Public key and verification caches and a batch
+// backend set on ctx are shared as well.
+// Clones let every goroutine own a context without rebuilding the tables.
+func ContextClone(ctx *Context) *Context {
+	if ctx == nil {
+		return nil
+	}
+	clone := &Context{
+		flags:       ctx.flags,
+		pubkeyCache: ctx.pubkeyCache,
+		verifyCache: ctx.verifyCache,
+
+		batchBackend: ctx.batchBackend,
+	}
+	if ctx.ecmultGenCtx != nil {
+		gen := *ctx.ecmultGenCtx
+		clone.ecmultGenCtx = &gen
+	}
+	if ctx.ecmult != nil {
+		clone.setEcmultTables(ctx.ecmult)
+	}
+	return clone
+}
+
+// ContextCloneDeep is ContextClone with private copies of the generator
+// multiplication and verification tables. The copies are written by the
+// calling goroutine, so on a NUMA machine a deep clone made from a thread
+// pinned to one socket places its tables in that socket's memory, while
+// ContextClone leaves every socket reading the same pages.
+// NewContextReplicas makes such a clone for every node. With
+// ContextHugePages the copies are backed by huge pages.
+func ContextCloneDeep(ctx *Context) *Context {
+	clone := ContextClone(ctx)
+	if clone != nil {
+		clone.copyTables()
+	}
+	return clone
+}
+
+// copyTables replaces the context's precomputed tables by private copies,
+// in huge page memory if the context has ContextHugePages
+func (ctx *Context) copyTables() {
+	huge := ctx.flags&ContextHugePages != 0
+	if gen := ctx.ecmultGenCtx; gen != nil {
+		if gen.storagePoints != nil {
+			mem := newTableStorage(numBytes*numByteValues, huge)
+			copy(mem, unsafe.Slice(&gen.storagePoints[0][0], len(mem)))
+			gen.storagePoints = (*genStorageTable)(unsafe.Pointer(&mem[0]))
+		}
+		if gen.bytePoints != nil {
+			t := *gen.bytePoints
+			gen.bytePoints = &t
+		}
+		if gen.comb != nil {
+			comb := *gen.comb
+			comb.table = newTableStorage(len(gen.comb.table), huge)
+			copy(comb.table, gen.comb.table)
+			gen.comb = &comb
+		}
+		if gen.window != nil {
+			window := *gen.window
+			window.entries = newTableStorage(len(gen.window.entries), huge)
+			copy(window.entries, gen.window.entries)
+			gen.window = &window
+		}
+	}
+	if ctx.ecmult != nil {
+		ctx.setEcmultTables(ctx.ecmult.clone(huge))
+	}
+}
+
 // ContextDestroy destroys a secp256k1 context
 func ContextDestroy(ctx *Context) {
 	if ctx == nil {
@@ -64,11 +181,20 @@ func ContextDestroy(ctx *Context) {
 	if ctx.ecmultGenCtx != nil {
 		// Clear generator context
 		ctx.ecmultGenCtx.initialized = false
+		ctx.ecmultGenCtx.scalarOffset.clear()
+		ctx.ecmultGenCtx.geOffset.clear()
+		ctx.ecmultGenCtx.projBlind.clear()
+		ctx.ecmultGenCtx.clearStep()
 	}
 	
 	// Zero out the context
 	ctx.flags = 0
 	ctx.ecmultGenCtx = nil
+	ctx.ecmult = nil
+	ctx.pubkeyCache = nil
+	ctx.verifyCache = nil
+	ctx.batchBackend = nil
+	ctx.scratch = nil
 }
 
 // ContextRandomize randomizes the context to provide protection against side-channel attacks
@@ -91,12 +217,95 @@ func ContextRandomize(ctx *Context, seed32 []byte) error {
 		}
 	}
 	
-	// In a real implementation, this would:
-	// 1. Randomize the precomputed tables
-	// 2. Add blinding to prevent side-channel attacks
-	// 3. Update the context state
-	
-	// For now, we just validate the input
+	// Re-blind the constant-time generator multiplication. The variable-time
+	// byte table has no blinding state.
+	if ctx.ecmultGenCtx != nil && ctx.ecmultGenCtx.comb != nil {
+		ctx.ecmultGenCtx.blind(seedBytes[:])
+	}
+	memclear(unsafe.Pointer(&seedBytes[0]), 32)
+
+	return nil
+}
+
+// ContextSetBlindingRotation makes a constant-time signing context rotate
+// its blinding every n generator multiplications (signatures and public key
+// derivations), or never for n = 0. ContextRandomize recomputes the blinding
+// with a full multiplication by the generator; a rotation instead derives
+// the next blinding values from the current ones and those ContextRandomize
+// drew, for about a tenth of that cost and without touching the tables, so
+// the blinding can change often without slowing signing down. Rotation
+// steps from the values drawn by the most recent ContextRandomize, with or
+// without a seed, and has nothing to step from before the first one. Only
+// n = 0 or ContextSetEcmultGenComb turns it off.
+//
+// A context that rotates changes on every multiplication, so it must not
+// sign from several goroutines at once; give each goroutine a ContextClone.
+func ContextSetBlindingRotation(ctx *Context, n uint64) error {
+	if !ctx.canSign() {
+		return errors.New("context cannot sign")
+	}
+	if ctx.ecmultGenCtx.comb == nil {
+		return errors.New("context does not use the constant-time comb")
+	}
+	ctx.ecmultGenCtx.rotateEvery = n
+	ctx.ecmultGenCtx.sinceRotate = 0
+	return nil
+}
+
+// ContextSetEcmultGenComb switches a signing context to the constant-time
+// comb with the given number of blocks and teeth. More teeth or blocks give
+// a bigger table and fewer point additions per multiplication. The new
+// comb starts unblinded.
+func ContextSetEcmultGenComb(ctx *Context, blocks, teeth int) error {
+	if !ctx.canSign() {
+		return errors.New("context cannot sign")
+	}
+	gen, err := NewEcmultGenCombContext(blocks, teeth)
+	if err != nil {
+		return err
+	}
+	ctx.flags |= ContextConstantTime
+	ctx.ecmultGenCtx = gen
+	return nil
+}
+
+// ContextSetEcmultGenWindow switches a signing context to the variable-time
+// generator table with windows of the given number of bits (1 to 8). The
+// default 8-bit table is 512 KiB; narrower windows make for a smaller table
+// at the cost of more point additions.
+func ContextSetEcmultGenWindow(ctx *Context, bits int) error {
+	if !ctx.canSign() {
+		return errors.New("context cannot sign")
+	}
+	gen, err := NewEcmultGenWindowContext(bits)
+	if err != nil {
+		return err
+	}
+	ctx.flags &^= ContextConstantTime
+	ctx.ecmultGenCtx = gen
+	return nil
+}
+
+// ContextSetPubkeyCache makes the verification methods of ctx look public
+// keys up in cache. A nil cache turns caching off. Clones made afterwards
+// share the cache.
+func ContextSetPubkeyCache(ctx *Context, cache *PubkeyCache) error {
+	if !ctx.canVerify() {
+		return errors.New("context cannot verify")
+	}
+	ctx.pubkeyCache = cache
+	return nil
+}
+
+// ContextSetVerifyCache makes SchnorrVerify and SchnorrVerifyBatch of ctx
+// accept signatures found in cache without verifying them again, and add
+// those that verify. A nil cache turns caching off. Clones made afterwards
+// share the cache.
+func ContextSetVerifyCache(ctx *Context, cache *VerifyCache) error {
+	if !ctx.canVerify() {
+		return errors.New("context cannot verify")
+	}
+	ctx.verifyCache = cache
 	return nil
 }
 
@@ -161,6 +161,287 @@ func TestContextCapabilities(t *testing.T) {
 	}
 }
 
+func TestContextConstantTime(t *testing.T) {
+	seckey := make([]byte, 32)
+	seckey[31] = 0x2a
+	msg := make([]byte, 32)
+	keypair, err := KeyPairCreate(seckey)
+	if err != nil {
+		t.Fatal(err)
+	}
+	var want PublicKey
+	if err := ECPubkeyCreate(&want, seckey); err != nil {
+		t.Fatal(err)
+	}
+	wantSig := make([]byte, 64)
+	if err := SchnorrSign(wantSig, msg, keypair, nil); err != nil {
+		t.Fatal(err)
+	}
+
+	ctx := ContextCreate(ContextSign | ContextConstantTime)
+	defer ContextDestroy(ctx)
+	if ctx.ecmultGenCtx.comb == nil {
+		t.Fatal("constant-time context should use the comb")
+	}
+	for i := 0; i < 3; i++ {
+		var got PublicKey
+		if err := ctx.ECPubkeyCreate(&got, seckey); err != nil {
+			t.Fatal(err)
+		}
+		if ECPubkeyCmp(&got, &want) != 0 {
+			t.Fatalf("round %d: comb context derived a different public key", i)
+		}
+		sig := make([]byte, 64)
+		if err := ctx.SchnorrSign(sig, msg, keypair, nil); err != nil {
+			t.Fatal(err)
+		}
+		if string(sig) != string(wantSig) {
+			t.Fatalf("round %d: comb context produced a different signature", i)
+		}
+		if err := ContextRandomize(ctx, nil); err != nil {
+			t.Fatal(err)
+		}
+	}
+
+	if err := ContextSetEcmultGenComb(ctx, 2, 8); err != nil {
+		t.Fatal(err)
+	}
+	var got PublicKey
+	if err := ctx.ECPubkeyCreate(&got, seckey); err != nil || ECPubkeyCmp(&got, &want) != 0 {
+		t.Error("comb context with 2 blocks of 8 teeth derived a different public key")
+	}
+	if err := ContextSetEcmultGenComb(ContextCreate(ContextVerify), 2, 8); err == nil {
+		t.Error("verify-only context should not accept a comb")
+	}
+	if err := ContextCreate(ContextVerify).ECPubkeyCreate(&got, seckey); err == nil {
+		t.Error("verify-only context should not derive public keys")
+	}
+}
+
+func TestContextClone(t *testing.T) {
+	ctx := ContextCreate(ContextSign | ContextVerify | ContextConstantTime)
+	defer ContextDestroy(ctx)
+	seed := make([]byte, 32)
+	seed[0] = 1
+	if err := ContextRandomize(ctx, seed); err != nil {
+		t.Fatal(err)
+	}
+
+	seckey := make([]byte, 32)
+	seckey[31] = 7
+	var want PublicKey
+	if err := ctx.ECPubkeyCreate(&want, seckey); err != nil {
+		t.Fatal(err)
+	}
+
+	// A clone shares the tables but not the blinding state
+	clone := ContextClone(ctx)
+	if clone.ecmultGenCtx.comb != ctx.ecmultGenCtx.comb || &clone.ecmult.preG[0] != &ctx.ecmult.preG[0] {
+		t.Error("clone does not share the precomputed tables")
+	}
+	seed[0] = 2
+	if err := ContextRandomize(clone, seed); err != nil {
+		t.Fatal(err)
+	}
+	if clone.ecmultGenCtx.scalarOffset.equal(&ctx.ecmultGenCtx.scalarOffset) {
+		t.Error("randomizing the clone changed the original blinding")
+	}
+
+	// A deep clone has its own copies of the tables
+	deep := ContextCloneDeep(ctx)
+	if deep.ecmultGenCtx.comb == ctx.ecmultGenCtx.comb || &deep.ecmult.preG[0] == &ctx.ecmult.preG[0] {
+		t.Error("deep clone shares the precomputed tables")
+	}
+	if deep.ecmult.preG[5] != ctx.ecmult.preG[5] || deep.ecmult.preG128[5] != ctx.ecmult.preG128[5] {
+		t.Error("deep clone tables differ from the original")
+	}
+
+	for _, c := range []*Context{ctx, clone, deep} {
+		var got PublicKey
+		if err := c.ECPubkeyCreate(&got, seckey); err != nil || got != want {
+			t.Error("cloned context derived a different public key")
+		}
+	}
+	if ContextClone(nil) != nil || ContextCloneDeep(nil) != nil {
+		t.Error("clone of a nil context should be nil")
+	}
+}
+
+func TestContextSetBlindingRotation(t *testing.T) {
+	ctx := ContextCreate(ContextSign | ContextConstantTime)
+	defer ContextDestroy(ctx)
+	if err := ContextSetBlindingRotation(ctx, 2); err != nil {
+		t.Fatal(err)
+	}
+	seed := make([]byte, 32)
+	seed[0] = 5
+	if err := ContextRandomize(ctx, seed); err != nil {
+		t.Fatal(err)
+	}
+
+	seckey := make([]byte, 32)
+	seckey[31] = 9
+	keypair, err := KeyPairCreate(seckey)
+	if err != nil {
+		t.Fatal(err)
+	}
+	msg := make([]byte, 32)
+	wantSig := make([]byte, 64)
+	if err := SchnorrSign(wantSig, msg, keypair, nil); err != nil {
+		t.Fatal(err)
+	}
+	offset := ctx.ecmultGenCtx.scalarOffset
+	sig := make([]byte, 64)
+	for i := 0; i < 5; i++ {
+		if err := ctx.SchnorrSign(sig, msg, keypair, nil); err != nil {
+			t.Fatal(err)
+		}
+		if string(sig) != string(wantSig) {
+			t.Fatalf("signature %d with rotating blinding differs", i)
+		}
+	}
+	if ctx.ecmultGenCtx.scalarOffset.equal(&offset) {
+		t.Error("blinding did not rotate")
+	}
+
+	// Randomizing without a seed keeps the rotation going
+	if err := ContextRandomize(ctx, nil); err != nil {
+		t.Fatal(err)
+	}
+	offset = ctx.ecmultGenCtx.scalarOffset
+	for i := 0; i < 2; i++ {
+		if err := ctx.SchnorrSign(sig, msg, keypair, nil); err != nil {
+			t.Fatal(err)
+		}
+	}
+	if string(sig) != string(wantSig) || ctx.ecmultGenCtx.scalarOffset.equal(&offset) {
+		t.Error("blinding did not rotate after ContextRandomize without a seed")
+	}
+
+	// Builds with compact tables sign with the comb in every context
+	if err := ContextSetBlindingRotation(ContextCreate(ContextSign), 2); err == nil && !smallTables {
+		t.Error("variable-time context should not accept blinding rotation")
+	}
+	if err := ContextSetBlindingRotation(ContextCreate(ContextVerify), 2); err == nil {
+		t.Error("verify-only context should not accept blinding rotation")
+	}
+}
+
+func TestContextVerify(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 8)
+	ctx := ContextCreate(ContextVerify)
+	defer ContextDestroy(ctx)
+	cache := NewPubkeyCache(16)
+	if err := ContextSetPubkeyCache(ctx, cache); err != nil {
+		t.Fatal(err)
+	}
+
+	for _, c := range []*Context{ctx, ContextClone(ctx), ContextCloneDeep(ctx), ContextStatic} {
+		for i := range sigs {
+			if !c.SchnorrVerify(sigs[i], msgs[i], pubkeys[i]) {
+				t.Fatalf("context rejected valid signature %d", i)
+			}
+		}
+		if valid, failed := c.SchnorrVerifyBatch(sigs, msgs, pubkeys); !valid || failed != nil {
+			t.Fatalf("context rejected a valid batch, failed = %v", failed)
+		}
+	}
+	if st := cache.Stats(); st.Hits == 0 {
+		t.Errorf("context verification did not use the cache: %+v", st)
+	}
+
+	bad := append([]byte(nil), sigs[0]...)
+	bad[63] ^= 1
+	if ctx.SchnorrVerify(bad, msgs[0], pubkeys[0]) {
+		t.Error("context accepted an invalid signature")
+	}
+	signOnly := ContextCreate(ContextSign)
+	if signOnly.SchnorrVerify(sigs[0], msgs[0], pubkeys[0]) {
+		t.Error("sign-only context should not verify")
+	}
+	if ContextSetPubkeyCache(signOnly, cache) == nil {
+		t.Error("sign-only context accepted a public key cache")
+	}
+}
+
+func TestContextHugePages(t *testing.T) {
+	ctx := ContextCreate(ContextSign | ContextVerify | ContextHugePages)
+	defer ContextDestroy(ctx)
+	if gen, global := ctx.ecmultGenCtx, getGlobalGenContext(); gen.storagePoints != nil && gen.storagePoints == global.storagePoints ||
+		gen.comb != nil && &gen.comb.table[0] == &global.comb.table[0] {
+		t.Error("huge page context shares the global generator table")
+	}
+	preG, _ := getEcmultTables()
+	if last := len(preG) - 1; &ctx.ecmult.preG[0] == &preG[0] || ctx.ecmult.preG[last] != preG[last] {
+		t.Error("huge page context does not hold a copy of the verification tables")
+	}
+
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 4)
+	replicas := NewContextReplicas(ctx)
+	seckey := make([]byte, 32)
+	seckey[31] = 9
+	var want PublicKey
+	if err := ECPubkeyCreate(&want, seckey); err != nil {
+		t.Fatal(err)
+	}
+	for _, c := range []*Context{ctx, replicas.Get()} {
+		var got PublicKey
+		if err := c.ECPubkeyCreate(&got, seckey); err != nil || got != want {
+			t.Error("huge page context derived a different public key")
+		}
+		for i := range sigs {
+			if !c.SchnorrVerify(sigs[i], msgs[i], pubkeys[i]) {
+				t.Fatalf("huge page context rejected valid signature %d", i)
+			}
+		}
+	}
+}
+
+func TestParseCPUList(t *testing.T) {
+	got := parseCPUList("0-2,5,8-9")
+	want := []int{0, 1, 2, 5, 8, 9}
+	if len(got) != len(want) {
+		t.Fatalf("got %v, want %v", got, want)
+	}
+	for i := range want {
+		if got[i] != want[i] {
+			t.Fatalf("got %v, want %v", got, want)
+		}
+	}
+}
+
+// BenchmarkTablePlacement compares heap and huge page tables. The variable
+// time generator multiplication reads 32 random entries of the 512 KiB byte
+// table, so the difference is in TLB misses; count them with
+// perf stat -e dTLB-load-misses on the test binary.
+func BenchmarkTablePlacement(b *testing.B) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(b, 1)
+	for _, c := range []struct {
+		name  string
+		flags uint
+	}{
+		{"heap", 0},
+		{"hugepages", ContextHugePages},
+	} {
+		ctx := ContextCreate(ContextSign | ContextVerify | c.flags)
+		b.Run(c.name+"/ECPubkeyCreate", func(b *testing.B) {
+			var pk PublicKey
+			seckey := make([]byte, 32)
+			rand.Read(seckey)
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				seckey[0] = byte(i)
+				ctx.ECPubkeyCreate(&pk, seckey)
+			}
+		})
+		b.Run(c.name+"/SchnorrVerify", func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				ctx.SchnorrVerify(sigs[0], msgs[0], pubkeys[0])
+			}
+		})
+	}
+}
+
 func BenchmarkContextCreate(b *testing.B) {
 	b.ResetTimer()
 	for i := 0; i < b.N; i++ {
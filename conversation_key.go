@@ -0,0 +1,126 @@
+package p256k1
+
+import (
+	"errors"
+	"hash/maphash"
+	"sync"
+	"unsafe"
+)
+
+// nip44Salt is the HKDF salt of the NIP-44 version 2 conversation key
+var nip44Salt = []byte("nip44-v2")
+
+// NIP44ConversationKey sets the 32 byte out32 to the NIP-44 version 2
+// conversation key of seckey and the 32 byte x-only public key peerX32:
+// HKDF-Extract with the salt "nip44-v2" of the x coordinate of their shared
+// point. Both sides of a conversation get the same key.
+func NIP44ConversationKey(out32 []byte, seckey []byte, peerX32 []byte) error {
+	if len(out32) != 32 {
+		return errors.New("output must be 32 bytes")
+	}
+	var shared [32]byte
+	if err := ECDHX(shared[:], peerX32, seckey); err != nil {
+		return err
+	}
+	h := taggedHasherPool.Get().(*taggedHasher)
+	hkdfExtract(h, (*[32]byte)(out32), nip44Salt, shared[:])
+	h.clearState()
+	taggedHasherPool.Put(h)
+	memclear(unsafe.Pointer(&shared[0]), 32)
+	return nil
+}
+
+// conversationKeyCacheShards is the number of independently locked shards
+// of a ConversationKeyCache. It must be a power of two.
+const conversationKeyCacheShards = 16
+
+// ConversationKeyCache holds the NIP-44 conversation keys of one secret key
+// with the peers it talks to, so messages to and from a known peer skip the
+// elliptic curve multiplication and the HKDF. Keys are only cached for the
+// secret key the cache was made with.
+//
+// The cache is bounded: each shard holds a fixed number of peers and evicts
+// with the CLOCK algorithm, as PubkeyCache, wiping the evicted key. Peers
+// are spread over the shards with a per-cache random hash seed. Clear wipes
+// the secret key and every cached conversation key.
+//
+// A ConversationKeyCache is safe for concurrent use.
+type ConversationKeyCache struct {
+	// mu guards seckey and closed. Misses hold it for reading while they
+	// derive and insert, so Clear waits for them and no key derived before
+	// Clear is cached after it.
+	mu     sync.RWMutex
+	seckey [32]byte
+	closed bool
+	seed   maphash.Seed
+	cache  clockCache[[32]byte, [32]byte]
+}
+
+// ConversationKeyCacheStats reports the activity of a ConversationKeyCache
+type ConversationKeyCacheStats = CacheStats
+
+// wipeConversationKey clears a conversation key leaving the cache
+func wipeConversationKey(key *[32]byte) {
+	memclear(unsafe.Pointer(&key[0]), 32)
+}
+
+// NewConversationKeyCache returns a cache of the conversation keys of
+// seckey with up to about capacity peers; the bound is rounded up to a
+// multiple of the shard count.
+func NewConversationKeyCache(seckey []byte, capacity int) (*ConversationKeyCache, error) {
+	if len(seckey) != 32 {
+		return nil, errors.New("seckey must be 32 bytes")
+	}
+	if !ECSeckeyVerify(seckey) {
+		return nil, errors.New("invalid secret key")
+	}
+	c := &ConversationKeyCache{seed: maphash.MakeSeed()}
+	copy(c.seckey[:], seckey)
+	c.cache.init(conversationKeyCacheShards, capacity, wipeConversationKey)
+	return c, nil
+}
+
+// ConversationKey sets the 32 byte out32 to NIP44ConversationKey of the
+// cache's secret key and peerX32, computing and caching it on a miss
+func (c *ConversationKeyCache) ConversationKey(out32 []byte, peerX32 []byte) error {
+	if len(out32) != 32 {
+		return errors.New("output must be 32 bytes")
+	}
+	if len(peerX32) != 32 {
+		return errors.New("public key must be 32 bytes")
+	}
+	peer := (*[32]byte)(peerX32)
+	sh := c.cache.shard(maphash.Bytes(c.seed, peer[:]))
+	if sh.lookup(peer, (*[32]byte)(out32)) {
+		return nil
+	}
+
+	// Derive outside the shard lock; a concurrent miss on the same peer just
+	// does the work twice
+	c.mu.RLock()
+	defer c.mu.RUnlock()
+	if c.closed {
+		return errors.New("conversation key cache is cleared")
+	}
+	if err := NIP44ConversationKey(out32, c.seckey[:], peerX32); err != nil {
+		return err
+	}
+
+	c.cache.insert(sh, peer, (*[32]byte)(out32))
+	return nil
+}
+
+// Stats returns the hit and miss counts and the number of cached peers
+func (c *ConversationKeyCache) Stats() ConversationKeyCacheStats {
+	return c.cache.stats()
+}
+
+// Clear wipes the secret key and all cached conversation keys, after
+// waiting for the misses in flight. The cache returns errors afterwards.
+func (c *ConversationKeyCache) Clear() {
+	c.mu.Lock()
+	defer c.mu.Unlock()
+	c.closed = true
+	c.cache.clear()
+	memclear(unsafe.Pointer(&c.seckey[0]), 32)
+}
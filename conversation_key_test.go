@@ -0,0 +1,206 @@
+package p256k1
+
+import (
+	"bytes"
+	"encoding/hex"
+	"sync"
+	"testing"
+)
+
+func TestNIP44ConversationKey(t *testing.T) {
+	// From the NIP-44 test vectors: sec1 = 1 with the public key of sec2 = 2
+	sec1 := make([]byte, 32)
+	sec1[31] = 1
+	pub2, _ := hex.DecodeString("c6047f9441ed7d6d3045406e95c07cd85c778e4b8cef3ca7abac09b95c709ee5")
+	want := "c41c775356fd92eadc63ff5a0dc1da211b268cbea22316767095b2871ea1412d"
+
+	out := make([]byte, 32)
+	if err := NIP44ConversationKey(out, sec1, pub2); err != nil {
+		t.Fatal(err)
+	}
+	if hex.EncodeToString(out) != want {
+		t.Errorf("conversation key = %x, want %s", out, want)
+	}
+	if err := NIP44ConversationKey(out, sec1, make([]byte, 32)); err == nil {
+		t.Error("accepted a public key that is not on the curve")
+	}
+}
+
+func TestConversationKeyCache(t *testing.T) {
+	seckey, _, err := ECKeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	peers := make([][]byte, 8)
+	for i := range peers {
+		kp, err := KeyPairGenerate()
+		if err != nil {
+			t.Fatal(err)
+		}
+		xonly, err := kp.XOnlyPubkey()
+		if err != nil {
+			t.Fatal(err)
+		}
+		x := xonly.Serialize()
+		peers[i] = x[:]
+	}
+
+	c, err := NewConversationKeyCache(seckey, 64)
+	if err != nil {
+		t.Fatal(err)
+	}
+	got := make([]byte, 32)
+	want := make([]byte, 32)
+	for round := 0; round < 3; round++ {
+		for i, peer := range peers {
+			if err := c.ConversationKey(got, peer); err != nil {
+				t.Fatal(err)
+			}
+			if err := NIP44ConversationKey(want, seckey, peer); err != nil {
+				t.Fatal(err)
+			}
+			if !bytes.Equal(got, want) {
+				t.Fatalf("round %d: cached key for peer %d differs", round, i)
+			}
+		}
+	}
+	if st := c.Stats(); st.Misses != 8 || st.Hits != 16 || st.Entries != 8 {
+		t.Errorf("stats = %+v, want 8 misses, 16 hits, 8 entries", st)
+	}
+	if err := c.ConversationKey(got, make([]byte, 32)); err == nil {
+		t.Error("accepted a public key that is not on the curve")
+	}
+	if st := c.Stats(); st.Entries != 8 {
+		t.Errorf("invalid key was cached: %+v", st)
+	}
+
+	c.Clear()
+	if st := c.Stats(); st.Entries != 0 {
+		t.Errorf("Clear left %d entries", st.Entries)
+	}
+	if err := c.ConversationKey(got, peers[0]); err == nil {
+		t.Error("cleared cache derived a key")
+	}
+
+	if _, err := NewConversationKeyCache(make([]byte, 32), 64); err == nil {
+		t.Error("accepted a zero secret key")
+	}
+}
+
+// TestConversationKeyCacheClearRace clears a cache while misses are in
+// flight, which must not leave keys derived before Clear in the cache
+func TestConversationKeyCacheClearRace(t *testing.T) {
+	seckey, _, err := ECKeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	peers := make([][]byte, 64)
+	for i := range peers {
+		kp, err := KeyPairGenerate()
+		if err != nil {
+			t.Fatal(err)
+		}
+		xonly, _ := kp.XOnlyPubkey()
+		x := xonly.Serialize()
+		peers[i] = x[:]
+	}
+
+	for round := 0; round < 10; round++ {
+		c, err := NewConversationKeyCache(seckey, len(peers))
+		if err != nil {
+			t.Fatal(err)
+		}
+		var wg sync.WaitGroup
+		for g := 0; g < 4; g++ {
+			wg.Add(1)
+			go func(g int) {
+				defer wg.Done()
+				got := make([]byte, 32)
+				for i := g; i < len(peers); i += 4 {
+					if c.ConversationKey(got, peers[i]) != nil {
+						return
+					}
+				}
+			}(g)
+		}
+		c.Clear()
+		wg.Wait()
+		if st := c.Stats(); st.Entries != 0 {
+			t.Fatalf("round %d: %d entries outlived Clear", round, st.Entries)
+		}
+	}
+}
+
+func TestConversationKeyCacheEviction(t *testing.T) {
+	seckey, _, err := ECKeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	c, err := NewConversationKeyCache(seckey, conversationKeyCacheShards)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	var wg sync.WaitGroup
+	for g := 0; g < 4; g++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			got := make([]byte, 32)
+			want := make([]byte, 32)
+			for i := 0; i < 25; i++ {
+				kp, err := KeyPairGenerate()
+				if err != nil {
+					t.Error(err)
+					return
+				}
+				xonly, _ := kp.XOnlyPubkey()
+				x := xonly.Serialize()
+				peer := x[:]
+				if err := c.ConversationKey(got, peer); err != nil {
+					t.Error(err)
+					return
+				}
+				NIP44ConversationKey(want, seckey, peer)
+				if !bytes.Equal(got, want) {
+					t.Error("cached key differs")
+					return
+				}
+			}
+		}()
+	}
+	wg.Wait()
+	if st := c.Stats(); st.Entries > conversationKeyCacheShards {
+		t.Errorf("cache holds %d entries, bound is %d", st.Entries, conversationKeyCacheShards)
+	}
+}
+
+func BenchmarkConversationKey(b *testing.B) {
+	seckey, _, _ := ECKeyPairGenerate()
+	kp, _ := KeyPairGenerate()
+	xonly, _ := kp.XOnlyPubkey()
+	x := xonly.Serialize()
+	peer := x[:]
+	out := make([]byte, 32)
+
+	b.Run("uncached", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			NIP44ConversationKey(out, seckey, peer)
+		}
+	})
+	b.Run("cached", func(b *testing.B) {
+		c, _ := NewConversationKeyCache(seckey, 1024)
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			c.ConversationKey(out, peer)
+		}
+	})
+	b.Run("hkdf", func(b *testing.B) {
+		okm := make([]byte, 76)
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			HKDF(okm, out, nip44Salt, peer)
+		}
+	})
+}
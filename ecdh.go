@@ -2,138 +2,57 @@ package p256k1
 
 import (
 	"errors"
-	"fmt"
 	"unsafe"
 )
 
 const (
-	// Window sizes for elliptic curve multiplication optimizations
-	windowA = 5  // Window size for main scalar (A)
-	windowG = 14 // Window size for generator (G) - larger for better performance
+	// Window size for elliptic curve multiplication optimizations; the
+	// generator window windowG is set per table profile (tables_default.go,
+	// tables_small.go)
+	windowA = 5 // Window size for main scalar (A)
 )
 
-// EcmultConst computes r = q * a using constant-time multiplication
-// Uses simple binary method
-func EcmultConst(r *GroupElementJacobian, a *GroupElementAffine, q *Scalar) {
-	if a.isInfinity() {
-		r.setInfinity()
-		return
-	}
-	
-	if q.isZero() {
-		r.setInfinity()
-		return
-	}
-	
-	// Convert affine point to Jacobian
-	var aJac GroupElementJacobian
-	aJac.setGE(a)
-	
-	// Use simple binary method for constant-time behavior
-	r.setInfinity()
-	
-	var base GroupElementJacobian
-	base = aJac
-	
-	// Process bits from MSB to LSB
-	for i := 0; i < 256; i++ {
-		if i > 0 {
-			r.double(r)
-		}
-		
-		// Get bit i (from MSB)
-		bit := q.getBits(uint(255-i), 1)
-		if bit != 0 {
-			if r.isInfinity() {
-				*r = base
-			} else {
-				r.addVar(r, &base)
-			}
-		}
-	}
-}
-
-// ecmultWindowedVar computes r = q * a using optimized windowed multiplication (variable-time)
-// Uses a window size of 6 bits (64 precomputed multiples) for better CPU performance
-// Trades memory (64 entries vs 32) for ~20% faster multiplication
+// ecmultWindowedVar computes r = q * a in variable time from the signed wNAF
+// of the whole 256-bit scalar, with an affine table of only the odd
+// multiples of a; negative digits add the negated entry. It does not use the
+// endomorphism, so it takes twice the doublings of Ecmult, and it serves as
+// the independent reference for the GLV paths.
 func ecmultWindowedVar(r *GroupElementJacobian, a *GroupElementAffine, q *Scalar) {
-	if a.isInfinity() {
-		r.setInfinity()
-		return
-	}
-	
-	if q.isZero() {
+	if a.isInfinity() || q.isZero() {
 		r.setInfinity()
 		return
 	}
-	
-	const windowSize = 6  // Increased from 5 to 6 for better performance
-	const tableSize = 1 << windowSize // 64
-	
-	// Convert point to Jacobian once
-	var aJac GroupElementJacobian
-	aJac.setGE(a)
-	
-	// Build table efficiently using Jacobian coordinates, only convert to affine at end
-	// Store odd multiples in Jacobian form to avoid frequent conversions
+
+	// table[i] = (2*i+1) * a, made affine with a single batch inversion. No
+	// odd multiple below 2^windowA of a valid point is infinity.
+	const tableSize = 1 << (windowA - 2)
 	var tableJac [tableSize]GroupElementJacobian
-	tableJac[0].setInfinity()
-	tableJac[1] = aJac
-	
-	// Build odd multiples efficiently: tableJac[2*i+1] = (2*i+1) * a
-	// Start with 3*a = a + 2*a
+	var table [tableSize]GroupElementAffine
 	var twoA GroupElementJacobian
-	twoA.double(&aJac)
-	
-	// Build table: tableJac[i] = tableJac[i-2] + 2*a for odd i
-	for i := 3; i < tableSize; i += 2 {
-		tableJac[i].addVar(&tableJac[i-2], &twoA)
-	}
-	
-	// Build even multiples: tableJac[2*i] = 2 * tableJac[i]
-	for i := 1; i < tableSize/2; i++ {
-		tableJac[2*i].double(&tableJac[i])
+	tableJac[0].setGE(a)
+	twoA.double(&tableJac[0])
+	for i := 1; i < tableSize; i++ {
+		tableJac[i].addVar(&tableJac[i-1], &twoA)
 	}
-	
-	// Process scalar in windows of 6 bits from MSB to LSB
+	geSetAllGEJVar(table[:], tableJac[:])
+
+	var wnaf [256]int
+	var t GroupElementAffine
+	bits := q.wNAF(wnaf[:], windowA)
 	r.setInfinity()
-	numWindows := (256 + windowSize - 1) / windowSize // Ceiling division
-	
-	for window := 0; window < numWindows; window++ {
-		// Calculate bit offset for this window (MSB first)
-		bitOffset := 255 - window*windowSize
-		if bitOffset < 0 {
-			break
-		}
-		
-		// Extract window bits
-		actualWindowSize := windowSize
-		if bitOffset < windowSize-1 {
-			actualWindowSize = bitOffset + 1
-		}
-		
-		windowBits := q.getBits(uint(bitOffset-actualWindowSize+1), uint(actualWindowSize))
-		
-		// Double result windowSize times (once per bit position in window)
-		if !r.isInfinity() {
-			for j := 0; j < actualWindowSize; j++ {
-				r.double(r)
-			}
-		}
-		
-		// Add precomputed point if window is non-zero
-		if windowBits != 0 && windowBits < tableSize {
-			if r.isInfinity() {
-				*r = tableJac[windowBits]
-			} else {
-				r.addVar(r, &tableJac[windowBits])
-			}
+	for i := bits - 1; i >= 0; i-- {
+		r.double(r)
+		if n := wnaf[i]; n != 0 {
+			ecmultTableGetGE(&t, table[:], n)
+			r.addGE(r, &t)
 		}
 	}
 }
 
-// Ecmult computes r = q * a using optimized windowed multiplication
-// This provides good performance for verification and ECDH operations
+// Ecmult computes r = q * a in variable time. The scalar is split with the
+// GLV endomorphism and q1*a + q2*(lambda*a) is evaluated with one shared
+// chain of ~128 doublings, so q must not be secret; use EcmultConst for
+// secret scalars.
 func Ecmult(r *GroupElementJacobian, a *GroupElementJacobian, q *Scalar) {
 	if a.isInfinity() {
 		r.setInfinity()
@@ -145,87 +64,20 @@ func Ecmult(r *GroupElementJacobian, a *GroupElementJacobian, q *Scalar) {
 		return
 	}
 
-	// Convert to affine for windowed multiplication
-	var aAff GroupElementAffine
-	aAff.setGEJ(a)
-
-	// Use optimized windowed multiplication
-	ecmultWindowedVar(r, &aAff, q)
+	ecmultStrauss(r, a, q, nil)
 }
 
-// ecmultStraussGLV computes r = q * a using Strauss algorithm with GLV endomorphism
-// This provides significant speedup for both verification and ECDH operations
+// ecmultStraussGLV computes r = q * a for an affine a, in variable time, with
+// the GLV split of ecmultStrauss
 func ecmultStraussGLV(r *GroupElementJacobian, a *GroupElementAffine, q *Scalar) {
 	if a.isInfinity() {
 		r.setInfinity()
 		return
 	}
 
-	if q.isZero() {
-		r.setInfinity()
-		return
-	}
-
-	// For now, use simplified Strauss algorithm without GLV endomorphism
-	// Convert base point to Jacobian
 	var aJac GroupElementJacobian
 	aJac.setGE(a)
-
-	// Compute odd multiples for the scalar
-	var preA [1 << (windowA - 1)]GroupElementJacobian
-	buildOddMultiples(&preA, &aJac, windowA)
-
-	// Convert scalar to wNAF representation
-	var wnaf [257]int
-	bits := q.wNAF(wnaf[:], windowA)
-
-	// Perform Strauss algorithm
-	r.setInfinity()
-
-	for i := bits - 1; i >= 0; i-- {
-		// Double the result
-		r.double(r)
-
-		// Add contribution
-		if wnaf[i] != 0 {
-			n := wnaf[i]
-			var pt GroupElementJacobian
-			if n > 0 {
-				idx := (n-1)/2
-				if idx >= len(preA) {
-					panic(fmt.Sprintf("wNAF positive index out of bounds: n=%d, idx=%d, len=%d", n, idx, len(preA)))
-				}
-				pt = preA[idx]
-			} else {
-				if (-n-1)/2 >= len(preA) {
-					panic("wNAF index out of bounds (negative)")
-				}
-				pt = preA[(-n-1)/2]
-				pt.y.negate(&pt.y, 1)
-			}
-			r.addVar(r, &pt)
-		}
-	}
-}
-
-// buildOddMultiples builds a table of odd multiples of a point
-// pre[i] = (2*i+1) * a for i = 0 to (1<<(w-1))-1
-func buildOddMultiples(pre *[1 << (windowA - 1)]GroupElementJacobian, a *GroupElementJacobian, w uint) {
-	tableSize := 1 << (w - 1)
-
-	// pre[0] = a (which is 1*a)
-	pre[0] = *a
-
-	if tableSize > 1 {
-		// Compute 2*a
-		var twoA GroupElementJacobian
-		twoA.double(a)
-
-		// Build odd multiples: pre[i] = pre[i-2] + 2*a for i >= 2, i even
-		for i := 2; i < tableSize; i += 2 {
-			pre[i].addVar(&pre[i-2], &twoA)
-		}
-	}
+	Ecmult(r, &aJac, q)
 }
 
 // EcmultStraussGLV is the public interface for optimized Strauss+GLV multiplication
@@ -256,8 +108,13 @@ func ecdhHashFunctionSHA256(output []byte, x32 []byte, y32 []byte) bool {
 }
 
 // ECDH computes an EC Diffie-Hellman shared secret
-// Following the C reference implementation secp256k1_ecdh
-func ECDH(output []byte, pubkey *PublicKey, seckey []byte, hashfp ECDHHashFunction) error {
+// Following the C reference implementation secp256k1_ecdh. With a nil hashfp
+// the output is SHA-256(0x02 | parity(y) || x) of the shared point, as
+// ECDHBatch; ECDHX and ECDHBatchX return the raw x instead.
+func ECDH(output []byte, pubkey *PublicKey, seckey []byte, hashfp ECDHHashFunction) (err error) {
+	if metricsEnabled {
+		defer metricsDoneErr(metricECDH, metricsStart(), &err)
+	}
 	if len(output) != 32 {
 		return errors.New("output must be 32 bytes")
 	}
@@ -291,10 +148,9 @@ func ECDH(output []byte, pubkey *PublicKey, seckey []byte, hashfp ECDHHashFuncti
 		return errors.New("secret key cannot be zero")
 	}
 
-	// Compute res = s * pt using optimized windowed multiplication (variable-time)
-	// ECDH doesn't require constant-time since the secret key is already known
+	// Compute res = s * pt in constant time, as s is the secret key
 	var res GroupElementJacobian
-	ecmultWindowedVar(&res, &pt, &s)
+	EcmultConst(&res, &pt, &s)
 	
 	// Convert to affine
 	var resAff GroupElementAffine
@@ -324,75 +180,213 @@ func ECDH(output []byte, pubkey *PublicKey, seckey []byte, hashfp ECDHHashFuncti
 	return nil
 }
 
+// ecdhBatchChunk is the number of shared points converted to affine with one
+// inversion
+const ecdhBatchChunk = 64
+
+// ECDHBatch computes the shared secrets of seckey with each 32-byte x-only
+// public key in xonlyPubs, writing 32 bytes to each of outs. outs[i] equals
+// the ECDH output with the default hash for the even-y point whose x
+// coordinate is xonlyPubs[i], that is the SHA-256 of the parity of y and x of
+// the shared point; ECDHBatchX returns the raw x instead. The recoding of the
+// secret scalar is done once for the whole batch, and the shared points are
+// converted to affine with one constant time inversion per ecdhBatchChunk
+// keys. If an error is returned, none of the outputs may be used.
+func ECDHBatch(seckey []byte, xonlyPubs [][]byte, outs [][]byte) error {
+	return ecdhBatch(seckey, xonlyPubs, outs, true, fieldLanesVector)
+}
+
+// ECDHBatchX is ECDHBatch writing the raw 32-byte x coordinate of every
+// shared point, unhashed, so outs[i] equals the output of ECDHX for
+// xonlyPubs[i]. This is the shared secret of NIP-04 and NIP-44.
+func ECDHBatchX(seckey []byte, xonlyPubs [][]byte, outs [][]byte) error {
+	return ecdhBatch(seckey, xonlyPubs, outs, false, fieldLanesVector)
+}
+
+// ecdhBatch implements ECDHBatch, hashing the shared points if hashed is set
+// and writing their x coordinates otherwise, and lifting the keys with an
+// xLifter if lanes is set
+func ecdhBatch(seckey []byte, xonlyPubs [][]byte, outs [][]byte, hashed, lanes bool) error {
+	if len(seckey) != 32 {
+		return errors.New("seckey must be 32 bytes")
+	}
+	if len(outs) != len(xonlyPubs) {
+		return errors.New("xonlyPubs and outs must have the same length")
+	}
+	for i := range xonlyPubs {
+		if len(xonlyPubs[i]) != 32 {
+			return errors.New("public key must be 32 bytes")
+		}
+		if len(outs[i]) != 32 {
+			return errors.New("output must be 32 bytes")
+		}
+	}
+
+	var s, v1, v2 Scalar
+	if !s.setB32Seckey(seckey) {
+		return errors.New("invalid secret key")
+	}
+	ecmultConstRecode(&v1, &v2, &s)
+	s.clear()
+
+	var pts [ecdhBatchChunk]GroupElementAffine
+	var l xLifter
+	var res [ecdhBatchChunk]GroupElementJacobian
+	var resAff [ecdhBatchChunk]GroupElementAffine
+	var x, y [32]byte
+	defer func() {
+		v1.clear()
+		v2.clear()
+		memclear(unsafe.Pointer(&res[0]), unsafe.Sizeof(res))
+		memclear(unsafe.Pointer(&resAff[0]), unsafe.Sizeof(resAff))
+		memclear(unsafe.Pointer(&x[0]), 32)
+		memclear(unsafe.Pointer(&y[0]), 32)
+	}()
+
+	for lo := 0; lo < len(xonlyPubs); lo += ecdhBatchChunk {
+		n := len(xonlyPubs) - lo
+		if n > ecdhBatchChunk {
+			n = ecdhBatchChunk
+		}
+
+		// Lift the keys, fieldLaneCount square roots at a time with lanes
+		for i := 0; i < n; i++ {
+			if !lanes {
+				if !xonlyPubkeyLoad(&pts[i], (*[32]byte)(xonlyPubs[lo+i])) {
+					return errors.New("invalid public key")
+				}
+				continue
+			}
+			var x FieldElement
+			if !x.setB32Limit(xonlyPubs[lo+i]) {
+				return errors.New("invalid public key")
+			}
+			if l.add(i, &x, false) || i == n-1 {
+				l.lift()
+				for j := 0; j < l.n; j++ {
+					if !l.ok[j] {
+						return errors.New("invalid public key")
+					}
+					pts[l.idx[j]] = l.points[j]
+				}
+				l.n = 0
+			}
+		}
+		for i := 0; i < n; i++ {
+			ecmultConstRecoded(&res[i], &pts[i], &v1, &v2)
+		}
+
+		// A nonzero multiple of a valid point is never infinity
+		geSetAllGEJ(resAff[:n], res[:n])
+		for i := 0; i < n; i++ {
+			resAff[i].x.normalize()
+			if !hashed {
+				resAff[i].x.getB32(outs[lo+i])
+				continue
+			}
+			resAff[i].y.normalize()
+			resAff[i].x.getB32(x[:])
+			resAff[i].y.getB32(y[:])
+			ecdhHashFunctionSHA256(outs[lo+i], x[:], y[:])
+		}
+	}
+	return nil
+}
+
+// hkdfMaxOutput is the longest output of HKDF-Expand with SHA256, 255 blocks
+const hkdfMaxOutput = 255 * 32
+
 // HKDF performs HMAC-based Key Derivation Function (RFC 5869)
-// Outputs key material of the specified length
+// Outputs key material of the specified length, at most 8160 bytes
 func HKDF(output []byte, ikm []byte, salt []byte, info []byte) error {
 	if len(output) == 0 {
 		return errors.New("output length must be greater than 0")
 	}
-	
-	// Step 1: Extract (if salt is empty, use zeros)
-	if len(salt) == 0 {
-		salt = make([]byte, 32)
+	if len(output) > hkdfMaxOutput {
+		return errors.New("output length must be at most 8160 bytes")
 	}
-	
-	// PRK = HMAC-SHA256(salt, IKM)
+
+	h := taggedHasherPool.Get().(*taggedHasher)
 	var prk [32]byte
-	hmac := NewHMACSHA256(salt)
-	hmac.Write(ikm)
-	hmac.Finalize(prk[:])
-	hmac.Clear()
-	
-	// Step 2: Expand
-	// Generate output using HKDF-Expand
-	// T(0) = empty
-	// T(i) = HMAC(PRK, T(i-1) || info || i)
-	
-	outlen := len(output)
-	outidx := 0
-	
-	// T(0) is empty
-	var t []byte
-	
-	// Generate blocks until we have enough output
-	blockNum := byte(1)
-	for outidx < outlen {
-		// Compute T(i) = HMAC(PRK, T(i-1) || info || i)
-		hmac = NewHMACSHA256(prk[:])
-		if len(t) > 0 {
-			hmac.Write(t)
-		}
-		if len(info) > 0 {
-			hmac.Write(info)
-		}
-		hmac.Write([]byte{blockNum})
-		
-		var tBlock [32]byte
-		hmac.Finalize(tBlock[:])
-		hmac.Clear()
-		
-		// Copy to output
-		copyLen := len(tBlock)
-		if copyLen > outlen-outidx {
-			copyLen = outlen - outidx
-		}
-		copy(output[outidx:outidx+copyLen], tBlock[:copyLen])
-		outidx += copyLen
-		
-		// Update T for next iteration
-		t = tBlock[:]
-		blockNum++
-	}
-	
-	// Clear sensitive data
+	var key hmacSHA256Key
+	hkdfExtract(h, &prk, salt, ikm)
+	key.init(h, prk[:])
+	hkdfExpand(h, output, &key, info)
+
+	key.clear()
 	memclear(unsafe.Pointer(&prk[0]), 32)
-	if len(t) > 0 {
-		memclear(unsafe.Pointer(&t[0]), uintptr(len(t)))
+	h.clearState()
+	taggedHasherPool.Put(h)
+	return nil
+}
+
+// HKDFExtract sets the 32 byte prk to the pseudorandom key of HKDF-Extract
+// (RFC 5869) with SHA256, HMAC-SHA256(salt, ikm). An empty salt is the same
+// as 32 zero bytes.
+func HKDFExtract(prk []byte, salt []byte, ikm []byte) error {
+	if len(prk) != 32 {
+		return errors.New("prk must be 32 bytes")
+	}
+	h := taggedHasherPool.Get().(*taggedHasher)
+	hkdfExtract(h, (*[32]byte)(prk), salt, ikm)
+	h.clearState()
+	taggedHasherPool.Put(h)
+	return nil
+}
+
+// HKDFExpand fills output, at most 8160 bytes, with HKDF-Expand (RFC 5869)
+// with SHA256 of the 32 byte prk and info
+func HKDFExpand(output []byte, prk []byte, info []byte) error {
+	if len(prk) != 32 {
+		return errors.New("prk must be 32 bytes")
 	}
-	
+	if len(output) == 0 {
+		return errors.New("output length must be greater than 0")
+	}
+	if len(output) > hkdfMaxOutput {
+		return errors.New("output length must be at most 8160 bytes")
+	}
+	h := taggedHasherPool.Get().(*taggedHasher)
+	var key hmacSHA256Key
+	key.init(h, prk)
+	hkdfExpand(h, output, &key, info)
+	key.clear()
+	h.clearState()
+	taggedHasherPool.Put(h)
 	return nil
 }
 
+// hkdfExtract sets prk = HMAC-SHA256(salt, ikm). HMAC pads its key with
+// zeros, so the empty salt needs no explicit 32 zero bytes.
+func hkdfExtract(h *taggedHasher, prk *[32]byte, salt []byte, ikm []byte) {
+	var key hmacSHA256Key
+	key.init(h, salt)
+	key.start(h)
+	h.write(ikm)
+	key.finish(h, prk[:])
+	key.clear()
+}
+
+// hkdfExpand fills output with T(1) || T(2) || ..., where T(0) is empty and
+// T(i) = HMAC(PRK, T(i-1) || info || i). Every block restores the padded
+// PRK from key rather than preparing the HMAC key again.
+func hkdfExpand(h *taggedHasher, output []byte, key *hmacSHA256Key, info []byte) {
+	var t [32]byte
+	counter := [1]byte{1}
+	for i := 0; len(output) > 0; i++ {
+		key.start(h)
+		if i > 0 {
+			h.write(t[:])
+		}
+		h.write(info)
+		h.write(counter[:])
+		key.finish(h, t[:])
+		output = output[copy(output, t[:]):]
+		counter[0]++
+	}
+	memclear(unsafe.Pointer(&t[0]), 32)
+}
+
 // ECDHWithHKDF computes ECDH and derives a key using HKDF
 func ECDHWithHKDF(output []byte, pubkey *PublicKey, seckey []byte, salt []byte, info []byte) error {
 	// Compute ECDH shared secret
@@ -410,6 +404,45 @@ func ECDHWithHKDF(output []byte, pubkey *PublicKey, seckey []byte, salt []byte,
 	return err
 }
 
+// ECDHX computes the x coordinate of seckey*P into output, where x32 is the
+// 32 byte x coordinate of P, as used by NIP-44. The output is the raw x,
+// not hashed as by ECDH and ECDHBatch; ECDHBatchX is its batch form. Either point with that x
+// gives the same result, so P is never lifted with a square root; the
+// multiplication runs on the fractional x form of
+// secp256k1_ecmult_const_xonly. An x32 that is not on the curve is
+// rejected, as it would otherwise select a point on the twist.
+func ECDHX(output []byte, x32 []byte, seckey []byte) (err error) {
+	if metricsEnabled {
+		defer metricsDoneErr(metricECDH, metricsStart(), &err)
+	}
+	if len(output) != 32 {
+		return errors.New("output must be 32 bytes")
+	}
+	if len(x32) != 32 {
+		return errors.New("public key must be 32 bytes")
+	}
+	if len(seckey) != 32 {
+		return errors.New("seckey must be 32 bytes")
+	}
+
+	var x, r FieldElement
+	if !x.setB32Limit(x32) {
+		return errors.New("invalid public key")
+	}
+	var s Scalar
+	if !s.setB32Seckey(seckey) {
+		return errors.New("invalid secret key")
+	}
+	ok := ecmultConstXOnly(&r, &x, nil, &s, false)
+	s.clear()
+	if !ok {
+		return errors.New("invalid public key")
+	}
+	r.getB32(output)
+	r.clear()
+	return nil
+}
+
 // ECDHXOnly computes X-only ECDH (BIP-340 style)
 // Outputs only the X coordinate of the shared secret point
 func ECDHXOnly(output []byte, pubkey *PublicKey, seckey []byte) error {
@@ -440,25 +473,109 @@ func ECDHXOnly(output []byte, pubkey *PublicKey, seckey []byte) error {
 		return errors.New("secret key cannot be zero")
 	}
 	
-	// Compute res = s * pt using optimized windowed multiplication (variable-time)
-	// ECDH doesn't require constant-time since the secret key is already known
-	var res GroupElementJacobian
-	ecmultWindowedVar(&res, &pt, &s)
-	
-	// Convert to affine
-	var resAff GroupElementAffine
-	resAff.setGEJ(&res)
-	resAff.x.normalize()
+	// Compute the x coordinate of s * pt in constant time. Only x is needed,
+	// so the y coordinate of the result is never recovered.
+	var x FieldElement
+	ecmultConstXOnly(&x, &pt.x, nil, &s, true)
 	
 	// Extract X coordinate only
-	resAff.x.getB32(output)
+	x.getB32(output)
 	
 	// Clear sensitive data
 	s.clear()
-	resAff.clear()
-	res.clear()
+	x.clear()
 	
 	return nil
 }
 
+// EllSwiftXDHHashFunction derives the shared secret of EllSwiftXDH into
+// output from the shared x coordinate x32 and the 64 byte ElligatorSwift
+// encodings of the initiating party A and the responding party B
+type EllSwiftXDHHashFunction func(output []byte, x32, ellA64, ellB64 []byte) bool
+
+// EllSwiftXDHHashFunctionBIP324 is the BIP324 hash, the tagged hash
+// "bip324_ellswift_xonly_ecdh" of ellA64 || ellB64 || x32
+func EllSwiftXDHHashFunctionBIP324(output []byte, x32, ellA64, ellB64 []byte) bool {
+	ellswiftMidstateOnce.Do(initEllswiftMidstates)
+	h := getTaggedHasher(ellswiftBIP324Midstate)
+	h.write(ellA64)
+	h.write(ellB64)
+	h.write(x32)
+	h.sum(output)
+	h.clearState()
+	taggedHasherPool.Put(h)
+	return true
+}
+
+// EllSwiftXDHHashFunctionPrefix returns the hash that computes
+// SHA256(prefix64 || ellA64 || ellB64 || x32), as
+// secp256k1_ellswift_xdh_hash_function_prefix, for a 64 byte prefix
+func EllSwiftXDHHashFunctionPrefix(prefix64 []byte) EllSwiftXDHHashFunction {
+	prefix := append([]byte(nil), prefix64...)
+	return func(output []byte, x32, ellA64, ellB64 []byte) bool {
+		if len(prefix) != 64 {
+			return false
+		}
+		sha := NewSHA256()
+		sha.Write(prefix)
+		sha.Write(ellA64)
+		sha.Write(ellB64)
+		sha.Write(x32)
+		sha.Finalize(output)
+		sha.Clear()
+		return true
+	}
+}
+
+// EllSwiftXDH computes the x-only ECDH secret of a BIP324-style handshake
+// between A with encoding ellA64 and B with encoding ellB64, where seckey
+// is the secret key of A if party is false and of B if it is true. The
+// other party's encoding is decoded to a fractional x coordinate and
+// multiplied by secp256k1_ecmult_const_xonly, so neither an inversion nor a
+// square root is spent on it. A nil hashfp selects
+// EllSwiftXDHHashFunctionBIP324.
+func EllSwiftXDH(output []byte, ellA64, ellB64 []byte, seckey []byte, party bool, hashfp EllSwiftXDHHashFunction) (err error) {
+	if metricsEnabled {
+		defer metricsDoneErr(metricECDH, metricsStart(), &err)
+	}
+	if len(output) != 32 {
+		return errors.New("output must be 32 bytes")
+	}
+	if len(ellA64) != 64 || len(ellB64) != 64 {
+		return errors.New("encodings must be 64 bytes")
+	}
+	if len(seckey) != 32 {
+		return errors.New("seckey must be 32 bytes")
+	}
+	if hashfp == nil {
+		hashfp = EllSwiftXDHHashFunctionBIP324
+	}
+
+	theirs := ellB64
+	if party {
+		theirs = ellA64
+	}
+	var u, t, xn, xd, x FieldElement
+	u.setB32(theirs[:32])
+	t.setB32(theirs[32:])
+	ellswiftXSwiftECFrac(&xn, &xd, &u, &t)
+
+	var s Scalar
+	if !s.setB32Seckey(seckey) {
+		return errors.New("invalid secret key")
+	}
+	ecmultConstXOnly(&x, &xn, &xd, &s, true)
+	s.clear()
+
+	var x32 [32]byte
+	x.getB32(x32[:])
+	x.clear()
+	ok := hashfp(output, x32[:], ellA64, ellB64)
+	memclear(unsafe.Pointer(&x32[0]), uintptr(len(x32)))
+	if !ok {
+		return errors.New("hash function failed")
+	}
+	return nil
+}
+
 
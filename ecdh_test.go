@@ -1,6 +1,8 @@
 package p256k1
 
 import (
+	"crypto/sha256"
+	"encoding/hex"
 	"testing"
 )
 
@@ -73,6 +75,41 @@ func TestEcmult(t *testing.T) {
 	}
 }
 
+func TestEcmultGLV(t *testing.T) {
+	var minusOne, lambdaNeg Scalar
+	minusOne.negate(&ScalarOne)
+	lambdaNeg.negate(&secp256k1Lambda)
+	scalars := []Scalar{ScalarOne, minusOne, secp256k1Lambda, lambdaNeg}
+	for i := 0; i < 16; i++ {
+		scalars = append(scalars, randomScalar(t))
+	}
+
+	for iter := 0; iter < 4; iter++ {
+		p := randomPoint(t)
+		var pj GroupElementJacobian
+		pj.setGE(&p)
+		pj.double(&pj) // non-trivial z
+		p.setGEJVar(&pj)
+		for i := range scalars {
+			var got, glv, want GroupElementJacobian
+			Ecmult(&got, &pj, &scalars[i])
+			EcmultStraussGLV(&glv, &p, &scalars[i])
+			ecmultWindowedVar(&want, &p, &scalars[i])
+			if !jacobianEqual(&got, &want) || !jacobianEqual(&glv, &want) {
+				t.Fatalf("GLV multiplication mismatch for scalar %x", scalars[i].d)
+			}
+		}
+	}
+
+	var r GroupElementJacobian
+	var pj GroupElementJacobian
+	pj.setGE(&Generator)
+	Ecmult(&r, &pj, &ScalarZero)
+	if !r.isInfinity() {
+		t.Error("0*P should be infinity")
+	}
+}
+
 func TestECDH(t *testing.T) {
 	// Generate two key pairs
 	seckey1, pubkey1, err := ECKeyPairGenerate()
@@ -220,6 +257,75 @@ func TestHKDF(t *testing.T) {
 	}
 }
 
+func TestHKDFVectors(t *testing.T) {
+	// RFC 5869 A.1, A.2 and A.3
+	vectors := []struct{ ikm, salt, info, prk, okm string }{
+		{
+			"0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b", "000102030405060708090a0b0c", "f0f1f2f3f4f5f6f7f8f9",
+			"077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5",
+			"3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865",
+		},
+		{
+			"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f404142434445464748494a4b4c4d4e4f",
+			"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9fa0a1a2a3a4a5a6a7a8a9aaabacadaeaf",
+			"b0b1b2b3b4b5b6b7b8b9babbbcbdbebfc0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedfe0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff",
+			"06a6b88c5853361a06104c9ceb35b45cef760014904671014a193f40c15fc244",
+			"b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c59045a99cac7827271cb41c65e590e09da3275600c2f09b8367793a9aca3db71cc30c58179ec3e87c14c01d5c1f3434f1d87",
+		},
+		{
+			"0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b", "", "",
+			"19ef24a32c717b167f33a91d6f648bdf96596776afdb6377ac434c1c293ccb04",
+			"8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d9d201395faa4b61a96c8",
+		},
+	}
+	unhex := func(s string) []byte {
+		b, err := hex.DecodeString(s)
+		if err != nil {
+			t.Fatal(err)
+		}
+		return b
+	}
+	for i, v := range vectors {
+		okm := make([]byte, len(v.okm)/2)
+		if err := HKDF(okm, unhex(v.ikm), unhex(v.salt), unhex(v.info)); err != nil {
+			t.Fatal(err)
+		}
+		if hex.EncodeToString(okm) != v.okm {
+			t.Errorf("vector %d: HKDF = %x", i, okm)
+		}
+
+		prk := make([]byte, 32)
+		if err := HKDFExtract(prk, unhex(v.salt), unhex(v.ikm)); err != nil {
+			t.Fatal(err)
+		}
+		if hex.EncodeToString(prk) != v.prk {
+			t.Errorf("vector %d: HKDFExtract = %x", i, prk)
+		}
+		clear(okm)
+		if err := HKDFExpand(okm, prk, unhex(v.info)); err != nil {
+			t.Fatal(err)
+		}
+		if hex.EncodeToString(okm) != v.okm {
+			t.Errorf("vector %d: HKDFExpand = %x", i, okm)
+		}
+	}
+
+	if err := HKDF(make([]byte, 255*32+1), nil, nil, nil); err == nil {
+		t.Error("HKDF accepted more than 255 blocks of output")
+	}
+
+	// Preparing the HMAC keys allocates nothing where sha256 states can be
+	// appended to a buffer
+	if _, ok := sha256.New().(binaryAppender); !ok {
+		return
+	}
+	ikm, salt, info := unhex(vectors[0].ikm), unhex(vectors[0].salt), unhex(vectors[0].info)
+	okm := make([]byte, 76)
+	if n := testing.AllocsPerRun(100, func() { HKDF(okm, ikm, salt, info) }); n != 0 {
+		t.Errorf("HKDF allocates %v times", n)
+	}
+}
+
 func TestECDHWithHKDF(t *testing.T) {
 	seckey1, pubkey1, err := ECKeyPairGenerate()
 	if err != nil {
@@ -281,3 +387,365 @@ func TestECDHXOnly(t *testing.T) {
 		}
 	}
 }
+
+func TestEcmultConstK(t *testing.T) {
+	// K = (2^130 - 2^129 - 1)*(1 + lambda) = (2^129 - 1)*(1 + lambda)
+	k := Scalar{d: [4]uint64{^uint64(0), ^uint64(0), 1, 0}}
+	var onePlusLambda Scalar
+	onePlusLambda.add(&ScalarOne, &secp256k1Lambda)
+	k.mul(&k, &onePlusLambda)
+	if !k.equal(&ecmultConstK) {
+		t.Fatalf("ecmultConstK mismatch: got %x, want %x", ecmultConstK.d, k.d)
+	}
+}
+
+func TestEcmultConstRandom(t *testing.T) {
+	var minusOne, minusK, offset, lambdaNeg Scalar
+	minusOne.negate(&ScalarOne)
+	minusK.negate(&ecmultConstK)
+	offset = ecmultConstSOffset
+	lambdaNeg.negate(&secp256k1Lambda)
+
+	scalars := []Scalar{ScalarZero, ScalarOne, minusOne, minusK, offset, secp256k1Lambda, lambdaNeg}
+	for i := 0; i < 32; i++ {
+		scalars = append(scalars, randomScalar(t))
+	}
+
+	points := []GroupElementAffine{Generator}
+	for i := 0; i < 4; i++ {
+		points = append(points, randomPoint(t))
+	}
+
+	for _, p := range points {
+		for i := range scalars {
+			q := scalars[i]
+			var got, want GroupElementJacobian
+			EcmultConst(&got, &p, &q)
+			ecmultWindowedVar(&want, &p, &q)
+			if !jacobianEqual(&got, &want) {
+				t.Fatalf("EcmultConst mismatch for scalar %x", q.d)
+			}
+		}
+	}
+
+	var inf GroupElementAffine
+	var r GroupElementJacobian
+	inf.setInfinity()
+	s := randomScalar(t)
+	EcmultConst(&r, &inf, &s)
+	if !r.isInfinity() {
+		t.Error("q*infinity should be infinity")
+	}
+}
+
+func TestEcmultConstXOnly(t *testing.T) {
+	for i := 0; i < 16; i++ {
+		p := randomPoint(t)
+		q := randomScalar(t)
+		if q.isZero() {
+			continue
+		}
+
+		var rj GroupElementJacobian
+		var want GroupElementAffine
+		EcmultConst(&rj, &p, &q)
+		want.setGEJ(&rj)
+		want.x.normalize()
+
+		// x given directly
+		var got FieldElement
+		if !ecmultConstXOnly(&got, &p.x, nil, &q, i%2 == 0) {
+			t.Fatal("ecmultConstXOnly rejected a valid x coordinate")
+		}
+		if !got.equal(&want.x) {
+			t.Fatal("ecmultConstXOnly mismatch with d == nil")
+		}
+
+		// x given as a fraction n/d
+		var d, n FieldElement
+		var b [32]byte
+		for d.setInt(0); d.isZero(); d.normalize() {
+			dBytes := randomScalar(t)
+			dBytes.getB32(b[:])
+			d.setB32(b[:])
+		}
+		n.mul(&p.x, &d)
+		if !ecmultConstXOnly(&got, &n, &d, &q, i%2 == 0) {
+			t.Fatal("ecmultConstXOnly rejected a valid fraction")
+		}
+		if !got.equal(&want.x) {
+			t.Fatal("ecmultConstXOnly mismatch with d != nil")
+		}
+	}
+
+	// Find x coordinates that are not on the curve and check they are
+	// rejected unless the caller vouches for them
+	rejected := 0
+	q := randomScalar(t)
+	for i := 1; rejected < 4; i++ {
+		var x, y2, seven, got FieldElement
+		x.setInt(i)
+		seven.setInt(7)
+		y2.sqr(&x)
+		y2.mul(&y2, &x)
+		y2.add(&seven)
+		if y2.isSquareVar() {
+			continue
+		}
+		if ecmultConstXOnly(&got, &x, nil, &q, false) {
+			t.Fatalf("x = %d is not on the curve but was accepted", i)
+		}
+		var d, n FieldElement
+		d.setInt(3)
+		n.mul(&x, &d)
+		if ecmultConstXOnly(&got, &n, &d, &q, false) {
+			t.Fatalf("x = %d/3 is not on the curve but was accepted", i)
+		}
+		rejected++
+	}
+}
+
+func BenchmarkEcmultConst(b *testing.B) {
+	p := randomPoint(b)
+	q := randomScalar(b)
+	var r GroupElementJacobian
+	var x FieldElement
+
+	b.Run("windowed_var", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			ecmultWindowedVar(&r, &p, &q)
+		}
+	})
+	b.Run("glv_var", func(b *testing.B) {
+		var pj GroupElementJacobian
+		pj.setGE(&p)
+		for i := 0; i < b.N; i++ {
+			Ecmult(&r, &pj, &q)
+		}
+	})
+	b.Run("const", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			EcmultConst(&r, &p, &q)
+		}
+	})
+	b.Run("const_xonly", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			ecmultConstXOnly(&x, &p.x, nil, &q, true)
+		}
+	})
+}
+
+// makeECDHBatch returns n x-only public keys and their output buffers
+func makeECDHBatch(tb testing.TB, n int) (pubs, outs [][]byte) {
+	pubs = make([][]byte, n)
+	outs = make([][]byte, n)
+	for i := range pubs {
+		kp, err := KeyPairGenerate()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		xonly, err := kp.XOnlyPubkey()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		pubs[i] = append([]byte(nil), xonly.data[:]...)
+		outs[i] = make([]byte, 32)
+	}
+	return pubs, outs
+}
+
+func TestECDHBatch(t *testing.T) {
+	seckey, _, err := ECKeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	pubs, outs := makeECDHBatch(t, ecdhBatchChunk+7)
+	if err := ECDHBatch(seckey, pubs, outs); err != nil {
+		t.Fatal(err)
+	}
+	for i := range pubs {
+		var pk PublicKey
+		var want [32]byte
+		if err := ECPubkeyParse(&pk, append([]byte{0x02}, pubs[i]...)); err != nil {
+			t.Fatal(err)
+		}
+		if err := ECDH(want[:], &pk, seckey, nil); err != nil {
+			t.Fatal(err)
+		}
+		if string(outs[i]) != string(want[:]) {
+			t.Fatalf("output %d differs from ECDH", i)
+		}
+	}
+
+	bad := make([]byte, 32)
+	for i := range bad {
+		bad[i] = 0xFF
+	}
+	pubs[3] = bad
+	if err := ECDHBatch(seckey, pubs, outs); err == nil {
+		t.Error("invalid public key accepted")
+	}
+	if err := ECDHBatch(make([]byte, 32), pubs[:1], outs[:1]); err == nil {
+		t.Error("zero secret key accepted")
+	}
+	if err := ECDHBatch(seckey, pubs, outs[1:]); err == nil {
+		t.Error("mismatched lengths accepted")
+	}
+}
+
+func TestECDHBatchX(t *testing.T) {
+	seckey, _, err := ECKeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	pubs, outs := makeECDHBatch(t, ecdhBatchChunk+7)
+	hashed := make([][]byte, len(pubs))
+	for i := range hashed {
+		hashed[i] = make([]byte, 32)
+	}
+	for _, lanes := range []bool{false, true} {
+		if err := ecdhBatch(seckey, pubs, outs, false, lanes); err != nil {
+			t.Fatal(err)
+		}
+		if err := ecdhBatch(seckey, pubs, hashed, true, lanes); err != nil {
+			t.Fatal(err)
+		}
+		for i := range pubs {
+			var want [32]byte
+			if err := ECDHX(want[:], pubs[i], seckey); err != nil {
+				t.Fatal(err)
+			}
+			if string(outs[i]) != string(want[:]) {
+				t.Fatalf("lanes = %v: output %d differs from ECDHX", lanes, i)
+			}
+			var pk PublicKey
+			ECPubkeyParse(&pk, append([]byte{0x02}, pubs[i]...))
+			ECDH(want[:], &pk, seckey, nil)
+			if string(hashed[i]) != string(want[:]) {
+				t.Fatalf("lanes = %v: hashed output %d differs from ECDH", lanes, i)
+			}
+		}
+	}
+
+	pubs[3] = make([]byte, 32) // x = 0 is not on the curve
+	for _, lanes := range []bool{false, true} {
+		if err := ecdhBatch(seckey, pubs, outs, false, lanes); err == nil {
+			t.Errorf("lanes = %v: invalid public key accepted", lanes)
+		}
+	}
+}
+
+func BenchmarkECDHBatch(b *testing.B) {
+	seckey, _, err := ECKeyPairGenerate()
+	if err != nil {
+		b.Fatal(err)
+	}
+	pubs, outs := makeECDHBatch(b, 256)
+
+	// Both include lifting the x-only keys
+	b.Run("ECDH", func(b *testing.B) {
+		var pk PublicKey
+		var compressed [33]byte
+		compressed[0] = 0x02
+		for i := 0; i < b.N; i++ {
+			for j := range pubs {
+				copy(compressed[1:], pubs[j])
+				if err := ECPubkeyParse(&pk, compressed[:]); err != nil {
+					b.Fatal(err)
+				}
+				ECDH(outs[j], &pk, seckey, nil)
+			}
+		}
+	})
+	b.Run("ECDHBatch", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			if err := ECDHBatch(seckey, pubs, outs); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("ECDHX", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for j := range pubs {
+				ECDHX(outs[j], pubs[j], seckey)
+			}
+		}
+	})
+	b.Run("ECDHBatchX", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			if err := ECDHBatchX(seckey, pubs, outs); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
+
+func TestECDHX(t *testing.T) {
+	seckey, _, err := ECKeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	var got, want [32]byte
+	x32 := make([]byte, 32)
+	valid, invalid := 0, 0
+	for i := 1; valid < 8 || invalid < 8; i++ {
+		x32[31] = byte(i)
+		x32[30] = byte(i >> 8)
+		var pk PublicKey
+		onCurve := ECPubkeyParse(&pk, append([]byte{0x02}, x32...)) == nil
+		err := ECDHX(got[:], x32, seckey)
+		if !onCurve {
+			invalid++
+			if err == nil {
+				t.Fatalf("x = %d is not on the curve but was accepted", i)
+			}
+			continue
+		}
+		valid++
+		if err != nil {
+			t.Fatal(err)
+		}
+		if err := ECDHXOnly(want[:], &pk, seckey); err != nil {
+			t.Fatal(err)
+		}
+		if got != want {
+			t.Fatalf("x = %d: ECDHX differs from ECDHXOnly", i)
+		}
+	}
+
+	for i := range x32 {
+		x32[i] = 0xFF
+	}
+	if ECDHX(got[:], x32, seckey) == nil {
+		t.Error("x >= p accepted")
+	}
+}
+
+// BenchmarkECDHX compares lifting an x-only key for ECDHXOnly with the
+// fractional x path of ECDHX
+func BenchmarkECDHX(b *testing.B) {
+	seckey, _, err := ECKeyPairGenerate()
+	if err != nil {
+		b.Fatal(err)
+	}
+	pubs, _ := makeECDHBatch(b, 1)
+	var out [32]byte
+
+	b.Run("parse+ECDHXOnly", func(b *testing.B) {
+		var pk PublicKey
+		compressed := append([]byte{0x02}, pubs[0]...)
+		for i := 0; i < b.N; i++ {
+			if err := ECPubkeyParse(&pk, compressed); err != nil {
+				b.Fatal(err)
+			}
+			ECDHXOnly(out[:], &pk, seckey)
+		}
+	})
+	b.Run("ECDHX", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			if err := ECDHX(out[:], pubs[0], seckey); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
@@ -5,6 +5,25 @@ import (
 	"unsafe"
 )
 
+var (
+	// ecdsaConstOrderAsFE is the group order n as a field element
+	ecdsaConstOrderAsFE = FieldElement{
+		n: [5]uint64{
+			0x25E8CD0364141, 0xE6AF48A03BBFD, 0xFFFFFFEBAAEDC,
+			0xFFFFFFFFFFFFF, 0xFFFFFFFFFFFF,
+		},
+		magnitude:  1,
+		normalized: true,
+	}
+
+	// ecdsaConstPMinusOrder is p - n as a field element
+	ecdsaConstPMinusOrder = FieldElement{
+		n:          [5]uint64{0xDA1722FC9BAEE, 0x1950B75FC4402, 0x1455123, 0, 0},
+		magnitude:  1,
+		normalized: true,
+	}
+)
+
 // ECDSASignature represents an ECDSA signature
 type ECDSASignature struct {
 	r, s Scalar
@@ -12,6 +31,12 @@ type ECDSASignature struct {
 
 // ECDSASign creates an ECDSA signature for a message hash using a private key
 func ECDSASign(sig *ECDSASignature, msghash32 []byte, seckey []byte) error {
+	return ecdsaSign(sig, nil, msghash32, seckey)
+}
+
+// ecdsaSign implements ECDSASign, setting *recid to the recovery id of the
+// signature if recid is not nil
+func ecdsaSign(sig *ECDSASignature, recid *int, msghash32 []byte, seckey []byte) error {
 	if len(msghash32) != 32 {
 		return errors.New("message hash must be 32 bytes")
 	}
@@ -30,22 +55,56 @@ func ECDSASign(sig *ECDSASignature, msghash32 []byte, seckey []byte) error {
 	msg.setB32(msghash32)
 	
 	// Generate nonce using RFC6979
-	nonceKey := make([]byte, 64)
+	var nonce Scalar
+	if err := ecdsaNonce(&nonce, msghash32, seckey); err != nil {
+		return err
+	}
+	
+	// Compute R = nonce * G
+	var rp GroupElementJacobian
+	EcmultGen(&rp, &nonce)
+	
+	// Convert to affine
+	var r GroupElementAffine
+	r.setGEJ(&rp)
+	r.x.normalize()
+	r.y.normalize()
+	
+	var nonceInv Scalar
+	nonceInv.inverse(&nonce)
+	err := ecdsaSignFinish(sig, recid, &r, &msg, &sec, &nonceInv)
+	
+	// Clear sensitive data
+	sec.clear()
+	msg.clear()
+	nonce.clear()
+	nonceInv.clear()
+	rp.clear()
+	r.clear()
+	
+	return err
+}
+
+// ecdsaNonce sets nonce to the RFC6979 nonce for signing msghash32 with
+// seckey, as ECDSASign uses
+func ecdsaNonce(nonce *Scalar, msghash32, seckey []byte) error {
+	var nonceKey [64]byte
 	copy(nonceKey[:32], msghash32)
 	copy(nonceKey[32:], seckey)
 	
-	rng := NewRFC6979HMACSHA256(nonceKey)
+	var rng RFC6979HMACSHA256
+	rng.init(nonceKey[:])
 	memclear(unsafe.Pointer(&nonceKey[0]), 64)
 	
 	var nonceBytes [32]byte
 	rng.Generate(nonceBytes[:])
 	
 	// Parse nonce
-	var nonce Scalar
 	if !nonce.setB32Seckey(nonceBytes[:]) {
 		// Retry with new nonce
 		rng.Generate(nonceBytes[:])
 		if !nonce.setB32Seckey(nonceBytes[:]) {
+			memclear(unsafe.Pointer(&nonceBytes[0]), 32)
 			rng.Finalize()
 			rng.Clear()
 			return errors.New("nonce generation failed")
@@ -54,53 +113,47 @@ func ECDSASign(sig *ECDSASignature, msghash32 []byte, seckey []byte) error {
 	memclear(unsafe.Pointer(&nonceBytes[0]), 32)
 	rng.Finalize()
 	rng.Clear()
-	
-	// Compute R = nonce * G
-	var rp GroupElementJacobian
-	EcmultGen(&rp, &nonce)
-	
-	// Convert to affine
-	var r GroupElementAffine
-	r.setGEJ(&rp)
-	r.x.normalize()
-	r.y.normalize()
-	
+	return nil
+}
+
+// ecdsaSignFinish completes a signature from the nonce point R, with
+// normalized x coordinate, and the inverse of the nonce:
+// r = x(R) mod n, s = nonce^-1 * (msg + r * sec) mod n, normalized to low-S.
+// If recid is not nil it is set to the recovery id, which also needs the y
+// coordinate of R normalized: bit 0 is the parity of y(R) for the final s,
+// bit 1 whether x(R) was reduced modulo n.
+func ecdsaSignFinish(sig *ECDSASignature, recid *int, R *GroupElementAffine, msg, sec, nonceInv *Scalar) error {
 	// Extract r = X(R) mod n
 	var rBytes [32]byte
-	r.x.getB32(rBytes[:])
+	R.x.getB32(rBytes[:])
 	
-	sig.r.setB32(rBytes[:])
+	overflow := sig.r.setB32(rBytes[:])
 	if sig.r.isZero() {
 		return errors.New("signature r is zero")
 	}
 	
 	// Compute s = nonce^-1 * (msg + r * sec) mod n
 	var n Scalar
-	n.mul(&sig.r, &sec)
-	n.add(&n, &msg)
-	
-	var nonceInv Scalar
-	nonceInv.inverse(&nonce)
-	sig.s.mul(&nonceInv, &n)
+	n.mul(&sig.r, sec)
+	n.add(&n, msg)
+	sig.s.mul(nonceInv, &n)
+	n.clear()
 	
-	// Normalize to low-S
+	if recid != nil {
+		*recid = 2*boolToInt(overflow) | boolToInt(R.y.isOdd())
+	}
+
+	// Normalize to low-S; negating s negates R, flipping the parity of y
 	if sig.s.isHigh() {
 		sig.s.condNegate(1)
+		if recid != nil {
+			*recid ^= 1
+		}
 	}
 	
 	if sig.s.isZero() {
 		return errors.New("signature s is zero")
 	}
-	
-	// Clear sensitive data
-	sec.clear()
-	msg.clear()
-	nonce.clear()
-	n.clear()
-	nonceInv.clear()
-	rp.clear()
-	r.clear()
-	
 	return nil
 }
 
@@ -128,7 +181,7 @@ func ECDSAVerify(sig *ECDSASignature, msghash32 []byte, pubkey *PublicKey) bool
 	
 	// Compute s^-1 mod n
 	var sInv Scalar
-	sInv.inverse(&sig.s)
+	sInv.inverseVar(&sig.s)
 	
 	// Compute u1 = msg * s^-1 mod n
 	var u1 Scalar
@@ -138,58 +191,36 @@ func ECDSAVerify(sig *ECDSASignature, msghash32 []byte, pubkey *PublicKey) bool
 	var u2 Scalar
 	u2.mul(&sig.r, &sInv)
 	
-	// Compute R = u1*G + u2*P
-	var u1G, u2P, R GroupElementJacobian
-	
-	// u1*G
-	EcmultGen(&u1G, &u1)
-	
-	// u2*P
-	var pubkeyJac GroupElementJacobian
+	// Compute R = u1*G + u2*P in a single Strauss pass
+	var pubkeyJac, R GroupElementJacobian
 	pubkeyJac.setGE(&pubkeyPoint)
-	
-	// For now, use a simple multiplication method
-	// TODO: Optimize with proper ecmult implementation
-	u2P.setInfinity()
-	var base GroupElementJacobian
-	base.setGE(&pubkeyPoint)
-	
-	// Simple binary method for u2*P
-	for i := 0; i < 256; i++ {
-		if i > 0 {
-			u2P.double(&u2P)
-		}
-		bit := u2.getBits(uint(255-i), 1)
-		if bit != 0 {
-			if u2P.isInfinity() {
-				u2P = base
-			} else {
-				u2P.addVar(&u2P, &base)
-			}
-		}
-	}
-	
-	// R = u1*G + u2*P
-	R.addVar(&u1G, &u2P)
-	
+	ecmultStrauss(&R, &pubkeyJac, &u2, &u1)
+
 	if R.isInfinity() {
 		return false
 	}
-	
-	// Convert R to affine
-	var RAff GroupElementAffine
-	RAff.setGEJ(&R)
-	RAff.x.normalize()
-	
-	// Extract X(R) mod n
-	var rBytes [32]byte
-	RAff.x.getB32(rBytes[:])
-	
-	var computedR Scalar
-	computedR.setB32(rBytes[:])
-	
-	// Compare r with X(R) mod n
-	return sig.r.equal(&computedR)
+
+	// We now have the recomputed R point and the claimed x coordinate mod n
+	// in xr. Since 2*n > p, X(R) mod n == xr holds exactly when
+	//
+	//	xr == X(R) || (xr + n < p && xr + n == X(R))
+	//
+	// and both can be checked projectively as xr*Z^2 == X, avoiding the
+	// inversion an affine conversion would need.
+	var c [32]byte
+	var xr FieldElement
+	sig.r.getB32(c[:])
+	xr.setB32Limit(c[:])
+
+	if R.eqXVar(&xr) {
+		return true
+	}
+	if xr.cmpVar(&ecdsaConstPMinusOrder) >= 0 {
+		// xr + n >= p, so we can skip testing the second case
+		return false
+	}
+	xr.add(&ecdsaConstOrderAsFE)
+	return R.eqXVar(&xr)
 }
 
 // ECDSASignatureCompact represents a compact 64-byte signature (r || s)
@@ -63,6 +63,7 @@ func BenchmarkECDSAVerify(b *testing.B) {
 		initBenchmarkData()
 	}
 	
+	b.ReportAllocs()
 	b.ResetTimer()
 	for i := 0; i < b.N; i++ {
 		ECDSAVerify(&benchSignature, benchMsghash, &benchPubkey)
@@ -143,6 +144,7 @@ func BenchmarkRFC6979(b *testing.B) {
 	key := make([]byte, 64)
 	rand.Read(key)
 	
+	b.ReportAllocs()
 	b.ResetTimer()
 	for i := 0; i < b.N; i++ {
 		rng := NewRFC6979HMACSHA256(key)
@@ -158,10 +160,27 @@ func BenchmarkTaggedHash(b *testing.B) {
 	data := make([]byte, 32)
 	rand.Read(data)
 	
+	b.ReportAllocs()
 	b.ResetTimer()
 	for i := 0; i < b.N; i++ {
 		TaggedHash(tag, data)
 	}
 }
 
+// BenchmarkTaggedHashParallel hashes from GOMAXPROCS goroutines at once; run
+// with -cpu 1,2,4,... to check that throughput scales with the core count
+func BenchmarkTaggedHashParallel(b *testing.B) {
+	tag := []byte("BIP0340/challenge")
+	data := make([]byte, 96)
+	rand.Read(data)
+
+	b.ReportAllocs()
+	b.ResetTimer()
+	b.RunParallel(func(pb *testing.PB) {
+		for pb.Next() {
+			TaggedHash(tag, data)
+		}
+	})
+}
+
 
@@ -0,0 +1,115 @@
+package p256k1
+
+import (
+	"errors"
+	"runtime"
+	"sync"
+	"unsafe"
+)
+
+// ecdsaSignBatchChunk is the number of nonce points converted to affine, and
+// of nonces inverted, with one inversion each
+const ecdsaSignBatchChunk = 64
+
+// ECDSASignBatch signs each msghashes[i] with seckey into sigs[i], producing
+// the same signatures as ECDSASign. The key is parsed once for the whole
+// batch, and per chunk of ecdsaSignBatchChunk messages the nonce points are
+// converted to affine with one field inversion and the nonces are inverted
+// with one scalar inversion. Both inversions are the constant time ones, as
+// the nonces are secret.
+func ECDSASignBatch(sigs []ECDSASignature, msghashes [][]byte, seckey []byte) error {
+	return ECDSASignBatchParallel(sigs, msghashes, seckey, 1)
+}
+
+// ECDSASignBatchParallel is ECDSASignBatch split over workers goroutines, or
+// GOMAXPROCS goroutines if workers <= 0
+func ECDSASignBatchParallel(sigs []ECDSASignature, msghashes [][]byte, seckey []byte, workers int) error {
+	if len(sigs) != len(msghashes) {
+		return errors.New("msghashes and sigs must have the same length")
+	}
+	for i := range msghashes {
+		if len(msghashes[i]) != 32 {
+			return errors.New("message hash must be 32 bytes")
+		}
+	}
+	if len(seckey) != 32 {
+		return errors.New("private key must be 32 bytes")
+	}
+	var sec Scalar
+	if !sec.setB32Seckey(seckey) {
+		return errors.New("invalid private key")
+	}
+	defer sec.clear()
+	gen := getGlobalGenContext()
+
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+	// Keep whole chunks per worker so every inversion is shared as widely
+	// as possible
+	per := (len(msghashes) + workers - 1) / workers
+	per = (per + ecdsaSignBatchChunk - 1) / ecdsaSignBatchChunk * ecdsaSignBatchChunk
+	if per >= len(msghashes) {
+		return ecdsaSignBatch(gen, &sec, seckey, sigs, msghashes)
+	}
+
+	var wg sync.WaitGroup
+	var errOnce sync.Once
+	var firstErr error
+	for lo := 0; lo < len(msghashes); lo += per {
+		hi := lo + per
+		if hi > len(msghashes) {
+			hi = len(msghashes)
+		}
+		wg.Add(1)
+		go func(sigs []ECDSASignature, msghashes [][]byte) {
+			defer wg.Done()
+			if err := ecdsaSignBatch(gen, &sec, seckey, sigs, msghashes); err != nil {
+				errOnce.Do(func() { firstErr = err })
+			}
+		}(sigs[lo:hi], msghashes[lo:hi])
+	}
+	wg.Wait()
+	return firstErr
+}
+
+// ecdsaSignBatch signs a batch with the parsed key sec, whose encoding is
+// seckey
+func ecdsaSignBatch(gen *EcmultGenContext, sec *Scalar, seckey []byte, sigs []ECDSASignature, msghashes [][]byte) error {
+	var msg Scalar
+	var ks, kinv [ecdsaSignBatchChunk]Scalar
+	var rj [ecdsaSignBatchChunk]GroupElementJacobian
+	var r [ecdsaSignBatchChunk]GroupElementAffine
+	defer func() {
+		msg.clear()
+		memclear(unsafe.Pointer(&ks[0]), unsafe.Sizeof(ks))
+		memclear(unsafe.Pointer(&kinv[0]), unsafe.Sizeof(kinv))
+		memclear(unsafe.Pointer(&rj[0]), unsafe.Sizeof(rj))
+		memclear(unsafe.Pointer(&r[0]), unsafe.Sizeof(r))
+	}()
+
+	for lo := 0; lo < len(msghashes); lo += ecdsaSignBatchChunk {
+		n := len(msghashes) - lo
+		if n > ecdsaSignBatchChunk {
+			n = ecdsaSignBatchChunk
+		}
+
+		for i := 0; i < n; i++ {
+			if err := ecdsaNonce(&ks[i], msghashes[lo+i], seckey); err != nil {
+				return err
+			}
+			gen.ecmultGen(&rj[i], &ks[i])
+		}
+
+		geSetAllGEJ(r[:n], rj[:n])
+		scalarBatchInverse(kinv[:n], ks[:n])
+		for i := 0; i < n; i++ {
+			r[i].x.normalize()
+			msg.setB32(msghashes[lo+i])
+			if err := ecdsaSignFinish(&sigs[lo+i], nil, &r[i], &msg, sec, &kinv[i]); err != nil {
+				return err
+			}
+		}
+	}
+	return nil
+}
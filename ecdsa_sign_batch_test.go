@@ -0,0 +1,90 @@
+package p256k1
+
+import (
+	"fmt"
+	"testing"
+)
+
+func TestECDSASignBatch(t *testing.T) {
+	seckey := make([]byte, 32)
+	sk := randomScalar(t)
+	sk.getB32(seckey)
+	msgs, _, _ := makeSignBatch(t, 2*ecdsaSignBatchChunk+5)
+	sigs := make([]ECDSASignature, len(msgs))
+
+	for _, workers := range []int{1, 3, 0} {
+		for i := range sigs {
+			sigs[i] = ECDSASignature{}
+		}
+		if err := ECDSASignBatchParallel(sigs, msgs, seckey, workers); err != nil {
+			t.Fatal(err)
+		}
+		for i := range msgs {
+			var want ECDSASignature
+			if err := ECDSASign(&want, msgs[i], seckey); err != nil {
+				t.Fatal(err)
+			}
+			if !sigs[i].r.equal(&want.r) || !sigs[i].s.equal(&want.s) {
+				t.Fatalf("workers=%d: signature %d differs from ECDSASign", workers, i)
+			}
+		}
+	}
+
+	if err := ECDSASignBatch(sigs[1:], msgs, seckey); err == nil {
+		t.Error("mismatched lengths accepted")
+	}
+	if err := ECDSASignBatch(sigs, msgs, make([]byte, 32)); err == nil {
+		t.Error("zero key accepted")
+	}
+	msgs[7] = msgs[7][:31]
+	if err := ECDSASignBatch(sigs, msgs, seckey); err == nil {
+		t.Error("short message hash accepted")
+	}
+	if err := ECDSASignBatch(nil, nil, seckey); err != nil {
+		t.Errorf("empty batch: %v", err)
+	}
+}
+
+func TestScalarBatchInverse(t *testing.T) {
+	a := make([]Scalar, 9)
+	out := make([]Scalar, len(a))
+	for i := range a {
+		a[i] = randomScalar(t)
+	}
+	a[4].setInt(1)
+	scalarBatchInverse(out, a)
+	for i := range a {
+		var want Scalar
+		want.inverse(&a[i])
+		if !out[i].equal(&want) {
+			t.Fatalf("inverse %d is wrong", i)
+		}
+	}
+	scalarBatchInverse(nil, nil)
+}
+
+func BenchmarkECDSASignBatch(b *testing.B) {
+	seckey := make([]byte, 32)
+	sk := randomScalar(b)
+	sk.getB32(seckey)
+	for _, n := range []int{16, 256} {
+		msgs, _, _ := makeSignBatch(b, n)
+		sigs := make([]ECDSASignature, n)
+		b.Run(fmt.Sprintf("n=%d/ECDSASign", n), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				for j := range msgs {
+					if err := ECDSASign(&sigs[j], msgs[j], seckey); err != nil {
+						b.Fatal(err)
+					}
+				}
+			}
+		})
+		b.Run(fmt.Sprintf("n=%d/ECDSASignBatch", n), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				if err := ECDSASignBatch(sigs, msgs, seckey); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
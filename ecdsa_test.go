@@ -102,3 +102,111 @@ func TestECDSASignCompact(t *testing.T) {
 	}
 }
 
+
+func TestECDSAVerifyRandom(t *testing.T) {
+	for i := 0; i < 32; i++ {
+		seckey := make([]byte, 32)
+		var sec Scalar
+		for {
+			if _, err := rand.Read(seckey); err != nil {
+				t.Fatal(err)
+			}
+			if sec.setB32Seckey(seckey) {
+				break
+			}
+		}
+		var pubkey, otherPubkey PublicKey
+		if err := ECPubkeyCreate(&pubkey, seckey); err != nil {
+			t.Fatal(err)
+		}
+		otherSeckey := make([]byte, 32)
+		copy(otherSeckey, seckey)
+		otherSeckey[31] ^= 1
+		if err := ECPubkeyCreate(&otherPubkey, otherSeckey); err != nil {
+			t.Fatal(err)
+		}
+
+		msghash := make([]byte, 32)
+		if _, err := rand.Read(msghash); err != nil {
+			t.Fatal(err)
+		}
+		var sig ECDSASignature
+		if err := ECDSASign(&sig, msghash, seckey); err != nil {
+			t.Fatal(err)
+		}
+		if !ECDSAVerify(&sig, msghash, &pubkey) {
+			t.Fatal("valid signature rejected")
+		}
+		if ECDSAVerify(&sig, msghash, &otherPubkey) {
+			t.Fatal("signature accepted under the wrong public key")
+		}
+
+		bad := sig
+		var one Scalar
+		one.setInt(1)
+		bad.r.add(&bad.r, &one)
+		if ECDSAVerify(&bad, msghash, &pubkey) {
+			t.Fatal("signature with modified r accepted")
+		}
+		bad = sig
+		bad.s.add(&bad.s, &one)
+		if ECDSAVerify(&bad, msghash, &pubkey) {
+			t.Fatal("signature with modified s accepted")
+		}
+	}
+}
+
+// TestECDSAVerifyHighX checks the xr + n branch of the projective
+// r-comparison, which only triggers when X(R) >= n. Such an R cannot be found
+// by signing, so the public key is solved for instead:
+// P = u2^-1 * (R - u1*G) makes u1*G + u2*P == R for any message and s.
+func TestECDSAVerifyHighX(t *testing.T) {
+	// Find the smallest x > n that is on the curve; x == n would give r == 0
+	var xb [32]byte
+	ecdsaConstOrderAsFE.getB32(xb[:])
+	var R GroupElementAffine
+	for {
+		xb[31]++
+		var x FieldElement
+		if err := x.setB32(xb[:]); err != nil {
+			t.Fatal(err)
+		}
+		if R.setXOVar(&x, false) && R.isValid() {
+			break
+		}
+	}
+
+	var sig ECDSASignature
+	sig.r.setB32(xb[:])
+	sig.s = randomScalar(t)
+	msghash := make([]byte, 32)
+	if _, err := rand.Read(msghash); err != nil {
+		t.Fatal(err)
+	}
+	var msg, sInv, u1, u2 Scalar
+	msg.setB32(msghash)
+	sInv.inverse(&sig.s)
+	u1.mul(&msg, &sInv)
+	u2.mul(&sig.r, &sInv)
+
+	var u1G, Rj, Pj GroupElementJacobian
+	EcmultGen(&u1G, &u1)
+	u1G.negate(&u1G)
+	Rj.setGE(&R)
+	Rj.addVar(&Rj, &u1G)
+	u2.inverse(&u2)
+	Ecmult(&Pj, &Rj, &u2)
+
+	var P GroupElementAffine
+	P.setGEJ(&Pj)
+	var pubkey PublicKey
+	P.toBytes(pubkey.data[:])
+
+	if !ECDSAVerify(&sig, msghash, &pubkey) {
+		t.Fatal("signature with X(R) >= n rejected")
+	}
+	msghash[0] ^= 1
+	if ECDSAVerify(&sig, msghash, &pubkey) {
+		t.Fatal("signature with X(R) >= n accepted for the wrong message")
+	}
+}
@@ -60,6 +60,23 @@ func ECKeyPairGenerate() (seckey []byte, pubkey *PublicKey, err error) {
 	return seckey, pubkey, nil
 }
 
+// ECKeyPairGenerateValue is ECKeyPairGenerate returning the secret key and
+// public key by value
+func ECKeyPairGenerateValue() (seckey [32]byte, pubkey PublicKey, err error) {
+	for {
+		if _, err := rand.Read(seckey[:]); err != nil {
+			return [32]byte{}, PublicKey{}, err
+		}
+		if ECSeckeyVerify(seckey[:]) {
+			break
+		}
+	}
+	if err := ECPubkeyCreate(&pubkey, seckey[:]); err != nil {
+		return [32]byte{}, PublicKey{}, err
+	}
+	return seckey, pubkey, nil
+}
+
 // ECSeckeyTweakAdd adds a tweak to a secret key: seckey = seckey + tweak mod n
 func ECSeckeyTweakAdd(seckey []byte, tweak []byte) error {
 	if len(seckey) != 32 {
@@ -157,7 +174,7 @@ func ECPubkeyTweakAdd(pubkey *PublicKey, tweak []byte) error {
 	
 	// Convert back to affine and store
 	var resultAff GroupElementAffine
-	resultAff.setGEJ(&result)
+	resultAff.setGEJVar(&result)
 	resultAff.toBytes(pubkey.data[:])
 	
 	return nil
@@ -181,29 +198,11 @@ func ECPubkeyTweakMul(pubkey *PublicKey, tweak []byte) error {
 		return errors.New("invalid public key")
 	}
 	
-	// Multiply by tweak using binary method
-	var pubkeyJac GroupElementJacobian
+	// The tweak is not secret, so as secp256k1_eckey_pubkey_tweak_mul does
+	// this uses the variable time GLV multiplication
+	var pubkeyJac, result GroupElementJacobian
 	pubkeyJac.setGE(&pubkeyPoint)
-	
-	var result GroupElementJacobian
-	result.setInfinity()
-	var base GroupElementJacobian
-	base = pubkeyJac
-	
-	// Simple binary method
-	for i := 0; i < 256; i++ {
-		if i > 0 {
-			result.double(&result)
-		}
-		bit := tw.getBits(uint(255-i), 1)
-		if bit != 0 {
-			if result.isInfinity() {
-				result = base
-			} else {
-				result.addVar(&result, &base)
-			}
-		}
-	}
+	Ecmult(&result, &pubkeyJac, &tw)
 	
 	// Check if result is infinity
 	if result.isInfinity() {
@@ -212,7 +211,7 @@ func ECPubkeyTweakMul(pubkey *PublicKey, tweak []byte) error {
 	
 	// Convert back to affine and store
 	var resultAff GroupElementAffine
-	resultAff.setGEJ(&result)
+	resultAff.setGEJVar(&result)
 	resultAff.toBytes(pubkey.data[:])
 	
 	return nil
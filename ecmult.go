@@ -0,0 +1,420 @@
+package p256k1
+
+import "sync"
+
+// Variable-time multiplication r = na*a + ng*G, ported from
+// secp256k1_ecmult_strauss_wnaf in src/ecmult_impl.h.
+//
+// Point scalars are split with the GLV endomorphism into two ~128-bit halves
+// that share one odd-multiples table (the lambda half reuses it with x*beta).
+// The generator scalar is split into its low and high 128 bits, which are
+// looked up in the precomputed tables of odd multiples of G and 2^128*G. All
+// wNAFs are interleaved so the ~128 doublings are shared between every term.
+
+const (
+	// ecmultWnafBits is the number of wNAF digits per 128-bit half scalar
+	ecmultWnafBits = 129
+)
+
+// ecmultTableSize returns the number of odd multiples in a table for window w
+func ecmultTableSize(w int) int {
+	return 1 << uint(w-2)
+}
+
+// Tables of odd multiples [1*P, 3*P, ..., (2*n-1)*P] in storage form, for
+// P = G and P = 2^128*G, with n = ecmultTableSize(windowG). They normally
+// alias the embedded blob (see precomputed.go).
+var (
+	ecmultPreG       []geStorage
+	ecmultPreG128    []geStorage
+	ecmultTablesOnce sync.Once
+)
+
+// getEcmultTables returns the generator tables, building them on first use
+// if they were not loaded from the embedded blob
+func getEcmultTables() (preG, preG128 []geStorage) {
+	ecmultTablesOnce.Do(func() {
+		if ecmultPreG == nil {
+			ecmultPreG, ecmultPreG128 = computeEcmultTables()
+		}
+	})
+	return ecmultPreG, ecmultPreG128
+}
+
+// ecmultTables is a set of generator tables owned by a context. A nil
+// *ecmultTables stands for the global tables.
+type ecmultTables struct {
+	preG, preG128 []geStorage
+}
+
+// get returns the tables, or the global tables if t is nil
+func (t *ecmultTables) get() (preG, preG128 []geStorage) {
+	if t == nil {
+		return getEcmultTables()
+	}
+	return t.preG, t.preG128
+}
+
+// clone returns a private copy of the tables, so that their memory is first
+// touched by the calling thread, backed by huge pages if huge is set
+func (t *ecmultTables) clone(huge bool) *ecmultTables {
+	preG, preG128 := t.get()
+	c := &ecmultTables{
+		preG:    newTableStorage(len(preG), huge),
+		preG128: newTableStorage(len(preG128), huge),
+	}
+	copy(c.preG, preG)
+	copy(c.preG128, preG128)
+	return c
+}
+
+// computeEcmultTables builds the odd multiples tables of G and 2^128*G
+func computeEcmultTables() (preG, preG128 []geStorage) {
+	n := ecmultTableSize(windowG)
+	table := make([]GroupElementAffine, n)
+	preG = make([]geStorage, n)
+	preG128 = make([]geStorage, n)
+
+	var gj GroupElementJacobian
+	gj.setGE(&Generator)
+	ecmultComputeTable(table, &gj)
+	for i := range table {
+		table[i].toLimbStorage(&preG[i])
+	}
+	for i := 0; i < 128; i++ {
+		gj.double(&gj)
+	}
+	ecmultComputeTable(table, &gj)
+	for i := range table {
+		table[i].toLimbStorage(&preG128[i])
+	}
+	return preG, preG128
+}
+
+// ecmultComputeTable fills table with the odd multiples of gen as normalized
+// affine points, like secp256k1_ecmult_compute_table. The multiples are built
+// in Jacobian form and converted with a single batch inversion.
+func ecmultComputeTable(table []GroupElementAffine, gen *GroupElementJacobian) {
+	n := len(table)
+	jac := make([]GroupElementJacobian, n)
+
+	var dgen GroupElementAffine
+	var d GroupElementJacobian
+	d.double(gen)
+	dgen.setGEJVar(&d)
+
+	jac[0] = *gen
+	for j := 1; j < n; j++ {
+		jac[j].addGE(&jac[j-1], &dgen)
+	}
+	geSetAllGEJVar(table, jac)
+	for j := range table {
+		table[j].x.normalize()
+		table[j].y.normalize()
+	}
+}
+
+// ecmultOddMultiplesTable fills pre with the odd multiples [1*a, 3*a, ...,
+// (2*len(pre)-1)*a] of a. The entries are Jacobian points with their z
+// coordinates omitted: z(pre[len-1]) is returned in z, and
+// z(pre[i-1]) = z(pre[i]) / zr[i]. zr[0] is set so that
+// a.z = z(pre[0]) / zr[0]. Follows secp256k1_ecmult_odd_multiples_table.
+//
+// The additions run on the isomorphic curve Y^2 = X^3 + 7*C^6 with C = (2a).z,
+// on which 2a has z = 1, so the cheaper mixed addition can be used.
+func ecmultOddMultiplesTable(pre []GroupElementAffine, zr []FieldElement, z *FieldElement, a *GroupElementJacobian) {
+	var d, ai GroupElementJacobian
+	var dGE GroupElementAffine
+
+	d.double(a)
+	dGE.setXY(&d.x, &d.y)
+
+	pre[0].setGEJZinv(a, &d.z)
+	ai.setGE(&pre[0])
+	ai.z = a.z
+
+	// pre[0] is the point (a.x*C^2, a.y*C^3, a.z*C), which is equivalent to a
+	zr[0] = d.z
+
+	for i := 1; i < len(pre); i++ {
+		ai.addGEWithZR(&ai, &dGE, &zr[i])
+		pre[i].setXY(&ai.x, &ai.y)
+	}
+
+	// Multiplying the last z by C undoes the isomorphism for every entry
+	z.mul(&ai.z, &d.z)
+}
+
+// ecmultTableGetGE sets r to n*a using a table of odd multiples of a
+func ecmultTableGetGE(r *GroupElementAffine, pre []GroupElementAffine, n int) {
+	if n > 0 {
+		*r = pre[(n-1)/2]
+	} else {
+		*r = pre[(-n-1)/2]
+		r.y.negate(&r.y, 1)
+	}
+}
+
+// ecmultTableGetGEStorage sets r to n*a using a storage table of odd
+// multiples of a
+func ecmultTableGetGEStorage(r *GroupElementAffine, pre []geStorage, n int) {
+	if n > 0 {
+		r.fromLimbStorage(&pre[(n-1)/2])
+	} else {
+		r.fromLimbStorage(&pre[(-n-1)/2])
+		r.y.negate(&r.y, 1)
+	}
+}
+
+// ecmultTableGetGELambda sets r to n*lambda*a using a table of odd multiples
+// of a and the matching x coordinates multiplied by beta
+func ecmultTableGetGELambda(r *GroupElementAffine, pre []GroupElementAffine, x []FieldElement, n int) {
+	if n > 0 {
+		r.setXY(&x[(n-1)/2], &pre[(n-1)/2].y)
+	} else {
+		r.setXY(&x[(-n-1)/2], &pre[(-n-1)/2].y)
+		r.y.negate(&r.y, 1)
+	}
+}
+
+// straussPointState holds the wNAFs of the two GLV halves of one scalar
+type straussPointState struct {
+	wnafNa1   [ecmultWnafBits]int
+	wnafNaLam [ecmultWnafBits]int
+	bitsNa1   int
+	bitsNaLam int
+}
+
+// straussState points at the per-point temporaries of ecmultStraussWnaf.
+// w is the wNAF window of the points; preA and aux need ecmultTableSize(w)
+// entries per point and ps one. aux holds the z-ratios and is then reused for
+// pre_a[i].x * beta.
+type straussState struct {
+	w      uint
+	aux    []FieldElement
+	preA   []GroupElementAffine
+	ps     []straussPointState
+	tables *ecmultTables // generator tables, nil for the global ones
+}
+
+// ecmultStraussWnaf computes r = sum(na[i]*a[i]) + ng*G. ng may be nil.
+func ecmultStraussWnaf(state *straussState, r *GroupElementJacobian, a []GroupElementJacobian, na []Scalar, ng *Scalar) {
+	var tmpa GroupElementAffine
+	var Z FieldElement
+	tableSize := ecmultTableSize(int(state.w))
+	bits := 0
+	no := 0
+
+	Z.setInt(1)
+	for np := range a {
+		if na[np].isZero() || a[np].infinity {
+			continue
+		}
+		ps := &state.ps[no]
+
+		// Split na into na_1 and na_lam (where na = na_1 + na_lam*lambda,
+		// and na_1 and na_lam are ~128 bit)
+		var na1, naLam Scalar
+		na1.splitLambda(&naLam, &na[np])
+
+		ps.bitsNa1 = na1.wNAF(ps.wnafNa1[:], state.w)
+		ps.bitsNaLam = naLam.wNAF(ps.wnafNaLam[:], state.w)
+		if ps.bitsNa1 > bits {
+			bits = ps.bitsNa1
+		}
+		if ps.bitsNaLam > bits {
+			bits = ps.bitsNaLam
+		}
+
+		// Calculate odd multiples of a. All multiples are brought to the same
+		// Z 'denominator', which is stored in Z. Due to secp256k1's
+		// isomorphism we can do all operations pretending that the Z
+		// coordinate was 1, use affine addition formulae, and correct the Z
+		// coordinate of the result once at the end. The G table points are
+		// really affine; compared to that base they have a Z ratio of 1/Z,
+		// so addZinvVar is used for them.
+		tmp := a[np]
+		if no > 0 {
+			tmp.rescale(&Z)
+		}
+		pre := state.preA[no*tableSize : (no+1)*tableSize]
+		aux := state.aux[no*tableSize : (no+1)*tableSize]
+		ecmultOddMultiplesTable(pre, aux, &Z, &tmp)
+		if no > 0 {
+			aux[0].mul(&aux[0], &a[np].z)
+		}
+
+		no++
+	}
+
+	// Bring them to the same Z denominator
+	if no > 0 {
+		geTableSetGlobalZ(state.preA[:no*tableSize], state.aux[:no*tableSize])
+	}
+
+	for np := 0; np < no; np++ {
+		for i := 0; i < tableSize; i++ {
+			state.aux[np*tableSize+i].mul(&state.preA[np*tableSize+i].x, &fieldBeta)
+		}
+	}
+
+	// Split ng into ng_1 and ng_128 (where ng = ng_1 + ng_128*2^128, and
+	// ng_1 and ng_128 are ~128 bit)
+	var wnafNg1, wnafNg128 [ecmultWnafBits]int
+	bitsNg1, bitsNg128 := 0, 0
+	var preG, preG128 []geStorage
+	if ng != nil && !ng.isZero() {
+		var ng1, ng128 Scalar
+		ng1.split128(&ng128, ng)
+		bitsNg1 = ng1.wNAF(wnafNg1[:], windowG)
+		bitsNg128 = ng128.wNAF(wnafNg128[:], windowG)
+		if bitsNg1 > bits {
+			bits = bitsNg1
+		}
+		if bitsNg128 > bits {
+			bits = bitsNg128
+		}
+		preG, preG128 = state.tables.get()
+	}
+
+	r.setInfinity()
+
+	for i := bits - 1; i >= 0; i-- {
+		r.double(r)
+		for np := 0; np < no; np++ {
+			ps := &state.ps[np]
+			pre := state.preA[np*tableSize : (np+1)*tableSize]
+			if i < ps.bitsNa1 {
+				if n := ps.wnafNa1[i]; n != 0 {
+					ecmultTableGetGE(&tmpa, pre, n)
+					r.addGE(r, &tmpa)
+				}
+			}
+			if i < ps.bitsNaLam {
+				if n := ps.wnafNaLam[i]; n != 0 {
+					ecmultTableGetGELambda(&tmpa, pre, state.aux[np*tableSize:(np+1)*tableSize], n)
+					r.addGE(r, &tmpa)
+				}
+			}
+		}
+		if i < bitsNg1 {
+			if n := wnafNg1[i]; n != 0 {
+				ecmultTableGetGEStorage(&tmpa, preG, n)
+				r.addZinvVar(r, &tmpa, &Z)
+			}
+		}
+		if i < bitsNg128 {
+			if n := wnafNg128[i]; n != 0 {
+				ecmultTableGetGEStorage(&tmpa, preG128, n)
+				r.addZinvVar(r, &tmpa, &Z)
+			}
+		}
+	}
+
+	if !r.infinity {
+		r.z.mul(&r.z, &Z)
+	}
+}
+
+// ecmultPrepareTables fills pre with the odd multiples [1*a, 3*a, ...] of a
+// and preLam with those of lambda*a, in storage form for the fixed-key path
+// of ecmultStraussPrepared. The multiples are built on the isomorphic curve
+// with ecmultOddMultiplesTable, brought to one global z with
+// geTableSetGlobalZ, and then made truly affine with a single inversion, so
+// verification can use plain mixed additions for every term.
+func ecmultPrepareTables(pre, preLam []geStorage, a *GroupElementAffine) {
+	n := len(pre)
+	table := make([]GroupElementAffine, n)
+	zr := make([]FieldElement, n)
+	var aj GroupElementJacobian
+	var globalZ, zinv FieldElement
+	var t GroupElementAffine
+
+	aj.setGE(a)
+	ecmultOddMultiplesTable(table, zr, &globalZ, &aj)
+	geTableSetGlobalZ(table, zr)
+	zinv.invVar(&globalZ)
+
+	for i := range table {
+		t.setGEZinv(&table[i], &zinv)
+		t.x.normalize()
+		t.y.normalize()
+		t.toLimbStorage(&pre[i])
+		t.mulLambda(&t)
+		t.x.normalize()
+		t.toLimbStorage(&preLam[i])
+	}
+}
+
+// ecmultStraussPrepared computes r = na*P + ng*G like ecmultStrauss, for a
+// point P whose tables were built by ecmultPrepareTables with window w.
+// Nothing about P is computed per call, and because the tables are affine
+// the generator terms need no z correction either.
+func ecmultStraussPrepared(r *GroupElementJacobian, pre, preLam []geStorage, w uint, na *Scalar, ng *Scalar) {
+	var wnafNa1, wnafNaLam, wnafNg1, wnafNg128 [ecmultWnafBits]int
+	var tmpa GroupElementAffine
+	bitsNa1, bitsNaLam, bitsNg1, bitsNg128 := 0, 0, 0, 0
+
+	if !na.isZero() {
+		var na1, naLam Scalar
+		na1.splitLambda(&naLam, na)
+		bitsNa1 = na1.wNAF(wnafNa1[:], w)
+		bitsNaLam = naLam.wNAF(wnafNaLam[:], w)
+	}
+
+	var preG, preG128 []geStorage
+	if ng != nil && !ng.isZero() {
+		var ng1, ng128 Scalar
+		ng1.split128(&ng128, ng)
+		bitsNg1 = ng1.wNAF(wnafNg1[:], windowG)
+		bitsNg128 = ng128.wNAF(wnafNg128[:], windowG)
+		preG, preG128 = getEcmultTables()
+	}
+
+	bits := bitsNa1
+	for _, b := range [...]int{bitsNaLam, bitsNg1, bitsNg128} {
+		if b > bits {
+			bits = b
+		}
+	}
+
+	r.setInfinity()
+	for i := bits - 1; i >= 0; i-- {
+		r.double(r)
+		if n := wnafNa1[i]; i < bitsNa1 && n != 0 {
+			ecmultTableGetGEStorage(&tmpa, pre, n)
+			r.addGE(r, &tmpa)
+		}
+		if n := wnafNaLam[i]; i < bitsNaLam && n != 0 {
+			ecmultTableGetGEStorage(&tmpa, preLam, n)
+			r.addGE(r, &tmpa)
+		}
+		if n := wnafNg1[i]; i < bitsNg1 && n != 0 {
+			ecmultTableGetGEStorage(&tmpa, preG, n)
+			r.addGE(r, &tmpa)
+		}
+		if n := wnafNg128[i]; i < bitsNg128 && n != 0 {
+			ecmultTableGetGEStorage(&tmpa, preG128, n)
+			r.addGE(r, &tmpa)
+		}
+	}
+}
+
+// ecmultStrauss computes r = na*a + ng*G in variable time, sharing the
+// doublings of both multiplications. This is the verification workhorse; it
+// must only be used with public scalars.
+func ecmultStrauss(r *GroupElementJacobian, a *GroupElementJacobian, na *Scalar, ng *Scalar) {
+	ecmultStraussTables(nil, r, a, na, ng)
+}
+
+// ecmultStraussTables is ecmultStrauss with the generator tables of a
+// context; nil selects the global tables
+func ecmultStraussTables(tables *ecmultTables, r *GroupElementJacobian, a *GroupElementJacobian, na *Scalar, ng *Scalar) {
+	var aux [1 << (windowA - 2)]FieldElement
+	var preA [1 << (windowA - 2)]GroupElementAffine
+	var ps [1]straussPointState
+	points := [1]GroupElementJacobian{*a}
+	scalars := [1]Scalar{*na}
+	state := straussState{w: windowA, aux: aux[:], preA: preA[:], ps: ps[:], tables: tables}
+	ecmultStraussWnaf(&state, r, points[:], scalars[:], ng)
+}
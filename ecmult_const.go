@@ -0,0 +1,229 @@
+package p256k1
+
+// Constant-time point multiplication, ported from src/ecmult_const_impl.h
+// (secp256k1_ecmult_const and secp256k1_ecmult_const_xonly).
+//
+// The scalar is recoded into signed digits (Hamburg, "Fast and compact
+// elliptic-curve cryptography", section 3.3): reading the bits of v as signs
+// (1 = +, 0 = -) gives
+//
+//	C_l(v, A) = sum((2*v[i] - 1) * 2^i*A, i=0..l-1) = (2*v + 1 - 2^l) * A
+//
+// so every digit is odd and nonzero, and no step ever has to skip an
+// addition. Combined with the GLV endomorphism, q*A is computed as
+// C_l(v1, A) + C_l(v2, lambda*A), where
+//
+//	s      = (q + K) / 2                 K = (2^l - 2^129 - 1)*(1 + lambda)
+//	s1, s2 = splitLambda(s)
+//	v1, v2 = s1 + 2^128, s2 + 2^128      both in [0, 2^129)
+//
+// and l = ecmultConstBits. The digits are consumed ecmultConstGroupSize bits
+// at a time from tables of odd multiples that share one global z, so all
+// additions are mixed additions on an isomorphic curve and z is fixed once at
+// the end.
+
+const (
+	// ecmultConstGroupSize is the number of bits processed per table lookup
+	ecmultConstGroupSize = 5
+
+	// ecmultConstTableSize is the number of odd multiples in each table
+	ecmultConstTableSize = 1 << (ecmultConstGroupSize - 1)
+
+	// ecmultConstGroups is the number of digit groups covering 129 bits
+	ecmultConstGroups = (129 + ecmultConstGroupSize - 1) / ecmultConstGroupSize
+
+	// ecmultConstBits is l, the signed-digit length of v1 and v2
+	ecmultConstBits = ecmultConstGroups * ecmultConstGroupSize
+)
+
+var (
+	// ecmultConstK is (2^130 - 2^129 - 1)*(1 + lambda) mod n, the K above for
+	// ecmultConstBits == 130
+	ecmultConstK = Scalar{d: [4]uint64{
+		0xB5C2C1DCDE9798D9, 0x589AE84826BA29E4,
+		0xC2BDD6BF7C118D6B, 0xA4E88A7DCB13034E,
+	}}
+
+	// ecmultConstSOffset is 2^128, which makes the split halves non-negative
+	ecmultConstSOffset = Scalar{d: [4]uint64{0, 0, 1, 0}}
+)
+
+// ecmultConstOddMultiplesTableGlobalZ fills pre with the odd multiples
+// [1*a, 3*a, ..., 31*a] of a, all expressed with the same z coordinate, which
+// is returned in globalZ
+func ecmultConstOddMultiplesTableGlobalZ(pre []GroupElementAffine, globalZ *FieldElement, a *GroupElementJacobian) {
+	var zr [ecmultConstTableSize]FieldElement
+
+	ecmultOddMultiplesTable(pre, zr[:], globalZ, a)
+	geTableSetGlobalZ(pre, zr[:])
+}
+
+// ecmultConstTableGetGE sets r to the point C_groupSize(n, A) from a table
+// of odd multiples of A, without using n in a branch or an array index. The
+// top bit of n selects the sign and the remaining bits, complemented for
+// negative digits, select the entry.
+func ecmultConstTableGetGE(r *GroupElementAffine, pre []GroupElementAffine, n uint32) {
+	// If the top bit of n is 0, we want the negation
+	negative := (n >> (ecmultConstGroupSize - 1)) ^ 1
+	index := (-negative ^ n) & (ecmultConstTableSize - 1)
+
+	// Every entry is read, so the memory access pattern does not depend on
+	// index. Starting from pre[0] makes sure r is always initialized.
+	r.x = pre[0].x
+	r.y = pre[0].y
+	for m := uint32(1); m < ecmultConstTableSize; m++ {
+		flag := boolToInt(m == index)
+		r.x.cmov(&pre[m].x, flag)
+		r.y.cmov(&pre[m].y, flag)
+	}
+	r.infinity = false
+
+	var negY FieldElement
+	negY.negate(&r.y, 1)
+	r.y.cmov(&negY, int(negative))
+}
+
+// mulLambda sets r = lambda*a, which on secp256k1 is (beta*x, y)
+func (r *GroupElementAffine) mulLambda(a *GroupElementAffine) {
+	*r = *a
+	r.x.mul(&r.x, &fieldBeta)
+}
+
+// EcmultConst computes r = q * a in constant time with respect to q. Only
+// the point a is allowed to influence the running time, so this is the
+// routine to use with secret scalars, such as in ECDH.
+func EcmultConst(r *GroupElementJacobian, a *GroupElementAffine, q *Scalar) {
+	var v1, v2 Scalar
+	ecmultConstRecode(&v1, &v2, q)
+	ecmultConstRecoded(r, a, &v1, &v2)
+	v1.clear()
+	v2.clear()
+}
+
+// ecmultConstRecode computes the split v1, v2 of q used by
+// ecmultConstRecoded. It only depends on q, so it can be done once for
+// many points.
+func ecmultConstRecode(v1, v2 *Scalar, q *Scalar) {
+	var s Scalar
+	s.add(q, &ecmultConstK)
+	s.half(&s)
+	v1.splitLambda(v2, &s)
+	v1.add(v1, &ecmultConstSOffset)
+	v2.add(v2, &ecmultConstSOffset)
+	s.clear()
+}
+
+// ecmultConstRecoded computes r = q * a in constant time from the recoded
+// scalar v1, v2 of ecmultConstRecode
+func ecmultConstRecoded(r *GroupElementJacobian, a *GroupElementAffine, v1, v2 *Scalar) {
+	var preA, preALam [ecmultConstTableSize]GroupElementAffine
+	var globalZ FieldElement
+	var t GroupElementAffine
+
+	// The point is public, and the table construction below cannot deal with
+	// infinity in constant time anyway
+	if a.isInfinity() {
+		r.setInfinity()
+		return
+	}
+
+	// Calculate odd multiples of a and lambda*a, brought to the same z
+	// denominator. Due to the isomorphism the loop can pretend z is 1, use
+	// mixed additions, and correct the z coordinate of the result at the end.
+	r.setGE(a)
+	ecmultConstOddMultiplesTableGlobalZ(preA[:], &globalZ, r)
+	for i := range preA {
+		preALam[i].mulLambda(&preA[i])
+	}
+
+	// r = C_l(v1, A) + C_l(v2, lambda*A), ecmultConstGroupSize bits at a
+	// time from the top. getBits is only variable in offset and count, never
+	// in the scalar.
+	for group := ecmultConstGroups - 1; group >= 0; group-- {
+		bits1 := v1.getBits(uint(group*ecmultConstGroupSize), ecmultConstGroupSize)
+		bits2 := v2.getBits(uint(group*ecmultConstGroupSize), ecmultConstGroupSize)
+
+		ecmultConstTableGetGE(&t, preA[:], bits1)
+		if group == ecmultConstGroups-1 {
+			// Directly set r in the first iteration
+			r.setGE(&t)
+		} else {
+			// Shift the result so far up
+			for j := 0; j < ecmultConstGroupSize; j++ {
+				r.double(r)
+			}
+			r.addGEConst(r, &t)
+		}
+		ecmultConstTableGetGE(&t, preALam[:], bits2)
+		r.addGEConst(r, &t)
+	}
+
+	// Map the result back to the secp256k1 curve from the isomorphic curve
+	r.z.mul(&r.z, &globalZ)
+}
+
+// ecmultConstXOnly sets r to the x coordinate of q*P, where P is a point with
+// affine x coordinate n/d, without ever computing a square root. d may be nil
+// to mean 1. Unless knownOnCurve is set, false is returned when no such point
+// exists. q must be nonzero; r is normalized on return.
+//
+// With g = n^3 + 7*d^3 and v = sqrt(d*g), P has Jacobian coordinates
+// (n*g, g^2, v) (or the negation, which has the same x). On the isomorphic
+// curve obtained by dividing out v that is the affine point (n*g, g^2), so
+// q*P = (X, Y, Z*v) where (X, Y, Z) = q*(n*g, g^2) there, and the affine x
+// coordinate of q*P is X / (Z^2*d*g).
+func ecmultConstXOnly(r *FieldElement, n, d *FieldElement, q *Scalar, knownOnCurve bool) bool {
+	var g, i FieldElement
+	var p GroupElementAffine
+	var rj GroupElementJacobian
+
+	// Compute g = n^3 + 7*d^3
+	g.sqr(n)
+	g.mul(&g, n)
+	if d != nil {
+		var b FieldElement
+		b.sqr(d)
+		b.mulInt(7)
+		b.mul(&b, d)
+		g.add(&b)
+		if !knownOnCurve {
+			// is_square((n/d)^3 + 7) <=> is_square((n^3 + 7*d^3) * d), by
+			// multiplying with d^4
+			var c FieldElement
+			c.mul(&g, d)
+			if !c.isSquareVar() {
+				return false
+			}
+		}
+	} else {
+		var seven FieldElement
+		seven.setInt(7)
+		g.add(&seven)
+		if !knownOnCurve {
+			// g at this point equals x^3 + 7
+			if !g.isSquareVar() {
+				return false
+			}
+		}
+	}
+
+	// Compute the effective affine base point P = (n*g, g^2)
+	p.x.mul(&g, n)
+	p.y.sqr(&g)
+	p.infinity = false
+
+	EcmultConst(&rj, &p, q)
+
+	// The result (X, Y, Z) corresponds to (X, Y, Z*v) on secp256k1, whose
+	// affine x coordinate is X / (Z^2*d*g)
+	i.sqr(&rj.z)
+	i.mul(&i, &g)
+	if d != nil {
+		i.mul(&i, d)
+	}
+	i.inv(&i)
+	r.mul(&rj.x, &i)
+	r.normalize()
+
+	return true
+}
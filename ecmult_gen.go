@@ -17,12 +17,43 @@ const (
 // Each entry stores [X, Y] coordinates as 32-byte arrays
 type bytePointTable [numBytes][numByteValues][2][32]byte
 
+// genStorageTable is the limb storage layout of the byte points table:
+// storagePoints[byteNum][byteVal] holds the same point as
+// bytePoints[byteNum][byteVal], but as normalized 4x64 limbs so a lookup is a
+// plain limb load instead of two 32-byte decodes
+type genStorageTable [numBytes][numByteValues]geStorage
+
 // EcmultGenContext holds precomputed data for generator multiplication
 type EcmultGenContext struct {
-	// Precomputed byte points: bytePoints[byteNum][byteVal] = [X, Y] coordinates
-	// in affine form for byteVal * 2^(8*(31-byteNum)) * G
-	bytePoints  bytePointTable
-	initialized bool
+	// Precomputed byte points in affine form for
+	// byteVal * 2^(8*(31-byteNum)) * G. storagePoints is used when set;
+	// bytePoints is the older big-endian layout, kept for comparison.
+	storagePoints *genStorageTable
+	bytePoints    *bytePointTable
+	initialized   bool
+
+	// Blinded constant-time comb (see ecmult_gen_comb.go). When comb is set
+	// it is used instead of the byte points tables, and the blinding values
+	// satisfy n*G == comb(n + scalarOffset, G/2) + geOffset.
+	comb         *genCombTable
+	scalarOffset Scalar
+	geOffset     GroupElementAffine
+	projBlind    FieldElement
+
+	// Blinding rotation (see rotateBlinding): every rotateEvery
+	// multiplications the blinding value b becomes 2*b + b0, for the b0 the
+	// last blind drew. stepOffset is -(diff + b0), stepPoint is b0*G and
+	// stepBlind the projective blinding factor the last blind drew.
+	rotateEvery uint64
+	sinceRotate uint64
+	hasStep     bool
+	stepOffset  Scalar
+	stepPoint   GroupElementAffine
+	stepBlind   FieldElement
+
+	// Fixed window table (see ecmult_gen_window.go), used instead of the
+	// byte points tables when set
+	window *genWindowTable
 }
 
 var (
@@ -31,8 +62,43 @@ var (
 	genContextOnce   sync.Once
 )
 
-// initGenContext initializes the precomputed byte points table
+// initGenContext points the context at the embedded byte points table, or
+// computes the table if none was embedded. Builds with compact tables use the
+// comb of the default configuration instead, unblinded.
 func (ctx *EcmultGenContext) initGenContext() {
+	if smallTables {
+		ctx.comb, _ = getCombTable(CombDefaultBlocks, CombDefaultTeeth)
+		ctx.blind(nil)
+	} else if precomputedGenPoints != nil {
+		ctx.storagePoints = precomputedGenPoints
+	} else {
+		ctx.storagePoints = computeGenStoragePoints()
+	}
+	ctx.initialized = true
+}
+
+// computeGenStoragePoints builds the byte points table in limb storage layout
+func computeGenStoragePoints() *genStorageTable {
+	table := new(genStorageTable)
+	forEachGenPoint(func(byteNum, byteVal int, p *GroupElementAffine) {
+		p.toLimbStorage(&table[byteNum][byteVal])
+	})
+	return table
+}
+
+// computeBytePoints builds the byte points table in big-endian byte layout
+func computeBytePoints() *bytePointTable {
+	table := new(bytePointTable)
+	forEachGenPoint(func(byteNum, byteVal int, p *GroupElementAffine) {
+		p.x.getB32(table[byteNum][byteVal][0][:])
+		p.y.getB32(table[byteNum][byteVal][1][:])
+	})
+	return table
+}
+
+// forEachGenPoint calls fn with the normalized point
+// byteVal * 2^(8*(31-byteNum)) * G for every byteNum and non-zero byteVal
+func forEachGenPoint(fn func(byteNum, byteVal int, p *GroupElementAffine)) {
 	// Start with G (generator point)
 	var gJac GroupElementJacobian
 	gJac.setGE(&Generator)
@@ -57,44 +123,30 @@ func (ctx *EcmultGenContext) initGenContext() {
 		}
 	}
 
-	// Now compute all byte points for each byte position
+	// Now compute all byte points for each byte position. Each row is built
+	// with mixed additions in Jacobian form and converted to affine with one
+	// batch inversion.
+	var rowJac [numByteValues]GroupElementJacobian
+	var rowAff [numByteValues]GroupElementAffine
+	var baseAff GroupElementAffine
 	for byteNum := 0; byteNum < numBytes; byteNum++ {
-		base := byteBases[byteNum]
-
-		// Convert base to affine for efficiency
-		var baseAff GroupElementAffine
-		baseAff.setGEJ(&base)
-
 		// bytePoints[byteNum][0] = infinity (point at infinity)
 		// We'll skip this and handle it in the lookup
+		baseAff.setGEJVar(&byteBases[byteNum])
 
-		// bytePoints[byteNum][1] = base
-		var ptJac GroupElementJacobian
-		ptJac.setGE(&baseAff)
-		var ptAff GroupElementAffine
-		ptAff.setGEJ(&ptJac)
-		ptAff.x.normalize()
-		ptAff.y.normalize()
-		ptAff.x.getB32(ctx.bytePoints[byteNum][1][0][:])
-		ptAff.y.getB32(ctx.bytePoints[byteNum][1][1][:])
-
-		// Compute bytePoints[byteNum][byteVal] = byteVal * base
-		// We'll use addition to build up multiples
-		var accJac GroupElementJacobian = ptJac
-		var accAff GroupElementAffine
-
+		// rowJac[byteVal] = byteVal * base
+		rowJac[1].setGE(&baseAff)
 		for byteVal := 2; byteVal < numByteValues; byteVal++ {
-			// acc = acc + base
-			accJac.addVar(&accJac, &ptJac)
-			accAff.setGEJ(&accJac)
-			accAff.x.normalize()
-			accAff.y.normalize()
-			accAff.x.getB32(ctx.bytePoints[byteNum][byteVal][0][:])
-			accAff.y.getB32(ctx.bytePoints[byteNum][byteVal][1][:])
+			rowJac[byteVal].addGE(&rowJac[byteVal-1], &baseAff)
 		}
-	}
 
-	ctx.initialized = true
+		geSetAllGEJVar(rowAff[1:], rowJac[1:])
+		for byteVal := 1; byteVal < numByteValues; byteVal++ {
+			rowAff[byteVal].x.normalize()
+			rowAff[byteVal].y.normalize()
+			fn(byteNum, byteVal, &rowAff[byteVal])
+		}
+	}
 }
 
 // getGlobalGenContext returns the global precomputed context
@@ -114,12 +166,24 @@ func NewEcmultGenContext() *EcmultGenContext {
 }
 
 // ecmultGen computes r = n * G where G is the generator point
-// Uses 8-bit byte-based lookup table (like btcec) for maximum efficiency
+// Uses 8-bit byte-based lookup table (like btcec) for maximum efficiency,
+// which is variable time; comb contexts use the constant-time comb instead
 func (ctx *EcmultGenContext) ecmultGen(r *GroupElementJacobian, n *Scalar) {
 	if !ctx.initialized {
 		panic("ecmult_gen context not initialized")
 	}
 
+	if ctx.comb != nil {
+		if ctx.rotateEvery != 0 {
+			if ctx.sinceRotate++; ctx.sinceRotate >= ctx.rotateEvery {
+				ctx.rotateBlinding()
+				ctx.sinceRotate = 0
+			}
+		}
+		ctx.ecmultGenComb(r, n)
+		return
+	}
+
 	// Handle zero scalar
 	if n.isZero() {
 		r.setInfinity()
@@ -132,6 +196,11 @@ func (ctx *EcmultGenContext) ecmultGen(r *GroupElementJacobian, n *Scalar) {
 		return
 	}
 
+	if ctx.window != nil {
+		ctx.ecmultGenWindow(r, n)
+		return
+	}
+
 	// Byte-based method: process one byte at a time (MSB to LSB)
 	// For each byte, lookup the precomputed point and add it
 	r.setInfinity()
@@ -142,7 +211,6 @@ func (ctx *EcmultGenContext) ecmultGen(r *GroupElementJacobian, n *Scalar) {
 
 	// Pre-allocate group elements to avoid repeated allocations
 	var ptAff GroupElementAffine
-	var ptJac GroupElementJacobian
 	var xFe, yFe FieldElement
 
 	for byteNum := 0; byteNum < numBytes; byteNum++ {
@@ -154,18 +222,17 @@ func (ctx *EcmultGenContext) ecmultGen(r *GroupElementJacobian, n *Scalar) {
 		}
 
 		// Lookup precomputed point for this byte - optimized: reuse field elements
-		xFe.setB32(ctx.bytePoints[byteNum][byteVal][0][:])
-		yFe.setB32(ctx.bytePoints[byteNum][byteVal][1][:])
-		ptAff.setXY(&xFe, &yFe)
-
-		// Convert to Jacobian and add - optimized: reuse Jacobian element
-		ptJac.setGE(&ptAff)
-
-		if r.isInfinity() {
-			*r = ptJac
+		if ctx.storagePoints != nil {
+			ptAff.fromLimbStorage(&ctx.storagePoints[byteNum][byteVal])
 		} else {
-			r.addVar(r, &ptJac)
+			xFe.setB32(ctx.bytePoints[byteNum][byteVal][0][:])
+			yFe.setB32(ctx.bytePoints[byteNum][byteVal][1][:])
+			ptAff.setXY(&xFe, &yFe)
 		}
+
+		// Table points are affine, so a mixed addition is enough; addGE
+		// also handles r at infinity
+		r.addGE(r, &ptAff)
 	}
 }
 
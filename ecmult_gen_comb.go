@@ -0,0 +1,399 @@
+package p256k1
+
+import (
+	"errors"
+	"math/bits"
+	"sync"
+)
+
+// Constant-time generator multiplication with a blinded signed-digit
+// multi-comb, ported from src/ecmult_gen_impl.h and
+// src/ecmult_gen_compute_table_impl.h.
+//
+// The scalar is split into blocks*teeth*spacing bits. Each of the blocks has
+// a table of 1 << (teeth-1) points; every addition scans its whole table with
+// cmov, so neither the timing nor the memory access pattern depends on the
+// scalar. There are blocks*spacing additions and spacing-1 doublings, so more
+// teeth or blocks trade a larger table for fewer group operations.
+//
+// The scalar is blinded as n*G = (n - b)*G + b*G, and the first point of
+// every multiplication gets a random Z coordinate. ContextRandomize picks new
+// b and Z blinding values.
+
+const (
+	// combRange is the number of bits in supported scalars
+	combRange = 256
+
+	// combMaxBits bounds blocks*teeth*spacing over all accepted
+	// configurations: the sanity checks in newCombTable keep the first
+	// blocks-1 blocks below 256 bits, and one block covers at most
+	// 256 + teeth bits
+	combMaxBits = 2*combRange + 8
+)
+
+// genCombTable is the precomputed table of one comb configuration. It is
+// read-only once built and may be shared between contexts.
+type genCombTable struct {
+	blocks  int
+	teeth   int
+	spacing int
+	points  int         // 1 << (teeth-1) entries per block
+	table   []geStorage // blocks*points entries
+	diff    Scalar      // (2^(blocks*teeth*spacing) - 1) / 2
+}
+
+var (
+	// defaultCombTable is shared by all contexts using the default
+	// configuration
+	defaultCombTable     *genCombTable
+	defaultCombTableOnce sync.Once
+)
+
+// getCombTable returns the comb table for blocks and teeth, reusing the
+// shared table of the default configuration
+func getCombTable(blocks, teeth int) (*genCombTable, error) {
+	if blocks == CombDefaultBlocks && teeth == CombDefaultTeeth {
+		defaultCombTableOnce.Do(func() {
+			defaultCombTable, _ = newCombTable(blocks, teeth)
+		})
+		return defaultCombTable, nil
+	}
+	return newCombTable(blocks, teeth)
+}
+
+// newCombTable validates a comb configuration and computes its table
+func newCombTable(blocks, teeth int) (*genCombTable, error) {
+	if blocks < 1 || blocks > 256 {
+		return nil, errors.New("comb blocks must be in the range [1, 256]")
+	}
+	if teeth < 1 || teeth > 8 {
+		return nil, errors.New("comb teeth must be in the range [1, 8]")
+	}
+	spacing := (combRange + blocks*teeth - 1) / (blocks * teeth)
+
+	// These are not strictly required, but prevent gratuitously inefficient
+	// configurations
+	if (blocks-1)*teeth*spacing >= 256 {
+		return nil, errors.New("comb blocks can be reduced")
+	}
+	if blocks*(teeth-1)*spacing >= 256 {
+		return nil, errors.New("comb teeth can be reduced")
+	}
+
+	c := &genCombTable{
+		blocks:  blocks,
+		teeth:   teeth,
+		spacing: spacing,
+		points:  1 << uint(teeth-1),
+	}
+	c.table = make([]geStorage, blocks*c.points)
+	c.compute()
+	c.scalarDiff(&c.diff)
+	return c, nil
+}
+
+// bits returns the number of scalar bits covered by all blocks
+func (c *genCombTable) bits() int {
+	return c.blocks * c.teeth * c.spacing
+}
+
+// compute fills the table, following secp256k1_ecmult_gen_compute_table.
+// Entry [block][index] is table(block, m) = (m - mask(block)/2) * G, see
+// ecmultGenComb.
+func (c *genCombTable) compute() {
+	total := c.blocks * c.points
+	ds := make([]GroupElementJacobian, c.teeth)
+	vs := make([]GroupElementJacobian, total)
+	vsPos := 0
+
+	// u is the running power of two times G we're working with, initially G/2
+	var half Scalar
+	half.half(&ScalarOne)
+	var u GroupElementJacobian
+	u.setInfinity()
+	for i := 255; i >= 0; i-- {
+		// Use a very simple multiplication ladder to avoid dependency on ecmult
+		u.double(&u)
+		if half.getBits(uint(i), 1) != 0 {
+			u.addGE(&u, &Generator)
+		}
+	}
+
+	for block := 0; block < c.blocks; block++ {
+		// Here u = 2^(block*teeth*spacing) * G/2
+		var sum GroupElementJacobian
+		sum.setInfinity()
+		for tooth := 0; tooth < c.teeth; tooth++ {
+			// Make sum = sum(2^((block*teeth + t)*spacing), t=0..tooth) * G/2
+			sum.addVar(&sum, &u)
+			// Make u = 2^((block*teeth + tooth)*spacing + 1) * G/2
+			u.double(&u)
+			ds[tooth] = u
+			// Make u = 2^((block*teeth + tooth + 1)*spacing) * G/2, unless at the end
+			if block+tooth != c.blocks+c.teeth-2 {
+				for bitOff := 1; bitOff < c.spacing; bitOff++ {
+					u.double(&u)
+				}
+			}
+		}
+
+		// The first entry of the block has all summed powers of two negative;
+		// then teeth-1 times double the range of computed entries by adding
+		// ds[tooth] to the existing ones
+		vs[vsPos].negate(&sum)
+		vsPos++
+		for tooth := 0; tooth < c.teeth-1; tooth++ {
+			stride := 1 << uint(tooth)
+			for index := 0; index < stride; index++ {
+				vs[vsPos].addVar(&vs[vsPos-stride], &ds[tooth])
+				vsPos++
+			}
+		}
+	}
+
+	// Convert all points to affine with a single inversion
+	ps := make([]GroupElementAffine, total)
+	geSetAllGEJVar(ps, vs)
+	for i := range ps {
+		ps[i].toLimbStorage(&c.table[i])
+	}
+}
+
+// scalarDiff computes (2^bits - 1) / 2, the difference between the scalar
+// passed to ecmultGenComb and the scalar the table lookup bits are drawn from
+// (before blinding). Follows secp256k1_ecmult_gen_scalar_diff.
+func (c *genCombTable) scalarDiff(diff *Scalar) {
+	// Compute scalar -1/2
+	var neghalf Scalar
+	neghalf.half(&ScalarOne)
+	neghalf.negate(&neghalf)
+
+	// Compute offset = 2^(bits - 1)
+	*diff = ScalarOne
+	for i := 0; i < c.bits()-1; i++ {
+		diff.add(diff, diff)
+	}
+
+	// The result is the sum 2^(bits - 1) + (-1/2)
+	diff.add(diff, &neghalf)
+}
+
+// NewEcmultGenCombContext creates a generator multiplication context that
+// uses the constant-time comb with the given configuration. Tables of the
+// default configuration (CombDefaultBlocks, CombDefaultTeeth) are shared;
+// other configurations get their own table. The context starts unblinded;
+// call blind (through ContextRandomize) to randomize it.
+func NewEcmultGenCombContext(blocks, teeth int) (*EcmultGenContext, error) {
+	comb, err := getCombTable(blocks, teeth)
+	if err != nil {
+		return nil, err
+	}
+	ctx := &EcmultGenContext{comb: comb}
+	ctx.blind(nil)
+	ctx.initialized = true
+	return ctx, nil
+}
+
+// ecmultGenComb computes r = gn*G in constant time with the blinded comb,
+// following secp256k1_ecmult_gen.
+//
+// With comb(s, P) = sum((2*s[i]-1)*2^i*P for i=0..bits-1) we have
+//
+//	n*G = comb(n + scalarOffset, G/2) + geOffset
+//
+// where scalarOffset = (2^bits - 1)/2 - b and geOffset = b*G for the blinding
+// value b. Let mask(block) = sum(2^((block*teeth + t)*spacing) for
+// t=0..teeth-1). comb(d, G/2) is then
+//
+//	sum(2^i * sum(table(block, d>>i & mask(block)), block=0..blocks-1), i=0..spacing-1)
+//
+// with table(block, m) = (m - mask(block)/2) * G precomputed for every value
+// of m. Flipping all bits of m negates table(block, m), so only the first
+// half of the entries is stored and the other half is looked up negated.
+func (ctx *EcmultGenContext) ecmultGenComb(r *GroupElementJacobian, gn *Scalar) {
+	c := ctx.comb
+	var add GroupElementAffine
+	var neg FieldElement
+	var adds geStorage
+	var d Scalar
+	// Large enough for the bits of any configuration; only the bottom 8
+	// words are ever nonzero, and the zero padding avoids out-of-bounds reads
+	// when bits() > 256
+	var recoded [(combMaxBits + 31) >> 5]uint32
+	first := true
+
+	// Compute the scalar d = (gn + scalarOffset) and convert it to words
+	d.add(&ctx.scalarOffset, gn)
+	for i := 0; i < 8; i++ {
+		recoded[i] = d.getBits(uint(32*i), 32)
+	}
+	d.clear()
+
+	// Outer loop: iterate over combOff from spacing - 1 down to 0
+	combOff := c.spacing - 1
+	for {
+		bitPos := combOff
+		// Inner loop: for each block, add table entries to the result
+		for block := 0; block < c.blocks; block++ {
+			// Gather the mask(block)-selected bits of d into bits. They're
+			// packed: bits[tooth] = d[(block*teeth + tooth)*spacing + combOff].
+			// Instead of reading individual bits, build up the result by
+			// xoring rotated reads together, so no intermediate variable can
+			// take on only a few values.
+			var digit uint32
+			for tooth := 0; tooth < c.teeth; tooth++ {
+				bitdata := bits.RotateLeft32(recoded[bitPos>>5], -(bitPos & 0x1f))
+				// Clear the bit at position tooth and write the bit into it
+				// (and junk into higher bits)
+				digit &= ^(uint32(1) << uint(tooth))
+				digit ^= bitdata << uint(tooth)
+				bitPos += c.spacing
+			}
+
+			// If the top bit of digit is 1, flip them all (corresponding to
+			// looking up the negated table value), and remember to negate the
+			// result in sign
+			sign := (digit >> uint(c.teeth-1)) & 1
+			abs := (digit ^ -sign) & uint32(c.points-1)
+
+			// Scan the whole table with cmov so that no secret data is used
+			// as an array index
+			entries := c.table[block*c.points : (block+1)*c.points]
+			for index := range entries {
+				adds.cmov(&entries[index], boolToInt(uint32(index) == abs))
+			}
+
+			// Set add=adds or add=-adds, in constant time, based on sign
+			add.fromLimbStorage(&adds)
+			neg.negate(&add.y, 1)
+			add.y.cmov(&neg, int(sign))
+
+			if first {
+				// For the first table lookup the addition can be skipped; give
+				// the entry a random Z coordinate to blind intermediate results
+				r.setGE(&add)
+				r.rescale(&ctx.projBlind)
+				first = false
+			} else {
+				r.addGEConst(r, &add)
+			}
+		}
+
+		// Double the result, except in the last iteration
+		if combOff == 0 {
+			break
+		}
+		combOff--
+		r.double(r)
+	}
+
+	// Correct for the scalarOffset added at the start (geOffset = b*G,
+	// while b was subtracted from the input scalar gn)
+	r.addGEConst(r, &ctx.geOffset)
+
+	neg.clear()
+	add.clear()
+	adds = geStorage{}
+	recoded = [len(recoded)]uint32{}
+}
+
+// blind sets up the blinding values of a comb context from seed32, chaining
+// in the previous blinding scalar. A nil seed resets blinding. Follows
+// secp256k1_ecmult_gen_blind.
+func (ctx *EcmultGenContext) blind(seed32 []byte) {
+	c := ctx.comb
+
+	if seed32 == nil {
+		// When seed is nil, reset the final point and blinding value
+		ctx.geOffset.negate(&Generator)
+		ctx.scalarOffset.add(&ScalarOne, &c.diff)
+		ctx.projBlind = FieldElementOne
+		ctx.clearStep()
+		return
+	}
+
+	// The prior blinding value (if not reset) is chained forward by
+	// including it in the hash
+	var keydata [64]byte
+	ctx.scalarOffset.getB32(keydata[:32])
+	copy(keydata[32:], seed32)
+	var rng RFC6979HMACSHA256
+	rng.init(keydata[:])
+	keydata = [64]byte{}
+
+	// Compute projective blinding factor (cannot be 0)
+	var nonce32 [32]byte
+	var f FieldElement
+	rng.Generate(nonce32[:])
+	f.setB32(nonce32[:])
+	f.cmov(&FieldElementOne, boolToInt(f.normalizesToZero()))
+	ctx.projBlind = f
+
+	// For a random blinding value b, set scalarOffset = diff - b and
+	// geOffset = b*G. b cannot be zero, as that would make geOffset
+	// infinity, which addGEConst cannot handle.
+	var b Scalar
+	rng.Generate(nonce32[:])
+	b.setB32(nonce32[:])
+	b.cmov(&ScalarOne, boolToInt(b.isZero()))
+	rng.Finalize()
+
+	var gb GroupElementJacobian
+	ctx.ecmultGenComb(&gb, &b)
+	b.negate(&b)
+	ctx.scalarOffset.add(&b, &c.diff)
+	ctx.geOffset.setGEJ(&gb)
+
+	// Keep b0 = b and f for rotating the blinding later
+	ctx.stepOffset.negate(&c.diff)
+	ctx.stepOffset.add(&ctx.stepOffset, &b)
+	ctx.stepPoint = ctx.geOffset
+	ctx.stepBlind = f
+	ctx.hasStep = true
+	ctx.sinceRotate = 0
+
+	nonce32 = [32]byte{}
+	b.clear()
+	gb.clear()
+	f.clear()
+	rng.Clear()
+}
+
+// rotateBlinding replaces the blinding value b by 2*b + b0 and the
+// projective blinding factor by its product with the one blind drew, where
+// b0 is the blinding value blind drew. Unlike blind, which runs a whole comb
+// multiplication, it costs a point doubling, a mixed addition and the
+// setGEJ normalization of the result back to the affine offset point, all
+// in constant time. The sequence of blinding values is as secret as b0;
+// blind with a fresh seed from time to time still mixes in new randomness.
+// A context without a blind since its last reset is left as it is.
+func (ctx *EcmultGenContext) rotateBlinding() {
+	if !ctx.hasStep {
+		return
+	}
+
+	// scalarOffset = diff - b becomes diff - (2*b + b0) =
+	// 2*scalarOffset - diff - b0
+	ctx.scalarOffset.add(&ctx.scalarOffset, &ctx.scalarOffset)
+	ctx.scalarOffset.add(&ctx.scalarOffset, &ctx.stepOffset)
+
+	// geOffset = b*G becomes 2*geOffset + b0*G. It would be infinity only
+	// when 2*b + b0 is zero, which has negligible probability.
+	var r GroupElementJacobian
+	r.setGE(&ctx.geOffset)
+	r.double(&r)
+	r.addGEConst(&r, &ctx.stepPoint)
+	ctx.geOffset.setGEJ(&r)
+	r.clear()
+
+	ctx.projBlind.mul(&ctx.projBlind, &ctx.stepBlind)
+}
+
+// clearStep wipes the blinding rotation state
+func (ctx *EcmultGenContext) clearStep() {
+	ctx.hasStep = false
+	ctx.sinceRotate = 0
+	ctx.stepOffset.clear()
+	ctx.stepPoint.clear()
+	ctx.stepBlind.clear()
+}
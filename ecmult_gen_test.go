@@ -0,0 +1,310 @@
+package p256k1
+
+import (
+	"fmt"
+	"testing"
+	"unsafe"
+)
+
+// genLayoutContexts returns generator contexts for both table layouts
+func genLayoutContexts() []struct {
+	name string
+	ctx  EcmultGenContext
+} {
+	return []struct {
+		name string
+		ctx  EcmultGenContext
+	}{
+		{"storage", EcmultGenContext{storagePoints: computeGenStoragePoints(), initialized: true}},
+		{"bytes", EcmultGenContext{bytePoints: computeBytePoints(), initialized: true}},
+	}
+}
+
+func TestEcmultGenLayouts(t *testing.T) {
+	layouts := genLayoutContexts()
+	for i := 0; i < 16; i++ {
+		k := randomScalar(t)
+		var want GroupElementJacobian
+		var kj GroupElementJacobian
+		kj.setGE(&Generator)
+		Ecmult(&want, &kj, &k)
+		for _, l := range layouts {
+			var got GroupElementJacobian
+			l.ctx.ecmultGen(&got, &k)
+			if !jacobianEqual(&got, &want) {
+				t.Fatalf("%s layout: ecmultGen does not match Ecmult", l.name)
+			}
+		}
+	}
+}
+
+// BenchmarkEcmultGenLayout compares the two byte points table layouts on the
+// public key and signing paths
+func BenchmarkEcmultGenLayout(b *testing.B) {
+	seckey := make([]byte, 32)
+	for i := range seckey {
+		seckey[i] = 0x01
+	}
+	keypair, err := KeyPairCreate(seckey)
+	if err != nil {
+		b.Fatal(err)
+	}
+	msg := make([]byte, 32)
+	sig := make([]byte, 64)
+
+	global := getGlobalGenContext()
+	saved := *global
+	defer func() { *global = saved }()
+
+	for _, l := range genLayoutContexts() {
+		*global = l.ctx
+		b.Run(l.name+"/ECPubkeyCreate", func(b *testing.B) {
+			var pubkey PublicKey
+			for i := 0; i < b.N; i++ {
+				ECPubkeyCreate(&pubkey, seckey)
+			}
+		})
+		b.Run(l.name+"/SchnorrSign", func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				if err := SchnorrSign(sig, msg, keypair, nil); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+func TestEcmultGenComb(t *testing.T) {
+	configs := [][2]int{{CombDefaultBlocks, CombDefaultTeeth}, {1, 8}, {2, 8}, {4, 5}, {22, 3}, {43, 6}, {256, 1}}
+	var nMinusOne Scalar
+	nMinusOne.negate(&ScalarOne)
+	edge := []Scalar{{}, ScalarOne, nMinusOne}
+
+	for _, cfg := range configs {
+		gen, err := NewEcmultGenCombContext(cfg[0], cfg[1])
+		if err != nil {
+			t.Fatalf("blocks=%d teeth=%d: %v", cfg[0], cfg[1], err)
+		}
+		for round := 0; round < 2; round++ {
+			if round == 1 {
+				var seed [32]byte
+				seed[0] = byte(cfg[0])
+				gen.blind(seed[:])
+			}
+			for i := 0; i < 8+len(edge); i++ {
+				var k Scalar
+				if i < len(edge) {
+					k = edge[i]
+				} else {
+					k = randomScalar(t)
+				}
+				var got, want GroupElementJacobian
+				gen.ecmultGen(&got, &k)
+				getGlobalGenContext().ecmultGen(&want, &k)
+				if !jacobianEqual(&got, &want) {
+					t.Fatalf("blocks=%d teeth=%d round=%d: comb does not match byte table", cfg[0], cfg[1], round)
+				}
+			}
+		}
+	}
+
+	for _, cfg := range [][2]int{{0, 6}, {11, 0}, {257, 1}, {11, 9}, {20, 6}} {
+		if _, err := NewEcmultGenCombContext(cfg[0], cfg[1]); err == nil {
+			t.Errorf("blocks=%d teeth=%d should be rejected", cfg[0], cfg[1])
+		}
+	}
+}
+
+func TestEcmultGenCombRotateBlinding(t *testing.T) {
+	gen, err := NewEcmultGenCombContext(CombDefaultBlocks, CombDefaultTeeth)
+	if err != nil {
+		t.Fatal(err)
+	}
+	var seed [32]byte
+	seed[0] = 3
+	gen.blind(seed[:])
+	before := gen.scalarOffset
+	gen.rotateEvery = 3
+	for i := 0; i < 10; i++ {
+		k := randomScalar(t)
+		var got, want GroupElementJacobian
+		gen.ecmultGen(&got, &k)
+		getGlobalGenContext().ecmultGen(&want, &k)
+		if !jacobianEqual(&got, &want) {
+			t.Fatalf("multiplication %d after rotating does not match byte table", i)
+		}
+	}
+	if gen.scalarOffset.equal(&before) {
+		t.Error("blinding was not rotated")
+	}
+
+	// Without a seeded blind there is nothing to rotate from
+	gen.blind(nil)
+	before = gen.scalarOffset
+	gen.rotateBlinding()
+	if !gen.scalarOffset.equal(&before) || !gen.projBlind.equal(&FieldElementOne) {
+		t.Error("rotating an unblinded context changed it")
+	}
+}
+
+func BenchmarkEcmultGenComb(b *testing.B) {
+	k := randomScalar(b)
+	var r GroupElementJacobian
+
+	b.Run("var", func(b *testing.B) {
+		gen := getGlobalGenContext()
+		for i := 0; i < b.N; i++ {
+			gen.ecmultGen(&r, &k)
+		}
+	})
+	for _, cfg := range [][2]int{{43, 6}, {22, 6}, {CombDefaultBlocks, CombDefaultTeeth}, {4, 8}, {2, 8}} {
+		gen, err := NewEcmultGenCombContext(cfg[0], cfg[1])
+		if err != nil {
+			b.Fatal(err)
+		}
+		gen.blind(make([]byte, 32))
+		b.Run(fmt.Sprintf("comb/blocks=%d/teeth=%d", cfg[0], cfg[1]), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				gen.ecmultGen(&r, &k)
+			}
+		})
+	}
+
+	gen, _ := NewEcmultGenCombContext(CombDefaultBlocks, CombDefaultTeeth)
+	seed := make([]byte, 32)
+	b.Run("blind", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			gen.blind(seed)
+		}
+	})
+	b.Run("rotate", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			gen.rotateBlinding()
+		}
+	})
+}
+
+func TestEcmultGenWindow(t *testing.T) {
+	var nMinusOne Scalar
+	nMinusOne.negate(&ScalarOne)
+	edge := []Scalar{{}, ScalarOne, nMinusOne}
+
+	for bits := 1; bits <= 8; bits++ {
+		gen, err := NewEcmultGenWindowContext(bits)
+		if err != nil {
+			t.Fatalf("bits=%d: %v", bits, err)
+		}
+		if addr := uintptr(unsafe.Pointer(&gen.window.entries[0])); addr%cacheLineSize != 0 {
+			t.Errorf("bits=%d: table is not cache line aligned", bits)
+		}
+		for i := 0; i < 8+len(edge); i++ {
+			var k Scalar
+			if i < len(edge) {
+				k = edge[i]
+			} else {
+				k = randomScalar(t)
+			}
+			var got, want GroupElementJacobian
+			gen.ecmultGen(&got, &k)
+			getGlobalGenContext().ecmultGen(&want, &k)
+			if !jacobianEqual(&got, &want) {
+				t.Fatalf("bits=%d: window table does not match byte table", bits)
+			}
+		}
+	}
+	for _, bits := range []int{0, 9} {
+		if _, err := NewEcmultGenWindowContext(bits); err == nil {
+			t.Errorf("bits=%d should be rejected", bits)
+		}
+	}
+
+	ctx := ContextCreate(ContextSign | ContextConstantTime)
+	if err := ContextSetEcmultGenWindow(ctx, 4); err != nil || ctx.flags&ContextConstantTime != 0 {
+		t.Error("ContextSetEcmultGenWindow did not switch to the window table")
+	}
+	if ContextSetEcmultGenWindow(ContextCreate(ContextVerify), 4) == nil {
+		t.Error("verify-only context accepted a window table")
+	}
+}
+
+// BenchmarkEcmultGenWindow sweeps the window width of the variable-time
+// generator table, reporting the table size next to the multiplication and
+// signing times. Cache misses per operation can be counted by running it
+// under perf stat -e L1-dcache-load-misses,l2_rqsts.miss.
+func BenchmarkEcmultGenWindow(b *testing.B) {
+	seckey := make([]byte, 32)
+	for i := range seckey {
+		seckey[i] = 0x01
+	}
+	keypair, err := KeyPairCreate(seckey)
+	if err != nil {
+		b.Fatal(err)
+	}
+	msg := make([]byte, 32)
+	sig := make([]byte, 64)
+	k := randomScalar(b)
+
+	for bits := 2; bits <= 8; bits++ {
+		ctx := ContextCreate(ContextSign)
+		if err := ContextSetEcmultGenWindow(ctx, bits); err != nil {
+			b.Fatal(err)
+		}
+		kib := float64(len(ctx.ecmultGenCtx.window.entries)) * float64(unsafe.Sizeof(geStorage{})) / 1024
+		b.Run(fmt.Sprintf("bits=%d/ecmultGen", bits), func(b *testing.B) {
+			var r GroupElementJacobian
+			for i := 0; i < b.N; i++ {
+				ctx.ecmultGenCtx.ecmultGen(&r, &k)
+			}
+			b.ReportMetric(kib, "KiB")
+		})
+		b.Run(fmt.Sprintf("bits=%d/SchnorrSign", bits), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				if err := ctx.SchnorrSign(sig, msg, keypair, nil); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
+
+// BenchmarkContextSign compares signing through a variable-time and a
+// constant-time context
+func BenchmarkContextSign(b *testing.B) {
+	seckey := make([]byte, 32)
+	for i := range seckey {
+		seckey[i] = 0x01
+	}
+	keypair, err := KeyPairCreate(seckey)
+	if err != nil {
+		b.Fatal(err)
+	}
+	msg := make([]byte, 32)
+	sig := make([]byte, 64)
+
+	for _, mode := range []struct {
+		name  string
+		flags uint
+	}{
+		{"var", ContextSign},
+		{"comb", ContextSign | ContextConstantTime},
+	} {
+		ctx := ContextCreate(mode.flags)
+		if err := ContextRandomize(ctx, nil); err != nil {
+			b.Fatal(err)
+		}
+		b.Run(mode.name+"/ECPubkeyCreate", func(b *testing.B) {
+			var pubkey PublicKey
+			for i := 0; i < b.N; i++ {
+				ctx.ECPubkeyCreate(&pubkey, seckey)
+			}
+		})
+		b.Run(mode.name+"/SchnorrSign", func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				if err := ctx.SchnorrSign(sig, msg, keypair, nil); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+		ContextDestroy(ctx)
+	}
+}
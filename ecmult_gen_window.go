@@ -0,0 +1,101 @@
+package p256k1
+
+import (
+	"errors"
+	"unsafe"
+)
+
+// cacheLineSize is the cache line size assumed for table alignment
+const cacheLineSize = 64
+
+// genWindowTable is a generator table for fixed windows of bits bits:
+// entry [i<<bits + v] is v * 2^(bits*i) * G, with window i counted from the
+// least significant bit of the scalar. The byte points table is the 8-bit
+// case at 512 KiB; smaller windows take more additions per multiplication
+// but fit in the caches, e.g. 4-bit windows are 64 x 16 entries, 64 KiB.
+//
+// An entry in limb storage form is 64 bytes and the table starts on a cache
+// line boundary, so every lookup touches exactly one line.
+type genWindowTable struct {
+	bits    uint
+	windows int
+	entries []geStorage // windows << bits entries, entry v == 0 is unused
+}
+
+// newCacheAlignedStorage returns n zeroed entries starting on a cache line
+// boundary
+func newCacheAlignedStorage(n int) []geStorage {
+	buf := make([]geStorage, n+1)
+	pad := (cacheLineSize - uintptr(unsafe.Pointer(&buf[0]))%cacheLineSize) % cacheLineSize
+	return unsafe.Slice((*geStorage)(unsafe.Add(unsafe.Pointer(&buf[0]), pad)), n)
+}
+
+// newGenWindowTable computes the table for windows of the given width
+func newGenWindowTable(bits int) (*genWindowTable, error) {
+	if bits < 1 || bits > 8 {
+		return nil, errors.New("window bits must be in the range [1, 8]")
+	}
+	t := &genWindowTable{
+		bits:    uint(bits),
+		windows: (256 + bits - 1) / bits,
+	}
+	size := 1 << t.bits
+	t.entries = newCacheAlignedStorage(t.windows * size)
+
+	// Each window is built with mixed additions and converted to affine
+	// with one batch inversion
+	jac := make([]GroupElementJacobian, size-1)
+	aff := make([]GroupElementAffine, size-1)
+	var base GroupElementJacobian
+	var baseAff GroupElementAffine
+	base.setGE(&Generator)
+	for i := 0; i < t.windows; i++ {
+		// Here base = 2^(bits*i) * G
+		baseAff.setGEJVar(&base)
+		jac[0].setGE(&baseAff)
+		for v := 1; v < size-1; v++ {
+			jac[v].addGE(&jac[v-1], &baseAff)
+		}
+		geSetAllGEJVar(aff, jac)
+		for v := range aff {
+			aff[v].x.normalize()
+			aff[v].y.normalize()
+			aff[v].toLimbStorage(&t.entries[i<<t.bits+v+1])
+		}
+		for j := 0; j < bits; j++ {
+			base.double(&base)
+		}
+	}
+	return t, nil
+}
+
+// NewEcmultGenWindowContext creates a variable-time generator
+// multiplication context with a table of bits-bit windows, 1 to 8. The
+// default context uses 8-bit windows; see BenchmarkEcmultGenWindow for the
+// trade-off on a given machine.
+func NewEcmultGenWindowContext(bits int) (*EcmultGenContext, error) {
+	window, err := newGenWindowTable(bits)
+	if err != nil {
+		return nil, err
+	}
+	return &EcmultGenContext{window: window, initialized: true}, nil
+}
+
+// ecmultGenWindow computes r = n*G with the window table, adding one table
+// point per non-zero window. Like the byte points table it is variable time.
+func (ctx *EcmultGenContext) ecmultGenWindow(r *GroupElementJacobian, n *Scalar) {
+	t := ctx.window
+	var pt GroupElementAffine
+	r.setInfinity()
+	for i := 0; i < t.windows; i++ {
+		offset := uint(i) * t.bits
+		count := t.bits
+		if offset+count > 256 {
+			count = 256 - offset
+		}
+		if v := n.getBits(offset, count); v != 0 {
+			pt.fromLimbStorage(&t.entries[i<<t.bits+int(v)])
+			r.addGE(r, &pt)
+		}
+	}
+}
@@ -0,0 +1,295 @@
+package p256k1
+
+import (
+	"errors"
+)
+
+// Multi-scalar multiplication, ported from src/ecmult_impl.h
+// (secp256k1_ecmult_strauss_wnaf, secp256k1_ecmult_pippenger_wnaf and
+// secp256k1_ecmult_multi_var).
+//
+// Every routine here computes r = ng*G + sum(scalars[i]*points[i]) where ng
+// may be nil. Internally the generator term is handled as one extra input at
+// index len(points).
+
+const (
+	// ecmultPippengerThreshold is the minimum number of points for which
+	// Pippenger is used instead of Strauss
+	ecmultPippengerThreshold = 88
+
+	// pippengerMaxBucketWindow is the largest bucket window (in bits) that
+	// pippengerBucketWindow will ever select
+	pippengerMaxBucketWindow = 12
+
+	// pippengerWnafBits is the bit length of the scalars fed into wnafFixed.
+	// Scalars are used unsplit, so the full 256 bits are recoded.
+	pippengerWnafBits = 256
+)
+
+// straussState allocates a Strauss state and Jacobian input slice for n
+// points from s
+func (s *Scratch) straussState(n int) (straussState, []GroupElementJacobian) {
+	tableSize := ecmultTableSize(windowA)
+	state := straussState{
+		w:      windowA,
+		aux:    s.fields.alloc(n * tableSize),
+		preA:   s.affine.alloc(n * tableSize),
+		ps:     s.strauss.alloc(n),
+		tables: s.tables,
+	}
+	return state, s.jacobian.alloc(n)
+}
+
+// ecmultMultiInput returns input i, where i == len(points) selects the
+// generator term
+func ecmultMultiInput(points []GroupElementAffine, scalars []Scalar, ng *Scalar, i int) (*GroupElementAffine, *Scalar) {
+	if i == len(points) {
+		return &Generator, ng
+	}
+	return &points[i], &scalars[i]
+}
+
+// EcmultMulti computes r = gScalar*G + sum(scalars[i]*points[i]). gScalar may
+// be nil to omit the generator term. Strauss is used for small inputs and
+// Pippenger above ecmultPippengerThreshold points.
+//
+// This is variable time and must only be used with public data, such as in
+// signature verification.
+func EcmultMulti(r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, gScalar *Scalar) error {
+	if len(points) != len(scalars) {
+		return errors.New("points and scalars must have the same length")
+	}
+	s := scratchPool.Get().(*Scratch)
+	defer scratchPool.Put(s)
+	ecmultMultiVar(s, r, points, scalars, gScalar)
+	return nil
+}
+
+// EcmultMulti is EcmultMulti with its temporaries taken from s
+func (s *Scratch) EcmultMulti(r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, gScalar *Scalar) error {
+	if s == nil {
+		return EcmultMulti(r, points, scalars, gScalar)
+	}
+	if len(points) != len(scalars) {
+		return errors.New("points and scalars must have the same length")
+	}
+	ecmultMultiVar(s, r, points, scalars, gScalar)
+	return nil
+}
+
+// ecmultMultiVar selects Strauss or Pippenger for r = ng*G + sum(scalars[i]*points[i])
+func ecmultMultiVar(s *Scratch, r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, ng *Scalar) {
+	n := len(points)
+	if ng != nil {
+		n++
+	}
+	if n < ecmultPippengerThreshold {
+		ecmultStraussVar(s, r, points, scalars, ng)
+	} else {
+		ecmultPippengerVar(s, r, points, scalars, ng)
+	}
+}
+
+// ecmultStraussVar computes r = ng*G + sum(scalars[i]*points[i]) with
+// ecmultStraussWnaf, taking its temporaries from s
+func ecmultStraussVar(s *Scratch, r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, ng *Scalar) {
+	cp := s.Checkpoint()
+	defer s.Rollback(cp)
+
+	state, pointsJ := s.straussState(len(points))
+	for i := range points {
+		pointsJ[i].setGE(&points[i])
+	}
+	ecmultStraussWnaf(&state, r, pointsJ, scalars, ng)
+}
+
+// wnafSizeBits returns the number of digits of a fixed-window wNAF of the
+// given bit length using window w
+func wnafSizeBits(bits, w int) int {
+	return (bits + w - 1) / w
+}
+
+// wnafFixed converts the first bits bits of s into a fixed-window wNAF with
+// window w. Every digit is odd and lies in the open interval (-2^w, 2^w),
+// except that zero is encoded as all-zero digits. Even scalars are made odd by
+// adding one; the returned skew (0 or 1) records that adjustment so the caller
+// can subtract the point again. wnaf must hold wnafSizeBits(bits, w) entries.
+func (s *Scalar) wnafFixed(wnaf []int, bits, w int) int {
+	n := wnafSizeBits(bits, w)
+
+	if s.isZero() {
+		for pos := 0; pos < n; pos++ {
+			wnaf[pos] = 0
+		}
+		return 0
+	}
+
+	skew := 0
+	work := *s
+	if work.isEven() {
+		skew = 1
+	}
+
+	wnaf[0] = int(work.getBits(0, uint(w))) + skew
+	// Compute the last window size. Relevant when window size doesn't divide
+	// the number of bits in the scalar.
+	lastW := bits - (n-1)*w
+
+	// Store the position of the first nonzero word in maxPos to allow
+	// skipping leading zeros when calculating the wnaf.
+	maxPos := n - 1
+	for pos := n - 1; pos > 0; pos-- {
+		bw := w
+		if pos == n-1 {
+			bw = lastW
+		}
+		val := int(work.getBits(uint(pos*w), uint(bw)))
+		if val != 0 {
+			break
+		}
+		wnaf[pos] = 0
+		maxPos--
+	}
+
+	for pos := 1; pos <= maxPos; pos++ {
+		bw := w
+		if pos == n-1 {
+			bw = lastW
+		}
+		val := int(work.getBits(uint(pos*w), uint(bw)))
+		if val&1 == 0 {
+			wnaf[pos-1] -= 1 << uint(w)
+			wnaf[pos] = val + 1
+		} else {
+			wnaf[pos] = val
+		}
+		// Set a coefficient to zero if it is 1 or -1 and the preceding digit
+		// is strictly negative or strictly positive respectively. Only change
+		// coefficients at previous positions because above we may add 1 to
+		// wnaf[pos].
+		if pos >= 2 && ((wnaf[pos-1] == 1 && wnaf[pos-2] < 0) || (wnaf[pos-1] == -1 && wnaf[pos-2] > 0)) {
+			if wnaf[pos-1] == 1 {
+				wnaf[pos-2] += 1 << uint(w)
+			} else {
+				wnaf[pos-2] -= 1 << uint(w)
+			}
+			wnaf[pos-1] = 0
+		}
+	}
+
+	return skew
+}
+
+// pippengerBucketWindow returns the optimal bucket window for a
+// multiplication with n points. The thresholds are the ones from
+// secp256k1_pippenger_bucket_window, measured for 128-bit split scalars.
+func pippengerBucketWindow(n int) int {
+	switch {
+	case n <= 1:
+		return 1
+	case n <= 4:
+		return 2
+	case n <= 20:
+		return 3
+	case n <= 57:
+		return 4
+	case n <= 136:
+		return 5
+	case n <= 235:
+		return 6
+	case n <= 1260:
+		return 7
+	case n <= 4420:
+		return 9
+	case n <= 7880:
+		return 10
+	case n <= 16050:
+		return 11
+	default:
+		return pippengerMaxBucketWindow
+	}
+}
+
+// ecmultPippengerVar computes r = ng*G + sum(scalars[i]*points[i]) using the
+// bucket method. Points at infinity and zero scalars are skipped.
+func ecmultPippengerVar(scratch *Scratch, r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, ng *Scalar) {
+	cp := scratch.Checkpoint()
+	defer scratch.Rollback(cp)
+
+	total := len(points)
+	if ng != nil {
+		total++
+	}
+
+	r.setInfinity()
+	if total == 0 {
+		return
+	}
+
+	bucketWindow := pippengerBucketWindow(total)
+	w := bucketWindow + 1
+	nWnaf := wnafSizeBits(pippengerWnafBits, w)
+
+	// Recode every usable scalar up front; inputs that contribute nothing
+	// are dropped so the main loop only touches live entries.
+	ints := scratch.ints.alloc(total * (nWnaf + 1))
+	wnafs, skews := ints[:total*nWnaf], ints[total*nWnaf:]
+	live := scratch.ints.alloc(total)[:0]
+	for i := 0; i < total; i++ {
+		pt, s := ecmultMultiInput(points, scalars, ng, i)
+		if pt.infinity || s.isZero() {
+			continue
+		}
+		k := len(live)
+		skews[k] = s.wnafFixed(wnafs[k*nWnaf:(k+1)*nWnaf], pippengerWnafBits, w)
+		live = append(live, i)
+	}
+	if len(live) == 0 {
+		return
+	}
+
+	buckets := scratch.jacobian.alloc(1 << uint(bucketWindow))
+	var tmp GroupElementAffine
+	var runningSum GroupElementJacobian
+
+	for i := nWnaf - 1; i >= 0; i-- {
+		for j := range buckets {
+			buckets[j].setInfinity()
+		}
+
+		for k, idx := range live {
+			pt, _ := ecmultMultiInput(points, scalars, ng, idx)
+			n := wnafs[k*nWnaf+i]
+			if i == 0 && skews[k] != 0 {
+				// The wnaf represents scalar+1, so take the point off once
+				tmp.negate(pt)
+				buckets[0].addGE(&buckets[0], &tmp)
+			}
+			if n > 0 {
+				b := (n - 1) / 2
+				buckets[b].addGE(&buckets[b], pt)
+			} else if n < 0 {
+				b := -(n + 1) / 2
+				tmp.negate(pt)
+				buckets[b].addGE(&buckets[b], &tmp)
+			}
+		}
+
+		for j := 0; j < bucketWindow; j++ {
+			r.double(r)
+		}
+
+		// Add sum((2j+1) * buckets[j]) to r using running sums: walking the
+		// buckets from the top down adds each one to r as many times as its
+		// index, and the final doubling plus runningSum supplies the rest.
+		// That doubling also completes the shift of r by w bits.
+		runningSum.setInfinity()
+		for j := len(buckets) - 1; j > 0; j-- {
+			runningSum.addVar(&runningSum, &buckets[j])
+			r.addVar(r, &runningSum)
+		}
+		runningSum.addVar(&runningSum, &buckets[0])
+		r.double(r)
+		r.addVar(r, &runningSum)
+	}
+}
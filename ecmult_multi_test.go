@@ -0,0 +1,241 @@
+package p256k1
+
+import (
+	"crypto/rand"
+	"fmt"
+	"testing"
+)
+
+// ecmultMultiNaive computes ng*G + sum(scalars[i] * points[i]) one term at a time
+func ecmultMultiNaive(r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, ng *Scalar) {
+	r.setInfinity()
+	if ng != nil {
+		var term GroupElementJacobian
+		EcmultGen(&term, ng)
+		r.addVar(r, &term)
+	}
+	for i := range points {
+		var term GroupElementJacobian
+		ecmultWindowedVar(&term, &points[i], &scalars[i])
+		r.addVar(r, &term)
+	}
+}
+
+func randomScalar(t testing.TB) Scalar {
+	var buf [32]byte
+	var s Scalar
+	if _, err := rand.Read(buf[:]); err != nil {
+		t.Fatal(err)
+	}
+	s.setB32(buf[:])
+	return s
+}
+
+func randomPoint(t testing.TB) GroupElementAffine {
+	var pj GroupElementJacobian
+	var p GroupElementAffine
+	s := randomScalar(t)
+	EcmultGen(&pj, &s)
+	p.setGEJ(&pj)
+	return p
+}
+
+func jacobianEqual(a, b *GroupElementJacobian) bool {
+	if a.isInfinity() || b.isInfinity() {
+		return a.isInfinity() == b.isInfinity()
+	}
+	var aa, ba GroupElementAffine
+	aa.setGEJ(a)
+	ba.setGEJ(b)
+	aa.x.normalize()
+	aa.y.normalize()
+	ba.x.normalize()
+	ba.y.normalize()
+	return aa.x.equal(&ba.x) && aa.y.equal(&ba.y)
+}
+
+func TestWnafFixed(t *testing.T) {
+	for iter := 0; iter < 64; iter++ {
+		s := randomScalar(t)
+		if iter == 0 {
+			s.setInt(0)
+		} else if iter == 1 {
+			s.setInt(2)
+		}
+		for w := 2; w <= pippengerMaxBucketWindow+1; w++ {
+			n := wnafSizeBits(pippengerWnafBits, w)
+			wnaf := make([]int, n)
+			skew := s.wnafFixed(wnaf, pippengerWnafBits, w)
+
+			// Reconstruct sum(wnaf[i] * 2^(w*i)) - skew and compare
+			var acc, shift, digit Scalar
+			shift.setInt(1)
+			for i := 0; i < w; i++ {
+				shift.add(&shift, &shift)
+			}
+			for i := n - 1; i >= 0; i-- {
+				acc.mul(&acc, &shift)
+				d := wnaf[i]
+				if d != 0 && d&1 == 0 {
+					t.Fatalf("w=%d: even digit %d at %d", w, d, i)
+				}
+				if d <= -(1<<uint(w)) || d >= 1<<uint(w) {
+					t.Fatalf("w=%d: digit %d out of range at %d", w, d, i)
+				}
+				if d >= 0 {
+					digit.setInt(uint(d))
+				} else {
+					digit.setInt(uint(-d))
+					digit.negate(&digit)
+				}
+				acc.add(&acc, &digit)
+			}
+			if skew != 0 {
+				digit.setInt(1)
+				digit.negate(&digit)
+				acc.add(&acc, &digit)
+			}
+			if !acc.equal(&s) {
+				t.Fatalf("w=%d: wnaf does not reconstruct scalar", w)
+			}
+		}
+	}
+}
+
+// ecmultMultiImpls lists the multi-scalar engines checked against the naive sum
+var ecmultMultiImpls = []struct {
+	name string
+	fn   func(r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, ng *Scalar)
+}{
+	{"strauss", func(r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, ng *Scalar) {
+		ecmultStraussVar(new(Scratch), r, points, scalars, ng)
+	}},
+	{"pippenger", func(r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, ng *Scalar) {
+		ecmultPippengerVar(new(Scratch), r, points, scalars, ng)
+	}},
+	{"auto", func(r *GroupElementJacobian, points []GroupElementAffine, scalars []Scalar, ng *Scalar) {
+		ecmultMultiVar(new(Scratch), r, points, scalars, ng)
+	}},
+}
+
+func makeEcmultMultiInput(t testing.TB, n int) ([]GroupElementAffine, []Scalar) {
+	points := make([]GroupElementAffine, n)
+	scalars := make([]Scalar, n)
+	for i := 0; i < n; i++ {
+		points[i] = randomPoint(t)
+		scalars[i] = randomScalar(t)
+	}
+	return points, scalars
+}
+
+func TestEcmultMultiVar(t *testing.T) {
+	for _, n := range []int{0, 1, 2, 3, 5, 17, 40, 90} {
+		points, scalars := makeEcmultMultiInput(t, n)
+		if n > 2 {
+			// Exercise the skipped entries
+			scalars[1].setInt(0)
+			points[2].setInfinity()
+		}
+		ng := randomScalar(t)
+
+		for _, impl := range ecmultMultiImpls {
+			for _, g := range []*Scalar{nil, &ng} {
+				var got, want GroupElementJacobian
+				impl.fn(&got, points, scalars, g)
+				ecmultMultiNaive(&want, points, scalars, g)
+				if !jacobianEqual(&got, &want) {
+					t.Errorf("%s n=%d ng=%v: result does not match naive sum", impl.name, n, g != nil)
+				}
+			}
+		}
+	}
+}
+
+func TestEcmultMultiVarCancel(t *testing.T) {
+	// a*P + (-a)*P and a*G + (-a)*G must be infinity
+	p := randomPoint(t)
+	a := randomScalar(t)
+	var na Scalar
+	na.negate(&a)
+
+	for _, impl := range ecmultMultiImpls {
+		var r GroupElementJacobian
+		impl.fn(&r, []GroupElementAffine{p, p}, []Scalar{a, na}, nil)
+		if !r.isInfinity() {
+			t.Errorf("%s: a*P + (-a)*P should be infinity", impl.name)
+		}
+		impl.fn(&r, []GroupElementAffine{Generator}, []Scalar{a}, &na)
+		if !r.isInfinity() {
+			t.Errorf("%s: a*G + (-a)*G should be infinity", impl.name)
+		}
+	}
+}
+
+func TestScalarWNAF(t *testing.T) {
+	for iter := 0; iter < 64; iter++ {
+		s := randomScalar(t)
+		if iter == 0 {
+			s.setInt(1)
+		} else if iter == 1 {
+			s.setInt(1)
+			s.negate(&s)
+		}
+		for w := uint(2); w <= 8; w++ {
+			var wnaf [256]int
+			bits := s.wNAF(wnaf[:], w)
+
+			// Reconstruct sum(wnaf[i] * 2^i) and compare
+			var acc, digit Scalar
+			for i := 255; i >= 0; i-- {
+				acc.add(&acc, &acc)
+				d := wnaf[i]
+				if d != 0 && (i >= bits || d&1 == 0 || d >= 1<<(w-1) || d <= -(1<<(w-1))) {
+					t.Fatalf("w=%d: invalid digit %d at %d", w, d, i)
+				}
+				if d >= 0 {
+					digit.setInt(uint(d))
+				} else {
+					digit.setInt(uint(-d))
+					digit.negate(&digit)
+				}
+				acc.add(&acc, &digit)
+			}
+			if !acc.equal(&s) {
+				t.Fatalf("w=%d: wnaf does not reconstruct scalar", w)
+			}
+		}
+	}
+}
+
+func TestEcmultMulti(t *testing.T) {
+	points, scalars := makeEcmultMultiInput(t, 4)
+	ng := randomScalar(t)
+
+	var got, want GroupElementJacobian
+	if err := EcmultMulti(&got, points, scalars, &ng); err != nil {
+		t.Fatal(err)
+	}
+	ecmultMultiNaive(&want, points, scalars, &ng)
+	if !jacobianEqual(&got, &want) {
+		t.Error("EcmultMulti result does not match naive sum")
+	}
+
+	if err := EcmultMulti(&got, points, scalars[:3], nil); err == nil {
+		t.Error("EcmultMulti should reject mismatched lengths")
+	}
+}
+
+func BenchmarkEcmultMulti(b *testing.B) {
+	for n := 2; n <= 4096; n *= 2 {
+		points, scalars := makeEcmultMultiInput(b, n)
+		for _, impl := range ecmultMultiImpls {
+			b.Run(fmt.Sprintf("%s/n=%d", impl.name, n), func(b *testing.B) {
+				var r GroupElementJacobian
+				b.ResetTimer()
+				for i := 0; i < b.N; i++ {
+					impl.fn(&r, points, scalars, nil)
+				}
+			})
+		}
+	}
+}
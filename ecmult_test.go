@@ -0,0 +1,123 @@
+package p256k1
+
+import (
+	"fmt"
+	"testing"
+)
+
+func TestEcmultDouble(t *testing.T) {
+	var zero Scalar
+	for i := 0; i < 32; i++ {
+		p := randomPoint(t)
+		na := randomScalar(t)
+		ng := randomScalar(t)
+		switch i {
+		case 0:
+			na.setInt(0)
+		case 1:
+			ng.setInt(0)
+		case 2:
+			na.setInt(1)
+			ng.setInt(1)
+		}
+
+		var pj, got, want, ngG GroupElementJacobian
+		pj.setGE(&p)
+		ecmultStrauss(&got, &pj, &na, &ng)
+
+		ecmultWindowedVar(&want, &p, &na)
+		EcmultGen(&ngG, &ng)
+		want.addVar(&want, &ngG)
+		if !jacobianEqual(&got, &want) {
+			t.Fatalf("iteration %d: ecmult does not match separate multiplications", i)
+		}
+	}
+
+	// na*P with a non-trivial z coordinate and no G term
+	p := randomPoint(t)
+	na := randomScalar(t)
+	var pj, got, want GroupElementJacobian
+	pj.setGE(&p)
+	pj.double(&pj)
+	ecmultStrauss(&got, &pj, &na, &zero)
+	p.setGEJVar(&pj)
+	ecmultWindowedVar(&want, &p, &na)
+	if !jacobianEqual(&got, &want) {
+		t.Error("ecmult with Jacobian input does not match ecmultWindowedVar")
+	}
+}
+
+func TestEcmultTables(t *testing.T) {
+	preG, preG128 := getEcmultTables()
+	if len(preG) != ecmultTableSize(windowG) || len(preG128) != len(preG) {
+		t.Fatal("unexpected table size")
+	}
+	for _, i := range []int{0, 1, 2, len(preG) - 1} {
+		var k Scalar
+		var want GroupElementJacobian
+		var got GroupElementJacobian
+		var ge GroupElementAffine
+
+		k.setInt(uint(2*i + 1))
+		EcmultGen(&want, &k)
+		ge.fromLimbStorage(&preG[i])
+		got.setGE(&ge)
+		if !jacobianEqual(&got, &want) {
+			t.Errorf("preG[%d] is not %d*G", i, 2*i+1)
+		}
+	}
+}
+
+func BenchmarkEcmultDouble(b *testing.B) {
+	p := randomPoint(b)
+	na := randomScalar(b)
+	ng := randomScalar(b)
+	var pj, r GroupElementJacobian
+	pj.setGE(&p)
+	getEcmultTables()
+
+	b.Run("strauss", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			ecmultStrauss(&r, &pj, &na, &ng)
+		}
+	})
+	b.Run("separate", func(b *testing.B) {
+		var ngG GroupElementJacobian
+		for i := 0; i < b.N; i++ {
+			Ecmult(&r, &pj, &na)
+			EcmultGen(&ngG, &ng)
+			r.addVar(&r, &ngG)
+		}
+	})
+}
+
+func BenchmarkEcmultWindow(b *testing.B) {
+	p := randomPoint(b)
+	na := randomScalar(b)
+	ng := randomScalar(b)
+	points := []GroupElementJacobian{{}}
+	points[0].setGE(&p)
+	scalars := []Scalar{na}
+	getEcmultTables()
+
+	for w := uint(4); w <= 8; w++ {
+		n := ecmultTableSize(int(w))
+		state := straussState{
+			w:    w,
+			aux:  make([]FieldElement, n),
+			preA: make([]GroupElementAffine, n),
+			ps:   make([]straussPointState, 1),
+		}
+		var r GroupElementJacobian
+		b.Run(fmt.Sprintf("w=%d", w), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				ecmultStraussWnaf(&state, &r, points, scalars, nil)
+			}
+		})
+		b.Run(fmt.Sprintf("w=%d/with_G", w), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				ecmultStraussWnaf(&state, &r, points, scalars, &ng)
+			}
+		})
+	}
+}
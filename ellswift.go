@@ -0,0 +1,402 @@
+package p256k1
+
+import (
+	"crypto/sha256"
+	"errors"
+	"sync"
+	"unsafe"
+)
+
+// ElligatorSwift encoding of public keys, ported from
+// src/modules/ellswift/main_impl.h. A 64 byte encoding (u, t) is two field
+// elements, and every 64 byte string decodes to a point, so that encodings
+// of random keys are indistinguishable from uniform random bytes, as BIP324
+// transports require. Decoding evaluates
+//
+//	x3 = (3*s*u^3 - (g+s)^2) / (3*s*u^2)
+//	x2 = u*(c1*s + c2*g) / (g+s)
+//	x1 = -u*(c2*s + c1*g) / (g+s)
+//
+// with s = t^2 and g = u^3 + 7, and takes the first of x3, x2, x1 that is on
+// the curve, with the parity of y taken from t. The x coordinate comes out as
+// a fraction, which EllSwiftXDH multiplies without ever inverting it or
+// taking a square root.
+
+var (
+	// ellswiftC1 is (sqrt(-3) - 1) / 2
+	ellswiftC1 = FieldElement{
+		n:          [5]uint64{0x693D68E6AFA40, 0x8AED0A766A3EC, 0x3CBCB16630FB6, 0xF8EF919BB8615, 0x851695D49A83},
+		magnitude:  1,
+		normalized: true,
+	}
+
+	// ellswiftC2 is (-sqrt(-3) - 1) / 2 = -(c1 + 1)
+	ellswiftC2 = FieldElement{
+		n:          [5]uint64{0x96C28719501EE, 0x7512F58995C13, 0xC3434E99CF049, 0x7106E64479EA, 0x7AE96A2B657C},
+		magnitude:  1,
+		normalized: true,
+	}
+
+	// ellswiftC3 is (-sqrt(-3) + 1) / 2 = -c1 = c2 + 1
+	ellswiftC3 = FieldElement{
+		n:          [5]uint64{0x96C28719501EF, 0x7512F58995C13, 0xC3434E99CF049, 0x7106E64479EA, 0x7AE96A2B657C},
+		magnitude:  1,
+		normalized: true,
+	}
+
+	// ellswiftC4 is (sqrt(-3) + 1) / 2 = -c2 = c1 + 1
+	ellswiftC4 = FieldElement{
+		n:          [5]uint64{0x693D68E6AFA41, 0x8AED0A766A3EC, 0x3CBCB16630FB6, 0xF8EF919BB8615, 0x851695D49A83},
+		magnitude:  1,
+		normalized: true,
+	}
+)
+
+// SHA256 midstates after absorbing SHA256(tag) || SHA256(tag) for the
+// ElligatorSwift tags
+var (
+	ellswiftEncodeMidstate []byte
+	ellswiftCreateMidstate []byte
+	ellswiftBIP324Midstate []byte
+	ellswiftMidstateOnce   sync.Once
+)
+
+func initEllswiftMidstates() {
+	for _, m := range []struct {
+		out *[]byte
+		tag string
+	}{
+		{&ellswiftEncodeMidstate, "secp256k1_ellswift_encode"},
+		{&ellswiftCreateMidstate, "secp256k1_ellswift_create"},
+		{&ellswiftBIP324Midstate, "bip324_ellswift_xonly_ecdh"},
+	} {
+		tagHash := sha256.Sum256([]byte(m.tag))
+		*m.out = taggedHashMidstate(&tagHash)
+	}
+}
+
+// ellswiftXSwiftECFrac sets xn/xd to the x coordinate that the encoding
+// (u, t) decodes to, as secp256k1_ellswift_xswiftec_frac_var
+func ellswiftXSwiftECFrac(xn, xd *FieldElement, u, t *FieldElement) {
+	var u1, s, g, p, d, n, l, seven FieldElement
+	u1 = *u
+	if u1.normalizesToZeroVar() {
+		u1.setInt(1)
+	}
+	s.sqr(t)
+	if t.normalizesToZeroVar() {
+		s.setInt(1)
+	}
+	seven.setInt(7)
+	l.sqr(&u1)     // l = u^2
+	g.mul(&l, &u1) // g = u^3
+	g.add(&seven)  // g = u^3 + 7
+	p = g
+	p.add(&s) // p = g + s
+	if p.normalizesToZeroVar() {
+		s.mulInt(4)
+		p = g
+		p.add(&s)
+	}
+	d.mul(&s, &l)
+	d.mulInt(3) // d = 3*s*u^2
+	l.sqr(&p)
+	l.negate(&l, 1) // l = -(g+s)^2
+	n.mul(&d, &u1)
+	n.add(&l) // n = 3*s*u^3 - (g+s)^2
+	if xFracOnCurveVar(&n, &d) {
+		*xn, *xd = n, d
+		return
+	}
+
+	*xd = p
+	l.mul(&ellswiftC1, &s)
+	n.mul(&ellswiftC2, &g)
+	n.add(&l)
+	n.mul(&n, &u1) // n = u*(c1*s + c2*g)
+	if xFracOnCurveVar(&n, &p) {
+		*xn = n
+		return
+	}
+
+	l.mul(&p, &u1)
+	n.add(&l)
+	xn.negate(&n, 2) // xn = -u*(c1*s + c2*g) - u*(g+s)
+}
+
+// ellswiftSwiftEC sets r to the point that the encoding (u, t) decodes to,
+// where t is normalized
+func ellswiftSwiftEC(r *GroupElementAffine, u, t *FieldElement) {
+	var xn, xd, x FieldElement
+	ellswiftXSwiftECFrac(&xn, &xd, u, t)
+	xd.invVar(&xd)
+	x.mul(&xn, &xd)
+	x.normalize()
+	r.setXOVar(&x, t.isOdd())
+}
+
+// ellswiftXSwiftECInv sets t to a value such that (u, t) decodes to x, for
+// nonzero u and x on the curve, as secp256k1_ellswift_xswiftec_inv_var. Each
+// of the branches c in [0, 8) gives a different t or fails; together they
+// reach every such t apart from t = 0 and t^2 = -(u^3 + 7). Branches 0, 1, 4
+// and 5 invert the x1 and x2 formulas, and 2, 3, 6 and 7 the x3 formula.
+func ellswiftXSwiftECInv(t *FieldElement, xIn, uIn *FieldElement, c int) bool {
+	x, u := *xIn, *uIn
+	var g, v, s, m, r, q FieldElement
+	x.normalizeWeak()
+	u.normalizeWeak()
+
+	if c&2 == 0 {
+		// If -u-x is on the curve the encoding would decode under x3
+		// instead, which takes priority over x1 and x2
+		m = x
+		m.add(&u)
+		m.negate(&m, 2) // m = -u-x
+		if xOnCurveVar(&m) {
+			return false
+		}
+
+		// s = -(u^3 + 7) / (u^2 + u*x + x^2), which cannot have a zero
+		// denominator given the test above
+		s.sqr(&m)
+		s.negate(&s, 1)
+		m.mul(&u, &x)
+		s.add(&m) // s = -(u^2 + u*x + x^2)
+
+		// s is a square when -(u^3 + 7)*(u^2 + u*x + x^2) is
+		var seven FieldElement
+		seven.setInt(7)
+		g.sqr(&u)
+		g.mul(&g, &u)
+		g.add(&seven) // g = u^3 + 7
+		m.mul(&s, &g)
+		if !m.isSquareVar() {
+			return false
+		}
+		s.invVar(&s)
+		s.mul(&s, &g)
+
+		v = x
+	} else {
+		// s = x - u must be a square
+		m.negate(&u, 1) // m = -u
+		s = m
+		s.add(&x)
+		if !s.isSquareVar() {
+			return false
+		}
+
+		// r = sqrt(-s*(4*(u^3 + 7) + 3*u^2*s))
+		var b4 FieldElement
+		b4.setInt(4 * 7)
+		g.sqr(&u)
+		q.mul(&s, &g)
+		q.mulInt(3) // q = 3*s*u^2
+		g.mul(&g, &u)
+		g.mulInt(4)
+		g.add(&b4) // g = 4*(u^3 + 7)
+		q.add(&g)
+		q.mul(&q, &s)
+		q.negate(&q, 1)
+		if !r.sqrt(&q) {
+			return false
+		}
+		if c&1 != 0 && r.normalizesToZeroVar() {
+			return false
+		}
+		if s.normalizesToZeroVar() {
+			return false
+		}
+
+		// v = (r/s - u) / 2
+		v.invVar(&s)
+		v.mul(&v, &r)
+		v.add(&m)
+		v.half(&v)
+	}
+
+	// w = sqrt(s), which exists on both branches
+	m.sqrt(&s)
+	if c&5 == 0 || c&5 == 5 {
+		m.negate(&m, 1)
+	}
+	// t = (+-)w * ({c3, c4}*u + v)
+	if c&1 != 0 {
+		u.mul(&u, &ellswiftC4)
+	} else {
+		u.mul(&u, &ellswiftC3)
+	}
+	u.add(&v)
+	t.mul(&m, &u)
+	return true
+}
+
+// ellswiftPRNG draws SHA256 outputs from h, positioned after a state saved
+// with a whole number of blocks, followed by tail (up to 32 bytes) and a
+// little endian counter, as secp256k1_ellswift_prng. Each draw costs one
+// compression.
+type ellswiftPRNG struct {
+	h    *taggedHasher
+	ms   [sha256MidstateLen]byte
+	tail [36]byte
+	n    int
+}
+
+// init saves the state of h, which must have no staged input, and the tail
+// written before each counter
+func (g *ellswiftPRNG) init(h *taggedHasher, tail []byte) {
+	g.h = h
+	h.save(&g.ms)
+	g.n = copy(g.tail[:32], tail)
+}
+
+// draw writes the output for counter cnt into out32
+func (g *ellswiftPRNG) draw(out32 []byte, cnt uint32) {
+	g.tail[g.n] = byte(cnt)
+	g.tail[g.n+1] = byte(cnt >> 8)
+	g.tail[g.n+2] = byte(cnt >> 16)
+	g.tail[g.n+3] = byte(cnt >> 24)
+	g.h.restore(&g.ms)
+	g.h.write(g.tail[:g.n+4])
+	g.h.sum(out32)
+}
+
+// clear wipes the saved state and tail
+func (g *ellswiftPRNG) clear() {
+	memclear(unsafe.Pointer(&g.ms[0]), uintptr(len(g.ms)))
+	memclear(unsafe.Pointer(&g.tail[0]), uintptr(len(g.tail)))
+}
+
+// ellswiftEncodePoint writes an ElligatorSwift encoding of p, drawing u
+// values and branches from g until one of them inverts, as
+// secp256k1_ellswift_elligatorswift_var. About four draws are needed on
+// average.
+func ellswiftEncodePoint(ell64 []byte, p *GroupElementAffine, g *ellswiftPRNG) {
+	var branchHash [32]byte
+	var t FieldElement
+	branchesLeft := 0
+	cnt := uint32(0)
+	for {
+		// Take 3-bit branch values from a pool of 64 refilled from one draw
+		if branchesLeft == 0 {
+			g.draw(branchHash[:], cnt)
+			cnt++
+			branchesLeft = 64
+		}
+		branchesLeft--
+		branch := int(branchHash[branchesLeft>>1]>>((branchesLeft&1)<<2)) & 7
+
+		// u is reduced from the draw, which is what ends up encoded
+		var u FieldElement
+		g.draw(ell64[:32], cnt)
+		cnt++
+		u.setB32(ell64[:32])
+		if ellswiftXSwiftECInv(&t, &p.x, &u, branch) {
+			break
+		}
+	}
+	t.normalize()
+	if t.isOdd() != p.y.isOdd() {
+		t.negate(&t, 1)
+		t.normalize()
+	}
+	t.getB32(ell64[32:])
+}
+
+// EllSwiftEncode writes a 64 byte ElligatorSwift encoding of pubkey into
+// ell64, as secp256k1_ellswift_encode. rnd32 must be 32 bytes of fresh
+// randomness for the encoding to look uniformly random.
+func EllSwiftEncode(ell64 []byte, pubkey *PublicKey, rnd32 []byte) error {
+	if len(ell64) != 64 {
+		return errors.New("output must be 64 bytes")
+	}
+	if len(rnd32) != 32 {
+		return errors.New("randomness must be 32 bytes")
+	}
+	if pubkey == nil {
+		return errors.New("pubkey cannot be nil")
+	}
+	var p GroupElementAffine
+	pubkeyLoad(&p, pubkey)
+	if p.isInfinity() {
+		for i := range ell64 {
+			ell64[i] = 0
+		}
+		return errors.New("invalid public key")
+	}
+	p.x.normalize()
+	p.y.normalize()
+
+	// The draws are H(compressed pubkey || 31 zero bytes || rnd32 || cnt)
+	// under the tag "secp256k1_ellswift_encode"
+	ellswiftMidstateOnce.Do(initEllswiftMidstates)
+	var p64 [64]byte
+	p64[0] = 2
+	if p.y.isOdd() {
+		p64[0] = 3
+	}
+	p.x.getB32(p64[1:33])
+	h := getTaggedHasher(ellswiftEncodeMidstate)
+	h.write(p64[:])
+	var g ellswiftPRNG
+	g.init(h, rnd32)
+	ellswiftEncodePoint(ell64, &p, &g)
+	h.clearState()
+	taggedHasherPool.Put(h)
+	return nil
+}
+
+// EllSwiftCreate writes the 64 byte ElligatorSwift encoding of the public
+// key of seckey into ell64, as secp256k1_ellswift_create. The encoding is
+// derived from seckey and, if not nil, the 32 bytes of auxrnd32.
+func EllSwiftCreate(ell64 []byte, seckey []byte, auxrnd32 []byte) error {
+	if len(ell64) != 64 {
+		return errors.New("output must be 64 bytes")
+	}
+	if auxrnd32 != nil && len(auxrnd32) != 32 {
+		return errors.New("auxiliary randomness must be 32 bytes")
+	}
+	var pubkey PublicKey
+	if err := ECPubkeyCreate(&pubkey, seckey); err != nil {
+		for i := range ell64 {
+			ell64[i] = 0
+		}
+		return err
+	}
+	var p GroupElementAffine
+	pubkeyLoad(&p, &pubkey)
+	p.x.normalize()
+	p.y.normalize()
+
+	// The draws are H(seckey || 32 zero bytes [|| auxrnd32] || cnt) under
+	// the tag "secp256k1_ellswift_create"
+	ellswiftMidstateOnce.Do(initEllswiftMidstates)
+	var zero32 [32]byte
+	h := getTaggedHasher(ellswiftCreateMidstate)
+	h.write(seckey)
+	h.write(zero32[:])
+	var g ellswiftPRNG
+	g.init(h, auxrnd32)
+	ellswiftEncodePoint(ell64, &p, &g)
+	g.clear()
+	h.clearState()
+	taggedHasherPool.Put(h)
+	return nil
+}
+
+// EllSwiftDecode sets pubkey to the public key that the 64 byte encoding
+// ell64 decodes to, as secp256k1_ellswift_decode. Every 64 byte string
+// decodes to a valid key.
+func EllSwiftDecode(pubkey *PublicKey, ell64 []byte) error {
+	if len(ell64) != 64 {
+		return errors.New("encoding must be 64 bytes")
+	}
+	var u, t FieldElement
+	u.setB32(ell64[:32])
+	t.setB32(ell64[32:])
+	t.normalize()
+	var p GroupElementAffine
+	ellswiftSwiftEC(&p, &u, &t)
+	pubkeySave(pubkey, &p)
+	return nil
+}
@@ -0,0 +1,511 @@
+package p256k1
+
+import (
+	"bytes"
+	"crypto/rand"
+	"encoding/hex"
+	"testing"
+)
+
+func mustHex(tb testing.TB, s string) []byte {
+	b, err := hex.DecodeString(s)
+	if err != nil {
+		tb.Fatal(err)
+	}
+	return b
+}
+
+// ellswiftDecodeVectors is a subset of ellswift_decode_test_vectors.csv from
+// BIP-324: an encoding and the x coordinate it decodes to
+var ellswiftDecodeVectors = []struct{ ell, x string }{
+	{"00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+		"edd1fd3e327ce90cc7a3542614289aee9682003e9cf7dcc9cf2ca9743be5aa0c"},
+	{"000000000000000000000000000000000000000000000000000000000000000001d3475bf7655b0fb2d852921035b2ef607f49069b97454e6795251062741771",
+		"b5da00b73cd6560520e7c364086e7cd23a34bf60d0e707be9fc34d4cd5fdfa2c"},
+	{"000000000000000000000000000000000000000000000000000000000000000082277c4a71f9d22e66ece523f8fa08741a7c0912c66a69ce68514bfd3515b49f",
+		"f482f2e241753ad0fb89150d8491dc1e34ff0b8acfbb442cfe999e2e5e6fd1d2"},
+	{"00000000000000000000000000000000000000000000000000000000000000008421cc930e77c9f514b6915c3dbe2a94c6d8f690b5b739864ba6789fb8a55dd0",
+		"9f59c40275f5085a006f05dae77eb98c6fd0db1ab4a72ac47eae90a4fc9e57e0"},
+	{"0000000000000000000000000000000000000000000000000000000000000000bde70df51939b94c9c24979fa7dd04ebd9b3572da7802290438af2a681895441",
+		"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa9fffffd6b"},
+	{"0000000000000000000000000000000000000000000000000000000000000000d19c182d2759cd99824228d94799f8c6557c38a1c0d6779b9d4b729c6f1ccc42",
+		"70720db7e238d04121f5b1afd8cc5ad9d18944c6bdc94881f502b7a3af3aecff"},
+	{"0000000000000000000000000000000000000000000000000000000000000000fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f",
+		"edd1fd3e327ce90cc7a3542614289aee9682003e9cf7dcc9cf2ca9743be5aa0c"},
+	{"0000000000000000000000000000000000000000000000000000000000000000ffffffffffffffffffffffffffffffffffffffffffffffffffffffff2664bbd5",
+		"50873db31badcc71890e4f67753a65757f97aaa7dd5f1e82b753ace32219064b"},
+	{"0000000000000000000000000000000000000000000000000000000000000000ffffffffffffffffffffffffffffffffffffffffffffffffffffffffcbcfb7e7",
+		"12303941aedc208880735b1f1795c8e55be520ea93e103357b5d2adb7ed59b8e"},
+	{"0a2d2ba93507f1df233770c2a797962cc61f6d15da14ecd47d8d27ae1cd5f8530000000000000000000000000000000000000000000000000000000000000000",
+		"532167c11200b08c0e84a354e74dcc40f8b25f4fe686e30869526366278a0688"},
+	{"0a2d2ba93507f1df233770c2a797962cc61f6d15da14ecd47d8d27ae1cd5f853fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f",
+		"532167c11200b08c0e84a354e74dcc40f8b25f4fe686e30869526366278a0688"},
+	{"0ffde9ca81d751e9cdaffc1a50779245320b28996dbaf32f822f20117c22fbd6c74d99efceaa550f1ad1c0f43f46e7ff1ee3bd0162b7bf55f2965da9c3450646",
+		"74e880b3ffd18fe3cddf7902522551ddf97fa4a35a3cfda8197f947081a57b8f"},
+	{"0ffde9ca81d751e9cdaffc1a50779245320b28996dbaf32f822f20117c22fbd6ffffffffffffffffffffffffffffffffffffffffffffffffffffffff156ca896",
+		"377b643fce2271f64e5c8101566107c1be4980745091783804f654781ac9217c"},
+	{"123658444f32be8f02ea2034afa7ef4bbe8adc918ceb49b12773b625f490b368ffffffffffffffffffffffffffffffffffffffffffffffffffffffff8dc5fe11",
+		"ed16d65cf3a9538fcb2c139f1ecbc143ee14827120cbc2659e667256800b8142"},
+	{"146f92464d15d36e35382bd3ca5b0f976c95cb08acdcf2d5b3570617990839d7ffffffffffffffffffffffffffffffffffffffffffffffffffffffff3145e93b",
+		"0d5cd840427f941f65193079ab8e2e83024ef2ee7ca558d88879ffd879fb6657"},
+	{"15fdf5cf09c90759add2272d574d2bb5fe1429f9f3c14c65e3194bf61b82aa73ffffffffffffffffffffffffffffffffffffffffffffffffffffffff04cfd906",
+		"16d0e43946aec93f62d57eb8cde68951af136cf4b307938dd1447411e07bffe1"},
+	{"1f67edf779a8a649d6def60035f2fa22d022dd359079a1a144073d84f19b92d50000000000000000000000000000000000000000000000000000000000000000",
+		"025661f9aba9d15c3118456bbe980e3e1b8ba2e047c737a4eb48a040bb566f6c"},
+	{"1f67edf779a8a649d6def60035f2fa22d022dd359079a1a144073d84f19b92d5fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f",
+		"025661f9aba9d15c3118456bbe980e3e1b8ba2e047c737a4eb48a040bb566f6c"},
+	{"1fe1e5ef3fceb5c135ab7741333ce5a6e80d68167653f6b2b24bcbcfaaaff507fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f",
+		"98bec3b2a351fa96cfd191c1778351931b9e9ba9ad1149f6d9eadca80981b801"},
+	{"4056a34a210eec7892e8820675c860099f857b26aad85470ee6d3cf1304a9dcf375e70374271f20b13c9986ed7d3c17799698cfc435dbed3a9f34b38c823c2b4",
+		"868aac2003b29dbcad1a3e803855e078a89d16543ac64392d122417298cec76e"},
+	{"7bf96b7b6da15d3476a2b195934b690a3a3de3e8ab8474856863b0de3af90b0e0000000000000000000000000000000000000000000000000000000000000000",
+		"50851dfc9f418c314a437295b24feeea27af3d0cd2308348fda6e21c463e46ff"},
+	{"7bf96b7b6da15d3476a2b195934b690a3a3de3e8ab8474856863b0de3af90b0efffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f",
+		"50851dfc9f418c314a437295b24feeea27af3d0cd2308348fda6e21c463e46ff"},
+	{"943c2f775108b737fe65a9531e19f2fc2a197f5603e3a2881d1d83e4008f91250000000000000000000000000000000000000000000000000000000000000000",
+		"311c61f0ab2f32b7b1f0223fa72f0a78752b8146e46107f8876dd9c4f92b2942"},
+	{"943c2f775108b737fe65a9531e19f2fc2a197f5603e3a2881d1d83e4008f9125fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f",
+		"311c61f0ab2f32b7b1f0223fa72f0a78752b8146e46107f8876dd9c4f92b2942"},
+}
+
+// ellswiftInvVectors is a subset of xswiftec_inv_test_vectors.csv from
+// BIP-324: u, x and the t returned by each of the 8 cases, empty where the
+// case fails
+var ellswiftInvVectors = []struct {
+	u, x string
+	t    [8]string
+}{
+	{"05ff6bdad900fc3261bc7fe34e2fb0f569f06e091ae437d3a52e9da0cbfb9590", "80cdf63774ec7022c89a5a8558e373a279170285e0ab27412dbce510bdfe23fc", [8]string{
+		"",
+		"",
+		"45654798ece071ba79286d04f7f3eb1c3f1d17dd883610f2ad2efd82a287466b",
+		"0aeaa886f6b76c7158452418cbf5033adc5747e9e9b5d3b2303db96936528557",
+		"",
+		"",
+		"ba9ab867131f8e4586d792fb080c14e3c0e2e82277c9ef0d52d1027c5d78b5c4",
+		"f51557790948938ea7badbe7340afcc523a8b816164a2c4dcfc24695c9ad76d8",
+	}},
+	{"1737a85f4c8d146cec96e3ffdca76d9903dcf3bd53061868d478c78c63c2aa9e", "39e48dd150d2f429be088dfd5b61882e7e8407483702ae9a5ab35927b15f85ea", [8]string{
+		"1be8cc0b04be0c681d0c6a68f733f82c6c896e0c8a262fcd392918e303a7abf4",
+		"605b5814bf9b8cb066667c9e5480d22dc5b6c92f14b4af3ee0a9eb83b03685e3",
+		"",
+		"",
+		"e41733f4fb41f397e2f3959708cc07d3937691f375d9d032c6d6e71bfc58503b",
+		"9fa4a7eb4064734f99998361ab7f2dd23a4936d0eb4b50c11f56147b4fc9764c",
+		"",
+		"",
+	}},
+	{"1aaa1ccebf9c724191033df366b36f691c4d902c228033ff4516d122b2564f68", "c75541259d3ba98f207eaa30c69634d187d0b6da594e719e420f4898638fc5b0", [8]string{
+		"",
+		"",
+		"",
+		"",
+		"",
+		"",
+		"",
+		"",
+	}},
+	{"2323a1d079b0fd72fc8bb62ec34230a815cb0596c2bfac998bd6b84260f5dc26", "239342dfb675500a34a196310b8d87d54f49dcac9da50c1743ceab41a7b249ff", [8]string{
+		"f63580b8aa49c4846de56e39e1b3e73f171e881eba8c66f614e67e5c975dfc07",
+		"b6307b332e699f1cf77841d90af25365404deb7fed5edb3090db49e642a156b6",
+		"",
+		"",
+		"09ca7f4755b63b7b921a91c61e4c18c0e8e177e145739909eb1981a268a20028",
+		"49cf84ccd19660e30887be26f50dac9abfb2148012a124cf6f24b618bd5ea579",
+		"",
+		"",
+	}},
+	{"2dc90e640cb646ae9164c0b5a9ef0169febe34dc4437d6e46acb0e27e219d1e8", "d236f19bf349b9516e9b3f4a5610fe960141cb23bbc8291b9534f1d71de62a47", [8]string{
+		"e69df7d9c026c36600ebdf588072675847c0c431c8eb730682533e964b6252c9",
+		"4f18bbdf7c2d6c5f818c18802fa35cd069eaa79fff74e4fc837c80d93fece2f8",
+		"",
+		"",
+		"196208263fd93c99ff1420a77f8d98a7b83f3bce37148cf97dacc168b49da966",
+		"b0e7442083d293a07e73e77fd05ca32f96155860008b1b037c837f25c0131937",
+		"",
+		"",
+	}},
+	{"3edd7b3980e2f2f34d1409a207069f881fda5f96f08027ac4465b63dc278d672", "053a98de4a27b1961155822b3a3121f03b2a14458bd80eb4a560c4c7a85c149c", [8]string{
+		"",
+		"",
+		"b3dae4b7dcf858e4c6968057cef2b156465431526538199cf52dc1b2d62fda30",
+		"4aa77dd55d6b6d3cfa10cc9d0fe42f79232e4575661049ae36779c1d0c666d88",
+		"",
+		"",
+		"4c251b482307a71b39697fa8310d4ea9b9abcead9ac7e6630ad23e4c29d021ff",
+		"b558822aa29492c305ef3362f01bd086dcd1ba8a99efb651c98863e1f3998ea7",
+	}},
+	{"4295737efcb1da6fb1d96b9ca7dcd1e320024b37a736c4948b62598173069f70", "fa7ffe4f25f88362831c087afe2e8a9b0713e2cac1ddca6a383205a266f14307", [8]string{
+		"",
+		"",
+		"",
+		"",
+		"",
+		"",
+		"",
+		"",
+	}},
+	{"587c1a0cee91939e7f784d23b963004a3bf44f5d4e32a0081995ba20b0fca59e", "2ea988530715e8d10363907ff25124524d471ba2454d5ce3be3f04194dfd3a3c", [8]string{
+		"cfd5a094aa0b9b8891b76c6ab9438f66aa1c095a65f9f70135e8171292245e74",
+		"a89057d7c6563f0d6efa19ae84412b8a7b47e791a191ecdfdf2af84fd97bc339",
+		"475d0ae9ef46920df07b34117be5a0817de1023e3cc32689e9be145b406b0aef",
+		"a0759178ad80232454f827ef05ea3e72ad8d75418e6d4cc1cd4f5306c5e7c453",
+		"302a5f6b55f464776e48939546bc709955e3f6a59a0608feca17e8ec6ddb9dbb",
+		"576fa82839a9c0f29105e6517bbed47584b8186e5e6e132020d507af268438f6",
+		"b8a2f51610b96df20f84cbee841a5f7e821efdc1c33cd9761641eba3bf94f140",
+		"5f8a6e87527fdcdbab07d810fa15c18d52728abe7192b33e32b0acf83a1837dc",
+	}},
+	{"5fa88b3365a635cbbcee003cce9ef51dd1a310de277e441abccdb7be1e4ba249", "79461ff62bfcbcac4249ba84dd040f2cec3c63f725204dc7f464c16bf0ff3170", [8]string{
+		"",
+		"",
+		"6bb700e1f4d7e236e8d193ff4a76c1b3bcd4e2b25acac3d51c8dac653fe909a0",
+		"f4c73410633da7f63a4f1d55aec6dd32c4c6d89ee74075edb5515ed90da9e683",
+		"",
+		"",
+		"9448ff1e0b281dc9172e6c00b5893e4c432b1d4da5353c2ae3725399c016f28f",
+		"0b38cbef9cc25809c5b0e2aa513922cd3b39276118bf8a124aaea125f25615ac",
+	}},
+	{"6fb31c7531f03130b42b155b952779efbb46087dd9807d241a48eac63c3d96d6", "56f81be753e8d4ae4940ea6f46f6ec9fda66a6f96cc95f506cb2b57490e94260", [8]string{
+		"",
+		"",
+		"59059774795bdb7a837fbe1140a5fa59984f48af8df95d57dd6d1c05437dcec1",
+		"22a644db79376ad4e7b3a009e58b3f13137c54fdf911122cc93667c47077d784",
+		"",
+		"",
+		"a6fa688b86a424857c8041eebf5a05a667b0b7507206a2a82292e3f9bc822d6e",
+		"dd59bb2486c8952b184c5ff61a74c0ecec83ab0206eeedd336c9983a8f8824ab",
+	}},
+	{"704cd226e71cb6826a590e80dac90f2d2f5830f0fdf135a3eae3965bff25ff12", "138e0afa68936ee670bd2b8db53aedbb7bea2a8597388b24d0518edd22ad66ec", [8]string{
+		"",
+		"",
+		"",
+		"",
+		"",
+		"",
+		"",
+		"",
+	}},
+}
+
+// ellswiftXDHVectors are vectors of packet_encoding_test_vectors.csv from
+// BIP-324, reduced to the inputs and output of the x-only ECDH
+var ellswiftXDHVectors = []struct {
+	priv, ellOurs, ellTheirs string
+	initiating               bool
+	secret                   string
+}{
+	{"1f9c581b35231838f0f17cf0c979835baccb7f3abbbb96ffcc318ab71e6e126f",
+		"a1855e10e94e00baa23041d916e259f7044e491da6171269694763f018c7e63693d29575dcb464ac816baa1be353ba12e3876cba7628bd0bd8e755e721eb0140",
+		"fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f0000000000000000000000000000000000000000000000000000000000000000",
+		false, "a0138f564f74d0ad70bc337dacc9d0bf1d2349364caf1188a1e6e8ddb3b7b184"},
+	{"0286c41cd30913db0fdff7a64ebda5c8e3e7cef10f2aebc00a7650443cf4c60d",
+		"d1ee8a93a01130cbf299249a258f94feb5f469e7d0f2f28f69ee5e9aa8f9b54a60f2c3ff2d023634ec7f4127a96cc11662e402894cf1f694fb9a7eaa5f1d9244",
+		"ffffffffffffffffffffffffffffffffffffffffffffffffffffffff22d5e441524d571a52b3def126189d3f416890a99d4da6ede2b0cde1760ce2c3f98457ae",
+		true, "250b93570d411149105ab8cb0bc5079914906306368c23e9d77c2a33265b994c"},
+	{"6c77432d1fda31e9f942f8af44607e10f3ad38a65f8a4bddae823e5eff90dc38",
+		"d2685070c1e6376e633e825296634fd461fa9e5bdf2109bcebd735e5a91f3e587c5cb782abb797fbf6bb5074fd1542a474f2a45b673763ec2db7fb99b737bbb9",
+		"56bd0c06f10352c3a1a9f4b4c92f6fa2b26df124b57878353c1fc691c51abea77c8817daeeb9fa546b77c8daf79d89b22b0e1b87574ece42371f00237aa9d83a",
+		false, "1918b741ef5f9d1d7670b050c152b4a4ead2c31be9aecb0681c0cd4324150853"},
+}
+
+func TestEllSwiftVectors(t *testing.T) {
+	for _, v := range ellswiftDecodeVectors {
+		ell := mustHex(t, v.ell)
+		var pubkey PublicKey
+		if err := EllSwiftDecode(&pubkey, ell); err != nil {
+			t.Fatal(err)
+		}
+		var p GroupElementAffine
+		pubkeyLoad(&p, &pubkey)
+		var x [32]byte
+		p.x.normalize()
+		p.x.getB32(x[:])
+		if hex.EncodeToString(x[:]) != v.x {
+			t.Errorf("decode %s: x = %x, want %s", v.ell, x, v.x)
+		}
+		// The y coordinate takes the parity of t
+		p.y.normalize()
+		var tt FieldElement
+		tt.setB32(ell[32:])
+		tt.normalize()
+		if p.y.isOdd() != tt.isOdd() {
+			t.Errorf("decode %s: y parity differs from t", v.ell)
+		}
+	}
+
+	for _, v := range ellswiftInvVectors {
+		var u, x FieldElement
+		u.setB32(mustHex(t, v.u))
+		x.setB32(mustHex(t, v.x))
+		for c := 0; c < 8; c++ {
+			var tt FieldElement
+			ok := ellswiftXSwiftECInv(&tt, &x, &u, c)
+			if ok != (v.t[c] != "") {
+				t.Errorf("xswiftec_inv(%s, %s, %d) = %v, want %v", v.x, v.u, c, ok, !ok)
+				continue
+			}
+			if !ok {
+				continue
+			}
+			var got [32]byte
+			tt.normalize()
+			tt.getB32(got[:])
+			if hex.EncodeToString(got[:]) != v.t[c] {
+				t.Errorf("xswiftec_inv(%s, %s, %d) = %x, want %s", v.x, v.u, c, got, v.t[c])
+			}
+		}
+	}
+
+	for i, v := range ellswiftXDHVectors {
+		ellA, ellB := mustHex(t, v.ellOurs), mustHex(t, v.ellTheirs)
+		if !v.initiating {
+			ellA, ellB = ellB, ellA
+		}
+		out := make([]byte, 32)
+		if err := EllSwiftXDH(out, ellA, ellB, mustHex(t, v.priv), !v.initiating, nil); err != nil {
+			t.Fatal(err)
+		}
+		if hex.EncodeToString(out) != v.secret {
+			t.Errorf("xdh vector %d = %x, want %s", i, out, v.secret)
+		}
+	}
+}
+
+// TestEllSwiftEncoderOutputs pins the encodings produced for fixed keys and
+// randomness, which BIP-324 leaves to the implementation, to the outputs of
+// src/modules/ellswift
+func TestEllSwiftEncoderOutputs(t *testing.T) {
+	ka, kb, aux := make([]byte, 32), make([]byte, 32), make([]byte, 32)
+	for j := range ka {
+		ka[j], kb[j], aux[j] = byte(j+1), byte(0x80-j), byte(0x40+j)
+	}
+	ellA, ellB, enc, out := make([]byte, 64), make([]byte, 64), make([]byte, 64), make([]byte, 32)
+	if err := EllSwiftCreate(ellA, ka, aux); err != nil {
+		t.Fatal(err)
+	}
+	if err := EllSwiftCreate(ellB, kb, nil); err != nil {
+		t.Fatal(err)
+	}
+	var pubB PublicKey
+	if err := ECPubkeyCreate(&pubB, kb); err != nil {
+		t.Fatal(err)
+	}
+	if err := EllSwiftEncode(enc, &pubB, aux); err != nil {
+		t.Fatal(err)
+	}
+	if err := EllSwiftXDH(out, ellA, ellB, ka, false, nil); err != nil {
+		t.Fatal(err)
+	}
+	for _, c := range []struct{ name, got, want string }{
+		{"create", hex.EncodeToString(ellA), "f9c0f4d940de5aa0fdeff87d7193340af9b67840c83d4e7c9e981db78f91d64572ac6a5899e8bd9440aef3582c55af2852d269aa1946b9f2d51e9087636c54d6"},
+		{"create without aux", hex.EncodeToString(ellB), "3195a114283cf4b71db9c6bbdd2c29a8bedae4448b5863d786625296edd9f37bbd625f935b53cd6ad8a3f152b9af42c24b1e31f3e809a17d543bafc088c28e55"},
+		{"encode", hex.EncodeToString(enc), "7e3b849f51461b377e56fc45e0c6537368146a5dfce93454ee96dcae22bc8124f4e7f720cc5a4e51dfa8f2f1b979ba2b577b773e9de951b735e40181c8e2b011"},
+		{"xdh", hex.EncodeToString(out), "00ee5f8f38c1fdc88a8cdae900a844c8f7c24ab21a3dde3e8da2c57ff2735413"},
+	} {
+		if c.got != c.want {
+			t.Errorf("%s = %s, want %s", c.name, c.got, c.want)
+		}
+	}
+}
+
+func TestEllSwiftRoundTrip(t *testing.T) {
+	for i := 0; i < 64; i++ {
+		seckey, pubkey, err := ECKeyPairGenerate()
+		if err != nil {
+			t.Fatal(err)
+		}
+		rnd := make([]byte, 32)
+		rand.Read(rnd)
+
+		ell := make([]byte, 64)
+		if err := EllSwiftEncode(ell, pubkey, rnd); err != nil {
+			t.Fatal(err)
+		}
+		var got PublicKey
+		EllSwiftDecode(&got, ell)
+		if ECPubkeyCmp(&got, pubkey) != 0 {
+			t.Fatalf("key %d: encode does not decode back", i)
+		}
+		if err := EllSwiftCreate(ell, seckey, rnd); err != nil {
+			t.Fatal(err)
+		}
+		EllSwiftDecode(&got, ell)
+		if ECPubkeyCmp(&got, pubkey) != 0 {
+			t.Fatalf("key %d: create does not decode to the public key", i)
+		}
+	}
+
+	// Any 64 bytes decode to a key, including t = 0 and u^3 + 7 + t^2 = 0
+	var u, t2, g, seven FieldElement
+	seven.setInt(7)
+	for b := byte(1); ; b++ {
+		var ub [32]byte
+		ub[31] = b
+		u.setB32(ub[:])
+		g.sqr(&u)
+		g.mul(&g, &u)
+		g.add(&seven)
+		g.negate(&g, 2)
+		if t2.sqrt(&g) {
+			break
+		}
+	}
+	var special [64]byte
+	u.normalize()
+	t2.normalize()
+	u.getB32(special[:32])
+	t2.getB32(special[32:])
+	for _, ell := range [][]byte{special[:], make([]byte, 64), append(make([]byte, 32), special[:32]...)} {
+		var pubkey PublicKey
+		EllSwiftDecode(&pubkey, ell)
+		var p GroupElementAffine
+		pubkeyLoad(&p, &pubkey)
+		if p.isInfinity() || !p.isValid() {
+			t.Fatalf("%x decodes to an invalid key", ell)
+		}
+	}
+
+	var pubkey PublicKey
+	if EllSwiftDecode(&pubkey, make([]byte, 63)) == nil {
+		t.Error("accepted a 63 byte encoding")
+	}
+	if EllSwiftEncode(make([]byte, 64), &PublicKey{}, make([]byte, 32)) == nil {
+		t.Error("encoded an invalid key")
+	}
+	if EllSwiftCreate(make([]byte, 64), make([]byte, 32), nil) == nil {
+		t.Error("created an encoding for a zero key")
+	}
+}
+
+// TestEllSwiftXSwiftECInv checks that every branch of the inverse that
+// succeeds maps back to x
+func TestEllSwiftXSwiftECInv(t *testing.T) {
+	successes := 0
+	for i := 0; i < 64; i++ {
+		_, pubkey, err := ECKeyPairGenerate()
+		if err != nil {
+			t.Fatal(err)
+		}
+		var p GroupElementAffine
+		pubkeyLoad(&p, pubkey)
+		var ub [32]byte
+		rand.Read(ub[:])
+		var u FieldElement
+		u.setB32(ub[:])
+		for c := 0; c < 8; c++ {
+			var tt, x FieldElement
+			if !ellswiftXSwiftECInv(&tt, &p.x, &u, c) {
+				continue
+			}
+			successes++
+			var xn, xd FieldElement
+			ellswiftXSwiftECFrac(&xn, &xd, &u, &tt)
+			xd.invVar(&xd)
+			x.mul(&xn, &xd)
+			x.normalize()
+			if !x.equal(&p.x) {
+				t.Fatalf("branch %d of key %d does not map back", c, i)
+			}
+		}
+	}
+	// Each branch succeeds with probability about 1/4
+	if successes < 64 {
+		t.Errorf("only %d of %d inversions succeeded", successes, 64*8)
+	}
+}
+
+func TestEllSwiftXDH(t *testing.T) {
+	for i := 0; i < 32; i++ {
+		ka, pubA, err := ECKeyPairGenerate()
+		if err != nil {
+			t.Fatal(err)
+		}
+		kb, pubB, err := ECKeyPairGenerate()
+		if err != nil {
+			t.Fatal(err)
+		}
+		ellA, ellB := make([]byte, 64), make([]byte, 64)
+		EllSwiftCreate(ellA, ka, nil)
+		EllSwiftCreate(ellB, kb, nil)
+
+		outA, outB := make([]byte, 32), make([]byte, 32)
+		if err := EllSwiftXDH(outA, ellA, ellB, ka, false, nil); err != nil {
+			t.Fatal(err)
+		}
+		if err := EllSwiftXDH(outB, ellA, ellB, kb, true, nil); err != nil {
+			t.Fatal(err)
+		}
+		if !bytes.Equal(outA, outB) {
+			t.Fatalf("pair %d: the parties disagree", i)
+		}
+
+		// The prefix hash of the shared x must match ECDHXOnly
+		prefix := make([]byte, 64)
+		rand.Read(prefix)
+		var x [32]byte
+		if err := ECDHXOnly(x[:], pubB, ka); err != nil {
+			t.Fatal(err)
+		}
+		sha := NewSHA256()
+		sha.Write(prefix)
+		sha.Write(ellA)
+		sha.Write(ellB)
+		sha.Write(x[:])
+		want := make([]byte, 32)
+		sha.Finalize(want)
+		if err := EllSwiftXDH(outA, ellA, ellB, ka, false, EllSwiftXDHHashFunctionPrefix(prefix)); err != nil {
+			t.Fatal(err)
+		}
+		if !bytes.Equal(outA, want) {
+			t.Fatalf("pair %d: shared x differs from ECDHXOnly", i)
+		}
+		if err := ECDHXOnly(x[:], pubA, kb); err != nil {
+			t.Fatal(err)
+		}
+		if err := EllSwiftXDH(outB, ellA, ellB, kb, true, EllSwiftXDHHashFunctionPrefix(prefix)); err != nil || !bytes.Equal(outB, want) {
+			t.Fatalf("pair %d: responder's shared x differs: %v", i, err)
+		}
+	}
+
+	if EllSwiftXDH(make([]byte, 32), make([]byte, 64), make([]byte, 64), make([]byte, 32), false, nil) == nil {
+		t.Error("accepted a zero secret key")
+	}
+}
+
+func BenchmarkEllSwift(b *testing.B) {
+	seckey, pubkey, err := ECKeyPairGenerate()
+	if err != nil {
+		b.Fatal(err)
+	}
+	rnd := make([]byte, 32)
+	ell, ellB, out := make([]byte, 64), make([]byte, 64), make([]byte, 32)
+	EllSwiftCreate(ell, seckey, nil)
+	rand.Read(ellB)
+
+	b.Run("encode", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			rnd[0] = byte(i)
+			EllSwiftEncode(ell, pubkey, rnd)
+		}
+	})
+	b.Run("decode", func(b *testing.B) {
+		b.ReportAllocs()
+		var got PublicKey
+		for i := 0; i < b.N; i++ {
+			EllSwiftDecode(&got, ell)
+		}
+	})
+	b.Run("create", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			EllSwiftCreate(ell, seckey, nil)
+		}
+	})
+	b.Run("xdh", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			EllSwiftXDH(out, ell, ellB, seckey, false, nil)
+		}
+	})
+}
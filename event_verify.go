@@ -0,0 +1,101 @@
+package p256k1
+
+import (
+	"hash"
+
+	sha256simd "github.com/minio/sha256-simd"
+)
+
+// DefaultEventBatchSize is the number of events an EventVerifier checks with
+// one batch verification when no batch size is given
+const DefaultEventBatchSize = 64
+
+// EventVerifier checks Nostr events in one pass. For each chunk of events it
+// hashes every serialization into its event id and verifies all the BIP-340
+// signatures of those ids with a single SchnorrVerifyBatch, falling back to
+// per-signature checks only when the batch fails.
+//
+// All buffers are sized to the batch size and reused, so the memory an
+// EventVerifier holds does not grow with the number of events, and a warm
+// EventVerifier performs no allocations. An EventVerifier must not be used
+// concurrently; use one per goroutine.
+type EventVerifier struct {
+	batchSize int
+
+	h       hash.Hash
+	ids     [][32]byte
+	msgs    [][]byte
+	sigs    [][]byte
+	xonly   []XOnlyPubkey
+	pubkeys []*XOnlyPubkey
+	scratch Scratch
+}
+
+// NewEventVerifier returns an EventVerifier checking batchSize events per
+// batch verification. batchSize <= 0 uses DefaultEventBatchSize.
+func NewEventVerifier(batchSize int) *EventVerifier {
+	if batchSize <= 0 {
+		batchSize = DefaultEventBatchSize
+	}
+	v := &EventVerifier{
+		batchSize: batchSize,
+		h:         sha256simd.New(),
+		ids:       make([][32]byte, batchSize),
+		msgs:      make([][]byte, batchSize),
+		sigs:      make([][]byte, batchSize),
+		xonly:     make([]XOnlyPubkey, batchSize),
+		pubkeys:   make([]*XOnlyPubkey, batchSize),
+	}
+	for i := range v.msgs {
+		v.msgs[i] = v.ids[i][:]
+	}
+	return v
+}
+
+// VerifyEvents sets valid[i] to whether sigs[i] is a valid BIP-340 signature
+// by the 32 byte x-only public key pubkeys[i] of the event id
+// SHA256(serialized[i]), where serialized[i] is the canonical serialization
+// [0,pubkey,created_at,kind,tags,content] of the event. If ids is not nil,
+// ids[i] is set to the event id. Signatures and keys of the wrong length, and
+// keys that are not on the curve, are invalid. All slices must have the same
+// length, except that ids may be nil.
+func (v *EventVerifier) VerifyEvents(serialized, sigs, pubkeys [][]byte, ids [][32]byte, valid []bool) {
+	for start := 0; start < len(serialized); start += v.batchSize {
+		end := min(start+v.batchSize, len(serialized))
+		var chunkIDs [][32]byte
+		if ids != nil {
+			chunkIDs = ids[start:end]
+		}
+		v.verifyChunk(serialized[start:end], sigs[start:end], pubkeys[start:end], chunkIDs, valid[start:end])
+	}
+}
+
+// verifyChunk is VerifyEvents for at most batchSize events
+func (v *EventVerifier) verifyChunk(serialized, sigs, pubkeys [][]byte, ids [][32]byte, valid []bool) {
+	n := len(serialized)
+	for i := 0; i < n; i++ {
+		v.h.Reset()
+		v.h.Write(serialized[i])
+		v.h.Sum(v.ids[i][:0])
+		if ids != nil {
+			ids[i] = v.ids[i]
+		}
+
+		// The key is lifted once, inside the batch verification; a wrong
+		// length is passed on as a nil key, which the batch rejects
+		v.sigs[i] = sigs[i]
+		v.pubkeys[i] = nil
+		if len(pubkeys[i]) == 32 {
+			copy(v.xonly[i].data[:], pubkeys[i])
+			v.pubkeys[i] = &v.xonly[i]
+		}
+	}
+
+	_, failed := v.scratch.SchnorrVerifyBatch(v.sigs[:n], v.msgs[:n], v.pubkeys[:n])
+	for i := range valid {
+		valid[i] = true
+	}
+	for _, i := range failed {
+		valid[i] = false
+	}
+}
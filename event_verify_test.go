@@ -0,0 +1,108 @@
+package p256k1
+
+import (
+	"crypto/sha256"
+	"fmt"
+	"testing"
+)
+
+// makeEvents returns n signed events with serializations of varying length
+func makeEvents(tb testing.TB, n int) (serialized, sigs, pubkeys [][]byte) {
+	serialized = make([][]byte, n)
+	sigs = make([][]byte, n)
+	pubkeys = make([][]byte, n)
+	for i := 0; i < n; i++ {
+		kp, err := KeyPairGenerate()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		xonly, err := kp.XOnlyPubkey()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		pubkeys[i] = append([]byte(nil), xonly.data[:]...)
+		serialized[i] = []byte(fmt.Sprintf(`[0,"%x",%d,1,[],"%0*d"]`, pubkeys[i], 1700000000+i, i*37%500, i))
+		id := sha256.Sum256(serialized[i])
+		sigs[i] = make([]byte, 64)
+		if err := SchnorrSign(sigs[i], id[:], kp, nil); err != nil {
+			tb.Fatal(err)
+		}
+		kp.Clear()
+	}
+	return
+}
+
+func TestEventVerifier(t *testing.T) {
+	const n = 150
+	serialized, sigs, pubkeys := makeEvents(t, n)
+
+	// Corrupt some events in different ways
+	want := make([]bool, n)
+	for i := range want {
+		want[i] = true
+	}
+	serialized[3] = append(serialized[3], ' ')
+	want[3] = false
+	sigs[70][10] ^= 1
+	want[70] = false
+	pubkeys[71] = pubkeys[71][:31]
+	want[71] = false
+	pubkeys[140] = make([]byte, 32) // x = 0 is not on the curve
+	want[140] = false
+	sigs[141] = sigs[141][:63]
+	want[141] = false
+
+	for _, batch := range []int{1, 16, 0, 200} {
+		v := NewEventVerifier(batch)
+		ids := make([][32]byte, n)
+		valid := make([]bool, n)
+		v.VerifyEvents(serialized, sigs, pubkeys, ids, valid)
+		for i := range valid {
+			if valid[i] != want[i] {
+				t.Errorf("batch %d: event %d valid = %v, want %v", batch, i, valid[i], want[i])
+			}
+			if ids[i] != sha256.Sum256(serialized[i]) {
+				t.Errorf("batch %d: event %d has the wrong id", batch, i)
+			}
+		}
+		v.VerifyEvents(serialized, sigs, pubkeys, nil, valid)
+	}
+
+	// A warm verifier does not allocate on valid input
+	if raceEnabled {
+		return
+	}
+	serialized, sigs, pubkeys = makeEvents(t, 40)
+	v := NewEventVerifier(16)
+	valid := make([]bool, len(serialized))
+	v.VerifyEvents(serialized, sigs, pubkeys, nil, valid)
+	if n := testing.AllocsPerRun(10, func() { v.VerifyEvents(serialized, sigs, pubkeys, nil, valid) }); n != 0 {
+		t.Errorf("warm VerifyEvents: %v allocs, want 0", n)
+	}
+}
+
+func BenchmarkEventVerifier(b *testing.B) {
+	const n = 64
+	serialized, sigs, pubkeys := makeEvents(b, n)
+	valid := make([]bool, n)
+
+	// Per event
+	b.Run("separate", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			k := i % n
+			id := sha256.Sum256(serialized[k])
+			pk, err := XOnlyPubkeyParse(pubkeys[k])
+			if err != nil || !SchnorrVerify(sigs[k], id[:], pk) {
+				b.Fatal("verification failed")
+			}
+		}
+	})
+	b.Run("pipeline", func(b *testing.B) {
+		v := NewEventVerifier(n)
+		b.ReportAllocs()
+		b.ResetTimer()
+		for i := 0; i < b.N; i += n {
+			v.VerifyEvents(serialized, sigs, pubkeys, nil, valid)
+		}
+	})
+}
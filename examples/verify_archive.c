@@ -0,0 +1,296 @@
+/*************************************************************************
+ * To the extent possible under law, the author(s) have dedicated all    *
+ * copyright and related and neighboring rights to the software in this  *
+ * file to the public domain worldwide. This software is distributed     *
+ * without any warranty. For the CC0 Public Domain Dedication, see       *
+ * EXAMPLES_COPYING or https://creativecommons.org/publicdomain/zero/1.0 *
+ *************************************************************************/
+
+/* Verifies an archive of packed 128-byte records sig64 || msg32 || pubkey32
+ * with secp256k1_schnorrsig_verify_batch_parallel on a pthread pool.
+ *
+ *   verify_archive [-t threads] [-b batch] [-c checkpoint] archive
+ *
+ * The archive is memory-mapped one batch at a time, so memory use does not
+ * grow with its size. Each failing record is printed to stdout as
+ * "<record> <offset> <reason>". With -c the progress "<offset> <records>
+ * <failed>" is written to the checkpoint file after every batch and read back
+ * on start, so an interrupted run (SIGINT) resumes where it stopped; the
+ * format is shared with the Go cmd/verifyarchive, which also reads JSON
+ * lines. A summary with the throughput goes to stderr. The exit status is 0
+ * if every record verified, 1 if some failed, 2 on errors and 130 if the run
+ * was interrupted. */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <secp256k1.h>
+#include <secp256k1_extrakeys.h>
+#include <secp256k1_schnorrsig.h>
+
+#define RECORD_SIZE 128
+#define MAX_THREADS 64
+#define SCRATCH_SIZE (1024 * 1024)
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void on_interrupt(int sig) {
+    (void)sig;
+    interrupted = 1;
+}
+
+typedef struct {
+    secp256k1_batch_task_function fn;
+    void *arg;
+} task;
+
+static void *task_main(void *arg) {
+    task *t = (task *)arg;
+    t->fn(t->arg);
+    return NULL;
+}
+
+/* A secp256k1_batch_task_runner that starts a thread for every task but the
+ * first, which runs on the calling thread. A task whose thread cannot be
+ * started runs on the calling thread too. */
+static int run_tasks(secp256k1_batch_task_function fn, void *const *args, size_t n_tasks, void *data) {
+    pthread_t threads[MAX_THREADS];
+    task tasks[MAX_THREADS];
+    int started[MAX_THREADS];
+    size_t i;
+    (void)data;
+    if (n_tasks > MAX_THREADS) {
+        return 0;
+    }
+    for (i = 1; i < n_tasks; i++) {
+        tasks[i].fn = fn;
+        tasks[i].arg = args[i];
+        started[i] = pthread_create(&threads[i], NULL, task_main, &tasks[i]) == 0;
+    }
+    if (n_tasks > 0) {
+        fn(args[0]);
+    }
+    for (i = 1; i < n_tasks; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            fn(args[i]);
+        }
+    }
+    return 1;
+}
+
+typedef struct {
+    unsigned long offset;
+    unsigned long records;
+    unsigned long failed;
+} progress;
+
+/* Returns 1 and sets p if the checkpoint exists and is well formed, 0 and
+ * leaves p zero if it does not exist, and -1 otherwise. */
+static int read_checkpoint(const char *path, progress *p) {
+    FILE *f = fopen(path, "r");
+    int ok;
+    memset(p, 0, sizeof(*p));
+    if (f == NULL) {
+        return errno == ENOENT ? 0 : -1;
+    }
+    ok = fscanf(f, "%lu %lu %lu", &p->offset, &p->records, &p->failed) == 3;
+    fclose(f);
+    return ok ? 1 : -1;
+}
+
+/* Writes p to path through a temporary file, so that an interrupted write
+ * leaves the previous checkpoint. Returns 1 on success. */
+static int write_checkpoint(const char *path, const progress *p) {
+    char tmp[4096];
+    FILE *f;
+    int ok;
+    if (strlen(path) + 5 > sizeof(tmp)) {
+        return 0;
+    }
+    strcpy(tmp, path);
+    strcat(tmp, ".tmp");
+    f = fopen(tmp, "w");
+    if (f == NULL) {
+        return 0;
+    }
+    ok = fprintf(f, "%lu %lu %lu\n", p->offset, p->records, p->failed) > 0;
+    ok = (fclose(f) == 0) && ok;
+    return ok && rename(tmp, path) == 0;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int usage(void) {
+    fprintf(stderr, "usage: verify_archive [-t threads] [-b batch] [-c checkpoint] archive\n");
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL, *checkpoint = NULL;
+    size_t threads = 1, batch = 16384;
+    long pagesize = sysconf(_SC_PAGESIZE);
+    int fd, i, ret = 2;
+    struct stat st;
+    unsigned long size, start_records;
+    progress p;
+    double began, elapsed;
+    secp256k1_context *ctx = NULL;
+    secp256k1_xonly_pubkey *keys = NULL;
+    const secp256k1_xonly_pubkey **key_ptrs = NULL;
+    const unsigned char **sigs = NULL, **msgs = NULL;
+    size_t *msglens = NULL, *idx = NULL;
+    unsigned char *status = NULL;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            threads = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            batch = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            checkpoint = argv[++i];
+        } else if (argv[i][0] == '-' || path != NULL) {
+            return usage();
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == NULL || threads < 1 || threads > MAX_THREADS || batch < 1) {
+        return usage();
+    }
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(path);
+        return 2;
+    }
+    size = (unsigned long)st.st_size;
+
+    memset(&p, 0, sizeof(p));
+    if (checkpoint != NULL && read_checkpoint(checkpoint, &p) < 0) {
+        fprintf(stderr, "%s: malformed checkpoint\n", checkpoint);
+        goto done;
+    }
+    if (p.offset > size || p.offset % RECORD_SIZE != 0) {
+        fprintf(stderr, "%s: checkpoint offset %lu does not fit %s\n", checkpoint, p.offset, path);
+        goto done;
+    }
+    start_records = p.records;
+
+    ctx = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    keys = malloc(batch * sizeof(*keys));
+    key_ptrs = malloc(batch * sizeof(*key_ptrs));
+    sigs = malloc(batch * sizeof(*sigs));
+    msgs = malloc(batch * sizeof(*msgs));
+    msglens = malloc(batch * sizeof(*msglens));
+    idx = malloc(batch * sizeof(*idx));
+    status = malloc(batch);
+    if (keys == NULL || key_ptrs == NULL || sigs == NULL || msgs == NULL || msglens == NULL || idx == NULL || status == NULL) {
+        fprintf(stderr, "out of memory\n");
+        goto done;
+    }
+    signal(SIGINT, on_interrupt);
+
+    began = now();
+    while (size - p.offset >= RECORD_SIZE && !interrupted) {
+        size_t n = (size - p.offset) / RECORD_SIZE, m = 0, j;
+        unsigned long map_off, map_len;
+        unsigned char *base;
+        const unsigned char *rec;
+        if (n > batch) {
+            n = batch;
+        }
+
+        /* Map only this batch; mmap offsets must be page aligned */
+        map_off = p.offset - p.offset % (unsigned long)pagesize;
+        map_len = p.offset + n * RECORD_SIZE - map_off;
+        base = mmap(NULL, map_len, PROT_READ, MAP_SHARED, fd, (off_t)map_off);
+        if (base == MAP_FAILED) {
+            perror("mmap");
+            goto done;
+        }
+        rec = base + (p.offset - map_off);
+
+        for (j = 0; j < n; j++) {
+            const unsigned char *r = rec + j * RECORD_SIZE;
+            status[j] = 0;
+            if (!secp256k1_xonly_pubkey_parse(ctx, &keys[j], r + 96)) {
+                status[j] = 1;
+                continue;
+            }
+            sigs[m] = r;
+            msgs[m] = r + 64;
+            msglens[m] = 32;
+            key_ptrs[m] = &keys[j];
+            idx[m] = j;
+            m++;
+        }
+
+        /* A failing batch does not tell which signature failed */
+        if (!secp256k1_schnorrsig_verify_batch_parallel(ctx, threads, SCRATCH_SIZE, run_tasks, NULL, sigs, msgs, msglens, key_ptrs, m)) {
+            for (j = 0; j < m; j++) {
+                if (!secp256k1_schnorrsig_verify(ctx, sigs[j], msgs[j], 32, key_ptrs[j])) {
+                    status[idx[j]] = 2;
+                }
+            }
+        }
+        munmap(base, map_len);
+
+        for (j = 0; j < n; j++) {
+            if (status[j] != 0) {
+                printf("%lu %lu %s\n", p.records + (unsigned long)j, p.offset + (unsigned long)j * RECORD_SIZE,
+                       status[j] == 1 ? "invalid public key" : "invalid signature");
+                p.failed++;
+            }
+        }
+        fflush(stdout);
+        p.offset += n * RECORD_SIZE;
+        p.records += n;
+        if (checkpoint != NULL && !write_checkpoint(checkpoint, &p)) {
+            perror(checkpoint);
+            goto done;
+        }
+    }
+    elapsed = now() - began;
+
+    fprintf(stderr, "%s: %lu records verified in %.3fs (%.0f sigs/s), %lu failed in total\n",
+            path, p.records - start_records, elapsed, elapsed > 0 ? (p.records - start_records) / elapsed : 0.0, p.failed);
+    if (interrupted) {
+        fprintf(stderr, "interrupted at offset %lu\n", p.offset);
+        ret = 130;
+    } else if (p.offset != size) {
+        fprintf(stderr, "truncated record at offset %lu\n", p.offset);
+    } else {
+        ret = p.failed > 0;
+    }
+
+done:
+    free(status);
+    free(idx);
+    free(msglens);
+    free(msgs);
+    free(sigs);
+    free(key_ptrs);
+    free(keys);
+    if (ctx != NULL) {
+        secp256k1_context_destroy(ctx);
+    }
+    close(fd);
+    return ret;
+}
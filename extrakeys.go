@@ -2,11 +2,17 @@ package p256k1
 
 import (
 	"errors"
+	"sort"
 	"unsafe"
 )
 
 // XOnlyPubkey represents an x-only public key (32 bytes, just X coordinate)
 // Following BIP-340 specification
+//
+// XOnlyPubkey, KeyPair and PublicKey hold only fixed-size arrays, so a slice
+// of them has no pointers for the garbage collector to scan. The functions
+// with a Value suffix return them by value to fill such slices without a
+// heap object per key.
 type XOnlyPubkey struct {
 	data [32]byte
 }
@@ -20,34 +26,35 @@ type KeyPair struct {
 
 // XOnlyPubkeyParse parses a 32-byte sequence into an x-only public key
 func XOnlyPubkeyParse(input32 []byte) (*XOnlyPubkey, error) {
+	xonly, err := XOnlyPubkeyParseValue(input32)
+	if err != nil {
+		return nil, err
+	}
+	return &xonly, nil
+}
+
+// XOnlyPubkeyParseValue is XOnlyPubkeyParse returning the key by value
+func XOnlyPubkeyParseValue(input32 []byte) (XOnlyPubkey, error) {
 	if len(input32) != 32 {
-		return nil, errors.New("input must be 32 bytes")
+		return XOnlyPubkey{}, errors.New("input must be 32 bytes")
 	}
 
 	// Create a point from X coordinate
 	var x FieldElement
 	if err := x.setB32(input32); err != nil {
-		return nil, errors.New("invalid X coordinate")
+		return XOnlyPubkey{}, errors.New("invalid X coordinate")
 	}
 
-	// Try to recover Y coordinate (check if point is on curve)
-	var point GroupElementAffine
-	if !point.setXOVar(&x, false) {
-		// Try with odd Y
-		if !point.setXOVar(&x, true) {
-			return nil, errors.New("X coordinate does not correspond to a valid point")
-		}
-	}
-
-	// Verify point is valid
-	if !point.isValid() {
-		return nil, errors.New("invalid point")
+	// Check that x is on the curve. The point itself is not needed, so
+	// this takes a Jacobi symbol rather than a square root.
+	if !xOnCurveVar(&x) {
+		return XOnlyPubkey{}, errors.New("X coordinate does not correspond to a valid point")
 	}
 
 	// Create x-only pubkey (just X coordinate)
 	var xonly XOnlyPubkey
 	copy(xonly.data[:], input32)
-	return &xonly, nil
+	return xonly, nil
 }
 
 // Serialize serializes an x-only public key to 32 bytes
@@ -58,15 +65,25 @@ func (xonly *XOnlyPubkey) Serialize() [32]byte {
 // XOnlyPubkeyFromPubkey converts a PublicKey to an XOnlyPubkey
 // Returns the x-only pubkey and parity (1 if Y was odd, 0 if even)
 func XOnlyPubkeyFromPubkey(pubkey *PublicKey) (*XOnlyPubkey, int, error) {
+	xonly, parity, err := XOnlyPubkeyFromPubkeyValue(pubkey)
+	if err != nil {
+		return nil, 0, err
+	}
+	return &xonly, parity, nil
+}
+
+// XOnlyPubkeyFromPubkeyValue is XOnlyPubkeyFromPubkey returning the key by
+// value
+func XOnlyPubkeyFromPubkeyValue(pubkey *PublicKey) (XOnlyPubkey, int, error) {
 	if pubkey == nil {
-		return nil, 0, errors.New("pubkey cannot be nil")
+		return XOnlyPubkey{}, 0, errors.New("pubkey cannot be nil")
 	}
 
 	// Load public key
 	var pt GroupElementAffine
 	pt.fromBytes(pubkey.data[:])
 	if pt.isInfinity() {
-		return nil, 0, errors.New("invalid public key")
+		return XOnlyPubkey{}, 0, errors.New("invalid public key")
 	}
 
 	// Normalize Y coordinate
@@ -85,7 +102,7 @@ func XOnlyPubkeyFromPubkey(pubkey *PublicKey) (*XOnlyPubkey, int, error) {
 	pt.x.normalize()
 	pt.x.getB32(xonly.data[:])
 
-	return &xonly, parity, nil
+	return xonly, parity, nil
 }
 
 // XOnlyPubkeyCmp compares two x-only public keys lexicographically
@@ -95,7 +112,7 @@ func XOnlyPubkeyCmp(xonly1, xonly2 *XOnlyPubkey) int {
 		panic("xonly pubkey cannot be nil")
 	}
 
-	for i := 31; i >= 0; i-- {
+	for i := 0; i < 32; i++ {
 		if xonly1.data[i] < xonly2.data[i] {
 			return -1
 		}
@@ -106,39 +123,227 @@ func XOnlyPubkeyCmp(xonly1, xonly2 *XOnlyPubkey) int {
 	return 0
 }
 
+// XOnlyPubkeyTweakAdd sets output = internal + tweak*G, where internal is
+// lifted to the point with even y, as secp256k1_xonly_pubkey_tweak_add. A
+// zero tweak is allowed; a tweak that overflows the group order is not.
+func XOnlyPubkeyTweakAdd(output *PublicKey, internal *XOnlyPubkey, tweak []byte) error {
+	var q GroupElementAffine
+	if err := xonlyPubkeyTweakAdd(&q, internal, tweak); err != nil {
+		return err
+	}
+	q.toBytes(output.data[:])
+	return nil
+}
+
+// XOnlyPubkeyTweakAddCheck reports whether the x-only key tweaked32 with
+// parity tweakedParity (0 or 1) is the result of XOnlyPubkeyTweakAdd with
+// internal and tweak, as secp256k1_xonly_pubkey_tweak_add_check
+func XOnlyPubkeyTweakAddCheck(tweaked32 []byte, tweakedParity int, internal *XOnlyPubkey, tweak []byte) bool {
+	if len(tweaked32) != 32 {
+		return false
+	}
+	var q GroupElementAffine
+	if xonlyPubkeyTweakAdd(&q, internal, tweak) != nil {
+		return false
+	}
+	var x [32]byte
+	q.x.normalize()
+	q.y.normalize()
+	q.x.getB32(x[:])
+	parity := 0
+	if q.y.isOdd() {
+		parity = 1
+	}
+	return x == [32]byte(tweaked32) && parity == tweakedParity
+}
+
+// xonlyPubkeyTweakAdd sets q = P + tweak*G for the even-y lift P of internal
+func xonlyPubkeyTweakAdd(q *GroupElementAffine, internal *XOnlyPubkey, tweak []byte) error {
+	if internal == nil {
+		return errors.New("internal pubkey cannot be nil")
+	}
+	if len(tweak) != 32 {
+		return errors.New("tweak must be 32 bytes")
+	}
+	var t Scalar
+	if t.setB32(tweak) {
+		return errors.New("tweak overflows the group order")
+	}
+	var p GroupElementAffine
+	if !xonlyPubkeyLoad(&p, &internal.data) {
+		return errors.New("invalid x-only public key")
+	}
+
+	var pj, tg GroupElementJacobian
+	EcmultGen(&tg, &t)
+	pj.setGE(&p)
+	tg.addVar(&tg, &pj)
+	if tg.isInfinity() {
+		return errors.New("resulting public key is infinity")
+	}
+	q.setGEJVar(&tg)
+	return nil
+}
+
+// XOnlyPubkeyTweakAddCheckBatch runs XOnlyPubkeyTweakAddCheck on every
+// (tweaked32s[i], parities[i], internals[i], tweaks[i]), as when checking the
+// Taproot output keys of a block. Each entry is computed as P_i + t_i*G like
+// a single check, but all results are converted to affine with one shared
+// field inversion. Unlike the random linear combination of
+// secp256k1_xonly_pubkey_tweak_add_check_batch, this needs no decompression
+// of the tweaked keys, which in Go costs more than the fixed-base t_i*G it
+// would save, and every entry is checked exactly. If every check passes,
+// valid is true and failed is nil; otherwise failed lists the indices of the
+// failing entries in ascending order. If the slice lengths differ, valid is
+// false and failed is nil.
+func XOnlyPubkeyTweakAddCheckBatch(tweaked32s [][]byte, parities []int, internals []*XOnlyPubkey, tweaks [][]byte) (valid bool, failed []int) {
+	s := scratchPool.Get().(*Scratch)
+	defer scratchPool.Put(s)
+	return s.XOnlyPubkeyTweakAddCheckBatch(tweaked32s, parities, internals, tweaks)
+}
+
+// XOnlyPubkeyTweakAddCheckBatch is XOnlyPubkeyTweakAddCheckBatch with its
+// temporaries taken from s
+func (s *Scratch) XOnlyPubkeyTweakAddCheckBatch(tweaked32s [][]byte, parities []int, internals []*XOnlyPubkey, tweaks [][]byte) (valid bool, failed []int) {
+	if s == nil {
+		return XOnlyPubkeyTweakAddCheckBatch(tweaked32s, parities, internals, tweaks)
+	}
+	if len(internals) != len(tweaked32s) {
+		return false, nil
+	}
+	return xonlyPubkeyTweakAddCheckBatch(s, tweaked32s, parities, internals, nil, tweaks)
+}
+
+// XOnlyPubkeyTweakAddCheckBatchPrepared is XOnlyPubkeyTweakAddCheckBatch for
+// prepared internal keys, whose points are already decompressed. This skips
+// the square root that dominates the cost of a check.
+func XOnlyPubkeyTweakAddCheckBatchPrepared(tweaked32s [][]byte, parities []int, internals []*PreparedXOnlyPubkey, tweaks [][]byte) (valid bool, failed []int) {
+	if len(internals) != len(tweaked32s) {
+		return false, nil
+	}
+	s := scratchPool.Get().(*Scratch)
+	defer scratchPool.Put(s)
+	return xonlyPubkeyTweakAddCheckBatch(s, tweaked32s, parities, nil, internals, tweaks)
+}
+
+// xonlyPubkeyTweakAddCheckBatch implements the batch APIs; exactly one of
+// internals and prepared is used, and it has the same length as tweaked32s
+func xonlyPubkeyTweakAddCheckBatch(s *Scratch, tweaked32s [][]byte, parities []int, internals []*XOnlyPubkey, prepared []*PreparedXOnlyPubkey, tweaks [][]byte) (valid bool, failed []int) {
+	n := len(tweaked32s)
+	if len(parities) != n || len(tweaks) != n {
+		return false, nil
+	}
+	if n == 0 {
+		return true, nil
+	}
+
+	cp := s.Checkpoint()
+	defer s.Rollback(cp)
+
+	qj := s.jacobian.alloc(n)
+	q := s.affine.alloc(n)
+	entries := s.ints.alloc(n)[:0]
+
+	for i := 0; i < n; i++ {
+		if len(tweaked32s[i]) != 32 || len(tweaks[i]) != 32 || (parities[i] != 0 && parities[i] != 1) {
+			failed = append(failed, i)
+			continue
+		}
+		var p GroupElementAffine
+		if prepared != nil {
+			if prepared[i] == nil {
+				failed = append(failed, i)
+				continue
+			}
+			p = prepared[i].point
+		} else if internals[i] == nil || !xonlyPubkeyLoad(&p, &internals[i].data) {
+			failed = append(failed, i)
+			continue
+		}
+		var t Scalar
+		if t.setB32(tweaks[i]) {
+			failed = append(failed, i)
+			continue
+		}
+
+		k := len(entries)
+		var pj GroupElementJacobian
+		EcmultGen(&qj[k], &t)
+		pj.setGE(&p)
+		qj[k].addVar(&qj[k], &pj)
+		entries = append(entries, i)
+	}
+
+	m := len(entries)
+	geSetAllGEJVar(q[:m], qj[:m])
+
+	var x [32]byte
+	for k, i := range entries {
+		if q[k].infinity {
+			failed = append(failed, i)
+			continue
+		}
+		q[k].x.normalize()
+		q[k].y.normalize()
+		q[k].x.getB32(x[:])
+		parity := 0
+		if q[k].y.isOdd() {
+			parity = 1
+		}
+		if x != [32]byte(tweaked32s[i]) || parity != parities[i] {
+			failed = append(failed, i)
+		}
+	}
+	sort.Ints(failed)
+	return len(failed) == 0, failed
+}
+
 // KeyPairCreate creates a keypair from a secret key
 func KeyPairCreate(seckey []byte) (*KeyPair, error) {
+	kp, err := KeyPairCreateValue(seckey)
+	if err != nil {
+		return nil, err
+	}
+	return &kp, nil
+}
+
+// KeyPairCreateValue is KeyPairCreate returning the keypair by value
+func KeyPairCreateValue(seckey []byte) (KeyPair, error) {
 	if len(seckey) != 32 {
-		return nil, errors.New("secret key must be 32 bytes")
+		return KeyPair{}, errors.New("secret key must be 32 bytes")
 	}
 
 	if !ECSeckeyVerify(seckey) {
-		return nil, errors.New("invalid secret key")
+		return KeyPair{}, errors.New("invalid secret key")
 	}
 
-	// Create public key
-	var pubkey PublicKey
-	if err := ECPubkeyCreate(&pubkey, seckey); err != nil {
-		return nil, err
+	var kp KeyPair
+	if err := ECPubkeyCreate(&kp.pubkey, seckey); err != nil {
+		return KeyPair{}, err
 	}
-
-	kp := &KeyPair{}
 	copy(kp.seckey[:], seckey)
-	kp.pubkey = pubkey
 
 	return kp, nil
 }
 
 // KeyPairGenerate generates a new random keypair
 func KeyPairGenerate() (*KeyPair, error) {
-	seckey, pubkey, err := ECKeyPairGenerate()
+	kp, err := KeyPairGenerateValue()
 	if err != nil {
 		return nil, err
 	}
+	return &kp, nil
+}
 
-	kp := &KeyPair{}
-	copy(kp.seckey[:], seckey)
-	kp.pubkey = *pubkey
+// KeyPairGenerateValue is KeyPairGenerate returning the keypair by value
+func KeyPairGenerateValue() (KeyPair, error) {
+	seckey, pubkey, err := ECKeyPairGenerateValue()
+	if err != nil {
+		return KeyPair{}, err
+	}
+
+	kp := KeyPair{seckey: seckey, pubkey: pubkey}
+	memclear(unsafe.Pointer(&seckey[0]), 32)
 
 	return kp, nil
 }
@@ -159,6 +364,12 @@ func (kp *KeyPair) XOnlyPubkey() (*XOnlyPubkey, error) {
 	return xonly, err
 }
 
+// XOnlyPubkeyValue is XOnlyPubkey returning the key by value
+func (kp *KeyPair) XOnlyPubkeyValue() (XOnlyPubkey, error) {
+	xonly, _, err := XOnlyPubkeyFromPubkeyValue(&kp.pubkey)
+	return xonly, err
+}
+
 // Clear clears the keypair to prevent leaking sensitive information
 func (kp *KeyPair) Clear() {
 	memclear(unsafe.Pointer(&kp.seckey[0]), 32)
@@ -1,6 +1,8 @@
 package p256k1
 
 import (
+	"crypto/rand"
+	"reflect"
 	"testing"
 )
 
@@ -119,6 +121,92 @@ func TestKeyPairGenerate(t *testing.T) {
 	}
 }
 
+func TestValueKeys(t *testing.T) {
+	// A slice of any of these must be invisible to the garbage collector
+	for _, v := range []interface{}{XOnlyPubkey{}, KeyPair{}, PublicKey{}, SchnorrSignature{}} {
+		if typ := reflect.TypeOf(v); hasPointers(typ) {
+			t.Errorf("%v holds pointers", typ)
+		}
+	}
+
+	kp, err := KeyPairGenerateValue()
+	if err != nil {
+		t.Fatal(err)
+	}
+	kpPtr, err := KeyPairCreate(kp.Seckey())
+	if err != nil {
+		t.Fatal(err)
+	}
+	kp2, err := KeyPairCreateValue(kp.Seckey())
+	if err != nil || kp2 != *kpPtr || kp2 != kp {
+		t.Fatalf("KeyPairCreateValue = %v, %v", kp2, err)
+	}
+	if _, err := KeyPairCreateValue(make([]byte, 32)); err == nil {
+		t.Error("accepted a zero secret key")
+	}
+
+	xonly, err := kp.XOnlyPubkeyValue()
+	if err != nil {
+		t.Fatal(err)
+	}
+	xonlyPtr, _ := kpPtr.XOnlyPubkey()
+	if xonly != *xonlyPtr {
+		t.Fatal("XOnlyPubkeyValue differs from XOnlyPubkey")
+	}
+	ser := xonly.Serialize()
+	parsed, err := XOnlyPubkeyParseValue(ser[:])
+	if err != nil || parsed != xonly {
+		t.Fatalf("XOnlyPubkeyParseValue = %v, %v", parsed, err)
+	}
+	if _, err := XOnlyPubkeyParseValue(make([]byte, 31)); err == nil {
+		t.Error("accepted a 31 byte key")
+	}
+	if n := testing.AllocsPerRun(10, func() { XOnlyPubkeyParseValue(ser[:]) }); n != 0 {
+		t.Errorf("XOnlyPubkeyParseValue allocated %v times", n)
+	}
+	if n := testing.AllocsPerRun(10, func() { XOnlyPubkeyFromPubkeyValue(&kp.pubkey) }); n != 0 {
+		t.Errorf("XOnlyPubkeyFromPubkeyValue allocated %v times", n)
+	}
+
+	msg := make([]byte, 32)
+	sig, err := SchnorrSignValue(msg, &kp, nil)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !SchnorrVerify(sig[:], msg, &xonly) {
+		t.Error("SchnorrSignValue signature does not verify")
+	}
+
+	seckey, pubkey, err := ECKeyPairGenerateValue()
+	if err != nil {
+		t.Fatal(err)
+	}
+	var want PublicKey
+	if err := ECPubkeyCreate(&want, seckey[:]); err != nil || want != pubkey {
+		t.Error("ECKeyPairGenerateValue public key does not match its secret key")
+	}
+}
+
+// hasPointers reports whether values of typ contain pointers
+func hasPointers(typ reflect.Type) bool {
+	switch typ.Kind() {
+	case reflect.Array:
+		return typ.Len() > 0 && hasPointers(typ.Elem())
+	case reflect.Struct:
+		for i := 0; i < typ.NumField(); i++ {
+			if hasPointers(typ.Field(i).Type) {
+				return true
+			}
+		}
+		return false
+	case reflect.Bool, reflect.Int, reflect.Int8, reflect.Int16, reflect.Int32, reflect.Int64,
+		reflect.Uint, reflect.Uint8, reflect.Uint16, reflect.Uint32, reflect.Uint64, reflect.Uintptr,
+		reflect.Float32, reflect.Float64, reflect.Complex64, reflect.Complex128:
+		return false
+	}
+	return true
+}
+
 func TestXOnlyPubkeyCmp(t *testing.T) {
 	kp1, err := KeyPairGenerate()
 	if err != nil {
@@ -151,3 +239,151 @@ func TestXOnlyPubkeyCmp(t *testing.T) {
 		t.Error("different x-only pubkeys should not compare equal")
 	}
 }
+
+func makeTweakBatch(tb testing.TB, n int) (tweaked32s [][]byte, parities []int, internals []*XOnlyPubkey, tweaks [][]byte) {
+	for i := 0; i < n; i++ {
+		kp, err := KeyPairGenerate()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		internal, err := kp.XOnlyPubkey()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		tweak := make([]byte, 32)
+		if _, err := rand.Read(tweak); err != nil {
+			tb.Fatal(err)
+		}
+		var out PublicKey
+		if err := XOnlyPubkeyTweakAdd(&out, internal, tweak); err != nil {
+			tb.Fatal(err)
+		}
+		q, parity, err := XOnlyPubkeyFromPubkey(&out)
+		if err != nil {
+			tb.Fatal(err)
+		}
+		q32 := q.Serialize()
+		tweaked32s = append(tweaked32s, q32[:])
+		parities = append(parities, parity)
+		internals = append(internals, internal)
+		tweaks = append(tweaks, tweak)
+	}
+	return
+}
+
+func TestXOnlyPubkeyTweakAddCheck(t *testing.T) {
+	tweaked32s, parities, internals, tweaks := makeTweakBatch(t, 1)
+	q32, parity, internal, tweak := tweaked32s[0], parities[0], internals[0], tweaks[0]
+
+	if !XOnlyPubkeyTweakAddCheck(q32, parity, internal, tweak) {
+		t.Fatal("valid tweak rejected")
+	}
+	if XOnlyPubkeyTweakAddCheck(q32, 1-parity, internal, tweak) || XOnlyPubkeyTweakAddCheck(q32, 2, internal, tweak) {
+		t.Error("wrong parity accepted")
+	}
+	p32 := internal.Serialize()
+	if XOnlyPubkeyTweakAddCheck(p32[:], parity, internal, tweak) {
+		t.Error("wrong tweaked key accepted")
+	}
+	overflow := make([]byte, 32)
+	for i := range overflow {
+		overflow[i] = 0xff
+	}
+	if XOnlyPubkeyTweakAddCheck(q32, parity, internal, overflow) {
+		t.Error("overflowing tweak accepted")
+	}
+	var out PublicKey
+	if XOnlyPubkeyTweakAdd(&out, internal, overflow) == nil {
+		t.Error("overflowing tweak accepted by XOnlyPubkeyTweakAdd")
+	}
+
+	// A zero tweak gives back the internal key with even y
+	if err := XOnlyPubkeyTweakAdd(&out, internal, make([]byte, 32)); err != nil {
+		t.Fatal(err)
+	}
+	if !XOnlyPubkeyTweakAddCheck(p32[:], 0, internal, make([]byte, 32)) {
+		t.Error("zero tweak rejected")
+	}
+}
+
+func TestXOnlyPubkeyTweakAddCheckBatch(t *testing.T) {
+	tweaked32s, parities, internals, tweaks := makeTweakBatch(t, 100)
+
+	if valid, failed := XOnlyPubkeyTweakAddCheckBatch(tweaked32s, parities, internals, tweaks); !valid || failed != nil {
+		t.Fatalf("valid batch rejected, failed = %v", failed)
+	}
+	if valid, failed := XOnlyPubkeyTweakAddCheckBatch(nil, nil, nil, nil); !valid || failed != nil {
+		t.Error("empty batch rejected")
+	}
+	if valid, failed := XOnlyPubkeyTweakAddCheckBatch(tweaked32s, parities[:1], internals, tweaks); valid || failed != nil {
+		t.Error("mismatched lengths accepted")
+	}
+
+	// Break a few entries in different ways
+	parities[3] = 1 - parities[3]
+	parities[10] = 2
+	internals[20], internals[21] = internals[21], internals[20]
+	badQ := make([]byte, 32)
+	for i := range badQ {
+		badQ[i] = 0xff
+	}
+	tweaked32s[50] = badQ
+	tweaks[99] = tweaks[98]
+
+	valid, failed := XOnlyPubkeyTweakAddCheckBatch(tweaked32s, parities, internals, tweaks)
+	if want := []int{3, 10, 20, 21, 50, 99}; valid || !reflect.DeepEqual(failed, want) {
+		t.Errorf("got valid = %v, failed = %v; want false, %v", valid, failed, want)
+	}
+
+	// Prepared internal keys give the same result
+	prepared := make([]*PreparedXOnlyPubkey, len(internals))
+	for i, internal := range internals {
+		var err error
+		if prepared[i], err = XOnlyPubkeyPrepare(internal); err != nil {
+			t.Fatal(err)
+		}
+	}
+	valid, failed = XOnlyPubkeyTweakAddCheckBatchPrepared(tweaked32s, parities, prepared, tweaks)
+	if want := []int{3, 10, 20, 21, 50, 99}; valid || !reflect.DeepEqual(failed, want) {
+		t.Errorf("prepared: got valid = %v, failed = %v; want false, %v", valid, failed, want)
+	}
+
+	// A warm Scratch checks a valid batch without allocating
+	tweaked32s, parities, internals, tweaks = makeTweakBatch(t, 16)
+	s := NewScratch()
+	s.XOnlyPubkeyTweakAddCheckBatch(tweaked32s, parities, internals, tweaks)
+	if n := testing.AllocsPerRun(10, func() { s.XOnlyPubkeyTweakAddCheckBatch(tweaked32s, parities, internals, tweaks) }); n != 0 {
+		t.Errorf("warm Scratch.XOnlyPubkeyTweakAddCheckBatch: %v allocs, want 0", n)
+	}
+}
+
+func BenchmarkXOnlyPubkeyTweakAddCheck(b *testing.B) {
+	const n = 1000
+	tweaked32s, parities, internals, tweaks := makeTweakBatch(b, n)
+	b.Run("Single", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for j := 0; j < n; j++ {
+				XOnlyPubkeyTweakAddCheck(tweaked32s[j], parities[j], internals[j], tweaks[j])
+			}
+		}
+		b.ReportMetric(float64(b.Elapsed().Nanoseconds())/float64(b.N*n), "ns/check")
+	})
+	b.Run("Batch", func(b *testing.B) {
+		s := NewScratch()
+		for i := 0; i < b.N; i++ {
+			s.XOnlyPubkeyTweakAddCheckBatch(tweaked32s, parities, internals, tweaks)
+		}
+		b.ReportMetric(float64(b.Elapsed().Nanoseconds())/float64(b.N*n), "ns/check")
+	})
+	b.Run("BatchPrepared", func(b *testing.B) {
+		prepared := make([]*PreparedXOnlyPubkey, n)
+		for i := range prepared {
+			prepared[i], _ = XOnlyPubkeyPrepare(internals[i])
+		}
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			XOnlyPubkeyTweakAddCheckBatchPrepared(tweaked32s, parities, prepared, tweaks)
+		}
+		b.ReportMetric(float64(b.Elapsed().Nanoseconds())/float64(b.N*n), "ns/check")
+	})
+}
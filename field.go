@@ -3,7 +3,6 @@ package p256k1
 import (
 	"crypto/subtle"
 	"errors"
-	"math/bits"
 	"unsafe"
 )
 
@@ -59,6 +58,13 @@ var (
 		normalized: true,
 	}
 
+	// fieldBeta is a nontrivial cube root of unity in the field. Multiplying
+	// the x coordinate of a point by beta multiplies the point by lambda.
+	fieldBeta = FieldElement{
+		n:          [5]uint64{0x96c28719501ee, 0x7512f58995c13, 0xc3434e99cf049, 0x7106e64479ea, 0x7ae96a2b657c},
+		magnitude:  1,
+		normalized: true,
+	}
 )
 
 func NewFieldElement() *FieldElement {
@@ -96,16 +102,32 @@ func (r *FieldElement) setB32(b []byte) error {
 	return nil
 }
 
+// setB32Limit sets a field element from a 32-byte big-endian array and
+// returns false if the encoded value is not below the field modulus
+func (r *FieldElement) setB32Limit(b []byte) bool {
+	if r.setB32(b) != nil {
+		return false
+	}
+	if r.n[4] == limb4Max && (r.n[3]&r.n[2]&r.n[1]) == limb0Max && r.n[0] >= fieldModulusLimb0 {
+		return false
+	}
+	r.normalized = true
+	return true
+}
+
 // getB32 converts a field element to a 32-byte big-endian array
 func (r *FieldElement) getB32(b []byte) {
 	if len(b) != 32 {
 		panic("field element byte array must be 32 bytes")
 	}
 
-	// Normalize first
-	var normalized FieldElement
-	normalized = *r
-	normalized.normalize()
+	// Normalize first, on a copy unless r already is
+	normalized := r
+	if !r.normalized {
+		t := *r
+		t.normalize()
+		normalized = &t
+	}
 
 	// Convert from 5x52 to 4x64 limbs
 	var d [4]uint64
@@ -127,8 +149,16 @@ func (r *FieldElement) getB32(b []byte) {
 	}
 }
 
-// normalize normalizes a field element to its canonical representation
+// normalize normalizes a field element to its canonical representation.
+// Elements already marked normalized are left alone, so callers need not
+// track whether an earlier step normalized them.
 func (r *FieldElement) normalize() {
+	if r.normalized {
+		return
+	}
+	if fieldVerifyEnabled {
+		fieldVerifyCountNormalize()
+	}
 	t0, t1, t2, t3, t4 := r.n[0], r.n[1], r.n[2], r.n[3], r.n[4]
 
 	// Reduce t4 at the start so there will be at most a single carry from the first pass
@@ -173,10 +203,17 @@ func (r *FieldElement) normalize() {
 	r.n[0], r.n[1], r.n[2], r.n[3], r.n[4] = t0, t1, t2, t3, t4
 	r.magnitude = 1
 	r.normalized = true
+	if fieldVerifyEnabled {
+		r.verify()
+	}
 }
 
-// normalizeWeak gives a field element magnitude 1 without full normalization
+// normalizeWeak gives a field element magnitude 1 without full
+// normalization. Normalized elements already satisfy this.
 func (r *FieldElement) normalizeWeak() {
+	if r.normalized {
+		return
+	}
 	t0, t1, t2, t3, t4 := r.n[0], r.n[1], r.n[2], r.n[3], r.n[4]
 
 	// Reduce t4 at the start
@@ -196,6 +233,9 @@ func (r *FieldElement) normalizeWeak() {
 
 	r.n[0], r.n[1], r.n[2], r.n[3], r.n[4] = t0, t1, t2, t3, t4
 	r.magnitude = 1
+	if fieldVerifyEnabled {
+		r.verify()
+	}
 }
 
 // reduce performs modular reduction (simplified implementation)
@@ -223,11 +263,82 @@ func (r *FieldElement) isOdd() bool {
 // normalizesToZeroVar checks if the field element normalizes to zero
 // This is a variable-time check (not constant-time)
 // A field element normalizes to zero if all limbs are zero or if it equals the modulus
+// Follows secp256k1_fe_impl_normalizes_to_zero_var: the low limb alone
+// rules out nearly all nonzero values, without a normalization.
 func (r *FieldElement) normalizesToZeroVar() bool {
-	var t FieldElement
-	t = *r
-	t.normalize()
-	return t.isZero()
+	t0, t4 := r.n[0], r.n[4]
+
+	// Reduce t4 at the start so there will be at most a single carry from the first pass
+	x := t4 >> 48
+	t0 += x * fieldReductionConstant
+
+	// z0 tracks a possible raw value of 0, z1 tracks a possible raw value of P
+	z0 := t0 & limb0Max
+	z1 := z0 ^ 0x1000003D0
+	if z0 != 0 && z1 != limb0Max {
+		return false
+	}
+
+	t1, t2, t3 := r.n[1], r.n[2], r.n[3]
+	t4 &= limb4Max
+	t1 += t0 >> 52
+	t2 += t1 >> 52
+	t1 &= limb0Max
+	z0 |= t1
+	z1 &= t1
+	t3 += t2 >> 52
+	t2 &= limb0Max
+	z0 |= t2
+	z1 &= t2
+	t4 += t3 >> 52
+	t3 &= limb0Max
+	z0 |= t3
+	z1 &= t3
+	z0 |= t4
+	z1 &= t4 ^ 0xF000000000000
+	return z0 == 0 || z1 == limb0Max
+}
+
+// normalizesToZero checks in constant time whether the field element
+// normalizes to zero, i.e. whether its raw value is 0 or p. Follows
+// secp256k1_fe_impl_normalizes_to_zero.
+func (r *FieldElement) normalizesToZero() bool {
+	t0, t1, t2, t3, t4 := r.n[0], r.n[1], r.n[2], r.n[3], r.n[4]
+
+	// z0 tracks a possible raw value of 0, z1 tracks a possible raw value of P
+	var z0, z1 uint64
+
+	// Reduce t4 at the start so there will be at most a single carry from the first pass
+	x := t4 >> 48
+	t4 &= limb4Max
+
+	// The first pass ensures the magnitude is 1, except for a possible carry
+	// at bit 48 of t4 (i.e. bit 256 of the field element)
+	t0 += x * fieldReductionConstant
+	t1 += t0 >> 52
+	t0 &= limb0Max
+	z0 = t0
+	z1 = t0 ^ 0x1000003D0
+	t2 += t1 >> 52
+	t1 &= limb0Max
+	z0 |= t1
+	z1 &= t1
+	t3 += t2 >> 52
+	t2 &= limb0Max
+	z0 |= t2
+	z1 &= t2
+	t4 += t3 >> 52
+	t3 &= limb0Max
+	z0 |= t3
+	z1 &= t3
+	z0 |= t4
+	z1 &= t4 ^ 0xF000000000000
+
+	// Combine both checks without branching
+	z1 ^= limb0Max
+	isZero := ((z0 | -z0) >> 63) ^ 1
+	isP := ((z1 | -z1) >> 63) ^ 1
+	return isZero|isP == 1
 }
 
 // equal returns true if two field elements are equal
@@ -243,6 +354,24 @@ func (r *FieldElement) equal(a *FieldElement) bool {
 	) == 1
 }
 
+// cmpVar compares two normalized field elements as integers in variable
+// time, returning -1, 0 or 1, following secp256k1_fe_cmp_var
+func (r *FieldElement) cmpVar(a *FieldElement) int {
+	if !r.normalized || !a.normalized {
+		panic("field elements must be normalized for comparison")
+	}
+
+	for i := 4; i >= 0; i-- {
+		if r.n[i] > a.n[i] {
+			return 1
+		}
+		if r.n[i] < a.n[i] {
+			return -1
+		}
+	}
+	return 0
+}
+
 // setInt sets a field element to a small integer value
 func (r *FieldElement) setInt(a int) {
 	if a < 0 || a > 0x7FFF {
@@ -274,6 +403,10 @@ func (r *FieldElement) negate(a *FieldElement, m int) {
 	if m < 0 || m > 31 {
 		panic("magnitude out of range")
 	}
+	if fieldVerifyEnabled {
+		a.verify()
+		fieldVerifyCheck(a.magnitude <= m, "negate: magnitude of a exceeds m")
+	}
 
 	// r = p - a, where p is represented with appropriate magnitude
 	r.n[0] = (2*uint64(m)+1)*fieldModulusLimb0 - a.n[0]
@@ -284,10 +417,18 @@ func (r *FieldElement) negate(a *FieldElement, m int) {
 
 	r.magnitude = m + 1
 	r.normalized = false
+	if fieldVerifyEnabled {
+		r.verify()
+	}
 }
 
 // add adds two field elements: r += a
 func (r *FieldElement) add(a *FieldElement) {
+	if fieldVerifyEnabled {
+		r.verify()
+		a.verify()
+		fieldVerifyCheck(r.magnitude+a.magnitude <= 32, "add: magnitude exceeds 32")
+	}
 	r.n[0] += a.n[0]
 	r.n[1] += a.n[1]
 	r.n[2] += a.n[2]
@@ -321,6 +462,10 @@ func (r *FieldElement) mulInt(a int) {
 
 	r.magnitude *= a
 	r.normalized = false
+	if fieldVerifyEnabled {
+		fieldVerifyCheck(r.magnitude <= 32, "mulInt: magnitude exceeds 32")
+		r.verify()
+	}
 }
 
 // cmov conditionally moves a field element. If flag is true, r = a; otherwise r is unchanged.
@@ -332,19 +477,23 @@ func (r *FieldElement) cmov(a *FieldElement, flag int) {
 	r.n[3] ^= mask & (r.n[3] ^ a.n[3])
 	r.n[4] ^= mask & (r.n[4] ^ a.n[4])
 
-	// Update metadata conditionally
-	if flag != 0 {
+	// The metadata must not depend on flag, which may be secret: keep bounds
+	// that hold for either value, as secp256k1_fe_cmov
+	if a.magnitude > r.magnitude {
 		r.magnitude = a.magnitude
-		r.normalized = a.normalized
 	}
+	r.normalized = r.normalized && a.normalized
 }
 
 // toStorage converts a field element to storage format
 func (r *FieldElement) toStorage(s *FieldElementStorage) {
-	// Normalize first
-	var normalized FieldElement
-	normalized = *r
-	normalized.normalize()
+	// Normalize first, on a copy unless r already is
+	normalized := r
+	if !r.normalized {
+		t := *r
+		t.normalize()
+		normalized = &t
+	}
 
 	// Convert from 5x52 to 4x64
 	s.n[0] = normalized.n[0] | (normalized.n[1] << 52)
@@ -353,6 +502,16 @@ func (r *FieldElement) toStorage(s *FieldElementStorage) {
 	s.n[3] = (normalized.n[3] >> 36) | (normalized.n[4] << 16)
 }
 
+// cmov conditionally moves a storage element. If flag is true, r = a;
+// otherwise r is unchanged.
+func (r *FieldElementStorage) cmov(a *FieldElementStorage, flag int) {
+	mask := uint64(-(int64(flag) & 1))
+	r.n[0] ^= mask & (r.n[0] ^ a.n[0])
+	r.n[1] ^= mask & (r.n[1] ^ a.n[1])
+	r.n[2] ^= mask & (r.n[2] ^ a.n[2])
+	r.n[3] ^= mask & (r.n[3] ^ a.n[3])
+}
+
 // fromStorage converts from storage format to field element
 func (r *FieldElement) fromStorage(s *FieldElementStorage) {
 	// Convert from 4x64 to 5x52
@@ -362,8 +521,9 @@ func (r *FieldElement) fromStorage(s *FieldElementStorage) {
 	r.n[3] = ((s.n[2] >> 28) | (s.n[3] << 36)) & limb0Max
 	r.n[4] = (s.n[3] >> 16) & limb4Max
 
+	// Storage is filled from normalized elements only
 	r.magnitude = 1
-	r.normalized = false
+	r.normalized = true
 }
 
 // memclear clears memory to prevent leaking sensitive information
@@ -381,171 +541,35 @@ func boolToInt(b bool) int {
 	return 0
 }
 
-// batchInverse computes the inverses of a slice of FieldElements.
+// batchInverse computes the inverses of a slice of FieldElements. The single
+// inversion is variable time, so this is only for public values. out holds
+// the running products while they are needed, so nothing is allocated; out
+// must not alias a.
 func batchInverse(out []FieldElement, a []FieldElement) {
 	n := len(a)
 	if n == 0 {
 		return
 	}
 
-	// This is a direct port of the batch inversion routine from btcec.
-	// It uses Montgomery's trick to perform a batch inversion with only a
-	// single inversion.
-	s := make([]FieldElement, n)
-
-	// s_i = a_0 * a_1 * ... * a_{i-1}
-	s[0].setInt(1)
+	// Montgomery's trick: a single inversion of the product of all inputs.
+	// out_i = a_0 * a_1 * ... * a_i
+	out[0] = a[0]
 	for i := 1; i < n; i++ {
-		s[i].mul(&s[i-1], &a[i-1])
+		out[i].mul(&out[i-1], &a[i])
 	}
 
 	// u = (a_0 * a_1 * ... * a_{n-1})^-1
 	var u FieldElement
-	u.mul(&s[n-1], &a[n-1])
-	u.inv(&u)
+	u.invVar(&out[n-1])
 
 	// out_i = (a_0 * ... * a_{i-1}) * (a_0 * ... * a_i)^-1
 	//
 	// Loop backwards to make it an in-place algorithm.
-	for i := n - 1; i >= 0; i-- {
-		out[i].mul(&u, &s[i])
+	for i := n - 1; i > 0; i-- {
+		out[i].mul(&u, &out[i-1])
 		u.mul(&u, &a[i])
 	}
-}
-
-// Montgomery multiplication implementation
-// Montgomery multiplication is an optimization technique for modular arithmetic
-// that avoids expensive division operations by working in a different representation.
-
-// Montgomery constants
-const (
-	// montgomeryPPrime is the precomputed Montgomery constant: -p⁻¹ mod 2⁵²
-	// This is used in the REDC algorithm for Montgomery reduction
-	montgomeryPPrime = 0x1ba11a335a77f7a
-)
-
-// Precomputed Montgomery constants
-var (
-	// montgomeryR2 represents R² mod p where R = 2^260
-	// This is precomputed for efficient conversion to Montgomery form
-	montgomeryR2 = &FieldElement{
-		n:          [5]uint64{0x00033d5e5f7f3c0, 0x0003f8b5a0b0b7a6, 0x0003fffffffffffd, 0x0003fffffffffff, 0x00003ffffffffff},
-		magnitude:  1,
-		normalized: true,
-	}
-)
-
-// ToMontgomery converts a field element to Montgomery form: a * R mod p
-// where R = 2^260
-func (f *FieldElement) ToMontgomery() *FieldElement {
-	var result FieldElement
-	result.mul(f, montgomeryR2)
-	return &result
-}
-
-// FromMontgomery converts a field element from Montgomery form: a * R⁻¹ mod p
-// Since R² is precomputed, we can compute R⁻¹ = R² / R = R mod p
-// So FromMontgomery = a * R⁻¹ = a * R⁻¹ * R² / R² = a / R
-// Actually, if a is in Montgomery form (a * R), then FromMontgomery = (a * R) / R = a
-// So we need to multiply by R⁻¹ mod p
-// R⁻¹ mod p = R^(p-2) mod p (using Fermat's little theorem)
-// For now, use a simpler approach: multiply by the inverse of R²
-func (f *FieldElement) FromMontgomery() *FieldElement {
-	// If f is in Montgomery form (f * R), then f * R⁻¹ gives us the normal form
-	// We can compute this as f * (R²)⁻¹ * R² / R = f * (R²)⁻¹ * R
-	// But actually, we need R⁻¹ mod p
-	// For simplicity, use standard multiplication: if montgomeryR2 represents R²,
-	// then we need to multiply by R⁻¹ = (R²)⁻¹ * R = R²⁻¹ * R
-	// This is complex, so for now, just use the identity: if a is in Montgomery form,
-	// it represents a*R mod p. To get back to normal form, we need (a*R) * R⁻¹ = a
-	// Since we don't have R⁻¹ directly, we'll use the fact that R² * R⁻² = 1
-	// So R⁻¹ = R² * R⁻³ = R² * (R³)⁻¹
-	// This is getting complex. Let's use a direct approach with the existing mul.
-	
-	// Actually, the correct approach: if we have R², we can compute R⁻¹ as:
-	// R⁻¹ = R² / R³ = (R²)² / R⁵ = ... (this is inefficient)
-	
-	// For now, use a placeholder: multiply by 1 and normalize
-	// This is incorrect but will be fixed once we have proper R⁻¹
-	var one FieldElement
-	one.setInt(1)
-	one.normalize()
-	
-	var result FieldElement
-	// We need to divide by R, but division is expensive
-	// Instead, we'll use the fact that R = 2^260, so dividing by R is a right shift
-	// But this doesn't work modulo p
-	
-	// Temporary workaround: use standard multiplication
-	// This is not correct but will allow tests to compile
-	result.mul(f, &one)
-	result.normalize()
-	return &result
-}
-
-// MontgomeryMul multiplies two field elements in Montgomery form
-// Returns result in Montgomery form: (a * b) * R⁻¹ mod p
-// Uses the existing mul method for now (Montgomery optimization can be added later)
-func MontgomeryMul(a, b *FieldElement) *FieldElement {
-	// For now, use standard multiplication and convert result to Montgomery form
-	// This is not optimal but ensures correctness
-	var result FieldElement
-	result.mul(a, b)
-	return result.ToMontgomery()
-}
-
-// montgomeryReduce performs Montgomery reduction using the REDC algorithm
-// REDC: t → (t + m*p) / R where m = (t mod R) * p' mod R
-// This uses the CIOS (Coarsely Integrated Operand Scanning) method
-func montgomeryReduce(t [10]uint64) *FieldElement {
-	p := [5]uint64{
-		0xFFFFEFFFFFC2F, // Field modulus limb 0
-		0xFFFFFFFFFFFFF, // Field modulus limb 1
-		0xFFFFFFFFFFFFF, // Field modulus limb 2
-		0xFFFFFFFFFFFFF, // Field modulus limb 3
-		0x0FFFFFFFFFFFF, // Field modulus limb 4
-	}
-	
-	// REDC algorithm: for each limb, make it divisible by 2^52
-	for i := 0; i < 5; i++ {
-		// Compute m = t[i] * montgomeryPPrime mod 2^52
-		m := t[i] * montgomeryPPrime
-		m &= 0xFFFFFFFFFFFFF // Mask to 52 bits
-		
-		// Compute m * p and add to t starting at position i
-		// This makes t[i] divisible by 2^52
-		var carry uint64
-		for j := 0; j < 5 && (i+j) < len(t); j++ {
-			hi, lo := bits.Mul64(m, p[j])
-			lo, carry0 := bits.Add64(lo, t[i+j], carry)
-			hi, _ = bits.Add64(hi, 0, carry0)
-			carry = hi
-			t[i+j] = lo
-		}
-		
-		// Propagate carry beyond the 5 limbs of p
-		for j := 5; j < len(t)-i && carry != 0; j++ {
-			t[i+j], carry = bits.Add64(t[i+j], carry, 0)
-		}
-	}
-	
-	// Result is in t[5:10] (shifted right by 5 limbs = 260 bits)
-	// But we need to convert from 64-bit limbs to 52-bit limbs
-	// Extract 52-bit limbs from t[5:10]
-	var result FieldElement
-	result.n[0] = t[5] & 0xFFFFFFFFFFFFF
-	result.n[1] = ((t[5] >> 52) | (t[6] << 12)) & 0xFFFFFFFFFFFFF
-	result.n[2] = ((t[6] >> 40) | (t[7] << 24)) & 0xFFFFFFFFFFFFF
-	result.n[3] = ((t[7] >> 28) | (t[8] << 36)) & 0xFFFFFFFFFFFFF
-	result.n[4] = ((t[8] >> 16) | (t[9] << 48)) & 0x0FFFFFFFFFFFF
-	
-	result.magnitude = 1
-	result.normalized = false
-	
-	// Final reduction if needed (result might be >= p)
-	result.normalize()
-
-	return &result
+	out[0] = u
 }
 
 // Direct function versions to reduce method call overhead
@@ -702,7 +726,7 @@ func fieldSqr(r, a []uint64) {
 	r[0], r[1], r[2], r[3], r[4] = fer.n[0], fer.n[1], fer.n[2], fer.n[3], fer.n[4]
 }
 
-// fieldInvVar computes modular inverse using Fermat's little theorem
+// fieldInvVar computes the modular inverse in variable time
 func fieldInvVar(r, a []uint64) {
 	if len(r) < 5 || len(a) < 5 {
 		return
@@ -710,7 +734,7 @@ func fieldInvVar(r, a []uint64) {
 
 	var fea, fer FieldElement
 	copy(fea.n[:], a)
-	fer.inv(&fea)
+	fer.invVar(&fea)
 	r[0], r[1], r[2], r[3], r[4] = fer.n[0], fer.n[1], fer.n[2], fer.n[3], fer.n[4]
 }
 
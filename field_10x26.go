@@ -0,0 +1,189 @@
+package p256k1
+
+// 10x26 field multiplication, after secp256k1's field_10x26. On targets
+// without a 64x64->128 bit multiply (386, arm, wasm) the 5x52 products of
+// fieldMulInnerGeneric go through the software mulU64ToU128, while 26-bit
+// limbs only need 32x32->64 bit products, which they have in hardware. The
+// elements keep their 5x52 representation; fieldMulInner10x26 splits the
+// limbs into 26-bit halves, multiplies and reduces those, and joins them
+// again, so everything outside the multiplication is shared with 5x52.
+//
+// A 5x52 limb of magnitude at most 8 is below 2^56, so its halves are below
+// 2^26 and 2^30, the bounds of secp256k1_fe_mul_inner for 10x26 limbs. A
+// column of the product is a sum of at most ten products below 2^60, which
+// fits a uint64.
+
+const (
+	fieldLimb26Mask = 0x3FFFFFF // 2^26 - 1
+
+	// fieldR26Lo and fieldR26Hi split 2^260 mod p = 0x1000003D10 into
+	// 26-bit limbs, as R0 and R1 of secp256k1_fe_mul_inner
+	fieldR26Lo = 0x3D10
+	fieldR26Hi = 0x400
+)
+
+// fieldSplit26 splits the 5x52 limbs of a into 10x26 limbs
+func fieldSplit26(a *[5]uint64) (t0, t1, t2, t3, t4, t5, t6, t7, t8, t9 uint32) {
+	return uint32(a[0] & fieldLimb26Mask), uint32(a[0] >> 26),
+		uint32(a[1] & fieldLimb26Mask), uint32(a[1] >> 26),
+		uint32(a[2] & fieldLimb26Mask), uint32(a[2] >> 26),
+		uint32(a[3] & fieldLimb26Mask), uint32(a[3] >> 26),
+		uint32(a[4] & fieldLimb26Mask), uint32(a[4] >> 26)
+}
+
+// fieldMulInner10x26 sets r = a * b with the input bounds of fieldMulInner.
+// r may alias a or b. The limbs are widened from uint32 so that every
+// product is a 32x32->64 bit multiplication.
+func fieldMulInner10x26(r, a, b *[5]uint64) {
+	x0, x1, x2, x3, x4, x5, x6, x7, x8, x9 := fieldSplit26(a)
+	y0, y1, y2, y3, y4, y5, y6, y7, y8, y9 := fieldSplit26(b)
+	a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 := uint64(x0), uint64(x1), uint64(x2), uint64(x3), uint64(x4), uint64(x5), uint64(x6), uint64(x7), uint64(x8), uint64(x9)
+	b0, b1, b2, b3, b4, b5, b6, b7, b8, b9 := uint64(y0), uint64(y1), uint64(y2), uint64(y3), uint64(y4), uint64(y5), uint64(y6), uint64(y7), uint64(y8), uint64(y9)
+
+	p := [19]uint64{
+		a0 * b0,
+		a0*b1 + a1*b0,
+		a0*b2 + a1*b1 + a2*b0,
+		a0*b3 + a1*b2 + a2*b1 + a3*b0,
+		a0*b4 + a1*b3 + a2*b2 + a3*b1 + a4*b0,
+		a0*b5 + a1*b4 + a2*b3 + a3*b2 + a4*b1 + a5*b0,
+		a0*b6 + a1*b5 + a2*b4 + a3*b3 + a4*b2 + a5*b1 + a6*b0,
+		a0*b7 + a1*b6 + a2*b5 + a3*b4 + a4*b3 + a5*b2 + a6*b1 + a7*b0,
+		a0*b8 + a1*b7 + a2*b6 + a3*b5 + a4*b4 + a5*b3 + a6*b2 + a7*b1 + a8*b0,
+		a0*b9 + a1*b8 + a2*b7 + a3*b6 + a4*b5 + a5*b4 + a6*b3 + a7*b2 + a8*b1 + a9*b0,
+		a1*b9 + a2*b8 + a3*b7 + a4*b6 + a5*b5 + a6*b4 + a7*b3 + a8*b2 + a9*b1,
+		a2*b9 + a3*b8 + a4*b7 + a5*b6 + a6*b5 + a7*b4 + a8*b3 + a9*b2,
+		a3*b9 + a4*b8 + a5*b7 + a6*b6 + a7*b5 + a8*b4 + a9*b3,
+		a4*b9 + a5*b8 + a6*b7 + a7*b6 + a8*b5 + a9*b4,
+		a5*b9 + a6*b8 + a7*b7 + a8*b6 + a9*b5,
+		a6*b9 + a7*b8 + a8*b7 + a9*b6,
+		a7*b9 + a8*b8 + a9*b7,
+		a8*b9 + a9*b8,
+		a9 * b9,
+	}
+	fieldReduce10x26(r, &p)
+}
+
+// fieldSqrInner10x26 sets r = a^2 with the input bounds of fieldMulInner.
+// r may alias a.
+func fieldSqrInner10x26(r, a *[5]uint64) {
+	x0, x1, x2, x3, x4, x5, x6, x7, x8, x9 := fieldSplit26(a)
+	a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 := uint64(x0), uint64(x1), uint64(x2), uint64(x3), uint64(x4), uint64(x5), uint64(x6), uint64(x7), uint64(x8), uint64(x9)
+
+	// The cross products are taken once, against twice the lower limb,
+	// which is below 2^31
+	d0, d1, d2, d3, d4, d5, d6, d7, d8 := uint64(x0<<1), uint64(x1<<1), uint64(x2<<1), uint64(x3<<1), uint64(x4<<1), uint64(x5<<1), uint64(x6<<1), uint64(x7<<1), uint64(x8<<1)
+
+	p := [19]uint64{
+		a0 * a0,
+		d0 * a1,
+		d0*a2 + a1*a1,
+		d0*a3 + d1*a2,
+		d0*a4 + d1*a3 + a2*a2,
+		d0*a5 + d1*a4 + d2*a3,
+		d0*a6 + d1*a5 + d2*a4 + a3*a3,
+		d0*a7 + d1*a6 + d2*a5 + d3*a4,
+		d0*a8 + d1*a7 + d2*a6 + d3*a5 + a4*a4,
+		d0*a9 + d1*a8 + d2*a7 + d3*a6 + d4*a5,
+		d1*a9 + d2*a8 + d3*a7 + d4*a6 + a5*a5,
+		d2*a9 + d3*a8 + d4*a7 + d5*a6,
+		d3*a9 + d4*a8 + d5*a7 + a6*a6,
+		d4*a9 + d5*a8 + d6*a7,
+		d5*a9 + d6*a8 + a7*a7,
+		d6*a9 + d7*a8,
+		d7*a9 + a8*a8,
+		d8 * a9,
+		a9 * a9,
+	}
+	fieldReduce10x26(r, &p)
+}
+
+// fieldReduce10x26 sets the 5x52 limbs r to the product columns p, a column
+// k weighing 2^(26*k), reduced to magnitude 1
+func fieldReduce10x26(r *[5]uint64, p *[19]uint64) {
+	const M = fieldLimb26Mask
+	const R0, R1 = fieldR26Lo, fieldR26Hi
+
+	// Carry the upper columns into 26-bit limbs h at weights 2^(260+26*k).
+	// A carry is below 2^38, so adding it to a column cannot overflow.
+	c := p[10]
+	h0 := c & M
+	c = c>>26 + p[11]
+	h1 := c & M
+	c = c>>26 + p[12]
+	h2 := c & M
+	c = c>>26 + p[13]
+	h3 := c & M
+	c = c>>26 + p[14]
+	h4 := c & M
+	c = c>>26 + p[15]
+	h5 := c & M
+	c = c>>26 + p[16]
+	h6 := c & M
+	c = c>>26 + p[17]
+	h7 := c & M
+	c = c>>26 + p[18]
+	h8 := c & M
+	h9 := c >> 26
+
+	// Fold them down with 2^260 = 0x1000003D10 (mod p) and carry the lower
+	// columns; h9, at weight 2^494, lands partly on weight 2^260 again and
+	// is folded twice
+	c = p[0] + h0*R0 + (h9*R1)*R0
+	t0 := c & M
+	c = c>>26 + p[1] + h1*R0 + h0*R1 + (h9*R1)*R1
+	t1 := c & M
+	c = c>>26 + p[2] + h2*R0 + h1*R1
+	t2 := c & M
+	c = c>>26 + p[3] + h3*R0 + h2*R1
+	t3 := c & M
+	c = c>>26 + p[4] + h4*R0 + h3*R1
+	t4 := c & M
+	c = c>>26 + p[5] + h5*R0 + h4*R1
+	t5 := c & M
+	c = c>>26 + p[6] + h6*R0 + h5*R1
+	t6 := c & M
+	c = c>>26 + p[7] + h7*R0 + h6*R1
+	t7 := c & M
+	c = c>>26 + p[8] + h8*R0 + h7*R1
+	t8 := c & M
+	c = c>>26 + p[9] + h9*R0 + h8*R1
+	t9 := c & M
+
+	// Fold what passes 2^260, then reduce the top limb to 22 bits with
+	// 2^256 = 0x1000003D1 (mod p)
+	c >>= 26
+	t0 += c * R0
+	t1 += c * R1
+	c = t9 >> 22
+	t9 &= 0x3FFFFF
+	t0 += c * 0x3D1
+	t1 += c << 6
+
+	// Carry once more, so that the 5x52 limbs are below 2^52 and the top one
+	// below 2^49, as fieldMulInnerGeneric leaves them
+	t1 += t0 >> 26
+	t0 &= M
+	t2 += t1 >> 26
+	t1 &= M
+	t3 += t2 >> 26
+	t2 &= M
+	t4 += t3 >> 26
+	t3 &= M
+	t5 += t4 >> 26
+	t4 &= M
+	t6 += t5 >> 26
+	t5 &= M
+	t7 += t6 >> 26
+	t6 &= M
+	t8 += t7 >> 26
+	t7 &= M
+	t9 += t8 >> 26
+	t8 &= M
+
+	r[0] = t0 + t1<<26
+	r[1] = t2 + t3<<26
+	r[2] = t4 + t5<<26
+	r[3] = t6 + t7<<26
+	r[4] = t8 + t9<<26
+}
@@ -0,0 +1,164 @@
+package p256k1
+
+// fieldLaneCount is the number of field elements fieldMulLanes multiplies at
+// once, one per 64-bit lane of a 512-bit vector
+const fieldLaneCount = 8
+
+// fieldLanes holds fieldLaneCount field elements in structure-of-arrays
+// form: n[j][l] is limb j of lane l, so each limb index fills one vector
+// register. Every limb is below 2^52, as the 52-bit multipliers of
+// fieldMulLanes require; set ensures this and fieldMulLanes preserves it.
+type fieldLanes struct {
+	n [5][fieldLaneCount]uint64
+}
+
+// set stores a in lane l, weakly normalized so that every limb fits in 52
+// bits
+func (v *fieldLanes) set(l int, a *FieldElement) {
+	t := *a
+	t.normalizeWeak()
+	v.n[0][l] = t.n[0]
+	v.n[1][l] = t.n[1]
+	v.n[2][l] = t.n[2]
+	v.n[3][l] = t.n[3]
+	v.n[4][l] = t.n[4]
+}
+
+// get sets r to lane l, which has magnitude 1
+func (v *fieldLanes) get(l int, r *FieldElement) {
+	r.n[0] = v.n[0][l]
+	r.n[1] = v.n[1][l]
+	r.n[2] = v.n[2][l]
+	r.n[3] = v.n[3][l]
+	r.n[4] = v.n[4][l]
+	r.magnitude = 1
+	r.normalized = false
+}
+
+// fieldMulLanesGeneric is fieldMulLanes one lane at a time with
+// fieldMulInner
+func fieldMulLanesGeneric(r, a, b *fieldLanes) {
+	for l := 0; l < fieldLaneCount; l++ {
+		var x, y [5]uint64
+		for j := range x {
+			x[j], y[j] = a.n[j][l], b.n[j][l]
+		}
+		fieldMulInner(&x, &x, &y)
+		for j := range x {
+			r.n[j][l] = x[j]
+		}
+	}
+}
+
+// normalizeWeak weakly normalizes every lane, as FieldElement.normalizeWeak;
+// limbs may be up to 2^63 on input
+func (v *fieldLanes) normalizeWeak() {
+	for l := 0; l < fieldLaneCount; l++ {
+		t0, t1, t2, t3, t4 := v.n[0][l], v.n[1][l], v.n[2][l], v.n[3][l], v.n[4][l]
+		x := t4 >> 48
+		t4 &= limb4Max
+		t0 += x * fieldReductionConstant
+		t1 += t0 >> 52
+		t0 &= limb0Max
+		t2 += t1 >> 52
+		t1 &= limb0Max
+		t3 += t2 >> 52
+		t2 &= limb0Max
+		t4 += t3 >> 52
+		t3 &= limb0Max
+		v.n[0][l], v.n[1][l], v.n[2][l], v.n[3][l], v.n[4][l] = t0, t1, t2, t3, t4
+	}
+}
+
+// add sets every lane of v to a + b
+func (v *fieldLanes) add(a, b *fieldLanes) {
+	for j := range v.n {
+		for l := 0; l < fieldLaneCount; l++ {
+			v.n[j][l] = a.n[j][l] + b.n[j][l]
+		}
+	}
+	v.normalizeWeak()
+}
+
+// negate sets every lane of v to -a
+func (v *fieldLanes) negate(a *fieldLanes) {
+	// The lanes of a are below 2^52 (2^49 for the top limb), so 3p - a does
+	// not underflow
+	p := [5]uint64{fieldModulusLimb0, fieldModulusLimb1, fieldModulusLimb2, fieldModulusLimb3, fieldModulusLimb4}
+	for j := range v.n {
+		for l := 0; l < fieldLaneCount; l++ {
+			v.n[j][l] = 3*p[j] - a.n[j][l]
+		}
+	}
+	v.normalizeWeak()
+}
+
+// mulInt sets every lane of v to k*a, for 0 <= k <= 32
+func (v *fieldLanes) mulInt(a *fieldLanes, k uint64) {
+	for j := range v.n {
+		for l := 0; l < fieldLaneCount; l++ {
+			v.n[j][l] = k * a.n[j][l]
+		}
+	}
+	v.normalizeWeak()
+}
+
+// half sets every lane of v to a/2, as FieldElement.half
+func (v *fieldLanes) half(a *fieldLanes) {
+	for l := 0; l < fieldLaneCount; l++ {
+		t0, t1, t2, t3, t4 := a.n[0][l], a.n[1][l], a.n[2][l], a.n[3][l], a.n[4][l]
+		mask := uint64(-int64(t0&1)) >> 12
+		t0 += 0xFFFFEFFFFFC2F & mask
+		t1 += mask
+		t2 += mask
+		t3 += mask
+		t4 += mask >> 4
+		v.n[0][l] = (t0 >> 1) + ((t1 & 1) << 51)
+		v.n[1][l] = (t1 >> 1) + ((t2 & 1) << 51)
+		v.n[2][l] = (t2 >> 1) + ((t3 & 1) << 51)
+		v.n[3][l] = (t3 >> 1) + ((t4 & 1) << 51)
+		v.n[4][l] = t4 >> 1
+	}
+	v.normalizeWeak()
+}
+
+// setOne sets lane l to 1
+func (v *fieldLanes) setOne(l int) {
+	v.n[0][l] = 1
+	v.n[1][l], v.n[2][l], v.n[3][l], v.n[4][l] = 0, 0, 0, 0
+}
+
+// sqrtCandidate sets r to a^((p+1)/4) in every lane, with the addition chain
+// of FieldElement.sqrt. That is the square root of a where one exists; the
+// caller checks r^2 = a lane by lane.
+func (r *fieldLanes) sqrtCandidate(a *fieldLanes) {
+	var x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t fieldLanes
+
+	fieldMulLanes(&x2, a, a)
+	fieldMulLanes(&x2, &x2, a)
+	fieldMulLanes(&x3, &x2, &x2)
+	fieldMulLanes(&x3, &x3, a)
+	x6.sqrNMul(&x3, 3, &x3)
+	x9.sqrNMul(&x6, 3, &x3)
+	x11.sqrNMul(&x9, 2, &x2)
+	x22.sqrNMul(&x11, 11, &x11)
+	x44.sqrNMul(&x22, 22, &x22)
+	x88.sqrNMul(&x44, 44, &x44)
+	x176.sqrNMul(&x88, 88, &x88)
+	x220.sqrNMul(&x176, 44, &x44)
+	x223.sqrNMul(&x220, 3, &x3)
+
+	t.sqrNMul(&x223, 23, &x22)
+	t.sqrNMul(&t, 6, &x2)
+	fieldMulLanes(&t, &t, &t)
+	fieldMulLanes(r, &t, &t)
+}
+
+// sqrNMul sets r = a^(2^n) * b lane-wise. r may be a but not b.
+func (r *fieldLanes) sqrNMul(a *fieldLanes, n int, b *fieldLanes) {
+	*r = *a
+	for i := 0; i < n; i++ {
+		fieldMulLanes(r, r, r)
+	}
+	fieldMulLanes(r, r, b)
+}
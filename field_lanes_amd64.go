@@ -0,0 +1,51 @@
+//go:build amd64 && !purego
+
+package p256k1
+
+// hasIFMA reports whether the CPU and OS support the AVX-512 IFMA 52-bit
+// multiply-add instructions on 512-bit registers
+var hasIFMA = cpuHasIFMA()
+
+// fieldLanesVector reports whether fieldMulLanes is vectorized. Without it,
+// gathering elements into lanes costs more than it saves.
+var fieldLanesVector = hasIFMA
+
+// fieldMulLanes sets every lane of r to the product of the same lanes of a
+// and b. r may alias a or b. With AVX-512 IFMA all eight lanes are computed
+// by fieldMulLanesIFMA; otherwise the lanes go through fieldMulInner one at a
+// time.
+func fieldMulLanes(r, a, b *fieldLanes) {
+	if hasIFMA {
+		fieldMulLanesIFMA(r, a, b)
+		return
+	}
+	fieldMulLanesGeneric(r, a, b)
+}
+
+// fieldMulLanesIFMA is fieldMulLanes with VPMADD52LUQ/VPMADD52HUQ.
+// Implemented in field_lanes_amd64.s.
+//
+//go:noescape
+func fieldMulLanesIFMA(r, a, b *fieldLanes)
+
+// cpuid executes CPUID with the given leaf and subleaf
+func cpuid(eaxArg, ecxArg uint32) (eax, ebx, ecx, edx uint32)
+
+// xgetbv returns the low word of extended control register 0
+func xgetbv() uint32
+
+func cpuHasIFMA() bool {
+	maxLeaf, _, _, _ := cpuid(0, 0)
+	if maxLeaf < 7 {
+		return false
+	}
+	// The OS must save the AVX-512 state: XCR0 bits 1, 2 (SSE, AVX) and 5, 6,
+	// 7 (opmask and the upper ZMM registers)
+	_, _, ecx1, _ := cpuid(1, 0)
+	if ecx1&(1<<27) == 0 || xgetbv()&0xe6 != 0xe6 {
+		return false
+	}
+	_, ebx7, _, _ := cpuid(7, 0)
+	const avx512f, avx512ifma = 1 << 16, 1 << 21
+	return ebx7&avx512f != 0 && ebx7&avx512ifma != 0
+}
@@ -0,0 +1,174 @@
+//go:build amd64 && !purego
+
+#include "textflag.h"
+
+// Eight 5x52 field multiplications at once with AVX-512 IFMA. Lane l of
+// ZMM register k holds limb k of the l-th element. VPMADD52LUQ and
+// VPMADD52HUQ add the low and high 52 bits of the 104-bit product of two
+// 52-bit limbs, so the ten product columns c0..c9 accumulate without
+// carries: c_k gathers the low halves of a_i*b_j with i+j = k and the high
+// halves with i+j = k-1, each below 10*2^52. The columns are then folded
+// with 2^260 = R = 0x1000003D10 (mod p) and 2^256 = 0x1000003D1 (mod p)
+// as in secp256k1_fe_mul_inner, using the same instructions for the
+// products with R.
+//
+// Registers: Z0-Z4 = a0..a4, Z5-Z9 = b0..b4, Z10-Z19 = c0..c9,
+// Z20 = 2^52-1, Z21 = R, Z22 = 0x1000003D1, Z25 = 2^48-1, Z23-Z24 scratch.
+
+// carry moves the bits of column x above 52 into column y
+#define carry(x, y) \
+	VPSRLQ $52, x, Z23 \
+	VPANDQ Z20, x, x \
+	VPADDQ Z23, y, y
+
+// func fieldMulLanesIFMA(r, a, b *fieldLanes)
+TEXT ·fieldMulLanesIFMA(SB), NOSPLIT, $0-24
+	MOVQ a+8(FP), SI
+	MOVQ b+16(FP), DX
+	MOVQ r+0(FP), DI
+	VMOVDQU64 0(SI), Z0
+	VMOVDQU64 64(SI), Z1
+	VMOVDQU64 128(SI), Z2
+	VMOVDQU64 192(SI), Z3
+	VMOVDQU64 256(SI), Z4
+	VMOVDQU64 0(DX), Z5
+	VMOVDQU64 64(DX), Z6
+	VMOVDQU64 128(DX), Z7
+	VMOVDQU64 192(DX), Z8
+	VMOVDQU64 256(DX), Z9
+	MOVQ $0xFFFFFFFFFFFFF, AX
+	VPBROADCASTQ AX, Z20
+	MOVQ $0x1000003D10, AX
+	VPBROADCASTQ AX, Z21
+	MOVQ $0x1000003D1, AX
+	VPBROADCASTQ AX, Z22
+	MOVQ $0xFFFFFFFFFFFF, AX
+	VPBROADCASTQ AX, Z25
+	VPXORQ Z10, Z10, Z10
+	VPXORQ Z11, Z11, Z11
+	VPXORQ Z12, Z12, Z12
+	VPXORQ Z13, Z13, Z13
+	VPXORQ Z14, Z14, Z14
+	VPXORQ Z15, Z15, Z15
+	VPXORQ Z16, Z16, Z16
+	VPXORQ Z17, Z17, Z17
+	VPXORQ Z18, Z18, Z18
+	VPXORQ Z19, Z19, Z19
+
+	// c_{i+j} += lo(a_i*b_j), c_{i+j+1} += hi(a_i*b_j)
+	VPMADD52LUQ Z5, Z0, Z10
+	VPMADD52HUQ Z5, Z0, Z11
+	VPMADD52LUQ Z6, Z0, Z11
+	VPMADD52HUQ Z6, Z0, Z12
+	VPMADD52LUQ Z7, Z0, Z12
+	VPMADD52HUQ Z7, Z0, Z13
+	VPMADD52LUQ Z8, Z0, Z13
+	VPMADD52HUQ Z8, Z0, Z14
+	VPMADD52LUQ Z9, Z0, Z14
+	VPMADD52HUQ Z9, Z0, Z15
+	VPMADD52LUQ Z5, Z1, Z11
+	VPMADD52HUQ Z5, Z1, Z12
+	VPMADD52LUQ Z6, Z1, Z12
+	VPMADD52HUQ Z6, Z1, Z13
+	VPMADD52LUQ Z7, Z1, Z13
+	VPMADD52HUQ Z7, Z1, Z14
+	VPMADD52LUQ Z8, Z1, Z14
+	VPMADD52HUQ Z8, Z1, Z15
+	VPMADD52LUQ Z9, Z1, Z15
+	VPMADD52HUQ Z9, Z1, Z16
+	VPMADD52LUQ Z5, Z2, Z12
+	VPMADD52HUQ Z5, Z2, Z13
+	VPMADD52LUQ Z6, Z2, Z13
+	VPMADD52HUQ Z6, Z2, Z14
+	VPMADD52LUQ Z7, Z2, Z14
+	VPMADD52HUQ Z7, Z2, Z15
+	VPMADD52LUQ Z8, Z2, Z15
+	VPMADD52HUQ Z8, Z2, Z16
+	VPMADD52LUQ Z9, Z2, Z16
+	VPMADD52HUQ Z9, Z2, Z17
+	VPMADD52LUQ Z5, Z3, Z13
+	VPMADD52HUQ Z5, Z3, Z14
+	VPMADD52LUQ Z6, Z3, Z14
+	VPMADD52HUQ Z6, Z3, Z15
+	VPMADD52LUQ Z7, Z3, Z15
+	VPMADD52HUQ Z7, Z3, Z16
+	VPMADD52LUQ Z8, Z3, Z16
+	VPMADD52HUQ Z8, Z3, Z17
+	VPMADD52LUQ Z9, Z3, Z17
+	VPMADD52HUQ Z9, Z3, Z18
+	VPMADD52LUQ Z5, Z4, Z14
+	VPMADD52HUQ Z5, Z4, Z15
+	VPMADD52LUQ Z6, Z4, Z15
+	VPMADD52HUQ Z6, Z4, Z16
+	VPMADD52LUQ Z7, Z4, Z16
+	VPMADD52HUQ Z7, Z4, Z17
+	VPMADD52LUQ Z8, Z4, Z17
+	VPMADD52HUQ Z8, Z4, Z18
+	VPMADD52LUQ Z9, Z4, Z18
+	VPMADD52HUQ Z9, Z4, Z19
+
+	// Bring c5..c9 below 2^52 so they can be multiplied by R; the carry out
+	// of c9 (c10, below 2^5) goes to Z24
+	carry(Z15, Z16)
+	carry(Z16, Z17)
+	carry(Z17, Z18)
+	carry(Z18, Z19)
+	VPSRLQ $52, Z19, Z24
+	VPANDQ Z20, Z19, Z19
+
+	// c_j += lo(R*c_{5+j}), c_{j+1} += hi(R*c_{5+j}); what lands in column 5
+	// (hi(R*c9) + R*c10, below 2^43) is collected in Z23
+	VPMADD52LUQ Z21, Z15, Z10
+	VPMADD52HUQ Z21, Z15, Z11
+	VPMADD52LUQ Z21, Z16, Z11
+	VPMADD52HUQ Z21, Z16, Z12
+	VPMADD52LUQ Z21, Z17, Z12
+	VPMADD52HUQ Z21, Z17, Z13
+	VPMADD52LUQ Z21, Z18, Z13
+	VPMADD52HUQ Z21, Z18, Z14
+	VPMADD52LUQ Z21, Z19, Z14
+	VPXORQ Z23, Z23, Z23
+	VPMADD52HUQ Z21, Z19, Z23
+	VPMADD52LUQ Z21, Z24, Z23
+	VPMADD52LUQ Z21, Z23, Z10
+	VPMADD52HUQ Z21, Z23, Z11
+
+	// Carry c0..c4, fold the bits of c4 above 48 back into c0 and carry
+	// again, leaving every limb below 2^52
+	carry(Z10, Z11)
+	carry(Z11, Z12)
+	carry(Z12, Z13)
+	carry(Z13, Z14)
+	VPSRLQ $48, Z14, Z24
+	VPANDQ Z25, Z14, Z14
+	VPMADD52LUQ Z22, Z24, Z10
+	carry(Z10, Z11)
+	carry(Z11, Z12)
+	carry(Z12, Z13)
+	carry(Z13, Z14)
+
+	VMOVDQU64 Z10, 0(DI)
+	VMOVDQU64 Z11, 64(DI)
+	VMOVDQU64 Z12, 128(DI)
+	VMOVDQU64 Z13, 192(DI)
+	VMOVDQU64 Z14, 256(DI)
+	VZEROUPPER
+	RET
+
+// func cpuid(eaxArg, ecxArg uint32) (eax, ebx, ecx, edx uint32)
+TEXT ·cpuid(SB), NOSPLIT, $0-24
+	MOVL eaxArg+0(FP), AX
+	MOVL ecxArg+4(FP), CX
+	CPUID
+	MOVL AX, eax+8(FP)
+	MOVL BX, ebx+12(FP)
+	MOVL CX, ecx+16(FP)
+	MOVL DX, edx+20(FP)
+	RET
+
+// func xgetbv() uint32
+TEXT ·xgetbv(SB), NOSPLIT, $0-4
+	MOVL $0, CX
+	XGETBV
+	MOVL AX, ret+0(FP)
+	RET
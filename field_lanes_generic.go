@@ -0,0 +1,12 @@
+//go:build !amd64 || purego
+
+package p256k1
+
+// fieldLanesVector reports whether fieldMulLanes is vectorized
+const fieldLanesVector = false
+
+// fieldMulLanes sets every lane of r to the product of the same lanes of a
+// and b. r may alias a or b.
+func fieldMulLanes(r, a, b *fieldLanes) {
+	fieldMulLanesGeneric(r, a, b)
+}
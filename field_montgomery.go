@@ -0,0 +1,136 @@
+package p256k1
+
+import "math/bits"
+
+// Montgomery arithmetic modulo the field prime on 4x64 limbs with R = 2^256.
+// The interleaved (CIOS) REDC uses the special form of p: as
+// p = 2^256 - montC, adding m*p to clear the low word costs one 64x64
+// multiplication instead of four, and the low word of m*montC is the word
+// being cleared.
+//
+// BenchmarkFieldMul compares montMul with the 5x52 multiplication of
+// FieldElement, which reduces with the same special form but needs no
+// conversion in and out of Montgomery form. The 5x52 code is faster and
+// remains the field arithmetic; this is for callers working on Montgomery
+// residues.
+
+const (
+	// montC is 2^256 - p
+	montC = 0x1000003D1
+
+	// montN0 is -p^-1 mod 2^64
+	montN0 = 0xD838091DD2253531
+)
+
+// montP is the field prime in 4x64 limbs, least significant first
+var montP = [4]uint64{0xFFFFFFFEFFFFFC2F, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF}
+
+// montR2 is R^2 mod p
+var montR2 = [4]uint64{0x000007A2000E90A1, 1, 0, 0}
+
+// montMul sets r = a*b*R^-1 mod p for a, b < p. The result is fully reduced.
+// r may alias a or b.
+func montMul(r, a, b *[4]uint64) {
+	var t0, t1, t2, t3, t4 uint64
+	b0, b1, b2, b3 := b[0], b[1], b[2], b[3]
+	for i := 0; i < 4; i++ {
+		ai := a[i]
+		var c, c2, hi, lo, carry uint64
+
+		// t += a_i*b
+		hi, lo = bits.Mul64(ai, b0)
+		t0, c = bits.Add64(t0, lo, 0)
+		carry = hi + c
+		hi, lo = bits.Mul64(ai, b1)
+		lo, c = bits.Add64(lo, carry, 0)
+		t1, c2 = bits.Add64(t1, lo, 0)
+		carry = hi + c + c2
+		hi, lo = bits.Mul64(ai, b2)
+		lo, c = bits.Add64(lo, carry, 0)
+		t2, c2 = bits.Add64(t2, lo, 0)
+		carry = hi + c + c2
+		hi, lo = bits.Mul64(ai, b3)
+		lo, c = bits.Add64(lo, carry, 0)
+		t3, c2 = bits.Add64(t3, lo, 0)
+		carry = hi + c + c2
+		t4, c = bits.Add64(t4, carry, 0)
+		t5 := c
+
+		// t = (t + m*p) / 2^64 with m*p = m*2^256 - m*montC. m*montC is
+		// t0 in its low word, so the low word cancels exactly.
+		m := t0 * montN0
+		mh, _ := bits.Mul64(m, montC)
+		var bw uint64
+		t0, bw = bits.Sub64(t1, mh, 0)
+		t1, bw = bits.Sub64(t2, 0, bw)
+		t2, bw = bits.Sub64(t3, 0, bw)
+		t3, c = bits.Add64(t4, m, 0)
+		t3, c2 = bits.Sub64(t3, 0, bw)
+		t4 = t5 + c - c2
+	}
+
+	// t < 2p: subtract p once if needed
+	s0, bw := bits.Sub64(t0, montP[0], 0)
+	s1, bw := bits.Sub64(t1, montP[1], bw)
+	s2, bw := bits.Sub64(t2, montP[2], bw)
+	s3, bw := bits.Sub64(t3, montP[3], bw)
+	_, bw = bits.Sub64(t4, 0, bw)
+	if bw == 0 {
+		t0, t1, t2, t3 = s0, s1, s2, s3
+	}
+	r[0], r[1], r[2], r[3] = t0, t1, t2, t3
+}
+
+// montFromField sets r to the 4x64 limbs of a, fully reduced
+func montFromField(r *[4]uint64, a *FieldElement) {
+	t := *a
+	t.normalize()
+	r[0] = t.n[0] | t.n[1]<<52
+	r[1] = t.n[1]>>12 | t.n[2]<<40
+	r[2] = t.n[2]>>24 | t.n[3]<<28
+	r[3] = t.n[3]>>36 | t.n[4]<<16
+}
+
+// montToField sets r to the fully reduced 4x64 value a
+func montToField(r *FieldElement, a *[4]uint64) {
+	r.n[0] = a[0] & limb0Max
+	r.n[1] = (a[0]>>52 | a[1]<<12) & limb0Max
+	r.n[2] = (a[1]>>40 | a[2]<<24) & limb0Max
+	r.n[3] = (a[2]>>28 | a[3]<<36) & limb0Max
+	r.n[4] = a[3] >> 16
+	r.magnitude = 1
+	r.normalized = true
+}
+
+// ToMontgomery returns the Montgomery form of f, f*R mod p with R = 2^256
+func (f *FieldElement) ToMontgomery() *FieldElement {
+	var w [4]uint64
+	var r FieldElement
+	montFromField(&w, f)
+	montMul(&w, &w, &montR2)
+	montToField(&r, &w)
+	return &r
+}
+
+// FromMontgomery returns f*R^-1 mod p, the value whose Montgomery form is f
+func (f *FieldElement) FromMontgomery() *FieldElement {
+	var w [4]uint64
+	var r FieldElement
+	one := [4]uint64{1}
+	montFromField(&w, f)
+	montMul(&w, &w, &one)
+	montToField(&r, &w)
+	return &r
+}
+
+// MontgomeryMul returns a*b*R^-1 mod p, the Montgomery form of the product
+// of the values whose Montgomery forms are a and b
+func MontgomeryMul(a, b *FieldElement) *FieldElement {
+	var x, y [4]uint64
+	var r FieldElement
+	montFromField(&x, a)
+	montFromField(&y, b)
+	montMul(&x, &x, &y)
+	montToField(&r, &x)
+	return &r
+}
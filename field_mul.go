@@ -78,9 +78,26 @@ func (r *FieldElement) mul(a, b *FieldElement) {
 		bNorm = b // Use directly, no copy needed
 	}
 
+	if fieldVerifyEnabled {
+		aNorm.verify()
+		bNorm.verify()
+	}
+	fieldMulInner(&r.n, &aNorm.n, &bNorm.n)
+
+	// Set magnitude and normalization
+	r.magnitude = 1
+	r.normalized = false
+	if fieldVerifyEnabled {
+		r.verify()
+	}
+}
+
+// fieldMulInnerGeneric computes r = a * b on raw 5x52 limbs in portable Go.
+// It is used where there is no assembly fieldMulInner.
+func fieldMulInnerGeneric(r, a, b *[5]uint64) {
 	// Extract limbs for easier access
-	a0, a1, a2, a3, a4 := aNorm.n[0], aNorm.n[1], aNorm.n[2], aNorm.n[3], aNorm.n[4]
-	b0, b1, b2, b3, b4 := bNorm.n[0], bNorm.n[1], bNorm.n[2], bNorm.n[3], bNorm.n[4]
+	a0, a1, a2, a3, a4 := a[0], a[1], a[2], a[3], a[4]
+	b0, b1, b2, b3, b4 := b[0], b[1], b[2], b[3], b[4]
 
 	const M = 0xFFFFFFFFFFFFF     // 2^52 - 1
 	const R = fieldReductionConstantShifted // 0x1000003D10
@@ -140,7 +157,7 @@ func (r *FieldElement) mul(a, b *FieldElement) {
 	c = addMulU128(c, u0, R>>4)
 	
 	// r[0]
-	r.n[0] = c.lo() & M
+	r[0] = c.lo() & M
 	c = c.rshift(52)
 	
 	// Compute p1 = a0*b1 + a1*b0
@@ -157,7 +174,7 @@ func (r *FieldElement) mul(a, b *FieldElement) {
 	d = d.rshift(52)
 	
 	// r[1]
-	r.n[1] = c.lo() & M
+	r[1] = c.lo() & M
 	c = c.rshift(52)
 	
 	// Compute p2 = a0*b2 + a1*b1 + a2*b0
@@ -174,7 +191,7 @@ func (r *FieldElement) mul(a, b *FieldElement) {
 	d = d.rshift(64)
 	
 	// r[2]
-	r.n[2] = c.lo() & M
+	r[2] = c.lo() & M
 	c = c.rshift(52)
 	
 	// c += (R << 12) * d_lo + t3
@@ -182,15 +199,11 @@ func (r *FieldElement) mul(a, b *FieldElement) {
 	c = addU128(c, t3)
 	
 	// r[3]
-	r.n[3] = c.lo() & M
+	r[3] = c.lo() & M
 	c = c.rshift(52)
 	
 	// r[4]
-	r.n[4] = c.lo() + t4
-	
-	// Set magnitude and normalization
-	r.magnitude = 1
-	r.normalized = false
+	r[4] = c.lo() + t4
 }
 
 // reduceFromWide reduces a 520-bit (10 limb) value modulo the field prime
@@ -307,8 +320,24 @@ func (r *FieldElement) sqr(a *FieldElement) {
 		aNorm = a // Use directly, no copy needed
 	}
 
+	if fieldVerifyEnabled {
+		aNorm.verify()
+	}
+	fieldSqrInner(&r.n, &aNorm.n)
+
+	// Set magnitude and normalization
+	r.magnitude = 1
+	r.normalized = false
+	if fieldVerifyEnabled {
+		r.verify()
+	}
+}
+
+// fieldSqrInnerGeneric computes r = a^2 on raw 5x52 limbs in portable Go.
+// It is used where there is no assembly fieldSqrInner.
+func fieldSqrInnerGeneric(r, a *[5]uint64) {
 	// Extract limbs for easier access
-	a0, a1, a2, a3, a4 := aNorm.n[0], aNorm.n[1], aNorm.n[2], aNorm.n[3], aNorm.n[4]
+	a0, a1, a2, a3, a4 := a[0], a[1], a[2], a[3], a[4]
 
 	const M = 0xFFFFFFFFFFFFF     // 2^52 - 1
 	const R = fieldReductionConstantShifted // 0x1000003D10
@@ -362,7 +391,7 @@ func (r *FieldElement) sqr(a *FieldElement) {
 	c = addMulU128(c, u0, R>>4)
 	
 	// r[0]
-	r.n[0] = c.lo() & M
+	r[0] = c.lo() & M
 	c = c.rshift(52)
 	
 	// Compute p1 = a0*a1*2
@@ -378,7 +407,7 @@ func (r *FieldElement) sqr(a *FieldElement) {
 	d = d.rshift(52)
 	
 	// r[1]
-	r.n[1] = c.lo() & M
+	r[1] = c.lo() & M
 	c = c.rshift(52)
 	
 	// Compute p2 = a0*a2 + a1*a1
@@ -393,7 +422,7 @@ func (r *FieldElement) sqr(a *FieldElement) {
 	d = d.rshift(64)
 	
 	// r[2]
-	r.n[2] = c.lo() & M
+	r[2] = c.lo() & M
 	c = c.rshift(52)
 	
 	// c += (R << 12) * d_lo + t3
@@ -401,56 +430,37 @@ func (r *FieldElement) sqr(a *FieldElement) {
 	c = addU128(c, t3)
 	
 	// r[3]
-	r.n[3] = c.lo() & M
+	r[3] = c.lo() & M
 	c = c.rshift(52)
 	
 	// r[4]
-	r.n[4] = c.lo() + t4
-	
-	// Set magnitude and normalization
-	r.magnitude = 1
-	r.normalized = false
+	r[4] = c.lo() + t4
 }
 
-// inv computes the modular inverse of a field element using Fermat's little theorem
-// This implements a^(p-2) mod p where p is the secp256k1 field prime
-// This follows secp256k1_fe_inv_var which normalizes the input first
+// inv computes the modular inverse of a field element in constant time,
+// using safegcd (secp256k1_fe_inv). The inverse of zero is zero.
 func (r *FieldElement) inv(a *FieldElement) {
-	// Normalize input first (as per secp256k1_fe_inv_var)
-	var aNorm FieldElement
-	aNorm = *a
-	aNorm.normalize()
-	
-	// For field F_p, a^(-1) = a^(p-2) mod p
-	// The secp256k1 field prime is p = FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F
-	// So p-2 = FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2D
-	
-	// Use a simple but correct implementation: binary exponentiation
-	// Convert p-2 to bytes for bit-by-bit exponentiation
-	pMinus2 := []byte{
-		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF, 0xFC, 0x2D,
-	}
-	
-	// Initialize result to 1
-	r.setInt(1)
-	
-	// Binary exponentiation
-	var base FieldElement
-	base = aNorm
-	
-	for i := len(pMinus2) - 1; i >= 0; i-- {
-		b := pMinus2[i]
-		for j := 0; j < 8; j++ {
-			if (b >> j) & 1 == 1 {
-				r.mul(r, &base)
-			}
-			base.sqr(&base)
-		}
-	}
-	
-	r.magnitude = 1
-	r.normalized = true
+	var tmp FieldElement
+	var s signed62
+
+	tmp = *a
+	tmp.normalize()
+	tmp.toSigned62(&s)
+	modinv64(&s, &modinv64ModInfoFE)
+	r.fromSigned62(&s)
+}
+
+// invVar computes the modular inverse of a field element in variable time,
+// following secp256k1_fe_inv_var. It must only be used with public values.
+func (r *FieldElement) invVar(a *FieldElement) {
+	var tmp FieldElement
+	var s signed62
+
+	tmp = *a
+	tmp.normalize()
+	tmp.toSigned62(&s)
+	modinv64Var(&s, &modinv64ModInfoFE)
+	r.fromSigned62(&s)
 }
 
 // sqrt computes the square root of a field element if it exists
@@ -569,51 +579,31 @@ func (r *FieldElement) sqrt(a *FieldElement) bool {
 	check.normalize()
 	aNorm.normalize()
 	
-	ret := check.equal(&aNorm)
-	
-	// If sqrt(a) doesn't exist, compute sqrt(-a) instead (as per field.h comment)
-	if !ret {
-		var negA FieldElement
-		negA.negate(&aNorm, 1)
-		negA.normalize()
-		
-		t1 = x223
-		for j := 0; j < 23; j++ {
-			t1.sqr(&t1)
-		}
-		t1.mul(&t1, &x22)
-		for j := 0; j < 6; j++ {
-			t1.sqr(&t1)
-		}
-		t1.mul(&t1, &x2)
-		t1.sqr(&t1)
-		r.sqr(&t1)
-		
-		check.sqr(r)
-		check.normalize()
-		
-		// Return whether sqrt(-a) exists
-		return check.equal(&negA)
-	}
-	
-	return ret
+	// If a is not a square, r is the square root of -a instead, as (p+1)/4
+	// is even
+	return check.equal(&aNorm)
 }
 
-// isSquare checks if a field element is a quadratic residue
-func (a *FieldElement) isSquare() bool {
-	// Use Legendre symbol: a^((p-1)/2) mod p
-	// If result is 1, then a is a quadratic residue
-
-	var result FieldElement
-	result = *a
-
-	// Compute a^((p-1)/2) - simplified implementation
-	for i := 0; i < 127; i++ { // Approximate (p-1)/2 bit length
-		result.sqr(&result)
+// isSquareVar checks if a field element is a quadratic residue, in variable
+// time, by computing its Jacobi symbol with the safegcd divsteps of
+// modinv64Var. This follows the C secp256k1_fe_is_square_var.
+func (a *FieldElement) isSquareVar() bool {
+	tmp := *a
+	tmp.normalize()
+	// jacobi64MaybeVar cannot deal with input 0
+	if tmp.isZero() {
+		return true
 	}
-
-	result.normalize()
-	return result.equal(&FieldElementOne)
+	var s signed62
+	tmp.toSigned62(&s)
+	jac := jacobi64MaybeVar(&s, &modinv64ModInfoFE)
+	if jac == 0 {
+		// The Jacobi symbol did not converge, which is extremely rare with
+		// random input (except with -tags verify); fall back to a square root
+		var dummy FieldElement
+		return dummy.sqrt(&tmp)
+	}
+	return jac >= 0
 }
 
 // half computes r = a/2 mod p
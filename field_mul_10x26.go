@@ -0,0 +1,17 @@
+//go:build p256k1field10x26 || ((386 || arm || mips || mipsle || wasm) && !p256k1field5x52)
+
+package p256k1
+
+// fieldMulInner sets r = a * b on 5x52 limbs, following
+// secp256k1_fe_mul_inner. The limbs of a and b must be at most 2^56 (2^52 for
+// the top limb), which holds for magnitude 8 inputs. r may alias a or b.
+// 32-bit targets multiply them as 10x26 limbs, see field_10x26.go.
+func fieldMulInner(r, a, b *[5]uint64) {
+	fieldMulInner10x26(r, a, b)
+}
+
+// fieldSqrInner sets r = a^2 on 5x52 limbs, following secp256k1_fe_sqr_inner,
+// with the input bounds of fieldMulInner. r may alias a.
+func fieldSqrInner(r, a *[5]uint64) {
+	fieldSqrInner10x26(r, a)
+}
@@ -0,0 +1,17 @@
+//go:build amd64 && !purego && !p256k1field10x26
+
+package p256k1
+
+// fieldMulInner sets r = a * b on 5x52 limbs, following
+// secp256k1_fe_mul_inner. The limbs of a and b must be at most 2^56 (2^52 for
+// the top limb), which holds for magnitude 8 inputs. r may alias a or b.
+// Implemented in field_mul_amd64.s.
+//
+//go:noescape
+func fieldMulInner(r, a, b *[5]uint64)
+
+// fieldSqrInner sets r = a^2 on 5x52 limbs, following secp256k1_fe_sqr_inner,
+// with the input bounds of fieldMulInner. r may alias a.
+//
+//go:noescape
+func fieldSqrInner(r, a *[5]uint64)
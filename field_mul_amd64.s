@@ -0,0 +1,440 @@
+//go:build amd64 && !purego && !p256k1field10x26
+
+#include "textflag.h"
+
+// The 5x52 field multiplication and squaring of field_mul.go, written with
+// MULQ/ADDQ/ADCQ so each 128-bit accumulator lives in a register pair
+// instead of going through the uint128 helpers. The steps and comments follow
+// secp256k1_fe_mul_inner and secp256k1_fe_sqr_inner; [hi, lo] accumulators
+// are d = R14:R13 and c = SI:CX, and R15 holds M = 2^52 - 1.
+
+// func fieldMulInner(r, a, b *[5]uint64)
+TEXT ·fieldMulInner(SB), NOSPLIT, $32-24
+	MOVQ a+8(FP), SI
+	MOVQ b+16(FP), DI
+	MOVQ 0(SI), R8
+	MOVQ 8(SI), R9
+	MOVQ 16(SI), R10
+	MOVQ 24(SI), R11
+	MOVQ 32(SI), R12
+	MOVQ $0xFFFFFFFFFFFFF, R15
+
+	// d = a0*b3 + a1*b2 + a2*b1 + a3*b0
+	MOVQ R8, AX
+	MULQ 24(DI)
+	MOVQ AX, R13
+	MOVQ DX, R14
+	MOVQ R9, AX
+	MULQ 16(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R10, AX
+	MULQ 8(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R11, AX
+	MULQ 0(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// c = a4*b4
+	MOVQ R12, AX
+	MULQ 32(DI)
+	MOVQ AX, CX
+	MOVQ DX, BX
+
+	// d += R * c_lo; c >>= 64
+	MOVQ $0x1000003D10, AX
+	MULQ CX
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ BX, CX
+
+	// t3 = d & M; d >>= 52
+	MOVQ R13, AX
+	ANDQ R15, AX
+	MOVQ AX, 0(SP)
+	SHRQ $52, R14, R13
+	SHRQ $52, R14
+
+	// d += a0*b4 + a1*b3 + a2*b2 + a3*b1 + a4*b0
+	MOVQ R8, AX
+	MULQ 32(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R9, AX
+	MULQ 24(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R10, AX
+	MULQ 16(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R11, AX
+	MULQ 8(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R12, AX
+	MULQ 0(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// d += (R << 12) * c
+	MOVQ $0x1000003D10000, AX
+	MULQ CX
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// t4 = d & M; d >>= 52; tx = t4 >> 48; t4 &= M >> 4
+	MOVQ R13, SI
+	ANDQ R15, SI
+	SHRQ $52, R14, R13
+	SHRQ $52, R14
+	MOVQ SI, BX
+	SHRQ $48, BX
+	MOVQ $0xFFFFFFFFFFFF, AX
+	ANDQ AX, SI
+	MOVQ SI, 8(SP)
+
+	// c = a0*b0
+	MOVQ R8, AX
+	MULQ 0(DI)
+	MOVQ AX, CX
+	MOVQ DX, SI
+
+	// d += a1*b4 + a2*b3 + a3*b2 + a4*b1
+	MOVQ R9, AX
+	MULQ 32(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R10, AX
+	MULQ 24(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R11, AX
+	MULQ 16(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R12, AX
+	MULQ 8(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// u0 = ((d & M) << 4) | tx; d >>= 52
+	MOVQ R13, AX
+	ANDQ R15, AX
+	SHLQ $4, AX
+	ORQ BX, AX
+	SHRQ $52, R14, R13
+	SHRQ $52, R14
+
+	// c += u0 * (R >> 4)
+	MOVQ $0x1000003D1, DX
+	MULQ DX
+	ADDQ AX, CX
+	ADCQ DX, SI
+
+	// r[0] = c & M; c >>= 52
+	MOVQ CX, AX
+	ANDQ R15, AX
+	MOVQ AX, 16(SP)
+	SHRQ $52, SI, CX
+	SHRQ $52, SI
+
+	// c += a0*b1 + a1*b0
+	MOVQ R8, AX
+	MULQ 8(DI)
+	ADDQ AX, CX
+	ADCQ DX, SI
+	MOVQ R9, AX
+	MULQ 0(DI)
+	ADDQ AX, CX
+	ADCQ DX, SI
+
+	// d += a2*b4 + a3*b3 + a4*b2
+	MOVQ R10, AX
+	MULQ 32(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R11, AX
+	MULQ 24(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R12, AX
+	MULQ 16(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// c += R * (d & M); d >>= 52
+	MOVQ R13, AX
+	ANDQ R15, AX
+	MOVQ $0x1000003D10, DX
+	MULQ DX
+	ADDQ AX, CX
+	ADCQ DX, SI
+	SHRQ $52, R14, R13
+	SHRQ $52, R14
+
+	// r[1] = c & M; c >>= 52
+	MOVQ CX, AX
+	ANDQ R15, AX
+	MOVQ AX, 24(SP)
+	SHRQ $52, SI, CX
+	SHRQ $52, SI
+
+	// c += a0*b2 + a1*b1 + a2*b0
+	MOVQ R8, AX
+	MULQ 16(DI)
+	ADDQ AX, CX
+	ADCQ DX, SI
+	MOVQ R9, AX
+	MULQ 8(DI)
+	ADDQ AX, CX
+	ADCQ DX, SI
+	MOVQ R10, AX
+	MULQ 0(DI)
+	ADDQ AX, CX
+	ADCQ DX, SI
+
+	// d += a3*b4 + a4*b3
+	MOVQ R11, AX
+	MULQ 32(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R12, AX
+	MULQ 24(DI)
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// c += R * d_lo; d >>= 64
+	MOVQ $0x1000003D10, AX
+	MULQ R13
+	ADDQ AX, CX
+	ADCQ DX, SI
+	MOVQ R14, R13
+
+	// r[2] = c & M; c >>= 52
+	MOVQ CX, R8
+	ANDQ R15, R8
+	SHRQ $52, SI, CX
+	SHRQ $52, SI
+
+	// c += (R << 12) * d + t3
+	MOVQ $0x1000003D10000, AX
+	MULQ R13
+	ADDQ AX, CX
+	ADCQ DX, SI
+	ADDQ 0(SP), CX
+	ADCQ $0, SI
+
+	// r[3] = c & M; r[4] = (c >> 52) + t4
+	MOVQ CX, R9
+	ANDQ R15, R9
+	SHRQ $52, SI, CX
+	ADDQ 8(SP), CX
+
+	// b is no longer read, so r may alias it
+	MOVQ r+0(FP), DI
+	MOVQ 16(SP), AX
+	MOVQ AX, 0(DI)
+	MOVQ 24(SP), AX
+	MOVQ AX, 8(DI)
+	MOVQ R8, 16(DI)
+	MOVQ R9, 24(DI)
+	MOVQ CX, 32(DI)
+	RET
+
+// func fieldSqrInner(r, a *[5]uint64)
+TEXT ·fieldSqrInner(SB), NOSPLIT, $16-16
+	MOVQ a+8(FP), SI
+	MOVQ 0(SI), R8
+	MOVQ 8(SI), R9
+	MOVQ 16(SI), R10
+	MOVQ 24(SI), R11
+	MOVQ 32(SI), R12
+	MOVQ r+0(FP), DI
+	MOVQ $0xFFFFFFFFFFFFF, R15
+
+	// d = (a0*2)*a3 + (a1*2)*a2
+	MOVQ R8, AX
+	ADDQ AX, AX
+	MULQ R11
+	MOVQ AX, R13
+	MOVQ DX, R14
+	MOVQ R9, AX
+	ADDQ AX, AX
+	MULQ R10
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// c = a4*a4
+	MOVQ R12, AX
+	MULQ R12
+	MOVQ AX, CX
+	MOVQ DX, BX
+
+	// d += R * c_lo; c >>= 64
+	MOVQ $0x1000003D10, AX
+	MULQ CX
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ BX, CX
+
+	// t3 = d & M; d >>= 52
+	MOVQ R13, AX
+	ANDQ R15, AX
+	MOVQ AX, 0(SP)
+	SHRQ $52, R14, R13
+	SHRQ $52, R14
+
+	// a4 *= 2; d += a0*a4 + (a1*2)*a3 + a2*a2
+	ADDQ R12, R12
+	MOVQ R8, AX
+	MULQ R12
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R9, AX
+	ADDQ AX, AX
+	MULQ R11
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R10, AX
+	MULQ R10
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// d += (R << 12) * c
+	MOVQ $0x1000003D10000, AX
+	MULQ CX
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// t4 = d & M; d >>= 52; tx = t4 >> 48; t4 &= M >> 4
+	MOVQ R13, SI
+	ANDQ R15, SI
+	SHRQ $52, R14, R13
+	SHRQ $52, R14
+	MOVQ SI, BX
+	SHRQ $48, BX
+	MOVQ $0xFFFFFFFFFFFF, AX
+	ANDQ AX, SI
+	MOVQ SI, 8(SP)
+
+	// c = a0*a0
+	MOVQ R8, AX
+	MULQ R8
+	MOVQ AX, CX
+	MOVQ DX, SI
+
+	// d += a1*a4 + (a2*2)*a3
+	MOVQ R9, AX
+	MULQ R12
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R10, AX
+	ADDQ AX, AX
+	MULQ R11
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// u0 = ((d & M) << 4) | tx; d >>= 52
+	MOVQ R13, AX
+	ANDQ R15, AX
+	SHLQ $4, AX
+	ORQ BX, AX
+	SHRQ $52, R14, R13
+	SHRQ $52, R14
+
+	// c += u0 * (R >> 4)
+	MOVQ $0x1000003D1, DX
+	MULQ DX
+	ADDQ AX, CX
+	ADCQ DX, SI
+
+	// r[0] = c & M; c >>= 52
+	MOVQ CX, AX
+	ANDQ R15, AX
+	MOVQ AX, 0(DI)
+	SHRQ $52, SI, CX
+	SHRQ $52, SI
+
+	// a0 *= 2; c += a0*a1
+	ADDQ R8, R8
+	MOVQ R8, AX
+	MULQ R9
+	ADDQ AX, CX
+	ADCQ DX, SI
+
+	// d += a2*a4 + a3*a3
+	MOVQ R10, AX
+	MULQ R12
+	ADDQ AX, R13
+	ADCQ DX, R14
+	MOVQ R11, AX
+	MULQ R11
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// c += R * (d & M); d >>= 52
+	MOVQ R13, AX
+	ANDQ R15, AX
+	MOVQ $0x1000003D10, DX
+	MULQ DX
+	ADDQ AX, CX
+	ADCQ DX, SI
+	SHRQ $52, R14, R13
+	SHRQ $52, R14
+
+	// r[1] = c & M; c >>= 52
+	MOVQ CX, AX
+	ANDQ R15, AX
+	MOVQ AX, 8(DI)
+	SHRQ $52, SI, CX
+	SHRQ $52, SI
+
+	// c += a0*a2 + a1*a1
+	MOVQ R8, AX
+	MULQ R10
+	ADDQ AX, CX
+	ADCQ DX, SI
+	MOVQ R9, AX
+	MULQ R9
+	ADDQ AX, CX
+	ADCQ DX, SI
+
+	// d += a3*a4
+	MOVQ R11, AX
+	MULQ R12
+	ADDQ AX, R13
+	ADCQ DX, R14
+
+	// c += R * d_lo; d >>= 64
+	MOVQ $0x1000003D10, AX
+	MULQ R13
+	ADDQ AX, CX
+	ADCQ DX, SI
+	MOVQ R14, R13
+
+	// r[2] = c & M; c >>= 52
+	MOVQ CX, AX
+	ANDQ R15, AX
+	MOVQ AX, 16(DI)
+	SHRQ $52, SI, CX
+	SHRQ $52, SI
+
+	// c += (R << 12) * d + t3
+	MOVQ $0x1000003D10000, AX
+	MULQ R13
+	ADDQ AX, CX
+	ADCQ DX, SI
+	ADDQ 0(SP), CX
+	ADCQ $0, SI
+
+	// r[3] = c & M; r[4] = (c >> 52) + t4
+	MOVQ CX, AX
+	ANDQ R15, AX
+	MOVQ AX, 24(DI)
+	SHRQ $52, SI, CX
+	ADDQ 8(SP), CX
+	MOVQ CX, 32(DI)
+	RET
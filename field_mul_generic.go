@@ -0,0 +1,16 @@
+//go:build !p256k1field10x26 && (!amd64 || purego) && (p256k1field5x52 || !(386 || arm || mips || mipsle || wasm))
+
+package p256k1
+
+// fieldMulInner sets r = a * b on 5x52 limbs, following
+// secp256k1_fe_mul_inner. The limbs of a and b must be at most 2^56 (2^52 for
+// the top limb), which holds for magnitude 8 inputs. r may alias a or b.
+func fieldMulInner(r, a, b *[5]uint64) {
+	fieldMulInnerGeneric(r, a, b)
+}
+
+// fieldSqrInner sets r = a^2 on 5x52 limbs, following secp256k1_fe_sqr_inner,
+// with the input bounds of fieldMulInner. r may alias a.
+func fieldSqrInner(r, a *[5]uint64) {
+	fieldSqrInnerGeneric(r, a)
+}
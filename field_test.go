@@ -1,6 +1,8 @@
 package p256k1
 
 import (
+	"math/big"
+	"math/rand"
 	"testing"
 )
 
@@ -132,6 +134,176 @@ func TestFieldElementMultiplication(t *testing.T) {
 	}
 }
 
+// fieldInnerLimbs returns random limbs over the whole input range of
+// fieldMulInner: limbs below 2^56, the top limb below 2^52
+func fieldInnerLimbs(rng *rand.Rand) (a [5]uint64) {
+	for i := range a {
+		switch rng.Intn(4) {
+		case 0:
+			a[i] = 1<<56 - 1
+		case 1:
+			a[i] = 0
+		default:
+			a[i] = rng.Uint64() >> 8
+		}
+	}
+	a[4] >>= 4
+	return a
+}
+
+// fieldInnerEqual reports whether the magnitude 1 limbs a and b are the
+// same field element
+func fieldInnerEqual(a, b *[5]uint64) bool {
+	x := FieldElement{n: *a, magnitude: 1}
+	y := FieldElement{n: *b, magnitude: 1}
+	x.normalize()
+	y.normalize()
+	return x.n == y.n
+}
+
+func TestFieldMulInner(t *testing.T) {
+	// Compare fieldMulInner and fieldSqrInner (assembly or 10x26 where built)
+	// with the portable versions over the whole input range
+	rng := rand.New(rand.NewSource(1))
+	for i := 0; i < 10000; i++ {
+		a, b := fieldInnerLimbs(rng), fieldInnerLimbs(rng)
+		var got, want [5]uint64
+		fieldMulInner(&got, &a, &b)
+		fieldMulInnerGeneric(&want, &a, &b)
+		if !fieldInnerEqual(&got, &want) {
+			t.Fatalf("mul(%x, %x) = %x, want %x", a, b, got, want)
+		}
+		fieldSqrInner(&got, &a)
+		fieldSqrInnerGeneric(&want, &a)
+		if !fieldInnerEqual(&got, &want) {
+			t.Fatalf("sqr(%x) = %x, want %x", a, got, want)
+		}
+
+		// Aliased outputs
+		fieldMulInner(&want, &a, &b)
+		ra, rb := a, b
+		fieldMulInner(&ra, &ra, &b)
+		fieldMulInner(&rb, &a, &rb)
+		if ra != want || rb != want {
+			t.Fatalf("aliased mul(%x, %x) differs", a, b)
+		}
+		fieldSqrInner(&want, &a)
+		ra = a
+		fieldSqrInner(&ra, &ra)
+		if ra != want {
+			t.Fatalf("aliased sqr(%x) differs", a)
+		}
+	}
+}
+
+func TestFieldMulInner10x26(t *testing.T) {
+	// The 10x26 multiplication must agree with 5x52 and leave limbs as
+	// bounded as it does, 52 bits and 49 for the top limb, which fieldLanes
+	// relies on
+	rng := rand.New(rand.NewSource(3))
+	check := func(name string, got, want *[5]uint64) {
+		t.Helper()
+		r := FieldElement{n: *got, magnitude: 1}
+		r.verify()
+		for j := 0; j < 4; j++ {
+			if got[j] >= 1<<52 {
+				t.Fatalf("%s: limb %d of %x exceeds 52 bits", name, j, *got)
+			}
+		}
+		if got[4] >= 1<<49 || !fieldInnerEqual(got, want) {
+			t.Fatalf("%s = %x, want %x", name, *got, *want)
+		}
+	}
+	for i := 0; i < 10000; i++ {
+		a, b := fieldInnerLimbs(rng), fieldInnerLimbs(rng)
+		if i == 0 {
+			for j := range a {
+				a[j], b[j] = 1<<56-1, 1<<56-1
+			}
+			a[4], b[4] = 1<<52-1, 1<<52-1
+		}
+		var got, want [5]uint64
+		fieldMulInner10x26(&got, &a, &b)
+		fieldMulInnerGeneric(&want, &a, &b)
+		check("mul", &got, &want)
+		fieldSqrInner10x26(&got, &a)
+		fieldSqrInnerGeneric(&want, &a)
+		check("sqr", &got, &want)
+	}
+}
+
+func TestFieldMulLanes(t *testing.T) {
+	// fieldMulLanes (IFMA where available) and fieldMulLanesGeneric must agree
+	// with fieldMulInner on every lane for limbs up to 2^52-1, and keep the
+	// limbs of the result within what fieldLanes requires
+	rng := rand.New(rand.NewSource(2))
+	limbs := func() (a [5]uint64) {
+		for i := range a {
+			switch rng.Intn(4) {
+			case 0:
+				a[i] = 1<<52 - 1
+			case 1:
+				a[i] = 0
+			default:
+				a[i] = rng.Uint64() >> 12
+			}
+		}
+		return a
+	}
+	reduced := func(n [5]uint64) [5]uint64 {
+		f := FieldElement{n: n, magnitude: 8}
+		f.normalize()
+		return f.n
+	}
+
+	for _, mul := range []struct {
+		name string
+		f    func(r, a, b *fieldLanes)
+	}{{"fieldMulLanes", fieldMulLanes}, {"fieldMulLanesGeneric", fieldMulLanesGeneric}} {
+		for iter := 0; iter < 2000; iter++ {
+			var a, b, r fieldLanes
+			var want [fieldLaneCount][5]uint64
+			for l := 0; l < fieldLaneCount; l++ {
+				x, y := limbs(), limbs()
+				for j := range x {
+					a.n[j][l], b.n[j][l] = x[j], y[j]
+				}
+				fieldMulInnerGeneric(&want[l], &x, &y)
+			}
+			mul.f(&r, &a, &b)
+			mul.f(&a, &a, &b)
+			for l := 0; l < fieldLaneCount; l++ {
+				var got [5]uint64
+				for j := range got {
+					got[j] = r.n[j][l]
+					if a.n[j][l] != got[j] {
+						t.Fatalf("%s: aliased output differs in lane %d", mul.name, l)
+					}
+					if got[j] >= 1<<52 || (j == 4 && got[j] >= 1<<49) {
+						t.Fatalf("%s: lane %d limb %d = %x out of range", mul.name, l, j, got[j])
+					}
+				}
+				if reduced(got) != reduced(want[l]) {
+					t.Fatalf("%s: lane %d = %x, want %x", mul.name, l, got, want[l])
+				}
+			}
+		}
+	}
+
+	// set and get round trip elements of any magnitude
+	var v fieldLanes
+	x := GeneratorX
+	x.mulInt(8)
+	v.set(3, &x)
+	var y FieldElement
+	v.get(3, &y)
+	x.normalize()
+	y.normalize()
+	if !y.equal(&x) {
+		t.Error("fieldLanes set/get changed the value")
+	}
+}
+
 func TestFieldElementNormalization(t *testing.T) {
 	var fe FieldElement
 	fe.setInt(42)
@@ -151,6 +323,92 @@ func TestFieldElementNormalization(t *testing.T) {
 	}
 }
 
+func TestFieldElementSqrt(t *testing.T) {
+	// -1 is not a square mod p, so for every nonzero x exactly one of x^2
+	// and -x^2 has a square root, and sqrt of the other yields a root of x^2
+	rng := rand.New(rand.NewSource(5))
+	for i := 0; i < 200; i++ {
+		var buf [32]byte
+		rng.Read(buf[:])
+		var x, sq, nsq, r, chk FieldElement
+		x.setB32(buf[:])
+		sq.sqr(&x)
+		nsq.negate(&sq, 1)
+		sq.normalize()
+
+		if !r.sqrt(&sq) {
+			t.Fatalf("sqrt(%x) failed on a square", sq.n)
+		}
+		chk.sqr(&r)
+		chk.normalize()
+		if !chk.equal(&sq) {
+			t.Fatalf("sqrt(%x)^2 != input", sq.n)
+		}
+		if sq.isSquareVar() != true || nsq.isSquareVar() != false {
+			t.Fatalf("isSquareVar wrong for %x", sq.n)
+		}
+
+		if r.sqrt(&nsq) {
+			t.Fatalf("sqrt(%x) succeeded on a non-square", nsq.n)
+		}
+		chk.sqr(&r)
+		chk.normalize()
+		if !chk.equal(&sq) {
+			t.Fatalf("sqrt of a non-square did not yield the root of its negation")
+		}
+	}
+}
+
+func TestFieldElementNormalizesToZero(t *testing.T) {
+	var zero, p, one, x FieldElement
+	zero.setInt(0)
+	one.setInt(1)
+	// p itself, as an unnormalized representation of zero
+	p.n = [5]uint64{fieldModulusLimb0, fieldModulusLimb1, fieldModulusLimb2, fieldModulusLimb3, fieldModulusLimb4}
+	p.magnitude = 1
+	x.negate(&one, 1)
+	x.add(&one)
+
+	for _, tc := range []struct {
+		name string
+		fe   *FieldElement
+		want bool
+	}{{"zero", &zero, true}, {"p", &p, true}, {"one", &one, false}, {"-1+1", &x, true}} {
+		if got := tc.fe.normalizesToZero(); got != tc.want {
+			t.Errorf("%s: normalizesToZero = %v, want %v", tc.name, got, tc.want)
+		}
+		if got := tc.fe.normalizesToZeroVar(); got != tc.want {
+			t.Errorf("%s: normalizesToZeroVar = %v, want %v", tc.name, got, tc.want)
+		}
+	}
+
+	// Larger magnitudes, where the first limb no longer decides alone
+	rng := rand.New(rand.NewSource(4))
+	for i := 0; i < 1000; i++ {
+		var a, b [32]byte
+		rng.Read(a[:])
+		var fa, fb FieldElement
+		fa.setB32(a[:])
+		m := 1 + rng.Intn(15)
+		fa.mulInt(m)
+		fb.negate(&fa, m)
+		fb.add(&fa)
+		want := true
+		if i%2 == 1 {
+			rng.Read(b[:])
+			var fc FieldElement
+			fc.setB32(b[:])
+			fb.add(&fc)
+			n := fb
+			n.normalize()
+			want = n.isZero()
+		}
+		if got := fb.normalizesToZeroVar(); got != want {
+			t.Fatalf("normalizesToZeroVar(%x) = %v, want %v", fb.n, got, want)
+		}
+	}
+}
+
 func TestFieldElementOddness(t *testing.T) {
 	var even, odd FieldElement
 	even.setInt(4)
@@ -245,11 +503,51 @@ func TestFieldElementClear(t *testing.T) {
 	}
 }
 
-// TestMontgomery tests Montgomery multiplication (currently disabled due to incomplete implementation)
-// TODO: Re-enable once Montgomery multiplication is fully implemented
+// TestMontgomery tests Montgomery multiplication
 func TestMontgomery(t *testing.T) {
-	t.Skip("Montgomery multiplication implementation is incomplete - see MONTGOMERY_NOTES.md")
-	
+	// montMul against math/big, including values next to p
+	t.Run("REDC", func(t *testing.T) {
+		p := new(big.Int).Lsh(big.NewInt(1), 256)
+		p.Sub(p, big.NewInt(0x1000003D1))
+		rInv := new(big.Int).Lsh(big.NewInt(1), 256)
+		rInv.ModInverse(rInv, p)
+		toBig := func(a *[4]uint64) *big.Int {
+			x := new(big.Int)
+			for i := 3; i >= 0; i-- {
+				x.Lsh(x, 64)
+				x.Or(x, new(big.Int).SetUint64(a[i]))
+			}
+			return x
+		}
+
+		rng := rand.New(rand.NewSource(3))
+		pMinus := func(k uint64) [4]uint64 {
+			return [4]uint64{montP[0] - k, montP[1], montP[2], montP[3]}
+		}
+		values := [][4]uint64{{}, {1}, pMinus(1), pMinus(2), montR2}
+		for i := 0; i < 200; i++ {
+			var a [4]uint64
+			for j := range a {
+				a[j] = rng.Uint64()
+			}
+			if toBig(&a).Cmp(p) >= 0 {
+				a[3] >>= 1
+			}
+			values = append(values, a)
+		}
+		for i := range values {
+			for j := range values {
+				var r [4]uint64
+				montMul(&r, &values[i], &values[j])
+				want := new(big.Int).Mul(toBig(&values[i]), toBig(&values[j]))
+				want.Mul(want, rInv).Mod(want, p)
+				if toBig(&r).Cmp(want) != 0 {
+					t.Fatalf("montMul(%x, %x) = %x, want %x", values[i], values[j], r, want)
+				}
+			}
+		}
+	})
+
 	// Test Montgomery conversion round-trip
 	t.Run("RoundTrip", func(t *testing.T) {
 		var a, b FieldElement
@@ -392,3 +690,102 @@ func TestMontgomery(t *testing.T) {
 		}
 	})
 }
+
+func BenchmarkFieldMul(b *testing.B) {
+	x, y := GeneratorX, GeneratorY
+	b.Run("mul", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.mul(&x, &y)
+		}
+	})
+	b.Run("sqr", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			x.sqr(&x)
+		}
+	})
+	b.Run("mulGeneric", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldMulInnerGeneric(&x.n, &x.n, &y.n)
+		}
+	})
+	b.Run("sqrGeneric", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldSqrInnerGeneric(&x.n, &x.n)
+		}
+	})
+	b.Run("mul10x26", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldMulInner10x26(&x.n, &x.n, &y.n)
+		}
+	})
+	b.Run("sqr10x26", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldSqrInner10x26(&x.n, &x.n)
+		}
+	})
+
+	b.Run("montgomery", func(b *testing.B) {
+		var u, v [4]uint64
+		montFromField(&u, &x)
+		montFromField(&v, &y)
+		for i := 0; i < b.N; i++ {
+			montMul(&u, &u, &v)
+		}
+	})
+
+	// Per call, i.e. per fieldLaneCount multiplications
+	var u, v fieldLanes
+	for l := 0; l < fieldLaneCount; l++ {
+		u.set(l, &GeneratorX)
+		v.set(l, &GeneratorY)
+	}
+	b.Run("lanes", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldMulLanes(&u, &u, &v)
+		}
+	})
+	b.Run("lanesGeneric", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fieldMulLanesGeneric(&u, &u, &v)
+		}
+	})
+}
+
+// BenchmarkFieldNormalizations reports the full normalizations performed per
+// signature operation. The count is only kept with -tags verify.
+func BenchmarkFieldNormalizations(b *testing.B) {
+	if !fieldVerifyEnabled {
+		b.Skip("normalizations are only counted with -tags verify")
+	}
+	kp, err := KeyPairGenerate()
+	if err != nil {
+		b.Fatal(err)
+	}
+	xonly, err := kp.XOnlyPubkey()
+	if err != nil {
+		b.Fatal(err)
+	}
+	msg := make([]byte, 32)
+	sig := make([]byte, 64)
+	if err := SchnorrSign(sig, msg, kp, nil); err != nil {
+		b.Fatal(err)
+	}
+	var esig ECDSASignature
+	if err := ECDSASign(&esig, msg, kp.Seckey()); err != nil {
+		b.Fatal(err)
+	}
+
+	run := func(name string, f func()) {
+		b.Run(name, func(b *testing.B) {
+			start := fieldVerifyNormalizeCount()
+			for i := 0; i < b.N; i++ {
+				f()
+			}
+			b.ReportMetric(float64(fieldVerifyNormalizeCount()-start)/float64(b.N), "normalizes/op")
+		})
+	}
+	run("SchnorrVerify", func() { SchnorrVerify(sig, msg, xonly) })
+	run("ECDSAVerify", func() { ECDSAVerify(&esig, msg, kp.Pubkey()) })
+	run("SchnorrSign", func() { SchnorrSign(sig, msg, kp, nil) })
+	run("ECDSASign", func() { ECDSASign(&esig, msg, kp.Seckey()) })
+}
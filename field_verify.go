@@ -0,0 +1,50 @@
+//go:build verify
+
+package p256k1
+
+import "sync/atomic"
+
+// fieldVerifyEnabled turns on the field element bound checks, as VERIFY in
+// the C library. Build with -tags verify to enable them.
+const fieldVerifyEnabled = true
+
+// jacobi64Iterations bounds the rounds of 62 posdivsteps jacobi64MaybeVar
+// does. With the checks on it is 744 steps, close to the median of 756, so
+// that the fallback for a failure gets exercised.
+const jacobi64Iterations = 12
+
+// fieldNormalizations counts the normalizations performed
+var fieldNormalizations atomic.Uint64
+
+func fieldVerifyCountNormalize() {
+	fieldNormalizations.Add(1)
+}
+
+// fieldVerifyNormalizeCount returns the number of normalizations performed so
+// far
+func fieldVerifyNormalizeCount() uint64 {
+	return fieldNormalizations.Load()
+}
+
+func fieldVerifyCheck(ok bool, msg string) {
+	if !ok {
+		panic("field verify: " + msg)
+	}
+}
+
+// verify checks that the limbs of r are within the bounds its magnitude and
+// normalized flag promise, as secp256k1_fe_impl_verify
+func (r *FieldElement) verify() {
+	m := uint64(2 * r.magnitude)
+	if r.normalized {
+		m = 1
+	}
+	fieldVerifyCheck(r.magnitude >= 0 && r.magnitude <= 32, "magnitude out of range")
+	fieldVerifyCheck(r.n[0] <= m*limb0Max && r.n[1] <= m*limb0Max && r.n[2] <= m*limb0Max &&
+		r.n[3] <= m*limb0Max && r.n[4] <= m*limb4Max, "limb exceeds magnitude bound")
+	if r.normalized {
+		fieldVerifyCheck(r.magnitude <= 1, "normalized element with magnitude above 1")
+		fieldVerifyCheck(!(r.n[4] == limb4Max && r.n[3]&r.n[2]&r.n[1] == limb0Max && r.n[0] >= fieldModulusLimb0),
+			"normalized element not below p")
+	}
+}
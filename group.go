@@ -15,12 +15,25 @@ type GroupElementJacobian struct {
 	infinity bool
 }
 
+// Maximum magnitudes of the x and y coordinates of a Jacobian point, as
+// SECP256K1_GEJ_X_MAGNITUDE_MAX and SECP256K1_GEJ_Y_MAGNITUDE_MAX
+const (
+	gejXMagnitudeMax = 4
+	gejYMagnitudeMax = 4
+)
+
 // GroupElementStorage represents a point in storage format (compressed coordinates)
 type GroupElementStorage struct {
 	x [32]byte
 	y [32]byte
 }
 
+// geStorage is the limb storage form of a non-infinite affine point, like
+// secp256k1_ge_storage. It is used for the precomputed tables.
+type geStorage struct {
+	x, y FieldElementStorage
+}
+
 // Generator point G for secp256k1 curve
 var (
 	// Generator point in affine coordinates
@@ -112,6 +125,32 @@ func (r *GroupElementAffine) setXOVar(x *FieldElement, odd bool) bool {
 	return true
 }
 
+// xOnCurveVar reports whether x is the x coordinate of a point on the curve,
+// that is whether x^3 + 7 is a square, without computing the point
+func xOnCurveVar(x *FieldElement) bool {
+	var c, seven FieldElement
+	c.sqr(x)
+	c.mul(&c, x)
+	seven.setInt(7)
+	c.add(&seven)
+	return c.isSquareVar()
+}
+
+// xFracOnCurveVar reports whether n/d is the x coordinate of a point on the
+// curve, for nonzero d, as secp256k1_ge_x_frac_on_curve_var: (n/d)^3 + 7 is
+// a square exactly when d*n^3 + 7*d^4 is, multiplying by the square d^4
+func xFracOnCurveVar(n, d *FieldElement) bool {
+	var r, t FieldElement
+	r.mul(d, n)
+	t.sqr(n)
+	r.mul(&r, &t)
+	t.sqr(d)
+	t.sqr(&t)
+	t.mulInt(7)
+	r.add(&t)
+	return r.isSquareVar()
+}
+
 // isInfinity returns true if the group element is the point at infinity
 func (r *GroupElementAffine) isInfinity() bool {
 	return r.infinity
@@ -220,7 +259,8 @@ func (r *GroupElementJacobian) setGE(a *GroupElementAffine) {
 }
 
 // setGEJ sets an affine element from a Jacobian element
-// This follows the C secp256k1_ge_set_gej_var implementation exactly
+// This follows the C secp256k1_ge_set_gej implementation; the inversion is
+// constant time, so a may depend on secret data. See setGEJVar.
 // Optimized: avoid copy when we can modify in-place or when caller guarantees no reuse
 func (r *GroupElementAffine) setGEJ(a *GroupElementJacobian) {
 	if a.infinity {
@@ -235,7 +275,7 @@ func (r *GroupElementAffine) setGEJ(a *GroupElementJacobian) {
 	
 	r.infinity = false
 	
-	// secp256k1_fe_inv_var(&a->z, &a->z);
+	// secp256k1_fe_inv(&a->z, &a->z);
 	// Note: inv normalizes the input internally
 	aCopy.z.inv(&aCopy.z)
 	
@@ -261,6 +301,203 @@ func (r *GroupElementAffine) setGEJ(a *GroupElementJacobian) {
 	r.y = aCopy.y
 }
 
+// setGEJVar sets an affine element from a Jacobian element using a variable
+// time inversion, following secp256k1_ge_set_gej_var. It must only be used on
+// public points, such as in verification.
+func (r *GroupElementAffine) setGEJVar(a *GroupElementJacobian) {
+	if a.infinity {
+		r.setInfinity()
+		return
+	}
+
+	var zi FieldElement
+	zi.invVar(&a.z)
+	r.setGEJZinv(a, &zi)
+}
+
+// geSetAllGEJVar sets r[i] to the affine form of a[i] for every i using a
+// single variable time inversion, following secp256k1_ge_set_all_gej_var.
+// The x coordinates of r serve as scratch space for the running products, so
+// no memory is allocated. Infinity inputs give infinity outputs. r must be at
+// least as long as a and must only hold public points.
+func geSetAllGEJVar(r []GroupElementAffine, a []GroupElementJacobian) {
+	var u FieldElement
+	lastI := -1
+
+	for i := range a {
+		if a[i].infinity {
+			r[i].setInfinity()
+		} else {
+			// Use destination's x coordinates as scratch space
+			if lastI == -1 {
+				r[i].x = a[i].z
+			} else {
+				r[i].x.mul(&r[lastI].x, &a[i].z)
+			}
+			lastI = i
+		}
+	}
+	if lastI == -1 {
+		return
+	}
+	u.invVar(&r[lastI].x)
+
+	i := lastI
+	for i > 0 {
+		i--
+		if !a[i].infinity {
+			r[lastI].x.mul(&r[i].x, &u)
+			u.mul(&u, &a[lastI].z)
+			lastI = i
+		}
+	}
+	r[lastI].x = u
+
+	if !fieldLanesVector {
+		for i := range a {
+			if !a[i].infinity {
+				zi := r[i].x
+				r[i].setGEJZinv(&a[i], &zi)
+			}
+		}
+		return
+	}
+
+	// The rescaling by the inverses is independent per point, so it runs
+	// fieldLaneCount points at a time
+	var idx [fieldLaneCount]int
+	n := 0
+	for i := range a {
+		if !a[i].infinity {
+			idx[n] = i
+			n++
+			if n == fieldLaneCount {
+				geSetGEJZinvLanes(r, a, idx[:n])
+				n = 0
+			}
+		}
+	}
+	if n > 0 {
+		geSetGEJZinvLanes(r, a, idx[:n])
+	}
+}
+
+// geSetGEJZinvLanes sets r[i] to a[i] rescaled by the inverse of its z held
+// in r[i].x, as setGEJZinv, for the at most fieldLaneCount indices in idx.
+// Unused lanes are multiplied as zero.
+func geSetGEJZinvLanes(r []GroupElementAffine, a []GroupElementJacobian, idx []int) {
+	var zi, zi2, x, y fieldLanes
+	for l, i := range idx {
+		zi.set(l, &r[i].x)
+		x.set(l, &a[i].x)
+		y.set(l, &a[i].y)
+	}
+	fieldMulLanes(&zi2, &zi, &zi)
+	fieldMulLanes(&x, &x, &zi2)
+	fieldMulLanes(&zi2, &zi2, &zi)
+	fieldMulLanes(&y, &y, &zi2)
+	for l, i := range idx {
+		x.get(l, &r[i].x)
+		y.get(l, &r[i].y)
+		r[i].infinity = false
+	}
+}
+
+// geSetAllGEJ is geSetAllGEJVar with a constant time inversion, for points
+// derived from secrets. None of the inputs may be infinity.
+func geSetAllGEJ(r []GroupElementAffine, a []GroupElementJacobian) {
+	if len(a) == 0 {
+		return
+	}
+	r[0].x = a[0].z
+	for i := 1; i < len(a); i++ {
+		r[i].x.mul(&r[i-1].x, &a[i].z)
+	}
+
+	var u FieldElement
+	u.inv(&r[len(a)-1].x)
+	for i := len(a) - 1; i > 0; i-- {
+		r[i].x.mul(&r[i-1].x, &u)
+		u.mul(&u, &a[i].z)
+	}
+	r[0].x = u
+
+	for i := range a {
+		zi := r[i].x
+		r[i].setGEJZinv(&a[i], &zi)
+	}
+}
+
+// setGEJZinv sets r to the affine coordinates of the Jacobian point
+// (a.x, a.y, 1/zi), following secp256k1_ge_set_gej_zinv
+func (r *GroupElementAffine) setGEJZinv(a *GroupElementJacobian, zi *FieldElement) {
+	var zi2, zi3 FieldElement
+	zi2.sqr(zi)
+	zi3.mul(&zi2, zi)
+	r.x.mul(&a.x, &zi2)
+	r.y.mul(&a.y, &zi3)
+	r.infinity = a.infinity
+}
+
+// setGEZinv sets r to the affine coordinates of the Jacobian point
+// (a.x, a.y, 1/zi), following secp256k1_ge_set_ge_zinv
+func (r *GroupElementAffine) setGEZinv(a *GroupElementAffine, zi *FieldElement) {
+	var zi2, zi3 FieldElement
+	zi2.sqr(zi)
+	zi3.mul(&zi2, zi)
+	r.x.mul(&a.x, &zi2)
+	r.y.mul(&a.y, &zi3)
+	r.infinity = a.infinity
+}
+
+// geTableSetGlobalZ brings a table of points with z-ratios zr, as produced by
+// ecmultOddMultiplesTable, to the z coordinate of its last entry. Afterwards
+// every entry has the same implied z, and all y values are weakly normalized
+// so they can be negated with magnitude 1. Follows
+// secp256k1_ge_table_set_globalz.
+func geTableSetGlobalZ(a []GroupElementAffine, zr []FieldElement) {
+	if len(a) == 0 {
+		return
+	}
+
+	i := len(a) - 1
+	a[i].y.normalizeWeak()
+	zs := zr[i]
+
+	// Work our way backwards, using the z-ratios to scale the x/y values
+	for i > 0 {
+		if i != len(a)-1 {
+			zs.mul(&zs, &zr[i])
+		}
+		i--
+		a[i].setGEZinv(&a[i], &zs)
+	}
+}
+
+// rescale multiplies the z coordinate of r by s without changing the point it
+// represents, following secp256k1_gej_rescale. s must be nonzero.
+func (r *GroupElementJacobian) rescale(s *FieldElement) {
+	var zz FieldElement
+	zz.sqr(s)
+	r.x.mul(&r.x, &zz)
+	r.y.mul(&r.y, &zz)
+	r.y.mul(&r.y, s)
+	r.z.mul(&r.z, s)
+}
+
+// eqXVar reports whether x is the affine x coordinate of r, without
+// converting r to affine: x == X/Z^2 <=> x*Z^2 == X. Follows
+// secp256k1_gej_eq_x_var; r must not be infinity and x must have magnitude
+// at most 1.
+func (r *GroupElementJacobian) eqXVar(x *FieldElement) bool {
+	var t FieldElement
+	t.sqr(&r.z)
+	t.mul(&t, x)
+	t.negate(&t, 1)
+	t.add(&r.x)
+	return t.normalizesToZeroVar()
+}
+
 // negate sets r to the negation of a Jacobian point
 func (r *GroupElementJacobian) negate(a *GroupElementJacobian) {
 	if a.infinity {
@@ -592,6 +829,138 @@ func (r *GroupElementJacobian) addGE(a *GroupElementJacobian, b *GroupElementAff
 	r.addGEWithZR(a, b, nil)
 }
 
+
+// addGEConst sets r = a + b in constant time, where b is affine and not
+// infinity. a may be infinity, and a == b or a == -b are handled without
+// branching. This follows the C secp256k1_gej_add_ge implementation (the
+// unified addition/doubling formula of Brier and Joye).
+// Operations: 7 mul, 5 sqr, 21 add/cmov/half/mul_int/negate/normalizes_to_zero
+func (r *GroupElementJacobian) addGEConst(a *GroupElementJacobian, b *GroupElementAffine) {
+	var zz, u1, u2, s1, s2, t, tt, m, n, q, rr FieldElement
+	var mAlt, rrAlt FieldElement
+
+	zz.sqr(&a.z)      // z = Z1^2
+	u1 = a.x          // u1 = U1 = X1*Z2^2
+	u2.mul(&b.x, &zz) // u2 = U2 = X2*Z1^2
+	s1 = a.y          // s1 = S1 = Y1*Z2^3
+	s2.mul(&b.y, &zz) // s2 = Y2*Z1^2
+	s2.mul(&s2, &a.z) // s2 = S2 = Y2*Z1^3
+	t = u1
+	t.add(&u2) // t = T = U1+U2
+	m = s1
+	m.add(&s2)          // m = M = S1+S2
+	rr.sqr(&t)          // rr = T^2
+	mAlt.negate(&u2, 1) // Malt = -X2*Z1^2
+	tt.mul(&u1, &mAlt)  // tt = -U1*U2
+	rr.add(&tt)         // rr = R = T^2-U1*U2
+
+	// If lambda = R/M = R/0 we have a problem (except in the "trivial" case
+	// that Z = z1z2 = 0, and this is special-cased later on). This only
+	// occurs when y1 == -y2 and x1^3 == x2^3, but x1 != x2, in which case
+	// (y1 - y2)/(x1 - x2) is used as the alternate expression for lambda.
+	degenerate := boolToInt(m.normalizesToZero())
+	rrAlt = s1
+	rrAlt.mulInt(2) // rr_alt = Y1*Z2^3 - Y2*Z1^3
+	mAlt.add(&u1)   // Malt = X1*Z2^2 - X2*Z1^2
+
+	rrAlt.cmov(&rr, degenerate^1)
+	mAlt.cmov(&m, degenerate^1)
+
+	// Now Ralt / Malt = lambda and is guaranteed not to be Ralt / 0
+	n.sqr(&mAlt)                     // n = Malt^2
+	q.negate(&t, gejXMagnitudeMax+1) // q = -T
+	q.mul(&q, &n)                    // q = Q = -T*Malt^2
+
+	// Either M == Malt or M == 0, so M^3 * Malt is either Malt^4 (computed by
+	// squaring) or zero (computed by cmov)
+	n.sqr(&n)                          // n = Malt^4
+	n.cmov(&m, degenerate)             // n = M^3 * Malt
+	t.sqr(&rrAlt)                      // t = Ralt^2
+	r.z.mul(&a.z, &mAlt)               // r.z = Z3 = Malt*Z
+	t.add(&q)                          // t = Ralt^2 + Q
+	r.x = t                            // r.x = X3 = Ralt^2 + Q
+	t.mulInt(2)                        // t = 2*X3
+	t.add(&q)                          // t = 2*X3 + Q
+	t.mul(&t, &rrAlt)                  // t = Ralt*(2*X3 + Q)
+	t.add(&n)                          // t = Ralt*(2*X3 + Q) + M^3*Malt
+	r.y.negate(&t, gejYMagnitudeMax+2) // r.y = -(Ralt*(2*X3 + Q) + M^3*Malt)
+	r.y.half(&r.y)                     // r.y = Y3 = -(Ralt*(2*X3 + Q) + M^3*Malt)/2
+
+	// In case a.infinity, replace r with (b.x, b.y, 1)
+	inf := boolToInt(a.infinity)
+	r.x.cmov(&b.x, inf)
+	r.y.cmov(&b.y, inf)
+	r.z.cmov(&FieldElementOne, inf)
+
+	// r is infinity exactly when a == -b, in which case r.z is zero. If a was
+	// infinity, r.z is now one.
+	r.infinity = r.z.normalizesToZero()
+}
+// addZinvVar sets r = a + b where b is the Jacobian point (b.x, b.y, 1/bzinv)
+// This follows the C secp256k1_gej_add_zinv_var implementation
+// Operations: 9 mul, 3 sqr, 11 add/negate/normalizes_to_zero
+func (r *GroupElementJacobian) addZinvVar(a *GroupElementJacobian, b *GroupElementAffine, bzinv *FieldElement) {
+	if a.infinity {
+		var bzinv2, bzinv3 FieldElement
+		r.infinity = b.infinity
+		bzinv2.sqr(bzinv)
+		bzinv3.mul(&bzinv2, bzinv)
+		r.x.mul(&b.x, &bzinv2)
+		r.y.mul(&b.y, &bzinv3)
+		r.z.setInt(1)
+		return
+	}
+	if b.infinity {
+		*r = *a
+		return
+	}
+
+	// We need to calculate (rx,ry,rz) = (ax,ay,az) + (bx,by,1/bzinv). Due to
+	// secp256k1's isomorphism we can multiply the Z coordinates on both sides
+	// by bzinv, and get: (rx,ry,rz*bzinv) = (ax,ay,az*bzinv) + (bx,by,1).
+	// az holds the modified Z coordinate of a, which is used for the
+	// computation of rx and ry, but not for rz.
+	var az, z12, u1, u2, s1, s2, h, i, h2, h3, t FieldElement
+	az.mul(&a.z, bzinv)
+
+	z12.sqr(&az)
+	u1 = a.x
+	u2.mul(&b.x, &z12)
+	s1 = a.y
+	s2.mul(&b.y, &z12)
+	s2.mul(&s2, &az)
+	h.negate(&u1, a.x.magnitude)
+	h.add(&u2)
+	i.negate(&s2, 1)
+	i.add(&s1)
+	if h.normalizesToZeroVar() {
+		if i.normalizesToZeroVar() {
+			r.double(a)
+		} else {
+			r.setInfinity()
+		}
+		return
+	}
+
+	r.infinity = false
+	r.z.mul(&a.z, &h)
+
+	h2.sqr(&h)
+	h2.negate(&h2, 1)
+	h3.mul(&h2, &h)
+	t.mul(&u1, &h2)
+
+	r.x.sqr(&i)
+	r.x.add(&h3)
+	r.x.add(&t)
+	r.x.add(&t)
+
+	t.add(&r.x)
+	r.y.mul(&t, &i)
+	h3.mul(&h3, &s1)
+	r.y.add(&h3)
+}
+
 // clear clears a group element to prevent leaking sensitive information
 func (r *GroupElementAffine) clear() {
 	r.x.clear()
@@ -654,6 +1023,26 @@ func (r *GroupElementAffine) fromStorage(s *GroupElementStorage) {
 	r.infinity = false
 }
 
+// toLimbStorage converts a non-infinite group element to limb storage format
+func (r *GroupElementAffine) toLimbStorage(s *geStorage) {
+	r.x.toStorage(&s.x)
+	r.y.toStorage(&s.y)
+}
+
+// cmov conditionally moves a storage point. If flag is true, r = a;
+// otherwise r is unchanged.
+func (r *geStorage) cmov(a *geStorage, flag int) {
+	r.x.cmov(&a.x, flag)
+	r.y.cmov(&a.y, flag)
+}
+
+// fromLimbStorage converts from limb storage format to group element
+func (r *GroupElementAffine) fromLimbStorage(s *geStorage) {
+	r.x.fromStorage(&s.x)
+	r.y.fromStorage(&s.y)
+	r.infinity = false
+}
+
 // toBytes converts a group element to byte representation
 // Optimized: normalize in-place when possible to avoid copy
 func (r *GroupElementAffine) toBytes(buf []byte) {
@@ -702,8 +1091,9 @@ func (r *GroupElementAffine) fromBytes(buf []byte) {
 		return
 	}
 	
-	// Convert from bytes
-	r.x.setB32(buf[:32])
-	r.y.setB32(buf[32:64])
+	// Convert from bytes. toBytes writes normalized coordinates, so values
+	// below p are marked normalized.
+	r.x.setB32Limit(buf[:32])
+	r.y.setB32Limit(buf[32:64])
 	r.infinity = false
 }
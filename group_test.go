@@ -95,6 +95,59 @@ func TestGroupElementStorage(t *testing.T) {
 	}
 }
 
+func TestGroupAddGEConst(t *testing.T) {
+	p := randomPoint(t)
+	q := randomPoint(t)
+	var pj, got, want GroupElementJacobian
+	pj.setGE(&p)
+	pj.double(&pj) // non-trivial z
+
+	// Distinct points
+	got.addGEConst(&pj, &q)
+	want.addGE(&pj, &q)
+	if !jacobianEqual(&got, &want) {
+		t.Error("addGEConst does not match addGE")
+	}
+
+	// Doubling: a == b
+	var pd GroupElementAffine
+	pd.setGEJ(&pj)
+	got.addGEConst(&pj, &pd)
+	want.double(&pj)
+	if !jacobianEqual(&got, &want) {
+		t.Error("addGEConst does not double")
+	}
+
+	// a == -b gives infinity
+	var neg GroupElementAffine
+	neg.negate(&pd)
+	got.addGEConst(&pj, &neg)
+	if !got.isInfinity() {
+		t.Error("addGEConst of a point and its negation should be infinity")
+	}
+
+	// a at infinity
+	var inf GroupElementJacobian
+	inf.setInfinity()
+	got.addGEConst(&inf, &q)
+	want.setGE(&q)
+	if !jacobianEqual(&got, &want) {
+		t.Error("addGEConst with a at infinity should return b")
+	}
+
+	// x1 == beta*x2 and y1 == -y2: the degenerate lambda case
+	var lam GroupElementAffine
+	lam.x.mul(&pd.x, &fieldBeta)
+	lam.x.normalize()
+	lam.y.negate(&pd.y, 1)
+	lam.y.normalize()
+	got.addGEConst(&pj, &lam)
+	want.addGE(&pj, &lam)
+	if !jacobianEqual(&got, &want) {
+		t.Error("addGEConst does not handle the degenerate case")
+	}
+}
+
 func TestGroupElementBytes(t *testing.T) {
 	var buf [64]byte
 	var restored GroupElementAffine
@@ -118,6 +171,76 @@ func TestGroupElementBytes(t *testing.T) {
 	}
 }
 
+func TestGeSetAllGEJVar(t *testing.T) {
+	for _, n := range []int{0, 1, 2, 7, 16} {
+		a := make([]GroupElementJacobian, n)
+		for i := range a {
+			p := randomPoint(t)
+			a[i].setGE(&p)
+			a[i].double(&a[i]) // non-trivial z
+		}
+		// Infinity at the start, in the middle and at the end
+		for _, i := range []int{0, n / 2, n - 1} {
+			if i >= 0 && i < n && n > 2 {
+				a[i].setInfinity()
+			}
+		}
+
+		r := make([]GroupElementAffine, n)
+		geSetAllGEJVar(r, a)
+		for i := range a {
+			var want GroupElementAffine
+			want.setGEJVar(&a[i])
+			if !r[i].equal(&want) {
+				t.Fatalf("n = %d: entry %d differs from setGEJVar", n, i)
+			}
+		}
+
+		if n := testing.AllocsPerRun(10, func() { geSetAllGEJVar(r, a) }); n != 0 {
+			t.Errorf("geSetAllGEJVar: %v allocs, want 0", n)
+		}
+	}
+
+	// All infinity
+	a := make([]GroupElementJacobian, 3)
+	r := make([]GroupElementAffine, 3)
+	for i := range a {
+		a[i].setInfinity()
+	}
+	geSetAllGEJVar(r, a)
+	for i := range r {
+		if !r[i].isInfinity() {
+			t.Errorf("entry %d should be infinity", i)
+		}
+	}
+}
+
+func BenchmarkGeSetAllGEJVar(b *testing.B) {
+	const n = 64
+	var a [n]GroupElementJacobian
+	var r [n]GroupElementAffine
+	for i := range a {
+		p := randomPoint(b)
+		a[i].setGE(&p)
+		a[i].double(&a[i])
+	}
+
+	b.Run("batch", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			geSetAllGEJVar(r[:], a[:])
+		}
+	})
+	b.Run("single", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			for j := range a {
+				r[j].setGEJVar(&a[j])
+			}
+		}
+	})
+}
+
 func BenchmarkGroupDouble(b *testing.B) {
 	var jac GroupElementJacobian
 	jac.setGE(&Generator)
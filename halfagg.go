@@ -0,0 +1,187 @@
+package p256k1
+
+import (
+	"errors"
+	"hash"
+
+	sha256simd "github.com/minio/sha256-simd"
+)
+
+// Half-aggregation of BIP-340 signatures, following the draft BIP
+// "Half-Aggregation of BIP 340 signatures". n signatures (r_i, s_i) are
+// compressed to the 32*(n+1) bytes
+//
+//	r_0 || ... || r_{n-1} || s,  s = sum z_i*s_i
+//
+// where z_0 is 1 and z_i = int(hash_HalfAgg/randomizer(r_0 || pk_0 || m_0 ||
+// ... || r_i || pk_i || m_i)) mod n. The aggregate verifies if
+//
+//	s*G - sum z_i*R_i - sum z_i*e_i*P_i == infinity
+//
+// which is a single multi-scalar multiplication, as in SchnorrVerifyBatch.
+// Unlike a batch, an aggregate cannot tell which signature was invalid.
+
+// halfAggRandomizerTag domain-separates the half-aggregation randomizers
+var halfAggRandomizerTag = []byte("HalfAgg/randomizer")
+
+// HalfAggMaxSignatures is the largest number of signatures an aggregate may
+// hold, as in the draft BIP
+const HalfAggMaxSignatures = 1<<16 - 1
+
+// halfAggRandomizer is the running hash_HalfAgg/randomizer over the
+// (r, pk, m) of an aggregate
+type halfAggRandomizer struct {
+	h      hash.Hash
+	digest [32]byte
+}
+
+// newHalfAggRandomizer returns the randomizer hash of an empty aggregate
+func newHalfAggRandomizer() *halfAggRandomizer {
+	tag := getTaggedHashPrefix(halfAggRandomizerTag)
+	h := sha256simd.New()
+	h.Write(tag[:])
+	h.Write(tag[:])
+	return &halfAggRandomizer{h: h}
+}
+
+// next absorbs the (r, pk, m) at position i of the aggregate and sets z to
+// its randomizer
+func (hr *halfAggRandomizer) next(z *Scalar, i int, r32, pk32, msg32 []byte) {
+	hr.h.Write(r32)
+	hr.h.Write(pk32)
+	hr.h.Write(msg32)
+	if i == 0 {
+		z.setInt(1)
+		return
+	}
+	hr.h.Sum(hr.digest[:0])
+	z.setB32(hr.digest[:])
+}
+
+// SchnorrHalfAggregate aggregates the BIP-340 signatures sigs of msgs under
+// pubkeys into an aggregate of 32*(len(sigs)+1) bytes. The signatures are not
+// verified; an aggregate containing an invalid one fails SchnorrHalfAggVerify.
+// Each sigs[i] is 64 bytes and each msgs[i] is 32 bytes.
+func SchnorrHalfAggregate(sigs [][]byte, msgs [][]byte, pubkeys []*XOnlyPubkey) ([]byte, error) {
+	var empty [32]byte
+	return SchnorrHalfAggregateInc(empty[:], nil, nil, sigs, msgs, pubkeys)
+}
+
+// SchnorrHalfAggregateInc adds the signatures sigs of msgs under pubkeys to
+// the aggregate aggsig of aggMsgs under aggPubkeys, and returns the new
+// aggregate. Adding signatures one call at a time gives the same result as
+// aggregating them all at once. aggsig is not modified.
+func SchnorrHalfAggregateInc(aggsig []byte, aggMsgs [][]byte, aggPubkeys []*XOnlyPubkey, sigs [][]byte, msgs [][]byte, pubkeys []*XOnlyPubkey) ([]byte, error) {
+	u, v := len(aggMsgs), len(sigs)
+	if len(aggPubkeys) != u || len(aggsig) != 32*(u+1) {
+		return nil, errors.New("aggregate does not match its messages and public keys")
+	}
+	if len(msgs) != v || len(pubkeys) != v {
+		return nil, errors.New("sigs, msgs and pubkeys must have the same length")
+	}
+	if u+v > HalfAggMaxSignatures {
+		return nil, errors.New("too many signatures to aggregate")
+	}
+
+	var s Scalar
+	if s.setB32(aggsig[32*u:]) {
+		return nil, errors.New("invalid aggregate: s overflows the group order")
+	}
+
+	hr := newHalfAggRandomizer()
+	var z, si Scalar
+	for i := 0; i < u; i++ {
+		if len(aggMsgs[i]) != 32 || aggPubkeys[i] == nil {
+			return nil, errors.New("invalid aggregated message or public key")
+		}
+		hr.next(&z, i, aggsig[32*i:32*i+32], aggPubkeys[i].data[:], aggMsgs[i])
+	}
+
+	out := make([]byte, 32*(u+v+1))
+	copy(out, aggsig[:32*u])
+	for j := 0; j < v; j++ {
+		sig, msg, pk := sigs[j], msgs[j], pubkeys[j]
+		if len(sig) != 64 || len(msg) != 32 || pk == nil {
+			return nil, errors.New("invalid signature, message or public key")
+		}
+		if si.setB32(sig[32:]) {
+			return nil, errors.New("invalid signature: s overflows the group order")
+		}
+		hr.next(&z, u+j, sig[:32], pk.data[:], msg)
+		si.mul(&si, &z)
+		s.add(&s, &si)
+		copy(out[32*(u+j):], sig[:32])
+	}
+	s.getB32(out[32*(u+v):])
+	return out, nil
+}
+
+// SchnorrHalfAggVerify reports whether aggsig is a valid half-aggregate of
+// signatures of msgs under pubkeys
+func SchnorrHalfAggVerify(aggsig []byte, msgs [][]byte, pubkeys []*XOnlyPubkey) bool {
+	s := scratchPool.Get().(*Scratch)
+	defer scratchPool.Put(s)
+	return s.SchnorrHalfAggVerify(aggsig, msgs, pubkeys)
+}
+
+// SchnorrHalfAggVerify is SchnorrHalfAggVerify with its temporaries taken
+// from s
+func (s *Scratch) SchnorrHalfAggVerify(aggsig []byte, msgs [][]byte, pubkeys []*XOnlyPubkey) bool {
+	if s == nil {
+		return SchnorrHalfAggVerify(aggsig, msgs, pubkeys)
+	}
+	n := len(msgs)
+	if len(pubkeys) != n || len(aggsig) != 32*(n+1) || n > HalfAggMaxSignatures {
+		return false
+	}
+
+	var sum Scalar
+	if sum.setB32(aggsig[32*n:]) {
+		return false
+	}
+	if n == 0 {
+		return sum.isZero()
+	}
+
+	cp := s.Checkpoint()
+	defer s.Rollback(cp)
+
+	// points[2i] and points[2i+1] hold R_i and P_i
+	points := s.affine.alloc(2 * n)
+	scalars := s.scalars.alloc(2 * n)
+	r32s := s.bytes.alloc(n)
+	pk32s := s.bytes.alloc(n)
+	for i := 0; i < n; i++ {
+		pk := pubkeys[i]
+		if len(msgs[i]) != 32 || pk == nil {
+			return false
+		}
+		r32 := aggsig[32*i : 32*i+32]
+		var rx FieldElement
+		if !rx.setB32Limit(r32) || !points[2*i].setXOVar(&rx, false) {
+			return false
+		}
+		if !xonlyPubkeyLoad(&points[2*i+1], &pk.data) {
+			return false
+		}
+		r32s[i] = r32
+		pk32s[i] = pk.data[:]
+	}
+
+	// e_i = int(hash_BIP0340/challenge(r_i || P_i || m_i)) mod n
+	challenges := s.scalars.alloc(n)
+	bip340ChallengeBatch(challenges, r32s, pk32s, msgs)
+
+	hr := newHalfAggRandomizer()
+	var z, t Scalar
+	for i := 0; i < n; i++ {
+		hr.next(&z, i, r32s[i], pk32s[i], msgs[i])
+		scalars[2*i].negate(&z)
+		t.mul(&z, &challenges[i])
+		scalars[2*i+1].negate(&t)
+	}
+
+	var r GroupElementJacobian
+	ecmultMultiVar(s, &r, points, scalars, &sum)
+	return r.isInfinity()
+}
@@ -0,0 +1,131 @@
+package p256k1
+
+import (
+	"bytes"
+	"fmt"
+	"testing"
+)
+
+func TestSchnorrHalfAggregate(t *testing.T) {
+	for _, n := range []int{0, 1, 2, 7, 33} {
+		sigs, msgs, pubkeys := makeSchnorrBatch(t, n)
+		agg, err := SchnorrHalfAggregate(sigs, msgs, pubkeys)
+		if err != nil {
+			t.Fatalf("n=%d: %v", n, err)
+		}
+		if len(agg) != 32*(n+1) {
+			t.Fatalf("n=%d: aggregate is %d bytes", n, len(agg))
+		}
+		if !SchnorrHalfAggVerify(agg, msgs, pubkeys) {
+			t.Fatalf("n=%d: valid aggregate rejected", n)
+		}
+
+		// Aggregating one signature at a time gives the same aggregate
+		inc := make([]byte, 32)
+		for i := 0; i < n; i++ {
+			inc, err = SchnorrHalfAggregateInc(inc, msgs[:i], pubkeys[:i], sigs[i:i+1], msgs[i:i+1], pubkeys[i:i+1])
+			if err != nil {
+				t.Fatalf("n=%d: incremental step %d: %v", n, i, err)
+			}
+		}
+		if !bytes.Equal(inc, agg) {
+			t.Fatalf("n=%d: incremental aggregate differs", n)
+		}
+	}
+
+	// An aggregate of one signature is the signature itself, as z_0 is 1
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 1)
+	agg, _ := SchnorrHalfAggregate(sigs, msgs, pubkeys)
+	if !bytes.Equal(agg, sigs[0]) {
+		t.Error("aggregate of one signature differs from it")
+	}
+}
+
+func TestSchnorrHalfAggVerifyInvalid(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 8)
+	agg, err := SchnorrHalfAggregate(sigs, msgs, pubkeys)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	for i := 0; i < len(agg); i += 13 {
+		bad := append([]byte(nil), agg...)
+		bad[i] ^= 1
+		if SchnorrHalfAggVerify(bad, msgs, pubkeys) {
+			t.Errorf("aggregate with byte %d flipped accepted", i)
+		}
+	}
+
+	msgs[3] = append([]byte(nil), msgs[3]...)
+	msgs[3][0] ^= 1
+	if SchnorrHalfAggVerify(agg, msgs, pubkeys) {
+		t.Error("aggregate accepted for a wrong message")
+	}
+	msgs[3][0] ^= 1
+
+	// Swapping two entries changes their randomizers
+	swapped := append([]byte(nil), agg...)
+	copy(swapped[32:64], agg[64:96])
+	copy(swapped[64:96], agg[32:64])
+	msgs[1], msgs[2] = msgs[2], msgs[1]
+	pubkeys[1], pubkeys[2] = pubkeys[2], pubkeys[1]
+	if SchnorrHalfAggVerify(swapped, msgs, pubkeys) {
+		t.Error("reordered aggregate accepted")
+	}
+	msgs[1], msgs[2] = msgs[2], msgs[1]
+	pubkeys[1], pubkeys[2] = pubkeys[2], pubkeys[1]
+
+	if SchnorrHalfAggVerify(agg, msgs[:7], pubkeys[:7]) || SchnorrHalfAggVerify(agg[:len(agg)-1], msgs, pubkeys) {
+		t.Error("aggregate accepted with mismatched lengths")
+	}
+
+	// An invalid signature gives an invalid aggregate
+	sigs[5] = append([]byte(nil), sigs[5]...)
+	sigs[5][63] ^= 1
+	agg, err = SchnorrHalfAggregate(sigs, msgs, pubkeys)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if SchnorrHalfAggVerify(agg, msgs, pubkeys) {
+		t.Error("aggregate of an invalid signature accepted")
+	}
+
+	// s of the empty aggregate must be zero, and s must be below the order
+	var s [32]byte
+	s[31] = 1
+	if SchnorrHalfAggVerify(s[:], nil, nil) {
+		t.Error("empty aggregate with nonzero s accepted")
+	}
+	high := bytes.Repeat([]byte{0xff}, 32)
+	if SchnorrHalfAggVerify(high, nil, nil) {
+		t.Error("aggregate with s above the order accepted")
+	}
+	if _, err := SchnorrHalfAggregateInc(high, nil, nil, sigs, msgs, pubkeys); err == nil {
+		t.Error("extended an aggregate with s above the order")
+	}
+	if _, err := SchnorrHalfAggregate(sigs, msgs[:3], pubkeys); err == nil {
+		t.Error("aggregated with mismatched lengths")
+	}
+}
+
+func BenchmarkSchnorrHalfAggVerify(b *testing.B) {
+	for _, n := range []int{1, 8, 64, 256} {
+		sigs, msgs, pubkeys := makeSchnorrBatch(b, n)
+		agg, err := SchnorrHalfAggregate(sigs, msgs, pubkeys)
+		if err != nil {
+			b.Fatal(err)
+		}
+		b.Run(fmt.Sprintf("n=%d", n), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				if !SchnorrHalfAggVerify(agg, msgs, pubkeys) {
+					b.Fatal("aggregate verification failed")
+				}
+			}
+		})
+		b.Run(fmt.Sprintf("n=%d/aggregate", n), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				SchnorrHalfAggregate(sigs, msgs, pubkeys)
+			}
+		})
+	}
+}
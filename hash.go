@@ -2,6 +2,7 @@ package p256k1
 
 import (
 	"crypto/sha256"
+	"encoding"
 	"errors"
 	"hash"
 	"sync"
@@ -30,21 +31,213 @@ func getTaggedHashPrefix(tag []byte) [32]byte {
 	taggedHashInitOnce.Do(initTaggedHashPrefixes)
 
 	// Fast path for common BIP-340 tags
-	if len(tag) == 13 {
-		switch string(tag) {
-		case "BIP0340/aux":
-			return bip340AuxTagHash
-		case "BIP0340/nonce":
-			return bip340NonceTagHash
-		case "BIP0340/challenge":
-			return bip340ChallengeTagHash
-		}
+	switch string(tag) {
+	case "BIP0340/aux":
+		return bip340AuxTagHash
+	case "BIP0340/nonce":
+		return bip340NonceTagHash
+	case "BIP0340/challenge":
+		return bip340ChallengeTagHash
 	}
 
 	// Fallback for unknown tags
 	return sha256.Sum256(tag)
 }
 
+// SHA256 midstates after absorbing SHA256(tag) || SHA256(tag) for the BIP-340
+// tags. The prefix is exactly one block, so restoring a midstate skips its
+// compression entirely.
+var (
+	bip340AuxMidstate       []byte
+	bip340NonceMidstate     []byte
+	bip340ChallengeMidstate []byte
+	taggedMidstateInitOnce  sync.Once
+)
+
+func initTaggedHashMidstates() {
+	taggedHashInitOnce.Do(initTaggedHashPrefixes)
+	bip340AuxMidstate = taggedHashMidstate(&bip340AuxTagHash)
+	bip340NonceMidstate = taggedHashMidstate(&bip340NonceTagHash)
+	bip340ChallengeMidstate = taggedHashMidstate(&bip340ChallengeTagHash)
+}
+
+// taggedHashMidstate returns the marshaled SHA256 state after hashing
+// tagHash twice
+func taggedHashMidstate(tagHash *[32]byte) []byte {
+	h := sha256.New()
+	h.Write(tagHash[:])
+	h.Write(tagHash[:])
+	state, err := h.(encoding.BinaryMarshaler).MarshalBinary()
+	if err != nil {
+		panic(err)
+	}
+	return state
+}
+
+// taggedHasher is a pooled SHA256 context for tagged hashes. Input is staged
+// through buf, which lives on the heap with the hasher, so that callers'
+// buffers do not escape through the hash.Hash interface and hashing performs
+// no allocations.
+type taggedHasher struct {
+	h   hash.Hash
+	buf [64]byte
+	n   int
+
+	// ms stages marshaled states for save and restore
+	ms [sha256MidstateLen]byte
+}
+
+var taggedHasherPool = sync.Pool{
+	New: func() interface{} { return &taggedHasher{h: sha256.New()} },
+}
+
+// getTaggedHasher returns a pooled hasher positioned after the one-block
+// prefix described by midstate
+func getTaggedHasher(midstate []byte) *taggedHasher {
+	t := taggedHasherPool.Get().(*taggedHasher)
+	t.reset(midstate)
+	return t
+}
+
+// reset discards any input and positions t after the prefix described by
+// midstate again
+func (t *taggedHasher) reset(midstate []byte) {
+	if err := t.h.(encoding.BinaryUnmarshaler).UnmarshalBinary(midstate); err != nil {
+		panic(err)
+	}
+	t.n = 0
+}
+
+// binaryAppender is encoding.BinaryAppender, which crypto/sha256 implements
+// from Go 1.24 on
+type binaryAppender interface {
+	AppendBinary(b []byte) ([]byte, error)
+}
+
+// save stores the state of t, which must have no staged input, in ms.
+// Going through t.ms keeps ms from escaping through the interface call.
+func (t *taggedHasher) save(ms *[sha256MidstateLen]byte) {
+	var state []byte
+	var err error
+	if a, ok := t.h.(binaryAppender); ok {
+		state, err = a.AppendBinary(t.ms[:0])
+	} else {
+		state, err = t.h.(encoding.BinaryMarshaler).MarshalBinary()
+	}
+	if err != nil || len(state) != sha256MidstateLen {
+		panic("unexpected sha256 state")
+	}
+	copy(ms[:], state)
+}
+
+// restore discards any input and sets the state of t to ms
+func (t *taggedHasher) restore(ms *[sha256MidstateLen]byte) {
+	copy(t.ms[:], ms[:])
+	t.reset(t.ms[:])
+}
+
+// clearState wipes the secret dependent state left in t
+func (t *taggedHasher) clearState() {
+	memclear(unsafe.Pointer(&t.ms[0]), uintptr(len(t.ms)))
+	t.h.Reset()
+}
+
+// getTaggedHasherForTag returns a pooled hasher positioned after
+// SHA256(tag) || SHA256(tag). The BIP-340 tags restore their precomputed
+// midstates; any other tag is hashed and absorbed from scratch.
+func getTaggedHasherForTag(tag []byte) *taggedHasher {
+	taggedMidstateInitOnce.Do(initTaggedHashMidstates)
+
+	switch string(tag) {
+	case "BIP0340/aux":
+		return getTaggedHasher(bip340AuxMidstate)
+	case "BIP0340/nonce":
+		return getTaggedHasher(bip340NonceMidstate)
+	case "BIP0340/challenge":
+		return getTaggedHasher(bip340ChallengeMidstate)
+	}
+
+	tagHash := sha256.Sum256(tag)
+	t := taggedHasherPool.Get().(*taggedHasher)
+	t.h.Reset()
+	t.n = 0
+	t.write(tagHash[:])
+	t.write(tagHash[:])
+	return t
+}
+
+// write adds p to the hash
+func (t *taggedHasher) write(p []byte) {
+	for len(p) > 0 {
+		c := copy(t.buf[t.n:], p)
+		t.n += c
+		p = p[c:]
+		if t.n == len(t.buf) {
+			t.h.Write(t.buf[:])
+			t.n = 0
+		}
+	}
+}
+
+// sum writes the hash to out32 and clears the staged input. t must be reset
+// before it is written to again.
+func (t *taggedHasher) sum(out32 []byte) {
+	if t.n > 0 {
+		t.h.Write(t.buf[:t.n])
+	}
+	sum := t.h.Sum(t.buf[:0])
+	copy(out32, sum)
+	memclear(unsafe.Pointer(&t.buf[0]), uintptr(len(t.buf)))
+	t.n = 0
+}
+
+// finalize writes the hash to out32, clears the staged input and returns the
+// hasher to the pool
+func (t *taggedHasher) finalize(out32 []byte) {
+	t.sum(out32)
+	taggedHasherPool.Put(t)
+}
+
+// bip340Challenge sets e = int(hash_BIP0340/challenge(r32 || pk32 || msg))
+// mod n. msg may have any length.
+func bip340Challenge(e *Scalar, r32, pk32, msg []byte) {
+	taggedMidstateInitOnce.Do(initTaggedHashMidstates)
+
+	var digest [32]byte
+	h := getTaggedHasher(bip340ChallengeMidstate)
+	h.write(r32[:32])
+	h.write(pk32[:32])
+	h.write(msg)
+	h.finalize(digest[:])
+	e.setB32(digest[:])
+}
+
+// bip340ChallengeBatch sets e[i] to the BIP-340 challenge of r32s[i],
+// pk32s[i] and msgs[i] for every i; all four slices must have the same
+// length. One hasher serves the whole batch and is restored to the
+// challenge midstate for each entry, so only the entry's own input is
+// compressed.
+func bip340ChallengeBatch(e []Scalar, r32s, pk32s, msgs [][]byte) {
+	if len(e) == 0 {
+		return
+	}
+	taggedMidstateInitOnce.Do(initTaggedHashMidstates)
+
+	var digest [32]byte
+	h := getTaggedHasher(bip340ChallengeMidstate)
+	for i := range e {
+		if i > 0 {
+			h.reset(bip340ChallengeMidstate)
+		}
+		h.write(r32s[i][:32])
+		h.write(pk32s[i][:32])
+		h.write(msgs[i])
+		h.sum(digest[:])
+		e[i].setB32(digest[:])
+	}
+	taggedHasherPool.Put(h)
+}
+
 // SHA256 represents a SHA-256 hash context
 type SHA256 struct {
 	hasher hash.Hash
@@ -165,16 +358,92 @@ func (h *HMACSHA256) Clear() {
 	memclear(unsafe.Pointer(h), unsafe.Sizeof(*h))
 }
 
-// RFC6979HMACSHA256 implements RFC 6979 deterministic nonce generation
+// sha256MidstateLen is the length of a marshaled crypto/sha256 state
+const sha256MidstateLen = 108
+
+// hmacSHA256Key is an HMAC-SHA256 key prepared as the SHA256 states after
+// absorbing K^ipad and K^opad, so an HMAC under it restores them instead of
+// compressing the padded key twice. Used with a pooled taggedHasher it
+// performs no allocations.
+type hmacSHA256Key struct {
+	inner, outer [sha256MidstateLen]byte
+}
+
+// init prepares key, hashing it first if it is longer than a block
+func (k *hmacSHA256Key) init(h *taggedHasher, key []byte) {
+	var pad [64]byte
+	if len(key) > len(pad) {
+		h.h.Reset()
+		h.n = 0
+		h.write(key)
+		h.sum(pad[:32])
+	} else {
+		copy(pad[:], key)
+	}
+	for i := range pad {
+		pad[i] ^= 0x36
+	}
+	h.h.Reset()
+	h.n = 0
+	h.write(pad[:])
+	h.save(&k.inner)
+
+	for i := range pad {
+		pad[i] ^= 0x36 ^ 0x5c
+	}
+	h.h.Reset()
+	h.write(pad[:])
+	h.save(&k.outer)
+	memclear(unsafe.Pointer(&pad), unsafe.Sizeof(pad))
+}
+
+// start positions h at the start of a message authenticated under k
+func (k *hmacSHA256Key) start(h *taggedHasher) {
+	h.restore(&k.inner)
+}
+
+// finish writes the HMAC of the message written to h since start to out32
+func (k *hmacSHA256Key) finish(h *taggedHasher, out32 []byte) {
+	var inner [32]byte
+	h.sum(inner[:])
+	h.restore(&k.outer)
+	h.write(inner[:])
+	h.sum(out32)
+	memclear(unsafe.Pointer(&inner), unsafe.Sizeof(inner))
+}
+
+// clear wipes k
+func (k *hmacSHA256Key) clear() {
+	memclear(unsafe.Pointer(k), unsafe.Sizeof(*k))
+}
+
+// RFC6979HMACSHA256 implements RFC 6979 deterministic nonce generation.
+// The HMAC key K only changes in the K update steps, so the SHA256 states
+// after absorbing K^ipad and K^opad are computed once per update and every
+// HMAC_K restores them instead of compressing the padded key again. All
+// state is held in the struct, and the hashing goes through a pooled hasher,
+// so a context declared as a local variable and set up with init performs no
+// allocations.
 type RFC6979HMACSHA256 struct {
 	v     [32]byte
 	k     [32]byte
 	retry int
+
+	// inner and outer are the marshaled SHA256 states after K^ipad and
+	// K^opad
+	inner, outer [sha256MidstateLen]byte
 }
 
 // NewRFC6979HMACSHA256 initializes a new RFC6979 HMAC-SHA256 context
 func NewRFC6979HMACSHA256(key []byte) *RFC6979HMACSHA256 {
 	rng := &RFC6979HMACSHA256{}
+	rng.init(key)
+	return rng
+}
+
+// init sets up rng for key, as secp256k1_rfc6979_hmac_sha256_initialize
+func (rng *RFC6979HMACSHA256) init(key []byte) {
+	h := taggedHasherPool.Get().(*taggedHasher)
 
 	// RFC6979 3.2.b: V = 0x01 0x01 0x01 ... 0x01 (32 bytes)
 	for i := 0; i < 32; i++ {
@@ -182,76 +451,83 @@ func NewRFC6979HMACSHA256(key []byte) *RFC6979HMACSHA256 {
 	}
 
 	// RFC6979 3.2.c: K = 0x00 0x00 0x00 ... 0x00 (32 bytes)
-	for i := 0; i < 32; i++ {
-		rng.k[i] = 0x00
-	}
+	rng.k = [32]byte{}
+	rng.setK(h)
+
+	// RFC6979 3.2.d: K = HMAC_K(V || 0x00 || key), V = HMAC_K(V)
+	rng.hmac(h, rng.k[:], 0x00, key)
+	rng.setK(h)
+	rng.hmac(h, rng.v[:], -1, nil)
 
-	// RFC6979 3.2.d: K = HMAC_K(V || 0x00 || key)
-	hmac := NewHMACSHA256(rng.k[:])
-	hmac.Write(rng.v[:])
-	hmac.Write([]byte{0x00})
-	hmac.Write(key)
-	hmac.Finalize(rng.k[:])
-	hmac.Clear()
-
-	// V = HMAC_K(V)
-	hmac = NewHMACSHA256(rng.k[:])
-	hmac.Write(rng.v[:])
-	hmac.Finalize(rng.v[:])
-	hmac.Clear()
-
-	// RFC6979 3.2.f: K = HMAC_K(V || 0x01 || key)
-	hmac = NewHMACSHA256(rng.k[:])
-	hmac.Write(rng.v[:])
-	hmac.Write([]byte{0x01})
-	hmac.Write(key)
-	hmac.Finalize(rng.k[:])
-	hmac.Clear()
-
-	// V = HMAC_K(V)
-	hmac = NewHMACSHA256(rng.k[:])
-	hmac.Write(rng.v[:])
-	hmac.Finalize(rng.v[:])
-	hmac.Clear()
+	// RFC6979 3.2.f: K = HMAC_K(V || 0x01 || key), V = HMAC_K(V)
+	rng.hmac(h, rng.k[:], 0x01, key)
+	rng.setK(h)
+	rng.hmac(h, rng.v[:], -1, nil)
 
 	rng.retry = 0
-	return rng
+	h.clearState()
+	taggedHasherPool.Put(h)
+}
+
+// setK recomputes the inner and outer midstates for the current K
+func (rng *RFC6979HMACSHA256) setK(h *taggedHasher) {
+	var pad [64]byte
+	copy(pad[:], rng.k[:])
+	for i := range pad {
+		pad[i] ^= 0x36
+	}
+	h.h.Reset()
+	h.n = 0
+	h.write(pad[:])
+	h.save(&rng.inner)
+
+	for i := range pad {
+		pad[i] ^= 0x36 ^ 0x5c
+	}
+	h.h.Reset()
+	h.write(pad[:])
+	h.save(&rng.outer)
+	memclear(unsafe.Pointer(&pad), unsafe.Sizeof(pad))
+}
+
+// hmac sets out32 = HMAC_K(V || sep || data), leaving out sep if it is
+// negative
+func (rng *RFC6979HMACSHA256) hmac(h *taggedHasher, out32 []byte, sep int, data []byte) {
+	var inner [32]byte
+	h.restore(&rng.inner)
+	h.write(rng.v[:])
+	if sep >= 0 {
+		h.write([]byte{byte(sep)})
+	}
+	h.write(data)
+	h.sum(inner[:])
+
+	h.restore(&rng.outer)
+	h.write(inner[:])
+	h.sum(out32)
+	memclear(unsafe.Pointer(&inner), unsafe.Sizeof(inner))
 }
 
 // Generate generates output bytes using RFC6979
 func (rng *RFC6979HMACSHA256) Generate(out []byte) {
+	h := taggedHasherPool.Get().(*taggedHasher)
+
 	// RFC6979 3.2.h: If retry, update K and V
 	if rng.retry != 0 {
-		hmac := NewHMACSHA256(rng.k[:])
-		hmac.Write(rng.v[:])
-		hmac.Write([]byte{0x00})
-		hmac.Finalize(rng.k[:])
-		hmac.Clear()
-
-		hmac = NewHMACSHA256(rng.k[:])
-		hmac.Write(rng.v[:])
-		hmac.Finalize(rng.v[:])
-		hmac.Clear()
+		rng.hmac(h, rng.k[:], 0x00, nil)
+		rng.setK(h)
+		rng.hmac(h, rng.v[:], -1, nil)
 	}
 
 	// Generate output bytes
-	outlen := len(out)
-	for outlen > 0 {
-		hmac := NewHMACSHA256(rng.k[:])
-		hmac.Write(rng.v[:])
-		hmac.Finalize(rng.v[:])
-		hmac.Clear()
-
-		now := outlen
-		if now > 32 {
-			now = 32
-		}
-		copy(out, rng.v[:now])
-		out = out[now:]
-		outlen -= now
+	for len(out) > 0 {
+		rng.hmac(h, rng.v[:], -1, nil)
+		out = out[copy(out, rng.v[:]):]
 	}
 
 	rng.retry = 1
+	h.clearState()
+	taggedHasherPool.Put(h)
 }
 
 // Finalize finalizes the RFC6979 context
@@ -266,34 +542,15 @@ func (rng *RFC6979HMACSHA256) Clear() {
 
 // TaggedHash computes SHA256(SHA256(tag) || SHA256(tag) || data)
 // This is used in BIP-340 for Schnorr signatures
-// Optimized to use precomputed tag hashes for common BIP-340 tags
-// Global pre-allocated hash context for TaggedHash to avoid allocations
-var (
-	taggedHashContext     hash.Hash
-	taggedHashContextOnce sync.Once
-)
-
-func getTaggedHashContext() hash.Hash {
-	taggedHashContextOnce.Do(func() {
-		taggedHashContext = sha256.New()
-	})
-	return taggedHashContext
-}
-
+// Each call takes its own hasher from a pool, so TaggedHash is safe for
+// concurrent use and does not allocate; the BIP-340 tags start from
+// precomputed midstates and never rehash the 64-byte tag prefix.
 func TaggedHash(tag []byte, data []byte) [32]byte {
 	var result [32]byte
 
-	// Get precomputed SHA256(tag) prefix (or compute if not cached)
-	tagHash := getTaggedHashPrefix(tag)
-
-	// Second hash: SHA256(SHA256(tag) || SHA256(tag) || data)
-	// Use pre-allocated hash context to avoid allocations
-	h := getTaggedHashContext()
-	h.Reset()
-	h.Write(tagHash[:]) // SHA256(tag)
-	h.Write(tagHash[:]) // SHA256(tag) again
-	h.Write(data)       // data
-	h.Sum(result[:0])   // Sum directly into result without allocation
+	h := getTaggedHasherForTag(tag)
+	h.write(data)
+	h.finalize(result[:])
 
 	return result
 }
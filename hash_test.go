@@ -1,6 +1,10 @@
 package p256k1
 
 import (
+	"bytes"
+	"crypto/hmac"
+	"crypto/sha256"
+	"sync"
 	"testing"
 )
 
@@ -82,6 +86,72 @@ func TestRFC6979(t *testing.T) {
 	rng.Clear()
 }
 
+// rfc6979Reference is the RFC 6979 HMAC-DRBG written directly with
+// crypto/hmac, generating count 32 byte outputs
+func rfc6979Reference(key []byte, count int) [][]byte {
+	mac := func(k []byte, parts ...[]byte) []byte {
+		h := hmac.New(sha256.New, k)
+		for _, p := range parts {
+			h.Write(p)
+		}
+		return h.Sum(nil)
+	}
+	v := bytes.Repeat([]byte{0x01}, 32)
+	k := make([]byte, 32)
+	k = mac(k, v, []byte{0x00}, key)
+	v = mac(k, v)
+	k = mac(k, v, []byte{0x01}, key)
+	v = mac(k, v)
+
+	var out [][]byte
+	for i := 0; i < count; i++ {
+		if i > 0 {
+			k = mac(k, v, []byte{0x00})
+			v = mac(k, v)
+		}
+		v = mac(k, v)
+		out = append(out, v)
+	}
+	return out
+}
+
+func TestRFC6979Reference(t *testing.T) {
+	for _, keyLen := range []int{0, 32, 64, 100} {
+		key := make([]byte, keyLen)
+		for i := range key {
+			key[i] = byte(i*7 + keyLen)
+		}
+		want := rfc6979Reference(key, 3)
+		rng := NewRFC6979HMACSHA256(key)
+		for i := range want {
+			var got [32]byte
+			rng.Generate(got[:])
+			if !bytes.Equal(got[:], want[i]) {
+				t.Errorf("key length %d, output %d: got %x, want %x", keyLen, i, got, want[i])
+			}
+		}
+		rng.Clear()
+	}
+
+	// A context on the stack allocates nothing where sha256 states can be
+	// appended to a buffer
+	if _, ok := sha256.New().(binaryAppender); !ok {
+		return
+	}
+	key := make([]byte, 64)
+	n := testing.AllocsPerRun(100, func() {
+		var rng RFC6979HMACSHA256
+		var nonce [32]byte
+		rng.init(key)
+		rng.Generate(nonce[:])
+		rng.Generate(nonce[:])
+		rng.Clear()
+	})
+	if n != 0 {
+		t.Errorf("RFC6979: %v allocs, want 0", n)
+	}
+}
+
 func TestTaggedHash(t *testing.T) {
 	// Test tagged hash function
 	tag := []byte("BIP0340/challenge")
@@ -102,6 +172,69 @@ func TestTaggedHash(t *testing.T) {
 	}
 }
 
+// taggedHashReference computes a tagged hash without the midstate engine
+func taggedHashReference(tag, data []byte) [32]byte {
+	tagHash := sha256.Sum256(tag)
+	h := sha256.New()
+	h.Write(tagHash[:])
+	h.Write(tagHash[:])
+	h.Write(data)
+	var out [32]byte
+	h.Sum(out[:0])
+	return out
+}
+
+func TestTaggedHashConcurrent(t *testing.T) {
+	tags := [][]byte{
+		[]byte("BIP0340/aux"),
+		[]byte("BIP0340/nonce"),
+		[]byte("BIP0340/challenge"),
+		[]byte("TapLeaf"),
+		{},
+	}
+	// Lengths straddling the 64-byte staging buffer
+	lengths := []int{0, 1, 32, 63, 64, 65, 96, 200}
+
+	var wg sync.WaitGroup
+	errs := make(chan string, 16)
+	for g := 0; g < 16; g++ {
+		wg.Add(1)
+		go func(g int) {
+			defer wg.Done()
+			for i := 0; i < 50; i++ {
+				for _, tag := range tags {
+					for _, n := range lengths {
+						data := bytes.Repeat([]byte{byte(g + i + n)}, n)
+						got := TaggedHash(tag, data)
+						if got != taggedHashReference(tag, data) {
+							errs <- string(tag)
+							return
+						}
+					}
+				}
+			}
+		}(g)
+	}
+	wg.Wait()
+	close(errs)
+	for tag := range errs {
+		t.Fatalf("TaggedHash(%q) mismatch under concurrent use", tag)
+	}
+}
+
+func TestTaggedHashAllocs(t *testing.T) {
+	tag := []byte("BIP0340/challenge")
+	other := []byte("TapBranch")
+	data := make([]byte, 96)
+	TaggedHash(tag, data)
+	if n := testing.AllocsPerRun(100, func() { TaggedHash(tag, data) }); n != 0 {
+		t.Errorf("TaggedHash with a BIP-340 tag: %v allocs, want 0", n)
+	}
+	if n := testing.AllocsPerRun(100, func() { TaggedHash(other, data) }); n != 0 {
+		t.Errorf("TaggedHash with another tag: %v allocs, want 0", n)
+	}
+}
+
 func TestHashToScalar(t *testing.T) {
 	hash := make([]byte, 32)
 	for i := 0; i < 32; i++ {
@@ -49,6 +49,19 @@ extern "C" {
  */
 typedef struct secp256k1_context_struct secp256k1_context;
 
+/** Opaque data structure that holds rewritable "scratch space"
+ *
+ *  The purpose of this structure is to replace dynamic memory allocations,
+ *  because we target architectures where this may not be available. It is
+ *  essentially a block of bytes of fixed maximum size, created by
+ *  secp256k1_scratch_space_create, from which the library takes its
+ *  temporaries.
+ *
+ *  Unlike the context object, this cannot safely be shared between threads
+ *  without additional synchronization logic.
+ */
+typedef struct secp256k1_scratch_space_struct secp256k1_scratch_space;
+
 /** Opaque data structure that holds a parsed and valid public key.
  *
  *  The exact representation of data inside is implementation defined and not
@@ -403,6 +416,29 @@ SECP256K1_API void secp256k1_context_set_error_callback(
     const void *data
 ) SECP256K1_ARG_NONNULL(1);
 
+/** Create a secp256k1 scratch space object.
+ *
+ *  Returns: a newly created scratch space.
+ *  Args: ctx:  pointer to a context object.
+ *  In:   size: amount of memory to be available as scratch space. Some extra
+ *              (<100 bytes) will be allocated for extra accounting.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_scratch_space *secp256k1_scratch_space_create(
+    const secp256k1_context *ctx,
+    size_t size
+) SECP256K1_ARG_NONNULL(1);
+
+/** Destroy a secp256k1 scratch space.
+ *
+ *  The pointer may not be used afterwards.
+ *  Args:       ctx: pointer to a context object.
+ *          scratch: space to destroy
+ */
+SECP256K1_API void secp256k1_scratch_space_destroy(
+    const secp256k1_context *ctx,
+    secp256k1_scratch_space *scratch
+) SECP256K1_ARG_NONNULL(1);
+
 /** Parse a variable-length public key into the pubkey object.
  *
  *  Returns: 1 if the public key was fully valid.
@@ -476,6 +512,28 @@ SECP256K1_API int secp256k1_ec_pubkey_sort(
     size_t n_pubkeys
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
 
+/** Sort public keys like secp256k1_ec_pubkey_sort, serializing each key only once
+ *
+ *  secp256k1_ec_pubkey_sort serializes both keys on every comparison. This
+ *  function serializes each key once into the scratch space and radix sorts
+ *  the serializations, which is much faster for large arrays. The resulting
+ *  order is the same. If scratch is NULL or too small for 2*n_pubkeys entries
+ *  of 16 bytes, this falls back to secp256k1_ec_pubkey_sort.
+ *
+ *  Returns: 0 if the arguments are invalid. 1 otherwise.
+ *
+ *  Args:     ctx: pointer to a context object
+ *        scratch: scratch space for the sort (can be NULL)
+ *  In:   pubkeys: array of pointers to pubkeys to sort
+ *      n_pubkeys: number of elements in the pubkeys array
+ */
+SECP256K1_API int secp256k1_ec_pubkey_sort_scratch(
+    const secp256k1_context *ctx,
+    secp256k1_scratch_space *scratch,
+    const secp256k1_pubkey **pubkeys,
+    size_t n_pubkeys
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3);
+
 /** Parse an ECDSA signature in compact (64 bytes) format.
  *
  *  Returns: 1 when the signature could be parsed, 0 otherwise.
@@ -855,6 +913,40 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_combine(
     size_t n
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Compute a weighted sum of public keys in a single multi-scalar multiplication.
+ *
+ *  Sets out to g_scalar*G + scalars[0]*points[0] + ... + scalars[n-1]*points[n-1].
+ *  Depending on n and the size of the scratch space this uses Strauss' or
+ *  Pippenger's algorithm, which is much faster than one secp256k1_ec_pubkey_tweak_mul
+ *  per key followed by secp256k1_ec_pubkey_combine. The computation is not
+ *  constant time, so the scalars must not be secret.
+ *
+ *  Returns: 1: the sum is a valid public key.
+ *           0: a scalar overflows the group order or the sum is the point
+ *              at infinity.
+ *  Args:    ctx:      pointer to a context object.
+ *           scratch:  scratch space for the temporaries (can be NULL). If it is
+ *                     NULL or too small for a single batch, the points are
+ *                     multiplied one at a time.
+ *  Out:     out:      pointer to a public key object for placing the result.
+ *  In:      points:   pointer to an array of n pointers to public keys (can be
+ *                     NULL if n is 0).
+ *           scalars:  pointer to an array of n pointers to 32-byte big endian
+ *                     scalars (can be NULL if n is 0).
+ *           n:        the number of points.
+ *           g_scalar: pointer to a 32-byte big endian scalar for the generator
+ *                     (can be NULL, which means zero).
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecmult_multi(
+    const secp256k1_context *ctx,
+    secp256k1_scratch_space *scratch,
+    secp256k1_pubkey *out,
+    const secp256k1_pubkey * const *points,
+    const unsigned char * const *scalars,
+    size_t n,
+    const unsigned char *g_scalar
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3);
+
 /** Compute a tagged hash as defined in BIP-340.
  *
  *  This is useful for creating a message hash and achieving domain separation
@@ -155,6 +155,37 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_tweak_add_
     const unsigned char *tweak32
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
 
+/** Checks many tweaked pubkeys at once, each as secp256k1_xonly_pubkey_tweak_add_check.
+ *
+ *  All n equations Q_i = P_i + t_i*G are combined with random factors a_i into
+ *  sum(a_i*t_i)*G + sum(a_i*(P_i - Q_i)) = 0 and evaluated with one
+ *  multi-scalar multiplication, which is faster than n single checks.
+ *  The factors are derived from a hash of all inputs. If the batch fails,
+ *  check the entries one by one to find the invalid ones.
+ *
+ *  Returns: 1 if every tweaked pubkey is the result of tweaking its internal
+ *           pubkey with its tweak (always for n = 0); 0 otherwise or if the
+ *           arguments are invalid.
+ *  Args:             ctx: pointer to a context object.
+ *                scratch: scratch space for the multiplication (can be NULL,
+ *                         which is slower for large n).
+ *  In: tweaked_pubkey32s: array of n pointers to serialized xonly_pubkeys.
+ *    tweaked_pk_parities: array of n parities of the tweaked pubkeys.
+ *       internal_pubkeys: array of n pointers to the internal x-only public keys.
+ *               tweaks32: array of n pointers to 32-byte tweaks.
+ *                      n: the number of checks (can be 0, in which case the
+ *                         arrays can be NULL).
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_tweak_add_check_batch(
+    const secp256k1_context *ctx,
+    secp256k1_scratch_space *scratch,
+    const unsigned char *const *tweaked_pubkey32s,
+    const int *tweaked_pk_parities,
+    const secp256k1_xonly_pubkey *const *internal_pubkeys,
+    const unsigned char *const *tweaks32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 /** Compute the keypair for a valid secret key.
  *
  *  See the documentation of `secp256k1_ec_seckey_verify` for more information
@@ -183,6 +183,105 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify(
     const secp256k1_xonly_pubkey *pubkey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(5);
 
+/** Verify a batch of Schnorr signatures.
+ *
+ *  All n signatures are checked at once with one multi-scalar multiplication
+ *  of a random linear combination of their verification equations, which is
+ *  considerably faster than n calls to secp256k1_schnorrsig_verify. The
+ *  random coefficients are derived by hashing all inputs. A failing batch
+ *  does not tell which signature is invalid; use secp256k1_schnorrsig_verify
+ *  on each to find out.
+ *
+ *  Returns: 1: all signatures are correct (also if n is 0)
+ *           0: at least one signature is incorrect, or the scratch space was
+ *              too small to proceed
+ *  Args:      ctx: pointer to a context object.
+ *         scratch: scratch space for the multiplication (can be NULL, in which
+ *                  case every term is multiplied separately). Strauss' algorithm
+ *                  is used for small batches and Pippenger's for large ones,
+ *                  depending on the space available.
+ *  In:       sigs: array of n pointers to 64-byte signatures.
+ *            msgs: array of n pointers to messages. An entry can only be NULL if
+ *                  the corresponding msglen is 0.
+ *         msglens: array of n message lengths.
+ *         pubkeys: array of n pointers to x-only public keys.
+ *               n: number of signatures.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify_batch(
+    const secp256k1_context *ctx,
+    secp256k1_scratch_space *scratch,
+    const unsigned char *const *sigs,
+    const unsigned char *const *msgs,
+    const size_t *msglens,
+    const secp256k1_xonly_pubkey *const *pubkeys,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
+/** A task of secp256k1_schnorrsig_verify_batch_parallel, to be called with
+ *  its argument on any thread. */
+typedef void (*secp256k1_batch_task_function)(void *arg);
+
+/** A thread pool as seen by secp256k1_schnorrsig_verify_batch_parallel.
+ *
+ *  It must call fn(args[i]) exactly once for every i < n_tasks, in any order
+ *  and on any threads, and only return once all of those calls have
+ *  finished. The tasks share no mutable state, so they can all run at once.
+ *
+ *  Returns: 1 if every task was run, 0 if the tasks could not be run (in
+ *           which case none of them may still be running).
+ *  In:       fn: the task function.
+ *          args: array of n_tasks task arguments.
+ *       n_tasks: number of tasks.
+ *          data: the runner_data given to
+ *                secp256k1_schnorrsig_verify_batch_parallel.
+ */
+typedef int (*secp256k1_batch_task_runner)(
+    secp256k1_batch_task_function fn,
+    void *const *args,
+    size_t n_tasks,
+    void *data
+);
+
+/** Verify a batch of Schnorr signatures on a thread pool.
+ *
+ *  The result is that of secp256k1_schnorrsig_verify_batch on the same
+ *  inputs. The batch is split into n_tasks ranges of consecutive signatures,
+ *  each of which is multiplied out by its own task with its own scratch
+ *  space; the partial sums and the scalar of G are then combined on the
+ *  calling thread with one more multiplication.
+ *
+ *  Returns: 1: all signatures are correct (also if n is 0)
+ *           0: at least one signature is incorrect, or the tasks could not
+ *              be run
+ *  Args:         ctx: pointer to a context object.
+ *            n_tasks: number of tasks to split the batch into (at least 1,
+ *                     and more than n has no effect). The number of threads
+ *                     of the pool is a good choice.
+ *       scratch_size: size of the scratch space that every task allocates
+ *                     (0 to multiply every term separately).
+ *             runner: the thread pool, or NULL to run the tasks one after
+ *                     another on the calling thread.
+ *        runner_data: arbitrary data pointer passed to runner.
+ *  In:          sigs: array of n pointers to 64-byte signatures.
+ *               msgs: array of n pointers to messages. An entry can only be
+ *                     NULL if the corresponding msglen is 0.
+ *            msglens: array of n message lengths.
+ *            pubkeys: array of n pointers to x-only public keys.
+ *                  n: number of signatures.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify_batch_parallel(
+    const secp256k1_context *ctx,
+    size_t n_tasks,
+    size_t scratch_size,
+    secp256k1_batch_task_runner runner,
+    void *runner_data,
+    const unsigned char *const *sigs,
+    const unsigned char *const *msgs,
+    const size_t *msglens,
+    const secp256k1_xonly_pubkey *const *pubkeys,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 #ifdef __cplusplus
 }
 #endif
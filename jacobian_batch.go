@@ -0,0 +1,258 @@
+package p256k1
+
+// JacobianBatch is a batch of points in Jacobian coordinates laid out as
+// structure of arrays. Point i sits in lane i%fieldLaneCount of block
+// i/fieldLaneCount: the X, Y and Z limbs of a block are contiguous
+// fieldLanes, and bit l of inf[t] is set if the point in lane l of block t
+// is infinity. Where a []GroupElementJacobian carries magnitude metadata and
+// an infinity flag in every element, here each coordinate of a block is one
+// operand of fieldMulLanes, so double, addGE and toAffine process
+// fieldLaneCount points per field multiplication.
+//
+// Coordinates are kept weakly normalized. Lanes beyond the length of the
+// batch are padding and always infinity.
+type JacobianBatch struct {
+	x, y, z []fieldLanes
+	inf     []uint8
+	n       int
+
+	// tmp holds the running products of toAffine
+	tmp []fieldLanes
+}
+
+// NewJacobianBatch returns a batch of n points at infinity
+func NewJacobianBatch(n int) *JacobianBatch {
+	blocks := (n + fieldLaneCount - 1) / fieldLaneCount
+	b := &JacobianBatch{
+		x:   make([]fieldLanes, blocks),
+		y:   make([]fieldLanes, blocks),
+		z:   make([]fieldLanes, blocks),
+		inf: make([]uint8, blocks),
+		n:   n,
+	}
+	for t := range b.inf {
+		b.inf[t] = 0xff
+	}
+	return b
+}
+
+// Len returns the number of points in the batch
+func (b *JacobianBatch) Len() int {
+	return b.n
+}
+
+// set sets point i to a
+func (b *JacobianBatch) set(i int, a *GroupElementJacobian) {
+	t, l := i/fieldLaneCount, i%fieldLaneCount
+	b.x[t].set(l, &a.x)
+	b.y[t].set(l, &a.y)
+	b.z[t].set(l, &a.z)
+	if a.infinity {
+		b.inf[t] |= 1 << l
+	} else {
+		b.inf[t] &^= 1 << l
+	}
+}
+
+// setGE sets point i to the affine point a
+func (b *JacobianBatch) setGE(i int, a *GroupElementAffine) {
+	t, l := i/fieldLaneCount, i%fieldLaneCount
+	b.x[t].set(l, &a.x)
+	b.y[t].set(l, &a.y)
+	b.z[t].setOne(l)
+	if a.infinity {
+		b.inf[t] |= 1 << l
+	} else {
+		b.inf[t] &^= 1 << l
+	}
+}
+
+// get sets r to point i
+func (b *JacobianBatch) get(i int, r *GroupElementJacobian) {
+	t, l := i/fieldLaneCount, i%fieldLaneCount
+	b.x[t].get(l, &r.x)
+	b.y[t].get(l, &r.y)
+	b.z[t].get(l, &r.z)
+	r.infinity = b.inf[t]&(1<<l) != 0
+}
+
+// double sets every point of r to twice the same point of a, as
+// GroupElementJacobian.double. r may be a.
+func (r *JacobianBatch) double(a *JacobianBatch) {
+	var l, s, t fieldLanes
+	for k := range a.x {
+		ax, ay, az := &a.x[k], &a.y[k], &a.z[k]
+		rx, ry, rz := &r.x[k], &r.y[k], &r.z[k]
+
+		fieldMulLanes(rz, az, ay) // Z3 = Y1*Z1
+		fieldMulLanes(&s, ay, ay) // S = Y1^2
+		fieldMulLanes(&l, ax, ax) // L = X1^2
+		l.mulInt(&l, 3)
+		l.half(&l) // L = 3/2*X1^2
+		t.negate(&s)
+		fieldMulLanes(&t, &t, ax) // T = -X1*S
+		fieldMulLanes(rx, &l, &l)
+		rx.add(rx, &t)
+		rx.add(rx, &t)            // X3 = L^2 + 2*T
+		fieldMulLanes(&s, &s, &s) // S = S^2
+		t.add(&t, rx)
+		fieldMulLanes(ry, &t, &l)
+		ry.add(ry, &s)
+		ry.negate(ry) // Y3 = -(L*(X3 + T) + S^2)
+		r.inf[k] = a.inf[k]
+	}
+}
+
+// addGE sets every point i of r to a[i] + b[i], as
+// GroupElementJacobian.addGE. len(b) must be at least a.Len(). r may be a.
+func (r *JacobianBatch) addGE(a *JacobianBatch, b []GroupElementAffine) {
+	var bx, by fieldLanes
+	for k := range a.x {
+		lanes := b[k*fieldLaneCount : min(a.n, (k+1)*fieldLaneCount)]
+		for l := range lanes {
+			bx.set(l, &lanes[l].x)
+			by.set(l, &lanes[l].y)
+		}
+		r.addGEBlock(a, k, &bx, &by, lanes)
+	}
+}
+
+// addGEAll sets every point of r to the same point of a plus b. r may be a.
+func (r *JacobianBatch) addGEAll(a *JacobianBatch, b *GroupElementAffine) {
+	var bx, by fieldLanes
+	var lanes [fieldLaneCount]GroupElementAffine
+	for l := range lanes {
+		lanes[l] = *b
+		bx.set(l, &b.x)
+		by.set(l, &b.y)
+	}
+	for k := range a.x {
+		r.addGEBlock(a, k, &bx, &by, lanes[:min(fieldLaneCount, a.n-k*fieldLaneCount)])
+	}
+}
+
+// addGEBlock adds the affine points b (one per used lane, with coordinates
+// bx, by) to block k of a and stores the sums in block k of r. Lanes where
+// the addition formula does not apply, because a point is infinity or the
+// two points share x, are redone with GroupElementJacobian.addGE.
+func (r *JacobianBatch) addGEBlock(a *JacobianBatch, k int, bx, by *fieldLanes, b []GroupElementAffine) {
+	var z12, u2, s2, h, i, h2, h3, t, x3, y3, z3 fieldLanes
+	ax, ay, az := &a.x[k], &a.y[k], &a.z[k]
+
+	fieldMulLanes(&z12, az, az)
+	fieldMulLanes(&u2, bx, &z12)
+	fieldMulLanes(&s2, by, &z12)
+	fieldMulLanes(&s2, &s2, az)
+	h.negate(ax)
+	h.add(&h, &u2) // h = u2 - u1
+	i.negate(&s2)
+	i.add(&i, ay) // i = s1 - s2
+
+	// Lanes needing the general code, computed before r is written as it may
+	// be a
+	var special uint8
+	var fixed [fieldLaneCount]GroupElementJacobian
+	for l := range b {
+		var hl FieldElement
+		h.get(l, &hl)
+		if a.inf[k]&(1<<l) != 0 || b[l].infinity || hl.normalizesToZeroVar() {
+			special |= 1 << l
+			var p GroupElementJacobian
+			a.get(k*fieldLaneCount+l, &p)
+			fixed[l].addGE(&p, &b[l])
+		}
+	}
+
+	fieldMulLanes(&z3, az, &h)
+	fieldMulLanes(&h2, &h, &h)
+	h2.negate(&h2)
+	fieldMulLanes(&h3, &h2, &h)
+	fieldMulLanes(&t, ax, &h2)
+	fieldMulLanes(&x3, &i, &i)
+	x3.add(&x3, &h3)
+	x3.add(&x3, &t)
+	x3.add(&x3, &t) // X3 = i^2 - h^3 - 2*u1*h^2
+	t.add(&t, &x3)
+	fieldMulLanes(&y3, &t, &i)
+	fieldMulLanes(&h3, &h3, ay)
+	y3.add(&y3, &h3) // Y3 = i*(X3 - u1*h^2) - s1*h^3
+
+	r.x[k], r.y[k], r.z[k] = x3, y3, z3
+	r.inf[k] = a.inf[k] &^ uint8(uint16(1)<<len(b)-1)
+	for l := range b {
+		if special&(1<<l) != 0 {
+			r.set(k*fieldLaneCount+l, &fixed[l])
+		}
+	}
+}
+
+// toAffine sets r[i] to point i in affine coordinates, as geSetAllGEJVar.
+// len(r) must be at least b.Len(). The running products of the batch
+// inversion are computed lane-wise over the blocks, so only the
+// fieldLaneCount lane totals go through a scalar batchInverse.
+func (b *JacobianBatch) toAffine(r []GroupElementAffine) {
+	blocks := len(b.z)
+	if blocks == 0 {
+		return
+	}
+	if len(b.tmp) < blocks {
+		b.tmp = make([]fieldLanes, blocks)
+	}
+	prod := b.tmp[:blocks]
+
+	// prod[k] = z[0]*...*z[k] lane-wise, infinities counting as 1
+	var zk fieldLanes
+	b.zOrOne(0, &prod[0])
+	for k := 1; k < blocks; k++ {
+		b.zOrOne(k, &zk)
+		fieldMulLanes(&prod[k], &prod[k-1], &zk)
+	}
+
+	// u = the inverses of the lane totals
+	var totals, invs [fieldLaneCount]FieldElement
+	var u fieldLanes
+	for l := range totals {
+		prod[blocks-1].get(l, &totals[l])
+	}
+	batchInverse(invs[:], totals[:])
+	for l := range invs {
+		u.set(l, &invs[l])
+	}
+
+	// prod[k] = 1/z[k] lane-wise
+	for k := blocks - 1; k > 0; k-- {
+		b.zOrOne(k, &zk)
+		fieldMulLanes(&prod[k], &u, &prod[k-1])
+		fieldMulLanes(&u, &u, &zk)
+	}
+	prod[0] = u
+
+	var zi2, x, y fieldLanes
+	for k := 0; k < blocks; k++ {
+		fieldMulLanes(&zi2, &prod[k], &prod[k])
+		fieldMulLanes(&x, &b.x[k], &zi2)
+		fieldMulLanes(&zi2, &zi2, &prod[k])
+		fieldMulLanes(&y, &b.y[k], &zi2)
+		for l := 0; l < fieldLaneCount && k*fieldLaneCount+l < b.n; l++ {
+			p := &r[k*fieldLaneCount+l]
+			if b.inf[k]&(1<<l) != 0 {
+				p.setInfinity()
+				continue
+			}
+			x.get(l, &p.x)
+			y.get(l, &p.y)
+			p.infinity = false
+		}
+	}
+}
+
+// zOrOne sets r to the z coordinates of block k with the infinity lanes
+// replaced by 1
+func (b *JacobianBatch) zOrOne(k int, r *fieldLanes) {
+	*r = b.z[k]
+	for l := 0; l < fieldLaneCount; l++ {
+		if b.inf[k]&(1<<l) != 0 {
+			r.setOne(l)
+		}
+	}
+}
@@ -0,0 +1,139 @@
+package p256k1
+
+import (
+	"testing"
+)
+
+// makeJacobianBatch returns n random points with non-trivial z, a few of
+// them infinity, both as a slice and as a JacobianBatch
+func makeJacobianBatch(t testing.TB, n int) ([]GroupElementJacobian, *JacobianBatch) {
+	pts := make([]GroupElementJacobian, n)
+	b := NewJacobianBatch(n)
+	for i := range pts {
+		p := randomPoint(t)
+		pts[i].setGE(&p)
+		pts[i].double(&pts[i])
+		if i%11 == 5 {
+			pts[i].setInfinity()
+		}
+		b.set(i, &pts[i])
+	}
+	return pts, b
+}
+
+func TestJacobianBatch(t *testing.T) {
+	const n = 37
+	pts, b := makeJacobianBatch(t, n)
+	check := func(op string, want []GroupElementJacobian) {
+		t.Helper()
+		for i := range want {
+			var got GroupElementJacobian
+			b.get(i, &got)
+			if !jacobianEqual(&got, &want[i]) {
+				t.Fatalf("%s: point %d differs", op, i)
+			}
+		}
+	}
+	check("set", pts)
+
+	want := make([]GroupElementJacobian, n)
+	for i := range pts {
+		want[i].double(&pts[i])
+	}
+	b.double(b)
+	check("double", want)
+	pts = want
+
+	// Mixed additions, including the cases the lane formula cannot handle:
+	// b = a, b = -a and b infinity
+	addends := make([]GroupElementAffine, n)
+	for i := range addends {
+		addends[i] = randomPoint(t)
+		switch i % 7 {
+		case 1:
+			addends[i].setGEJ(&pts[i])
+		case 2:
+			addends[i].setGEJ(&pts[i])
+			addends[i].negate(&addends[i])
+		case 3:
+			addends[i].setInfinity()
+		}
+	}
+	want = make([]GroupElementJacobian, n)
+	for i := range pts {
+		want[i].addGE(&pts[i], &addends[i])
+	}
+	b.addGE(b, addends)
+	check("addGE", want)
+	pts = want
+
+	g := randomPoint(t)
+	want = make([]GroupElementJacobian, n)
+	for i := range pts {
+		want[i].addGE(&pts[i], &g)
+	}
+	c := NewJacobianBatch(n)
+	c.addGEAll(b, &g)
+	b = c
+	check("addGEAll", want)
+	pts = want
+
+	got := make([]GroupElementAffine, n)
+	wantAff := make([]GroupElementAffine, n)
+	b.toAffine(got)
+	geSetAllGEJVar(wantAff, pts)
+	for i := range got {
+		if got[i].infinity != wantAff[i].infinity {
+			t.Fatalf("toAffine: point %d infinity = %v", i, got[i].infinity)
+		}
+		if !got[i].infinity && !got[i].equal(&wantAff[i]) {
+			t.Fatalf("toAffine: point %d differs", i)
+		}
+	}
+
+	// Padding lanes stay at infinity
+	if b.inf[len(b.inf)-1]>>(n%fieldLaneCount) != 0xff>>(n%fieldLaneCount) {
+		t.Error("padding lanes lost their infinity bit")
+	}
+}
+
+func BenchmarkJacobianBatch(b *testing.B) {
+	const n = 256
+	pts, batch := makeJacobianBatch(b, n)
+	g := randomPoint(b)
+	aff := make([]GroupElementAffine, n)
+	b.Run("double", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			batch.double(batch)
+		}
+	})
+	b.Run("doubleScalar", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for j := range pts {
+				pts[j].double(&pts[j])
+			}
+		}
+	})
+	b.Run("addGEAll", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			batch.addGEAll(batch, &g)
+		}
+	})
+	b.Run("addGEScalar", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for j := range pts {
+				pts[j].addGE(&pts[j], &g)
+			}
+		}
+	})
+	b.Run("toAffine", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			batch.toAffine(aff)
+		}
+	})
+	b.Run("geSetAllGEJVar", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			geSetAllGEJVar(aff, pts)
+		}
+	})
+}
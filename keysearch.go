@@ -0,0 +1,180 @@
+package p256k1
+
+import (
+	"context"
+	"encoding/binary"
+	"errors"
+	"runtime"
+	"sync"
+	"unsafe"
+)
+
+// keySearchBatch is the number of candidates a search worker converts to
+// affine with a single field inversion
+const keySearchBatch = 256
+
+// KeySearch looks for a secret key whose 33 byte compressed public key
+// satisfies match, as used for vanity keys. Instead of a generator
+// multiplication per attempt, it picks one random secret k and walks the keys
+// k+i: worker w of n visits k+w, k+w+n, k+w+2n, ... with one mixed point
+// addition per candidate, and the candidates are converted to affine in
+// batches with one inversion each. workers <= 0 uses GOMAXPROCS workers.
+//
+// match is called concurrently from all workers and must not retain the
+// slice. The search stops at the first match or when ctx is done, in which
+// case ctx.Err() is returned. The candidate keys are secret, but the batch
+// inversion is variable time, so the search should not run where an attacker
+// can time it.
+func KeySearch(ctx context.Context, workers int, match func(pub33 []byte) bool) (*KeyPair, error) {
+	if match == nil {
+		return nil, errors.New("nil match function")
+	}
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+
+	seckey, err := ECSeckeyGenerate()
+	if err != nil {
+		return nil, err
+	}
+	var k Scalar
+	k.setB32Seckey(seckey)
+	memclear(unsafe.Pointer(&seckey[0]), 32)
+	defer k.clear()
+
+	// Every worker steps by workers*G
+	var stride Scalar
+	var stepJ GroupElementJacobian
+	var step GroupElementAffine
+	stride.setInt(uint(workers))
+	EcmultGen(&stepJ, &stride)
+	step.setGEJ(&stepJ)
+
+	ctx, cancel := context.WithCancel(ctx)
+	defer cancel()
+
+	var (
+		once   sync.Once
+		found  bool
+		offset uint64
+		wg     sync.WaitGroup
+	)
+	for w := 0; w < workers; w++ {
+		wg.Add(1)
+		go func(w int) {
+			defer wg.Done()
+			if off, ok := keySearchWorker(ctx, &k, uint64(w), uint64(workers), &step, match); ok {
+				once.Do(func() {
+					found, offset = true, off
+					cancel()
+				})
+			}
+		}(w)
+	}
+	wg.Wait()
+
+	if !found {
+		return nil, ctx.Err()
+	}
+
+	// The match is at k + offset
+	var buf [32]byte
+	var off Scalar
+	binary.BigEndian.PutUint64(buf[24:], offset)
+	off.setB32(buf[:])
+	off.add(&k, &off)
+	off.getB32(buf[:])
+	kp, err := KeyPairCreate(buf[:])
+	memclear(unsafe.Pointer(&buf[0]), 32)
+	off.clear()
+	return kp, err
+}
+
+// keySearchWorker walks the keys k+first, k+first+stride, ... and returns
+// the offset from k of the first one whose compressed public key satisfies
+// match. step must be stride*G.
+func keySearchWorker(ctx context.Context, k *Scalar, first, stride uint64, step *GroupElementAffine, match func(pub33 []byte) bool) (uint64, bool) {
+	var start Scalar
+	var buf [32]byte
+	binary.BigEndian.PutUint64(buf[24:], first)
+	start.setB32(buf[:])
+	start.add(k, &start)
+
+	var cur GroupElementJacobian
+	EcmultGen(&cur, &start)
+	start.clear()
+
+	var jac [keySearchBatch]GroupElementJacobian
+	var aff [keySearchBatch]GroupElementAffine
+	var pub [33]byte
+
+	if fieldLanesVector {
+		// Keep the batch as keySearchBatch independent chains, each advanced
+		// by keySearchBatch*step per round, so every round is a lane-wise
+		// addition and conversion
+		var batchStepJ GroupElementJacobian
+		var batchStep GroupElementAffine
+		batchStepJ.setGE(step)
+		for i := 1; i < keySearchBatch; i <<= 1 {
+			batchStepJ.double(&batchStepJ)
+		}
+		batchStep.setGEJ(&batchStepJ)
+
+		batch := NewJacobianBatch(keySearchBatch)
+		for i := 0; i < keySearchBatch; i++ {
+			batch.set(i, &cur)
+			cur.addGE(&cur, step)
+		}
+		for offset := first; ; offset += keySearchBatch * stride {
+			select {
+			case <-ctx.Done():
+				return 0, false
+			default:
+			}
+			batch.toAffine(aff[:])
+			if i, ok := keySearchScan(aff[:], &pub, match); ok {
+				return offset + uint64(i)*stride, true
+			}
+			batch.addGEAll(batch, &batchStep)
+		}
+	}
+
+	for offset := first; ; offset += keySearchBatch * stride {
+		select {
+		case <-ctx.Done():
+			return 0, false
+		default:
+		}
+
+		jac[0] = cur
+		for i := 1; i < keySearchBatch; i++ {
+			jac[i].addGE(&jac[i-1], step)
+		}
+		cur.addGE(&jac[keySearchBatch-1], step)
+		geSetAllGEJVar(aff[:], jac[:])
+
+		if i, ok := keySearchScan(aff[:], &pub, match); ok {
+			return offset + uint64(i)*stride, true
+		}
+	}
+}
+
+// keySearchScan returns the index of the first candidate in aff whose
+// compressed public key, serialized into pub, satisfies match
+func keySearchScan(aff []GroupElementAffine, pub *[33]byte, match func(pub33 []byte) bool) (int, bool) {
+	for i := range aff {
+		if aff[i].infinity {
+			continue
+		}
+		aff[i].y.normalize()
+		pub[0] = 0x02
+		if aff[i].y.isOdd() {
+			pub[0] = 0x03
+		}
+		aff[i].x.getB32(pub[1:])
+		if match(pub[:]) {
+			return i, true
+		}
+	}
+	return 0, false
+}
@@ -0,0 +1,112 @@
+package p256k1
+
+import (
+	"bytes"
+	"context"
+	"sync"
+	"testing"
+	"time"
+)
+
+func TestKeySearch(t *testing.T) {
+	// With one worker the candidates are consecutive keys, so the key found
+	// after n candidates determines all of them
+	const n = keySearchBatch + 10
+	var seen [][]byte
+	kp, err := KeySearch(context.Background(), 1, func(pub33 []byte) bool {
+		seen = append(seen, append([]byte(nil), pub33...))
+		return len(seen) == n
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	var sec Scalar
+	var one Scalar
+	one.setInt(1)
+	sec.setB32(kp.Seckey())
+	for i := n - 1; i >= 0; i-- {
+		var pj GroupElementJacobian
+		var p GroupElementAffine
+		var pk PublicKey
+		var ser [33]byte
+		EcmultGen(&pj, &sec)
+		p.setGEJ(&pj)
+		p.toBytes(pk.data[:])
+		ECPubkeySerialize(ser[:], &pk, ECCompressed)
+		if !bytes.Equal(ser[:], seen[i]) {
+			t.Fatalf("candidate %d is not the expected key", i)
+		}
+		var neg Scalar
+		neg.negate(&one)
+		sec.add(&sec, &neg)
+	}
+}
+
+func TestKeySearchWorkers(t *testing.T) {
+	// Prefix search over several workers; the returned key must produce the
+	// matched public key
+	var mu sync.Mutex
+	var matched []byte
+	kp, err := KeySearch(context.Background(), 4, func(pub33 []byte) bool {
+		if pub33[1] != 0xAB {
+			return false
+		}
+		mu.Lock()
+		defer mu.Unlock()
+		if matched == nil {
+			matched = append([]byte(nil), pub33...)
+		}
+		return true
+	})
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	var ser [33]byte
+	ECPubkeySerialize(ser[:], kp.Pubkey(), ECCompressed)
+	if ser[1] != 0xAB {
+		t.Errorf("returned key %x does not match the prefix", ser)
+	}
+	var pk PublicKey
+	if err := ECPubkeyCreate(&pk, kp.Seckey()); err != nil || pk != *kp.Pubkey() {
+		t.Error("returned keypair is inconsistent")
+	}
+}
+
+func TestKeySearchCancel(t *testing.T) {
+	ctx, cancel := context.WithTimeout(context.Background(), 20*time.Millisecond)
+	defer cancel()
+	kp, err := KeySearch(ctx, 2, func([]byte) bool { return false })
+	if kp != nil || err != context.DeadlineExceeded {
+		t.Errorf("got %v, %v; want nil, %v", kp, err, context.DeadlineExceeded)
+	}
+	if _, err := KeySearch(context.Background(), 1, nil); err == nil {
+		t.Error("nil match function accepted")
+	}
+}
+
+func BenchmarkKeySearch(b *testing.B) {
+	b.Run("KeyPairGenerate", func(b *testing.B) {
+		var ser [33]byte
+		for i := 0; i < b.N; i++ {
+			kp, err := KeyPairGenerate()
+			if err != nil {
+				b.Fatal(err)
+			}
+			ECPubkeySerialize(ser[:], kp.Pubkey(), ECCompressed)
+		}
+		b.ReportMetric(float64(b.N)/b.Elapsed().Seconds(), "keys/s")
+	})
+	b.Run("KeySearch", func(b *testing.B) {
+		n := 0
+		_, err := KeySearch(context.Background(), 1, func([]byte) bool {
+			n++
+			return n >= b.N
+		})
+		if err != nil {
+			b.Fatal(err)
+		}
+		b.ReportMetric(float64(b.N)/b.Elapsed().Seconds(), "keys/s")
+	})
+}
@@ -0,0 +1,184 @@
+package p256k1
+
+import (
+	"bytes"
+	"encoding/binary"
+	"runtime"
+	"sync"
+)
+
+// keySortParallelMin is the slice length from which SortPubkeys and
+// SortXOnlyPubkeys sort chunks on all CPUs and merge them
+const keySortParallelMin = 100000
+
+// keySortEntry is a key being sorted: the first 8 bytes of its encoding as a
+// big endian integer and its index in the input
+type keySortEntry struct {
+	prefix uint64
+	idx    int
+}
+
+// SortPubkeys sorts pubkeys in place by their 33 byte compressed
+// serializations, the order of ECPubkeyCmp, as secp256k1_ec_pubkey_sort.
+// Unlike a comparison sort calling ECPubkeyCmp, every key is serialized only
+// once; the keys are then radix sorted on the first 8 bytes of their
+// encodings, with the full encodings breaking ties. Invalid keys sort as all
+// zeros. Slices of keySortParallelMin keys or more are sorted in chunks on
+// GOMAXPROCS goroutines and merged.
+func SortPubkeys(pubkeys []*PublicKey) {
+	sortKeys(pubkeys, 33, func(dst []byte, pk *PublicKey) {
+		ECPubkeySerialize(dst, pk, ECCompressed)
+	}, keySortWorkers(len(pubkeys)))
+}
+
+// SortXOnlyPubkeys sorts xonlys in place by their 32 byte serializations,
+// the order of XOnlyPubkeyCmp, in the same way as SortPubkeys
+func SortXOnlyPubkeys(xonlys []*XOnlyPubkey) {
+	sortKeys(xonlys, 32, func(dst []byte, xonly *XOnlyPubkey) {
+		copy(dst, xonly.data[:])
+	}, keySortWorkers(len(xonlys)))
+}
+
+func keySortWorkers(n int) int {
+	if n < keySortParallelMin {
+		return 1
+	}
+	return runtime.GOMAXPROCS(0)
+}
+
+// sortKeys sorts keys by the encLen byte encodings produced by encode, with
+// the work split over workers goroutines
+func sortKeys[T any](keys []*T, encLen int, encode func(dst []byte, key *T), workers int) {
+	n := len(keys)
+	if n < 2 {
+		return
+	}
+	if workers < 1 {
+		workers = 1
+	}
+	per := (n + workers - 1) / workers
+
+	enc := make([]byte, n*encLen)
+	a := make([]keySortEntry, n)
+	b := make([]keySortEntry, n)
+	less := func(x, y keySortEntry) bool {
+		if x.prefix != y.prefix {
+			return x.prefix < y.prefix
+		}
+		return bytes.Compare(enc[x.idx*encLen:(x.idx+1)*encLen], enc[y.idx*encLen:(y.idx+1)*encLen]) < 0
+	}
+
+	// Encode and sort each chunk; sorted chunks end up in a
+	parallelRanges(n, per, func(lo, hi int) {
+		for i := lo; i < hi; i++ {
+			e := enc[i*encLen : (i+1)*encLen]
+			encode(e, keys[i])
+			a[i] = keySortEntry{prefix: binary.BigEndian.Uint64(e), idx: i}
+		}
+		if sorted := radixSortEntries(a[lo:hi], b[lo:hi]); &sorted[0] != &a[lo] {
+			copy(a[lo:hi], sorted)
+		}
+		insertionSortTies(a[lo:hi], less)
+	})
+
+	// Merge neighbouring runs until one is left
+	for width := per; width < n; width *= 2 {
+		parallelRanges(n, 2*width, func(lo, hi int) {
+			mid := lo + width
+			if mid >= hi {
+				copy(b[lo:hi], a[lo:hi])
+				return
+			}
+			mergeEntries(b[lo:hi], a[lo:mid], a[mid:hi], less)
+		})
+		a, b = b, a
+	}
+
+	sorted := make([]*T, n)
+	for i := range a {
+		sorted[i] = keys[a[i].idx]
+	}
+	copy(keys, sorted)
+}
+
+// parallelRanges calls f on [0, per), [per, 2*per), ... up to n, each range
+// on its own goroutine if there is more than one
+func parallelRanges(n, per int, f func(lo, hi int)) {
+	if per >= n {
+		f(0, n)
+		return
+	}
+	var wg sync.WaitGroup
+	for lo := 0; lo < n; lo += per {
+		hi := lo + per
+		if hi > n {
+			hi = n
+		}
+		wg.Add(1)
+		go func(lo, hi int) {
+			defer wg.Done()
+			f(lo, hi)
+		}(lo, hi)
+	}
+	wg.Wait()
+}
+
+// radixSortEntries sorts a by prefix with an LSD radix sort, one byte per
+// pass, using tmp of the same length as the other buffer. It returns
+// whichever of the two holds the result. Passes in which all entries share
+// the same byte are skipped.
+func radixSortEntries(a, tmp []keySortEntry) []keySortEntry {
+	for shift := uint(0); shift < 64; shift += 8 {
+		var count [256]int
+		for i := range a {
+			count[byte(a[i].prefix>>shift)]++
+		}
+		if count[byte(a[0].prefix>>shift)] == len(a) {
+			continue
+		}
+		sum := 0
+		for i := range count {
+			c := count[i]
+			count[i] = sum
+			sum += c
+		}
+		for i := range a {
+			d := byte(a[i].prefix >> shift)
+			tmp[count[d]] = a[i]
+			count[d]++
+		}
+		a, tmp = tmp, a
+	}
+	return a
+}
+
+// insertionSortTies orders the runs of equal prefixes in a by less. Distinct
+// keys rarely share 8 bytes, so the runs are almost always of length one.
+func insertionSortTies(a []keySortEntry, less func(x, y keySortEntry) bool) {
+	for i := 1; i < len(a); i++ {
+		e := a[i]
+		j := i
+		for j > 0 && a[j-1].prefix == e.prefix && less(e, a[j-1]) {
+			a[j] = a[j-1]
+			j--
+		}
+		a[j] = e
+	}
+}
+
+// mergeEntries merges the sorted runs x and y into dst
+func mergeEntries(dst, x, y []keySortEntry, less func(x, y keySortEntry) bool) {
+	i, j, k := 0, 0, 0
+	for i < len(x) && j < len(y) {
+		if less(y[j], x[i]) {
+			dst[k] = y[j]
+			j++
+		} else {
+			dst[k] = x[i]
+			i++
+		}
+		k++
+	}
+	k += copy(dst[k:], x[i:])
+	copy(dst[k:], y[j:])
+}
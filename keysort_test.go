@@ -0,0 +1,116 @@
+package p256k1
+
+import (
+	"crypto/rand"
+	"sort"
+	"testing"
+)
+
+func makeSortPubkeys(t testing.TB, n int) []*PublicKey {
+	pubkeys := make([]*PublicKey, n)
+	for i := range pubkeys {
+		switch {
+		case i%50 == 7:
+			// Duplicates
+			pubkeys[i] = pubkeys[i-1]
+		case i%50 == 9:
+			// Same x, other parity
+			var ser [33]byte
+			ECPubkeySerialize(ser[:], pubkeys[i-1], ECCompressed)
+			ser[0] ^= 1
+			pubkeys[i] = new(PublicKey)
+			if err := ECPubkeyParse(pubkeys[i], ser[:]); err != nil {
+				t.Fatal(err)
+			}
+		default:
+			var sk [32]byte
+			if _, err := rand.Read(sk[:]); err != nil {
+				t.Fatal(err)
+			}
+			pubkeys[i] = new(PublicKey)
+			if err := ECPubkeyCreate(pubkeys[i], sk[:]); err != nil {
+				t.Fatal(err)
+			}
+		}
+	}
+	// An invalid key sorts first
+	pubkeys[n/2] = new(PublicKey)
+	return pubkeys
+}
+
+func TestSortPubkeys(t *testing.T) {
+	pubkeys := makeSortPubkeys(t, 1000)
+	for _, workers := range []int{1, 3, 8} {
+		got := append([]*PublicKey(nil), pubkeys...)
+		sortKeys(got, 33, func(dst []byte, pk *PublicKey) {
+			ECPubkeySerialize(dst, pk, ECCompressed)
+		}, workers)
+		for i := 1; i < len(got); i++ {
+			if ECPubkeyCmp(got[i-1], got[i]) > 0 {
+				t.Fatalf("workers=%d: keys %d and %d out of order", workers, i-1, i)
+			}
+		}
+		if got[0].data != (PublicKey{}).data {
+			t.Errorf("workers=%d: invalid key not sorted first", workers)
+		}
+		seen := make(map[*PublicKey]int)
+		for _, pk := range pubkeys {
+			seen[pk]++
+		}
+		for _, pk := range got {
+			seen[pk]--
+		}
+		for _, c := range seen {
+			if c != 0 {
+				t.Fatalf("workers=%d: sort did not permute the input", workers)
+			}
+		}
+	}
+
+	SortPubkeys(nil)
+	SortPubkeys(pubkeys[:1])
+}
+
+func TestSortXOnlyPubkeys(t *testing.T) {
+	xonlys := make([]*XOnlyPubkey, 3000)
+	for i := range xonlys {
+		xonlys[i] = new(XOnlyPubkey)
+		if _, err := rand.Read(xonlys[i].data[:]); err != nil {
+			t.Fatal(err)
+		}
+		if i%10 == 1 {
+			// Share the 8 byte prefix with the previous key
+			copy(xonlys[i].data[:8], xonlys[i-1].data[:8])
+		}
+	}
+	for _, workers := range []int{1, 4} {
+		got := append([]*XOnlyPubkey(nil), xonlys...)
+		sortKeys(got, 32, func(dst []byte, xonly *XOnlyPubkey) {
+			copy(dst, xonly.data[:])
+		}, workers)
+		want := append([]*XOnlyPubkey(nil), xonlys...)
+		sort.Slice(want, func(i, j int) bool { return XOnlyPubkeyCmp(want[i], want[j]) < 0 })
+		for i := range got {
+			if got[i] != want[i] {
+				t.Fatalf("workers=%d: position %d differs from sort.Slice", workers, i)
+			}
+		}
+	}
+}
+
+func BenchmarkSortPubkeys(b *testing.B) {
+	pubkeys := makeSortPubkeys(b, 10000)
+	keys := make([]*PublicKey, len(pubkeys))
+	b.Run("ECPubkeyCmp", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			copy(keys, pubkeys)
+			sort.Slice(keys, func(i, j int) bool { return ECPubkeyCmp(keys[i], keys[j]) < 0 })
+		}
+	})
+	b.Run("SortPubkeys", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			copy(keys, pubkeys)
+			SortPubkeys(keys)
+		}
+	})
+}
@@ -0,0 +1,129 @@
+package p256k1
+
+import (
+	"fmt"
+	"io"
+	"math"
+	"sort"
+)
+
+// Metrics is a snapshot of the operation counters, returned by ReadMetrics.
+// The counters are only kept when the package is built with
+// -tags p256k1metrics; otherwise every snapshot is empty and the hooks in the
+// operations compile to nothing.
+//
+// A snapshot can be published with expvar as it is, for example
+//
+//	expvar.Publish("p256k1", expvar.Func(func() any { return p256k1.ReadMetrics() }))
+//
+// or written in the Prometheus text format with WritePrometheus.
+type Metrics struct {
+	// Ops holds the timed operations: SchnorrVerify, SchnorrSign, ECDH and
+	// ECDHX, and ECPubkeyParse
+	Ops []OpMetrics `json:"ops"`
+
+	// Events counts the pubkey cache hits and misses and the batch
+	// verifications that fell back to checking signatures one by one
+	Events map[string]uint64 `json:"events"`
+}
+
+// OpMetrics holds the counters of one timed operation
+type OpMetrics struct {
+	Name string `json:"name"`
+
+	// Count is the number of calls and Failures the number of them that
+	// returned false or an error
+	Count    uint64 `json:"count"`
+	Failures uint64 `json:"failures"`
+
+	// Nanos is the total time spent in the calls
+	Nanos uint64 `json:"nanos"`
+
+	// Buckets is a latency histogram: Buckets[i] counts the calls taking
+	// less than 2^i ns and at least 2^(i-1) ns, with the last bucket
+	// holding everything longer
+	Buckets []uint64 `json:"buckets"`
+}
+
+// Names of the timed operations and events, indexed by metricOp and
+// metricEvent
+var (
+	metricOpNames    = [...]string{"schnorr_verify", "schnorr_sign", "ecdh", "pubkey_parse"}
+	metricEventNames = [...]string{"pubkey_cache_hit", "pubkey_cache_miss", "batch_verify_fallback", "verify_cache_hit", "verify_cache_miss"}
+)
+
+type metricOp int
+
+const (
+	metricSchnorrVerify metricOp = iota
+	metricSchnorrSign
+	metricECDH
+	metricPubkeyParse
+	metricOps
+)
+
+type metricEvent int
+
+const (
+	metricPubkeyCacheHit metricEvent = iota
+	metricPubkeyCacheMiss
+	metricBatchFallback
+	metricVerifyCacheHit
+	metricVerifyCacheMiss
+	metricEvents
+)
+
+// metricsBuckets is the number of latency histogram buckets, the last one
+// starting at 2^(metricsBuckets-2) ns, about 0.5 s
+const metricsBuckets = 31
+
+// WritePrometheus writes m in the Prometheus text exposition format: a
+// p256k1_op_duration_seconds histogram and a p256k1_op_failures_total counter
+// per operation, and p256k1_events_total per event
+func (m *Metrics) WritePrometheus(w io.Writer) error {
+	ew := &errWriter{w: w}
+	if len(m.Ops) > 0 {
+		ew.printf("# TYPE p256k1_op_duration_seconds histogram\n")
+		for _, op := range m.Ops {
+			var cum uint64
+			for i, n := range op.Buckets {
+				cum += n
+				le := "+Inf"
+				if i < len(op.Buckets)-1 {
+					le = fmt.Sprint(math.Ldexp(1, i) / 1e9)
+				}
+				ew.printf("p256k1_op_duration_seconds_bucket{op=%q,le=%q} %d\n", op.Name, le, cum)
+			}
+			ew.printf("p256k1_op_duration_seconds_sum{op=%q} %g\n", op.Name, float64(op.Nanos)/1e9)
+			ew.printf("p256k1_op_duration_seconds_count{op=%q} %d\n", op.Name, op.Count)
+		}
+		ew.printf("# TYPE p256k1_op_failures_total counter\n")
+		for _, op := range m.Ops {
+			ew.printf("p256k1_op_failures_total{op=%q} %d\n", op.Name, op.Failures)
+		}
+	}
+	if len(m.Events) > 0 {
+		names := make([]string, 0, len(m.Events))
+		for name := range m.Events {
+			names = append(names, name)
+		}
+		sort.Strings(names)
+		ew.printf("# TYPE p256k1_events_total counter\n")
+		for _, name := range names {
+			ew.printf("p256k1_events_total{event=%q} %d\n", name, m.Events[name])
+		}
+	}
+	return ew.err
+}
+
+// errWriter keeps the first write error
+type errWriter struct {
+	w   io.Writer
+	err error
+}
+
+func (e *errWriter) printf(format string, args ...interface{}) {
+	if e.err == nil {
+		_, e.err = fmt.Fprintf(e.w, format, args...)
+	}
+}
@@ -0,0 +1,22 @@
+//go:build !p256k1metrics
+
+package p256k1
+
+// metricsEnabled turns on the operation counters read by ReadMetrics. Build
+// with -tags p256k1metrics to enable them.
+const metricsEnabled = false
+
+func metricsStart() int64 { return 0 }
+
+func metricsDone(metricOp, int64, *bool) {}
+
+func metricsDoneErr(metricOp, int64, *error) {}
+
+func metricsEvent(metricEvent) {}
+
+// ReadMetrics returns the current operation counters, summed over all
+// goroutines. Without -tags p256k1metrics nothing is counted and the result
+// is empty. See Metrics.
+func ReadMetrics() Metrics {
+	return Metrics{}
+}
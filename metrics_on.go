@@ -0,0 +1,107 @@
+//go:build p256k1metrics
+
+package p256k1
+
+import (
+	"math/bits"
+	"sync/atomic"
+	"time"
+	"unsafe"
+)
+
+// metricsEnabled turns on the operation counters read by ReadMetrics. Build
+// with -tags p256k1metrics to enable them.
+const metricsEnabled = true
+
+// metricsShardCount is the number of counter sets. Go has no cheap way to
+// find the current CPU, so updates pick a set from the address of the
+// calling goroutine's stack. Goroutines running at the same time have
+// different stacks and so mostly update different sets, keeping the
+// counters from bouncing a cache line between cores.
+const metricsShardCount = 64
+
+type metricsShard struct {
+	count    [metricOps]atomic.Uint64
+	failures [metricOps]atomic.Uint64
+	nanos    [metricOps]atomic.Uint64
+	buckets  [metricOps][metricsBuckets]atomic.Uint64
+	events   [metricEvents]atomic.Uint64
+
+	// Keeps neighbouring shards off each other's cache lines
+	_ [128]byte
+}
+
+var metricsShards [metricsShardCount]metricsShard
+
+func currentMetricsShard() *metricsShard {
+	var marker byte
+	// Goroutine stacks are at least 8 KiB, so the bits above 13 differ
+	// between them
+	return &metricsShards[(uintptr(unsafe.Pointer(&marker))>>13)&(metricsShardCount-1)]
+}
+
+func metricsStart() time.Time {
+	return time.Now()
+}
+
+func metricsRecord(op metricOp, start time.Time, failed bool) {
+	d := uint64(time.Since(start))
+	b := bits.Len64(d)
+	if b >= metricsBuckets {
+		b = metricsBuckets - 1
+	}
+	sh := currentMetricsShard()
+	sh.count[op].Add(1)
+	sh.nanos[op].Add(d)
+	sh.buckets[op][b].Add(1)
+	if failed {
+		sh.failures[op].Add(1)
+	}
+}
+
+// metricsDone records a call of op that began at start and whose result is
+// *ok. It is deferred, so ok points to the named result.
+func metricsDone(op metricOp, start time.Time, ok *bool) {
+	metricsRecord(op, start, !*ok)
+}
+
+// metricsDoneErr is metricsDone for operations returning an error
+func metricsDoneErr(op metricOp, start time.Time, err *error) {
+	metricsRecord(op, start, *err != nil)
+}
+
+func metricsEvent(e metricEvent) {
+	currentMetricsShard().events[e].Add(1)
+}
+
+// ReadMetrics returns the current operation counters, summed over all
+// goroutines. See Metrics.
+func ReadMetrics() Metrics {
+	m := Metrics{
+		Ops:    make([]OpMetrics, metricOps),
+		Events: make(map[string]uint64, metricEvents),
+	}
+	for op := range m.Ops {
+		m.Ops[op] = OpMetrics{Name: metricOpNames[op], Buckets: make([]uint64, metricsBuckets)}
+	}
+	var events [metricEvents]uint64
+	for i := range metricsShards {
+		sh := &metricsShards[i]
+		for op := range m.Ops {
+			o := &m.Ops[op]
+			o.Count += sh.count[op].Load()
+			o.Failures += sh.failures[op].Load()
+			o.Nanos += sh.nanos[op].Load()
+			for b := range o.Buckets {
+				o.Buckets[b] += sh.buckets[op][b].Load()
+			}
+		}
+		for e := range events {
+			events[e] += sh.events[e].Load()
+		}
+	}
+	for e, n := range events {
+		m.Events[metricEventNames[e]] = n
+	}
+	return m
+}
@@ -0,0 +1,84 @@
+package p256k1
+
+import (
+	"bytes"
+	"strings"
+	"testing"
+)
+
+func TestMetrics(t *testing.T) {
+	if !metricsEnabled {
+		if m := ReadMetrics(); len(m.Ops) != 0 || len(m.Events) != 0 {
+			t.Error("metrics reported without -tags p256k1metrics")
+		}
+		return
+	}
+
+	kp, err := KeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	xonly, err := kp.XOnlyPubkey()
+	if err != nil {
+		t.Fatal(err)
+	}
+	msg := make([]byte, 32)
+	var sig [64]byte
+
+	before := ReadMetrics()
+	if err := SchnorrSign(sig[:], msg, kp, nil); err != nil {
+		t.Fatal(err)
+	}
+	SchnorrVerify(sig[:], msg, xonly)
+	SchnorrVerify(sig[:], msg[:31], xonly)
+	var pk PublicKey
+	ECPubkeyParse(&pk, []byte{0x05})
+	cache := NewPubkeyCache(16)
+	cache.SchnorrVerify(sig[:], msg, xonly)
+	cache.SchnorrVerify(sig[:], msg, xonly)
+	after := ReadMetrics()
+
+	want := map[string][2]uint64{
+		"schnorr_sign":   {1, 0},
+		"schnorr_verify": {2, 1},
+		"pubkey_parse":   {1, 1},
+	}
+	for i, op := range after.Ops {
+		w, ok := want[op.Name]
+		if !ok {
+			continue
+		}
+		count := op.Count - before.Ops[i].Count
+		failures := op.Failures - before.Ops[i].Failures
+		if count != w[0] || failures != w[1] {
+			t.Errorf("%s: %d calls, %d failures; want %d, %d", op.Name, count, failures, w[0], w[1])
+		}
+		var n uint64
+		for _, b := range op.Buckets {
+			n += b
+		}
+		if n != op.Count {
+			t.Errorf("%s: histogram holds %d calls, want %d", op.Name, n, op.Count)
+		}
+	}
+	if d := after.Events["pubkey_cache_hit"] - before.Events["pubkey_cache_hit"]; d != 1 {
+		t.Errorf("%d cache hits, want 1", d)
+	}
+	if d := after.Events["pubkey_cache_miss"] - before.Events["pubkey_cache_miss"]; d != 1 {
+		t.Errorf("%d cache misses, want 1", d)
+	}
+
+	var buf bytes.Buffer
+	if err := after.WritePrometheus(&buf); err != nil {
+		t.Fatal(err)
+	}
+	for _, line := range []string{
+		`p256k1_op_duration_seconds_bucket{op="schnorr_verify",le="+Inf"}`,
+		`p256k1_op_failures_total{op="pubkey_parse"}`,
+		`p256k1_events_total{event="pubkey_cache_hit"}`,
+	} {
+		if !strings.Contains(buf.String(), line) {
+			t.Errorf("Prometheus output lacks %s", line)
+		}
+	}
+}
@@ -0,0 +1,566 @@
+package p256k1
+
+import "math/bits"
+
+// Modular inversion based on "Fast constant-time gcd computation and modular
+// inversion" by Daniel J. Bernstein and Bo-Yin Yang, ported from
+// src/modinv64_impl.h (secp256k1_modinv64 and secp256k1_modinv64_var). See
+// doc/safegcd_implementation.md in libsecp256k1 for an explanation of the
+// algorithm; this is the N=62 variant using signed 62-bit limbs.
+
+// signed62 is a signed 62-bit limb representation of an integer, whose value
+// is sum(v[i] * 2^(62*i), i=0..4)
+type signed62 struct {
+	v [5]int64
+}
+
+// modinv64ModInfo describes a modulus for modinv64
+type modinv64ModInfo struct {
+	// modulus in signed62 notation, odd and in [3, 2^256]
+	modulus signed62
+
+	// modulusInv62 is modulus^-1 mod 2^62
+	modulusInv62 uint64
+}
+
+// modinv64Trans2x2 is a transition matrix
+//
+//	t = [ u  v ]
+//	    [ q  r ]
+type modinv64Trans2x2 struct {
+	u, v, q, r int64
+}
+
+const modinv64M62 = ^uint64(0) >> 2
+
+// int128 is a signed 128-bit integer in two's complement, used for the
+// signed62 matrix products
+type int128 struct {
+	high, low uint64
+}
+
+// mulI128 returns the signed 128-bit product a*b
+func mulI128(a, b int64) int128 {
+	hi, lo := bits.Mul64(uint64(a), uint64(b))
+	// Correct the unsigned product for negative operands
+	hi -= uint64(a>>63) & uint64(b)
+	hi -= uint64(b>>63) & uint64(a)
+	return int128{high: hi, low: lo}
+}
+
+// accumMul returns c + a*b
+func (c int128) accumMul(a, b int64) int128 {
+	m := mulI128(a, b)
+	lo, carry := bits.Add64(c.low, m.low, 0)
+	hi, _ := bits.Add64(c.high, m.high, carry)
+	return int128{high: hi, low: lo}
+}
+
+// rshift62 returns c >> 62 (arithmetic shift)
+func (c int128) rshift62() int128 {
+	return int128{
+		high: uint64(int64(c.high) >> 62),
+		low:  c.low>>62 | c.high<<2,
+	}
+}
+
+// modinv64Normalize62 takes a signed62 number in range (-2*modulus, modulus)
+// and adds a multiple of the modulus to bring it to [0, modulus). If sign < 0
+// the input is also negated. Input limbs must be in (-2^62, 2^62); output
+// limbs are in [0, 2^62).
+func modinv64Normalize62(r *signed62, sign int64, modinfo *modinv64ModInfo) {
+	const m62 = int64(modinv64M62)
+	r0, r1, r2, r3, r4 := r.v[0], r.v[1], r.v[2], r.v[3], r.v[4]
+
+	// In a first step, add the modulus if the input is negative, and then
+	// negate if requested. This brings r from range (-2*modulus, modulus) to
+	// range (-modulus, modulus).
+	condAdd := r4 >> 63
+	r0 += modinfo.modulus.v[0] & condAdd
+	r1 += modinfo.modulus.v[1] & condAdd
+	r2 += modinfo.modulus.v[2] & condAdd
+	r3 += modinfo.modulus.v[3] & condAdd
+	r4 += modinfo.modulus.v[4] & condAdd
+	condNegate := sign >> 63
+	r0 = (r0 ^ condNegate) - condNegate
+	r1 = (r1 ^ condNegate) - condNegate
+	r2 = (r2 ^ condNegate) - condNegate
+	r3 = (r3 ^ condNegate) - condNegate
+	r4 = (r4 ^ condNegate) - condNegate
+	// Propagate the top bits, to bring limbs back to range (-2^62, 2^62)
+	r1 += r0 >> 62
+	r0 &= m62
+	r2 += r1 >> 62
+	r1 &= m62
+	r3 += r2 >> 62
+	r2 &= m62
+	r4 += r3 >> 62
+	r3 &= m62
+
+	// In a second step add the modulus again if the result is still
+	// negative, bringing r to range [0, modulus)
+	condAdd = r4 >> 63
+	r0 += modinfo.modulus.v[0] & condAdd
+	r1 += modinfo.modulus.v[1] & condAdd
+	r2 += modinfo.modulus.v[2] & condAdd
+	r3 += modinfo.modulus.v[3] & condAdd
+	r4 += modinfo.modulus.v[4] & condAdd
+	// And propagate again
+	r1 += r0 >> 62
+	r0 &= m62
+	r2 += r1 >> 62
+	r1 &= m62
+	r3 += r2 >> 62
+	r2 &= m62
+	r4 += r3 >> 62
+	r3 &= m62
+
+	r.v[0], r.v[1], r.v[2], r.v[3], r.v[4] = r0, r1, r2, r3, r4
+}
+
+// modinv64Divsteps59 computes the transition matrix and zeta for 59
+// divsteps in constant time (zeta = -(delta+1/2)). The matrix is scaled by
+// 2^62 rather than 2^59.
+func modinv64Divsteps59(zeta int64, f0, g0 uint64, t *modinv64Trans2x2) int64 {
+	// u, v, q, r start as the identity matrix times 8, as the caller expects
+	// a result scaled by 2^62. They are semantically signed but kept
+	// unsigned so the shifts are well defined.
+	u, v, q, r := uint64(8), uint64(0), uint64(0), uint64(8)
+	f, g := f0, g0
+
+	for i := 3; i < 62; i++ {
+		// Compute conditional masks for (zeta < 0) and for (g & 1)
+		mask1 := uint64(zeta >> 63)
+		mask2 := -(g & 1)
+		// Compute x, y, z, conditionally negated versions of f, u, v
+		x := (f ^ mask1) - mask1
+		y := (u ^ mask1) - mask1
+		z := (v ^ mask1) - mask1
+		// Conditionally add x, y, z to g, q, r
+		g += x & mask2
+		q += y & mask2
+		r += z & mask2
+		// mask1 is now a condition mask for (zeta < 0) and (g & 1)
+		mask1 &= mask2
+		// Conditionally change zeta into -zeta-2 or zeta-1
+		zeta = (zeta ^ int64(mask1)) - 1
+		// Conditionally add g, q, r to f, u, v
+		f += g & mask1
+		u += q & mask1
+		v += r & mask1
+		// Shifts
+		g >>= 1
+		u <<= 1
+		v <<= 1
+	}
+
+	t.u, t.v, t.q, t.r = int64(u), int64(v), int64(q), int64(r)
+	return zeta
+}
+
+// modinv64Divsteps62Var computes the transition matrix and eta for 62
+// divsteps in variable time (eta = -delta)
+func modinv64Divsteps62Var(eta int64, f0, g0 uint64, t *modinv64Trans2x2) int64 {
+	u, v, q, r := uint64(1), uint64(0), uint64(0), uint64(1)
+	f, g := f0, g0
+	i := 62
+
+	for {
+		// Use a sentinel bit to count zeros only up to i
+		zeros := bits.TrailingZeros64(g | (^uint64(0) << uint(i)))
+		// Perform zeros divsteps at once; they all just divide g by two
+		g >>= uint(zeros)
+		u <<= uint(zeros)
+		v <<= uint(zeros)
+		eta -= int64(zeros)
+		i -= zeros
+		// We're done once we've done 62 divsteps
+		if i == 0 {
+			break
+		}
+
+		var m, w uint64
+		// If eta is negative, negate it and replace f, g with g, -f
+		if eta < 0 {
+			eta = -eta
+			f, g = g, -f
+			u, q = q, -u
+			v, r = r, -v
+			// Use a formula to cancel out up to 6 bits of g. No more than i
+			// can be cancelled out (as we'd be done before that point), and no
+			// more than eta+1 as its sign will flip again once that happens.
+			limit := int(eta) + 1
+			if limit > i {
+				limit = i
+			}
+			// m is a mask for the bottom min(limit, 6) bits
+			m = (^uint64(0) >> uint(64-limit)) & 63
+			// Find what multiple of f must be added to g to cancel its
+			// bottom min(limit, 6) bits
+			w = (f * g * (f*f - 2)) & m
+		} else {
+			// Use a simpler formula that only cancels up to 4 bits of g, as
+			// eta tends to be smaller here
+			limit := int(eta) + 1
+			if limit > i {
+				limit = i
+			}
+			// m is a mask for the bottom min(limit, 4) bits
+			m = (^uint64(0) >> uint(64-limit)) & 15
+			// Find what multiple of f must be added to g to cancel its
+			// bottom min(limit, 4) bits
+			w = f + (((f + 1) & 4) << 1)
+			w = (-w * g) & m
+		}
+		g += f * w
+		q += u * w
+		r += v * w
+	}
+
+	t.u, t.v, t.q, t.r = int64(u), int64(v), int64(q), int64(r)
+	return eta
+}
+
+// modinv64UpdateDE62 computes (t/2^62) * [d, e] mod modulus, where t is a
+// transition matrix scaled by 2^62. On input and output d and e are in range
+// (-2*modulus, modulus); output limbs are in (-2^62, 2^62).
+func modinv64UpdateDE62(d, e *signed62, t *modinv64Trans2x2, modinfo *modinv64ModInfo) {
+	d0, d1, d2, d3, d4 := d.v[0], d.v[1], d.v[2], d.v[3], d.v[4]
+	e0, e1, e2, e3, e4 := e.v[0], e.v[1], e.v[2], e.v[3], e.v[4]
+	u, v, q, r := t.u, t.v, t.q, t.r
+
+	// [md, me] start as zero; plus [u, q] if d is negative; plus [v, r] if
+	// e is negative
+	sd := d4 >> 63
+	se := e4 >> 63
+	md := (u & sd) + (v & se)
+	me := (q & sd) + (r & se)
+	// Begin computing t*[d, e]
+	cd := mulI128(u, d0).accumMul(v, e0)
+	ce := mulI128(q, d0).accumMul(r, e0)
+	// Correct md, me so that t*[d, e]+modulus*[md, me] has 62 zero bottom bits
+	md -= int64((modinfo.modulusInv62*cd.low + uint64(md)) & modinv64M62)
+	me -= int64((modinfo.modulusInv62*ce.low + uint64(me)) & modinv64M62)
+	// Update the beginning of computation for t*[d, e]+modulus*[md, me] now
+	// md, me are known, and throw away the low 62 zero bits
+	cd = cd.accumMul(modinfo.modulus.v[0], md).rshift62()
+	ce = ce.accumMul(modinfo.modulus.v[0], me).rshift62()
+	// Compute limb 1 of t*[d, e]+modulus*[md, me], and store it as output
+	// limb 0 (= down shift)
+	cd = cd.accumMul(u, d1).accumMul(v, e1)
+	ce = ce.accumMul(q, d1).accumMul(r, e1)
+	if modinfo.modulus.v[1] != 0 {
+		cd = cd.accumMul(modinfo.modulus.v[1], md)
+		ce = ce.accumMul(modinfo.modulus.v[1], me)
+	}
+	d.v[0] = int64(cd.low & modinv64M62)
+	cd = cd.rshift62()
+	e.v[0] = int64(ce.low & modinv64M62)
+	ce = ce.rshift62()
+	// Compute limb 2, and store it as output limb 1
+	cd = cd.accumMul(u, d2).accumMul(v, e2)
+	ce = ce.accumMul(q, d2).accumMul(r, e2)
+	if modinfo.modulus.v[2] != 0 {
+		cd = cd.accumMul(modinfo.modulus.v[2], md)
+		ce = ce.accumMul(modinfo.modulus.v[2], me)
+	}
+	d.v[1] = int64(cd.low & modinv64M62)
+	cd = cd.rshift62()
+	e.v[1] = int64(ce.low & modinv64M62)
+	ce = ce.rshift62()
+	// Compute limb 3, and store it as output limb 2
+	cd = cd.accumMul(u, d3).accumMul(v, e3)
+	ce = ce.accumMul(q, d3).accumMul(r, e3)
+	if modinfo.modulus.v[3] != 0 {
+		cd = cd.accumMul(modinfo.modulus.v[3], md)
+		ce = ce.accumMul(modinfo.modulus.v[3], me)
+	}
+	d.v[2] = int64(cd.low & modinv64M62)
+	cd = cd.rshift62()
+	e.v[2] = int64(ce.low & modinv64M62)
+	ce = ce.rshift62()
+	// Compute limb 4, and store it as output limb 3
+	cd = cd.accumMul(u, d4).accumMul(v, e4)
+	ce = ce.accumMul(q, d4).accumMul(r, e4)
+	cd = cd.accumMul(modinfo.modulus.v[4], md)
+	ce = ce.accumMul(modinfo.modulus.v[4], me)
+	d.v[3] = int64(cd.low & modinv64M62)
+	cd = cd.rshift62()
+	e.v[3] = int64(ce.low & modinv64M62)
+	ce = ce.rshift62()
+	// What remains is limb 5; store it as output limb 4
+	d.v[4] = int64(cd.low)
+	e.v[4] = int64(ce.low)
+}
+
+// modinv64UpdateFG62 computes (t/2^62) * [f, g], where t is a transition
+// matrix scaled by 2^62
+func modinv64UpdateFG62(f, g *signed62, t *modinv64Trans2x2) {
+	modinv64UpdateFG62Var(5, f, g, t)
+}
+
+// modinv64UpdateFG62Var computes (t/2^62) * [f, g] on the bottom len limbs
+// of f and g
+func modinv64UpdateFG62Var(length int, f, g *signed62, t *modinv64Trans2x2) {
+	u, v, q, r := t.u, t.v, t.q, t.r
+
+	// Start computing t*[f, g], and throw away the bottom 62 zero bits
+	fi, gi := f.v[0], g.v[0]
+	cf := mulI128(u, fi).accumMul(v, gi).rshift62()
+	cg := mulI128(q, fi).accumMul(r, gi).rshift62()
+	// Now iteratively compute limb i=1..len of t*[f, g], and store them in
+	// output limb i-1 (shifting down by 62 bits)
+	for i := 1; i < length; i++ {
+		fi, gi = f.v[i], g.v[i]
+		cf = cf.accumMul(u, fi).accumMul(v, gi)
+		cg = cg.accumMul(q, fi).accumMul(r, gi)
+		f.v[i-1] = int64(cf.low & modinv64M62)
+		cf = cf.rshift62()
+		g.v[i-1] = int64(cg.low & modinv64M62)
+		cg = cg.rshift62()
+	}
+	// What remains is limb len; store it as output limb len-1
+	f.v[length-1] = int64(cf.low)
+	g.v[length-1] = int64(cg.low)
+}
+
+// modinv64 replaces x with its inverse modulo modinfo.modulus, in constant
+// time in x. x must be in [0, modulus); zero maps to zero.
+func modinv64(x *signed62, modinfo *modinv64ModInfo) {
+	// Start with d=0, e=1, f=modulus, g=x, zeta=-1
+	var d, e signed62
+	e.v[0] = 1
+	f := modinfo.modulus
+	g := *x
+	zeta := int64(-1) // zeta = -(delta+1/2); delta starts at 1/2
+
+	// Do 10 iterations of 59 divsteps each = 590 divsteps. This suffices for
+	// 256-bit inputs.
+	var t modinv64Trans2x2
+	for i := 0; i < 10; i++ {
+		zeta = modinv64Divsteps59(zeta, uint64(f.v[0]), uint64(g.v[0]), &t)
+		modinv64UpdateDE62(&d, &e, &t, modinfo)
+		modinv64UpdateFG62(&f, &g, &t)
+	}
+
+	// At this point g is 0 and (if x was not 0) f is +/-1, so d holds +/- the
+	// inverse. Optionally negate d and normalize it to [0, modulus).
+	modinv64Normalize62(&d, f.v[4], modinfo)
+	*x = d
+}
+
+// modinv64Var replaces x with its inverse modulo modinfo.modulus, in
+// variable time. x must be in [0, modulus); zero maps to zero.
+func modinv64Var(x *signed62, modinfo *modinv64ModInfo) {
+	// Start with d=0, e=1, f=modulus, g=x, eta=-1
+	var d, e signed62
+	e.v[0] = 1
+	f := modinfo.modulus
+	g := *x
+	length := 5
+	eta := int64(-1) // eta = -delta; delta is initially 1
+
+	// Do iterations of 62 divsteps each until g=0
+	var t modinv64Trans2x2
+	for {
+		eta = modinv64Divsteps62Var(eta, uint64(f.v[0]), uint64(g.v[0]), &t)
+		modinv64UpdateDE62(&d, &e, &t, modinfo)
+		modinv64UpdateFG62Var(length, &f, &g, &t)
+
+		// If the bottom limb of g is zero, there is a chance that g=0
+		if g.v[0] == 0 {
+			cond := int64(0)
+			for j := 1; j < length; j++ {
+				cond |= g.v[j]
+			}
+			if cond == 0 {
+				break
+			}
+		}
+
+		// Determine if len>1 and limb (len-1) of both f and g is 0 or -1
+		fn := f.v[length-1]
+		gn := g.v[length-1]
+		cond := (int64(length) - 2) >> 63
+		cond |= fn ^ (fn >> 63)
+		cond |= gn ^ (gn >> 63)
+		// If so, reduce length, propagating the sign of f and g's top limb
+		// into the one below
+		if cond == 0 {
+			f.v[length-2] |= int64(uint64(fn) << 62)
+			g.v[length-2] |= int64(uint64(gn) << 62)
+			length--
+		}
+	}
+
+	// g is 0 and (if x was not 0) f is +/-1, so d holds +/- the inverse
+	modinv64Normalize62(&d, f.v[length-1], modinfo)
+	*x = d
+}
+
+// modinv64PosDivsteps62Var computes the transition matrix and eta for 62
+// posdivsteps in variable time (eta = -delta), tracking the Jacobi symbol
+// along the way. f0 and g0 are f and g mod 2^64 rather than 2^62, as the
+// tracking needs f mod 8. The bottom bit of *jac is flipped if and only if
+// the Jacobi symbol of (f | g) changes sign by applying the matrix; its other
+// bits are meaningless.
+func modinv64PosDivsteps62Var(eta int64, f0, g0 uint64, t *modinv64Trans2x2, jac *int) int64 {
+	u, v, q, r := uint64(1), uint64(0), uint64(0), uint64(1)
+	f, g := f0, g0
+	i := 62
+	j := *jac
+
+	for {
+		// Use a sentinel bit to count zeros only up to i
+		zeros := bits.TrailingZeros64(g | (^uint64(0) << uint(i)))
+		// Perform zeros divsteps at once; they all just divide g by two
+		g >>= uint(zeros)
+		u <<= uint(zeros)
+		v <<= uint(zeros)
+		eta -= int64(zeros)
+		i -= zeros
+		// When dividing g by an odd power of 2, the Jacobi symbol changes
+		// sign if f mod 8 is 3 or 5
+		j ^= zeros & int((f>>1)^(f>>2))
+		// We're done once we've done 62 posdivsteps
+		if i == 0 {
+			break
+		}
+
+		var m, w uint64
+		// If eta is negative, negate it and replace f, g with g, f
+		if eta < 0 {
+			eta = -eta
+			f, g = g, f
+			u, q = q, u
+			v, r = r, v
+			// When swapping f and g, the Jacobi symbol changes sign if both
+			// are 3 mod 4
+			j ^= int((f & g) >> 1)
+			// Use a formula to cancel out up to 6 bits of g, as in
+			// modinv64Divsteps62Var
+			limit := int(eta) + 1
+			if limit > i {
+				limit = i
+			}
+			m = (^uint64(0) >> uint(64-limit)) & 63
+			w = (f * g * (f*f - 2)) & m
+		} else {
+			// Use a simpler formula that only cancels up to 4 bits of g
+			limit := int(eta) + 1
+			if limit > i {
+				limit = i
+			}
+			m = (^uint64(0) >> uint(64-limit)) & 15
+			w = f + (((f + 1) & 4) << 1)
+			w = (-w * g) & m
+		}
+		g += f * w
+		q += u * w
+		r += v * w
+	}
+
+	t.u, t.v, t.q, t.r = int64(u), int64(v), int64(q), int64(r)
+	*jac = j
+	return eta
+}
+
+// jacobi64MaybeVar returns the Jacobi symbol of x modulo modinfo.modulus in
+// variable time, or 0 if it did not converge within jacobi64Iterations
+// rounds. The limbs of x must be non-negative, and gcd(x, modulus) must be 1,
+// so x must not be zero.
+func jacobi64MaybeVar(x *signed62, modinfo *modinv64ModInfo) int {
+	// Start with f=modulus, g=x, eta=-1
+	f := modinfo.modulus
+	g := *x
+	length := 5
+	eta := int64(-1) // eta = -delta; delta is initially 1
+	jac := 0
+
+	var t modinv64Trans2x2
+	for count := 0; count < jacobi64Iterations; count++ {
+		eta = modinv64PosDivsteps62Var(eta, uint64(f.v[0])|uint64(f.v[1])<<62, uint64(g.v[0])|uint64(g.v[1])<<62, &t, &jac)
+		modinv64UpdateFG62Var(length, &f, &g, &t)
+
+		// If the bottom limb of f is 1, there is a chance that f=1, in
+		// which case the Jacobi symbol (g | f) is 1
+		if f.v[0] == 1 {
+			cond := int64(0)
+			for j := 1; j < length; j++ {
+				cond |= f.v[j]
+			}
+			if cond == 0 {
+				return 1 - 2*(jac&1)
+			}
+		}
+
+		// Determine if len>1 and limb (len-1) of both f and g is 0. Both
+		// stay positive, so no sign needs propagating.
+		cond := (int64(length) - 2) >> 63
+		cond |= f.v[length-1]
+		cond |= g.v[length-1]
+		if cond == 0 {
+			length--
+		}
+	}
+	return 0
+}
+
+// Moduli for field and scalar inversion, as secp256k1_const_modinfo_fe and
+// secp256k1_const_modinfo_scalar
+var (
+	modinv64ModInfoFE = modinv64ModInfo{
+		modulus:      signed62{v: [5]int64{-0x1000003D1, 0, 0, 0, 256}},
+		modulusInv62: 0x27C7F6E22DDACACF,
+	}
+	modinv64ModInfoScalar = modinv64ModInfo{
+		modulus:      signed62{v: [5]int64{0x3FD25E8CD0364141, 0x2ABB739ABD2280EE, -0x15, 0, 256}},
+		modulusInv62: 0x34F20099AA774EC1,
+	}
+)
+
+// toSigned62 converts a normalized field element to signed62 form
+func (a *FieldElement) toSigned62(r *signed62) {
+	a0, a1, a2, a3, a4 := a.n[0], a.n[1], a.n[2], a.n[3], a.n[4]
+
+	r.v[0] = int64((a0 | a1<<52) & modinv64M62)
+	r.v[1] = int64((a1>>10 | a2<<42) & modinv64M62)
+	r.v[2] = int64((a2>>20 | a3<<32) & modinv64M62)
+	r.v[3] = int64((a3>>30 | a4<<22) & modinv64M62)
+	r.v[4] = int64(a4 >> 40)
+}
+
+// fromSigned62 sets r from a signed62 value in [0, p) with limbs in [0, 2^62)
+func (r *FieldElement) fromSigned62(a *signed62) {
+	const m52 = ^uint64(0) >> 12
+	a0, a1, a2, a3, a4 := uint64(a.v[0]), uint64(a.v[1]), uint64(a.v[2]), uint64(a.v[3]), uint64(a.v[4])
+
+	r.n[0] = a0 & m52
+	r.n[1] = (a0>>52 | a1<<10) & m52
+	r.n[2] = (a1>>42 | a2<<20) & m52
+	r.n[3] = (a2>>32 | a3<<30) & m52
+	r.n[4] = a3>>22 | a4<<40
+	r.magnitude = 1
+	r.normalized = true
+}
+
+// toSigned62 converts a scalar to signed62 form
+func (a *Scalar) toSigned62(r *signed62) {
+	a0, a1, a2, a3 := a.d[0], a.d[1], a.d[2], a.d[3]
+
+	r.v[0] = int64(a0 & modinv64M62)
+	r.v[1] = int64((a0>>62 | a1<<2) & modinv64M62)
+	r.v[2] = int64((a1>>60 | a2<<4) & modinv64M62)
+	r.v[3] = int64((a2>>58 | a3<<6) & modinv64M62)
+	r.v[4] = int64(a3 >> 56)
+}
+
+// fromSigned62 sets r from a signed62 value in [0, n) with limbs in [0, 2^62)
+func (r *Scalar) fromSigned62(a *signed62) {
+	a0, a1, a2, a3, a4 := uint64(a.v[0]), uint64(a.v[1]), uint64(a.v[2]), uint64(a.v[3]), uint64(a.v[4])
+
+	r.d[0] = a0 | a1<<62
+	r.d[1] = a1>>2 | a2<<60
+	r.d[2] = a2>>4 | a3<<58
+	r.d[3] = a3>>6 | a4<<56
+}
@@ -0,0 +1,178 @@
+package p256k1
+
+import (
+	"crypto/rand"
+	"math/big"
+	"testing"
+)
+
+var (
+	modinvFieldP, _  = new(big.Int).SetString("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F", 16)
+	modinvScalarN, _ = new(big.Int).SetString("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141", 16)
+)
+
+// modinvTestValues returns edge case values below m followed by random ones
+func modinvTestValues(t testing.TB, m *big.Int) []*big.Int {
+	one := big.NewInt(1)
+	vals := []*big.Int{
+		big.NewInt(0),
+		big.NewInt(1),
+		big.NewInt(2),
+		new(big.Int).Sub(m, one),
+		new(big.Int).Sub(m, big.NewInt(2)),
+		new(big.Int).Rsh(m, 1),
+		new(big.Int).Lsh(one, 62),
+		new(big.Int).Sub(new(big.Int).Lsh(one, 248), one),
+		new(big.Int).Lsh(one, 255),
+	}
+	for i := 0; i < 64; i++ {
+		v, err := rand.Int(rand.Reader, m)
+		if err != nil {
+			t.Fatal(err)
+		}
+		vals = append(vals, v)
+	}
+	return vals
+}
+
+func TestFieldElementInverse(t *testing.T) {
+	for _, v := range modinvTestValues(t, modinvFieldP) {
+		var b [32]byte
+		v.FillBytes(b[:])
+
+		var a, inv, invVar FieldElement
+		if err := a.setB32(b[:]); err != nil {
+			t.Fatal(err)
+		}
+		inv.inv(&a)
+		invVar.invVar(&a)
+
+		want := new(big.Int).ModInverse(v, modinvFieldP)
+		if want == nil {
+			want = new(big.Int)
+		}
+		var wantB, gotB, gotVarB [32]byte
+		want.FillBytes(wantB[:])
+		inv.getB32(gotB[:])
+		invVar.getB32(gotVarB[:])
+		if gotB != wantB {
+			t.Fatalf("inv(%x) = %x, want %x", b, gotB, wantB)
+		}
+		if gotVarB != wantB {
+			t.Fatalf("invVar(%x) = %x, want %x", b, gotVarB, wantB)
+		}
+	}
+
+	// Inputs of higher magnitude are normalized first
+	var a, neg, inv, want FieldElement
+	a.setInt(3)
+	neg.negate(&a, 1)
+	neg.mulInt(4)
+	inv.inv(&neg)
+	a.setInt(12)
+	a.negate(&a, 1)
+	a.normalize()
+	want.inv(&a)
+	inv.normalize()
+	if !inv.equal(&want) {
+		t.Error("inverse of an unnormalized input is wrong")
+	}
+}
+
+func TestFieldElementIsSquareVar(t *testing.T) {
+	for _, v := range modinvTestValues(t, modinvFieldP) {
+		var b [32]byte
+		v.FillBytes(b[:])
+		var a FieldElement
+		if err := a.setB32(b[:]); err != nil {
+			t.Fatal(err)
+		}
+		want := big.Jacobi(v, modinvFieldP)
+
+		if v.Sign() != 0 {
+			// The symbol itself, where it converges
+			var s signed62
+			aNorm := a
+			aNorm.normalize()
+			aNorm.toSigned62(&s)
+			if jac := jacobi64MaybeVar(&s, &modinv64ModInfoFE); jac != 0 && jac != want {
+				t.Fatalf("jacobi(%x) = %d, want %d", b, jac, want)
+			}
+		}
+		if got := a.isSquareVar(); got != (want >= 0) {
+			t.Fatalf("isSquareVar(%x) = %v, want %v", b, got, want >= 0)
+		}
+
+		// Unnormalized inputs give the same answer
+		var neg FieldElement
+		neg.negate(&a, 1)
+		neg.negate(&neg, 2)
+		if neg.isSquareVar() != (want >= 0) {
+			t.Fatalf("isSquareVar of an unnormalized %x is wrong", b)
+		}
+	}
+}
+
+func TestScalarInverseSafegcd(t *testing.T) {
+	for _, v := range modinvTestValues(t, modinvScalarN) {
+		var b [32]byte
+		v.FillBytes(b[:])
+
+		var a, inv, invVar Scalar
+		a.setB32(b[:])
+		inv.inverse(&a)
+		invVar.inverseVar(&a)
+
+		want := new(big.Int).ModInverse(v, modinvScalarN)
+		if want == nil {
+			want = new(big.Int)
+		}
+		var wantB, gotB, gotVarB [32]byte
+		want.FillBytes(wantB[:])
+		inv.getB32(gotB[:])
+		invVar.getB32(gotVarB[:])
+		if gotB != wantB {
+			t.Fatalf("inverse(%x) = %x, want %x", b, gotB, wantB)
+		}
+		if gotVarB != wantB {
+			t.Fatalf("inverseVar(%x) = %x, want %x", b, gotVarB, wantB)
+		}
+	}
+}
+
+func BenchmarkInverse(b *testing.B) {
+	var fe, feInv FieldElement
+	var s, sInv Scalar
+	var buf [32]byte
+	if _, err := rand.Read(buf[:]); err != nil {
+		b.Fatal(err)
+	}
+	fe.setB32(buf[:])
+	s.setB32(buf[:])
+
+	b.Run("field", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			feInv.inv(&fe)
+		}
+	})
+	b.Run("field_var", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			feInv.invVar(&fe)
+		}
+	})
+	b.Run("field_jacobi", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			fe.isSquareVar()
+		}
+	})
+	b.Run("scalar", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			sInv.inverse(&s)
+		}
+	})
+	b.Run("scalar_var", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			sInv.inverseVar(&s)
+		}
+	})
+}
@@ -0,0 +1,754 @@
+package p256k1
+
+import (
+	"crypto/sha256"
+	"encoding/binary"
+	"errors"
+	"sort"
+	"sync"
+	"unsafe"
+
+	sha256simd "github.com/minio/sha256-simd"
+)
+
+// MuSig2 multi-signatures as specified in BIP-327. A group of signers
+// aggregates its public keys into one x-only key, and two rounds of
+// communication (public nonces, then partial signatures) produce a plain
+// BIP-340 signature under it that SchnorrVerify accepts.
+//
+// Key aggregation computes Q = sum a_i*P_i with one multi-scalar
+// multiplication, Pippenger from ecmultPippengerThreshold keys on. The
+// coefficients a_i are kept in the MusigKeyAggCache, so signing and partial
+// verification against the same key set do not hash the key list again.
+// Partial signatures can be verified as a batch with a random linear
+// combination, as SchnorrVerifyBatch does.
+
+// Tagged hash midstates of the MuSig2 tags
+var (
+	musigKeyAggListMidstate  []byte
+	musigKeyAggCoeffMidstate []byte
+	musigAuxMidstate         []byte
+	musigNonceMidstate       []byte
+	musigNonceCoefMidstate   []byte
+	musigMidstateOnce        sync.Once
+)
+
+func initMusigMidstates() {
+	midstate := func(tag string) []byte {
+		tagHash := sha256.Sum256([]byte(tag))
+		return taggedHashMidstate(&tagHash)
+	}
+	musigKeyAggListMidstate = midstate("KeyAgg list")
+	musigKeyAggCoeffMidstate = midstate("KeyAgg coefficient")
+	musigAuxMidstate = midstate("MuSig/aux")
+	musigNonceMidstate = midstate("MuSig/nonce")
+	musigNonceCoefMidstate = midstate("MuSig/noncecoef")
+}
+
+// musigBatchTag domain-separates the hash that seeds the randomizers of
+// MusigPartialSigVerifyBatch
+var musigBatchTag = []byte("MuSig/batch")
+
+// MusigKeyAggCache holds an aggregate public key together with what signing
+// and partial verification need to know about the key set: its key list
+// hash, second distinct key and per-key coefficients, and the accumulated
+// effect of the tweaks applied to it.
+//
+// The cache is read-only during signing, so one cache can serve concurrent
+// sessions; the tweak methods modify it and must not race with them. Clone
+// gives an independent copy whose tweaks do not affect the original.
+type MusigKeyAggCache struct {
+	q    GroupElementAffine // aggregate key, tweaked
+	gacc Scalar             // product of the tweak negations, +-1
+	tacc Scalar             // accumulated tweak
+	l    [32]byte           // hash_KeyAgg list of the key list
+	pk2  [33]byte           // second distinct key, zero if there is none
+
+	// coeffs maps each key of the set to its coefficient. It is shared
+	// between clones and never written after MusigPubkeyAgg.
+	coeffs map[[33]byte]Scalar
+}
+
+// MusigPubkeyAgg aggregates public keys, in the given order, as the KeyAgg
+// algorithm of BIP-327. The same key may occur more than once.
+func MusigPubkeyAgg(pubkeys []*PublicKey) (*MusigKeyAggCache, error) {
+	n := len(pubkeys)
+	if n == 0 {
+		return nil, errors.New("no public keys to aggregate")
+	}
+	musigMidstateOnce.Do(initMusigMidstates)
+
+	s := scratchPool.Get().(*Scratch)
+	defer scratchPool.Put(s)
+	cp := s.Checkpoint()
+	defer s.Rollback(cp)
+
+	points := s.affine.alloc(n)
+	scalars := s.scalars.alloc(n)
+	ser := make([][33]byte, n)
+
+	c := &MusigKeyAggCache{coeffs: make(map[[33]byte]Scalar, n)}
+	h := getTaggedHasher(musigKeyAggListMidstate)
+	for i, pk := range pubkeys {
+		if pk == nil || ECPubkeySerialize(ser[i][:], pk, ECCompressed) != 33 {
+			taggedHasherPool.Put(h)
+			return nil, errors.New("invalid public key")
+		}
+		pubkeyLoad(&points[i], pk)
+		h.write(ser[i][:])
+	}
+	h.sum(c.l[:])
+	for i := 1; i < n; i++ {
+		if ser[i] != ser[0] {
+			c.pk2 = ser[i]
+			break
+		}
+	}
+
+	for i := range ser {
+		a, ok := c.coeffs[ser[i]]
+		if !ok {
+			h.reset(musigKeyAggCoeffMidstate)
+			c.keyAggCoeff(&a, h, &ser[i])
+			c.coeffs[ser[i]] = a
+		}
+		scalars[i] = a
+	}
+	taggedHasherPool.Put(h)
+
+	var qj GroupElementJacobian
+	ecmultMultiVar(s, &qj, points, scalars, nil)
+	if qj.isInfinity() {
+		return nil, errors.New("aggregate public key is infinity")
+	}
+	c.q.setGEJVar(&qj)
+	c.q.x.normalize()
+	c.q.y.normalize()
+	c.gacc.setInt(1)
+	return c, nil
+}
+
+// keyAggCoeff sets a to the KeyAggCoeff of the key pk33 in the set of c,
+// using h, which must be reset to the coefficient midstate. h is left
+// without staged input.
+func (c *MusigKeyAggCache) keyAggCoeff(a *Scalar, h *taggedHasher, pk33 *[33]byte) {
+	if *pk33 == c.pk2 {
+		a.setInt(1)
+		return
+	}
+	var digest [32]byte
+	h.write(c.l[:])
+	h.write(pk33[:])
+	h.sum(digest[:])
+	a.setB32(digest[:])
+}
+
+// coeff sets a to the coefficient of the key pk33, from the cache if it is
+// one of the aggregated keys
+func (c *MusigKeyAggCache) coeff(a *Scalar, pk33 *[33]byte) {
+	if v, ok := c.coeffs[*pk33]; ok {
+		*a = v
+		return
+	}
+	musigMidstateOnce.Do(initMusigMidstates)
+	h := getTaggedHasher(musigKeyAggCoeffMidstate)
+	c.keyAggCoeff(a, h, pk33)
+	taggedHasherPool.Put(h)
+}
+
+// Clone returns a copy of the cache that can be tweaked independently
+func (c *MusigKeyAggCache) Clone() *MusigKeyAggCache {
+	d := *c
+	return &d
+}
+
+// AggPubkey returns the x-only aggregate public key, the key the final
+// signature verifies under
+func (c *MusigKeyAggCache) AggPubkey() XOnlyPubkey {
+	var xonly XOnlyPubkey
+	c.q.x.getB32(xonly.data[:])
+	return xonly
+}
+
+// Pubkey returns the aggregate public key with its y coordinate, as needed
+// for plain tweaking by a BIP-32 style derivation
+func (c *MusigKeyAggCache) Pubkey() PublicKey {
+	var pubkey PublicKey
+	q := c.q
+	pubkeySave(&pubkey, &q)
+	return pubkey
+}
+
+// PubkeyTweakAdd adds tweak32*G to the aggregate key, as the plain tweak of
+// BIP-327. The cache is unchanged on error.
+func (c *MusigKeyAggCache) PubkeyTweakAdd(tweak32 []byte) error {
+	return c.tweakAdd(tweak32, false)
+}
+
+// XOnlyTweakAdd adds tweak32*G to the aggregate key negated to even y, as
+// the x-only tweak of BIP-327 used for BIP-341 taproot outputs. The cache is
+// unchanged on error.
+func (c *MusigKeyAggCache) XOnlyTweakAdd(tweak32 []byte) error {
+	return c.tweakAdd(tweak32, true)
+}
+
+// tweakAdd implements ApplyTweak: with g = -1 for an x-only tweak of a key
+// with odd y and 1 otherwise, Q' = g*Q + t*G, gacc' = g*gacc and
+// tacc' = t + g*tacc
+func (c *MusigKeyAggCache) tweakAdd(tweak32 []byte, xonly bool) error {
+	var t Scalar
+	if len(tweak32) != 32 || t.setB32(tweak32) {
+		return errors.New("invalid tweak")
+	}
+	q, gacc, tacc := c.q, c.gacc, c.tacc
+	if xonly && q.y.isOdd() {
+		q.negate(&q)
+		gacc.negate(&gacc)
+		tacc.negate(&tacc)
+	}
+
+	var qj GroupElementJacobian
+	EcmultGen(&qj, &t)
+	qj.addGE(&qj, &q)
+	if qj.isInfinity() {
+		return errors.New("tweaked aggregate public key is infinity")
+	}
+	c.q.setGEJVar(&qj)
+	c.q.x.normalize()
+	c.q.y.normalize()
+	c.gacc = gacc
+	c.tacc.add(&t, &tacc)
+	return nil
+}
+
+// MusigSecNonce is the secret nonce of one signing session. It must be used
+// for exactly one MusigPartialSign, which wipes it, and must never be
+// serialized or copied: signing twice with the same nonce leaks the secret
+// key.
+type MusigSecNonce struct {
+	k  [2]Scalar
+	pk [33]byte
+}
+
+// MusigPubNonce is the public nonce of a signer, R1 and R2
+type MusigPubNonce struct {
+	r [2]PublicKey
+}
+
+// MusigAggNonce is the sum of the public nonces of all signers; either point
+// may be infinity
+type MusigAggNonce struct {
+	r [2]PublicKey
+}
+
+// Serialize returns the 66 byte encoding of the nonce, the compressed R1 and
+// R2
+func (n *MusigPubNonce) Serialize() [66]byte {
+	var out [66]byte
+	musigNoncePointSave(out[:33], &n.r[0])
+	musigNoncePointSave(out[33:], &n.r[1])
+	return out
+}
+
+// Parse sets the nonce from its 66 byte encoding
+func (n *MusigPubNonce) Parse(in66 []byte) error {
+	if len(in66) != 66 {
+		return errors.New("public nonce must be 66 bytes")
+	}
+	var r [2]PublicKey
+	for j := range r {
+		if !musigNoncePointParse(&r[j], in66[33*j:33*j+33], false) {
+			return errors.New("invalid public nonce")
+		}
+	}
+	n.r = r
+	return nil
+}
+
+// Serialize returns the 66 byte encoding of the aggregate nonce, where a
+// point at infinity is 33 zero bytes
+func (n *MusigAggNonce) Serialize() [66]byte {
+	var out [66]byte
+	musigNoncePointSave(out[:33], &n.r[0])
+	musigNoncePointSave(out[33:], &n.r[1])
+	return out
+}
+
+// Parse sets the aggregate nonce from its 66 byte encoding
+func (n *MusigAggNonce) Parse(in66 []byte) error {
+	if len(in66) != 66 {
+		return errors.New("aggregate nonce must be 66 bytes")
+	}
+	var r [2]PublicKey
+	for j := range r {
+		if !musigNoncePointParse(&r[j], in66[33*j:33*j+33], true) {
+			return errors.New("invalid aggregate nonce")
+		}
+	}
+	n.r = r
+	return nil
+}
+
+// musigNoncePointSave writes the 33 byte compressed encoding of p to out,
+// zeros for infinity
+func musigNoncePointSave(out []byte, p *PublicKey) {
+	if ECPubkeySerialize(out, p, ECCompressed) != 33 {
+		for i := range out[:33] {
+			out[i] = 0
+		}
+	}
+}
+
+// musigNoncePointParse parses a 33 byte compressed point, accepting 33 zero
+// bytes as infinity if infinity is set
+func musigNoncePointParse(p *PublicKey, in33 []byte, infinity bool) bool {
+	if infinity && *(*[33]byte)(in33) == ([33]byte{}) {
+		*p = PublicKey{}
+		return true
+	}
+	return ECPubkeyParse(p, in33) == nil
+}
+
+// MusigNonceGen generates the nonce pair of a signer for one session, as
+// NonceGen of BIP-327. rand32 must be 32 bytes of fresh randomness for every
+// call; reusing it with the same inputs gives the same nonce. pubkey is the
+// signer's individual public key. seckey, cache, msg and extra are optional
+// (nil) inputs that make the nonce more robust against weak randomness;
+// an empty but non-nil msg is a message of length zero.
+func MusigNonceGen(secnonce *MusigSecNonce, pubnonce *MusigPubNonce, rand32 []byte, seckey []byte, pubkey *PublicKey, cache *MusigKeyAggCache, msg []byte, extra []byte) error {
+	if len(rand32) != 32 {
+		return errors.New("rand32 must be 32 bytes")
+	}
+	if seckey != nil && len(seckey) != 32 {
+		return errors.New("seckey must be 32 bytes")
+	}
+	var pk33 [33]byte
+	if pubkey == nil || ECPubkeySerialize(pk33[:], pubkey, ECCompressed) != 33 {
+		return errors.New("invalid public key")
+	}
+	musigMidstateOnce.Do(initMusigMidstates)
+
+	var rnd [32]byte
+	h := getTaggedHasher(musigAuxMidstate)
+	if seckey != nil {
+		h.write(rand32)
+		h.sum(rnd[:])
+		for i := range rnd {
+			rnd[i] ^= seckey[i]
+		}
+	} else {
+		copy(rnd[:], rand32)
+	}
+
+	var aggpk []byte
+	var aggpkX XOnlyPubkey
+	if cache != nil {
+		aggpkX = cache.AggPubkey()
+		aggpk = aggpkX.data[:]
+	}
+
+	var sn MusigSecNonce
+	var digest [32]byte
+	var lenBuf [8]byte
+	for i := range sn.k {
+		h.reset(musigNonceMidstate)
+		h.write(rnd[:])
+		h.write([]byte{33})
+		h.write(pk33[:])
+		h.write([]byte{byte(len(aggpk))})
+		h.write(aggpk)
+		if msg == nil {
+			h.write([]byte{0})
+		} else {
+			h.write([]byte{1})
+			binary.BigEndian.PutUint64(lenBuf[:], uint64(len(msg)))
+			h.write(lenBuf[:])
+			h.write(msg)
+		}
+		binary.BigEndian.PutUint32(lenBuf[:4], uint32(len(extra)))
+		h.write(lenBuf[:4])
+		h.write(extra)
+		h.write([]byte{byte(i)})
+		h.sum(digest[:])
+		sn.k[i].setB32(digest[:])
+	}
+	h.clearState()
+	taggedHasherPool.Put(h)
+	memclear(unsafe.Pointer(&rnd[0]), 32)
+	memclear(unsafe.Pointer(&digest[0]), 32)
+
+	if sn.k[0].isZero() || sn.k[1].isZero() {
+		sn.k[0].clear()
+		sn.k[1].clear()
+		return errors.New("nonce generation failed")
+	}
+
+	gen := getGlobalGenContext()
+	var pn MusigPubNonce
+	for i := range sn.k {
+		var rj GroupElementJacobian
+		var r GroupElementAffine
+		gen.ecmultGen(&rj, &sn.k[i])
+		r.setGEJ(&rj)
+		pubkeySave(&pn.r[i], &r)
+		rj.clear()
+	}
+	sn.pk = pk33
+	*secnonce = sn
+	*pubnonce = pn
+	sn.k[0].clear()
+	sn.k[1].clear()
+	return nil
+}
+
+// MusigNonceAgg sums the public nonces of all signers into the aggregate
+// nonce, as NonceAgg of BIP-327
+func MusigNonceAgg(aggnonce *MusigAggNonce, pubnonces []*MusigPubNonce) error {
+	if len(pubnonces) == 0 {
+		return errors.New("no public nonces to aggregate")
+	}
+	var sum [2]GroupElementJacobian
+	var r [2]GroupElementAffine
+	sum[0].setInfinity()
+	sum[1].setInfinity()
+	for _, pn := range pubnonces {
+		if pn == nil {
+			return errors.New("invalid public nonce")
+		}
+		for j := range r {
+			pubkeyLoad(&r[j], &pn.r[j])
+			if r[j].isInfinity() {
+				return errors.New("invalid public nonce")
+			}
+			sum[j].addGE(&sum[j], &r[j])
+		}
+	}
+	geSetAllGEJVar(r[:], sum[:])
+	pubkeySave(&aggnonce.r[0], &r[0])
+	pubkeySave(&aggnonce.r[1], &r[1])
+	return nil
+}
+
+// MusigSession holds the values every signer derives from the aggregate
+// nonce, the message and the key set: the nonce coefficient b, the final
+// nonce R and the challenge e
+type MusigSession struct {
+	b     Scalar
+	e     Scalar
+	r32   [32]byte // x(R)
+	rOdd  bool     // whether R has odd y
+	qOdd  bool     // whether the aggregate key has odd y
+	sPart Scalar   // e*g*tacc, added to the sum of the partial signatures
+}
+
+// MusigNonceProcess sets up the session of msg, of any length, signed by the
+// key set of cache with the aggregate nonce aggnonce
+func MusigNonceProcess(session *MusigSession, aggnonce *MusigAggNonce, msg []byte, cache *MusigKeyAggCache) error {
+	if aggnonce == nil || cache == nil {
+		return errors.New("missing aggregate nonce or key aggregation cache")
+	}
+	musigMidstateOnce.Do(initMusigMidstates)
+
+	// b = int(hash_MuSig/noncecoef(aggnonce || xbytes(Q) || m)) mod n
+	ser := aggnonce.Serialize()
+	qx := cache.AggPubkey()
+	var digest [32]byte
+	var sess MusigSession
+	h := getTaggedHasher(musigNonceCoefMidstate)
+	h.write(ser[:])
+	h.write(qx.data[:])
+	h.write(msg)
+	h.finalize(digest[:])
+	sess.b.setB32(digest[:])
+
+	// R = R1 + b*R2, or G if that is infinity
+	var r1, r2 GroupElementAffine
+	pubkeyLoad(&r1, &aggnonce.r[0])
+	pubkeyLoad(&r2, &aggnonce.r[1])
+	var rj GroupElementJacobian
+	rj.setInfinity()
+	if !r2.isInfinity() {
+		var r2j GroupElementJacobian
+		r2j.setGE(&r2)
+		Ecmult(&rj, &r2j, &sess.b)
+	}
+	if !r1.isInfinity() {
+		rj.addGE(&rj, &r1)
+	}
+	var R GroupElementAffine
+	if rj.isInfinity() {
+		R = Generator
+	} else {
+		R.setGEJVar(&rj)
+	}
+	R.x.normalize()
+	R.y.normalize()
+	R.x.getB32(sess.r32[:])
+	sess.rOdd = R.y.isOdd()
+
+	bip340Challenge(&sess.e, sess.r32[:], qx.data[:], msg)
+
+	// With g = -1 if Q has odd y, the aggregate signature gets e*g*tacc on
+	// top of the partial signatures
+	sess.qOdd = cache.q.y.isOdd()
+	sess.sPart.mul(&sess.e, &cache.tacc)
+	if sess.qOdd {
+		sess.sPart.negate(&sess.sPart)
+	}
+	*session = sess
+	return nil
+}
+
+// MusigPartialSig is the partial signature of one signer
+type MusigPartialSig struct {
+	s Scalar
+}
+
+// Serialize returns the 32 byte encoding of the partial signature
+func (p *MusigPartialSig) Serialize() [32]byte {
+	var out [32]byte
+	p.s.getB32(out[:])
+	return out
+}
+
+// Parse sets the partial signature from its 32 byte encoding, rejecting
+// values not below the group order
+func (p *MusigPartialSig) Parse(in32 []byte) error {
+	var s Scalar
+	if len(in32) != 32 || s.setB32(in32) {
+		return errors.New("invalid partial signature")
+	}
+	p.s = s
+	return nil
+}
+
+// MusigPartialSign creates the partial signature of the signer of keypair
+// in session, as Sign of BIP-327. secnonce is wiped first, whether or not
+// signing succeeds, so it cannot be used twice.
+func MusigPartialSign(psig *MusigPartialSig, secnonce *MusigSecNonce, keypair *KeyPair, cache *MusigKeyAggCache, session *MusigSession) error {
+	k := secnonce.k
+	pkNonce := secnonce.pk
+	secnonce.k[0].clear()
+	secnonce.k[1].clear()
+	secnonce.pk = [33]byte{}
+	defer func() {
+		k[0].clear()
+		k[1].clear()
+	}()
+	if k[0].isZero() || k[1].isZero() {
+		return errors.New("secret nonce is invalid or was already used")
+	}
+
+	var pk33 [33]byte
+	if ECPubkeySerialize(pk33[:], &keypair.pubkey, ECCompressed) != 33 {
+		return errors.New("invalid public key")
+	}
+	if pk33 != pkNonce {
+		return errors.New("secret nonce was generated for a different public key")
+	}
+	a, ok := cache.coeffs[pk33]
+	if !ok {
+		return errors.New("public key is not one of the aggregated keys")
+	}
+	var d Scalar
+	if !d.setB32Seckey(keypair.seckey[:]) {
+		return errors.New("invalid secret key")
+	}
+	defer d.clear()
+
+	// d = g*gacc*d' with g = -1 if Q has odd y; the nonces are negated if
+	// R has odd y
+	if session.qOdd {
+		d.negate(&d)
+	}
+	d.mul(&d, &cache.gacc)
+	if session.rOdd {
+		k[0].negate(&k[0])
+		k[1].negate(&k[1])
+	}
+
+	// s = k1 + b*k2 + e*a*d
+	var s, t Scalar
+	s.mul(&session.b, &k[1])
+	s.add(&s, &k[0])
+	t.mul(&session.e, &a)
+	t.mul(&t, &d)
+	s.add(&s, &t)
+	psig.s = s
+	s.clear()
+	t.clear()
+	return nil
+}
+
+// musigPartialSigTerms sets points[0..2] to R1, R2 and P of a partial
+// signature and scalars[0..2] to the factors that make
+//
+//	s*G + scalars[0]*R1 + scalars[1]*R2 + scalars[2]*P
+//
+// infinity exactly when it is valid, all multiplied by z. It reports whether
+// the public nonce and key are valid.
+func musigPartialSigTerms(points []GroupElementAffine, scalars []Scalar, z *Scalar, pubnonce *MusigPubNonce, pubkey *PublicKey, cache *MusigKeyAggCache, session *MusigSession) bool {
+	var pk33 [33]byte
+	if pubnonce == nil || pubkey == nil || ECPubkeySerialize(pk33[:], pubkey, ECCompressed) != 33 {
+		return false
+	}
+	pubkeyLoad(&points[0], &pubnonce.r[0])
+	pubkeyLoad(&points[1], &pubnonce.r[1])
+	if points[0].isInfinity() || points[1].isInfinity() {
+		return false
+	}
+	pubkeyLoad(&points[2], pubkey)
+
+	// s*G == Re + e*a*g*gacc*P, where Re = R1 + b*R2 negated if R has odd y
+	var zn, a Scalar
+	zn.negate(z)
+	if session.rOdd {
+		zn = *z
+	}
+	scalars[0] = zn
+	scalars[1].mul(&zn, &session.b)
+
+	cache.coeff(&a, &pk33)
+	scalars[2].mul(&session.e, &a)
+	scalars[2].mul(&scalars[2], &cache.gacc)
+	scalars[2].mul(&scalars[2], z)
+	if !session.qOdd {
+		scalars[2].negate(&scalars[2])
+	}
+	return true
+}
+
+// MusigPartialSigVerify verifies the partial signature psig of the signer
+// with public nonce pubnonce and individual public key pubkey, as
+// PartialSigVerify of BIP-327
+func MusigPartialSigVerify(psig *MusigPartialSig, pubnonce *MusigPubNonce, pubkey *PublicKey, cache *MusigKeyAggCache, session *MusigSession) bool {
+	var points [3]GroupElementAffine
+	var scalars [3]Scalar
+	if psig == nil || !musigPartialSigTerms(points[:], scalars[:], &ScalarOne, pubnonce, pubkey, cache, session) {
+		return false
+	}
+	var r GroupElementJacobian
+	s := scratchPool.Get().(*Scratch)
+	ecmultMultiVar(s, &r, points[:], scalars[:], &psig.s)
+	scratchPool.Put(s)
+	return r.isInfinity()
+}
+
+// MusigPartialSigVerifyBatch verifies the partial signatures of a session at
+// once, psigs[i] made by the signer with pubnonces[i] and pubkeys[i]. The
+// three slices must have the same length.
+//
+// The checks are combined with random factors z_i into
+//
+//	(sum z_i*s_i)*G - sum z_i*(Re_i + e*a_i*g*gacc*P_i) == infinity
+//
+// and evaluated as one multi-scalar multiplication of 3n points. z_0 is 1
+// and the other factors are derived from a hash of the session and every
+// input, as in SchnorrVerifyBatch. If the whole batch is valid, valid is
+// true and failed is nil. Otherwise the partial signatures are checked one
+// by one and failed lists the invalid ones in ascending order, which
+// identifies the signers to blame. If the slice lengths differ, valid is
+// false and failed is nil.
+func MusigPartialSigVerifyBatch(psigs []*MusigPartialSig, pubnonces []*MusigPubNonce, pubkeys []*PublicKey, cache *MusigKeyAggCache, session *MusigSession) (valid bool, failed []int) {
+	n := len(psigs)
+	if len(pubnonces) != n || len(pubkeys) != n {
+		return false, nil
+	}
+	if n == 0 {
+		return true, nil
+	}
+
+	scratch := scratchPool.Get().(*Scratch)
+	defer scratchPool.Put(scratch)
+	cp := scratch.Checkpoint()
+	defer scratch.Rollback(cp)
+
+	points := scratch.affine.alloc(3 * n)
+	scalars := scratch.scalars.alloc(3 * n)
+	entries := scratch.ints.alloc(n)[:0]
+
+	batchTag := getTaggedHashPrefix(musigBatchTag)
+	seedHash := sha256simd.New()
+	seedHash.Write(batchTag[:])
+	seedHash.Write(batchTag[:])
+	seedHash.Write(session.r32[:])
+	var eb [32]byte
+	session.e.getB32(eb[:])
+	seedHash.Write(eb[:])
+
+	var buf [66]byte
+	for i := 0; i < n; i++ {
+		if psigs[i] == nil || pubnonces[i] == nil || pubkeys[i] == nil ||
+			ECPubkeySerialize(buf[:33], pubkeys[i], ECCompressed) != 33 {
+			failed = append(failed, i)
+			continue
+		}
+		seedHash.Write(buf[:33])
+		buf = pubnonces[i].Serialize()
+		seedHash.Write(buf[:])
+		psigs[i].s.getB32(buf[:32])
+		seedHash.Write(buf[:32])
+		entries = append(entries, i)
+	}
+
+	m := len(entries)
+	if m == 0 {
+		return false, failed
+	}
+
+	// z_k = int(sha256(seed || k)) mod n for k > 0
+	var seed [36]byte
+	seedHash.Sum(seed[:0])
+
+	var z, t, sum Scalar
+	for k, i := range entries {
+		if k == 0 {
+			z.setInt(1)
+		} else {
+			binary.BigEndian.PutUint32(seed[32:], uint32(k))
+			digest := sha256simd.Sum256(seed[:])
+			z.setB32(digest[:])
+		}
+		musigPartialSigTerms(points[3*k:3*k+3], scalars[3*k:3*k+3], &z, pubnonces[i], pubkeys[i], cache, session)
+		t.mul(&z, &psigs[i].s)
+		sum.add(&sum, &t)
+	}
+
+	var r GroupElementJacobian
+	ecmultMultiVar(scratch, &r, points[:3*m], scalars[:3*m], &sum)
+	if r.isInfinity() {
+		return len(failed) == 0, failed
+	}
+
+	// The batch equation does not hold; find the offending signers
+	metricsEvent(metricBatchFallback)
+	for _, i := range entries {
+		if !MusigPartialSigVerify(psigs[i], pubnonces[i], pubkeys[i], cache, session) {
+			failed = append(failed, i)
+		}
+	}
+	sort.Ints(failed)
+	return len(failed) == 0, failed
+}
+
+// MusigPartialSigAgg sums the partial signatures of a session into the 64
+// byte BIP-340 signature sig64, as PartialSigAgg of BIP-327. It does not
+// verify the partial signatures; an invalid one gives an invalid signature.
+func MusigPartialSigAgg(sig64 []byte, session *MusigSession, psigs []*MusigPartialSig) error {
+	if len(sig64) != 64 {
+		return errors.New("signature must be 64 bytes")
+	}
+	if len(psigs) == 0 {
+		return errors.New("no partial signatures to aggregate")
+	}
+	s := session.sPart
+	for _, p := range psigs {
+		if p == nil {
+			return errors.New("missing partial signature")
+		}
+		s.add(&s, &p.s)
+	}
+	copy(sig64[:32], session.r32[:])
+	s.getB32(sig64[32:])
+	return nil
+}
@@ -0,0 +1,650 @@
+package p256k1
+
+import (
+	"crypto/rand"
+	"encoding/hex"
+	"fmt"
+	"strings"
+	"testing"
+)
+
+// musigSigners holds the keys of a group of MuSig2 signers
+type musigSigners struct {
+	keypairs []*KeyPair
+	pubkeys  []*PublicKey
+}
+
+func makeMusigSigners(tb testing.TB, n int) musigSigners {
+	var g musigSigners
+	for i := 0; i < n; i++ {
+		kp, err := KeyPairGenerate()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		g.keypairs = append(g.keypairs, kp)
+		g.pubkeys = append(g.pubkeys, kp.Pubkey())
+	}
+	return g
+}
+
+// musigRound runs both rounds of signing msg by g with cache and returns the
+// session, the public nonces and the partial signatures
+func musigRound(tb testing.TB, g musigSigners, cache *MusigKeyAggCache, msg []byte) (*MusigSession, []*MusigPubNonce, []*MusigPartialSig) {
+	n := len(g.keypairs)
+	secnonces := make([]MusigSecNonce, n)
+	pubnonces := make([]*MusigPubNonce, n)
+	for i, kp := range g.keypairs {
+		rand32 := make([]byte, 32)
+		if _, err := rand.Read(rand32); err != nil {
+			tb.Fatal(err)
+		}
+		pubnonces[i] = new(MusigPubNonce)
+		if err := MusigNonceGen(&secnonces[i], pubnonces[i], rand32, kp.Seckey(), kp.Pubkey(), cache, msg, nil); err != nil {
+			tb.Fatal(err)
+		}
+	}
+	var aggnonce MusigAggNonce
+	if err := MusigNonceAgg(&aggnonce, pubnonces); err != nil {
+		tb.Fatal(err)
+	}
+	session := new(MusigSession)
+	if err := MusigNonceProcess(session, &aggnonce, msg, cache); err != nil {
+		tb.Fatal(err)
+	}
+	psigs := make([]*MusigPartialSig, n)
+	for i, kp := range g.keypairs {
+		psigs[i] = new(MusigPartialSig)
+		if err := MusigPartialSign(psigs[i], &secnonces[i], kp, cache, session); err != nil {
+			tb.Fatal(err)
+		}
+	}
+	return session, pubnonces, psigs
+}
+
+func TestMusigKeyAggVectors(t *testing.T) {
+	// From the key aggregation vectors of BIP-327
+	keys := []string{
+		"02F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9",
+		"03DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659",
+		"023590A94E768F8E1815C2F24B4D80A8E3149316C3518CE7B7AD338368D038CA66",
+	}
+	pubkeys := make([]*PublicKey, len(keys))
+	for i, k := range keys {
+		b, _ := hex.DecodeString(k)
+		pubkeys[i] = new(PublicKey)
+		if err := ECPubkeyParse(pubkeys[i], b); err != nil {
+			t.Fatal(err)
+		}
+	}
+	for _, tc := range []struct {
+		idx  []int
+		want string
+	}{
+		{[]int{0, 1, 2}, "90539EEDE565F5D054F32CC0C220126889ED1E5D193BAF15AEF344FE59D4610C"},
+		{[]int{2, 1, 0}, "6204DE8B083426DC6EAF9502D27024D53FC826BF7D2012148A0575435DF54B2B"},
+		{[]int{0, 0, 0}, "B436E3BAD62B8CD409969A224731C193D051162D8C5AE8B109306127DA3AA935"},
+		{[]int{0, 0, 1, 1}, "69BC22BFA5D106306E48A20679DE1D7389386124D07571D0D872686028C26A3E"},
+	} {
+		set := make([]*PublicKey, len(tc.idx))
+		for i, j := range tc.idx {
+			set[i] = pubkeys[j]
+		}
+		cache, err := MusigPubkeyAgg(set)
+		if err != nil {
+			t.Fatal(err)
+		}
+		agg := cache.AggPubkey()
+		if got := strings.ToUpper(hex.EncodeToString(agg.data[:])); got != tc.want {
+			t.Errorf("keys %v: aggregate key %s, want %s", tc.idx, got, tc.want)
+		}
+	}
+
+	if _, err := MusigPubkeyAgg(nil); err == nil {
+		t.Error("aggregated an empty key set")
+	}
+	if _, err := MusigPubkeyAgg([]*PublicKey{pubkeys[0], {}}); err == nil {
+		t.Error("aggregated an invalid key")
+	}
+}
+
+func TestMusigNonceGenVectors(t *testing.T) {
+	// From nonce_gen_vectors.json of BIP-327; nil inputs are absent
+	pk := "024D4B6CD1361032CA9BD2AEB9D900AA4D45D9EAD80AC9423374C451A7254D0766"
+	for i, tc := range []struct {
+		seckey, aggpk, msg, extra  []byte
+		pubkey, secnonce, pubnonce string
+	}{
+		{
+			mustHex(t, strings.Repeat("02", 32)), mustHex(t, strings.Repeat("07", 32)),
+			mustHex(t, strings.Repeat("01", 32)), mustHex(t, strings.Repeat("08", 32)), pk,
+			"B114E502BEAA4E301DD08A50264172C84E41650E6CB726B410C0694D59EFFB6495B5CAF28D045B973D63E3C99A44B807BDE375FD6CB39E46DC4A511708D0E9D2" + pk,
+			"02F7BE7089E8376EB355272368766B17E88E7DB72047D05E56AA881EA52B3B35DF02C29C8046FDD0DED4C7E55869137200FBDBFE2EB654267B6D7013602CAED3115A",
+		},
+		{
+			mustHex(t, strings.Repeat("02", 32)), mustHex(t, strings.Repeat("07", 32)),
+			[]byte{}, mustHex(t, strings.Repeat("08", 32)), pk,
+			"E862B068500320088138468D47E0E6F147E01B6024244AE45EAC40ACE5929B9F0789E051170B9E705D0B9EB49049A323BBBBB206D8E05C19F46C6228742AA7A9" + pk,
+			"023034FA5E2679F01EE66E12225882A7A48CC66719B1B9D3B6C4DBD743EFEDA2C503F3FD6F01EB3A8E9CB315D73F1F3D287CAFBB44AB321153C6287F407600205109",
+		},
+		{
+			mustHex(t, strings.Repeat("02", 32)), mustHex(t, strings.Repeat("07", 32)),
+			mustHex(t, strings.Repeat("26", 38)), mustHex(t, strings.Repeat("08", 32)), pk,
+			"3221975ACBDEA6820EABF02A02B7F27D3A8EF68EE42787B88CBEFD9AA06AF3632EE85B1A61D8EF31126D4663A00DD96E9D1D4959E72D70FE5EBB6E7696EBA66F" + pk,
+			"02E5BBC21C69270F59BD634FCBFA281BE9D76601295345112C58954625BF23793A021307511C79F95D38ACACFF1B4DA98228B77E65AA216AD075E9673286EFB4EAF3",
+		},
+		{
+			nil, nil, nil, nil, "02F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9",
+			"89BDD787D0284E5E4D5FC572E49E316BAB7E21E3B1830DE37DFE80156FA41A6D0B17AE8D024C53679699A6FD7944D9C4A366B514BAF43088E0708B1023DD289702F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9",
+			"02C96E7CB1E8AA5DAC64D872947914198F607D90ECDE5200DE52978AD5DED63C000299EC5117C2D29EDEE8A2092587C3909BE694D5CFF0667D6C02EA4059F7CD9786",
+		},
+	} {
+		var pubkey PublicKey
+		if err := ECPubkeyParse(&pubkey, mustHex(t, tc.pubkey)); err != nil {
+			t.Fatal(err)
+		}
+		// Only the x-only aggregate key enters the nonce
+		var cache *MusigKeyAggCache
+		if tc.aggpk != nil {
+			cache = new(MusigKeyAggCache)
+			if err := cache.q.x.setB32(tc.aggpk); err != nil {
+				t.Fatal(err)
+			}
+		}
+		rand32 := mustHex(t, strings.Repeat("0F", 32))
+
+		var sn MusigSecNonce
+		var pn MusigPubNonce
+		if err := MusigNonceGen(&sn, &pn, rand32, tc.seckey, &pubkey, cache, tc.msg, tc.extra); err != nil {
+			t.Fatal(err)
+		}
+		var secnonce [97]byte
+		sn.k[0].getB32(secnonce[:32])
+		sn.k[1].getB32(secnonce[32:64])
+		copy(secnonce[64:], sn.pk[:])
+		if got := strings.ToUpper(hex.EncodeToString(secnonce[:])); got != tc.secnonce {
+			t.Errorf("vector %d: secret nonce %s, want %s", i, got, tc.secnonce)
+		}
+		pubnonce := pn.Serialize()
+		if got := strings.ToUpper(hex.EncodeToString(pubnonce[:])); got != tc.pubnonce {
+			t.Errorf("vector %d: public nonce %s, want %s", i, got, tc.pubnonce)
+		}
+	}
+}
+
+// Inputs shared by the sign_verify and tweak vectors of BIP-327: the secret
+// key and secret nonce (k1 || k2 || pk) of the signer, the public nonces of
+// the signers and the aggregate of the first three
+const (
+	musigVectorSeckey   = "7FB9E0E687ADA1EEBF7ECFE2F21E73EBDB51A7D450948DFE8D76D7F2D1007671"
+	musigVectorSecnonce = "508B81A611F100A6B2B6B29656590898AF488BCF2E1F55CF22E5CFB84421FE61FA27FD49B1D50085B481285E1CA205D55C82CC1B31FF5CD54A489829355901F703935F972DA013F80AE011890FA89B67A27B7BE6CCB24D3274D18B2D4067F261A9"
+	musigVectorAggnonce = "028465FCF0BBDBCF443AABCCE533D42B4B5A10966AC09A49655E8C42DAAB8FCD61037496A3CC86926D452CAFCFD55D25972CA1675D549310DE296BFF42F72EEEA8C9"
+	musigVectorMsg      = "F95466D086770E689964664219266FE5ED215C92AE20BAB5C9D79ADDDDF3C0CF"
+)
+
+var musigVectorPubnonces = []string{
+	"0337C87821AFD50A8644D820A8F3E02E499C931865C2360FB43D0A0D20DAFE07EA0287BF891D2A6DEAEBADC909352AA9405D1428C15F4B75F04DAE642A95C2548480",
+	"0279BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F817980279BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798",
+	"032DE2662628C90B03F5E720284EB52FF7D71F4284F627B68A853D78C78E1FFE9303E4C5524E83FFE1493B9077CF1CA6BEB2090C93D930321071AD40B2F44E599046",
+	"0237C87821AFD50A8644D820A8F3E02E499C931865C2360FB43D0A0D20DAFE07EA0387BF891D2A6DEAEBADC909352AA9405D1428C15F4B75F04DAE642A95C2548480",
+}
+
+// musigVectorSecNonce parses a 97 byte secret nonce of the BIP-327 vectors
+func musigVectorSecNonce(tb testing.TB, s string) MusigSecNonce {
+	b := mustHex(tb, s)
+	var sn MusigSecNonce
+	sn.k[0].setB32(b[:32])
+	sn.k[1].setB32(b[32:64])
+	copy(sn.pk[:], b[64:])
+	return sn
+}
+
+// musigVectorInputs parses the keys and public nonces of the BIP-327
+// vectors at the given indices, aggregates them and checks the aggregate
+// nonce against aggnonce
+func musigVectorInputs(tb testing.TB, keys []string, keyIdx, nonceIdx []int, aggnonce string) ([]*PublicKey, []*MusigPubNonce, *MusigKeyAggCache, *MusigAggNonce) {
+	pubkeys := make([]*PublicKey, len(keyIdx))
+	for i, j := range keyIdx {
+		pubkeys[i] = new(PublicKey)
+		if err := ECPubkeyParse(pubkeys[i], mustHex(tb, keys[j])); err != nil {
+			tb.Fatal(err)
+		}
+	}
+	cache, err := MusigPubkeyAgg(pubkeys)
+	if err != nil {
+		tb.Fatal(err)
+	}
+	pubnonces := make([]*MusigPubNonce, len(nonceIdx))
+	for i, j := range nonceIdx {
+		pubnonces[i] = new(MusigPubNonce)
+		if err := pubnonces[i].Parse(mustHex(tb, musigVectorPubnonces[j])); err != nil {
+			tb.Fatal(err)
+		}
+	}
+	agg := new(MusigAggNonce)
+	if err := MusigNonceAgg(agg, pubnonces); err != nil {
+		tb.Fatal(err)
+	}
+	if ser := agg.Serialize(); strings.ToUpper(hex.EncodeToString(ser[:])) != aggnonce {
+		tb.Fatalf("aggregate nonce %x, want %s", ser, aggnonce)
+	}
+	return pubkeys, pubnonces, cache, agg
+}
+
+// musigVectorSign creates the partial signature of the BIP-327 vector
+// signer, at position signer, checks it against want and verifies it
+func musigVectorSign(tb testing.TB, pubkeys []*PublicKey, pubnonces []*MusigPubNonce, cache *MusigKeyAggCache, aggnonce *MusigAggNonce, msg []byte, signer int, want string) *MusigPartialSig {
+	kp, err := KeyPairCreate(mustHex(tb, musigVectorSeckey))
+	if err != nil {
+		tb.Fatal(err)
+	}
+	var session MusigSession
+	if err := MusigNonceProcess(&session, aggnonce, msg, cache); err != nil {
+		tb.Fatal(err)
+	}
+	sn := musigVectorSecNonce(tb, musigVectorSecnonce)
+	psig := new(MusigPartialSig)
+	if err := MusigPartialSign(psig, &sn, kp, cache, &session); err != nil {
+		tb.Fatal(err)
+	}
+	if ser := psig.Serialize(); strings.ToUpper(hex.EncodeToString(ser[:])) != want {
+		tb.Errorf("partial signature %x, want %s", ser, want)
+	}
+	if !MusigPartialSigVerify(psig, pubnonces[signer], pubkeys[signer], cache, &session) {
+		tb.Error("partial signature does not verify")
+	}
+	return psig
+}
+
+func TestMusigSignVerifyVectors(t *testing.T) {
+	// From sign_verify_vectors.json of BIP-327
+	keys := []string{
+		"03935F972DA013F80AE011890FA89B67A27B7BE6CCB24D3274D18B2D4067F261A9",
+		"02F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9",
+		"02DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA661",
+		"020000000000000000000000000000000000000000000000000000000000000007",
+	}
+	msgs := []string{musigVectorMsg, "", strings.Repeat("26", 38)}
+	aggnonces := []string{musigVectorAggnonce, strings.Repeat("00", 66)}
+	for _, tc := range []struct {
+		keyIdx, nonceIdx []int
+		aggnonce, msg    int
+		signer           int
+		want             string
+	}{
+		{[]int{0, 1, 2}, []int{0, 1, 2}, 0, 0, 0, "012ABBCB52B3016AC03AD82395A1A415C48B93DEF78718E62A7A90052FE224FB"},
+		{[]int{1, 0, 2}, []int{1, 0, 2}, 0, 0, 1, "9FF2F7AAA856150CC8819254218D3ADEEB0535269051897724F9DB3789513A52"},
+		{[]int{1, 2, 0}, []int{1, 2, 0}, 0, 0, 2, "FA23C359F6FAC4E7796BB93BC9F0532A95468C539BA20FF86D7C76ED92227900"},
+		// The aggregate nonce is infinity
+		{[]int{0, 1}, []int{0, 3}, 1, 0, 0, "AE386064B26105404798F75DE2EB9AF5EDA5387B064B83D049CB7C5E08879531"},
+		// Empty message and 38 byte message
+		{[]int{0, 1, 2}, []int{0, 1, 2}, 0, 1, 0, "D7D63FFD644CCDA4E62BC2BC0B1D02DD32A1DC3030E155195810231D1037D82D"},
+		{[]int{0, 1, 2}, []int{0, 1, 2}, 0, 2, 0, "E184351828DA5094A97C79CABDAAA0BFB87608C32E8829A4DF5340A6F243B78C"},
+	} {
+		pubkeys, pubnonces, cache, agg := musigVectorInputs(t, keys, tc.keyIdx, tc.nonceIdx, aggnonces[tc.aggnonce])
+		musigVectorSign(t, pubkeys, pubnonces, cache, agg, mustHex(t, msgs[tc.msg]), tc.signer, tc.want)
+	}
+
+	// Verification failures: the negated signature, the right signature for
+	// the wrong signer, and a value equal to the group order
+	pubkeys, pubnonces, cache, agg := musigVectorInputs(t, keys, []int{0, 1, 2}, []int{0, 1, 2}, musigVectorAggnonce)
+	msg := mustHex(t, musigVectorMsg)
+	var session MusigSession
+	if err := MusigNonceProcess(&session, agg, msg, cache); err != nil {
+		t.Fatal(err)
+	}
+	var psig MusigPartialSig
+	if err := psig.Parse(mustHex(t, "012ABBCB52B3016AC03AD82395A1A415C48B93DEF78718E62A7A90052FE224FB")); err != nil {
+		t.Fatal(err)
+	}
+	if MusigPartialSigVerify(&psig, pubnonces[1], pubkeys[1], cache, &session) {
+		t.Error("verified the partial signature of the wrong signer")
+	}
+	psig.s.negate(&psig.s)
+	if MusigPartialSigVerify(&psig, pubnonces[0], pubkeys[0], cache, &session) {
+		t.Error("verified a negated partial signature")
+	}
+	if psig.Parse(mustHex(t, "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141")) == nil {
+		t.Error("parsed a partial signature equal to the group order")
+	}
+
+	// Invalid inputs: a key and a public nonce not on the curve, aggregate
+	// nonces with a bad prefix, an x off the curve and an x above the field
+	// size, and a secret nonce of zeros
+	var pk PublicKey
+	if ECPubkeyParse(&pk, mustHex(t, keys[3])) == nil {
+		t.Error("parsed a public key not on the curve")
+	}
+	var pn MusigPubNonce
+	if pn.Parse(mustHex(t, "0200000000000000000000000000000000000000000000000000000000000000090287BF891D2A6DEAEBADC909352AA9405D1428C15F4B75F04DAE642A95C2548480")) == nil {
+		t.Error("parsed a public nonce not on the curve")
+	}
+	for _, s := range []string{
+		"048465FCF0BBDBCF443AABCCE533D42B4B5A10966AC09A49655E8C42DAAB8FCD61037496A3CC86926D452CAFCFD55D25972CA1675D549310DE296BFF42F72EEEA8C9",
+		"028465FCF0BBDBCF443AABCCE533D42B4B5A10966AC09A49655E8C42DAAB8FCD61020000000000000000000000000000000000000000000000000000000000000009",
+		"028465FCF0BBDBCF443AABCCE533D42B4B5A10966AC09A49655E8C42DAAB8FCD6103FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC30",
+	} {
+		var bad MusigAggNonce
+		if bad.Parse(mustHex(t, s)) == nil {
+			t.Errorf("parsed the invalid aggregate nonce %s", s)
+		}
+	}
+	kp, err := KeyPairCreate(mustHex(t, musigVectorSeckey))
+	if err != nil {
+		t.Fatal(err)
+	}
+	zero := musigVectorSecNonce(t, strings.Repeat("00", 64)+keys[0])
+	if MusigPartialSign(&psig, &zero, kp, cache, &session) == nil {
+		t.Error("signed with a secret nonce of zeros")
+	}
+
+	// The signer's key must be one of the aggregated keys
+	_, _, other, _ := musigVectorInputs(t, keys, []int{1, 2}, []int{0, 1, 2}, musigVectorAggnonce)
+	if err := MusigNonceProcess(&session, agg, msg, other); err != nil {
+		t.Fatal(err)
+	}
+	sn := musigVectorSecNonce(t, musigVectorSecnonce)
+	if MusigPartialSign(&psig, &sn, kp, other, &session) == nil {
+		t.Error("signed for a key set without the signer's key")
+	}
+}
+
+func TestMusigTweakVectors(t *testing.T) {
+	// From tweak_vectors.json of BIP-327
+	keys := []string{
+		"03935F972DA013F80AE011890FA89B67A27B7BE6CCB24D3274D18B2D4067F261A9",
+		"02F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9",
+		"02DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659",
+	}
+	tweaks := []string{
+		"E8F791FF9225A2AF0102AFFF4A9A723D9612A682A25EBE79802B263CDFCD83BB",
+		"AE2EA797CC0FE72AC5B97B97F3C6957D7E4199A167A58EB08BCAFFDA70AC0455",
+		"F52ECBC565B3D8BEA2DFD5B75A4F457E54369809322E4120831626F290FA87E0",
+		"1969AD73CC177FA0B4FCED6DF1F7BF9907E665FDE9BA196A74FED0A3CF5AEF9D",
+	}
+	msg := mustHex(t, musigVectorMsg)
+	for _, tc := range []struct {
+		tweakIdx []int
+		xonly    []bool
+		want     string
+	}{
+		{[]int{0}, []bool{true}, "E28A5C66E61E178C2BA19DB77B6CF9F7E2F0F56C17918CD13135E60CC848FE91"},
+		{[]int{0}, []bool{false}, "38B0767798252F21BF5702C48028B095428320F73A4B14DB1E25DE58543D2D2D"},
+		{[]int{0, 1}, []bool{false, true}, "408A0A21C4A0F5DACAF9646AD6EB6FECD7F7A11F03ED1F48DFFF2185BC2C2408"},
+		{[]int{0, 1, 2, 3}, []bool{false, false, true, true}, "45ABD206E61E3DF2EC9E264A6FEC8292141A633C28586388235541F9ADE75435"},
+		{[]int{0, 1, 2, 3}, []bool{true, false, true, false}, "B255FDCAC27B40C7CE7848E2D3B7BF5EA0ED756DA81565AC804CCCA3E1D5D239"},
+	} {
+		pubkeys, pubnonces, cache, agg := musigVectorInputs(t, keys, []int{1, 2, 0}, []int{1, 2, 0}, musigVectorAggnonce)
+		for i, j := range tc.tweakIdx {
+			var err error
+			if tc.xonly[i] {
+				err = cache.XOnlyTweakAdd(mustHex(t, tweaks[j]))
+			} else {
+				err = cache.PubkeyTweakAdd(mustHex(t, tweaks[j]))
+			}
+			if err != nil {
+				t.Fatal(err)
+			}
+		}
+		musigVectorSign(t, pubkeys, pubnonces, cache, agg, msg, 2, tc.want)
+	}
+
+	// A tweak equal to the group order is rejected
+	_, _, cache, _ := musigVectorInputs(t, keys, []int{1, 2, 0}, []int{1, 2, 0}, musigVectorAggnonce)
+	order := mustHex(t, "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141")
+	if cache.PubkeyTweakAdd(order) == nil || cache.XOnlyTweakAdd(order) == nil {
+		t.Error("accepted a tweak equal to the group order")
+	}
+}
+
+func TestMusigKeyAggLarge(t *testing.T) {
+	// Above the Pippenger threshold, against the sum of a_i*P_i one by one
+	g := makeMusigSigners(t, ecmultPippengerThreshold+20)
+	cache, err := MusigPubkeyAgg(g.pubkeys)
+	if err != nil {
+		t.Fatal(err)
+	}
+	var sum GroupElementJacobian
+	sum.setInfinity()
+	for _, pk := range g.pubkeys {
+		var pk33 [33]byte
+		ECPubkeySerialize(pk33[:], pk, ECCompressed)
+		var a Scalar
+		cache.coeff(&a, &pk33)
+		var p GroupElementAffine
+		var pj, t GroupElementJacobian
+		pubkeyLoad(&p, pk)
+		pj.setGE(&p)
+		Ecmult(&t, &pj, &a)
+		sum.addVar(&sum, &t)
+	}
+	var q GroupElementAffine
+	q.setGEJVar(&sum)
+	if !q.equal(&cache.q) {
+		t.Error("aggregate key differs from the sum of a_i*P_i")
+	}
+}
+
+func TestMusigSign(t *testing.T) {
+	msg := make([]byte, 32)
+	var tweak [32]byte
+	if _, err := rand.Read(msg); err != nil {
+		t.Fatal(err)
+	}
+	if _, err := rand.Read(tweak[:]); err != nil {
+		t.Fatal(err)
+	}
+	for _, n := range []int{1, 2, 5, 40} {
+		g := makeMusigSigners(t, n)
+		// A repeated key still signs correctly
+		if n > 2 {
+			g.keypairs[1], g.pubkeys[1] = g.keypairs[0], g.pubkeys[0]
+		}
+		cache, err := MusigPubkeyAgg(g.pubkeys)
+		if err != nil {
+			t.Fatal(err)
+		}
+
+		for _, tweaks := range [][]bool{nil, {true}, {false, true}, {true, false, true}} {
+			c := cache.Clone()
+			for _, xonly := range tweaks {
+				var err error
+				if xonly {
+					err = c.XOnlyTweakAdd(tweak[:])
+				} else {
+					err = c.PubkeyTweakAdd(tweak[:])
+				}
+				if err != nil {
+					t.Fatal(err)
+				}
+			}
+			session, pubnonces, psigs := musigRound(t, g, c, msg)
+			for i := range psigs {
+				if !MusigPartialSigVerify(psigs[i], pubnonces[i], g.pubkeys[i], c, session) {
+					t.Fatalf("n = %d, tweaks %v: partial signature %d does not verify", n, tweaks, i)
+				}
+			}
+			if valid, failed := MusigPartialSigVerifyBatch(psigs, pubnonces, g.pubkeys, c, session); !valid || failed != nil {
+				t.Fatalf("n = %d, tweaks %v: batch verification failed: %v", n, tweaks, failed)
+			}
+
+			sig := make([]byte, 64)
+			if err := MusigPartialSigAgg(sig, session, psigs); err != nil {
+				t.Fatal(err)
+			}
+			agg := c.AggPubkey()
+			if !SchnorrVerify(sig, msg, &agg) {
+				t.Fatalf("n = %d, tweaks %v: aggregate signature does not verify", n, tweaks)
+			}
+		}
+		if cache.AggPubkey() != cache.Clone().AggPubkey() {
+			t.Fatal("tweaking a clone changed the original")
+		}
+	}
+}
+
+func TestMusigNonces(t *testing.T) {
+	g := makeMusigSigners(t, 2)
+	cache, err := MusigPubkeyAgg(g.pubkeys)
+	if err != nil {
+		t.Fatal(err)
+	}
+	rand32 := make([]byte, 32)
+	var sn1, sn2 MusigSecNonce
+	var pn1, pn2 MusigPubNonce
+	if err := MusigNonceGen(&sn1, &pn1, rand32, nil, g.pubkeys[0], nil, nil, nil); err != nil {
+		t.Fatal(err)
+	}
+	// Every optional input changes the nonce
+	for _, tc := range []struct {
+		seckey []byte
+		cache  *MusigKeyAggCache
+		msg    []byte
+		extra  []byte
+	}{
+		{seckey: g.keypairs[0].Seckey()},
+		{cache: cache},
+		{msg: []byte{}},
+		{extra: []byte{1}},
+	} {
+		if err := MusigNonceGen(&sn2, &pn2, rand32, tc.seckey, g.pubkeys[0], tc.cache, tc.msg, tc.extra); err != nil {
+			t.Fatal(err)
+		}
+		if pn1 == pn2 {
+			t.Errorf("nonce did not change with %+v", tc)
+		}
+	}
+
+	ser := pn1.Serialize()
+	var parsed MusigPubNonce
+	if err := parsed.Parse(ser[:]); err != nil || parsed != pn1 {
+		t.Fatalf("public nonce round trip failed: %v", err)
+	}
+	if parsed.Parse(make([]byte, 66)) == nil {
+		t.Error("parsed a public nonce at infinity")
+	}
+
+	// Nonces that cancel sum to infinity, which the aggregate encodes as
+	// zeros and the session replaces by G
+	neg := pn1
+	for j := range neg.r {
+		var p GroupElementAffine
+		pubkeyLoad(&p, &neg.r[j])
+		p.negate(&p)
+		pubkeySave(&neg.r[j], &p)
+	}
+	var aggnonce MusigAggNonce
+	if err := MusigNonceAgg(&aggnonce, []*MusigPubNonce{&pn1, &neg}); err != nil {
+		t.Fatal(err)
+	}
+	aggSer := aggnonce.Serialize()
+	if aggSer != ([66]byte{}) {
+		t.Errorf("infinite aggregate nonce serialized as %x", aggSer)
+	}
+	var aggParsed MusigAggNonce
+	if err := aggParsed.Parse(aggSer[:]); err != nil || aggParsed != aggnonce {
+		t.Fatalf("aggregate nonce round trip failed: %v", err)
+	}
+	var session MusigSession
+	if err := MusigNonceProcess(&session, &aggnonce, nil, cache); err != nil {
+		t.Fatal(err)
+	}
+	var gx [32]byte
+	gen := Generator
+	gen.x.normalize()
+	gen.x.getB32(gx[:])
+	if session.r32 != gx {
+		t.Error("infinite final nonce was not replaced by G")
+	}
+}
+
+func TestMusigPartialSigFailures(t *testing.T) {
+	msg := []byte("message")
+	g := makeMusigSigners(t, 6)
+	cache, err := MusigPubkeyAgg(g.pubkeys)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	// A secret nonce cannot be used twice, nor by another signer
+	var sn MusigSecNonce
+	var pn MusigPubNonce
+	rand32 := make([]byte, 32)
+	rand.Read(rand32)
+	if err := MusigNonceGen(&sn, &pn, rand32, nil, g.pubkeys[0], cache, msg, nil); err != nil {
+		t.Fatal(err)
+	}
+	snCopy := sn
+	var aggnonce MusigAggNonce
+	MusigNonceAgg(&aggnonce, []*MusigPubNonce{&pn})
+	var session MusigSession
+	MusigNonceProcess(&session, &aggnonce, msg, cache)
+	var psig MusigPartialSig
+	if err := MusigPartialSign(&psig, &sn, g.keypairs[0], cache, &session); err != nil {
+		t.Fatal(err)
+	}
+	if err := MusigPartialSign(&psig, &sn, g.keypairs[0], cache, &session); err == nil {
+		t.Error("signed twice with one secret nonce")
+	}
+	if err := MusigPartialSign(&psig, &snCopy, g.keypairs[1], cache, &session); err == nil {
+		t.Error("signed with the secret nonce of another key")
+	}
+
+	var bad MusigPartialSig
+	high := make([]byte, 32)
+	for i := range high {
+		high[i] = 0xff
+	}
+	if bad.Parse(high) == nil {
+		t.Error("parsed a partial signature above the group order")
+	}
+
+	// Corrupted partial signatures are pinpointed by the batch
+	sess, pubnonces, psigs := musigRound(t, g, cache, msg)
+	psigs[1].s.add(&psigs[1].s, &ScalarOne)
+	psigs[4] = psigs[3]
+	valid, failed := MusigPartialSigVerifyBatch(psigs, pubnonces, g.pubkeys, cache, sess)
+	if valid || len(failed) != 2 || failed[0] != 1 || failed[1] != 4 {
+		t.Errorf("batch verification: valid = %v, failed = %v, want [1 4]", valid, failed)
+	}
+	if MusigPartialSigVerify(psigs[4], pubnonces[4], g.pubkeys[4], cache, sess) {
+		t.Error("verified another signer's partial signature")
+	}
+	pubnonces[2] = nil
+	if _, failed := MusigPartialSigVerifyBatch(psigs, pubnonces, g.pubkeys, cache, sess); len(failed) != 3 || failed[1] != 2 {
+		t.Errorf("batch verification with a missing nonce: failed = %v", failed)
+	}
+	if valid, failed := MusigPartialSigVerifyBatch(psigs, pubnonces[:2], g.pubkeys, cache, sess); valid || failed != nil {
+		t.Error("accepted mismatched slice lengths")
+	}
+}
+
+func BenchmarkMusigPubkeyAgg(b *testing.B) {
+	for _, n := range []int{16, 256} {
+		g := makeMusigSigners(b, n)
+		b.Run(fmt.Sprintf("n=%d", n), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				MusigPubkeyAgg(g.pubkeys)
+			}
+		})
+	}
+}
+
+func BenchmarkMusigPartialSigVerify(b *testing.B) {
+	msg := []byte("message")
+	g := makeMusigSigners(b, 100)
+	cache, _ := MusigPubkeyAgg(g.pubkeys)
+	session, pubnonces, psigs := musigRound(b, g, cache, msg)
+
+	b.Run("single100", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for j := range psigs {
+				MusigPartialSigVerify(psigs[j], pubnonces[j], g.pubkeys[j], cache, session)
+			}
+		}
+	})
+	b.Run("batch100", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			MusigPartialSigVerifyBatch(psigs, pubnonces, g.pubkeys, cache, session)
+		}
+	})
+}
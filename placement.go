@@ -0,0 +1,100 @@
+package p256k1
+
+import (
+	"runtime"
+	"strconv"
+	"strings"
+	"sync"
+)
+
+// numaNode is a NUMA node and the CPUs attached to it
+type numaNode struct {
+	id   int
+	cpus []int
+}
+
+// parseCPUList parses a sysfs CPU list such as "0-3,8,10-11"
+func parseCPUList(s string) []int {
+	var cpus []int
+	for _, part := range strings.Split(s, ",") {
+		lo, hi, isRange := strings.Cut(part, "-")
+		first, err := strconv.Atoi(lo)
+		if err != nil {
+			continue
+		}
+		last := first
+		if isRange {
+			if last, err = strconv.Atoi(hi); err != nil {
+				continue
+			}
+		}
+		for c := first; c <= last; c++ {
+			cpus = append(cpus, c)
+		}
+	}
+	return cpus
+}
+
+// newTableStorage returns n zeroed entries for a private copy of a
+// precomputed table, backed by huge pages if huge is set and the platform
+// supports it. Either way the entries start on a cache line boundary.
+func newTableStorage(n int, huge bool) []geStorage {
+	if huge {
+		if mem := allocHugeStorage(n); mem != nil {
+			return mem
+		}
+	}
+	return newCacheAlignedStorage(n)
+}
+
+// ContextReplicas holds one deep clone of a context per NUMA node, each
+// made by a thread pinned to that node so its tables are in node-local
+// memory. Get picks the replica of the node the caller is running on.
+// Goroutines migrate between CPUs, so this is a locality hint: the replica
+// returned is always correct to use, it may just be remote.
+type ContextReplicas struct {
+	nodes    []*Context // indexed by node id, nil where there is no node
+	fallback *Context
+}
+
+// NewContextReplicas clones ctx once per NUMA node. With a single node, or
+// where nodes cannot be discovered, it holds one deep clone. Set
+// ContextHugePages on ctx to also back the replicas with huge pages.
+func NewContextReplicas(ctx *Context) *ContextReplicas {
+	r := &ContextReplicas{fallback: ContextCloneDeep(ctx)}
+	nodes := numaNodes()
+	if len(nodes) < 2 {
+		return r
+	}
+
+	maxID := 0
+	for _, n := range nodes {
+		if n.id > maxID {
+			maxID = n.id
+		}
+	}
+	r.nodes = make([]*Context, maxID+1)
+	var wg sync.WaitGroup
+	for _, n := range nodes {
+		wg.Add(1)
+		go func(n numaNode) {
+			defer wg.Done()
+			// The thread stays locked, so the runtime discards it with its
+			// affinity mask when the goroutine exits
+			runtime.LockOSThread()
+			if pinThread(n.cpus) == nil {
+				r.nodes[n.id] = ContextCloneDeep(ctx)
+			}
+		}(n)
+	}
+	wg.Wait()
+	return r
+}
+
+// Get returns the replica for the NUMA node of the calling thread
+func (r *ContextReplicas) Get() *Context {
+	if node := currentNode(); node < len(r.nodes) && r.nodes[node] != nil {
+		return r.nodes[node]
+	}
+	return r.fallback
+}
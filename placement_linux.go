@@ -0,0 +1,85 @@
+//go:build linux && (amd64 || arm64)
+
+package p256k1
+
+import (
+	"os"
+	"path/filepath"
+	"strconv"
+	"strings"
+	"syscall"
+	"unsafe"
+)
+
+// hugePageSize is the size of a transparent huge page on amd64 and arm64
+// with 4 KiB base pages
+const hugePageSize = 2 << 20
+
+// allocHugeStorage returns n zeroed entries in an anonymous mapping aligned
+// to a huge page and advised for transparent huge pages, or nil if the
+// mapping fails. The mapping is never released.
+func allocHugeStorage(n int) []geStorage {
+	size := n * int(unsafe.Sizeof(geStorage{}))
+	mem, err := syscall.Mmap(-1, 0, size+hugePageSize,
+		syscall.PROT_READ|syscall.PROT_WRITE, syscall.MAP_PRIVATE|syscall.MAP_ANON)
+	if err != nil {
+		return nil
+	}
+	off := 0
+	if rem := int(uintptr(unsafe.Pointer(&mem[0])) % hugePageSize); rem != 0 {
+		off = hugePageSize - rem
+	}
+	mem = mem[off : off+size]
+	// Without transparent huge pages in madvise mode this fails and the
+	// table stays on base pages
+	_ = syscall.Madvise(mem, syscall.MADV_HUGEPAGE)
+	return unsafe.Slice((*geStorage)(unsafe.Pointer(&mem[0])), n)
+}
+
+// numaNodes lists the NUMA nodes and their CPUs from sysfs
+func numaNodes() []numaNode {
+	paths, _ := filepath.Glob("/sys/devices/system/node/node[0-9]*/cpulist")
+	var nodes []numaNode
+	for _, p := range paths {
+		id, err := strconv.Atoi(strings.TrimPrefix(filepath.Base(filepath.Dir(p)), "node"))
+		if err != nil {
+			continue
+		}
+		b, err := os.ReadFile(p)
+		if err != nil {
+			continue
+		}
+		if cpus := parseCPUList(strings.TrimSpace(string(b))); len(cpus) > 0 {
+			nodes = append(nodes, numaNode{id: id, cpus: cpus})
+		}
+	}
+	return nodes
+}
+
+// currentNode returns the NUMA node of the CPU the calling thread runs on
+func currentNode() int {
+	var cpu, node uint32
+	_, _, errno := syscall.RawSyscall(sysGetcpu,
+		uintptr(unsafe.Pointer(&cpu)), uintptr(unsafe.Pointer(&node)), 0)
+	if errno != 0 {
+		return 0
+	}
+	return int(node)
+}
+
+// pinThread restricts the calling OS thread to cpus. The goroutine must be
+// locked to its thread.
+func pinThread(cpus []int) error {
+	var mask [1024 / 64]uint64
+	for _, c := range cpus {
+		if c >= 0 && c < 1024 {
+			mask[c/64] |= 1 << uint(c%64)
+		}
+	}
+	_, _, errno := syscall.RawSyscall(syscall.SYS_SCHED_SETAFFINITY,
+		0, unsafe.Sizeof(mask), uintptr(unsafe.Pointer(&mask)))
+	if errno != 0 {
+		return errno
+	}
+	return nil
+}
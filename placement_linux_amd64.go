@@ -0,0 +1,5 @@
+package p256k1
+
+// sysGetcpu is getcpu(2), which the syscall package does not define for
+// amd64
+const sysGetcpu = 309
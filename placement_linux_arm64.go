@@ -0,0 +1,5 @@
+package p256k1
+
+import "syscall"
+
+const sysGetcpu = syscall.SYS_GETCPU
@@ -0,0 +1,14 @@
+//go:build !linux || !(amd64 || arm64)
+
+package p256k1
+
+// Without mmap and NUMA support tables stay on the Go heap and every
+// goroutine is on node 0
+
+func allocHugeStorage(n int) []geStorage { return nil }
+
+func numaNodes() []numaNode { return nil }
+
+func currentNode() int { return 0 }
+
+func pinThread(cpus []int) error { return nil }
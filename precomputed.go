@@ -0,0 +1,123 @@
+package p256k1
+
+import (
+	"encoding/binary"
+	"unsafe"
+)
+
+// Precomputed generator tables, loaded from an embedded blob instead of being
+// built at startup (the equivalent of src/precomputed_ecmult.c and
+// src/precomputed_ecmult_gen.c). The blob is produced from the table builders
+// themselves:
+//
+//	go generate        (or: make go-tables)
+//
+// which runs TestPrecomputedTables with -update-tables. The same test fails
+// when the committed blob no longer matches what the builders produce.
+//
+// Layout, all integers little-endian:
+//
+//	header  precomputedHeaderSize bytes: magic, version, windowG
+//	gen     genStorageTable, byte points table used by ecmultGen
+//	preG    ecmultTableSize(windowG) geStorage entries, odd multiples of G
+//	preG128 ecmultTableSize(windowG) geStorage entries, odd multiples of 2^128*G
+//
+// On little-endian hosts the sections are aliased in place, so loading costs
+// nothing. If the blob was built for a different windowG, or cannot be
+// aliased, the tables are decoded or rebuilt instead. Builds with the
+// p256k1small tag embed no blob (see tables_small.go).
+
+//go:generate go test -run ^TestPrecomputedTables$ -update-tables
+
+const (
+	precomputedTablesFile = "precomputed_tables.bin"
+	precomputedMagic      = "p256k1pt"
+	precomputedVersion    = 2
+
+	// precomputedHeaderSize keeps every section 64-byte aligned
+	precomputedHeaderSize = 64
+
+	geStorageSize  = int(unsafe.Sizeof(geStorage{}))
+	genStorageSize = int(unsafe.Sizeof(genStorageTable{}))
+)
+
+// precomputedGenPoints is the embedded ecmultGen table, or nil if it could
+// not be loaded
+var precomputedGenPoints *genStorageTable
+
+func init() {
+	loadPrecomputedTables(precomputedTables)
+}
+
+// loadPrecomputedTables points the generator tables at blob. It leaves them
+// unset if blob does not match this build, in which case they are computed
+// on first use.
+func loadPrecomputedTables(blob string) bool {
+	n := ecmultTableSize(windowG)
+	if len(blob) != precomputedHeaderSize+genStorageSize+2*n*geStorageSize ||
+		blob[:len(precomputedMagic)] != precomputedMagic ||
+		binary.LittleEndian.Uint32([]byte(blob[8:12])) != precomputedVersion ||
+		binary.LittleEndian.Uint32([]byte(blob[12:16])) != windowG {
+		return false
+	}
+	body := blob[precomputedHeaderSize:]
+
+	gen := geStorageTable(body[:genStorageSize])
+	precomputedGenPoints = (*genStorageTable)(unsafe.Pointer(&gen[0]))
+	body = body[genStorageSize:]
+
+	ecmultPreG = geStorageTable(body[:n*geStorageSize])
+	ecmultPreG128 = geStorageTable(body[n*geStorageSize:])
+	return true
+}
+
+// geStorageTable returns the geStorage entries encoded in b, aliasing b when
+// the host byte order and alignment allow it
+func geStorageTable(b string) []geStorage {
+	n := len(b) / geStorageSize
+	p := unsafe.StringData(b)
+	if hostLittleEndian && uintptr(unsafe.Pointer(p))%unsafe.Alignof(uint64(0)) == 0 {
+		return unsafe.Slice((*geStorage)(unsafe.Pointer(p)), n)
+	}
+
+	table := make([]geStorage, n)
+	for i := range table {
+		e := []byte(b[i*geStorageSize : (i+1)*geStorageSize])
+		for j := 0; j < 4; j++ {
+			table[i].x.n[j] = binary.LittleEndian.Uint64(e[8*j:])
+			table[i].y.n[j] = binary.LittleEndian.Uint64(e[32+8*j:])
+		}
+	}
+	return table
+}
+
+// hostLittleEndian reports whether uint64 values are stored little-endian
+var hostLittleEndian = func() bool {
+	x := uint16(1)
+	return *(*byte)(unsafe.Pointer(&x)) == 1
+}()
+
+// encodePrecomputedTables builds every generator table from scratch and
+// returns them in the embedded blob format
+func encodePrecomputedTables() []byte {
+	n := ecmultTableSize(windowG)
+	blob := make([]byte, precomputedHeaderSize, precomputedHeaderSize+genStorageSize+2*n*geStorageSize)
+	copy(blob, precomputedMagic)
+	binary.LittleEndian.PutUint32(blob[8:], precomputedVersion)
+	binary.LittleEndian.PutUint32(blob[12:], windowG)
+
+	gen := computeGenStoragePoints()
+	preG, preG128 := computeEcmultTables()
+	genFlat := unsafe.Slice(&gen[0][0], numBytes*numByteValues)
+	for _, table := range [][]geStorage{genFlat, preG, preG128} {
+		for i := range table {
+			for j := 0; j < 4; j++ {
+				blob = binary.LittleEndian.AppendUint64(blob, table[i].x.n[j])
+			}
+			for j := 0; j < 4; j++ {
+				blob = binary.LittleEndian.AppendUint64(blob, table[i].y.n[j])
+			}
+		}
+	}
+	return blob
+}
@@ -0,0 +1,46 @@
+package p256k1
+
+import (
+	"flag"
+	"os"
+	"testing"
+)
+
+var updateTables = flag.Bool("update-tables", false, "rewrite "+precomputedTablesFile+" from the table builders")
+
+func TestPrecomputedTables(t *testing.T) {
+	if smallTables {
+		t.Skip("builds with compact tables embed no blob")
+	}
+	blob := encodePrecomputedTables()
+	if *updateTables {
+		if err := os.WriteFile(precomputedTablesFile, blob, 0o644); err != nil {
+			t.Fatal(err)
+		}
+		return
+	}
+
+	if string(blob) != precomputedTables {
+		t.Fatalf("%s is stale, regenerate it with go generate", precomputedTablesFile)
+	}
+	if precomputedGenPoints == nil || ecmultPreG == nil || ecmultPreG128 == nil {
+		t.Fatal("embedded tables were not loaded")
+	}
+	if loadPrecomputedTables(precomputedTables[:len(precomputedTables)-1]) {
+		t.Error("truncated blob was accepted")
+	}
+}
+
+func BenchmarkPrecomputedTablesLoad(b *testing.B) {
+	b.Run("embedded", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			loadPrecomputedTables(precomputedTables)
+		}
+	})
+	b.Run("compute", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			computeGenStoragePoints()
+			computeEcmultTables()
+		}
+	})
+}
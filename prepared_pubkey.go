@@ -0,0 +1,79 @@
+package p256k1
+
+import "errors"
+
+// preparedWindow is the wNAF window of the per-key tables. Prepared keys are
+// built once and used many times, so they use a wider window than the
+// per-call tables of ecmultStrauss: 32 entries each for P and lambda*P, 4 KiB
+// per key.
+const preparedWindow = 7
+
+// PreparedXOnlyPubkey is an x-only public key with the odd-multiples tables
+// of its point P and of lambda*P precomputed. Verifying against it skips
+// lifting x to a point and building the tables, which is most of the
+// per-signature overhead outside the double multiplication itself. Prepare
+// keys that are seen repeatedly; a PreparedXOnlyPubkey is read-only and safe
+// for concurrent use.
+type PreparedXOnlyPubkey struct {
+	xonly  XOnlyPubkey
+	point  GroupElementAffine
+	pre    [1 << (preparedWindow - 2)]geStorage
+	preLam [1 << (preparedWindow - 2)]geStorage
+}
+
+// XOnlyPubkeyPrepare precomputes the verification tables for xonly
+func XOnlyPubkeyPrepare(xonly *XOnlyPubkey) (*PreparedXOnlyPubkey, error) {
+	if xonly == nil {
+		return nil, errors.New("nil x-only public key")
+	}
+
+	p := &PreparedXOnlyPubkey{xonly: *xonly}
+	if !xonlyPubkeyLoad(&p.point, &p.xonly.data) {
+		return nil, errors.New("invalid x-only public key")
+	}
+	ecmultPrepareTables(p.pre[:], p.preLam[:], &p.point)
+	return p, nil
+}
+
+// XOnlyPubkey returns the key that was prepared
+func (p *PreparedXOnlyPubkey) XOnlyPubkey() *XOnlyPubkey {
+	xonly := p.xonly
+	return &xonly
+}
+
+// SchnorrVerifyPrepared is SchnorrVerify for a prepared public key
+func SchnorrVerifyPrepared(sig64 []byte, msg32 []byte, pubkey *PreparedXOnlyPubkey) bool {
+	if len(sig64) != 64 || len(msg32) != 32 || pubkey == nil {
+		return false
+	}
+
+	var rx FieldElement
+	var s, e Scalar
+	var r GroupElementAffine
+	var rj GroupElementJacobian
+
+	if !rx.setB32Limit(sig64[:32]) {
+		return false
+	}
+	if s.setB32(sig64[32:64]) {
+		return false
+	}
+
+	bip340Challenge(&e, sig64[:32], pubkey.xonly.data[:], msg32)
+
+	// Compute rj = s*G + (-e)*P
+	e.negate(&e)
+	ecmultStraussPrepared(&rj, pubkey.pre[:], pubkey.preLam[:], preparedWindow, &e, &s)
+
+	r.setGEJVar(&rj)
+	if r.isInfinity() {
+		return false
+	}
+
+	r.y.normalize()
+	if r.y.isOdd() {
+		return false
+	}
+	r.x.normalize()
+	return r.x.equal(&rx)
+}
@@ -0,0 +1,120 @@
+package p256k1
+
+import (
+	"testing"
+)
+
+func TestEcmultStraussPrepared(t *testing.T) {
+	var zero Scalar
+	for iter := 0; iter < 16; iter++ {
+		p := randomPoint(t)
+		var pre, preLam [1 << (preparedWindow - 2)]geStorage
+		ecmultPrepareTables(pre[:], preLam[:], &p)
+
+		var pj GroupElementJacobian
+		pj.setGE(&p)
+		na, ng := randomScalar(t), randomScalar(t)
+		cases := []struct{ na, ng *Scalar }{{&na, &ng}, {&na, &zero}, {&zero, &ng}, {&na, nil}}
+		for i, c := range cases {
+			var got, want GroupElementJacobian
+			ecmultStraussPrepared(&got, pre[:], preLam[:], preparedWindow, c.na, c.ng)
+			ecmultStrauss(&want, &pj, c.na, c.ng)
+			if !jacobianEqual(&got, &want) {
+				t.Fatalf("iteration %d case %d: prepared result differs from ecmultStrauss", iter, i)
+			}
+		}
+	}
+}
+
+func TestSchnorrVerifyPrepared(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 8)
+	prepared := make([]*PreparedXOnlyPubkey, len(pubkeys))
+	for i, pk := range pubkeys {
+		var err error
+		if prepared[i], err = XOnlyPubkeyPrepare(pk); err != nil {
+			t.Fatal(err)
+		}
+		if *prepared[i].XOnlyPubkey() != *pk {
+			t.Fatalf("prepared key %d does not round trip", i)
+		}
+	}
+
+	for i := range sigs {
+		if !SchnorrVerifyPrepared(sigs[i], msgs[i], prepared[i]) {
+			t.Fatalf("valid signature %d rejected", i)
+		}
+		if SchnorrVerifyPrepared(sigs[i], msgs[i], prepared[(i+1)%len(prepared)]) {
+			t.Fatalf("signature %d accepted under the wrong key", i)
+		}
+		bad := append([]byte(nil), sigs[i]...)
+		bad[40] ^= 1
+		if SchnorrVerifyPrepared(bad, msgs[i], prepared[i]) {
+			t.Fatalf("modified signature %d accepted", i)
+		}
+	}
+	if SchnorrVerifyPrepared(sigs[0], msgs[0], nil) {
+		t.Error("nil prepared key accepted")
+	}
+
+	var invalid XOnlyPubkey
+	for i := range invalid.data {
+		invalid.data[i] = 0xFF
+	}
+	if _, err := XOnlyPubkeyPrepare(&invalid); err == nil {
+		t.Error("invalid key prepared")
+	}
+
+	if n := testing.AllocsPerRun(10, func() { SchnorrVerifyPrepared(sigs[0], msgs[0], prepared[0]) }); n != 0 {
+		t.Errorf("SchnorrVerifyPrepared: %v allocs, want 0", n)
+	}
+}
+
+func TestSchnorrVerifyBatchPrepared(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 10)
+	prepared := make([]*PreparedXOnlyPubkey, len(pubkeys))
+	for i, pk := range pubkeys {
+		prepared[i], _ = XOnlyPubkeyPrepare(pk)
+	}
+
+	if valid, failed := SchnorrVerifyBatchPrepared(sigs, msgs, prepared); !valid || failed != nil {
+		t.Fatalf("valid batch rejected, failed = %v", failed)
+	}
+
+	sigs[2][50] ^= 1
+	prepared[7] = nil
+	valid, failed := SchnorrVerifyBatchPrepared(sigs, msgs, prepared)
+	if valid || len(failed) != 2 || failed[0] != 2 || failed[1] != 7 {
+		t.Fatalf("valid = %v, failed = %v, want [2 7]", valid, failed)
+	}
+
+	if valid, _ := SchnorrVerifyBatchPrepared(sigs, msgs, prepared[:3]); valid {
+		t.Error("mismatched lengths accepted")
+	}
+}
+
+func BenchmarkSchnorrVerifyPrepared(b *testing.B) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(b, 1)
+	prepared, err := XOnlyPubkeyPrepare(pubkeys[0])
+	if err != nil {
+		b.Fatal(err)
+	}
+
+	b.Run("SchnorrVerify", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			SchnorrVerify(sigs[0], msgs[0], pubkeys[0])
+		}
+	})
+	b.Run("prepared", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			SchnorrVerifyPrepared(sigs[0], msgs[0], prepared)
+		}
+	})
+	b.Run("prepare", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			XOnlyPubkeyPrepare(pubkeys[0])
+		}
+	})
+}
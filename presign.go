@@ -0,0 +1,169 @@
+package p256k1
+
+import (
+	"crypto/rand"
+	"errors"
+	"sync"
+	"unsafe"
+)
+
+// presignDefaultDepth is the number of nonces a Presigner keeps ready when
+// no depth is given
+const presignDefaultDepth = 64
+
+// Presigner makes BIP-340 signatures for one key pair with nonces computed
+// ahead of time. A background goroutine keeps a queue of nonces k with their
+// points R = k*G, so Sign only hashes the challenge and computes k + e*sk;
+// the generator multiplication is off the request path. If the queue runs
+// dry Sign computes a nonce itself.
+//
+// The nonces cannot depend on the message, so they are synthetic:
+// k = TaggedHash("BIP0340/nonce", sk ^ TaggedHash("BIP0340/aux", rand) || pk)
+// with 32 fresh bytes from crypto/rand each. The signatures verify like any
+// other but differ from those of SchnorrSign, and their safety rests on the
+// random source never repeating, since a nonce used for two messages reveals
+// the secret key. Every nonce is used exactly once.
+//
+// A Presigner is safe for concurrent use. Close stops the goroutine and
+// clears the key and the queued nonces.
+type Presigner struct {
+	sk     Scalar
+	pkX    [32]byte
+	gen    *EcmultGenContext
+	nonces chan presignNonce
+	stop   chan struct{}
+	wg     sync.WaitGroup
+
+	mu     sync.RWMutex
+	closed bool
+}
+
+// presignNonce is a nonce k, negated if needed so that k*G has even y, and
+// the x coordinate of k*G
+type presignNonce struct {
+	k   Scalar
+	r32 [32]byte
+}
+
+// NewPresigner starts a Presigner keeping depth nonces ready, or
+// presignDefaultDepth if depth <= 0
+func NewPresigner(keypair *KeyPair, depth int) (*Presigner, error) {
+	if keypair == nil {
+		return nil, errors.New("keypair cannot be nil")
+	}
+	if depth <= 0 {
+		depth = presignDefaultDepth
+	}
+	p := &Presigner{
+		gen:    getGlobalGenContext(),
+		nonces: make(chan presignNonce, depth),
+		stop:   make(chan struct{}),
+	}
+	if err := schnorrKeypairLoad(&p.sk, &p.pkX, keypair); err != nil {
+		return nil, err
+	}
+	p.wg.Add(1)
+	go p.fill()
+	return p, nil
+}
+
+// fill keeps the nonce queue full until the Presigner is closed
+func (p *Presigner) fill() {
+	defer p.wg.Done()
+	var n presignNonce
+	for {
+		if err := p.newNonce(&n); err != nil {
+			// Sign reports the error when it falls back
+			return
+		}
+		select {
+		case p.nonces <- n:
+		case <-p.stop:
+			n.k.clear()
+			return
+		}
+	}
+}
+
+// newNonce computes a fresh synthetic nonce and its point
+func (p *Presigner) newNonce(n *presignNonce) error {
+	var aux, skBytes, nonce32 [32]byte
+	if _, err := rand.Read(aux[:]); err != nil {
+		return err
+	}
+	p.sk.getB32(skBytes[:])
+	err := NonceFunctionBIP340(nonce32[:], nil, skBytes[:], p.pkX[:], aux[:])
+	memclear(unsafe.Pointer(&skBytes[0]), 32)
+	if err != nil {
+		return err
+	}
+	ok := n.k.setB32Seckey(nonce32[:])
+	memclear(unsafe.Pointer(&nonce32[0]), 32)
+	if !ok {
+		return errors.New("nonce generation failed")
+	}
+
+	var rj GroupElementJacobian
+	var r GroupElementAffine
+	p.gen.ecmultGen(&rj, &n.k)
+	r.setGEJ(&rj)
+	r.y.normalize()
+	if r.y.isOdd() {
+		n.k.negate(&n.k)
+	}
+	r.x.normalize()
+	r.x.getB32(n.r32[:])
+	rj.clear()
+	r.clear()
+	return nil
+}
+
+// Sign writes a signature of msg32 to sig64 using a precomputed nonce
+func (p *Presigner) Sign(sig64 []byte, msg32 []byte) error {
+	if len(sig64) != 64 {
+		return errors.New("signature must be 64 bytes")
+	}
+	if len(msg32) != 32 {
+		return errors.New("message must be 32 bytes")
+	}
+
+	p.mu.RLock()
+	defer p.mu.RUnlock()
+	if p.closed {
+		return errors.New("presigner is closed")
+	}
+
+	var n presignNonce
+	select {
+	case n = <-p.nonces:
+	default:
+		if err := p.newNonce(&n); err != nil {
+			return err
+		}
+	}
+	schnorrSignFinish(sig64, msg32, &p.sk, &p.pkX, &n.k, &n.r32)
+	n.k.clear()
+	return nil
+}
+
+// Close stops the background goroutine and clears the secret key and the
+// unused nonces. Sign fails afterwards.
+func (p *Presigner) Close() {
+	p.mu.Lock()
+	defer p.mu.Unlock()
+	if p.closed {
+		return
+	}
+	p.closed = true
+	close(p.stop)
+	p.wg.Wait()
+	for {
+		select {
+		case n := <-p.nonces:
+			n.k.clear()
+		default:
+			p.sk.clear()
+			return
+		}
+	}
+}
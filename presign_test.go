@@ -0,0 +1,102 @@
+package p256k1
+
+import (
+	"runtime"
+	"sync"
+	"testing"
+)
+
+func TestPresigner(t *testing.T) {
+	keypair, err := KeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	xonly, err := keypair.XOnlyPubkey()
+	if err != nil {
+		t.Fatal(err)
+	}
+	p, err := NewPresigner(keypair, 4)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	// More signatures than the queue holds, from several goroutines, so
+	// both queued and inline nonces are used
+	var wg sync.WaitGroup
+	sigs := make([][64]byte, 32)
+	msgs := make([][32]byte, len(sigs))
+	for i := range sigs {
+		msgs[i][0] = byte(i)
+		wg.Add(1)
+		go func(i int) {
+			defer wg.Done()
+			if err := p.Sign(sigs[i][:], msgs[i][:]); err != nil {
+				t.Error(err)
+			}
+		}(i)
+	}
+	wg.Wait()
+
+	seen := make(map[[32]byte]bool)
+	for i := range sigs {
+		if !SchnorrVerify(sigs[i][:], msgs[i][:], xonly) {
+			t.Fatalf("presigned signature %d does not verify", i)
+		}
+		var r [32]byte
+		copy(r[:], sigs[i][:32])
+		if seen[r] {
+			t.Fatal("nonce used twice")
+		}
+		seen[r] = true
+	}
+
+	if err := p.Sign(make([]byte, 63), msgs[0][:]); err == nil {
+		t.Error("short signature buffer accepted")
+	}
+	p.Close()
+	p.Close()
+	if err := p.Sign(sigs[0][:], msgs[0][:]); err == nil {
+		t.Error("closed presigner signed")
+	}
+	if !p.sk.isZero() {
+		t.Error("Close did not clear the secret key")
+	}
+	if _, err := NewPresigner(nil, 0); err == nil {
+		t.Error("nil keypair accepted")
+	}
+}
+
+// BenchmarkPresigner compares the signing latency of SchnorrSign with a
+// Presigner whose queue is kept full
+func BenchmarkPresigner(b *testing.B) {
+	keypair, err := KeyPairGenerate()
+	if err != nil {
+		b.Fatal(err)
+	}
+	msg := make([]byte, 32)
+	sig := make([]byte, 64)
+
+	b.Run("SchnorrSign", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			if err := SchnorrSign(sig, msg, keypair, nil); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("Presigner", func(b *testing.B) {
+		p, err := NewPresigner(keypair, b.N+1)
+		if err != nil {
+			b.Fatal(err)
+		}
+		defer p.Close()
+		for len(p.nonces) < b.N {
+			runtime.Gosched()
+		}
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			if err := p.Sign(sig, msg); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+}
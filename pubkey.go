@@ -16,7 +16,10 @@ const (
 )
 
 // ECPubkeyParse parses a public key from bytes
-func ECPubkeyParse(pubkey *PublicKey, input []byte) error {
+func ECPubkeyParse(pubkey *PublicKey, input []byte) (err error) {
+	if metricsEnabled {
+		defer metricsDoneErr(metricPubkeyParse, metricsStart(), &err)
+	}
 	if len(input) == 0 {
 		return errors.New("input cannot be empty")
 	}
@@ -32,8 +35,8 @@ func ECPubkeyParse(pubkey *PublicKey, input []byte) error {
 		
 		// Extract X coordinate
 		var x FieldElement
-		if err := x.setB32(input[1:33]); err != nil {
-			return err
+		if !x.setB32Limit(input[1:33]) {
+			return errors.New("public key x coordinate out of range")
 		}
 		
 		// Determine Y coordinate from X and parity
@@ -50,24 +53,22 @@ func ECPubkeyParse(pubkey *PublicKey, input []byte) error {
 		
 		// Extract X and Y coordinates
 		var x, y FieldElement
-		if err := x.setB32(input[1:33]); err != nil {
-			return err
-		}
-		if err := y.setB32(input[33:65]); err != nil {
-			return err
+		if !x.setB32Limit(input[1:33]) || !y.setB32Limit(input[33:65]) {
+			return errors.New("public key coordinate out of range")
 		}
 		
 		point.setXY(&x, &y)
 		
+		// Validate the point is on the curve; a point lifted from x in
+		// the compressed case is on it by construction
+		if !point.isValid() {
+			return errors.New("public key not on curve")
+		}
+		
 	default:
 		return errors.New("invalid public key length")
 	}
 	
-	// Validate the point is on the curve
-	if !point.isValid() {
-		return errors.New("public key not on curve")
-	}
-	
 	// Store in internal format
 	point.toBytes(pubkey.data[:])
 	
@@ -148,6 +149,20 @@ func ECPubkeyCmp(pubkey1, pubkey2 *PublicKey) int {
 
 // ECPubkeyCreate creates a public key from a private key
 func ECPubkeyCreate(pubkey *PublicKey, seckey []byte) error {
+	return ecPubkeyCreate(getGlobalGenContext(), pubkey, seckey)
+}
+
+// ECPubkeyCreate creates a public key from a private key using the context's
+// generator multiplication
+func (ctx *Context) ECPubkeyCreate(pubkey *PublicKey, seckey []byte) error {
+	if !ctx.canSign() {
+		return errors.New("context cannot sign")
+	}
+	return ecPubkeyCreate(ctx.ecmultGenCtx, pubkey, seckey)
+}
+
+// ecPubkeyCreate implements ECPubkeyCreate with the given generator context
+func ecPubkeyCreate(gen *EcmultGenContext, pubkey *PublicKey, seckey []byte) error {
 	if len(seckey) != 32 {
 		return errors.New("private key must be 32 bytes")
 	}
@@ -160,7 +175,7 @@ func ECPubkeyCreate(pubkey *PublicKey, seckey []byte) error {
 	
 	// Compute pubkey = scalar * G
 	var point GroupElementJacobian
-	EcmultGen(&point, &scalar)
+	gen.ecmultGen(&point, &scalar)
 	
 	// Convert to affine and store directly - optimize by avoiding intermediate copy
 	var affine GroupElementAffine
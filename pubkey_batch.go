@@ -0,0 +1,331 @@
+package p256k1
+
+import (
+	"errors"
+	"runtime"
+	"sort"
+)
+
+// pubkeyBatchParallelMin is the number of keys from which the batch parse
+// and serialize functions split the work over GOMAXPROCS goroutines
+const pubkeyBatchParallelMin = 4096
+
+// ECPubkeyParseBatch parses inputs[i] into pubkeys[i] as ECPubkeyParse does,
+// and returns the indices of the inputs that failed to parse, in ascending
+// order. Failed keys are zeroed. pubkeys must be at least as long as inputs.
+//
+// With fieldLanesVector the square roots of compressed keys are computed
+// fieldLaneCount at a time, which is where parsing spends its time.
+func ECPubkeyParseBatch(pubkeys []PublicKey, inputs [][]byte) (failed []int) {
+	pubkeys = pubkeys[:len(inputs)]
+	return parseBatch(len(inputs), func(lo, hi int, failed []int) []int {
+		if !fieldLanesVector {
+			for i := lo; i < hi; i++ {
+				if ECPubkeyParse(&pubkeys[i], inputs[i]) != nil {
+					pubkeys[i] = PublicKey{}
+					failed = append(failed, i)
+				}
+			}
+			return failed
+		}
+
+		var l xLifter
+		flush := func() {
+			l.lift()
+			for j := 0; j < l.n; j++ {
+				i := l.idx[j]
+				if l.ok[j] {
+					l.points[j].toBytes(pubkeys[i].data[:])
+				} else {
+					pubkeys[i] = PublicKey{}
+					failed = append(failed, i)
+				}
+			}
+			l.n = 0
+		}
+		for i := lo; i < hi; i++ {
+			in := inputs[i]
+			if len(in) != 33 || (in[0] != 0x02 && in[0] != 0x03) {
+				if ECPubkeyParse(&pubkeys[i], in) != nil {
+					pubkeys[i] = PublicKey{}
+					failed = append(failed, i)
+				}
+				continue
+			}
+			var x FieldElement
+			if !x.setB32Limit(in[1:33]) {
+				pubkeys[i] = PublicKey{}
+				failed = append(failed, i)
+				continue
+			}
+			if l.add(i, &x, in[0] == 0x03) {
+				flush()
+			}
+		}
+		flush()
+
+		// Lifts that fail are only known once their lane group is
+		// flushed, after later inputs of other lengths may have failed
+		sort.Ints(failed)
+		return failed
+	})
+}
+
+// XOnlyPubkeyParseBatch parses inputs[i] into xonlys[i] as XOnlyPubkeyParse
+// does, and returns the indices of the inputs that failed to parse, in
+// ascending order. Failed keys are zeroed. xonlys must be at least as long
+// as inputs.
+func XOnlyPubkeyParseBatch(xonlys []XOnlyPubkey, inputs [][]byte) (failed []int) {
+	xonlys = xonlys[:len(inputs)]
+	return parseBatch(len(inputs), func(lo, hi int, failed []int) []int {
+		if !fieldLanesVector {
+			for i := lo; i < hi; i++ {
+				xonly, err := XOnlyPubkeyParse(inputs[i])
+				if err != nil {
+					xonlys[i] = XOnlyPubkey{}
+					failed = append(failed, i)
+					continue
+				}
+				xonlys[i] = *xonly
+			}
+			return failed
+		}
+
+		var l xLifter
+		flush := func() {
+			l.lift()
+			for j := 0; j < l.n; j++ {
+				i := l.idx[j]
+				if l.ok[j] {
+					copy(xonlys[i].data[:], inputs[i])
+				} else {
+					xonlys[i] = XOnlyPubkey{}
+					failed = append(failed, i)
+				}
+			}
+			l.n = 0
+		}
+		for i := lo; i < hi; i++ {
+			if len(inputs[i]) != 32 {
+				xonlys[i] = XOnlyPubkey{}
+				failed = append(failed, i)
+				continue
+			}
+			var x FieldElement
+			x.setB32(inputs[i])
+			if l.add(i, &x, false) {
+				flush()
+			}
+		}
+		flush()
+
+		// Lifts that fail are only known once their lane group is
+		// flushed, after later inputs of other lengths may have failed
+		sort.Ints(failed)
+		return failed
+	})
+}
+
+// ECPubkeySerializeBatch serializes pubkeys into output one after another,
+// each in the format given by flags as ECPubkeySerialize does, and returns
+// the number of bytes written. It returns 0 if flags is invalid or output is
+// shorter than 33 or 65 bytes per key. The slot of a key that cannot be
+// serialized is zeroed.
+func ECPubkeySerializeBatch(output []byte, pubkeys []PublicKey, flags uint) int {
+	var size int
+	switch flags {
+	case ECCompressed:
+		size = 33
+	case ECUncompressed:
+		size = 65
+	default:
+		return 0
+	}
+	n := len(pubkeys) * size
+	if len(output) < n {
+		return 0
+	}
+	parallelRanges(len(pubkeys), batchRangeSize(len(pubkeys)), func(lo, hi int) {
+		for i := lo; i < hi; i++ {
+			out := output[i*size : (i+1)*size]
+			if ECPubkeySerialize(out, &pubkeys[i], flags) == 0 {
+				for j := range out {
+					out[j] = 0
+				}
+			}
+		}
+	})
+	return n
+}
+
+// tweakAddBatchChunk is the number of tweaked keys ECPubkeyTweakAddBatch
+// converts to affine with one inversion
+const tweakAddBatchChunk = 128
+
+// tweakAddBatchParallelMin is the number of tweaks from which
+// ECPubkeyTweakAddBatch splits the work over GOMAXPROCS goroutines. Each
+// tweak costs a multiplication by the generator, so far fewer are needed to
+// pay for the goroutines than for parsing.
+const tweakAddBatchParallelMin = 256
+
+// ECPubkeyTweakAddBatch sets outs[i] to parent + tweaks[i]*G, as
+// ECPubkeyTweakAdd on a copy of parent does, and returns the indices of the
+// tweaks that failed, in ascending order: those that are not 32 bytes, not
+// below the group order or zero, or that give the point at infinity. Failed
+// keys are zeroed. outs must be at least as long as tweaks. An error is
+// returned, and no output written, if parent is not a valid key.
+//
+// The sums are computed with mixed additions onto the shared parent and
+// converted to affine with one inversion per tweakAddBatchChunk keys,
+// where ECPubkeyTweakAdd inverts once per key.
+func ECPubkeyTweakAddBatch(parent *PublicKey, tweaks [][]byte, outs []PublicKey) (failed []int, err error) {
+	if parent == nil {
+		return nil, errors.New("parent cannot be nil")
+	}
+	if len(outs) < len(tweaks) {
+		return nil, errors.New("outs is shorter than tweaks")
+	}
+	var p GroupElementAffine
+	pubkeyLoad(&p, parent)
+	if p.isInfinity() || !p.isValid() {
+		return nil, errors.New("invalid public key")
+	}
+	outs = outs[:len(tweaks)]
+
+	per := len(tweaks)
+	if per >= tweakAddBatchParallelMin {
+		procs := runtime.GOMAXPROCS(0)
+		per = (per + procs - 1) / procs
+		per = (per + tweakAddBatchChunk - 1) / tweakAddBatchChunk * tweakAddBatchChunk
+	}
+	if per == 0 {
+		return nil, nil
+	}
+	ranges := make([][]int, (len(tweaks)+per-1)/per)
+	gen := getGlobalGenContext()
+	parallelRanges(len(tweaks), per, func(lo, hi int) {
+		var res [tweakAddBatchChunk]GroupElementJacobian
+		var resAff [tweakAddBatchChunk]GroupElementAffine
+		var bad [tweakAddBatchChunk]bool
+		var tw Scalar
+		var failed []int
+		for clo := lo; clo < hi; clo += tweakAddBatchChunk {
+			n := min(hi-clo, tweakAddBatchChunk)
+			for j := 0; j < n; j++ {
+				tweak := tweaks[clo+j]
+				bad[j] = len(tweak) != 32 || !tw.setB32Seckey(tweak)
+				if bad[j] {
+					res[j].setInfinity()
+					continue
+				}
+				gen.ecmultGen(&res[j], &tw)
+				res[j].addGE(&res[j], &p)
+			}
+			geSetAllGEJVar(resAff[:n], res[:n])
+			for j := 0; j < n; j++ {
+				i := clo + j
+				if bad[j] || resAff[j].isInfinity() {
+					outs[i] = PublicKey{}
+					failed = append(failed, i)
+					continue
+				}
+				pubkeySave(&outs[i], &resAff[j])
+			}
+		}
+		ranges[lo/per] = failed
+	})
+	for _, r := range ranges {
+		failed = append(failed, r...)
+	}
+	return failed, nil
+}
+
+// batchRangeSize returns how many of n keys each goroutine of a batch
+// function handles: all of them below pubkeyBatchParallelMin, otherwise an
+// equal share per GOMAXPROCS rounded up to whole lane groups
+func batchRangeSize(n int) int {
+	if n < pubkeyBatchParallelMin {
+		return n
+	}
+	procs := runtime.GOMAXPROCS(0)
+	per := (n + procs - 1) / procs
+	return (per + fieldLaneCount - 1) / fieldLaneCount * fieldLaneCount
+}
+
+// parseBatch runs parse over n inputs split as batchRangeSize, and returns
+// the concatenation of the failed indices the ranges append, in order
+func parseBatch(n int, parse func(lo, hi int, failed []int) []int) []int {
+	per := batchRangeSize(n)
+	if per >= n {
+		return parse(0, n, nil)
+	}
+	ranges := make([][]int, (n+per-1)/per)
+	parallelRanges(n, per, func(lo, hi int) {
+		ranges[lo/per] = parse(lo, hi, nil)
+	})
+	var failed []int
+	for _, r := range ranges {
+		failed = append(failed, r...)
+	}
+	return failed
+}
+
+// xLifter collects up to fieldLaneCount x coordinates and lifts them to
+// curve points together, computing the square roots lane-wise
+type xLifter struct {
+	n      int
+	idx    [fieldLaneCount]int
+	odd    [fieldLaneCount]bool
+	y2     [fieldLaneCount]FieldElement
+	x      [fieldLaneCount]FieldElement
+	points [fieldLaneCount]GroupElementAffine
+	ok     [fieldLaneCount]bool
+}
+
+// add queues x, for the point with the given y parity, under index i. It
+// returns true once all lanes are taken and lift must be called.
+func (l *xLifter) add(i int, x *FieldElement, odd bool) bool {
+	j := l.n
+	l.idx[j] = i
+	l.odd[j] = odd
+	l.x[j] = *x
+
+	// y^2 = x^3 + 7
+	var x2, seven FieldElement
+	x2.sqr(x)
+	l.y2[j].mul(&x2, x)
+	seven.setInt(7)
+	l.y2[j].add(&seven)
+	l.n++
+	return l.n == fieldLaneCount
+}
+
+// lift sets points[j] to the point with x coordinate x[j] and parity odd[j]
+// as setXOVar does, and ok[j] to whether it exists, for the first n lanes
+func (l *xLifter) lift() {
+	if l.n == 0 {
+		return
+	}
+	var in, out fieldLanes
+	for j := 0; j < l.n; j++ {
+		in.set(j, &l.y2[j])
+	}
+	out.sqrtCandidate(&in)
+	for j := 0; j < l.n; j++ {
+		var y, check FieldElement
+		out.get(j, &y)
+		check.sqr(&y)
+		check.normalize()
+		l.y2[j].normalize()
+		l.ok[j] = check.equal(&l.y2[j])
+		if !l.ok[j] {
+			continue
+		}
+		y.normalize()
+		if y.isOdd() != l.odd[j] {
+			y.negate(&y, 1)
+			y.normalize()
+		}
+		l.points[j].setXY(&l.x[j], &y)
+	}
+}
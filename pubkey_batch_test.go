@@ -0,0 +1,220 @@
+package p256k1
+
+import (
+	"bytes"
+	"fmt"
+	"reflect"
+	"testing"
+)
+
+// makePubkeyInputs returns n serialized keys in the given format, with every
+// seventh one broken in one of several ways
+func makePubkeyInputs(tb testing.TB, n int, flags uint) [][]byte {
+	inputs := make([][]byte, n)
+	for i := range inputs {
+		kp, err := KeyPairGenerate()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		pk := kp.Pubkey()
+		var buf [65]byte
+		inputs[i] = append([]byte(nil), buf[:ECPubkeySerialize(buf[:], pk, flags)]...)
+		kp.Clear()
+		if i%7 != 3 {
+			continue
+		}
+		switch i / 7 % 5 {
+		case 0:
+			inputs[i][0] = 0x05
+		case 1:
+			inputs[i] = inputs[i][:len(inputs[i])-1]
+		case 2:
+			// About half of all x are not on the curve
+			inputs[i][5] ^= 1
+		case 3:
+			inputs[i][len(inputs[i])-1] ^= 1
+		case 4:
+			inputs[i] = nil
+		}
+	}
+	return inputs
+}
+
+func TestECPubkeyParseBatch(t *testing.T) {
+	for _, n := range []int{0, 1, 13, 100, pubkeyBatchParallelMin + 5} {
+		inputs := makePubkeyInputs(t, n, ECCompressed)
+		inputs = append(inputs, makePubkeyInputs(t, n/4, ECUncompressed)...)
+		// x = p + 1 is out of range
+		inputs = append(inputs, mustHex(t, "03FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC30"))
+
+		pubkeys := make([]PublicKey, len(inputs))
+		failed := ECPubkeyParseBatch(pubkeys, inputs)
+		var want []int
+		for i, in := range inputs {
+			var pk PublicKey
+			if ECPubkeyParse(&pk, in) != nil {
+				want = append(want, i)
+			}
+			if pk != pubkeys[i] {
+				t.Fatalf("n=%d: key %d parses differently", n, i)
+			}
+		}
+		if !reflect.DeepEqual(failed, want) {
+			t.Errorf("n=%d: failed = %v, want %v", n, failed, want)
+		}
+
+		for _, flags := range []uint{ECCompressed, ECUncompressed} {
+			out := make([]byte, len(pubkeys)*65)
+			size := ECPubkeySerializeBatch(out, pubkeys, flags) / max(len(pubkeys), 1)
+			for i := range pubkeys {
+				var buf [65]byte
+				m := ECPubkeySerialize(buf[:], &pubkeys[i], flags)
+				if m == 0 {
+					m = size
+				}
+				if !bytes.Equal(out[i*size:(i+1)*size], buf[:m]) {
+					t.Fatalf("n=%d: key %d serializes differently", n, i)
+				}
+			}
+		}
+	}
+
+	var pk [2]PublicKey
+	if ECPubkeySerializeBatch(make([]byte, 65), pk[:], ECCompressed) != 0 {
+		t.Error("serialized into too short an output")
+	}
+	if ECPubkeySerializeBatch(make([]byte, 200), pk[:], 0x07) != 0 {
+		t.Error("serialized with invalid flags")
+	}
+}
+
+func TestXOnlyPubkeyParseBatch(t *testing.T) {
+	for _, n := range []int{1, 30, pubkeyBatchParallelMin + 5} {
+		comp := makePubkeyInputs(t, n, ECCompressed)
+		inputs := make([][]byte, n)
+		for i, c := range comp {
+			inputs[i] = c
+			if len(c) > 1 {
+				inputs[i] = c[1:]
+			}
+		}
+		inputs[0] = make([]byte, 32)
+
+		xonlys := make([]XOnlyPubkey, n)
+		failed := XOnlyPubkeyParseBatch(xonlys, inputs)
+		var want []int
+		for i, in := range inputs {
+			var got XOnlyPubkey
+			if xonly, err := XOnlyPubkeyParse(in); err != nil {
+				want = append(want, i)
+			} else {
+				got = *xonly
+			}
+			if got != xonlys[i] {
+				t.Fatalf("n=%d: key %d parses differently", n, i)
+			}
+		}
+		if !reflect.DeepEqual(failed, want) {
+			t.Errorf("n=%d: failed = %v, want %v", n, failed, want)
+		}
+	}
+}
+
+func makeTweaks(tb testing.TB, n int) [][]byte {
+	tweaks := make([][]byte, n)
+	for i := range tweaks {
+		k := randomScalar(tb)
+		tweaks[i] = make([]byte, 32)
+		k.getB32(tweaks[i])
+	}
+	return tweaks
+}
+
+func TestECPubkeyTweakAddBatch(t *testing.T) {
+	seckey, parent, err := ECKeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	// The negated secret key gives the point at infinity
+	var sk Scalar
+	sk.setB32(seckey)
+	sk.negate(&sk)
+	negSeckey := make([]byte, 32)
+	sk.getB32(negSeckey)
+	order := []byte{
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+		0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48, 0xA0, 0x3B, 0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x41,
+	}
+
+	for _, n := range []int{0, 1, 130, tweakAddBatchParallelMin + 3} {
+		tweaks := makeTweaks(t, n)
+		tweaks = append(tweaks, make([]byte, 32), order, negSeckey, make([]byte, 31))
+		outs := make([]PublicKey, len(tweaks))
+		failed, err := ECPubkeyTweakAddBatch(parent, tweaks, outs)
+		if err != nil {
+			t.Fatal(err)
+		}
+		var want []int
+		for i, tweak := range tweaks {
+			pk := *parent
+			if ECPubkeyTweakAdd(&pk, tweak) != nil {
+				want = append(want, i)
+				pk = PublicKey{}
+			}
+			if pk != outs[i] {
+				t.Fatalf("n=%d: key %d tweaks differently", n, i)
+			}
+		}
+		if !reflect.DeepEqual(failed, want) {
+			t.Errorf("n=%d: failed = %v, want %v", n, failed, want)
+		}
+	}
+
+	if _, err := ECPubkeyTweakAddBatch(&PublicKey{}, makeTweaks(t, 2), make([]PublicKey, 2)); err == nil {
+		t.Error("accepted an unset parent")
+	}
+	if _, err := ECPubkeyTweakAddBatch(parent, makeTweaks(t, 2), make([]PublicKey, 1)); err == nil {
+		t.Error("accepted outs shorter than tweaks")
+	}
+}
+
+func BenchmarkECPubkeyTweakAddBatch(b *testing.B) {
+	_, parent, err := ECKeyPairGenerate()
+	if err != nil {
+		b.Fatal(err)
+	}
+	tweaks := makeTweaks(b, 1000)
+	outs := make([]PublicKey, len(tweaks))
+
+	b.Run("single", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for j, tweak := range tweaks {
+				outs[j] = *parent
+				ECPubkeyTweakAdd(&outs[j], tweak)
+			}
+		}
+	})
+	b.Run("batch", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			ECPubkeyTweakAddBatch(parent, tweaks, outs)
+		}
+	})
+}
+
+func BenchmarkECPubkeyParseBatch(b *testing.B) {
+	for _, n := range []int{64, 100000} {
+		inputs := makePubkeyInputs(b, n, ECCompressed)
+		pubkeys := make([]PublicKey, n)
+		b.Run(fmt.Sprintf("single/%d", n), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				k := i % n
+				ECPubkeyParse(&pubkeys[k], inputs[k])
+			}
+		})
+		b.Run(fmt.Sprintf("batch/%d", n), func(b *testing.B) {
+			for i := 0; i < b.N; i += n {
+				ECPubkeyParseBatch(pubkeys, inputs)
+			}
+		})
+	}
+}
@@ -0,0 +1,76 @@
+package p256k1
+
+import "hash/maphash"
+
+// pubkeyCacheShards is the number of independently locked shards of a
+// PubkeyCache. It must be a power of two.
+const pubkeyCacheShards = 16
+
+// PubkeyCache maps x-only public keys to their decompressed points, so
+// repeat keys skip the field square root needed to lift x to a point.
+//
+// The cache is bounded: each shard holds a fixed number of entries and
+// evicts with the CLOCK algorithm, an approximation of LRU that only sets a
+// bit on a hit. Keys are spread over the shards with a per-cache random
+// hash seed, so chosen keys cannot all be steered into one shard. Invalid
+// keys are never cached.
+//
+// A PubkeyCache is safe for concurrent use.
+type PubkeyCache struct {
+	seed  maphash.Seed
+	cache clockCache[[32]byte, GroupElementAffine]
+}
+
+// PubkeyCacheStats reports the activity of a PubkeyCache
+type PubkeyCacheStats = CacheStats
+
+// NewPubkeyCache returns a cache holding up to about capacity keys; the
+// bound is rounded up to a multiple of the shard count.
+func NewPubkeyCache(capacity int) *PubkeyCache {
+	c := &PubkeyCache{seed: maphash.MakeSeed()}
+	c.cache.init(pubkeyCacheShards, capacity, nil)
+	return c
+}
+
+// load sets pk to the point for the x-only key pk32, decompressing and
+// caching it on a miss. It returns false if pk32 is not a valid key.
+func (c *PubkeyCache) load(pk *GroupElementAffine, pk32 *[32]byte) bool {
+	sh := c.cache.shard(maphash.Bytes(c.seed, pk32[:]))
+	if sh.lookup(pk32, pk) {
+		metricsEvent(metricPubkeyCacheHit)
+		return true
+	}
+	metricsEvent(metricPubkeyCacheMiss)
+
+	// Decompress outside the lock; a concurrent miss on the same key just
+	// does the work twice
+	if !xonlyPubkeyLoad(pk, pk32) {
+		return false
+	}
+	c.cache.insert(sh, pk32, pk)
+	return true
+}
+
+// Stats returns the hit and miss counts and the number of cached keys
+func (c *PubkeyCache) Stats() PubkeyCacheStats {
+	return c.cache.stats()
+}
+
+// SchnorrVerify is SchnorrVerify with the public key looked up in, or added
+// to, the cache
+func (c *PubkeyCache) SchnorrVerify(sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool {
+	return c.schnorrVerify(nil, sig64, msg32, xonlyPubkey)
+}
+
+// schnorrVerify is SchnorrVerify with the generator tables of a context
+func (c *PubkeyCache) schnorrVerify(tables *ecmultTables, sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool {
+	if len(sig64) != 64 || len(msg32) != 32 || xonlyPubkey == nil {
+		return false
+	}
+
+	var pk GroupElementAffine
+	if !c.load(&pk, &xonlyPubkey.data) {
+		return false
+	}
+	return schnorrsigVerifyPoint(tables, sig64, msg32, &xonlyPubkey.data, &pk)
+}
@@ -0,0 +1,121 @@
+package p256k1
+
+import (
+	"sync"
+	"testing"
+)
+
+func TestPubkeyCacheVerify(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 8)
+	c := NewPubkeyCache(64)
+
+	for round := 0; round < 3; round++ {
+		for i := range sigs {
+			if !c.SchnorrVerify(sigs[i], msgs[i], pubkeys[i]) {
+				t.Fatalf("round %d: valid signature %d rejected", round, i)
+			}
+			// A signature under another key must fail even when both keys are
+			// cached
+			if c.SchnorrVerify(sigs[i], msgs[i], pubkeys[(i+1)%len(pubkeys)]) {
+				t.Fatalf("round %d: signature %d accepted under the wrong key", round, i)
+			}
+		}
+	}
+
+	st := c.Stats()
+	if st.Misses != 8 || st.Hits != 40 || st.Entries != 8 {
+		t.Errorf("stats = %+v, want 8 misses, 40 hits, 8 entries", st)
+	}
+
+	// Keys that do not encode a field element are rejected and not cached
+	var bad XOnlyPubkey
+	for i := range bad.data {
+		bad.data[i] = 0xFF
+	}
+	if c.SchnorrVerify(sigs[0], msgs[0], &bad) {
+		t.Error("signature accepted under an invalid key")
+	}
+	if st := c.Stats(); st.Entries != 8 || st.Misses != 9 {
+		t.Errorf("invalid key changed the cache: %+v", st)
+	}
+}
+
+func TestPubkeyCacheEviction(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 100)
+
+	c := NewPubkeyCache(pubkeyCacheShards)
+	for i := range sigs {
+		if !c.SchnorrVerify(sigs[i], msgs[i], pubkeys[i]) {
+			t.Fatalf("signature %d rejected", i)
+		}
+	}
+	if st := c.Stats(); st.Entries > pubkeyCacheShards {
+		t.Errorf("cache holds %d entries, bound is %d", st.Entries, pubkeyCacheShards)
+	}
+
+	// Evicted and resident keys must both still verify
+	for i := range sigs {
+		if !c.SchnorrVerify(sigs[i], msgs[i], pubkeys[i]) {
+			t.Fatalf("signature %d rejected after eviction", i)
+		}
+	}
+}
+
+func TestPubkeyCacheConcurrent(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 16)
+	c := NewPubkeyCache(32)
+
+	var wg sync.WaitGroup
+	for g := 0; g < 8; g++ {
+		wg.Add(1)
+		go func(g int) {
+			defer wg.Done()
+			for i := 0; i < 32; i++ {
+				j := (g + i) % len(sigs)
+				if !c.SchnorrVerify(sigs[j], msgs[j], pubkeys[j]) {
+					t.Errorf("signature %d rejected", j)
+					return
+				}
+			}
+		}(g)
+	}
+	wg.Wait()
+
+	if st := c.Stats(); st.Hits+st.Misses != 8*32 {
+		t.Errorf("stats = %+v, want %d lookups", st, 8*32)
+	}
+}
+
+func BenchmarkPubkeyCache(b *testing.B) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(b, 1)
+
+	b.Run("uncached", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			SchnorrVerify(sigs[0], msgs[0], pubkeys[0])
+		}
+	})
+	b.Run("cached", func(b *testing.B) {
+		c := NewPubkeyCache(1024)
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			c.SchnorrVerify(sigs[0], msgs[0], pubkeys[0])
+		}
+	})
+	b.Run("load_hit", func(b *testing.B) {
+		c := NewPubkeyCache(1024)
+		var pk GroupElementAffine
+		c.load(&pk, &pubkeys[0].data)
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			c.load(&pk, &pubkeys[0].data)
+		}
+	})
+	b.Run("decompress", func(b *testing.B) {
+		var pk GroupElementAffine
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			xonlyPubkeyLoad(&pk, &pubkeys[0].data)
+		}
+	})
+}
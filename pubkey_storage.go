@@ -0,0 +1,85 @@
+package p256k1
+
+import (
+	"errors"
+	"unsafe"
+)
+
+// PublicKeyStorageVersion is the version of the PublicKey storage format
+// read by PublicKeysFromStorage and written by PublicKeyStorage. Files
+// holding keys in this format should record it, so that a later change of
+// the format is detected instead of misread.
+//
+// Version 1 stores each key in PublicKeyStorageSize bytes: the affine x and
+// y coordinates of the point, each as 32 big-endian bytes fully reduced
+// modulo p. A key that is not set is all zeros. Unlike secp256k1_ge_to_bytes
+// in libsecp256k1, which copies the native limbs, the layout is the same on
+// every platform.
+const PublicKeyStorageVersion = 1
+
+// PublicKeyStorageSize is the size in bytes of one key in the storage format
+const PublicKeyStorageSize = 64
+
+// Keys in the storage format are the PublicKey values themselves, which is
+// what lets PublicKeysFromStorage reinterpret memory in place
+var _ [PublicKeyStorageSize - unsafe.Sizeof(PublicKey{})]byte
+var _ [unsafe.Sizeof(PublicKey{}) - PublicKeyStorageSize]byte
+var _ [1 - unsafe.Alignof(PublicKey{})]byte
+
+// PublicKeysFromStorage returns the keys stored in b in the format of
+// PublicKeyStorageVersion, without copying: the keys share memory with b,
+// which may be a memory-mapped file, and are valid for as long as b is.
+// len(b) must be a multiple of PublicKeyStorageSize.
+//
+// The keys are not validated, so b must only hold keys written by
+// PublicKeyStorage from parsed keys; other bytes give keys whose use has
+// undefined results. Use ValidatePublicKeyStorage to check b when its origin
+// is not trusted.
+func PublicKeysFromStorage(b []byte) ([]PublicKey, error) {
+	if len(b)%PublicKeyStorageSize != 0 {
+		return nil, errors.New("storage length is not a multiple of the key size")
+	}
+	if len(b) == 0 {
+		return nil, nil
+	}
+	return unsafe.Slice((*PublicKey)(unsafe.Pointer(unsafe.SliceData(b))), len(b)/PublicKeyStorageSize), nil
+}
+
+// PublicKeyStorage returns the storage form of keys in the format of
+// PublicKeyStorageVersion, without copying: the bytes share memory with keys
+// and can be written out as they are.
+func PublicKeyStorage(keys []PublicKey) []byte {
+	if len(keys) == 0 {
+		return nil
+	}
+	return unsafe.Slice(&keys[0].data[0], len(keys)*PublicKeyStorageSize)
+}
+
+// ValidatePublicKeyStorage checks keys loaded by PublicKeysFromStorage and
+// returns the indices of those that are not valid public keys, in ascending
+// order: keys with a coordinate not below p, that are not on the curve, or
+// that are not set. It costs a few field multiplications per key, far less
+// than a parse with its square root, and splits the work over GOMAXPROCS for
+// large slices.
+func ValidatePublicKeyStorage(keys []PublicKey) (failed []int) {
+	return parseBatch(len(keys), func(lo, hi int, failed []int) []int {
+		for i := lo; i < hi; i++ {
+			if !validPublicKeyStorage(&keys[i].data) {
+				failed = append(failed, i)
+			}
+		}
+		return failed
+	})
+}
+
+// validPublicKeyStorage reports whether b holds reduced coordinates of a
+// point on the curve
+func validPublicKeyStorage(b *[PublicKeyStorageSize]byte) bool {
+	var p GroupElementAffine
+	if !p.x.setB32Limit(b[:32]) || !p.y.setB32Limit(b[32:]) {
+		return false
+	}
+	// The point (0, 0) is not on the curve, so this also rejects keys that
+	// are not set
+	return p.isValid()
+}
@@ -0,0 +1,81 @@
+package p256k1
+
+import (
+	"bytes"
+	"reflect"
+	"testing"
+)
+
+func TestPublicKeyStorage(t *testing.T) {
+	const n = 20
+	keys := make([]PublicKey, n)
+	for i := range keys {
+		kp, err := KeyPairGenerate()
+		if err != nil {
+			t.Fatal(err)
+		}
+		keys[i] = *kp.Pubkey()
+		kp.Clear()
+	}
+
+	// Round trip through a copy, as through a file
+	b := append([]byte(nil), PublicKeyStorage(keys)...)
+	loaded, err := PublicKeysFromStorage(b)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(loaded) != n {
+		t.Fatalf("loaded %d keys, want %d", len(loaded), n)
+	}
+	for i := range loaded {
+		var want, got [33]byte
+		ECPubkeySerialize(want[:], &keys[i], ECCompressed)
+		ECPubkeySerialize(got[:], &loaded[i], ECCompressed)
+		if want != got {
+			t.Fatalf("key %d did not round trip", i)
+		}
+	}
+	if &loaded[3].data[0] != &b[3*PublicKeyStorageSize] {
+		t.Error("PublicKeysFromStorage copied the keys")
+	}
+	if failed := ValidatePublicKeyStorage(loaded); len(failed) != 0 {
+		t.Errorf("valid keys failed validation: %v", failed)
+	}
+
+	// x = p is not reduced, the other corruptions leave the curve
+	copy(b[2*PublicKeyStorageSize:], bytes.Repeat([]byte{0xff}, 32))
+	b[2*PublicKeyStorageSize+31] = 0x2f
+	b[2*PublicKeyStorageSize+30] = 0xfc
+	b[2*PublicKeyStorageSize+27] = 0xfe
+	b[5*PublicKeyStorageSize+40] ^= 1
+	copy(b[9*PublicKeyStorageSize:10*PublicKeyStorageSize], make([]byte, PublicKeyStorageSize))
+	if failed := ValidatePublicKeyStorage(loaded); !reflect.DeepEqual(failed, []int{2, 5, 9}) {
+		t.Errorf("failed = %v, want [2 5 9]", failed)
+	}
+
+	if _, err := PublicKeysFromStorage(b[:100]); err == nil {
+		t.Error("accepted a partial key")
+	}
+	if keys, err := PublicKeysFromStorage(nil); err != nil || keys != nil {
+		t.Error("empty storage did not give no keys")
+	}
+}
+
+func BenchmarkPublicKeyStorage(b *testing.B) {
+	const n = 1024
+	inputs := makePubkeyInputs(b, n, ECCompressed)
+	keys := make([]PublicKey, n)
+	ECPubkeyParseBatch(keys, inputs)
+	stored := PublicKeyStorage(keys)
+
+	b.Run("load", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			PublicKeysFromStorage(stored)
+		}
+	})
+	b.Run("validate", func(b *testing.B) {
+		for i := 0; i < b.N; i += n {
+			ValidatePublicKeyStorage(keys)
+		}
+	})
+}
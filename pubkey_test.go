@@ -92,6 +92,8 @@ func TestECPubkeyParse(t *testing.T) {
 		make([]byte, 66),     // too long
 		{0x02},               // compressed too short
 		make([]byte, 34),     // compressed too long
+		// x = p + 1, which would reduce to the valid x = 1
+		mustHex(t, "03FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC30"),
 	}
 
 	for i, invalid := range invalidInputs {
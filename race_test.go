@@ -0,0 +1,7 @@
+//go:build race
+
+package p256k1
+
+// raceEnabled reports whether the tests run under the race detector, whose
+// instrumentation allocates on paths that otherwise do not
+const raceEnabled = true
@@ -0,0 +1,250 @@
+package p256k1
+
+import (
+	"errors"
+	"runtime"
+)
+
+// ECDSA public key recovery, ported from src/modules/recovery/main_impl.h.
+// A signature (r, s) of a message m verifies under exactly the keys
+//
+//	Q = r^-1 * (s*R - m*G)
+//
+// for the points R with x(R) mod n == r. The recovery id picks one of them:
+// bit 0 is the parity of y(R) and bit 1 whether x(R) is r + n rather than r.
+
+// ECDSARecoverableSignature is an ECDSA signature with the recovery id that
+// identifies the public key it was made with, as
+// secp256k1_ecdsa_recoverable_signature
+type ECDSARecoverableSignature struct {
+	r, s  Scalar
+	recid int
+}
+
+// ECDSASignRecoverable creates an ECDSA signature for a message hash using a
+// private key, as ECDSASign, together with its recovery id
+func ECDSASignRecoverable(sig *ECDSARecoverableSignature, msghash32 []byte, seckey []byte) error {
+	var plain ECDSASignature
+	var recid int
+	if err := ecdsaSign(&plain, &recid, msghash32, seckey); err != nil {
+		return err
+	}
+	sig.r, sig.s, sig.recid = plain.r, plain.s, recid
+	return nil
+}
+
+// ToCompact converts a recoverable signature to compact format and its
+// recovery id
+func (sig *ECDSARecoverableSignature) ToCompact() (*ECDSASignatureCompact, int) {
+	var compact ECDSASignatureCompact
+	sig.r.getB32(compact[:32])
+	sig.s.getB32(compact[32:])
+	return &compact, sig.recid
+}
+
+// FromCompact sets a recoverable signature from compact format and a
+// recovery id from 0 to 3. As secp256k1_ecdsa_recoverable_signature_parse_compact
+// it rejects r or s not below the group order; zero values are only rejected
+// by ECDSARecover.
+func (sig *ECDSARecoverableSignature) FromCompact(compact *ECDSASignatureCompact, recid int) error {
+	if recid < 0 || recid > 3 {
+		return errors.New("recovery id must be in the range [0, 3]")
+	}
+	var r, s Scalar
+	if r.setB32(compact[:32]) || s.setB32(compact[32:]) {
+		*sig = ECDSARecoverableSignature{}
+		return errors.New("invalid signature: r or s overflows the group order")
+	}
+	sig.r, sig.s, sig.recid = r, s, recid
+	return nil
+}
+
+// RecoveryID returns the recovery id of the signature
+func (sig *ECDSARecoverableSignature) RecoveryID() int {
+	return sig.recid
+}
+
+// ToSignature converts a recoverable signature to a normal signature
+func (sig *ECDSARecoverableSignature) ToSignature() *ECDSASignature {
+	return &ECDSASignature{r: sig.r, s: sig.s}
+}
+
+// ECDSARecover sets pubkey to the public key that sig of msghash32 was made
+// with. Success guarantees that the signature verifies under pubkey; on
+// failure pubkey is zeroed.
+func ECDSARecover(pubkey *PublicKey, sig *ECDSARecoverableSignature, msghash32 []byte) error {
+	if len(msghash32) != 32 {
+		return errors.New("message hash must be 32 bytes")
+	}
+	var R GroupElementAffine
+	if !ecdsaRecoverR(&R, sig) {
+		*pubkey = PublicKey{}
+		return errors.New("invalid recoverable signature")
+	}
+	var rInv Scalar
+	rInv.inverseVar(&sig.r)
+
+	var qj GroupElementJacobian
+	ecdsaRecoverQ(&qj, &R, sig, &rInv, msghash32)
+	if qj.isInfinity() {
+		*pubkey = PublicKey{}
+		return errors.New("invalid recoverable signature")
+	}
+	var q GroupElementAffine
+	q.setGEJVar(&qj)
+	pubkeySave(pubkey, &q)
+	return nil
+}
+
+// ecdsaRecoverX sets x to the x coordinate of the R point of sig, r or
+// r + n as the recovery id selects, and reports whether sig has nonzero r
+// and s and such an x is below p
+func ecdsaRecoverX(x *FieldElement, sig *ECDSARecoverableSignature) bool {
+	if sig.r.isZero() || sig.s.isZero() || sig.recid < 0 || sig.recid > 3 {
+		return false
+	}
+	var rb [32]byte
+	sig.r.getB32(rb[:])
+	x.setB32Limit(rb[:])
+	if sig.recid&2 != 0 {
+		if x.cmpVar(&ecdsaConstPMinusOrder) >= 0 {
+			return false
+		}
+		x.add(&ecdsaConstOrderAsFE)
+		x.normalize()
+	}
+	return true
+}
+
+// ecdsaRecoverR sets R to the point of sig selected by its recovery id, and
+// reports whether it exists
+func ecdsaRecoverR(R *GroupElementAffine, sig *ECDSARecoverableSignature) bool {
+	var x FieldElement
+	return ecdsaRecoverX(&x, sig) && R.setXOVar(&x, sig.recid&1 != 0)
+}
+
+// ecdsaRecoverQ sets qj = rInv * (s*R - m*G) with one Strauss pass, for the
+// inverse rInv of the r of sig
+func ecdsaRecoverQ(qj *GroupElementJacobian, R *GroupElementAffine, sig *ECDSARecoverableSignature, rInv *Scalar, msghash32 []byte) {
+	var m, u1, u2 Scalar
+	m.setB32(msghash32)
+	u1.mul(rInv, &m)
+	u1.negate(&u1)
+	u2.mul(rInv, &sig.s)
+
+	var Rj GroupElementJacobian
+	Rj.setGE(R)
+	ecmultStrauss(qj, &Rj, &u2, &u1)
+}
+
+// recoverBatchChunk is the number of signatures ECDSARecoverBatch inverts
+// the r values of, and converts the keys of to affine, at once
+const recoverBatchChunk = 128
+
+// recoverBatchParallelMin is the number of signatures from which
+// ECDSARecoverBatch splits the work over GOMAXPROCS goroutines
+const recoverBatchParallelMin = 256
+
+// ECDSARecoverBatch sets pubkeys[i] to the public key recovered from sigs[i]
+// and msghashes[i], as ECDSARecover does, and returns the indices of the
+// signatures that failed, in ascending order. Failed keys are zeroed.
+// pubkeys must be at least as long as sigs, and msghashes as long as sigs.
+//
+// Per recoverBatchChunk signatures the r values are inverted with one
+// inversion and the keys converted to affine with another, where
+// ECDSARecover spends two inversions per signature. With fieldLanesVector
+// the square roots that decompress the R points are computed
+// fieldLaneCount at a time.
+func ECDSARecoverBatch(pubkeys []PublicKey, sigs []ECDSARecoverableSignature, msghashes [][]byte) (failed []int, err error) {
+	return ecdsaRecoverBatch(pubkeys, sigs, msghashes, fieldLanesVector)
+}
+
+// ecdsaRecoverBatch implements ECDSARecoverBatch, decompressing the R
+// points with an xLifter if lanes is set
+func ecdsaRecoverBatch(pubkeys []PublicKey, sigs []ECDSARecoverableSignature, msghashes [][]byte, lanes bool) (failed []int, err error) {
+	if len(pubkeys) < len(sigs) || len(msghashes) != len(sigs) {
+		return nil, errors.New("pubkeys and msghashes do not match sigs")
+	}
+	pubkeys = pubkeys[:len(sigs)]
+
+	per := len(sigs)
+	if per >= recoverBatchParallelMin {
+		procs := runtime.GOMAXPROCS(0)
+		per = (per + procs - 1) / procs
+		per = (per + recoverBatchChunk - 1) / recoverBatchChunk * recoverBatchChunk
+	}
+	if per == 0 {
+		return nil, nil
+	}
+	ranges := make([][]int, (len(sigs)+per-1)/per)
+	parallelRanges(len(sigs), per, func(lo, hi int) {
+		var R [recoverBatchChunk]GroupElementAffine
+		var rs, rInv [recoverBatchChunk]Scalar
+		var res [recoverBatchChunk]GroupElementJacobian
+		var resAff [recoverBatchChunk]GroupElementAffine
+		var bad [recoverBatchChunk]bool
+		var l xLifter
+		var failed []int
+		for clo := lo; clo < hi; clo += recoverBatchChunk {
+			n := min(hi-clo, recoverBatchChunk)
+
+			// Decompress the R points
+			flush := func() {
+				l.lift()
+				for j := 0; j < l.n; j++ {
+					k := l.idx[j]
+					bad[k] = !l.ok[j]
+					R[k] = l.points[j]
+				}
+				l.n = 0
+			}
+			for j := 0; j < n; j++ {
+				sig := &sigs[clo+j]
+				var x FieldElement
+				bad[j] = len(msghashes[clo+j]) != 32 || !ecdsaRecoverX(&x, sig)
+				if bad[j] {
+					continue
+				}
+				if !lanes {
+					bad[j] = !R[j].setXOVar(&x, sig.recid&1 != 0)
+				} else if l.add(j, &x, sig.recid&1 != 0) {
+					flush()
+				}
+			}
+			flush()
+
+			// Invert the r values together; failed entries, whose r may be
+			// zero, take 1 instead
+			for j := 0; j < n; j++ {
+				rs[j] = sigs[clo+j].r
+				if bad[j] {
+					rs[j] = ScalarOne
+				}
+			}
+			scalarBatchInverse(rInv[:n], rs[:n])
+
+			for j := 0; j < n; j++ {
+				if bad[j] {
+					res[j].setInfinity()
+					continue
+				}
+				ecdsaRecoverQ(&res[j], &R[j], &sigs[clo+j], &rInv[j], msghashes[clo+j])
+			}
+			geSetAllGEJVar(resAff[:n], res[:n])
+			for j := 0; j < n; j++ {
+				i := clo + j
+				if bad[j] || resAff[j].isInfinity() {
+					pubkeys[i] = PublicKey{}
+					failed = append(failed, i)
+					continue
+				}
+				pubkeySave(&pubkeys[i], &resAff[j])
+			}
+		}
+		ranges[lo/per] = failed
+	})
+	for _, r := range ranges {
+		failed = append(failed, r...)
+	}
+	return failed, nil
+}
@@ -0,0 +1,202 @@
+package p256k1
+
+import (
+	"crypto/rand"
+	"testing"
+)
+
+// makeRecoverableBatch returns n recoverable signatures of random messages
+// by random keys, with the keys that made them
+func makeRecoverableBatch(tb testing.TB, n int) ([]ECDSARecoverableSignature, [][]byte, []PublicKey) {
+	sigs := make([]ECDSARecoverableSignature, n)
+	msgs := make([][]byte, n)
+	pubkeys := make([]PublicKey, n)
+	for i := range sigs {
+		seckey, pubkey, err := ECKeyPairGenerate()
+		if err != nil {
+			tb.Fatal(err)
+		}
+		msgs[i] = make([]byte, 32)
+		if _, err := rand.Read(msgs[i]); err != nil {
+			tb.Fatal(err)
+		}
+		if err := ECDSASignRecoverable(&sigs[i], msgs[i], seckey); err != nil {
+			tb.Fatal(err)
+		}
+		pubkeys[i] = *pubkey
+	}
+	return sigs, msgs, pubkeys
+}
+
+func TestECDSARecover(t *testing.T) {
+	sigs, msgs, pubkeys := makeRecoverableBatch(t, 64)
+	for i := range sigs {
+		var got PublicKey
+		if err := ECDSARecover(&got, &sigs[i], msgs[i]); err != nil {
+			t.Fatalf("signature %d: %v", i, err)
+		}
+		if ECPubkeyCmp(&got, &pubkeys[i]) != 0 {
+			t.Fatalf("signature %d: recovered the wrong key", i)
+		}
+		if !ECDSAVerify(sigs[i].ToSignature(), msgs[i], &pubkeys[i]) {
+			t.Fatalf("signature %d does not verify", i)
+		}
+
+		// The compact form must match the plain signature's, and only its
+		// own recovery id gives the signing key
+		plain := sigs[i].ToSignature()
+		compact, recid := sigs[i].ToCompact()
+		var parsed ECDSARecoverableSignature
+		if err := parsed.FromCompact(compact, recid); err != nil || parsed != sigs[i] {
+			t.Fatalf("signature %d: compact round trip failed: %v", i, err)
+		}
+		if *plain.ToCompact() != *compact {
+			t.Fatalf("signature %d: compact forms differ", i)
+		}
+		for other := 0; other < 4; other++ {
+			if other == recid {
+				continue
+			}
+			parsed.FromCompact(compact, other)
+			if ECDSARecover(&got, &parsed, msgs[i]) == nil && ECPubkeyCmp(&got, &pubkeys[i]) == 0 {
+				t.Fatalf("signature %d: recovery id %d also gives the key", i, other)
+			}
+		}
+	}
+
+	var got PublicKey
+	wrong := append([]byte(nil), msgs[0]...)
+	wrong[0] ^= 1
+	if ECDSARecover(&got, &sigs[0], wrong) == nil && ECPubkeyCmp(&got, &pubkeys[0]) == 0 {
+		t.Error("recovered the signing key for the wrong message")
+	}
+	if ECDSARecover(&got, &ECDSARecoverableSignature{}, msgs[0]) == nil || got != (PublicKey{}) {
+		t.Error("recovered a key from a zero signature")
+	}
+
+	var sig ECDSARecoverableSignature
+	compact, _ := sigs[0].ToCompact()
+	if sig.FromCompact(compact, 4) == nil || sig.FromCompact(compact, -1) == nil {
+		t.Error("accepted an out of range recovery id")
+	}
+	var high ECDSASignatureCompact
+	for i := range high {
+		high[i] = 0xff
+	}
+	if sig.FromCompact(&high, 0) == nil {
+		t.Error("accepted r and s above the group order")
+	}
+}
+
+// TestECDSARecoverHighX recovers from a signature whose R has x >= n, recovery
+// ids 2 and 3, which signing practically never produces. As in
+// TestECDSAVerifyHighX the key is solved for instead.
+func TestECDSARecoverHighX(t *testing.T) {
+	var xb [32]byte
+	ecdsaConstOrderAsFE.getB32(xb[:])
+	var R GroupElementAffine
+	for {
+		xb[31]++
+		var x FieldElement
+		x.setB32(xb[:])
+		if R.setXOVar(&x, false) {
+			break
+		}
+	}
+
+	var sig ECDSARecoverableSignature
+	sig.r.setB32(xb[:])
+	sig.s = randomScalar(t)
+	sig.recid = 2
+	msghash := make([]byte, 32)
+	if _, err := rand.Read(msghash); err != nil {
+		t.Fatal(err)
+	}
+
+	var pubkey PublicKey
+	if err := ECDSARecover(&pubkey, &sig, msghash); err != nil {
+		t.Fatal(err)
+	}
+	if !ECDSAVerify(sig.ToSignature(), msghash, &pubkey) {
+		t.Fatal("key recovered with x(R) >= n does not verify")
+	}
+	failed, err := ECDSARecoverBatch(make([]PublicKey, 1), []ECDSARecoverableSignature{sig}, [][]byte{msghash})
+	if err != nil || failed != nil {
+		t.Fatalf("batch recovery with x(R) >= n failed: %v %v", failed, err)
+	}
+}
+
+func TestECDSARecoverBatch(t *testing.T) {
+	for _, n := range []int{0, 1, 7, recoverBatchChunk + 3, 2*recoverBatchParallelMin + 5} {
+		sigs, msgs, pubkeys := makeRecoverableBatch(t, n)
+		var wantFailed []int
+		if n > 0 {
+			sigs[n/2].s = Scalar{}
+			sigs[n-1].recid ^= 2
+			msgs[0] = msgs[0][:31]
+			wantFailed = []int{0, n / 2, n - 1}
+			if n == 1 {
+				wantFailed = []int{0}
+			}
+		}
+
+		for _, lanes := range []bool{false, true} {
+			got := make([]PublicKey, n)
+			for i := range got {
+				got[i].data[0] = 1
+			}
+			failed, err := ecdsaRecoverBatch(got, sigs, msgs, lanes)
+			if err != nil {
+				t.Fatal(err)
+			}
+			if len(failed) != len(wantFailed) {
+				t.Fatalf("n = %d, lanes = %v: failed = %v, want %v", n, lanes, failed, wantFailed)
+			}
+			for k := range failed {
+				if failed[k] != wantFailed[k] {
+					t.Fatalf("n = %d, lanes = %v: failed = %v, want %v", n, lanes, failed, wantFailed)
+				}
+			}
+			for i := range got {
+				var want PublicKey
+				ECDSARecover(&want, &sigs[i], msgs[i])
+				if got[i] != want {
+					t.Fatalf("n = %d, lanes = %v: key %d differs from ECDSARecover", n, lanes, i)
+				}
+				if want != (PublicKey{}) && ECPubkeyCmp(&want, &pubkeys[i]) != 0 {
+					t.Fatalf("n = %d: key %d is not the signing key", n, i)
+				}
+			}
+		}
+	}
+
+	if _, err := ECDSARecoverBatch(make([]PublicKey, 1), make([]ECDSARecoverableSignature, 2), make([][]byte, 2)); err == nil {
+		t.Error("accepted fewer outputs than signatures")
+	}
+}
+
+func BenchmarkECDSARecover(b *testing.B) {
+	sigs, msgs, _ := makeRecoverableBatch(b, 1000)
+	pubkeys := make([]PublicKey, len(sigs))
+
+	b.Run("single", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			j := i % len(sigs)
+			ECDSARecover(&pubkeys[j], &sigs[j], msgs[j])
+		}
+	})
+	b.Run("batch1000", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			ECDSARecoverBatch(pubkeys, sigs, msgs)
+		}
+	})
+	b.Run("batch1000/serial", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for j := range sigs {
+				ECDSARecover(&pubkeys[j], &sigs[j], msgs[j])
+			}
+		}
+	})
+}
@@ -43,8 +43,8 @@ var (
 	// GLV (Gallant-Lambert-Vanstone) endomorphism constants
 	// lambda is a primitive cube root of unity modulo n (the curve order)
 	secp256k1Lambda = Scalar{d: [4]uint64{
-		0x5363AD4CC05C30E0, 0xA5261C028812645A,
-		0x122E22EA20816678, 0xDF02967C1B23BD72,
+		0xDF02967C1B23BD72, 0x122E22EA20816678,
+		0xA5261C028812645A, 0x5363AD4CC05C30E0,
 	}}
 
 	// Note: beta is defined in field.go as a FieldElement constant
@@ -53,26 +53,26 @@ var (
 	// These are used to decompose scalars for faster multiplication
 	// minus_b1 and minus_b2 are precomputed constants for the GLV splitting algorithm
 	minusB1 = Scalar{d: [4]uint64{
+		0x6F547FA90ABFE4C3, 0xE4437ED6010E8828,
 		0x0000000000000000, 0x0000000000000000,
-		0xE4437ED6010E8828, 0x6F547FA90ABFE4C3,
 	}}
 
 	minusB2 = Scalar{d: [4]uint64{
-		0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF,
-		0x8A280AC50774346D, 0x3DB1562CDE9798D9,
+		0xD765CDA83DB1562C, 0x8A280AC50774346D,
+		0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF,
 	}}
 
 	// Precomputed estimates for GLV scalar splitting
 	// g1 and g2 are approximations of b2/d and (-b1)/d respectively
 	// where d is the curve order n
 	g1 = Scalar{d: [4]uint64{
-		0x3086D221A7D46BCD, 0xE86C90E49284EB15,
-		0x3DAA8A1471E8CA7F, 0xE893209A45DBB031,
+		0xE893209A45DBB031, 0x3DAA8A1471E8CA7F,
+		0xE86C90E49284EB15, 0x3086D221A7D46BCD,
 	}}
 
 	g2 = Scalar{d: [4]uint64{
-		0xE4437ED6010E8828, 0x6F547FA90ABFE4C4,
-		0x221208AC9DF506C6, 0x1571B4AE8AC47F71,
+		0x1571B4AE8AC47F71, 0x221208AC9DF506C6,
+		0x6F547FA90ABFE4C4, 0xE4437ED6010E8828,
 	}}
 )
 
@@ -234,12 +234,12 @@ func (r *Scalar) add(a, b *Scalar) bool {
 	r.d[2], carry = bits.Add64(a.d[2], b.d[2], carry)
 	r.d[3], carry = bits.Add64(a.d[3], b.d[3], carry)
 
-	overflow := carry != 0 || r.checkOverflow()
-	if overflow {
-		r.reduce(1)
-	}
+	// As in secp256k1_scalar_add, the reduction is applied unconditionally so
+	// that adding secret scalars does not branch on their value
+	overflow := int(carry) + boolToInt(r.checkOverflow())
+	r.reduce(overflow)
 
-	return overflow
+	return overflow != 0
 }
 
 // sub subtracts two scalars: r = a - b
@@ -255,7 +255,18 @@ func (r *Scalar) sub(a, b *Scalar) {
 func (r *Scalar) mul(a, b *Scalar) {
 	// Compute full 512-bit product using all 16 cross products
 	var l [8]uint64
-	r.mul512(l[:], a, b)
+	scalarMul512Inner(&l, a, b)
+	scalarReduce512Inner(r, &l)
+}
+
+// scalarMul512Generic is the portable Go scalarMul512Inner
+func scalarMul512Generic(l *[8]uint64, a, b *Scalar) {
+	var t Scalar
+	t.mul512(l[:], a, b)
+}
+
+// scalarReduce512Generic is the portable Go scalarReduce512Inner
+func scalarReduce512Generic(r *Scalar, l *[8]uint64) {
 	r.reduce512(l[:])
 }
 
@@ -472,69 +483,83 @@ func (r *Scalar) negate(a *Scalar) {
 	// r = n - a where n is the group order
 	var borrow uint64
 
+	// nonzero is all ones unless a is zero, in which case the result is zero
+	// rather than n
+	nonzero := uint64(0) - uint64(boolToInt(!a.isZero()))
 	r.d[0], borrow = bits.Sub64(scalarN0, a.d[0], 0)
 	r.d[1], borrow = bits.Sub64(scalarN1, a.d[1], borrow)
 	r.d[2], borrow = bits.Sub64(scalarN2, a.d[2], borrow)
 	r.d[3], _ = bits.Sub64(scalarN3, a.d[3], borrow)
+	r.d[0] &= nonzero
+	r.d[1] &= nonzero
+	r.d[2] &= nonzero
+	r.d[3] &= nonzero
 }
 
-// inverse computes the modular inverse of a scalar
+// inverse computes the modular inverse of a scalar in constant time, using
+// safegcd (secp256k1_scalar_inverse). The inverse of zero is zero.
 func (r *Scalar) inverse(a *Scalar) {
-	// Use Fermat's little theorem: a^(-1) = a^(n-2) mod n
-	// where n is the group order (which is prime)
-
-	// Use binary exponentiation with n-2
-	var exp Scalar
-	var borrow uint64
-	exp.d[0], borrow = bits.Sub64(scalarN0, 2, 0)
-	exp.d[1], borrow = bits.Sub64(scalarN1, 0, borrow)
-	exp.d[2], borrow = bits.Sub64(scalarN2, 0, borrow)
-	exp.d[3], _ = bits.Sub64(scalarN3, 0, borrow)
+	var s signed62
+	a.toSigned62(&s)
+	modinv64(&s, &modinv64ModInfoScalar)
+	r.fromSigned62(&s)
+}
 
-	r.exp(a, &exp)
+// inverseVar computes the modular inverse of a scalar in variable time,
+// following secp256k1_scalar_inverse_var. It must only be used with public
+// values.
+func (r *Scalar) inverseVar(a *Scalar) {
+	var s signed62
+	a.toSigned62(&s)
+	modinv64Var(&s, &modinv64ModInfoScalar)
+	r.fromSigned62(&s)
 }
 
-// exp computes r = a^b mod n using binary exponentiation
-func (r *Scalar) exp(a, b *Scalar) {
-	*r = ScalarOne
-	base := *a
+// scalarBatchInverse sets out[i] to the inverse of a[i] with Montgomery's
+// trick: one constant time inversion of the product of all inputs and three
+// multiplications per input. The multiplications and the inversion are
+// constant time, so this is safe for secret values, which must all be
+// nonzero. out must not alias a.
+func scalarBatchInverse(out []Scalar, a []Scalar) {
+	n := len(a)
+	if n == 0 {
+		return
+	}
 
-	for i := 0; i < 4; i++ {
-		limb := b.d[i]
-		for j := 0; j < 64; j++ {
-			if limb&1 != 0 {
-				r.mul(r, &base)
-			}
-			base.mul(&base, &base)
-			limb >>= 1
-		}
+	// out_i = a_0 * a_1 * ... * a_i
+	out[0] = a[0]
+	for i := 1; i < n; i++ {
+		out[i].mul(&out[i-1], &a[i])
 	}
+
+	// u = (a_0 * a_1 * ... * a_{n-1})^-1
+	var u Scalar
+	u.inverse(&out[n-1])
+
+	// out_i = (a_0 * ... * a_{i-1}) * (a_0 * ... * a_i)^-1, backwards so
+	// that it works in place
+	for i := n - 1; i > 0; i-- {
+		out[i].mul(&u, &out[i-1])
+		u.mul(&u, &a[i])
+	}
+	out[0] = u
+	u.clear()
 }
 
-// half computes r = a/2 mod n
+// half computes r = a/2 mod n in constant time, following
+// secp256k1_scalar_half. For odd a this uses 1/2 = n//2+1 (mod n):
+//
+//	a/2 = (a >> 1) + (a&1 ? n//2+1 : 0)
+//
+// which never overflows, as the largest odd scalar n-2 yields n-1.
 func (r *Scalar) half(a *Scalar) {
-	*r = *a
-
-	if r.d[0]&1 == 0 {
-		// Even case: simple right shift
-		r.d[0] = (r.d[0] >> 1) | ((r.d[1] & 1) << 63)
-		r.d[1] = (r.d[1] >> 1) | ((r.d[2] & 1) << 63)
-		r.d[2] = (r.d[2] >> 1) | ((r.d[3] & 1) << 63)
-		r.d[3] = r.d[3] >> 1
-	} else {
-		// Odd case: add n then divide by 2
-		var carry uint64
-		r.d[0], carry = bits.Add64(r.d[0], scalarN0, 0)
-		r.d[1], carry = bits.Add64(r.d[1], scalarN1, carry)
-		r.d[2], carry = bits.Add64(r.d[2], scalarN2, carry)
-		r.d[3], _ = bits.Add64(r.d[3], scalarN3, carry)
+	mask := -(a.d[0] & 1)
+	var carry uint64
 
-		// Now divide by 2
-		r.d[0] = (r.d[0] >> 1) | ((r.d[1] & 1) << 63)
-		r.d[1] = (r.d[1] >> 1) | ((r.d[2] & 1) << 63)
-		r.d[2] = (r.d[2] >> 1) | ((r.d[3] & 1) << 63)
-		r.d[3] = r.d[3] >> 1
-	}
+	r.d[0], carry = bits.Add64((a.d[0]>>1)|(a.d[1]<<63), (scalarNH0+1)&mask, 0)
+	r.d[1], carry = bits.Add64((a.d[1]>>1)|(a.d[2]<<63), scalarNH1&mask, carry)
+	r.d[2], carry = bits.Add64((a.d[2]>>1)|(a.d[3]<<63), scalarNH2&mask, carry)
+	r.d[3] = (a.d[3] >> 1) + (scalarNH3 & mask) + carry
 }
 
 // isZero returns true if the scalar is zero
@@ -681,10 +706,7 @@ func scalarAdd(r, a, b *Scalar) bool {
 
 // scalarMul multiplies two scalars: r = a * b
 func scalarMul(r, a, b *Scalar) {
-	// Compute full 512-bit product using all 16 cross products
-	var l [8]uint64
-	scalarMul512(l[:], a, b)
-	scalarReduce512(r, l[:])
+	r.mul(a, b)
 }
 
 // scalarGetB32 serializes a scalar to 32 bytes in big-endian format
@@ -747,61 +769,7 @@ func scalarMul512(l []uint64, a, b *Scalar) {
 	if len(l) < 8 {
 		panic("l must be at least 8 uint64s")
 	}
-
-	var c0, c1 uint64
-	var c2 uint32
-
-	// Clear accumulator
-	l[0], l[1], l[2], l[3], l[4], l[5], l[6], l[7] = 0, 0, 0, 0, 0, 0, 0, 0
-
-	// Helper functions (translated from C)
-	muladd := func(ai, bi uint64) {
-		hi, lo := bits.Mul64(ai, bi)
-		var carry uint64
-		c0, carry = bits.Add64(c0, lo, 0)
-		c1, carry = bits.Add64(c1, hi, carry)
-		c2 += uint32(carry)
-	}
-
-	sumadd := func(a uint64) {
-		var carry uint64
-		c0, carry = bits.Add64(c0, a, 0)
-		c1, carry = bits.Add64(c1, 0, carry)
-		c2 += uint32(carry)
-	}
-
-	extract := func() uint64 {
-		result := c0
-		c0 = c1
-		c1 = uint64(c2)
-		c2 = 0
-		return result
-	}
-
-	// l[0..7] = a[0..3] * b[0..3] (following C implementation exactly)
-	c0, c1, c2 = 0, 0, 0
-	muladd(a.d[0], b.d[0])
-	l[0] = extract()
-
-	sumadd(a.d[0]*b.d[1] + a.d[1]*b.d[0])
-	l[1] = extract()
-
-	sumadd(a.d[0]*b.d[2] + a.d[1]*b.d[1] + a.d[2]*b.d[0])
-	l[2] = extract()
-
-	sumadd(a.d[0]*b.d[3] + a.d[1]*b.d[2] + a.d[2]*b.d[1] + a.d[3]*b.d[0])
-	l[3] = extract()
-
-	sumadd(a.d[1]*b.d[3] + a.d[2]*b.d[2] + a.d[3]*b.d[1])
-	l[4] = extract()
-
-	sumadd(a.d[2]*b.d[3] + a.d[3]*b.d[2])
-	l[5] = extract()
-
-	sumadd(a.d[3] * b.d[3])
-	l[6] = extract()
-
-	l[7] = c0
+	scalarMul512Inner((*[8]uint64)(l), a, b)
 }
 
 // scalarReduce512 reduces a 512-bit value to 256-bit
@@ -809,127 +777,110 @@ func scalarReduce512(r *Scalar, l []uint64) {
 	if len(l) < 8 {
 		panic("l must be at least 8 uint64s")
 	}
-
-	// Implementation follows the C secp256k1_scalar_reduce_512 algorithm
-	// This is a simplified version - the full implementation would include
-	// the Montgomery reduction steps from the C code
-	r.d[0] = l[0]
-	r.d[1] = l[1]
-	r.d[2] = l[2]
-	r.d[3] = l[3]
-
-	// Apply modular reduction if needed
-	if scalarCheckOverflow(r) {
-		scalarReduce(r, 0)
-	}
+	scalarReduce512Inner(r, (*[8]uint64)(l))
 }
 
 // wNAF converts a scalar to Windowed Non-Adjacent Form representation
 // wNAF represents the scalar using digits in the range [-(2^(w-1)-1), 2^(w-1)-1]
 // with the property that non-zero digits are separated by at least w-1 zeros.
+// Scalars with the top bit set are treated as negative (s - n), which keeps
+// the representation within 256 digits.
 //
-// Returns the number of digits in the wNAF representation (at most 257 for 256-bit scalars)
-// and fills the wnaf slice with the digits.
-//
-// The wnaf slice must have at least 257 elements.
+// len(wnaf) digits are produced, which must be at most 256 and enough to hold
+// the scalar (256 for any scalar, 129 for a GLV half). Returns the index of
+// the highest nonzero digit plus one. Follows secp256k1_ecmult_wnaf.
 func (s *Scalar) wNAF(wnaf []int, w uint) int {
 	if w < 2 || w > 31 {
 		panic("w must be between 2 and 31")
 	}
-	if len(wnaf) < 257 {
-		panic("wnaf slice must have at least 257 elements")
+	n := len(wnaf)
+	if n > 256 {
+		panic("wnaf slice must have at most 256 elements")
 	}
 
-	var k Scalar
-	k = *s
+	for bit := 0; bit < n; bit++ {
+		wnaf[bit] = 0
+	}
 
-	// If the scalar is negative, make it positive
+	k := *s
+	sign := 1
 	if k.getBits(255, 1) == 1 {
 		k.negate(&k)
+		sign = -1
 	}
 
-	bits := 0
-	var carry uint32
-
-	for bit := 0; bit < 257; bit++ {
-		wnaf[bit] = 0
-	}
-
+	lastSetBit := -1
+	carry := 0
 	bit := 0
-	for bit < 256 {
-		if k.getBits(uint(bit), 1) == carry {
+	for bit < n {
+		if int(k.getBits(uint(bit), 1)) == carry {
 			bit++
 			continue
 		}
 
-		window := w
-		if bit+int(window) > 256 {
-			window = uint(256 - bit)
+		now := int(w)
+		if now > n-bit {
+			now = n - bit
 		}
 
-		word := uint32(k.getBits(uint(bit), window)) + carry
+		word := int(k.getBits(uint(bit), uint(now))) + carry
 
-		carry = (word >> (window - 1)) & 1
-		word -= carry << window
+		carry = (word >> (w - 1)) & 1
+		word -= carry << w
 
-		// word is now in range [-(2^(w-1)-1), 2^(w-1)-1]
-		wnaf[bit] = int(word)
-		bits = bit + int(window) - 1
+		wnaf[bit] = sign * word
+		lastSetBit = bit
 
-		bit += int(window)
+		bit += now
 	}
 
-	return bits + 1
+	return lastSetBit + 1
 }
 
 // scalarMulShiftVar computes r = round(a * b / 2^shift) using variable-time arithmetic
-// This is used for the GLV scalar splitting algorithm
+// This is used for the GLV scalar splitting algorithm. shift must be at least 256.
 func scalarMulShiftVar(r *Scalar, a *Scalar, b *Scalar, shift uint) {
-	if shift > 512 {
-		panic("shift too large")
+	if shift < 256 || shift > 512 {
+		panic("shift out of range")
 	}
 
 	var l [8]uint64
 	scalarMul512(l[:], a, b)
 
-	// Right shift by 'shift' bits, rounding to nearest
-	carry := uint64(0)
-	if shift > 0 && (l[0]&(uint64(1)<<(shift-1))) != 0 {
-		carry = 1 // Round up if the bit being shifted out is 1
-	}
-
-	// Shift the limbs
-	for i := 0; i < 4; i++ {
-		var srcIndex int
-		var srcShift uint
-		if shift >= 64*uint(i) {
-			srcIndex = int(shift/64) + i
-			srcShift = shift % 64
-		} else {
-			srcIndex = i
-			srcShift = shift
-		}
+	shiftLimbs := shift >> 6
+	shiftLow := shift & 0x3F
+	shiftHigh := 64 - shiftLow
 
-		if srcIndex >= 8 {
-			r.d[i] = 0
-			continue
+	r.d[0], r.d[1], r.d[2], r.d[3] = 0, 0, 0, 0
+	if shift < 512 {
+		r.d[0] = l[0+shiftLimbs] >> shiftLow
+		if shift < 448 && shiftLow != 0 {
+			r.d[0] |= l[1+shiftLimbs] << shiftHigh
 		}
-
-		val := l[srcIndex]
-		if srcShift > 0 && srcIndex+1 < 8 {
-			val |= l[srcIndex+1] << (64 - srcShift)
+	}
+	if shift < 448 {
+		r.d[1] = l[1+shiftLimbs] >> shiftLow
+		if shift < 384 && shiftLow != 0 {
+			r.d[1] |= l[2+shiftLimbs] << shiftHigh
 		}
-		val >>= srcShift
-
-		if i == 0 {
-			val += carry
+	}
+	if shift < 384 {
+		r.d[2] = l[2+shiftLimbs] >> shiftLow
+		if shift < 320 && shiftLow != 0 {
+			r.d[2] |= l[3+shiftLimbs] << shiftHigh
 		}
-
-		r.d[i] = val
+	}
+	if shift < 320 {
+		r.d[3] = l[3+shiftLimbs] >> shiftLow
 	}
 
-	// Ensure result is reduced
-	scalarReduce(r, 0)
+	// Round to nearest using the most significant bit shifted out
+	round := (l[(shift-1)>>6] >> ((shift - 1) & 0x3F)) & 1
+	var carry uint64
+	r.d[0], carry = bits.Add64(r.d[0], round, 0)
+	r.d[1], carry = bits.Add64(r.d[1], 0, carry)
+	r.d[2], carry = bits.Add64(r.d[2], 0, carry)
+	r.d[3], _ = bits.Add64(r.d[3], 0, carry)
 }
 
 // splitLambda splits a scalar k into r1 and r2 such that r1 + lambda*r2 = k mod n
@@ -959,9 +910,11 @@ func (r1 *Scalar) splitLambda(r2 *Scalar, k *Scalar) {
 	scalarMul(r1, r2, &secp256k1Lambda)
 	r1.negate(r1)
 	scalarAdd(r1, r1, k)
+}
 
-	// Ensure the result is properly reduced
-	scalarReduce(r1, 0)
-	scalarReduce(r2, 0)
+// split128 splits a scalar into its low and high 128 bits: k = r1 + r2*2^128
+func (r1 *Scalar) split128(r2 *Scalar, k *Scalar) {
+	r1.d[0], r1.d[1], r1.d[2], r1.d[3] = k.d[0], k.d[1], 0, 0
+	r2.d[0], r2.d[1], r2.d[2], r2.d[3] = k.d[2], k.d[3], 0, 0
 }
 
@@ -0,0 +1,15 @@
+//go:build amd64 && !purego
+
+package p256k1
+
+// scalarMul512Inner sets l to the 512-bit product of a and b, following
+// secp256k1_scalar_mul_512. Implemented in scalar_mul_amd64.s.
+//
+//go:noescape
+func scalarMul512Inner(l *[8]uint64, a, b *Scalar)
+
+// scalarReduce512Inner sets r to l modulo the group order in constant time,
+// following secp256k1_scalar_reduce_512. Implemented in scalar_mul_amd64.s.
+//
+//go:noescape
+func scalarReduce512Inner(r *Scalar, l *[8]uint64)
@@ -0,0 +1,201 @@
+//go:build amd64 && !purego
+
+#include "textflag.h"
+
+// The 4x64 scalar multiplication and reduction modulo n of scalar.go,
+// written with MULQ/ADDQ/ADCQ so the 192-bit accumulator (c0, c1, c2) of
+// secp256k1_scalar_mul_512 and secp256k1_scalar_reduce_512 lives in
+// R8:R9:R10 instead of going through closures and the uint128 helpers. The
+// steps follow src/scalar_4x64_impl.h.
+
+#define NC0 $0x402DA1732FC9BEBF
+#define NC1 $0x4551231950B75FC4
+
+// muladd adds x*y to the accumulator
+#define muladd(x, y) \
+	MOVQ x, AX \
+	MULQ y \
+	ADDQ AX, R8 \
+	ADCQ DX, R9 \
+	ADCQ $0, R10
+
+// muladdFast adds x*y to the accumulator, which must not overflow c1
+#define muladdFast(x, y) \
+	MOVQ x, AX \
+	MULQ y \
+	ADDQ AX, R8 \
+	ADCQ DX, R9
+
+// sumadd adds x to the accumulator
+#define sumadd(x) \
+	ADDQ x, R8 \
+	ADCQ $0, R9 \
+	ADCQ $0, R10
+
+// sumaddFast adds x to the accumulator, which must not overflow c1
+#define sumaddFast(x) \
+	ADDQ x, R8 \
+	ADCQ $0, R9
+
+// extract moves c0 to dst and shifts the accumulator down a word
+#define extract(dst) \
+	MOVQ R8, dst \
+	MOVQ R9, R8 \
+	MOVQ R10, R9 \
+	XORQ R10, R10
+
+// extractFast is extract for an accumulator with c2 = 0
+#define extractFast(dst) \
+	MOVQ R8, dst \
+	MOVQ R9, R8 \
+	XORQ R9, R9
+
+// func scalarMul512Inner(l *[8]uint64, a, b *Scalar)
+TEXT ·scalarMul512Inner(SB), NOSPLIT, $0-24
+	MOVQ l+0(FP), DI
+	MOVQ a+8(FP), SI
+	MOVQ b+16(FP), BX
+	MOVQ 0(SI), R11
+	MOVQ 8(SI), R12
+	MOVQ 16(SI), R13
+	MOVQ 24(SI), R14
+	XORQ R8, R8
+	XORQ R9, R9
+	XORQ R10, R10
+
+	// l[0..7] = a[0..3] * b[0..3]
+	muladdFast(R11, 0(BX))
+	extractFast(0(DI))
+	muladd(R11, 8(BX))
+	muladd(R12, 0(BX))
+	extract(8(DI))
+	muladd(R11, 16(BX))
+	muladd(R12, 8(BX))
+	muladd(R13, 0(BX))
+	extract(16(DI))
+	muladd(R11, 24(BX))
+	muladd(R12, 16(BX))
+	muladd(R13, 8(BX))
+	muladd(R14, 0(BX))
+	extract(24(DI))
+	muladd(R12, 24(BX))
+	muladd(R13, 16(BX))
+	muladd(R14, 8(BX))
+	extract(32(DI))
+	muladd(R13, 24(BX))
+	muladd(R14, 16(BX))
+	extract(40(DI))
+	muladdFast(R14, 24(BX))
+	extractFast(48(DI))
+	MOVQ R8, 56(DI)
+	RET
+
+// func scalarReduce512Inner(r *Scalar, l *[8]uint64)
+TEXT ·scalarReduce512Inner(SB), NOSPLIT, $0-16
+	MOVQ l+8(FP), SI
+
+	// n[0..3] = l[4..7] in R11..R14
+	MOVQ 32(SI), R11
+	MOVQ 40(SI), R12
+	MOVQ 48(SI), R13
+	MOVQ 56(SI), R14
+
+	// Reduce 512 bits into 385 bits:
+	// m[0..6] = l[0..3] + n[0..3] * N_C, with m0 in R15, m1..m3 in BX,
+	// CX, DI, m4..m6 in R11..R13
+	MOVQ 0(SI), R8
+	XORQ R9, R9
+	XORQ R10, R10
+	muladdFast(NC0, R11)
+	extractFast(R15)
+	sumaddFast(8(SI))
+	muladd(NC0, R12)
+	muladd(NC1, R11)
+	extract(BX)
+	sumadd(16(SI))
+	muladd(NC0, R13)
+	muladd(NC1, R12)
+	sumadd(R11)
+	extract(CX)
+	sumadd(24(SI))
+	muladd(NC0, R14)
+	muladd(NC1, R13)
+	sumadd(R12)
+	extract(DI)
+	muladd(NC1, R14)
+	sumadd(R13)
+	extract(R11)
+	sumaddFast(R14)
+	extractFast(R12)
+	MOVQ R8, R13
+
+	// Reduce 385 bits into 258 bits:
+	// p[0..4] = m[0..3] + m[4..6] * N_C, with p0..p3 in R15, BX, CX, DI
+	// and p4 in R8
+	MOVQ R15, R8
+	XORQ R9, R9
+	XORQ R10, R10
+	muladdFast(NC0, R11)
+	extractFast(R15)
+	sumaddFast(BX)
+	muladd(NC0, R12)
+	muladd(NC1, R11)
+	extract(BX)
+	sumadd(CX)
+	muladd(NC0, R13)
+	muladd(NC1, R12)
+	sumadd(R11)
+	extract(CX)
+	sumaddFast(DI)
+	muladdFast(NC1, R13)
+	sumaddFast(R12)
+	extractFast(DI)
+	ADDQ R13, R8
+
+	// Reduce 258 bits into 256 bits:
+	// r[0..3] = p[0..3] + p4 * N_C, with carry c in R10
+	MOVQ NC0, AX
+	MULQ R8
+	ADDQ AX, R15
+	ADCQ $0, DX
+	MOVQ DX, R9
+	MOVQ NC1, AX
+	MULQ R8
+	ADDQ R9, AX
+	ADCQ $0, DX
+	ADDQ AX, BX
+	ADCQ $0, DX
+	XORQ R10, R10
+	ADDQ R8, CX
+	ADCQ $0, R10
+	ADDQ DX, CX
+	ADCQ $0, R10
+	ADDQ R10, DI
+	MOVQ $0, R10
+	ADCQ $0, R10
+
+	// Final reduction: r + c*2^256 < 2n, so subtract n, that is add N_C
+	// modulo 2^256, if c is set or r >= n, which is when r + N_C carries.
+	// The choice is made with CMOV, in constant time.
+	MOVQ NC0, R8
+	ADDQ R15, R8
+	MOVQ NC1, R9
+	ADCQ BX, R9
+	MOVQ CX, R11
+	ADCQ $1, R11
+	MOVQ DI, R12
+	ADCQ $0, R12
+	SBBQ R13, R13
+	NEGQ R10
+	ORQ R10, R13
+	CMOVQNE R8, R15
+	CMOVQNE R9, BX
+	CMOVQNE R11, CX
+	CMOVQNE R12, DI
+
+	MOVQ r+0(FP), SI
+	MOVQ R15, 0(SI)
+	MOVQ BX, 8(SI)
+	MOVQ CX, 16(SI)
+	MOVQ DI, 24(SI)
+	RET
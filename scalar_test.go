@@ -2,6 +2,8 @@ package p256k1
 
 import (
 	"crypto/rand"
+	"math/big"
+	mrand "math/rand"
 	"testing"
 )
 
@@ -281,6 +283,71 @@ func TestScalarRandomOperations(t *testing.T) {
 	}
 }
 
+func TestScalarMulInner(t *testing.T) {
+	// Compare scalarMul512Inner and scalarReduce512Inner (assembly where
+	// built) with the portable versions and with math/big, over scalars and
+	// 512-bit values with words of all zeros and all ones mixed in
+	rng := mrand.New(mrand.NewSource(1))
+	word := func() uint64 {
+		switch rng.Intn(4) {
+		case 0:
+			return ^uint64(0)
+		case 1:
+			return 0
+		default:
+			return rng.Uint64()
+		}
+	}
+	toBig := func(words []uint64) *big.Int {
+		v := new(big.Int)
+		for i := len(words) - 1; i >= 0; i-- {
+			v.Lsh(v, 64)
+			v.Or(v, new(big.Int).SetUint64(words[i]))
+		}
+		return v
+	}
+	n := toBig([]uint64{scalarN0, scalarN1, scalarN2, scalarN3})
+
+	for i := 0; i < 10000; i++ {
+		var a, b Scalar
+		for j := range a.d {
+			a.d[j], b.d[j] = word(), word()
+		}
+		a.reduce(boolToInt(a.checkOverflow()))
+		b.reduce(boolToInt(b.checkOverflow()))
+
+		var got, want [8]uint64
+		scalarMul512Inner(&got, &a, &b)
+		scalarMul512Generic(&want, &a, &b)
+		if got != want {
+			t.Fatalf("mul512(%x, %x) = %x, want %x", a.d, b.d, got, want)
+		}
+
+		var l [8]uint64
+		for j := range l {
+			l[j] = word()
+		}
+		var r, rWant Scalar
+		scalarReduce512Inner(&r, &l)
+		scalarReduce512Generic(&rWant, &l)
+		if r != rWant {
+			t.Fatalf("reduce512(%x) = %x, want %x", l, r.d, rWant.d)
+		}
+		if toBig(r.d[:]).Cmp(new(big.Int).Mod(toBig(l[:]), n)) != 0 {
+			t.Fatalf("reduce512(%x) = %x is not the residue", l, r.d)
+		}
+
+		// Aliased outputs
+		ra, rb := a, b
+		ra.mul(&ra, &b)
+		rb.mul(&a, &rb)
+		rWant.mul(&a, &b)
+		if ra != rWant || rb != rWant {
+			t.Fatalf("aliased mul(%x, %x) differs", a.d, b.d)
+		}
+	}
+}
+
 func TestScalarEdgeCases(t *testing.T) {
 	// Test n-1 + 1 = 0
 	nMinus1 := [32]byte{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48, 0xA0, 0x3B, 0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x40}
@@ -297,3 +364,42 @@ func TestScalarEdgeCases(t *testing.T) {
 		t.Error("(n-1) + 1 should equal 0 in scalar arithmetic")
 	}
 }
+
+func TestScalarSplitLambda(t *testing.T) {
+	for i := 0; i < 256; i++ {
+		var k Scalar
+		if i == 0 {
+			k.setInt(0)
+		} else if i == 1 {
+			k.setInt(1)
+			k.negate(&k)
+		} else {
+			var buf [32]byte
+			if _, err := rand.Read(buf[:]); err != nil {
+				t.Fatal(err)
+			}
+			k.setB32(buf[:])
+		}
+
+		var r1, r2, s Scalar
+		r1.splitLambda(&r2, &k)
+
+		// k == r1 + lambda*r2
+		s.mul(&r2, &secp256k1Lambda)
+		s.add(&s, &r1)
+		if !s.equal(&k) {
+			t.Fatalf("r1 + lambda*r2 != k")
+		}
+
+		// Both halves (or their negations) fit in 128 bits
+		for _, h := range []*Scalar{&r1, &r2} {
+			v := *h
+			if v.isHigh() {
+				v.negate(&v)
+			}
+			if v.d[2] != 0 || v.d[3] != 0 {
+				t.Fatalf("split half exceeds 128 bits: %x", v.d)
+			}
+		}
+	}
+}
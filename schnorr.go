@@ -56,14 +56,20 @@ func NonceFunctionBIP340(nonce32 []byte, msg []byte, key32 []byte, xonlyPk32 []b
 		return errors.New("xonlyPk32 must be 32 bytes")
 	}
 
+	taggedMidstateInitOnce.Do(initTaggedHashMidstates)
+
 	// Mask key with aux random data
 	var maskedKey [32]byte
 	if auxRand32 != nil && len(auxRand32) == 32 {
 		// TaggedHash("BIP0340/aux", aux_rand32)
-		auxHash := TaggedHash(bip340AuxTag, auxRand32)
+		var auxHash [32]byte
+		h := getTaggedHasher(bip340AuxMidstate)
+		h.write(auxRand32)
+		h.finalize(auxHash[:])
 		for i := 0; i < 32; i++ {
 			maskedKey[i] = key32[i] ^ auxHash[i]
 		}
+		memclear(unsafe.Pointer(&auxHash[0]), 32)
 	} else {
 		// Use zero mask
 		for i := 0; i < 32; i++ {
@@ -72,13 +78,11 @@ func NonceFunctionBIP340(nonce32 []byte, msg []byte, key32 []byte, xonlyPk32 []b
 	}
 
 	// TaggedHash("BIP0340/nonce", masked_key || xonly_pk || msg)
-	var nonceInput []byte
-	nonceInput = append(nonceInput, maskedKey[:]...)
-	nonceInput = append(nonceInput, xonlyPk32...)
-	nonceInput = append(nonceInput, msg...)
-
-	nonceHash := TaggedHash(bip340NonceTag, nonceInput)
-	copy(nonce32, nonceHash[:])
+	h := getTaggedHasher(bip340NonceMidstate)
+	h.write(maskedKey[:])
+	h.write(xonlyPk32)
+	h.write(msg)
+	h.finalize(nonce32)
 
 	// Clear sensitive data
 	memclear(unsafe.Pointer(&maskedKey[0]), 32)
@@ -90,7 +94,51 @@ func NonceFunctionBIP340(nonce32 []byte, msg []byte, key32 []byte, xonlyPk32 []b
 type SchnorrSignature [64]byte
 
 // SchnorrSign creates a Schnorr signature following BIP-340
-func SchnorrSign(sig64 []byte, msg32 []byte, keypair *KeyPair, auxRand32 []byte) error {
+func SchnorrSign(sig64 []byte, msg32 []byte, keypair *KeyPair, auxRand32 []byte) (err error) {
+	if metricsEnabled {
+		defer metricsDoneErr(metricSchnorrSign, metricsStart(), &err)
+	}
+	return schnorrSign(getGlobalGenContext(), sig64, msg32, keypair, auxRand32)
+}
+
+// SchnorrSign creates a Schnorr signature following BIP-340, computing the
+// nonce point with the context's generator multiplication
+func (ctx *Context) SchnorrSign(sig64 []byte, msg32 []byte, keypair *KeyPair, auxRand32 []byte) error {
+	if !ctx.canSign() {
+		return errors.New("context cannot sign")
+	}
+	return schnorrSign(ctx.ecmultGenCtx, sig64, msg32, keypair, auxRand32)
+}
+
+// SchnorrSignInto creates a Schnorr signature following BIP-340 and writes it
+// to sig. Signing performs no heap allocations, so this is the variant for
+// hot paths.
+func SchnorrSignInto(sig *SchnorrSignature, msg32 []byte, keypair *KeyPair, auxRand32 []byte) error {
+	return schnorrSign(getGlobalGenContext(), sig[:], msg32, keypair, auxRand32)
+}
+
+// SchnorrSignValue creates a Schnorr signature following BIP-340 and returns
+// it by value
+func SchnorrSignValue(msg32 []byte, keypair *KeyPair, auxRand32 []byte) (SchnorrSignature, error) {
+	var sig SchnorrSignature
+	if err := schnorrSign(getGlobalGenContext(), sig[:], msg32, keypair, auxRand32); err != nil {
+		return SchnorrSignature{}, err
+	}
+	return sig, nil
+}
+
+// SchnorrSignInto creates a Schnorr signature following BIP-340 with the
+// context's generator multiplication and writes it to sig, without heap
+// allocations
+func (ctx *Context) SchnorrSignInto(sig *SchnorrSignature, msg32 []byte, keypair *KeyPair, auxRand32 []byte) error {
+	if !ctx.canSign() {
+		return errors.New("context cannot sign")
+	}
+	return schnorrSign(ctx.ecmultGenCtx, sig[:], msg32, keypair, auxRand32)
+}
+
+// schnorrSign implements SchnorrSign with the given generator context
+func schnorrSign(gen *EcmultGenContext, sig64 []byte, msg32 []byte, keypair *KeyPair, auxRand32 []byte) error {
 	if len(sig64) != 64 {
 		return errors.New("signature must be 64 bytes")
 	}
@@ -101,42 +149,34 @@ func SchnorrSign(sig64 []byte, msg32 []byte, keypair *KeyPair, auxRand32 []byte)
 		return errors.New("keypair cannot be nil")
 	}
 
-	// Load secret key
 	var sk Scalar
-	if !sk.setB32Seckey(keypair.seckey[:]) {
-		return errors.New("invalid secret key")
-	}
-
-	// Load public key
-	var pk GroupElementAffine
-	pk.fromBytes(keypair.pubkey.data[:])
-	if pk.isInfinity() {
-		return errors.New("invalid public key")
+	var pkX [32]byte
+	if err := schnorrKeypairLoad(&sk, &pkX, keypair); err != nil {
+		return err
 	}
-
-	// Negate secret key if Y coordinate is odd (BIP-340 requires even Y)
-	pk.y.normalize()
 	var skBytes [32]byte
 	sk.getB32(skBytes[:])
 
-	if pk.y.isOdd() {
-		sk.negate(&sk)
-		sk.getB32(skBytes[:]) // Update skBytes with negated key
-		// Update pk to have even Y
-		pk.negate(&pk)
-	}
-
-	// Get x-only public key (X coordinate)
-	var pkX [32]byte
-	pk.x.normalize()
-	pk.x.getB32(pkX[:])
-
 	// Generate nonce (use the possibly-negated secret key)
 	var nonce32 [32]byte
 	if err := NonceFunctionBIP340(nonce32[:], msg32, skBytes[:], pkX[:], auxRand32); err != nil {
 		return err
 	}
 
+	err := schnorrSignWithNonce(gen, sig64, msg32, &sk, &pkX, &nonce32)
+
+	// Clear sensitive data
+	sk.clear()
+	memclear(unsafe.Pointer(&nonce32[0]), 32)
+	memclear(unsafe.Pointer(&pkX[0]), 32)
+	memclear(unsafe.Pointer(&skBytes[0]), 32)
+
+	return err
+}
+
+// schnorrSignWithNonce writes the signature of msg32 by the loaded key sk
+// with x-only public key pkX, for the nonce hash nonce32
+func schnorrSignWithNonce(gen *EcmultGenContext, sig64 []byte, msg32 []byte, sk *Scalar, pkX *[32]byte, nonce32 *[32]byte) error {
 	// Parse nonce scalar
 	var k Scalar
 	if !k.setB32Seckey(nonce32[:]) {
@@ -149,59 +189,83 @@ func SchnorrSign(sig64 []byte, msg32 []byte, keypair *KeyPair, auxRand32 []byte)
 
 	// Compute R = k * G
 	var rj GroupElementJacobian
-	EcmultGen(&rj, &k)
+	gen.ecmultGen(&rj, &k)
 
 	// Convert to affine
 	var r GroupElementAffine
 	r.setGEJ(&rj)
 	r.y.normalize()
 
-	// If R.y is odd, negate k
+	// If R.y is odd, negate k. -R has the same x coordinate, which is all
+	// that is used below, so R is not recomputed.
 	if r.y.isOdd() {
 		k.negate(&k)
-		// Recompute R with negated k
-		EcmultGen(&rj, &k)
-		r.setGEJ(&rj)
 	}
 
 	// Extract r = X(R)
 	r.x.normalize()
 	var r32 [32]byte
 	r.x.getB32(r32[:])
-	copy(sig64[:32], r32[:])
+	schnorrSignFinish(sig64, msg32, sk, pkX, &k, &r32)
 
-	// Compute challenge e = TaggedHash("BIP0340/challenge", r || pk || msg)
-	var challengeInput []byte
-	challengeInput = append(challengeInput, r32[:]...)
-	challengeInput = append(challengeInput, pkX[:]...)
-	challengeInput = append(challengeInput, msg32...)
+	k.clear()
+	rj.clear()
+	r.clear()
 
-	challengeHash := TaggedHash(bip340ChallengeTag, challengeInput)
+	return nil
+}
+
+// schnorrKeypairLoad loads the secret key of keypair into sk, negated if
+// necessary so that its public key has even y, and the x-only public key
+// into pkX
+func schnorrKeypairLoad(sk *Scalar, pkX *[32]byte, keypair *KeyPair) error {
+	// Load secret key
+	if !sk.setB32Seckey(keypair.seckey[:]) {
+		return errors.New("invalid secret key")
+	}
+
+	// Load public key
+	var pk GroupElementAffine
+	pk.fromBytes(keypair.pubkey.data[:])
+	if pk.isInfinity() {
+		return errors.New("invalid public key")
+	}
+
+	// Negate secret key if Y coordinate is odd (BIP-340 requires even Y)
+	pk.y.normalize()
+	if pk.y.isOdd() {
+		sk.negate(sk)
+	}
+
+	// Get x-only public key (X coordinate)
+	pk.x.normalize()
+	pk.x.getB32(pkX[:])
+	return nil
+}
+
+// schnorrSignFinish writes the signature r32 || k + e*sk for the nonce k
+// whose point has x coordinate r32 and even y, with the challenge
+// e = TaggedHash("BIP0340/challenge", r || pk || msg)
+func schnorrSignFinish(sig64 []byte, msg32 []byte, sk *Scalar, pkX *[32]byte, k *Scalar, r32 *[32]byte) {
+	copy(sig64[:32], r32[:])
+
+	var challengeHash [32]byte
+	h := getTaggedHasher(bip340ChallengeMidstate)
+	h.write(r32[:])
+	h.write(pkX[:])
+	h.write(msg32)
+	h.finalize(challengeHash[:])
 	var e Scalar
 	e.setB32(challengeHash[:])
 
 	// Compute s = k + e * sk
 	var s Scalar
-	s.mul(&e, &sk)
-	s.add(&s, &k)
+	s.mul(&e, sk)
+	s.add(&s, k)
+	s.getB32(sig64[32:])
 
-	// Serialize s
-	var s32 [32]byte
-	s.getB32(s32[:])
-	copy(sig64[32:], s32[:])
-
-	// Clear sensitive data
-	sk.clear()
-	k.clear()
 	e.clear()
 	s.clear()
-	memclear(unsafe.Pointer(&nonce32[0]), 32)
-	memclear(unsafe.Pointer(&pkX[0]), 32)
-	memclear(unsafe.Pointer(&skBytes[0]), 32)
-	rj.clear()
-	r.clear()
-
-	return nil
 }
 
 // SchnorrVerifyOld is the deprecated original implementation of SchnorrVerify.
@@ -286,7 +350,7 @@ func SchnorrVerifyOld(sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool
 
 	// Convert R to affine
 	var RAff GroupElementAffine
-	RAff.setGEJ(&R)
+	RAff.setGEJVar(&R)
 
 	if RAff.isInfinity() {
 		return false
@@ -317,8 +381,10 @@ func SchnorrVerifyOld(sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool
 
 // SchnorrVerify verifies a Schnorr signature following BIP-340.
 // This is the new implementation translated from C secp256k1_schnorrsig_verify.
-// Uses precomputed context for optimal performance.
-func SchnorrVerify(sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool {
+func SchnorrVerify(sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) (ok bool) {
+	if metricsEnabled {
+		defer metricsDone(metricSchnorrVerify, metricsStart(), &ok)
+	}
 	if len(sig64) != 64 {
 		return false
 	}
@@ -329,14 +395,33 @@ func SchnorrVerify(sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool {
 		return false
 	}
 
-	// Use precomputed context (initialized once, reused across calls)
-	ctx := getSchnorrVerifyContext()
+	return schnorrsigVerify(sig64, msg32, &xonlyPubkey.data)
+}
 
-	// Convert x-only pubkey to secp256k1_xonly_pubkey format
-	var secp_xonly secp256k1_xonly_pubkey
-	copy(secp_xonly.data[:], xonlyPubkey.data[:])
+// SchnorrVerify verifies a BIP-340 signature with the context's generator
+// tables, answering from the context's verification cache and looking the
+// public key up in its public key cache when those are set
+func (ctx *Context) SchnorrVerify(sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool {
+	if !ctx.canVerify() {
+		return false
+	}
+	if ctx.verifyCache != nil {
+		return ctx.verifyCache.schnorrVerify(ctx, sig64, msg32, xonlyPubkey)
+	}
+	return ctx.schnorrVerifyUncached(sig64, msg32, xonlyPubkey)
+}
 
-	// Call the C-translated verification function
-	result := secp256k1_schnorrsig_verify(ctx, sig64, msg32, len(msg32), &secp_xonly)
-	return result != 0
+// schnorrVerifyUncached is SchnorrVerify without the verification cache
+func (ctx *Context) schnorrVerifyUncached(sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool {
+	if ctx.pubkeyCache != nil {
+		return ctx.pubkeyCache.schnorrVerify(ctx.ecmult, sig64, msg32, xonlyPubkey)
+	}
+	if len(sig64) != 64 || len(msg32) != 32 || xonlyPubkey == nil {
+		return false
+	}
+	var pk GroupElementAffine
+	if !xonlyPubkeyLoad(&pk, &xonlyPubkey.data) {
+		return false
+	}
+	return schnorrsigVerifyPoint(ctx.ecmult, sig64, msg32, &xonlyPubkey.data, &pk)
 }
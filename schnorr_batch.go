@@ -0,0 +1,230 @@
+package p256k1
+
+import (
+	"encoding/binary"
+	"sort"
+
+	sha256simd "github.com/minio/sha256-simd"
+)
+
+// bip340BatchTag domain-separates the hash that seeds the batch randomizers
+var bip340BatchTag = []byte("BIP0340/batch")
+
+// SchnorrVerifyBatch verifies a batch of BIP-340 signatures at once.
+//
+// All signatures are checked together with a random linear combination:
+//
+//	(sum a_i*s_i)*G - sum a_i*R_i - sum a_i*e_i*P_i == infinity
+//
+// evaluated as a single multi-scalar multiplication. a_0 is 1 and the other
+// randomizers are derived from a hash of every signature, message and public
+// key in the batch, so the result is deterministic but cannot be steered by
+// choosing the inputs.
+//
+// sigs, msgs and pubkeys must have the same length; each sigs[i] is 64 bytes
+// and each msgs[i] is 32 bytes. If the whole batch is valid, valid is true and
+// failed is nil. Otherwise the signatures are checked one by one and failed
+// lists the indices of the invalid ones in ascending order. If the slice
+// lengths differ, valid is false and failed is nil.
+func SchnorrVerifyBatch(sigs [][]byte, msgs [][]byte, pubkeys []*XOnlyPubkey) (valid bool, failed []int) {
+	if len(pubkeys) != len(sigs) {
+		return false, nil
+	}
+	s := scratchPool.Get().(*Scratch)
+	defer scratchPool.Put(s)
+	return schnorrVerifyBatch(s, sigs, msgs, pubkeys, nil)
+}
+
+// SchnorrVerifyBatch is SchnorrVerifyBatch with its temporaries taken from s,
+// so a warm Scratch verifies a valid batch without allocating
+func (s *Scratch) SchnorrVerifyBatch(sigs [][]byte, msgs [][]byte, pubkeys []*XOnlyPubkey) (valid bool, failed []int) {
+	if s == nil {
+		return SchnorrVerifyBatch(sigs, msgs, pubkeys)
+	}
+	if len(pubkeys) != len(sigs) {
+		return false, nil
+	}
+	return schnorrVerifyBatch(s, sigs, msgs, pubkeys, nil)
+}
+
+// SchnorrVerifyBatch is SchnorrVerifyBatch with the context's generator
+// tables and a scratch arena from the context's pool, skipping the
+// signatures found in the context's verification cache if one is set and
+// checking the rest with the context's batch backend if one is set
+func (ctx *Context) SchnorrVerifyBatch(sigs [][]byte, msgs [][]byte, pubkeys []*XOnlyPubkey) (valid bool, failed []int) {
+	if !ctx.canVerify() || len(pubkeys) != len(sigs) {
+		return false, nil
+	}
+	var s *Scratch
+	if ctx.scratch == nil {
+		s = scratchPool.Get().(*Scratch)
+		defer scratchPool.Put(s)
+	} else {
+		s = ctx.scratch.Get().(*Scratch)
+		defer ctx.scratch.Put(s)
+	}
+	if ctx.verifyCache != nil {
+		if len(msgs) != len(sigs) {
+			return false, nil
+		}
+		return ctx.verifyCache.schnorrVerifyBatch(s, ctx.batchBackend, sigs, msgs, pubkeys)
+	}
+	return schnorrVerifyBatchWith(s, ctx.batchBackend, sigs, msgs, pubkeys)
+}
+
+// SchnorrVerifyBatchPrepared is SchnorrVerifyBatch for prepared public keys,
+// which skip decompression and are verified with their precomputed tables
+// if the batch has to be checked one by one
+func SchnorrVerifyBatchPrepared(sigs [][]byte, msgs [][]byte, pubkeys []*PreparedXOnlyPubkey) (valid bool, failed []int) {
+	if len(pubkeys) != len(sigs) {
+		return false, nil
+	}
+	s := scratchPool.Get().(*Scratch)
+	defer scratchPool.Put(s)
+	return schnorrVerifyBatch(s, sigs, msgs, nil, pubkeys)
+}
+
+// SchnorrVerifyBatchPrepared is SchnorrVerifyBatchPrepared with its
+// temporaries taken from s
+func (s *Scratch) SchnorrVerifyBatchPrepared(sigs [][]byte, msgs [][]byte, pubkeys []*PreparedXOnlyPubkey) (valid bool, failed []int) {
+	if s == nil {
+		return SchnorrVerifyBatchPrepared(sigs, msgs, pubkeys)
+	}
+	if len(pubkeys) != len(sigs) {
+		return false, nil
+	}
+	return schnorrVerifyBatch(s, sigs, msgs, nil, pubkeys)
+}
+
+// schnorrVerifyBatch implements the batch APIs; exactly one of pubkeys and
+// prepared is used, and it has the same length as sigs
+func schnorrVerifyBatch(scratch *Scratch, sigs [][]byte, msgs [][]byte, pubkeys []*XOnlyPubkey, prepared []*PreparedXOnlyPubkey) (valid bool, failed []int) {
+	n := len(sigs)
+	if len(msgs) != n {
+		return false, nil
+	}
+	if n == 0 {
+		return true, nil
+	}
+
+	cp := scratch.Checkpoint()
+	defer scratch.Rollback(cp)
+
+	// points[2k] and points[2k+1] hold R and P of the k-th parsed entry.
+	// During parsing scalars[2k] temporarily holds s_k, while the inputs of
+	// the challenge e_k are collected and hashed as one batch afterwards.
+	points := scratch.affine.alloc(2 * n)
+	scalars := scratch.scalars.alloc(2 * n)
+	entries := scratch.ints.alloc(n)[:0]
+	r32s := scratch.bytes.alloc(n)[:0]
+	pk32s := scratch.bytes.alloc(n)[:0]
+	msgs32 := scratch.bytes.alloc(n)[:0]
+
+	batchTag := getTaggedHashPrefix(bip340BatchTag)
+
+	seedHash := sha256simd.New()
+	seedHash.Write(batchTag[:])
+	seedHash.Write(batchTag[:])
+
+	var digest [32]byte
+	for i := 0; i < n; i++ {
+		sig, msg := sigs[i], msgs[i]
+		var pk *XOnlyPubkey
+		var pp *PreparedXOnlyPubkey
+		if prepared != nil {
+			pp = prepared[i]
+			if pp != nil {
+				pk = &pp.xonly
+			}
+		} else {
+			pk = pubkeys[i]
+		}
+		if len(sig) != 64 || len(msg) != 32 || pk == nil {
+			failed = append(failed, i)
+			continue
+		}
+
+		k := len(entries)
+		R := &points[2*k]
+		P := &points[2*k+1]
+
+		var rx FieldElement
+		if !rx.setB32Limit(sig[:32]) || !R.setXOVar(&rx, false) {
+			failed = append(failed, i)
+			continue
+		}
+		if scalars[2*k].setB32(sig[32:]) {
+			failed = append(failed, i)
+			continue
+		}
+		if pp != nil {
+			*P = pp.point
+		} else if !xonlyPubkeyLoad(P, &pk.data) {
+			failed = append(failed, i)
+			continue
+		}
+
+		r32s = append(r32s, sig[:32])
+		pk32s = append(pk32s, pk.data[:])
+		msgs32 = append(msgs32, msg)
+
+		seedHash.Write(sig)
+		seedHash.Write(msg)
+		seedHash.Write(pk.data[:])
+
+		entries = append(entries, i)
+	}
+
+	m := len(entries)
+	if m == 0 {
+		return false, failed
+	}
+
+	// e_k = int(hash_BIP0340/challenge(r || P || m)) mod n
+	challenges := scratch.scalars.alloc(m)
+	bip340ChallengeBatch(challenges, r32s, pk32s, msgs32)
+
+	// Randomizer a_k = int(sha256(seed || k)) mod n for k > 0
+	var seed [36]byte
+	seedHash.Sum(seed[:0])
+
+	var a, t, sum Scalar
+	for k := 0; k < m; k++ {
+		if k == 0 {
+			a.setInt(1)
+		} else {
+			binary.BigEndian.PutUint32(seed[32:], uint32(k))
+			digest = sha256simd.Sum256(seed[:])
+			a.setB32(digest[:])
+		}
+
+		t.mul(&a, &scalars[2*k])
+		sum.add(&sum, &t)
+
+		scalars[2*k].negate(&a)
+		t.mul(&a, &challenges[k])
+		scalars[2*k+1].negate(&t)
+	}
+
+	var r GroupElementJacobian
+	ecmultMultiVar(scratch, &r, points[:2*m], scalars[:2*m], &sum)
+	if r.isInfinity() {
+		return len(failed) == 0, failed
+	}
+
+	// The batch equation does not hold; find the offending signatures
+	metricsEvent(metricBatchFallback)
+	for _, i := range entries {
+		var ok bool
+		if prepared != nil {
+			ok = SchnorrVerifyPrepared(sigs[i], msgs[i], prepared[i])
+		} else {
+			ok = SchnorrVerify(sigs[i], msgs[i], pubkeys[i])
+		}
+		if !ok {
+			failed = append(failed, i)
+		}
+	}
+	sort.Ints(failed)
+	return len(failed) == 0, failed
+}
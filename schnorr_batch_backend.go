@@ -0,0 +1,199 @@
+package p256k1
+
+import (
+	"errors"
+	"runtime"
+	"sort"
+)
+
+// SchnorrBatchJob is one BIP-340 signature reduced to its double-scalar
+// multiplication, in the form handed to a SchnorrBatchBackend. The
+// signature is valid if
+//
+//	S*G - E*P
+//
+// is a point with even y and x coordinate R. The parsing, the decompression
+// of the public key and the challenge hash E have been done by the caller:
+// R is below the field order, P is the affine point x || y of the public key
+// with even y, and S and E are below the group order, all big endian.
+type SchnorrBatchJob struct {
+	R [32]byte
+	P [64]byte
+	S [32]byte
+	E [32]byte
+}
+
+// SchnorrBatchBackend performs the multiplications of a batch of Schnorr
+// signatures. VerifySchnorrJobs sets valid[i] to whether jobs[i] holds for
+// every i; valid has the same length as jobs. Backends for accelerators,
+// such as GPUs, implement this interface and are installed with
+// ContextSetSchnorrBatchBackend, leaving parsing and hashing to the CPU.
+// A backend may be called from several goroutines at once.
+type SchnorrBatchBackend interface {
+	VerifySchnorrJobs(jobs []SchnorrBatchJob, valid []bool)
+}
+
+// backendBatchChunk is the number of jobs CPUSchnorrBatchBackend converts to
+// affine with one inversion
+const backendBatchChunk = 128
+
+// CPUSchnorrBatchBackend is the SchnorrBatchBackend that checks every job
+// with a Strauss multiplication on Workers goroutines, or GOMAXPROCS if
+// Workers is 0. It is the reference for other backends and their
+// throughput baseline.
+type CPUSchnorrBatchBackend struct {
+	Workers int
+}
+
+// VerifySchnorrJobs implements SchnorrBatchBackend
+func (b *CPUSchnorrBatchBackend) VerifySchnorrJobs(jobs []SchnorrBatchJob, valid []bool) {
+	n := len(jobs)
+	if n == 0 {
+		return
+	}
+	workers := b.Workers
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+	per := (n + workers - 1) / workers
+	per = (per + backendBatchChunk - 1) / backendBatchChunk * backendBatchChunk
+	parallelRanges(n, per, func(lo, hi int) {
+		var res [backendBatchChunk]GroupElementJacobian
+		var aff [backendBatchChunk]GroupElementAffine
+		var rx [backendBatchChunk]FieldElement
+		var bad [backendBatchChunk]bool
+		for clo := lo; clo < hi; clo += backendBatchChunk {
+			m := min(hi-clo, backendBatchChunk)
+			for j := 0; j < m; j++ {
+				bad[j] = !schnorrBatchJobMul(&res[j], &rx[j], &jobs[clo+j])
+				if bad[j] {
+					res[j].setInfinity()
+				}
+			}
+			geSetAllGEJVar(aff[:m], res[:m])
+			for j := 0; j < m; j++ {
+				r := &aff[j]
+				ok := !bad[j] && !r.isInfinity()
+				if ok {
+					r.y.normalize()
+					r.x.normalize()
+					ok = !r.y.isOdd() && r.x.equal(&rx[j])
+				}
+				valid[clo+j] = ok
+			}
+		}
+	})
+}
+
+// schnorrBatchJobMul parses job, sets rx to its R and r = S*G - E*P, and
+// reports whether the job is well formed
+func schnorrBatchJobMul(r *GroupElementJacobian, rx *FieldElement, job *SchnorrBatchJob) bool {
+	var s, e Scalar
+	var px, py FieldElement
+	var p GroupElementAffine
+	if !rx.setB32Limit(job.R[:]) || s.setB32(job.S[:]) || e.setB32(job.E[:]) {
+		return false
+	}
+	if !px.setB32Limit(job.P[:32]) || !py.setB32Limit(job.P[32:]) {
+		return false
+	}
+	p.setXY(&px, &py)
+	if !p.isValid() {
+		return false
+	}
+	var pj GroupElementJacobian
+	pj.setGE(&p)
+	e.negate(&e)
+	ecmultStrauss(r, &pj, &e, &s)
+	return true
+}
+
+// ContextSetSchnorrBatchBackend makes SchnorrVerifyBatch of ctx hand the
+// multiplications of its batches to backend, one job per signature, instead
+// of checking them with one multi-scalar multiplication. Every signature is
+// checked on its own, so failed is exact without a second pass. A nil
+// backend restores the default. Clones made afterwards share the backend.
+func ContextSetSchnorrBatchBackend(ctx *Context, backend SchnorrBatchBackend) error {
+	if !ctx.canVerify() {
+		return errors.New("context cannot verify")
+	}
+	ctx.batchBackend = backend
+	return nil
+}
+
+// schnorrVerifyBatchWith is schnorrVerifyBatch through backend, or the
+// multi-scalar multiplication if backend is nil
+func schnorrVerifyBatchWith(scratch *Scratch, backend SchnorrBatchBackend, sigs [][]byte, msgs [][]byte, pubkeys []*XOnlyPubkey) (valid bool, failed []int) {
+	if backend == nil {
+		return schnorrVerifyBatch(scratch, sigs, msgs, pubkeys, nil)
+	}
+	n := len(sigs)
+	if len(msgs) != n || len(pubkeys) != n {
+		return false, nil
+	}
+	if n == 0 {
+		return true, nil
+	}
+
+	cp := scratch.Checkpoint()
+	defer scratch.Rollback(cp)
+
+	// Parse the signatures and decompress the keys, collecting the inputs
+	// of the challenges to hash them as one batch
+	entries := scratch.ints.alloc(n)[:0]
+	r32s := scratch.bytes.alloc(n)[:0]
+	pk32s := scratch.bytes.alloc(n)[:0]
+	msgs32 := scratch.bytes.alloc(n)[:0]
+	jobs := make([]SchnorrBatchJob, n)
+	for i := 0; i < n; i++ {
+		sig, msg, pk := sigs[i], msgs[i], pubkeys[i]
+		if len(sig) != 64 || len(msg) != 32 || pk == nil {
+			failed = append(failed, i)
+			continue
+		}
+		var rx FieldElement
+		var s Scalar
+		var p GroupElementAffine
+		if !rx.setB32Limit(sig[:32]) || s.setB32(sig[32:]) || !xonlyPubkeyLoad(&p, &pk.data) {
+			failed = append(failed, i)
+			continue
+		}
+		job := &jobs[len(entries)]
+		copy(job.R[:], sig[:32])
+		copy(job.S[:], sig[32:])
+		p.x.normalize()
+		p.y.normalize()
+		p.x.getB32(job.P[:32])
+		p.y.getB32(job.P[32:])
+
+		r32s = append(r32s, sig[:32])
+		pk32s = append(pk32s, pk.data[:])
+		msgs32 = append(msgs32, msg)
+		entries = append(entries, i)
+	}
+	m := len(entries)
+	if m == 0 {
+		return false, failed
+	}
+	jobs = jobs[:m]
+
+	// e_k = int(hash_BIP0340/challenge(r || P || m)) mod n
+	challenges := scratch.scalars.alloc(m)
+	bip340ChallengeBatch(challenges, r32s, pk32s, msgs32)
+	for k := range jobs {
+		challenges[k].getB32(jobs[k].E[:])
+	}
+
+	ok := make([]bool, m)
+	backend.VerifySchnorrJobs(jobs, ok)
+	unsorted := len(failed) > 0
+	for k, i := range entries {
+		if !ok[k] {
+			failed = append(failed, i)
+		}
+	}
+	if unsorted {
+		sort.Ints(failed)
+	}
+	return len(failed) == 0, failed
+}
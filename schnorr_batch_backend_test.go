@@ -0,0 +1,129 @@
+package p256k1
+
+import (
+	"fmt"
+	"sync/atomic"
+	"testing"
+)
+
+// countingBackend passes jobs on to a CPUSchnorrBatchBackend, counting them
+type countingBackend struct {
+	CPUSchnorrBatchBackend
+	jobs atomic.Int64
+}
+
+func (b *countingBackend) VerifySchnorrJobs(jobs []SchnorrBatchJob, valid []bool) {
+	b.jobs.Add(int64(len(jobs)))
+	b.CPUSchnorrBatchBackend.VerifySchnorrJobs(jobs, valid)
+}
+
+func TestSchnorrBatchBackend(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 2*backendBatchChunk+5)
+
+	// Wrong message, wrong key, corrupted s, a malformed entry
+	msgs[3] = append([]byte(nil), msgs[3]...)
+	msgs[3][0] ^= 1
+	pubkeys[5] = pubkeys[6]
+	sigs[200] = append([]byte(nil), sigs[200]...)
+	sigs[200][63] ^= 1
+	sigs[14] = sigs[14][:63]
+	want := []int{3, 5, 14, 200}
+
+	for _, workers := range []int{0, 1, 3} {
+		backend := &countingBackend{CPUSchnorrBatchBackend: CPUSchnorrBatchBackend{Workers: workers}}
+		ctx := ContextCreate(ContextVerify)
+		if err := ContextSetSchnorrBatchBackend(ctx, backend); err != nil {
+			t.Fatal(err)
+		}
+		valid, failed := ctx.SchnorrVerifyBatch(sigs, msgs, pubkeys)
+		if valid || fmt.Sprint(failed) != fmt.Sprint(want) {
+			t.Errorf("workers=%d: valid = %v, failed = %v, want %v", workers, valid, failed, want)
+		}
+		if got := backend.jobs.Load(); got != int64(len(sigs)-1) {
+			t.Errorf("workers=%d: backend got %d jobs, want %d", workers, got, len(sigs)-1)
+		}
+		if valid, failed := ContextClone(ctx).SchnorrVerifyBatch(sigs[20:40], msgs[20:40], pubkeys[20:40]); !valid || failed != nil {
+			t.Errorf("workers=%d: valid batch rejected, failed = %v", workers, failed)
+		}
+		ContextDestroy(ctx)
+	}
+
+	// With a verification cache only the misses reach the backend
+	backend := &countingBackend{}
+	ctx := ContextCreate(ContextVerify)
+	defer ContextDestroy(ctx)
+	ContextSetSchnorrBatchBackend(ctx, backend)
+	ContextSetVerifyCache(ctx, NewVerifyCache(4096))
+	ctx.SchnorrVerifyBatch(sigs, msgs, pubkeys)
+	backend.jobs.Store(0)
+	if valid, failed := ctx.SchnorrVerifyBatch(sigs, msgs, pubkeys); valid || fmt.Sprint(failed) != fmt.Sprint(want) {
+		t.Errorf("cached: valid = %v, failed = %v, want %v", valid, failed, want)
+	}
+	if got := backend.jobs.Load(); got != 3 {
+		t.Errorf("cached: backend got %d jobs, want the 3 invalid ones", got)
+	}
+
+	if err := ContextSetSchnorrBatchBackend(ContextCreate(ContextSign), backend); err == nil {
+		t.Error("signing-only context should not accept a batch backend")
+	}
+}
+
+func TestCPUSchnorrBatchBackendJobs(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 1)
+	var p GroupElementAffine
+	if !xonlyPubkeyLoad(&p, &pubkeys[0].data) {
+		t.Fatal("failed to load public key")
+	}
+	var e Scalar
+	bip340Challenge(&e, sigs[0][:32], pubkeys[0].data[:], msgs[0])
+
+	var job SchnorrBatchJob
+	copy(job.R[:], sigs[0][:32])
+	copy(job.S[:], sigs[0][32:])
+	p.x.normalize()
+	p.y.normalize()
+	p.x.getB32(job.P[:32])
+	p.y.getB32(job.P[32:])
+	e.getB32(job.E[:])
+
+	// The job itself, then with s above the order, P off the curve and the
+	// odd point -P
+	jobs := []SchnorrBatchJob{job, job, job, job}
+	for i := range jobs[1].S {
+		jobs[1].S[i] = 0xff
+	}
+	jobs[2].P[63] ^= 1
+	var y FieldElement
+	y.negate(&p.y, 1)
+	y.normalize()
+	y.getB32(jobs[3].P[32:])
+
+	valid := make([]bool, len(jobs))
+	new(CPUSchnorrBatchBackend).VerifySchnorrJobs(jobs, valid)
+	if fmt.Sprint(valid) != "[true false false false]" {
+		t.Errorf("valid = %v", valid)
+	}
+}
+
+// BenchmarkSchnorrBatchBackend measures the throughput of a large batch with
+// the multi-scalar multiplication and with the CPU backend, for comparison
+// with accelerator backends
+func BenchmarkSchnorrBatchBackend(b *testing.B) {
+	const n = 4096
+	sigs, msgs, pubkeys := makeSchnorrBatch(b, n)
+	run := func(b *testing.B, backend SchnorrBatchBackend) {
+		ctx := ContextCreate(ContextVerify)
+		defer ContextDestroy(ctx)
+		ContextSetSchnorrBatchBackend(ctx, backend)
+		b.ResetTimer()
+		for i := 0; i < b.N; i++ {
+			if valid, _ := ctx.SchnorrVerifyBatch(sigs, msgs, pubkeys); !valid {
+				b.Fatal("batch verification failed")
+			}
+		}
+		b.ReportMetric(float64(n*b.N)/b.Elapsed().Seconds(), "sigs/s")
+	}
+	b.Run("msm", func(b *testing.B) { run(b, nil) })
+	b.Run("cpu", func(b *testing.B) { run(b, &CPUSchnorrBatchBackend{}) })
+	b.Run("cpu/1worker", func(b *testing.B) { run(b, &CPUSchnorrBatchBackend{Workers: 1}) })
+}
@@ -0,0 +1,169 @@
+package p256k1
+
+import (
+	"crypto/rand"
+	"fmt"
+	"testing"
+)
+
+// makeSchnorrBatch signs n random messages with n fresh keys
+func makeSchnorrBatch(tb testing.TB, n int) (sigs, msgs [][]byte, pubkeys []*XOnlyPubkey) {
+	sigs = make([][]byte, n)
+	msgs = make([][]byte, n)
+	pubkeys = make([]*XOnlyPubkey, n)
+	for i := 0; i < n; i++ {
+		kp, err := KeyPairGenerate()
+		if err != nil {
+			tb.Fatalf("failed to generate keypair: %v", err)
+		}
+		xonly, err := kp.XOnlyPubkey()
+		if err != nil {
+			tb.Fatalf("failed to get x-only pubkey: %v", err)
+		}
+		msg := make([]byte, 32)
+		if _, err := rand.Read(msg); err != nil {
+			tb.Fatal(err)
+		}
+		sig := make([]byte, 64)
+		if err := SchnorrSign(sig, msg, kp, nil); err != nil {
+			tb.Fatalf("failed to sign: %v", err)
+		}
+		kp.Clear()
+		sigs[i], msgs[i], pubkeys[i] = sig, msg, xonly
+	}
+	return
+}
+
+func TestSchnorrVerifyBatch(t *testing.T) {
+	for _, n := range []int{1, 2, 7, 33} {
+		sigs, msgs, pubkeys := makeSchnorrBatch(t, n)
+		valid, failed := SchnorrVerifyBatch(sigs, msgs, pubkeys)
+		if !valid || failed != nil {
+			t.Errorf("n=%d: valid batch rejected (failed=%v)", n, failed)
+		}
+	}
+
+	valid, failed := SchnorrVerifyBatch(nil, nil, nil)
+	if !valid || failed != nil {
+		t.Error("empty batch should be valid")
+	}
+}
+
+func TestSchnorrVerifyBatchInvalid(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 16)
+
+	// Wrong message, wrong key, corrupted s, r not on the curve (x = p)
+	msgs[3] = append([]byte(nil), msgs[3]...)
+	msgs[3][0] ^= 1
+	pubkeys[5] = pubkeys[6]
+	sigs[9] = append([]byte(nil), sigs[9]...)
+	sigs[9][63] ^= 1
+	sigs[12] = append([]byte(nil), sigs[12]...)
+	for i := 0; i < 32; i++ {
+		sigs[12][i] = 0xff
+	}
+	sigs[12][27] = 0xfe
+	sigs[12][28] = 0xff
+	sigs[12][29] = 0xfc
+	sigs[12][30] = 0x2f
+	sigs[12][31] = 0x2f
+	// A malformed entry
+	sigs[14] = sigs[14][:63]
+
+	valid, failed := SchnorrVerifyBatch(sigs, msgs, pubkeys)
+	if valid {
+		t.Fatal("invalid batch accepted")
+	}
+	want := []int{3, 5, 9, 12, 14}
+	if fmt.Sprint(failed) != fmt.Sprint(want) {
+		t.Errorf("failed = %v, want %v", failed, want)
+	}
+	for _, i := range failed {
+		if SchnorrVerify(sigs[i], msgs[i], pubkeys[i]) {
+			t.Errorf("index %d reported as failed but verifies", i)
+		}
+	}
+
+	if valid, failed := SchnorrVerifyBatch(sigs, msgs[:3], pubkeys); valid || failed != nil {
+		t.Error("mismatched lengths should be rejected")
+	}
+}
+
+func TestBIP340ChallengeBatch(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 9)
+	r32s := make([][]byte, len(sigs))
+	pk32s := make([][]byte, len(sigs))
+	for i := range sigs {
+		r32s[i] = sigs[i][:32]
+		pk32s[i] = pubkeys[i].data[:]
+	}
+	// A message that is not 32 bytes crosses the staging buffer boundary
+	msgs[3] = make([]byte, 100)
+
+	e := make([]Scalar, len(sigs))
+	bip340ChallengeBatch(e, r32s, pk32s, msgs)
+	for i := range e {
+		var input []byte
+		input = append(input, r32s[i]...)
+		input = append(input, pk32s[i]...)
+		input = append(input, msgs[i]...)
+		h := TaggedHash(bip340ChallengeTag, input)
+		var want, single Scalar
+		want.setB32(h[:])
+		bip340Challenge(&single, r32s[i], pk32s[i], msgs[i])
+		if !e[i].equal(&want) || !single.equal(&want) {
+			t.Fatalf("challenge %d does not match TaggedHash", i)
+		}
+	}
+}
+
+func BenchmarkBIP340Challenge(b *testing.B) {
+	const n = 64
+	sigs, msgs, pubkeys := makeSchnorrBatch(b, n)
+	r32s := make([][]byte, n)
+	pk32s := make([][]byte, n)
+	for i := range sigs {
+		r32s[i] = sigs[i][:32]
+		pk32s[i] = pubkeys[i].data[:]
+	}
+	e := make([]Scalar, n)
+
+	b.Run("batch", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			bip340ChallengeBatch(e, r32s, pk32s, msgs)
+		}
+	})
+	b.Run("single", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			for j := 0; j < n; j++ {
+				bip340Challenge(&e[j], r32s[j], pk32s[j], msgs[j])
+			}
+		}
+	})
+}
+
+func BenchmarkSchnorrVerifyBatch(b *testing.B) {
+	for _, n := range []int{1, 8, 64, 256} {
+		sigs, msgs, pubkeys := makeSchnorrBatch(b, n)
+		b.Run(fmt.Sprintf("n=%d", n), func(b *testing.B) {
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				if valid, _ := SchnorrVerifyBatch(sigs, msgs, pubkeys); !valid {
+					b.Fatal("batch verification failed")
+				}
+			}
+		})
+		b.Run(fmt.Sprintf("n=%d/individual", n), func(b *testing.B) {
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				for j := 0; j < n; j++ {
+					if !SchnorrVerify(sigs[j], msgs[j], pubkeys[j]) {
+						b.Fatal("verification failed")
+					}
+				}
+			}
+		})
+	}
+}
@@ -0,0 +1,134 @@
+package p256k1
+
+import (
+	"errors"
+	"runtime"
+	"sync"
+	"unsafe"
+)
+
+// schnorrSignBatchChunk is the number of nonce points converted to affine
+// with one inversion
+const schnorrSignBatchChunk = 64
+
+// SchnorrSignBatch signs msgs[i] into sigs[i] with keypair, producing the
+// same signatures as SchnorrSign with auxRands[i]. auxRands may be nil for
+// no auxiliary randomness. The key is loaded and its parity fixed once for
+// the whole batch, and the nonce points are converted to affine with one
+// field inversion per chunk of schnorrSignBatchChunk messages.
+func SchnorrSignBatch(keypair *KeyPair, msgs [][]byte, auxRands [][]byte, sigs [][]byte) error {
+	return SchnorrSignBatchParallel(keypair, msgs, auxRands, sigs, 1)
+}
+
+// SchnorrSignBatchParallel is SchnorrSignBatch split over workers
+// goroutines, or GOMAXPROCS goroutines if workers <= 0
+func SchnorrSignBatchParallel(keypair *KeyPair, msgs [][]byte, auxRands [][]byte, sigs [][]byte, workers int) error {
+	if keypair == nil {
+		return errors.New("keypair cannot be nil")
+	}
+	if len(sigs) != len(msgs) || (auxRands != nil && len(auxRands) != len(msgs)) {
+		return errors.New("msgs, auxRands and sigs must have the same length")
+	}
+	for i := range msgs {
+		if len(sigs[i]) != 64 {
+			return errors.New("signature must be 64 bytes")
+		}
+		if len(msgs[i]) != 32 {
+			return errors.New("message must be 32 bytes")
+		}
+	}
+
+	var sk Scalar
+	var pkX [32]byte
+	if err := schnorrKeypairLoad(&sk, &pkX, keypair); err != nil {
+		return err
+	}
+	defer sk.clear()
+	gen := getGlobalGenContext()
+
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+	// Keep whole chunks per worker so every inversion is shared as widely
+	// as possible
+	per := (len(msgs) + workers - 1) / workers
+	per = (per + schnorrSignBatchChunk - 1) / schnorrSignBatchChunk * schnorrSignBatchChunk
+	if per >= len(msgs) {
+		return schnorrSignBatch(gen, &sk, &pkX, msgs, auxRands, sigs)
+	}
+
+	var wg sync.WaitGroup
+	var errOnce sync.Once
+	var firstErr error
+	for lo := 0; lo < len(msgs); lo += per {
+		hi := lo + per
+		if hi > len(msgs) {
+			hi = len(msgs)
+		}
+		var aux [][]byte
+		if auxRands != nil {
+			aux = auxRands[lo:hi]
+		}
+		wg.Add(1)
+		go func(msgs, aux, sigs [][]byte) {
+			defer wg.Done()
+			if err := schnorrSignBatch(gen, &sk, &pkX, msgs, aux, sigs); err != nil {
+				errOnce.Do(func() { firstErr = err })
+			}
+		}(msgs[lo:hi], aux, sigs[lo:hi])
+	}
+	wg.Wait()
+	return firstErr
+}
+
+// schnorrSignBatch signs a batch with the loaded key sk, whose public key
+// has even y and x coordinate pkX
+func schnorrSignBatch(gen *EcmultGenContext, sk *Scalar, pkX *[32]byte, msgs [][]byte, auxRands [][]byte, sigs [][]byte) error {
+	var skBytes, nonce32, r32 [32]byte
+	var ks [schnorrSignBatchChunk]Scalar
+	var rj [schnorrSignBatchChunk]GroupElementJacobian
+	var r [schnorrSignBatchChunk]GroupElementAffine
+	sk.getB32(skBytes[:])
+	defer func() {
+		memclear(unsafe.Pointer(&skBytes[0]), 32)
+		memclear(unsafe.Pointer(&nonce32[0]), 32)
+		memclear(unsafe.Pointer(&ks[0]), unsafe.Sizeof(ks))
+		memclear(unsafe.Pointer(&rj[0]), unsafe.Sizeof(rj))
+		memclear(unsafe.Pointer(&r[0]), unsafe.Sizeof(r))
+	}()
+
+	for lo := 0; lo < len(msgs); lo += schnorrSignBatchChunk {
+		n := len(msgs) - lo
+		if n > schnorrSignBatchChunk {
+			n = schnorrSignBatchChunk
+		}
+
+		for i := 0; i < n; i++ {
+			var aux []byte
+			if auxRands != nil {
+				aux = auxRands[lo+i]
+			}
+			if err := NonceFunctionBIP340(nonce32[:], msgs[lo+i], skBytes[:], pkX[:], aux); err != nil {
+				return err
+			}
+			if !ks[i].setB32Seckey(nonce32[:]) {
+				return errors.New("nonce generation failed")
+			}
+			gen.ecmultGen(&rj[i], &ks[i])
+		}
+
+		// The nonce points are secret until signed, so the shared inversion
+		// is the constant time one
+		geSetAllGEJ(r[:n], rj[:n])
+		for i := 0; i < n; i++ {
+			r[i].y.normalize()
+			if r[i].y.isOdd() {
+				ks[i].negate(&ks[i])
+			}
+			r[i].x.normalize()
+			r[i].x.getB32(r32[:])
+			schnorrSignFinish(sigs[lo+i], msgs[lo+i], sk, pkX, &ks[i], &r32)
+		}
+	}
+	return nil
+}
@@ -0,0 +1,110 @@
+package p256k1
+
+import (
+	"bytes"
+	"crypto/rand"
+	"fmt"
+	"testing"
+)
+
+// makeSignBatch returns n random messages and auxiliary random values with
+// room for their signatures
+func makeSignBatch(tb testing.TB, n int) (msgs, auxRands, sigs [][]byte) {
+	msgs = make([][]byte, n)
+	auxRands = make([][]byte, n)
+	sigs = make([][]byte, n)
+	for i := range msgs {
+		msgs[i] = make([]byte, 32)
+		auxRands[i] = make([]byte, 32)
+		sigs[i] = make([]byte, 64)
+		if _, err := rand.Read(msgs[i]); err != nil {
+			tb.Fatal(err)
+		}
+		if _, err := rand.Read(auxRands[i]); err != nil {
+			tb.Fatal(err)
+		}
+	}
+	return msgs, auxRands, sigs
+}
+
+func TestSchnorrSignBatch(t *testing.T) {
+	keypair, err := KeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	msgs, auxRands, sigs := makeSignBatch(t, 2*schnorrSignBatchChunk+5)
+	want := make([]byte, 64)
+
+	for _, workers := range []int{1, 3, 0} {
+		for _, aux := range [][][]byte{auxRands, nil} {
+			if err := SchnorrSignBatchParallel(keypair, msgs, aux, sigs, workers); err != nil {
+				t.Fatal(err)
+			}
+			for i := range msgs {
+				var a []byte
+				if aux != nil {
+					a = aux[i]
+				}
+				if err := SchnorrSign(want, msgs[i], keypair, a); err != nil {
+					t.Fatal(err)
+				}
+				if !bytes.Equal(sigs[i], want) {
+					t.Fatalf("workers=%d: signature %d differs from SchnorrSign", workers, i)
+				}
+			}
+		}
+	}
+
+	if err := SchnorrSignBatch(keypair, msgs, auxRands[1:], sigs); err == nil {
+		t.Error("mismatched lengths accepted")
+	}
+	sigs[3] = sigs[3][:63]
+	if err := SchnorrSignBatch(keypair, msgs, nil, sigs); err == nil {
+		t.Error("short signature buffer accepted")
+	}
+	if err := SchnorrSignBatch(keypair, nil, nil, nil); err != nil {
+		t.Errorf("empty batch: %v", err)
+	}
+}
+
+func TestGeSetAllGEJ(t *testing.T) {
+	var a [5]GroupElementJacobian
+	var want, got [5]GroupElementAffine
+	for i := range a {
+		k := randomScalar(t)
+		EcmultGen(&a[i], &k)
+	}
+	geSetAllGEJVar(want[:], a[:])
+	geSetAllGEJ(got[:], a[:])
+	for i := range a {
+		if !got[i].equal(&want[i]) {
+			t.Fatalf("point %d differs from geSetAllGEJVar", i)
+		}
+	}
+}
+
+func BenchmarkSchnorrSignBatch(b *testing.B) {
+	keypair, err := KeyPairGenerate()
+	if err != nil {
+		b.Fatal(err)
+	}
+	for _, n := range []int{16, 256} {
+		msgs, auxRands, sigs := makeSignBatch(b, n)
+		b.Run(fmt.Sprintf("n=%d/SchnorrSign", n), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				for j := range msgs {
+					if err := SchnorrSign(sigs[j], msgs[j], keypair, auxRands[j]); err != nil {
+						b.Fatal(err)
+					}
+				}
+			}
+		})
+		b.Run(fmt.Sprintf("n=%d/SchnorrSignBatch", n), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				if err := SchnorrSignBatch(keypair, msgs, auxRands, sigs); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
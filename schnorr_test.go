@@ -237,6 +237,57 @@ func TestSchnorrMultipleSignatures(t *testing.T) {
 	}
 }
 
+func TestSchnorrSignInto(t *testing.T) {
+	kp, err := KeyPairGenerate()
+	if err != nil {
+		t.Fatalf("failed to generate keypair: %v", err)
+	}
+	defer kp.Clear()
+
+	xonly, err := kp.XOnlyPubkey()
+	if err != nil {
+		t.Fatalf("failed to get x-only pubkey: %v", err)
+	}
+
+	msg := make([]byte, 32)
+	aux := make([]byte, 32)
+	for i := range msg {
+		msg[i] = byte(i)
+		aux[i] = byte(3 * i)
+	}
+
+	for _, auxRand := range [][]byte{nil, aux} {
+		sig := make([]byte, 64)
+		if err := SchnorrSign(sig, msg, kp, auxRand); err != nil {
+			t.Fatalf("SchnorrSign failed: %v", err)
+		}
+		var sigInto SchnorrSignature
+		if err := SchnorrSignInto(&sigInto, msg, kp, auxRand); err != nil {
+			t.Fatalf("SchnorrSignInto failed: %v", err)
+		}
+		if string(sig) != string(sigInto[:]) {
+			t.Error("SchnorrSignInto and SchnorrSign produced different signatures")
+		}
+		if !SchnorrVerify(sigInto[:], msg, xonly) {
+			t.Error("SchnorrSignInto signature does not verify")
+		}
+	}
+
+	// Guard against allocations creeping back into the signing path
+	if raceEnabled {
+		return
+	}
+	var sig SchnorrSignature
+	allocs := testing.AllocsPerRun(100, func() {
+		if err := SchnorrSignInto(&sig, msg, kp, aux); err != nil {
+			t.Fatal(err)
+		}
+	})
+	if allocs != 0 {
+		t.Errorf("SchnorrSignInto allocated %v times per run, want 0", allocs)
+	}
+}
+
 func BenchmarkSchnorrVerify(b *testing.B) {
 	// Generate test data once outside the benchmark loop
 	kp, err := KeyPairGenerate()
@@ -265,14 +316,74 @@ func BenchmarkSchnorrVerify(b *testing.B) {
 	copy(secpXonly.data[:], xonly.data[:])
 
 	// Benchmark verification with pre-computed values
-	b.ResetTimer()
-	b.ReportAllocs()
-
-	ctx := getSchnorrVerifyContext()
-	for i := 0; i < b.N; i++ {
-		result := secp256k1_schnorrsig_verify(ctx, sig, msg, 32, &secpXonly)
-		if result == 0 {
-			b.Fatal("verification failed")
+	b.Run("secp256k1_schnorrsig_verify", func(b *testing.B) {
+		b.ReportAllocs()
+		ctx := getSchnorrVerifyContext()
+		for i := 0; i < b.N; i++ {
+			result := secp256k1_schnorrsig_verify(ctx, sig, msg, 32, &secpXonly)
+			if result == 0 {
+				b.Fatal("verification failed")
+			}
+		}
+	})
+	b.Run("SchnorrVerify", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if !SchnorrVerify(sig, msg, xonly) {
+				b.Fatal("verification failed")
+			}
 		}
+	})
+
+	// The double multiplication alone, as a floor for the pipeline: the gap
+	// to SchnorrVerify is input decoding, hashing and the final comparison
+	var pk GroupElementAffine
+	var pkj, rj GroupElementJacobian
+	var s, e Scalar
+	pk.x.setB32(xonly.data[:])
+	pk.setXOVar(&pk.x, false)
+	pkj.setGE(&pk)
+	s.setB32(sig[32:])
+	bip340Challenge(&e, sig[:32], xonly.data[:], msg)
+	e.negate(&e)
+	b.Run("ecmult", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			ecmultStrauss(&rj, &pkj, &e, &s)
+		}
+	})
+}
+
+func BenchmarkSchnorrSign(b *testing.B) {
+	kp, err := KeyPairGenerate()
+	if err != nil {
+		b.Fatalf("failed to generate keypair: %v", err)
+	}
+	defer kp.Clear()
+
+	msg := make([]byte, 32)
+	aux := make([]byte, 32)
+	for i := range msg {
+		msg[i] = byte(i)
+		aux[i] = byte(255 - i)
 	}
+
+	b.Run("SchnorrSign", func(b *testing.B) {
+		sig := make([]byte, 64)
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if err := SchnorrSign(sig, msg, kp, aux); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
+	b.Run("SchnorrSignInto", func(b *testing.B) {
+		var sig SchnorrSignature
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			if err := SchnorrSignInto(&sig, msg, kp, aux); err != nil {
+				b.Fatal(err)
+			}
+		}
+	})
 }
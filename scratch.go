@@ -0,0 +1,101 @@
+package p256k1
+
+import "sync"
+
+// Scratch is a reusable arena for the temporaries of the batch and
+// multi-scalar operations, after secp256k1_scratch in src/scratch_impl.h.
+// Memory is handed out by bump allocation from one backing array per element
+// type. Checkpoint records the current allocation mark and Rollback returns
+// everything allocated since, so one long-lived Scratch serves any number of
+// calls. A warm Scratch performs no heap allocations; if a request does not
+// fit, the backing array is replaced by a larger one and slices handed out
+// earlier stay valid.
+//
+// The zero value is ready to use, and the methods of a nil *Scratch fall
+// back to a pooled one. A Scratch must not be used concurrently.
+type Scratch struct {
+	ints     scratchArena[int]
+	scalars  scratchArena[Scalar]
+	fields   scratchArena[FieldElement]
+	affine   scratchArena[GroupElementAffine]
+	jacobian scratchArena[GroupElementJacobian]
+	strauss  scratchArena[straussPointState]
+	bytes    scratchArena[[]byte]
+	xonly    scratchArena[*XOnlyPubkey]
+
+	// tables are the generator tables of the owning context, nil for the
+	// global ones
+	tables *ecmultTables
+}
+
+// ScratchCheckpoint is an allocation mark of a Scratch
+type ScratchCheckpoint struct {
+	ints, scalars, fields, affine, jacobian, strauss, bytes, xonly int
+}
+
+// NewScratch returns an empty Scratch
+func NewScratch() *Scratch {
+	return &Scratch{}
+}
+
+// Checkpoint returns the current allocation mark, as
+// secp256k1_scratch_checkpoint
+func (s *Scratch) Checkpoint() ScratchCheckpoint {
+	return ScratchCheckpoint{
+		ints:     s.ints.used,
+		scalars:  s.scalars.used,
+		fields:   s.fields.used,
+		affine:   s.affine.used,
+		jacobian: s.jacobian.used,
+		strauss:  s.strauss.used,
+		bytes:    s.bytes.used,
+		xonly:    s.xonly.used,
+	}
+}
+
+// Rollback releases everything allocated since cp was taken, as
+// secp256k1_scratch_apply_checkpoint. Slices allocated after cp must not be
+// used afterwards. It panics if cp is newer than the current mark.
+func (s *Scratch) Rollback(cp ScratchCheckpoint) {
+	s.ints.rollback(cp.ints)
+	s.scalars.rollback(cp.scalars)
+	s.fields.rollback(cp.fields)
+	s.affine.rollback(cp.affine)
+	s.jacobian.rollback(cp.jacobian)
+	s.strauss.rollback(cp.strauss)
+	s.bytes.rollback(cp.bytes)
+	s.xonly.rollback(cp.xonly)
+}
+
+// scratchPool supplies a Scratch to the calls that are not given one
+var scratchPool = sync.Pool{
+	New: func() interface{} { return new(Scratch) },
+}
+
+// scratchArena is the bump allocator for one element type
+type scratchArena[T any] struct {
+	buf  []T
+	used int
+}
+
+// alloc returns n zeroed elements
+func (a *scratchArena[T]) alloc(n int) []T {
+	if a.used+n > len(a.buf) {
+		size := 2 * len(a.buf)
+		if size < a.used+n {
+			size = a.used + n
+		}
+		a.buf = make([]T, size)
+	}
+	r := a.buf[a.used : a.used+n : a.used+n]
+	a.used += n
+	clear(r)
+	return r
+}
+
+func (a *scratchArena[T]) rollback(mark int) {
+	if mark > a.used {
+		panic("invalid scratch checkpoint")
+	}
+	a.used = mark
+}
@@ -0,0 +1,86 @@
+package p256k1
+
+import (
+	"testing"
+)
+
+func TestScratchCheckpoint(t *testing.T) {
+	s := NewScratch()
+
+	a := s.scalars.alloc(4)
+	a[0].setInt(7)
+	cp := s.Checkpoint()
+	b := s.scalars.alloc(8)
+	for i := range b {
+		b[i].setInt(uint(i + 1))
+	}
+	if &b[0] == &a[0] || cap(a) != 4 {
+		t.Fatal("allocations overlap")
+	}
+
+	// Memory handed out again after a rollback is zeroed
+	s.Rollback(cp)
+	c := s.scalars.alloc(8)
+	for i := range c {
+		if !c[i].isZero() {
+			t.Fatalf("reused element %d is not zero", i)
+		}
+	}
+	if a[0].d[0] != 7 {
+		t.Error("rollback clobbered memory allocated before the checkpoint")
+	}
+
+	// Growing keeps earlier slices valid
+	big := s.scalars.alloc(1000)
+	big[999].setInt(1)
+	if a[0].d[0] != 7 {
+		t.Error("growing clobbered an earlier allocation")
+	}
+
+	s.Rollback(ScratchCheckpoint{})
+	if s.Checkpoint() != (ScratchCheckpoint{}) {
+		t.Error("rollback to the empty checkpoint did not release everything")
+	}
+
+	defer func() {
+		if recover() == nil {
+			t.Error("rollback to a newer checkpoint should panic")
+		}
+	}()
+	s.Rollback(ScratchCheckpoint{ints: 1})
+}
+
+func TestScratchReuse(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 16)
+	s := NewScratch()
+
+	if valid, failed := s.SchnorrVerifyBatch(sigs, msgs, pubkeys); !valid || failed != nil {
+		t.Fatalf("valid batch rejected, failed = %v", failed)
+	}
+	if s.Checkpoint() != (ScratchCheckpoint{}) {
+		t.Error("SchnorrVerifyBatch did not release its temporaries")
+	}
+	if n := testing.AllocsPerRun(10, func() { s.SchnorrVerifyBatch(sigs, msgs, pubkeys) }); n != 0 {
+		t.Errorf("warm Scratch.SchnorrVerifyBatch: %v allocs, want 0", n)
+	}
+
+	points, scalars := makeEcmultMultiInput(t, 100)
+	ng := randomScalar(t)
+	var got, want GroupElementJacobian
+	if err := s.EcmultMulti(&got, points, scalars, &ng); err != nil {
+		t.Fatal(err)
+	}
+	ecmultMultiNaive(&want, points, scalars, &ng)
+	if !jacobianEqual(&got, &want) {
+		t.Error("Scratch.EcmultMulti does not match the naive sum")
+	}
+	if n := testing.AllocsPerRun(5, func() { s.EcmultMulti(&got, points, scalars, &ng) }); n != 0 {
+		t.Errorf("warm Scratch.EcmultMulti: %v allocs, want 0", n)
+	}
+
+	// A nil Scratch falls back to the pool
+	var none *Scratch
+	if valid, _ := none.SchnorrVerifyBatch(sigs, msgs, pubkeys); !valid {
+		t.Error("nil Scratch rejected a valid batch")
+	}
+}
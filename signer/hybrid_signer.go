@@ -0,0 +1,232 @@
+package signer
+
+import (
+	"errors"
+	"slices"
+
+	"p256k1.mleku.dev"
+)
+
+// HybridSigner implements I like P256K1Signer, but sends each operation to
+// whichever of the Go implementation and the C library of this repository
+// is faster for it. Measured on amd64 with AVX-512 IFMA, Go signs in 8.4 µs
+// against 14.5 µs and derives keys in 8.5 µs against 14.0 µs, while C
+// verifies in 29.4 µs against 37.8 µs and computes ECDH in 33.7 µs against
+// 39.0 µs. So Generate, InitSec, Sign and everything else run in Go, and
+// Verify and ECDH in C.
+//
+// The C library is only linked when building with cgo and -tags p256k1cgo;
+// it is compiled from ../src by cgo, so no separately built library is
+// needed. Otherwise, and always with -tags nocgo, every operation runs in
+// Go and a HybridSigner behaves exactly as a P256K1Signer.
+type HybridSigner struct {
+	P256K1Signer
+
+	// cPub is the public key parsed by the C library, when hybridCgo
+	cPub cXOnlyPubkey
+}
+
+// NewHybridSigner creates a new HybridSigner instance
+func NewHybridSigner() *HybridSigner {
+	return &HybridSigner{}
+}
+
+// Generate creates a fresh new key pair from system entropy, and ensures it
+// is even (so ECDH works)
+func (s *HybridSigner) Generate() error {
+	if err := s.P256K1Signer.Generate(); err != nil {
+		return err
+	}
+	return s.loadPub()
+}
+
+// InitSec initialises the secret (signing) key from the raw bytes, and also
+// derives the public key
+func (s *HybridSigner) InitSec(sec []byte) error {
+	if err := s.P256K1Signer.InitSec(sec); err != nil {
+		return err
+	}
+	return s.loadPub()
+}
+
+// InitPub initializes the public (verification) key from raw bytes, this is
+// expected to be an x-only 32 byte pubkey
+func (s *HybridSigner) InitPub(pub []byte) error {
+	if err := s.P256K1Signer.InitPub(pub); err != nil {
+		return err
+	}
+	return s.loadPub()
+}
+
+// loadPub parses the public key for the C library
+func (s *HybridSigner) loadPub() error {
+	if hybridCgo && !s.cPub.parse(s.pub[:]) {
+		return errors.New("C library rejected the public key")
+	}
+	return nil
+}
+
+// Verify checks a message hash and signature match the stored public key
+func (s *HybridSigner) Verify(msg, sig []byte) (valid bool, err error) {
+	if !hybridCgo {
+		return s.P256K1Signer.Verify(msg, sig)
+	}
+	if s.xonlyPub == nil {
+		return false, errors.New("no public key available for verification")
+	}
+
+	if len(msg) != 32 {
+		return false, errors.New("message must be 32 bytes")
+	}
+
+	if len(sig) != 64 {
+		return false, errors.New("signature must be 64 bytes")
+	}
+
+	return cSchnorrVerify(sig, msg, &s.cPub), nil
+}
+
+// ECDH returns the x coordinate of the shared point of the secret key and
+// the 32 byte x-only pub, as P256K1Signer.ECDH
+func (s *HybridSigner) ECDH(pub []byte) (secret []byte, err error) {
+	secret, err = s.ECDHInto(make([]byte, 0, 32), pub)
+	if err != nil {
+		return nil, err
+	}
+	return secret, nil
+}
+
+// ECDHInto appends the 32 byte shared secret of ECDH to dst and returns the
+// extended slice, as P256K1Signer.ECDHInto
+func (s *HybridSigner) ECDHInto(dst, pub []byte) (secret []byte, err error) {
+	if !hybridCgo {
+		return s.P256K1Signer.ECDHInto(dst, pub)
+	}
+	if !s.hasSecret || s.keypair == nil {
+		return dst, errors.New("no secret key available for ECDH")
+	}
+
+	if len(pub) != 32 {
+		return dst, errors.New("public key must be 32 bytes")
+	}
+
+	n := len(dst)
+	dst = slices.Grow(dst, 32)
+	if !cECDHX(dst[n:n+32], pub, s.keypair.Seckey()) {
+		return dst[:n], errors.New("invalid public key")
+	}
+	return dst[:n+32], nil
+}
+
+// Zero wipes the secret key to prevent memory leaks
+func (s *HybridSigner) Zero() {
+	s.P256K1Signer.Zero()
+	s.cPub = cXOnlyPubkey{}
+}
+
+// BatchVerifier checks many BIP-340 signatures by different keys at once.
+// With the C library each call into C checks cBatchChunk signatures with one
+// batch verification, so the cost of crossing the cgo boundary is shared by
+// the whole chunk; without it the keys are parsed with
+// p256k1.XOnlyPubkeyParseBatch and the signatures checked with
+// p256k1.Scratch.SchnorrVerifyBatch.
+//
+// The buffers are reused between calls. A BatchVerifier must not be used
+// concurrently, and Close must be called to release the memory held by the
+// C library.
+type BatchVerifier struct {
+	// Packed inputs for C, which must not be given Go pointers
+	sigs, msgs, pubs, ok []byte
+	idx                  []int
+	c                    cBatch
+
+	// Go path
+	scratch p256k1.Scratch
+	xonlys  []p256k1.XOnlyPubkey
+	pkPtrs  []*p256k1.XOnlyPubkey
+	goSigs  [][]byte
+	goMsgs  [][]byte
+
+	// Stand-ins for inputs of the wrong length
+	zeroSig [64]byte
+	zeroMsg [32]byte
+}
+
+// NewBatchVerifier returns an empty BatchVerifier
+func NewBatchVerifier() *BatchVerifier {
+	return &BatchVerifier{}
+}
+
+// Verify sets valid[i] to whether sigs[i] is a valid BIP-340 signature of
+// the 32 byte msgs[i] by the 32 byte x-only public key pubs[i]. Inputs of
+// the wrong length and keys that are not on the curve are invalid. All
+// slices must have the same length.
+func (v *BatchVerifier) Verify(sigs, msgs, pubs [][]byte, valid []bool) {
+	for start := 0; start < len(sigs); start += cBatchChunk {
+		end := min(start+cBatchChunk, len(sigs))
+		if hybridCgo {
+			v.verifyC(sigs[start:end], msgs[start:end], pubs[start:end], valid[start:end])
+		} else {
+			v.verifyGo(sigs[start:end], msgs[start:end], pubs[start:end], valid[start:end])
+		}
+	}
+}
+
+// verifyC is Verify for at most cBatchChunk signatures with one call into C
+func (v *BatchVerifier) verifyC(sigs, msgs, pubs [][]byte, valid []bool) {
+	v.sigs, v.msgs, v.pubs = v.sigs[:0], v.msgs[:0], v.pubs[:0]
+	v.idx = v.idx[:0]
+	for i := range sigs {
+		valid[i] = false
+		if len(sigs[i]) != 64 || len(msgs[i]) != 32 || len(pubs[i]) != 32 {
+			continue
+		}
+		v.sigs = append(v.sigs, sigs[i]...)
+		v.msgs = append(v.msgs, msgs[i]...)
+		v.pubs = append(v.pubs, pubs[i]...)
+		v.idx = append(v.idx, i)
+	}
+	v.ok = slices.Grow(v.ok[:0], len(v.idx))[:len(v.idx)]
+	v.c.verify(v.sigs, v.msgs, v.pubs, v.ok)
+	for j, i := range v.idx {
+		valid[i] = v.ok[j] == 1
+	}
+}
+
+// verifyGo is Verify for at most cBatchChunk signatures in Go
+func (v *BatchVerifier) verifyGo(sigs, msgs, pubs [][]byte, valid []bool) {
+	n := len(sigs)
+	if cap(v.xonlys) < n {
+		v.xonlys = make([]p256k1.XOnlyPubkey, cBatchChunk)
+		v.pkPtrs = make([]*p256k1.XOnlyPubkey, cBatchChunk)
+		v.goSigs = make([][]byte, cBatchChunk)
+		v.goMsgs = make([][]byte, cBatchChunk)
+	}
+	failed := p256k1.XOnlyPubkeyParseBatch(v.xonlys[:n], pubs)
+	for i := 0; i < n; i++ {
+		v.pkPtrs[i] = &v.xonlys[i]
+		v.goSigs[i] = sigs[i]
+		v.goMsgs[i] = msgs[i]
+		if len(sigs[i]) != 64 || len(msgs[i]) != 32 {
+			v.pkPtrs[i] = nil
+			v.goSigs[i] = v.zeroSig[:]
+			v.goMsgs[i] = v.zeroMsg[:]
+		}
+	}
+	// A nil key makes the batch reject the signature
+	for _, i := range failed {
+		v.pkPtrs[i] = nil
+	}
+	_, bad := v.scratch.SchnorrVerifyBatch(v.goSigs[:n], v.goMsgs[:n], v.pkPtrs[:n])
+	for i := range valid {
+		valid[i] = true
+	}
+	for _, i := range bad {
+		valid[i] = false
+	}
+}
+
+// Close releases the memory the C library holds for v
+func (v *BatchVerifier) Close() {
+	v.c.close()
+}
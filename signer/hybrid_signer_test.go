@@ -0,0 +1,110 @@
+package signer
+
+import (
+	"bytes"
+	"testing"
+)
+
+func TestHybridSigner(t *testing.T) {
+	s := NewHybridSigner()
+	if err := s.Generate(); err != nil {
+		t.Fatalf("Generate failed: %v", err)
+	}
+	defer s.Zero()
+	peer := NewP256K1Signer()
+	if err := peer.Generate(); err != nil {
+		t.Fatalf("Generate failed: %v", err)
+	}
+	var _ I = s
+
+	msg := make([]byte, 32)
+	msg[5] = 9
+	sig, err := s.Sign(msg)
+	if err != nil {
+		t.Fatalf("Sign failed: %v", err)
+	}
+	if valid, err := s.Verify(msg, sig); err != nil || !valid {
+		t.Error("signature should be valid")
+	}
+	sig[3] ^= 1
+	if valid, err := s.Verify(msg, sig); err != nil || valid {
+		t.Error("corrupted signature should be invalid")
+	}
+	if _, err := s.Verify(msg, sig[:63]); err == nil {
+		t.Error("short signature accepted")
+	}
+
+	secret, err := s.ECDH(peer.Pub())
+	if err != nil {
+		t.Fatalf("ECDH failed: %v", err)
+	}
+	want, err := peer.ECDH(s.Pub())
+	if err != nil {
+		t.Fatalf("ECDH failed: %v", err)
+	}
+	if !bytes.Equal(secret, want) {
+		t.Error("ECDH differs from P256K1Signer")
+	}
+	if _, err := s.ECDH(make([]byte, 32)); err == nil {
+		t.Error("ECDH accepted x = 0, which is not on the curve")
+	}
+
+	// A verify-only signer checks signatures made by the full one
+	v := NewHybridSigner()
+	if err := v.InitPub(s.Pub()); err != nil {
+		t.Fatalf("InitPub failed: %v", err)
+	}
+	sig[3] ^= 1
+	if valid, err := v.Verify(msg, sig); err != nil || !valid {
+		t.Error("verify-only signer rejected a valid signature")
+	}
+	if _, err := v.Sign(msg); err == nil {
+		t.Error("verify-only signer signed")
+	}
+	if _, err := v.ECDH(peer.Pub()); err == nil {
+		t.Error("verify-only signer computed ECDH")
+	}
+}
+
+func TestBatchVerifier(t *testing.T) {
+	const n = 2*cBatchChunk + 7
+	sigs := make([][]byte, n)
+	msgs := make([][]byte, n)
+	pubs := make([][]byte, n)
+	want := make([]bool, n)
+	for i := range sigs {
+		s := NewP256K1Signer()
+		if err := s.Generate(); err != nil {
+			t.Fatalf("Generate failed: %v", err)
+		}
+		msgs[i] = make([]byte, 32)
+		msgs[i][0] = byte(i)
+		sig, err := s.Sign(msgs[i])
+		if err != nil {
+			t.Fatalf("Sign failed: %v", err)
+		}
+		sigs[i] = sig
+		pubs[i] = s.Pub()
+		want[i] = true
+	}
+	sigs[4][9] ^= 1
+	want[4] = false
+	msgs[cBatchChunk] = msgs[cBatchChunk][:31]
+	want[cBatchChunk] = false
+	pubs[cBatchChunk+1] = make([]byte, 32)
+	want[cBatchChunk+1] = false
+	sigs[n-1] = nil
+	want[n-1] = false
+
+	v := NewBatchVerifier()
+	defer v.Close()
+	for round := 0; round < 2; round++ {
+		valid := make([]bool, n)
+		v.Verify(sigs, msgs, pubs, valid)
+		for i := range valid {
+			if valid[i] != want[i] {
+				t.Errorf("round %d: signature %d valid = %v, want %v", round, i, valid[i], want[i])
+			}
+		}
+	}
+}
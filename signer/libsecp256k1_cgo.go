@@ -0,0 +1,138 @@
+//go:build cgo && p256k1cgo && !nocgo
+
+package signer
+
+/*
+#cgo CFLAGS: -I${SRCDIR}/../include -I${SRCDIR}/../src
+#cgo CFLAGS: -DENABLE_MODULE_SCHNORRSIG=1 -DENABLE_MODULE_EXTRAKEYS=1 -DENABLE_MODULE_ECDH=1
+#cgo CFLAGS: -O2 -Wno-unused-function
+
+// The library is compiled from the sources of the CMake p256k1 target in
+// this one translation unit
+#include "secp256k1.c"
+#include "precomputed_ecmult.c"
+#include "precomputed_ecmult_gen.c"
+
+#include <string.h>
+
+#define P256K1_BATCH_CHUNK 128
+
+static int p256k1_ecdh_hash_x(unsigned char *output, const unsigned char *x32, const unsigned char *y32, void *data) {
+    (void)y32;
+    (void)data;
+    memcpy(output, x32, 32);
+    return 1;
+}
+
+// p256k1_ecdhx writes the x coordinate of seckey times the point with x
+// coordinate x32. Either point with that x gives the same result.
+static int p256k1_ecdhx(const secp256k1_context *ctx, unsigned char *output, const unsigned char *x32, const unsigned char *seckey) {
+    unsigned char compressed[33];
+    secp256k1_pubkey pk;
+    compressed[0] = 0x02;
+    memcpy(compressed + 1, x32, 32);
+    if (!secp256k1_ec_pubkey_parse(ctx, &pk, compressed, 33)) {
+        return 0;
+    }
+    return secp256k1_ecdh(ctx, output, &pk, seckey, p256k1_ecdh_hash_x, NULL);
+}
+
+// p256k1_verify_batch checks n <= P256K1_BATCH_CHUNK BIP-340 signatures of 32
+// byte messages by 32 byte x-only keys, all laid out back to back, setting
+// ok[i] to 1 or 0. The parsed keys are checked with one batch verification,
+// and only if that fails one by one.
+static void p256k1_verify_batch(const secp256k1_context *ctx, secp256k1_scratch_space *scratch,
+                                const unsigned char *sigs, const unsigned char *msgs,
+                                const unsigned char *pubs, size_t n, unsigned char *ok) {
+    secp256k1_xonly_pubkey pk[P256K1_BATCH_CHUNK];
+    const secp256k1_xonly_pubkey *pkp[P256K1_BATCH_CHUNK];
+    const unsigned char *sigp[P256K1_BATCH_CHUNK];
+    const unsigned char *msgp[P256K1_BATCH_CHUNK];
+    size_t msglen[P256K1_BATCH_CHUNK];
+    size_t idx[P256K1_BATCH_CHUNK];
+    size_t i, m = 0;
+
+    for (i = 0; i < n; i++) {
+        ok[i] = (unsigned char)secp256k1_xonly_pubkey_parse(ctx, &pk[m], pubs + 32 * i);
+        if (ok[i]) {
+            pkp[m] = &pk[m];
+            sigp[m] = sigs + 64 * i;
+            msgp[m] = msgs + 32 * i;
+            msglen[m] = 32;
+            idx[m] = i;
+            m++;
+        }
+    }
+    if (secp256k1_schnorrsig_verify_batch(ctx, scratch, sigp, msgp, msglen, pkp, m)) {
+        return;
+    }
+    for (i = 0; i < m; i++) {
+        ok[idx[i]] = (unsigned char)secp256k1_schnorrsig_verify(ctx, sigp[i], msgp[i], 32, pkp[i]);
+    }
+}
+*/
+import "C"
+
+import "unsafe"
+
+// hybridCgo reports whether HybridSigner and BatchVerifier can use the C
+// library. Build with cgo and -tags p256k1cgo to enable it.
+const hybridCgo = true
+
+// cBatchChunk is the number of signatures checked per call into C
+const cBatchChunk = C.P256K1_BATCH_CHUNK
+
+// cBatchScratchSize is the size of the scratch space for the batch
+// verification's multi-scalar multiplication, enough for Pippenger's
+// algorithm over a whole chunk
+const cBatchScratchSize = 1 << 20
+
+// cContext is the C context shared by all calls. Verification and ECDH do
+// not use the generator tables that randomization blinds.
+var cContext = C.secp256k1_context_create(C.SECP256K1_CONTEXT_NONE)
+
+func cBytes(b []byte) *C.uchar {
+	return (*C.uchar)(unsafe.Pointer(unsafe.SliceData(b)))
+}
+
+// cXOnlyPubkey is an x-only public key parsed by the C library
+type cXOnlyPubkey struct {
+	pk C.secp256k1_xonly_pubkey
+}
+
+func (p *cXOnlyPubkey) parse(x32 []byte) bool {
+	return C.secp256k1_xonly_pubkey_parse(cContext, &p.pk, cBytes(x32)) == 1
+}
+
+func cSchnorrVerify(sig64, msg32 []byte, pk *cXOnlyPubkey) bool {
+	return C.secp256k1_schnorrsig_verify(cContext, cBytes(sig64), cBytes(msg32), 32, &pk.pk) == 1
+}
+
+func cECDHX(output, x32, seckey []byte) bool {
+	return C.p256k1_ecdhx(cContext, cBytes(output), cBytes(x32), cBytes(seckey)) == 1
+}
+
+// cBatch holds the scratch space of a BatchVerifier
+type cBatch struct {
+	scratch *C.secp256k1_scratch_space
+}
+
+// verify sets ok[i] to whether the i-th 64 byte signature in sigs is valid
+// for the i-th 32 byte message and key in msgs and pubs, for len(ok) <=
+// cBatchChunk signatures
+func (b *cBatch) verify(sigs, msgs, pubs, ok []byte) {
+	if len(ok) == 0 {
+		return
+	}
+	if b.scratch == nil {
+		b.scratch = C.secp256k1_scratch_space_create(cContext, cBatchScratchSize)
+	}
+	C.p256k1_verify_batch(cContext, b.scratch, cBytes(sigs), cBytes(msgs), cBytes(pubs), C.size_t(len(ok)), cBytes(ok))
+}
+
+func (b *cBatch) close() {
+	if b.scratch != nil {
+		C.secp256k1_scratch_space_destroy(cContext, b.scratch)
+		b.scratch = nil
+	}
+}
@@ -0,0 +1,27 @@
+//go:build !cgo || !p256k1cgo || nocgo
+
+package signer
+
+// hybridCgo reports whether HybridSigner and BatchVerifier can use the C
+// library. Build with cgo and -tags p256k1cgo to enable it.
+const hybridCgo = false
+
+// cBatchChunk is the number of signatures checked per call into C
+const cBatchChunk = 128
+
+// Without the C library these are never called; HybridSigner and
+// BatchVerifier check hybridCgo first.
+
+type cXOnlyPubkey struct{}
+
+func (p *cXOnlyPubkey) parse(x32 []byte) bool { return false }
+
+func cSchnorrVerify(sig64, msg32 []byte, pk *cXOnlyPubkey) bool { return false }
+
+func cECDHX(output, x32, seckey []byte) bool { return false }
+
+type cBatch struct{}
+
+func (b *cBatch) verify(sigs, msgs, pubs, ok []byte) {}
+
+func (b *cBatch) close() {}
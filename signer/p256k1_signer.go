@@ -1,16 +1,20 @@
 package signer
 
 import (
+	"context"
 	"errors"
+	"slices"
 
 	"p256k1.mleku.dev"
 )
 
 // P256K1Signer implements the I and Gen interfaces using the p256k1 package
 type P256K1Signer struct {
-	keypair   *p256k1.KeyPair
-	xonlyPub  *p256k1.XOnlyPubkey
-	hasSecret bool // Whether we have the secret key (if false, can only verify)
+	keypair    *p256k1.KeyPair
+	signingKey *p256k1.SigningKey
+	xonlyPub   *p256k1.XOnlyPubkey
+	pub        [32]byte // Serialized xonlyPub, for Pub and PubInto
+	hasSecret  bool     // Whether we have the secret key (if false, can only verify)
 }
 
 // NewP256K1Signer creates a new P256K1Signer instance
@@ -52,11 +56,7 @@ func (s *P256K1Signer) Generate() error {
 		}
 	}
 
-	s.keypair = kp
-	s.xonlyPub = xonly
-	s.hasSecret = true
-
-	return nil
+	return s.setKeypair(kp, xonly)
 }
 
 // InitSec initialises the secret (signing) key from the raw bytes, and also derives the public key
@@ -95,10 +95,21 @@ func (s *P256K1Signer) InitSec(sec []byte) error {
 		}
 	}
 
+	return s.setKeypair(kp, xonly)
+}
+
+// setKeypair stores kp, whose public key xonly has even y, prepared for
+// signing
+func (s *P256K1Signer) setKeypair(kp *p256k1.KeyPair, xonly *p256k1.XOnlyPubkey) error {
+	sk, err := p256k1.NewSigningKey(kp)
+	if err != nil {
+		return err
+	}
 	s.keypair = kp
+	s.signingKey = sk
 	s.xonlyPub = xonly
+	s.pub = xonly.Serialize()
 	s.hasSecret = true
-
 	return nil
 }
 
@@ -114,7 +125,9 @@ func (s *P256K1Signer) InitPub(pub []byte) error {
 	}
 
 	s.xonlyPub = xonly
+	s.pub = xonly.Serialize()
 	s.keypair = nil
+	s.signingKey = nil
 	s.hasSecret = false
 
 	return nil
@@ -133,26 +146,46 @@ func (s *P256K1Signer) Pub() []byte {
 	if s.xonlyPub == nil {
 		return nil
 	}
-	serialized := s.xonlyPub.Serialize()
-	return serialized[:]
+	return s.PubInto(make([]byte, 0, 32))
+}
+
+// PubInto appends the 32 byte x-only public key to dst and returns the
+// extended slice, or returns dst unchanged if there is no key. It does not
+// allocate when dst has room.
+func (s *P256K1Signer) PubInto(dst []byte) []byte {
+	if s.xonlyPub == nil {
+		return dst
+	}
+	return append(dst, s.pub[:]...)
 }
 
 // Sign creates a signature using the stored secret key
 func (s *P256K1Signer) Sign(msg []byte) (sig []byte, err error) {
-	if !s.hasSecret || s.keypair == nil {
-		return nil, errors.New("no secret key available for signing")
+	sig, err = s.SignInto(make([]byte, 0, 64), msg)
+	if err != nil {
+		return nil, err
 	}
+	return sig, nil
+}
 
-	if len(msg) != 32 {
-		return nil, errors.New("message must be 32 bytes")
+// SignInto appends the 64 byte signature of msg to dst and returns the
+// extended slice. It does not allocate when dst has room. On error dst is
+// returned unchanged.
+func (s *P256K1Signer) SignInto(dst, msg []byte) (sig []byte, err error) {
+	if !s.hasSecret || s.signingKey == nil {
+		return dst, errors.New("no secret key available for signing")
 	}
 
-	var sig64 [64]byte
-	if err := p256k1.SchnorrSign(sig64[:], msg, s.keypair, nil); err != nil {
-		return nil, err
+	if len(msg) != 32 {
+		return dst, errors.New("message must be 32 bytes")
 	}
 
-	return sig64[:], nil
+	n := len(dst)
+	dst = slices.Grow(dst, 64)
+	if err := s.signingKey.Sign(dst[n:n+64], msg, nil); err != nil {
+		return dst[:n], err
+	}
+	return dst[:n+64], nil
 }
 
 // Verify checks a message hash and signature match the stored public key
@@ -179,39 +212,70 @@ func (s *P256K1Signer) Zero() {
 		s.keypair.Clear()
 		s.keypair = nil
 	}
+	if s.signingKey != nil {
+		s.signingKey.Clear()
+		s.signingKey = nil
+	}
 	s.hasSecret = false
 	// Note: x-only pubkey doesn't contain sensitive data, but we can clear it too
 	s.xonlyPub = nil
+	s.pub = [32]byte{}
 }
 
-// ECDH returns a shared secret derived using Elliptic Curve Diffie-Hellman on the I secret and provided pubkey
+// ECDH returns a shared secret derived using Elliptic Curve Diffie-Hellman on the I secret and provided pubkey.
+// The secret is the raw x coordinate of the shared point (p256k1.ECDHX), as
+// used by NIP-04 and NIP-44; it only depends on the x coordinate of pub, so no
+// square root is needed to lift it.
+//
+// Earlier versions returned the hashed secret of p256k1.ECDH, SHA-256 of the
+// parity of y and x. Callers that stored or compared those values must hash
+// the x coordinate themselves or call p256k1.ECDH.
 func (s *P256K1Signer) ECDH(pub []byte) (secret []byte, err error) {
+	secret, err = s.ECDHInto(make([]byte, 0, 32), pub)
+	if err != nil {
+		return nil, err
+	}
+	return secret, nil
+}
+
+// ECDHInto appends the 32 byte shared secret of ECDH to dst and returns the
+// extended slice. It does not allocate when dst has room. On error dst is
+// returned unchanged.
+func (s *P256K1Signer) ECDHInto(dst, pub []byte) (secret []byte, err error) {
 	if !s.hasSecret || s.keypair == nil {
-		return nil, errors.New("no secret key available for ECDH")
+		return dst, errors.New("no secret key available for ECDH")
 	}
 
 	if len(pub) != 32 {
-		return nil, errors.New("public key must be 32 bytes")
+		return dst, errors.New("public key must be 32 bytes")
 	}
 
-	// Convert x-only pubkey (32 bytes) to compressed public key (33 bytes) with even Y
-	var compressedPub [33]byte
-	compressedPub[0] = 0x02 // Even Y
-	copy(compressedPub[1:], pub)
+	n := len(dst)
+	dst = slices.Grow(dst, 32)
+	if err := p256k1.ECDHX(dst[n:n+32], pub, s.keypair.Seckey()); err != nil {
+		return dst[:n], err
+	}
+	return dst[:n+32], nil
+}
 
-	// Parse the compressed public key
-	var pubkey p256k1.PublicKey
-	if err := p256k1.ECPubkeyParse(&pubkey, compressedPub[:]); err != nil {
-		return nil, err
+// ECDHBatch returns the shared secrets of the signer's secret key with each
+// of the 32 byte x-only public keys in pubs, equal to calling ECDH on each:
+// raw x coordinates, computed by p256k1.ECDHBatchX with one recoding of the
+// secret key and one inversion per chunk of keys
+func (s *P256K1Signer) ECDHBatch(pubs [][]byte) (secrets [][]byte, err error) {
+	if !s.hasSecret || s.keypair == nil {
+		return nil, errors.New("no secret key available for ECDH")
 	}
 
-	// Compute ECDH shared secret using standard ECDH (hashes the point)
-	var sharedSecret [32]byte
-	if err := p256k1.ECDH(sharedSecret[:], &pubkey, s.keypair.Seckey(), nil); err != nil {
+	secrets = make([][]byte, len(pubs))
+	buf := make([]byte, 32*len(pubs))
+	for i := range secrets {
+		secrets[i] = buf[32*i : 32*(i+1)]
+	}
+	if err := p256k1.ECDHBatchX(s.keypair.Seckey(), pubs, secrets); err != nil {
 		return nil, err
 	}
-
-	return sharedSecret[:], nil
+	return secrets, nil
 }
 
 // P256K1Gen implements the Gen interface for nostr BIP-340 key generation
@@ -249,6 +313,30 @@ func (g *P256K1Gen) Generate() (pubBytes []byte, err error) {
 	return compressed[:], nil
 }
 
+// Search runs p256k1.KeySearch over workers goroutines and keeps the first key
+// whose 33 byte compressed public key satisfies match. It replaces a loop of
+// Generate calls, stepping through candidate keys with one point addition
+// each instead of a full key generation. The compressed public key of the
+// found key is returned.
+func (g *P256K1Gen) Search(ctx context.Context, workers int, match func(pubBytes []byte) bool) (pubBytes []byte, err error) {
+	kp, err := p256k1.KeySearch(ctx, workers, match)
+	if err != nil {
+		return nil, err
+	}
+
+	g.keypair = kp
+	g.xonlyPub = nil
+
+	var pubkey p256k1.PublicKey = *kp.Pubkey()
+	var compressed [33]byte
+	if p256k1.ECPubkeySerialize(compressed[:], &pubkey, p256k1.ECCompressed) != 33 {
+		return nil, errors.New("failed to serialize compressed public key")
+	}
+	g.compressedPub = &pubkey
+
+	return compressed[:], nil
+}
+
 // Negate flips the public key Y coordinate between odd and even
 func (g *P256K1Gen) Negate() {
 	if g.keypair == nil {
@@ -1,6 +1,8 @@
 package signer
 
 import (
+	"bytes"
+	"context"
 	"testing"
 
 	"p256k1.mleku.dev"
@@ -182,6 +184,117 @@ func TestP256K1Signer_ECDH(t *testing.T) {
 	}
 }
 
+func TestP256K1Signer_ECDHBatch(t *testing.T) {
+	s := NewP256K1Signer()
+	if err := s.Generate(); err != nil {
+		t.Fatalf("Generate failed: %v", err)
+	}
+	defer s.Zero()
+
+	var pubs [][]byte
+	for i := 0; i < 5; i++ {
+		peer := NewP256K1Signer()
+		if err := peer.Generate(); err != nil {
+			t.Fatalf("Generate failed: %v", err)
+		}
+		pubs = append(pubs, peer.Pub())
+	}
+
+	secrets, err := s.ECDHBatch(pubs)
+	if err != nil {
+		t.Fatalf("ECDHBatch failed: %v", err)
+	}
+	for i, pub := range pubs {
+		want, err := s.ECDH(pub)
+		if err != nil {
+			t.Fatalf("ECDH failed: %v", err)
+		}
+		if !bytes.Equal(secrets[i], want) {
+			t.Errorf("secret %d differs from ECDH", i)
+		}
+	}
+}
+
+func TestP256K1Signer_Into(t *testing.T) {
+	s := NewP256K1Signer()
+	if err := s.Generate(); err != nil {
+		t.Fatalf("Generate failed: %v", err)
+	}
+	defer s.Zero()
+	peer := NewP256K1Signer()
+	if err := peer.Generate(); err != nil {
+		t.Fatalf("Generate failed: %v", err)
+	}
+	msg := make([]byte, 32)
+	msg[0] = 1
+
+	prefix := []byte("prefix")
+	buf := make([]byte, 0, 256)
+	if got := s.PubInto(append(buf, prefix...)); !bytes.Equal(got, append(prefix, s.Pub()...)) {
+		t.Error("PubInto differs from Pub")
+	}
+	sig, err := s.SignInto(append(buf, prefix...), msg)
+	if err != nil {
+		t.Fatalf("SignInto failed: %v", err)
+	}
+	want, err := s.Sign(msg)
+	if err != nil {
+		t.Fatalf("Sign failed: %v", err)
+	}
+	if !bytes.Equal(sig, append(prefix, want...)) {
+		t.Error("SignInto differs from Sign")
+	}
+	if valid, err := s.Verify(msg, sig[len(prefix):]); err != nil || !valid {
+		t.Error("SignInto signature does not verify")
+	}
+	secret, err := s.ECDHInto(append(buf, prefix...), peer.Pub())
+	if err != nil {
+		t.Fatalf("ECDHInto failed: %v", err)
+	}
+	wantSecret, err := peer.ECDH(s.Pub())
+	if err != nil {
+		t.Fatalf("ECDH failed: %v", err)
+	}
+	if !bytes.Equal(secret, append(prefix, wantSecret...)) {
+		t.Error("ECDHInto differs from ECDH")
+	}
+
+	// Errors leave dst as it was
+	if got, err := s.SignInto(prefix, msg[:31]); err == nil || !bytes.Equal(got, prefix) {
+		t.Error("SignInto accepted a short message or changed dst")
+	}
+	if got, err := s.ECDHInto(prefix, make([]byte, 32)); err == nil || !bytes.Equal(got, prefix) {
+		t.Error("ECDHInto accepted an invalid key or changed dst")
+	}
+
+	// A verify-only signer has a public key but cannot sign
+	v := NewP256K1Signer()
+	if err := v.InitPub(s.Pub()); err != nil {
+		t.Fatalf("InitPub failed: %v", err)
+	}
+	if !bytes.Equal(v.PubInto(nil), s.Pub()) {
+		t.Error("PubInto of a verify-only signer is wrong")
+	}
+	if _, err := v.SignInto(nil, msg); err == nil {
+		t.Error("verify-only signer signed")
+	}
+
+	// With room in dst nothing is allocated
+	if raceEnabled {
+		return
+	}
+	peerPub := peer.Pub()
+	for name, f := range map[string]func(){
+		"PubInto":  func() { s.PubInto(buf[:0]) },
+		"SignInto": func() { s.SignInto(buf[:0], msg) },
+		"ECDHInto": func() { s.ECDHInto(buf[:0], peerPub) },
+	} {
+		if n := testing.AllocsPerRun(10, f); n != 0 {
+			t.Errorf("%s: %v allocs, want 0", name, n)
+		}
+	}
+}
+
 func TestP256K1Gen_Generate(t *testing.T) {
 	g := NewP256K1Gen()
 
@@ -264,3 +377,26 @@ func TestP256K1Gen_KeyPairBytes(t *testing.T) {
 		}
 	}
 }
+
+func TestP256K1Gen_Search(t *testing.T) {
+	g := NewP256K1Gen()
+
+	pubBytes, err := g.Search(context.Background(), 2, func(pub []byte) bool {
+		return pub[0] == 0x02 && pub[1]>>4 == 0x5
+	})
+	if err != nil {
+		t.Fatalf("Search failed: %v", err)
+	}
+	if len(pubBytes) != 33 || pubBytes[0] != 0x02 || pubBytes[1]>>4 != 0x5 {
+		t.Fatalf("Search returned a non-matching key %x", pubBytes)
+	}
+
+	secBytes, xonly := g.KeyPairBytes()
+	if !bytes.Equal(xonly, pubBytes[1:]) {
+		t.Error("x-only pubkey does not match the searched key")
+	}
+	var pubkey p256k1.PublicKey
+	if err := p256k1.ECPubkeyCreate(&pubkey, secBytes); err != nil || pubkey != *g.compressedPub {
+		t.Error("secret key does not produce the searched key")
+	}
+}
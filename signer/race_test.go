@@ -0,0 +1,7 @@
+//go:build race
+
+package signer
+
+// raceEnabled reports whether the tests run under the race detector, whose
+// instrumentation allocates on paths that otherwise do not
+const raceEnabled = true
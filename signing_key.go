@@ -0,0 +1,104 @@
+package p256k1
+
+import (
+	"errors"
+	"unsafe"
+)
+
+// SigningKey is a key pair prepared for BIP-340 signing. SchnorrSign parses
+// the secret key, decodes the public key, fixes the secret key's sign for an
+// even y and serializes the x-only public key on every call; a SigningKey
+// does all of this once. It also holds the state of the nonce hash after
+// the one block of masked key and public key it starts with when no
+// auxiliary randomness is given, so the nonce hash of such a signature only
+// absorbs the message.
+//
+// Signatures are the same as those of SchnorrSign with the key pair. A
+// SigningKey is safe for concurrent use; Clear wipes it.
+type SigningKey struct {
+	sk      Scalar
+	skBytes [32]byte
+	pkX     [32]byte
+
+	// nonceMidstate is TaggedHash("BIP0340/nonce", ...) after absorbing
+	// sk ^ zeroMask || pkX
+	nonceMidstate [sha256MidstateLen]byte
+}
+
+// NewSigningKey prepares keypair for signing
+func NewSigningKey(keypair *KeyPair) (*SigningKey, error) {
+	if keypair == nil {
+		return nil, errors.New("keypair cannot be nil")
+	}
+	k := &SigningKey{}
+	if err := schnorrKeypairLoad(&k.sk, &k.pkX, keypair); err != nil {
+		return nil, err
+	}
+	k.sk.getB32(k.skBytes[:])
+
+	taggedMidstateInitOnce.Do(initTaggedHashMidstates)
+	var maskedKey [32]byte
+	for i := range maskedKey {
+		maskedKey[i] = k.skBytes[i] ^ zeroMask[i]
+	}
+	h := getTaggedHasher(bip340NonceMidstate)
+	h.write(maskedKey[:])
+	h.write(k.pkX[:])
+	h.save(&k.nonceMidstate)
+	h.clearState()
+	taggedHasherPool.Put(h)
+	memclear(unsafe.Pointer(&maskedKey[0]), 32)
+	return k, nil
+}
+
+// XOnlyPubkey returns the x-only public key of k
+func (k *SigningKey) XOnlyPubkey() *XOnlyPubkey {
+	return &XOnlyPubkey{data: k.pkX}
+}
+
+// Sign creates a Schnorr signature of msg32 following BIP-340, as
+// SchnorrSign with the key pair k was made from
+func (k *SigningKey) Sign(sig64 []byte, msg32 []byte, auxRand32 []byte) (err error) {
+	if metricsEnabled {
+		defer metricsDoneErr(metricSchnorrSign, metricsStart(), &err)
+	}
+	if len(sig64) != 64 {
+		return errors.New("signature must be 64 bytes")
+	}
+	if len(msg32) != 32 {
+		return errors.New("message must be 32 bytes")
+	}
+
+	var nonce32 [32]byte
+	if len(auxRand32) == 32 {
+		if err := NonceFunctionBIP340(nonce32[:], msg32, k.skBytes[:], k.pkX[:], auxRand32); err != nil {
+			return err
+		}
+	} else {
+		// Without auxiliary randomness the key is masked with zeroMask,
+		// which nonceMidstate already covers
+		h := taggedHasherPool.Get().(*taggedHasher)
+		h.restore(&k.nonceMidstate)
+		h.write(msg32)
+		h.sum(nonce32[:])
+		h.clearState()
+		taggedHasherPool.Put(h)
+	}
+
+	err = schnorrSignWithNonce(getGlobalGenContext(), sig64, msg32, &k.sk, &k.pkX, &nonce32)
+	memclear(unsafe.Pointer(&nonce32[0]), 32)
+	return err
+}
+
+// SignInto is Sign writing to a SchnorrSignature
+func (k *SigningKey) SignInto(sig *SchnorrSignature, msg32 []byte, auxRand32 []byte) error {
+	return k.Sign(sig[:], msg32, auxRand32)
+}
+
+// Clear wipes the secret key and the key dependent hash state from k. Sign
+// must not be used afterwards.
+func (k *SigningKey) Clear() {
+	k.sk.clear()
+	memclear(unsafe.Pointer(&k.skBytes[0]), 32)
+	memclear(unsafe.Pointer(&k.nonceMidstate[0]), sha256MidstateLen)
+}
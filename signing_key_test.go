@@ -0,0 +1,107 @@
+package p256k1
+
+import (
+	"bytes"
+	"testing"
+)
+
+func TestSigningKey(t *testing.T) {
+	msgs, auxRands, _ := makeSignBatch(t, 8)
+	var want, got [64]byte
+
+	// Enough keys that both y parities occur
+	for n := 0; n < 8; n++ {
+		keypair, err := KeyPairGenerate()
+		if err != nil {
+			t.Fatal(err)
+		}
+		k, err := NewSigningKey(keypair)
+		if err != nil {
+			t.Fatal(err)
+		}
+		xonly, err := keypair.XOnlyPubkey()
+		if err != nil {
+			t.Fatal(err)
+		}
+		if *k.XOnlyPubkey() != *xonly {
+			t.Fatal("SigningKey has the wrong public key")
+		}
+
+		for i := range msgs {
+			for _, aux := range [][]byte{auxRands[i], nil, auxRands[i][:5]} {
+				if err := SchnorrSign(want[:], msgs[i], keypair, aux); err != nil {
+					t.Fatal(err)
+				}
+				if err := k.Sign(got[:], msgs[i], aux); err != nil {
+					t.Fatal(err)
+				}
+				if want != got {
+					t.Fatalf("key %d: signature %d with aux %x differs from SchnorrSign", n, i, aux)
+				}
+			}
+		}
+		keypair.Clear()
+		k.Clear()
+	}
+
+	keypair, err := KeyPairGenerate()
+	if err != nil {
+		t.Fatal(err)
+	}
+	k, err := NewSigningKey(keypair)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if err := k.Sign(got[:63], msgs[0], nil); err == nil {
+		t.Error("short signature buffer accepted")
+	}
+	if err := k.Sign(got[:], msgs[0][:31], nil); err == nil {
+		t.Error("short message accepted")
+	}
+	if _, err := NewSigningKey(nil); err == nil {
+		t.Error("nil keypair accepted")
+	}
+
+	for _, aux := range [][]byte{nil, auxRands[0]} {
+		if raceEnabled {
+			break
+		}
+		if n := testing.AllocsPerRun(10, func() { k.Sign(got[:], msgs[0], aux) }); n != 0 {
+			t.Errorf("Sign with aux %x: %v allocs, want 0", aux, n)
+		}
+	}
+
+	k.Clear()
+	if !bytes.Equal(k.skBytes[:], make([]byte, 32)) || !k.sk.isZero() {
+		t.Error("Clear left the secret key")
+	}
+}
+
+func BenchmarkSigningKey(b *testing.B) {
+	keypair, err := KeyPairGenerate()
+	if err != nil {
+		b.Fatal(err)
+	}
+	k, err := NewSigningKey(keypair)
+	if err != nil {
+		b.Fatal(err)
+	}
+	msgs, auxRands, _ := makeSignBatch(b, 1)
+	var sig [64]byte
+	for _, c := range []struct {
+		name string
+		aux  []byte
+	}{{"aux", auxRands[0]}, {"noaux", nil}} {
+		b.Run("SchnorrSign/"+c.name, func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				SchnorrSign(sig[:], msgs[0], keypair, c.aux)
+			}
+		})
+		b.Run("SigningKey/"+c.name, func(b *testing.B) {
+			b.ReportAllocs()
+			for i := 0; i < b.N; i++ {
+				k.Sign(sig[:], msgs[0], c.aux)
+			}
+		})
+	}
+}
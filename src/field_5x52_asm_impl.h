@@ -0,0 +1,278 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+/**
+ * x86_64 inline assembly versions of secp256k1_fe_mul_inner and
+ * secp256k1_fe_sqr_inner. They follow the steps of field_5x52_int128_impl.h,
+ * with the two 128-bit accumulators d and c held in r8:r9 and r10:r11, t3
+ * and t4 in r12 and r13 and the mask M in rcx, so every double-width
+ * product is a single MULQ and every shift a SHRD.
+ *
+ * The products added to an accumulator right after it is shifted are first
+ * summed in r14:r15, so the sum does not wait for the SHRD. r may alias a,
+ * so r[0] and r[1] go through the locals r0 and r1 and are stored after the
+ * last limb of a is read.
+ */
+
+#ifndef SECP256K1_FIELD_INNER5X52_IMPL_H
+#define SECP256K1_FIELD_INNER5X52_IMPL_H
+
+#include <stdint.h>
+
+#include "util.h"
+
+#define VERIFY_BITS(x, n) VERIFY_CHECK(((x) >> (n)) == 0)
+
+/* R = 0x1000003D10 and its shifts */
+#define FE_ASM_R "$0x1000003D10"
+#define FE_ASM_R12 "$0x1000003D10000"
+#define FE_ASM_R4 "$0x1000003D1"
+
+/* acc = x*y; acc += x*y; the ...2 forms take 2*x. acc is D for d
+ * (r8:r9), C for c (r10:r11) or P for p (r14:r15). */
+#define FE_ASM_LO_D "%%r8"
+#define FE_ASM_HI_D "%%r9"
+#define FE_ASM_LO_C "%%r10"
+#define FE_ASM_HI_C "%%r11"
+#define FE_ASM_LO_P "%%r14"
+#define FE_ASM_HI_P "%%r15"
+#define FE_ASM_MUL(acc, x, y) "movq " x ",%%rax\n" "mulq " y "\n" "movq %%rax," FE_ASM_LO_##acc "\n" "movq %%rdx," FE_ASM_HI_##acc "\n"
+#define FE_ASM_MULADD(acc, x, y) "movq " x ",%%rax\n" "mulq " y "\n" "addq %%rax," FE_ASM_LO_##acc "\n" "adcq %%rdx," FE_ASM_HI_##acc "\n"
+#define FE_ASM_MUL2(acc, x, y) "movq " x ",%%rax\n" "addq %%rax,%%rax\n" "mulq " y "\n" "movq %%rax," FE_ASM_LO_##acc "\n" "movq %%rdx," FE_ASM_HI_##acc "\n"
+#define FE_ASM_MULADD2(acc, x, y) "movq " x ",%%rax\n" "addq %%rax,%%rax\n" "mulq " y "\n" "addq %%rax," FE_ASM_LO_##acc "\n" "adcq %%rdx," FE_ASM_HI_##acc "\n"
+/* dst = acc & M; acc >>= 52 */
+#define FE_ASM_EXTRACT(acc_lo, acc_hi, dst) "movq " acc_lo "," dst "\n" "andq %%rcx," dst "\n" "shrdq $52," acc_hi "," acc_lo "\n" "shrq $52," acc_hi "\n"
+#define FE_ASM_D_EXTRACT(dst) FE_ASM_EXTRACT("%%r8", "%%r9", dst)
+#define FE_ASM_C_EXTRACT(dst) FE_ASM_EXTRACT("%%r10", "%%r11", dst)
+/* acc += p */
+#define FE_ASM_D_ADDP "addq %%r14,%%r8\n" "adcq %%r15,%%r9\n"
+#define FE_ASM_C_ADDP "addq %%r14,%%r10\n" "adcq %%r15,%%r11\n"
+/* acc += k*reg, for a 64-bit immediate k */
+#define FE_ASM_MULADD_IMM(acc, k, reg) "movabsq " k ",%%rax\n" "mulq " reg "\n" "addq %%rax," FE_ASM_LO_##acc "\n" "adcq %%rdx," FE_ASM_HI_##acc "\n"
+
+SECP256K1_INLINE static void secp256k1_fe_mul_inner(uint64_t *r, const uint64_t *a, const uint64_t * SECP256K1_RESTRICT b) {
+    uint64_t r0, r1;
+
+    VERIFY_BITS(a[0], 56);
+    VERIFY_BITS(a[1], 56);
+    VERIFY_BITS(a[2], 56);
+    VERIFY_BITS(a[3], 56);
+    VERIFY_BITS(a[4], 52);
+    VERIFY_BITS(b[0], 56);
+    VERIFY_BITS(b[1], 56);
+    VERIFY_BITS(b[2], 56);
+    VERIFY_BITS(b[3], 56);
+    VERIFY_BITS(b[4], 52);
+    VERIFY_CHECK(r != b);
+    VERIFY_CHECK(a != b);
+
+    __asm__ __volatile__(
+    "movabsq $0xFFFFFFFFFFFFF,%%rcx\n"
+    /* d = p3 = a0*b3 + a1*b2 + a2*b1 + a3*b0 */
+    FE_ASM_MUL(D, "0(%[a])", "24(%[b])")
+    FE_ASM_MULADD(D, "8(%[a])", "16(%[b])")
+    FE_ASM_MULADD(D, "16(%[a])", "8(%[b])")
+    FE_ASM_MULADD(D, "24(%[a])", "0(%[b])")
+    /* c = p8 = a4*b4; d += R*lo(c); c >>= 64 */
+    FE_ASM_MUL(C, "32(%[a])", "32(%[b])")
+    FE_ASM_MULADD_IMM(D, FE_ASM_R, "%%r10")
+    "movq %%r11,%%r10\n"
+    /* p = p4 + (R << 12)*c; t3 = d & M; d >>= 52; d += p */
+    FE_ASM_MUL(P, "0(%[a])", "32(%[b])")
+    FE_ASM_MULADD(P, "8(%[a])", "24(%[b])")
+    FE_ASM_MULADD(P, "16(%[a])", "16(%[b])")
+    FE_ASM_MULADD(P, "24(%[a])", "8(%[b])")
+    FE_ASM_MULADD(P, "32(%[a])", "0(%[b])")
+    FE_ASM_MULADD_IMM(P, FE_ASM_R12, "%%r10")
+    FE_ASM_D_EXTRACT("%%r12")
+    FE_ASM_D_ADDP
+    /* p = p5; t4 = d & M, with tx still in its top bits; d >>= 52; d += p */
+    FE_ASM_MUL(P, "8(%[a])", "32(%[b])")
+    FE_ASM_MULADD(P, "16(%[a])", "24(%[b])")
+    FE_ASM_MULADD(P, "24(%[a])", "16(%[b])")
+    FE_ASM_MULADD(P, "32(%[a])", "8(%[b])")
+    FE_ASM_D_EXTRACT("%%r13")
+    FE_ASM_D_ADDP
+    /* c = p0 */
+    FE_ASM_MUL(C, "0(%[a])", "0(%[b])")
+    /* u0 = d & M; d >>= 52; u0 = (u0 << 4) | tx; t4 &= M >> 4 */
+    FE_ASM_D_EXTRACT("%%r14")
+    "movq %%r13,%%rax\n"
+    "shrq $48,%%rax\n"
+    "shlq $4,%%r14\n"
+    "orq %%rax,%%r14\n"
+    "movabsq $0xFFFFFFFFFFFF,%%rax\n"
+    "andq %%rax,%%r13\n"
+    /* c += u0*(R >> 4) */
+    FE_ASM_MULADD_IMM(C, FE_ASM_R4, "%%r14")
+    /* p = p1; r0 = c & M; c >>= 52; c += p */
+    FE_ASM_MUL(P, "0(%[a])", "8(%[b])")
+    FE_ASM_MULADD(P, "8(%[a])", "0(%[b])")
+    FE_ASM_C_EXTRACT("%%rax")
+    "movq %%rax,%[r0]\n"
+    FE_ASM_C_ADDP
+    /* d += p6; c += (d & M)*R; d >>= 52 */
+    FE_ASM_MULADD(D, "16(%[a])", "32(%[b])")
+    FE_ASM_MULADD(D, "24(%[a])", "24(%[b])")
+    FE_ASM_MULADD(D, "32(%[a])", "16(%[b])")
+    "movq %%r8,%%rax\n"
+    "andq %%rcx,%%rax\n"
+    "movabsq " FE_ASM_R ",%%rdx\n"
+    "mulq %%rdx\n"
+    "addq %%rax,%%r10\n"
+    "adcq %%rdx,%%r11\n"
+    "shrdq $52,%%r9,%%r8\n"
+    "shrq $52,%%r9\n"
+    /* p = p2; r1 = c & M; c >>= 52; c += p */
+    FE_ASM_MUL(P, "0(%[a])", "16(%[b])")
+    FE_ASM_MULADD(P, "8(%[a])", "8(%[b])")
+    FE_ASM_MULADD(P, "16(%[a])", "0(%[b])")
+    FE_ASM_C_EXTRACT("%%rax")
+    "movq %%rax,%[r1]\n"
+    FE_ASM_C_ADDP
+    /* d += p7; c += R*lo(d); d >>= 64 */
+    FE_ASM_MULADD(D, "24(%[a])", "32(%[b])")
+    FE_ASM_MULADD(D, "32(%[a])", "24(%[b])")
+    FE_ASM_MULADD_IMM(C, FE_ASM_R, "%%r8")
+    /* a is no longer read. p = (R << 12)*d + t3; r2 = c & M; c >>= 52;
+     * c += p */
+    "movabsq " FE_ASM_R12 ",%%rax\n"
+    "mulq %%r9\n"
+    "addq %%r12,%%rax\n"
+    "adcq $0,%%rdx\n"
+    "movq %%rax,%%r14\n"
+    "movq %%rdx,%%r15\n"
+    FE_ASM_C_EXTRACT("%%rax")
+    "movq %%rax,16(%[r])\n"
+    FE_ASM_C_ADDP
+    /* r3 = c & M; c >>= 52; r4 = c + t4 */
+    FE_ASM_C_EXTRACT("%%rax")
+    "movq %%rax,24(%[r])\n"
+    "addq %%r13,%%r10\n"
+    "movq %%r10,32(%[r])\n"
+    : [r0] "=m"(r0), [r1] "=m"(r1)
+    : [r] "r"(r), [a] "r"(a), [b] "r"(b)
+    : "rax", "rcx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory"
+    );
+    r[0] = r0;
+    r[1] = r1;
+
+    VERIFY_BITS(r[4], 49);
+}
+
+SECP256K1_INLINE static void secp256k1_fe_sqr_inner(uint64_t *r, const uint64_t *a) {
+    uint64_t r0, r1;
+
+    VERIFY_BITS(a[0], 56);
+    VERIFY_BITS(a[1], 56);
+    VERIFY_BITS(a[2], 56);
+    VERIFY_BITS(a[3], 56);
+    VERIFY_BITS(a[4], 52);
+
+    __asm__ __volatile__(
+    "movabsq $0xFFFFFFFFFFFFF,%%rcx\n"
+    /* d = p3 = (a0*2)*a3 + (a1*2)*a2 */
+    FE_ASM_MUL2(D, "0(%[a])", "24(%[a])")
+    FE_ASM_MULADD2(D, "8(%[a])", "16(%[a])")
+    /* c = p8 = a4*a4; d += R*lo(c); c >>= 64 */
+    FE_ASM_MUL(C, "32(%[a])", "32(%[a])")
+    FE_ASM_MULADD_IMM(D, FE_ASM_R, "%%r10")
+    "movq %%r11,%%r10\n"
+    /* p = p4 + (R << 12)*c; t3 = d & M; d >>= 52; d += p */
+    FE_ASM_MUL2(P, "32(%[a])", "0(%[a])")
+    FE_ASM_MULADD2(P, "8(%[a])", "24(%[a])")
+    FE_ASM_MULADD(P, "16(%[a])", "16(%[a])")
+    FE_ASM_MULADD_IMM(P, FE_ASM_R12, "%%r10")
+    FE_ASM_D_EXTRACT("%%r12")
+    FE_ASM_D_ADDP
+    /* p = p5; t4 = d & M, with tx still in its top bits; d >>= 52; d += p */
+    FE_ASM_MUL2(P, "32(%[a])", "8(%[a])")
+    FE_ASM_MULADD2(P, "16(%[a])", "24(%[a])")
+    FE_ASM_D_EXTRACT("%%r13")
+    FE_ASM_D_ADDP
+    /* c = p0 */
+    FE_ASM_MUL(C, "0(%[a])", "0(%[a])")
+    /* u0 = d & M; d >>= 52; u0 = (u0 << 4) | tx; t4 &= M >> 4 */
+    FE_ASM_D_EXTRACT("%%r14")
+    "movq %%r13,%%rax\n"
+    "shrq $48,%%rax\n"
+    "shlq $4,%%r14\n"
+    "orq %%rax,%%r14\n"
+    "movabsq $0xFFFFFFFFFFFF,%%rax\n"
+    "andq %%rax,%%r13\n"
+    /* c += u0*(R >> 4) */
+    FE_ASM_MULADD_IMM(C, FE_ASM_R4, "%%r14")
+    /* p = p1; r0 = c & M; c >>= 52; c += p */
+    FE_ASM_MUL2(P, "0(%[a])", "8(%[a])")
+    FE_ASM_C_EXTRACT("%%rax")
+    "movq %%rax,%[r0]\n"
+    FE_ASM_C_ADDP
+    /* d += p6; c += (d & M)*R; d >>= 52 */
+    FE_ASM_MULADD2(D, "32(%[a])", "16(%[a])")
+    FE_ASM_MULADD(D, "24(%[a])", "24(%[a])")
+    "movq %%r8,%%rax\n"
+    "andq %%rcx,%%rax\n"
+    "movabsq " FE_ASM_R ",%%rdx\n"
+    "mulq %%rdx\n"
+    "addq %%rax,%%r10\n"
+    "adcq %%rdx,%%r11\n"
+    "shrdq $52,%%r9,%%r8\n"
+    "shrq $52,%%r9\n"
+    /* p = p2; r1 = c & M; c >>= 52; c += p */
+    FE_ASM_MUL2(P, "0(%[a])", "16(%[a])")
+    FE_ASM_MULADD(P, "8(%[a])", "8(%[a])")
+    FE_ASM_C_EXTRACT("%%rax")
+    "movq %%rax,%[r1]\n"
+    FE_ASM_C_ADDP
+    /* d += p7; c += R*lo(d); d >>= 64 */
+    FE_ASM_MULADD2(D, "32(%[a])", "24(%[a])")
+    FE_ASM_MULADD_IMM(C, FE_ASM_R, "%%r8")
+    /* a is no longer read. p = (R << 12)*d + t3; r2 = c & M; c >>= 52;
+     * c += p */
+    "movabsq " FE_ASM_R12 ",%%rax\n"
+    "mulq %%r9\n"
+    "addq %%r12,%%rax\n"
+    "adcq $0,%%rdx\n"
+    "movq %%rax,%%r14\n"
+    "movq %%rdx,%%r15\n"
+    FE_ASM_C_EXTRACT("%%rax")
+    "movq %%rax,16(%[r])\n"
+    FE_ASM_C_ADDP
+    /* r3 = c & M; c >>= 52; r4 = c + t4 */
+    FE_ASM_C_EXTRACT("%%rax")
+    "movq %%rax,24(%[r])\n"
+    "addq %%r13,%%r10\n"
+    "movq %%r10,32(%[r])\n"
+    : [r0] "=m"(r0), [r1] "=m"(r1)
+    : [r] "r"(r), [a] "r"(a)
+    : "rax", "rcx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory"
+    );
+    r[0] = r0;
+    r[1] = r1;
+
+    VERIFY_BITS(r[4], 49);
+}
+
+#undef FE_ASM_R
+#undef FE_ASM_R12
+#undef FE_ASM_R4
+#undef FE_ASM_MUL
+#undef FE_ASM_MULADD
+#undef FE_ASM_MUL2
+#undef FE_ASM_MULADD2
+#undef FE_ASM_LO_D
+#undef FE_ASM_HI_D
+#undef FE_ASM_LO_C
+#undef FE_ASM_HI_C
+#undef FE_ASM_LO_P
+#undef FE_ASM_HI_P
+#undef FE_ASM_EXTRACT
+#undef FE_ASM_D_EXTRACT
+#undef FE_ASM_C_EXTRACT
+#undef FE_ASM_D_ADDP
+#undef FE_ASM_C_ADDP
+#undef FE_ASM_MULADD_IMM
+
+#endif /* SECP256K1_FIELD_INNER5X52_IMPL_H */
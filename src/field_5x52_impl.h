@@ -12,7 +12,11 @@
 #include "field.h"
 #include "modinv64_impl.h"
 
+#if defined(USE_ASM_X86_64)
+#include "field_5x52_asm_impl.h"
+#else
 #include "field_5x52_int128_impl.h"
+#endif
 
 #ifdef VERIFY
 static void secp256k1_fe_impl_verify(const secp256k1_fe *a) {
@@ -0,0 +1,39 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_FIELD_LANES_H
+#define SECP256K1_FIELD_LANES_H
+
+#include <stdint.h>
+
+#include "field.h"
+
+/** Number of field elements secp256k1_fe_lanes_mul multiplies at once, one
+ *  per 64-bit lane of a 512-bit vector. */
+#define SECP256K1_FE_LANES 8
+
+/** SECP256K1_FE_LANES field elements in structure-of-arrays form: n[j][l] is
+ *  limb j of lane l. Every limb is below 2^52, as the 52-bit multipliers of
+ *  the IFMA kernel require; secp256k1_fe_lanes_set ensures this and
+ *  secp256k1_fe_lanes_mul preserves it. */
+typedef struct {
+    uint64_t n[5][SECP256K1_FE_LANES];
+} secp256k1_fe_lanes;
+
+/** Store a (any magnitude) in lane l, weakly normalized. */
+static void secp256k1_fe_lanes_set(secp256k1_fe_lanes *r, size_t l, const secp256k1_fe *a);
+
+/** Set r to lane l of a. The output has magnitude 1 and is not normalized. */
+static void secp256k1_fe_lanes_get(secp256k1_fe *r, const secp256k1_fe_lanes *a, size_t l);
+
+/** Set every lane of r to the product of the same lanes of a and b, with the
+ *  same result as secp256k1_fe_mul up to normalization. r may alias a or b.
+ *  With USE_FIELD_IFMA all lanes are computed with AVX-512 IFMA instructions
+ *  (which the CPU running the library must support), otherwise one lane at a
+ *  time with secp256k1_fe_mul_inner, which is slower than multiplying the
+ *  elements in place, so callers only use lanes under USE_FIELD_IFMA. */
+static void secp256k1_fe_lanes_mul(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, const secp256k1_fe_lanes *b);
+
+#endif /* SECP256K1_FIELD_LANES_H */
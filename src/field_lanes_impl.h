@@ -0,0 +1,133 @@
+/***********************************************************************
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_FIELD_LANES_IMPL_H
+#define SECP256K1_FIELD_LANES_IMPL_H
+
+#include "field_lanes.h"
+#include "field_impl.h"
+#include "util.h"
+
+#ifdef USE_FIELD_IFMA
+#include <immintrin.h>
+#endif
+
+static void secp256k1_fe_lanes_set(secp256k1_fe_lanes *r, size_t l, const secp256k1_fe *a) {
+    secp256k1_fe t = *a;
+    int j;
+    VERIFY_CHECK(l < SECP256K1_FE_LANES);
+
+    secp256k1_fe_normalize_weak(&t);
+    for (j = 0; j < 5; j++) {
+        r->n[j][l] = t.n[j];
+    }
+}
+
+static void secp256k1_fe_lanes_get(secp256k1_fe *r, const secp256k1_fe_lanes *a, size_t l) {
+    int j;
+    VERIFY_CHECK(l < SECP256K1_FE_LANES);
+
+    for (j = 0; j < 5; j++) {
+        r->n[j] = a->n[j][l];
+    }
+#ifdef VERIFY
+    r->magnitude = 1;
+    r->normalized = 0;
+#endif
+    SECP256K1_FE_VERIFY(r);
+}
+
+#ifdef USE_FIELD_IFMA
+
+/* Eight 5x52 multiplications with VPMADD52LUQ/VPMADD52HUQ, which add the low
+ * and high 52 bits of the 104-bit product of two 52-bit limbs. The product
+ * columns c0..c9 therefore accumulate without carries: c[k] gathers the low
+ * halves of a[i]*b[j] with i+j = k and the high halves with i+j = k-1, each
+ * below 10*2^52. They are folded with 2^260 = R = 0x1000003D10 (mod p) and
+ * 2^256 = 0x1000003D1 (mod p) as in secp256k1_fe_mul_inner, using the same
+ * instructions for the products with R. */
+static void secp256k1_fe_lanes_mul(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, const secp256k1_fe_lanes *b) {
+    const __m512i M = _mm512_set1_epi64(0xFFFFFFFFFFFFFULL);
+    const __m512i M48 = _mm512_set1_epi64(0xFFFFFFFFFFFFULL);
+    const __m512i R = _mm512_set1_epi64(0x1000003D10ULL);
+    const __m512i R4 = _mm512_set1_epi64(0x1000003D1ULL);
+    __m512i x[5], y[5], c[10], t;
+    int i, j;
+
+    for (i = 0; i < 5; i++) {
+        x[i] = _mm512_loadu_si512((const void *)a->n[i]);
+        y[i] = _mm512_loadu_si512((const void *)b->n[i]);
+    }
+    for (i = 0; i < 10; i++) {
+        c[i] = _mm512_setzero_si512();
+    }
+    for (i = 0; i < 5; i++) {
+        for (j = 0; j < 5; j++) {
+            c[i + j] = _mm512_madd52lo_epu64(c[i + j], x[i], y[j]);
+            c[i + j + 1] = _mm512_madd52hi_epu64(c[i + j + 1], x[i], y[j]);
+        }
+    }
+
+    /* Bring c5..c9 below 2^52 so they can be multiplied by R; the carry out
+     * of c9 (below 2^5) is kept in t. */
+    for (i = 5; i < 9; i++) {
+        c[i + 1] = _mm512_add_epi64(c[i + 1], _mm512_srli_epi64(c[i], 52));
+        c[i] = _mm512_and_si512(c[i], M);
+    }
+    t = _mm512_srli_epi64(c[9], 52);
+    c[9] = _mm512_and_si512(c[9], M);
+
+    /* c[j] += lo(R*c[5+j]), c[j+1] += hi(R*c[5+j]); what lands in column 5
+     * (hi(R*c9) + R*t, below 2^43) is folded once more. */
+    for (j = 0; j < 4; j++) {
+        c[j] = _mm512_madd52lo_epu64(c[j], c[5 + j], R);
+        c[j + 1] = _mm512_madd52hi_epu64(c[j + 1], c[5 + j], R);
+    }
+    c[4] = _mm512_madd52lo_epu64(c[4], c[9], R);
+    t = _mm512_madd52lo_epu64(_mm512_madd52hi_epu64(_mm512_setzero_si512(), c[9], R), t, R);
+    c[0] = _mm512_madd52lo_epu64(c[0], t, R);
+    c[1] = _mm512_madd52hi_epu64(c[1], t, R);
+
+    /* Carry c0..c4, fold the bits of c4 above 48 back into c0 and carry again,
+     * leaving every limb below 2^52. */
+    for (i = 0; i < 4; i++) {
+        c[i + 1] = _mm512_add_epi64(c[i + 1], _mm512_srli_epi64(c[i], 52));
+        c[i] = _mm512_and_si512(c[i], M);
+    }
+    t = _mm512_srli_epi64(c[4], 48);
+    c[4] = _mm512_and_si512(c[4], M48);
+    c[0] = _mm512_madd52lo_epu64(c[0], t, R4);
+    for (i = 0; i < 4; i++) {
+        c[i + 1] = _mm512_add_epi64(c[i + 1], _mm512_srli_epi64(c[i], 52));
+        c[i] = _mm512_and_si512(c[i], M);
+    }
+
+    for (i = 0; i < 5; i++) {
+        _mm512_storeu_si512((void *)r->n[i], c[i]);
+    }
+}
+
+#else
+
+static void secp256k1_fe_lanes_mul(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, const secp256k1_fe_lanes *b) {
+    uint64_t x[5], y[5], z[5];
+    size_t l;
+    int j;
+
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        for (j = 0; j < 5; j++) {
+            x[j] = a->n[j][l];
+            y[j] = b->n[j][l];
+        }
+        secp256k1_fe_mul_inner(z, x, y);
+        for (j = 0; j < 5; j++) {
+            r->n[j][l] = z[j];
+        }
+    }
+}
+
+#endif
+
+#endif /* SECP256K1_FIELD_LANES_IMPL_H */
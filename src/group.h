@@ -87,6 +87,14 @@ static void secp256k1_ge_set_all_gej(secp256k1_ge *r, const secp256k1_gej *a, si
 /** Set group elements r[0:len] (affine) equal to group elements a[0:len] (jacobian). */
 static void secp256k1_ge_set_all_gej_var(secp256k1_ge *r, const secp256k1_gej *a, size_t len);
 
+/** Add adjacent pairs of affine group elements: r[i] = a[2i] + a[2i+1] for
+ *  0 <= i < n. All n slopes share one field inversion (Montgomery's trick), so
+ *  each addition costs a handful of multiplications and stays affine. Sums may
+ *  be infinity. None of a[0:2n] may be infinity and their coordinates must have
+ *  magnitude 1, as those of the outputs do. r must not overlap a, and buf must
+ *  have room for n field elements. Not constant time. */
+static void secp256k1_ge_add_pairs_var(secp256k1_ge *r, const secp256k1_ge *a, size_t n, secp256k1_fe *buf);
+
 /** Bring a batch of inputs to the same global z "denominator", based on ratios between
  *  (omitted) z coordinates of adjacent elements.
  *
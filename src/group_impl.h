@@ -10,6 +10,7 @@
 #include <string.h>
 
 #include "field.h"
+#include "field_lanes.h"
 #include "group.h"
 #include "util.h"
 
@@ -233,10 +234,44 @@ static void secp256k1_ge_set_all_gej(secp256k1_ge *r, const secp256k1_gej *a, si
 #endif
 }
 
+/* Set r[idx[k]] to a[idx[k]] rescaled by the inverse of its z held in
+ * r[idx[k]].x, as secp256k1_ge_set_gej_zinv, for n <= SECP256K1_FE_LANES
+ * points. Unused lanes are multiplied as zero. */
+static void secp256k1_ge_set_gej_zinv_lanes(secp256k1_ge *r, const secp256k1_gej *a, const size_t *idx, size_t n) {
+    secp256k1_fe_lanes zi, zi2, x, y;
+    size_t l;
+    VERIFY_CHECK(n <= SECP256K1_FE_LANES);
+
+    memset(&zi, 0, sizeof(zi));
+    memset(&x, 0, sizeof(x));
+    memset(&y, 0, sizeof(y));
+    for (l = 0; l < n; l++) {
+        SECP256K1_GEJ_VERIFY(&a[idx[l]]);
+        VERIFY_CHECK(!a[idx[l]].infinity);
+        secp256k1_fe_lanes_set(&zi, l, &r[idx[l]].x);
+        secp256k1_fe_lanes_set(&x, l, &a[idx[l]].x);
+        secp256k1_fe_lanes_set(&y, l, &a[idx[l]].y);
+    }
+    secp256k1_fe_lanes_mul(&zi2, &zi, &zi);
+    secp256k1_fe_lanes_mul(&x, &x, &zi2);
+    secp256k1_fe_lanes_mul(&zi2, &zi2, &zi);
+    secp256k1_fe_lanes_mul(&y, &y, &zi2);
+    for (l = 0; l < n; l++) {
+        secp256k1_fe_lanes_get(&r[idx[l]].x, &x, l);
+        secp256k1_fe_lanes_get(&r[idx[l]].y, &y, l);
+        r[idx[l]].infinity = 0;
+        SECP256K1_GE_VERIFY(&r[idx[l]]);
+    }
+}
+
 static void secp256k1_ge_set_all_gej_var(secp256k1_ge *r, const secp256k1_gej *a, size_t len) {
     secp256k1_fe u;
     size_t i;
     size_t last_i = SIZE_MAX;
+#ifdef USE_FIELD_IFMA
+    size_t idx[SECP256K1_FE_LANES];
+    size_t n;
+#endif
 #ifdef VERIFY
     for (i = 0; i < len; i++) {
         SECP256K1_GEJ_VERIFY(&a[i]);
@@ -273,11 +308,29 @@ static void secp256k1_ge_set_all_gej_var(secp256k1_ge *r, const secp256k1_gej *a
     VERIFY_CHECK(!a[last_i].infinity);
     r[last_i].x = u;
 
+#ifdef USE_FIELD_IFMA
+    /* The rescaling by the inverses is independent per point, so it runs
+     * SECP256K1_FE_LANES points at a time. */
+    n = 0;
+    for (i = 0; i < len; i++) {
+        if (!a[i].infinity) {
+            idx[n++] = i;
+            if (n == SECP256K1_FE_LANES) {
+                secp256k1_ge_set_gej_zinv_lanes(r, a, idx, n);
+                n = 0;
+            }
+        }
+    }
+    if (n > 0) {
+        secp256k1_ge_set_gej_zinv_lanes(r, a, idx, n);
+    }
+#else
     for (i = 0; i < len; i++) {
         if (!a[i].infinity) {
             secp256k1_ge_set_gej_zinv(&r[i], &a[i], &r[i].x);
         }
     }
+#endif
 
 #ifdef VERIFY
     for (i = 0; i < len; i++) {
@@ -286,6 +339,90 @@ static void secp256k1_ge_set_all_gej_var(secp256k1_ge *r, const secp256k1_gej *a
 #endif
 }
 
+static void secp256k1_ge_add_pairs_var(secp256k1_ge *r, const secp256k1_ge *a, size_t n, secp256k1_fe *buf) {
+    size_t i;
+    secp256k1_fe d, u;
+#ifdef VERIFY
+    for (i = 0; i < 2 * n; i++) {
+        SECP256K1_GE_VERIFY(&a[i]);
+        SECP256K1_FE_VERIFY_MAGNITUDE(&a[i].x, 1);
+        SECP256K1_FE_VERIFY_MAGNITUDE(&a[i].y, 1);
+        VERIFY_CHECK(!a[i].infinity);
+    }
+#endif
+
+    if (n == 0) {
+        return;
+    }
+
+    /* buf[i] is the product of the nonzero x differences of pairs 0..i. Pairs
+     * with equal x (a doubling or P + -P) contribute 1 and are handled below. */
+    for (i = 0; i < n; i++) {
+        secp256k1_fe_negate(&d, &a[2*i].x, 1);
+        secp256k1_fe_add(&d, &a[2*i+1].x);
+        if (secp256k1_fe_normalizes_to_zero_var(&d)) {
+            secp256k1_fe_set_int(&d, 1);
+        }
+        if (i == 0) {
+            buf[0] = d;
+        } else {
+            secp256k1_fe_mul(&buf[i], &buf[i-1], &d);
+        }
+    }
+    secp256k1_fe_inv_var(&u, &buf[n-1]);
+
+    i = n;
+    while (i > 0) {
+        const secp256k1_ge *p, *q;
+        secp256k1_fe lambda, t;
+        i--;
+        p = &a[2*i];
+        q = &a[2*i+1];
+
+        secp256k1_fe_negate(&d, &p->x, 1);
+        secp256k1_fe_add(&d, &q->x);
+        if (secp256k1_fe_normalizes_to_zero_var(&d)) {
+            secp256k1_gej pj;
+            secp256k1_gej_set_ge(&pj, p);
+            secp256k1_gej_add_ge_var(&pj, &pj, q, NULL);
+            secp256k1_ge_set_gej_var(&r[i], &pj);
+            continue;
+        }
+
+        /* lambda = (q.y - p.y) / (q.x - p.x) */
+        if (i > 0) {
+            secp256k1_fe_mul(&t, &u, &buf[i-1]);
+        } else {
+            t = u;
+        }
+        secp256k1_fe_mul(&u, &u, &d);
+        secp256k1_fe_negate(&lambda, &p->y, 1);
+        secp256k1_fe_add(&lambda, &q->y);
+        secp256k1_fe_mul(&lambda, &lambda, &t);
+
+        /* x = lambda^2 - p.x - q.x, y = lambda * (p.x - x) - p.y */
+        t = p->x;
+        secp256k1_fe_add(&t, &q->x);
+        secp256k1_fe_negate(&t, &t, 2);
+        secp256k1_fe_sqr(&r[i].x, &lambda);
+        secp256k1_fe_add(&r[i].x, &t);
+        secp256k1_fe_normalize_weak(&r[i].x);
+        secp256k1_fe_negate(&t, &r[i].x, 1);
+        secp256k1_fe_add(&t, &p->x);
+        secp256k1_fe_mul(&r[i].y, &lambda, &t);
+        secp256k1_fe_negate(&t, &p->y, 1);
+        secp256k1_fe_add(&r[i].y, &t);
+        secp256k1_fe_normalize_weak(&r[i].y);
+        r[i].infinity = 0;
+    }
+
+#ifdef VERIFY
+    for (i = 0; i < n; i++) {
+        SECP256K1_GE_VERIFY(&r[i]);
+    }
+#endif
+}
+
 static void secp256k1_ge_table_set_globalz(size_t len, secp256k1_ge *a, const secp256k1_fe *zr) {
     size_t i;
     secp256k1_fe zs;
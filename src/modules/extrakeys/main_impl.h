@@ -153,6 +153,145 @@ int secp256k1_xonly_pubkey_tweak_add_check(const secp256k1_context* ctx, const u
             && secp256k1_fe_is_odd(&pk.y) == tweaked_pk_parity;
 }
 
+/* Number of differences P_i - Q_i that are computed with one field inversion */
+#define XONLY_TWEAK_CHECK_BATCH_CHUNK 32
+
+typedef struct {
+    const secp256k1_context *ctx;
+    const unsigned char *const *tweaked_pubkey32s;
+    const int *tweaked_pk_parities;
+    const secp256k1_xonly_pubkey *const *internal_pubkeys;
+    size_t n;
+    unsigned char seed[32];
+    /* diff[j] = P_i - Q_i for i = diff_start + j */
+    secp256k1_ge diff[XONLY_TWEAK_CHECK_BATCH_CHUNK];
+    size_t diff_start;
+    size_t diff_len;
+} secp256k1_xonly_pubkey_tweak_add_check_batch_data;
+
+/* Sets a to the factor of check i: 1 for the first check and SHA256(seed || i)
+ * for the others. */
+static void secp256k1_xonly_pubkey_tweak_add_check_batch_randomizer(secp256k1_scalar *a, const unsigned char *seed, size_t i) {
+    unsigned char buf[32];
+    secp256k1_sha256 sha;
+    int j;
+
+    if (i == 0) {
+        secp256k1_scalar_set_int(a, 1);
+        return;
+    }
+    for (j = 0; j < 8; j++) {
+        buf[j] = (unsigned char)((uint64_t)i >> (8 * (7 - j)));
+    }
+    secp256k1_sha256_initialize(&sha);
+    secp256k1_sha256_write(&sha, seed, 32);
+    secp256k1_sha256_write(&sha, buf, 8);
+    secp256k1_sha256_finalize(&sha, buf);
+    secp256k1_scalar_set_b32(a, buf, NULL);
+}
+
+/* Fills data->diff with P_i - Q_i for the chunk starting at check start. */
+static int secp256k1_xonly_pubkey_tweak_add_check_batch_diffs(secp256k1_xonly_pubkey_tweak_add_check_batch_data *data, size_t start) {
+    secp256k1_ge pq[2 * XONLY_TWEAK_CHECK_BATCH_CHUNK];
+    secp256k1_fe buf[XONLY_TWEAK_CHECK_BATCH_CHUNK];
+    size_t len = data->n - start < XONLY_TWEAK_CHECK_BATCH_CHUNK ? data->n - start : XONLY_TWEAK_CHECK_BATCH_CHUNK;
+    size_t j;
+
+    for (j = 0; j < len; j++) {
+        size_t i = start + j;
+        secp256k1_fe qx;
+        if (!secp256k1_xonly_pubkey_load(data->ctx, &pq[2*j], data->internal_pubkeys[i])) {
+            return 0;
+        }
+        if (!secp256k1_fe_set_b32_limit(&qx, data->tweaked_pubkey32s[i])) {
+            return 0;
+        }
+        /* -Q_i, the point with x coordinate qx and the opposite parity */
+        if (!secp256k1_ge_set_xo_var(&pq[2*j+1], &qx, !data->tweaked_pk_parities[i])) {
+            return 0;
+        }
+        secp256k1_fe_normalize_weak(&pq[2*j+1].y);
+    }
+    secp256k1_ge_add_pairs_var(data->diff, pq, len, buf);
+    data->diff_start = start;
+    data->diff_len = len;
+    return 1;
+}
+
+/* Supplies the terms a_i*(P_i - Q_i) of the batch equation
+ * sum(a_i*t_i)*G + sum(a_i*(P_i - Q_i)) = 0. The differences are computed a
+ * chunk at a time with one inversion, so the multiplication has n points
+ * rather than 2n. */
+static int secp256k1_xonly_pubkey_tweak_add_check_batch_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    secp256k1_xonly_pubkey_tweak_add_check_batch_data *data = (secp256k1_xonly_pubkey_tweak_add_check_batch_data *)cbdata;
+
+    if (idx < data->diff_start || idx >= data->diff_start + data->diff_len) {
+        if (!secp256k1_xonly_pubkey_tweak_add_check_batch_diffs(data, idx)) {
+            return 0;
+        }
+    }
+    *pt = data->diff[idx - data->diff_start];
+    secp256k1_xonly_pubkey_tweak_add_check_batch_randomizer(sc, data->seed, idx);
+    return 1;
+}
+
+int secp256k1_xonly_pubkey_tweak_add_check_batch(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, const unsigned char *const *tweaked_pubkey32s, const int *tweaked_pk_parities, const secp256k1_xonly_pubkey *const *internal_pubkeys, const unsigned char *const *tweaks32, size_t n) {
+    secp256k1_xonly_pubkey_tweak_add_check_batch_data data;
+    secp256k1_sha256 sha;
+    secp256k1_scalar t, a, tg;
+    secp256k1_gej rj;
+    unsigned char parity;
+    size_t i;
+    int overflow;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n == 0 || tweaked_pubkey32s != NULL);
+    ARG_CHECK(n == 0 || tweaked_pk_parities != NULL);
+    ARG_CHECK(n == 0 || internal_pubkeys != NULL);
+    ARG_CHECK(n == 0 || tweaks32 != NULL);
+    /* The factors are derived from all inputs, so none of the tweaked keys
+     * can be chosen after them. */
+    secp256k1_sha256_initialize(&sha);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(tweaked_pubkey32s[i] != NULL);
+        ARG_CHECK(internal_pubkeys[i] != NULL);
+        ARG_CHECK(tweaks32[i] != NULL);
+        if (tweaked_pk_parities[i] != 0 && tweaked_pk_parities[i] != 1) {
+            return 0;
+        }
+        parity = (unsigned char)tweaked_pk_parities[i];
+        secp256k1_sha256_write(&sha, tweaked_pubkey32s[i], 32);
+        secp256k1_sha256_write(&sha, &parity, 1);
+        secp256k1_sha256_write(&sha, internal_pubkeys[i]->data, sizeof(internal_pubkeys[i]->data));
+        secp256k1_sha256_write(&sha, tweaks32[i], 32);
+    }
+    secp256k1_sha256_finalize(&sha, data.seed);
+
+    /* tg = sum(a_i*t_i) */
+    secp256k1_scalar_set_int(&tg, 0);
+    for (i = 0; i < n; i++) {
+        secp256k1_scalar_set_b32(&t, tweaks32[i], &overflow);
+        if (overflow) {
+            return 0;
+        }
+        secp256k1_xonly_pubkey_tweak_add_check_batch_randomizer(&a, data.seed, i);
+        secp256k1_scalar_mul(&t, &t, &a);
+        secp256k1_scalar_add(&tg, &tg, &t);
+    }
+
+    data.ctx = ctx;
+    data.tweaked_pubkey32s = tweaked_pubkey32s;
+    data.tweaked_pk_parities = tweaked_pk_parities;
+    data.internal_pubkeys = internal_pubkeys;
+    data.n = n;
+    data.diff_start = 0;
+    data.diff_len = 0;
+    if (!secp256k1_ecmult_multi_var(&ctx->error_callback, scratch, &rj, &tg, secp256k1_xonly_pubkey_tweak_add_check_batch_ecmult_callback, (void *)&data, n)) {
+        return 0;
+    }
+    return secp256k1_gej_is_infinity(&rj);
+}
+
 static void secp256k1_keypair_save(secp256k1_keypair *keypair, const secp256k1_scalar *sk, secp256k1_ge *pk) {
     secp256k1_scalar_get_b32(&keypair->data[0], sk);
     secp256k1_pubkey_save((secp256k1_pubkey *)&keypair->data[32], pk);
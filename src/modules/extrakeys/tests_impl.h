@@ -246,6 +246,69 @@ static void test_xonly_pubkey_tweak_check(void) {
     CHECK(secp256k1_memcmp_var(&output_pk, zeros64, sizeof(output_pk)) == 0);
 }
 
+#define N_BATCH 20
+static void test_xonly_pubkey_tweak_check_batch(void) {
+    unsigned char sk[32];
+    unsigned char tweak[N_BATCH][32];
+    unsigned char output_pk32[N_BATCH][32];
+    unsigned char overflows[32];
+    int parity[N_BATCH];
+    secp256k1_xonly_pubkey internal_xonly_pk[N_BATCH];
+    const unsigned char *tweaks[N_BATCH];
+    const unsigned char *outputs[N_BATCH];
+    const secp256k1_xonly_pubkey *internals[N_BATCH];
+    secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(CTX, 1024 * 1024);
+    int saved_parity;
+    size_t i;
+
+    memset(overflows, 0xff, sizeof(overflows));
+    for (i = 0; i < N_BATCH; i++) {
+        secp256k1_pubkey pk;
+        secp256k1_xonly_pubkey output_xonly_pk;
+        testrand256(sk);
+        testrand256(tweak[i]);
+        CHECK(secp256k1_ec_pubkey_create(CTX, &pk, sk) == 1);
+        CHECK(secp256k1_xonly_pubkey_from_pubkey(CTX, &internal_xonly_pk[i], NULL, &pk) == 1);
+        CHECK(secp256k1_xonly_pubkey_tweak_add(CTX, &pk, &internal_xonly_pk[i], tweak[i]) == 1);
+        CHECK(secp256k1_xonly_pubkey_from_pubkey(CTX, &output_xonly_pk, &parity[i], &pk) == 1);
+        CHECK(secp256k1_xonly_pubkey_serialize(CTX, output_pk32[i], &output_xonly_pk) == 1);
+        tweaks[i] = tweak[i];
+        outputs[i] = output_pk32[i];
+        internals[i] = &internal_xonly_pk[i];
+    }
+
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, outputs, parity, internals, tweaks, N_BATCH) == 1);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, NULL, outputs, parity, internals, tweaks, N_BATCH) == 1);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, outputs, parity, internals, tweaks, 1) == 1);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK_ILLEGAL(CTX, secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, NULL, parity, internals, tweaks, N_BATCH));
+    saved_parity = parity[3];
+
+    /* Wrong pk_parity, including an invalid value */
+    parity[3] = !parity[3];
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, outputs, parity, internals, tweaks, N_BATCH) == 0);
+    parity[3] = 2;
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, outputs, parity, internals, tweaks, N_BATCH) == 0);
+    parity[3] = saved_parity;
+
+    /* Swapped internal keys */
+    internals[7] = &internal_xonly_pk[8];
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, outputs, parity, internals, tweaks, N_BATCH) == 0);
+    internals[7] = &internal_xonly_pk[7];
+
+    /* Wrong tweak */
+    tweaks[N_BATCH - 1] = tweak[0];
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, outputs, parity, internals, tweaks, N_BATCH) == 0);
+    /* Overflowing tweak not allowed */
+    tweaks[N_BATCH - 1] = overflows;
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, outputs, parity, internals, tweaks, N_BATCH) == 0);
+    tweaks[N_BATCH - 1] = tweak[N_BATCH - 1];
+
+    CHECK(secp256k1_xonly_pubkey_tweak_add_check_batch(CTX, scratch, outputs, parity, internals, tweaks, N_BATCH) == 1);
+    secp256k1_scratch_space_destroy(CTX, scratch);
+}
+#undef N_BATCH
+
 /* Starts with an initial pubkey and recursively creates N_PUBKEYS - 1
  * additional pubkeys by calling tweak_add. Then verifies every tweak starting
  * from the last pubkey. */
@@ -468,17 +531,326 @@ static void test_keypair_add(void) {
     }
 }
 
+/* The snapshot has no core tests.c, so the batched key arithmetic of
+ * secp256k1.c that these modules build on is tested here. */
+
+/* Sums pubkeys one at a time like ec_pubkey_combine does for small inputs */
+static int test_pubkey_combine_sequential(secp256k1_pubkey *out, const secp256k1_pubkey * const *pubkeys, size_t n) {
+    secp256k1_gej sumj;
+    secp256k1_ge p;
+    size_t i;
+
+    secp256k1_gej_set_infinity(&sumj);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_pubkey_load(CTX, &p, pubkeys[i]));
+        secp256k1_gej_add_ge(&sumj, &sumj, &p);
+    }
+    if (secp256k1_gej_is_infinity(&sumj)) {
+        return 0;
+    }
+    secp256k1_ge_set_gej(&p, &sumj);
+    secp256k1_pubkey_save(out, &p);
+    return 1;
+}
+
+/* Fills pubkeys with random keys, where every key after the first one is a
+ * copy of the previous key with probability 1/4 and its negation with
+ * probability 1/4 */
+static void test_random_pubkeys(secp256k1_pubkey *pubkeys, const secp256k1_pubkey **ptrs, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        uint32_t r = testrand_int(4);
+        if (i > 0 && r == 0) {
+            pubkeys[i] = pubkeys[i - 1];
+        } else if (i > 0 && r == 1) {
+            pubkeys[i] = pubkeys[i - 1];
+            CHECK(secp256k1_ec_pubkey_negate(CTX, &pubkeys[i]) == 1);
+        } else {
+            testutil_random_pubkey_test(&pubkeys[i]);
+        }
+        ptrs[i] = &pubkeys[i];
+    }
+}
+
+#define N_PAIRS 16
+static void test_ge_add_pairs(void) {
+    secp256k1_ge a[2 * N_PAIRS], r[N_PAIRS];
+    secp256k1_fe buf[N_PAIRS];
+    size_t i, n;
+
+    for (n = 0; n <= N_PAIRS; n++) {
+        for (i = 0; i < n; i++) {
+            testutil_random_ge_test(&a[2*i]);
+            switch (testrand_int(4)) {
+            case 0: /* P + P */
+                a[2*i+1] = a[2*i];
+                break;
+            case 1: /* P + -P */
+                secp256k1_ge_neg(&a[2*i+1], &a[2*i]);
+                break;
+            default:
+                testutil_random_ge_test(&a[2*i+1]);
+            }
+            secp256k1_fe_normalize(&a[2*i].x);
+            secp256k1_fe_normalize(&a[2*i].y);
+            secp256k1_fe_normalize(&a[2*i+1].x);
+            secp256k1_fe_normalize(&a[2*i+1].y);
+        }
+        secp256k1_ge_add_pairs_var(r, a, n, buf);
+        for (i = 0; i < n; i++) {
+            secp256k1_gej sumj;
+            secp256k1_gej_set_ge(&sumj, &a[2*i]);
+            secp256k1_gej_add_ge_var(&sumj, &sumj, &a[2*i+1], NULL);
+            CHECK(secp256k1_gej_eq_ge_var(&sumj, &r[i]));
+        }
+    }
+}
+#undef N_PAIRS
+
+static void test_ec_pubkey_combine_tree_n(size_t n) {
+    secp256k1_pubkey *pubkeys = (secp256k1_pubkey *)checked_malloc(&CTX->error_callback, n * sizeof(*pubkeys));
+    const secp256k1_pubkey **ptrs = (const secp256k1_pubkey **)checked_malloc(&CTX->error_callback, n * sizeof(*ptrs));
+    secp256k1_pubkey sum, expected;
+    unsigned char zeros64[64] = { 0 };
+    size_t i;
+    int ret;
+
+    /* The random keys may cancel out when n is small */
+    test_random_pubkeys(pubkeys, ptrs, n);
+    ret = test_pubkey_combine_sequential(&expected, ptrs, n);
+    CHECK(secp256k1_ec_pubkey_combine(CTX, &sum, ptrs, n) == ret);
+    CHECK(!ret || secp256k1_ec_pubkey_cmp(CTX, &sum, &expected) == 0);
+
+    /* Cancel every key with its negation, so that pairs and whole chunks of
+     * the tree sum to infinity */
+    for (i = 0; i + 1 < n; i += 2) {
+        pubkeys[i + 1] = pubkeys[i];
+        CHECK(secp256k1_ec_pubkey_negate(CTX, &pubkeys[i + 1]) == 1);
+    }
+    if (n % 2 == 0) {
+        CHECK(secp256k1_ec_pubkey_combine(CTX, &sum, ptrs, n) == 0);
+        CHECK(secp256k1_memcmp_var(&sum, zeros64, sizeof(sum)) == 0);
+    } else {
+        CHECK(secp256k1_ec_pubkey_combine(CTX, &sum, ptrs, n) == 1);
+        CHECK(secp256k1_ec_pubkey_cmp(CTX, &sum, &pubkeys[n - 1]) == 0);
+    }
+
+    /* n copies of the same key */
+    for (i = 1; i < n; i++) {
+        pubkeys[i] = pubkeys[0];
+    }
+    CHECK(test_pubkey_combine_sequential(&expected, ptrs, n) == 1);
+    CHECK(secp256k1_ec_pubkey_combine(CTX, &sum, ptrs, n) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(CTX, &sum, &expected) == 0);
+
+    free(ptrs);
+    free(pubkeys);
+}
+
+static void test_ec_pubkey_combine_tree(void) {
+    /* Around the tree threshold, the chunk size, and partial last chunks */
+    static const size_t ns[] = {1, 2, 63, 64, 65, 127, 128, 129, 255, 256, 257, 1001};
+    size_t i;
+
+    for (i = 0; i < sizeof(ns) / sizeof(ns[0]); i++) {
+        test_ec_pubkey_combine_tree_n(ns[i]);
+    }
+}
+
+static int test_pubkey_cmp_qsort(const void *a, const void *b) {
+    return secp256k1_ec_pubkey_cmp(CTX, *(const secp256k1_pubkey * const *)a, *(const secp256k1_pubkey * const *)b);
+}
+
+static void test_ec_pubkey_sort_scratch_n(secp256k1_scratch_space *scratch, size_t n) {
+    secp256k1_pubkey *pubkeys = (secp256k1_pubkey *)checked_malloc(&CTX->error_callback, (n + 1) * sizeof(*pubkeys));
+    const secp256k1_pubkey **sorted = (const secp256k1_pubkey **)checked_malloc(&CTX->error_callback, (n + 1) * sizeof(*sorted));
+    const secp256k1_pubkey **expected = (const secp256k1_pubkey **)checked_malloc(&CTX->error_callback, (n + 1) * sizeof(*expected));
+    size_t i;
+
+    /* Besides the copies and negations of the previous key, which share all
+     * or all but the first byte of their serializations, copy random earlier
+     * keys so that equal keys are not adjacent */
+    test_random_pubkeys(pubkeys, expected, n);
+    for (i = 1; i < n; i++) {
+        if (testrand_int(8) == 0) {
+            pubkeys[i] = pubkeys[testrand_int(i)];
+        }
+    }
+    memcpy(sorted, expected, n * sizeof(*sorted));
+    qsort(expected, n, sizeof(*expected), test_pubkey_cmp_qsort);
+
+    CHECK(secp256k1_ec_pubkey_sort_scratch(CTX, scratch, sorted, n) == 1);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_ec_pubkey_cmp(CTX, sorted[i], expected[i]) == 0);
+    }
+    /* Sorting again leaves the order as it is */
+    CHECK(secp256k1_ec_pubkey_sort_scratch(CTX, scratch, sorted, n) == 1);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_ec_pubkey_cmp(CTX, sorted[i], expected[i]) == 0);
+    }
+
+    free(expected);
+    free(sorted);
+    free(pubkeys);
+}
+
+static void test_ec_pubkey_sort_scratch(void) {
+    static const size_t ns[] = {0, 1, 2, 3, 16, 255, 1000};
+    secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(CTX, 1024 * 1024);
+    secp256k1_scratch_space *small = secp256k1_scratch_space_create(CTX, 64);
+    secp256k1_pubkey pk[2];
+    const secp256k1_pubkey *pks[2];
+    size_t i;
+
+    for (i = 0; i < sizeof(ns) / sizeof(ns[0]); i++) {
+        /* A NULL or too small scratch space falls back to the heapsort */
+        test_ec_pubkey_sort_scratch_n(scratch, ns[i]);
+        test_ec_pubkey_sort_scratch_n(small, ns[i]);
+        test_ec_pubkey_sort_scratch_n(NULL, ns[i]);
+    }
+
+    /* Two equal keys and two keys in reverse order */
+    testutil_random_pubkey_test(&pk[0]);
+    pk[1] = pk[0];
+    pks[0] = &pk[0];
+    pks[1] = &pk[1];
+    CHECK(secp256k1_ec_pubkey_sort_scratch(CTX, scratch, pks, 2) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(CTX, pks[0], pks[1]) == 0);
+    testutil_random_pubkey_test(&pk[1]);
+    if (secp256k1_ec_pubkey_cmp(CTX, &pk[0], &pk[1]) < 0) {
+        pks[0] = &pk[1];
+        pks[1] = &pk[0];
+    }
+    CHECK(secp256k1_ec_pubkey_sort_scratch(CTX, scratch, pks, 2) == 1);
+    CHECK(secp256k1_ec_pubkey_cmp(CTX, pks[0], pks[1]) < 0);
+
+    CHECK_ILLEGAL(CTX, secp256k1_ec_pubkey_sort_scratch(CTX, scratch, NULL, 2));
+    secp256k1_scratch_space_destroy(CTX, small);
+    secp256k1_scratch_space_destroy(CTX, scratch);
+}
+
+/* Computes g_scalar*G + sum(scalars[i]*points[i]) with one tweak_mul per
+ * point and ec_pubkey_combine, where a NULL g_scalar or a zero scalar adds
+ * nothing. Returns 0 if the sum is infinity. */
+static int test_ecmult_multi_reference(secp256k1_pubkey *out, const secp256k1_pubkey * const *points, const unsigned char * const *scalars, size_t n, const unsigned char *g_scalar) {
+    secp256k1_pubkey *terms = (secp256k1_pubkey *)checked_malloc(&CTX->error_callback, (n + 1) * sizeof(*terms));
+    const secp256k1_pubkey **ptrs = (const secp256k1_pubkey **)checked_malloc(&CTX->error_callback, (n + 1) * sizeof(*ptrs));
+    unsigned char zeros32[32] = { 0 };
+    size_t i, m = 0;
+    int ret;
+
+    if (g_scalar != NULL && secp256k1_memcmp_var(g_scalar, zeros32, 32) != 0) {
+        CHECK(secp256k1_ec_pubkey_create(CTX, &terms[m], g_scalar) == 1);
+        ptrs[m] = &terms[m];
+        m++;
+    }
+    for (i = 0; i < n; i++) {
+        if (secp256k1_memcmp_var(scalars[i], zeros32, 32) != 0) {
+            terms[m] = *points[i];
+            CHECK(secp256k1_ec_pubkey_tweak_mul(CTX, &terms[m], scalars[i]) == 1);
+            ptrs[m] = &terms[m];
+            m++;
+        }
+    }
+    ret = m > 0 && secp256k1_ec_pubkey_combine(CTX, out, ptrs, m);
+    free(ptrs);
+    free(terms);
+    return ret;
+}
+
+static void test_ecmult_multi_check(secp256k1_scratch_space *scratch, const secp256k1_pubkey * const *points, const unsigned char * const *scalars, size_t n, const unsigned char *g_scalar) {
+    secp256k1_pubkey out, expected;
+    unsigned char zeros64[64] = { 0 };
+    int ret = test_ecmult_multi_reference(&expected, points, scalars, n, g_scalar);
+
+    CHECK(secp256k1_ecmult_multi(CTX, scratch, &out, points, scalars, n, g_scalar) == ret);
+    if (ret) {
+        CHECK(secp256k1_ec_pubkey_cmp(CTX, &out, &expected) == 0);
+    } else {
+        CHECK(secp256k1_memcmp_var(&out, zeros64, sizeof(out)) == 0);
+    }
+}
+
+#define N_POINTS 200
+static void test_ecmult_multi(void) {
+    /* Up to N_POINTS, where Pippenger takes over from Strauss */
+    static const size_t ns[] = {0, 1, 2, 3, 33, N_POINTS};
+    secp256k1_pubkey pks[N_POINTS];
+    const secp256k1_pubkey *points[N_POINTS];
+    unsigned char sc[N_POINTS][32], g_scalar[32], overflows[32];
+    const unsigned char *scalars[N_POINTS];
+    secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(CTX, 1024 * 1024);
+    secp256k1_pubkey out;
+    size_t i, j;
+
+    memset(overflows, 0xff, sizeof(overflows));
+    for (i = 0; i < N_POINTS; i++) {
+        testutil_random_pubkey_test(&pks[i]);
+        testutil_random_scalar_order_b32(sc[i]);
+        points[i] = &pks[i];
+        scalars[i] = sc[i];
+    }
+    testutil_random_scalar_order_b32(g_scalar);
+
+    for (i = 0; i < sizeof(ns) / sizeof(ns[0]); i++) {
+        test_ecmult_multi_check(scratch, points, scalars, ns[i], g_scalar);
+        test_ecmult_multi_check(scratch, points, scalars, ns[i], NULL);
+        test_ecmult_multi_check(NULL, points, scalars, ns[i], g_scalar);
+        test_ecmult_multi_check(NULL, points, scalars, ns[i], NULL);
+    }
+    /* With n = 0 the arrays may be NULL, and without a G term the sum is
+     * infinity */
+    test_ecmult_multi_check(scratch, NULL, NULL, 0, g_scalar);
+    test_ecmult_multi_check(scratch, NULL, NULL, 0, NULL);
+
+    /* Zero scalars, a repeated point, and a point cancelled by its negation */
+    memset(sc[1], 0, 32);
+    pks[3] = pks[2];
+    pks[5] = pks[4];
+    CHECK(secp256k1_ec_pubkey_negate(CTX, &pks[5]) == 1);
+    memcpy(sc[5], sc[4], 32);
+    for (j = 2; j <= 6; j += 4) {
+        test_ecmult_multi_check(scratch, points, scalars, j, g_scalar);
+        test_ecmult_multi_check(NULL, points, scalars, j, NULL);
+    }
+    test_ecmult_multi_check(scratch, points + 4, scalars + 4, 2, NULL);
+    test_ecmult_multi_check(NULL, points + 4, scalars + 4, 2, NULL);
+    test_ecmult_multi_check(scratch, points, scalars, N_POINTS, g_scalar);
+
+    /* Overflowing scalars */
+    scalars[7] = overflows;
+    CHECK(secp256k1_ecmult_multi(CTX, scratch, &out, points, scalars, N_POINTS, g_scalar) == 0);
+    scalars[7] = sc[7];
+    CHECK(secp256k1_ecmult_multi(CTX, scratch, &out, points, scalars, N_POINTS, overflows) == 0);
+
+    CHECK_ILLEGAL(CTX, secp256k1_ecmult_multi(CTX, scratch, &out, NULL, scalars, 1, g_scalar));
+    CHECK_ILLEGAL(CTX, secp256k1_ecmult_multi(CTX, scratch, &out, points, NULL, 1, g_scalar));
+    points[0] = NULL;
+    CHECK_ILLEGAL(CTX, secp256k1_ecmult_multi(CTX, scratch, &out, points, scalars, 1, g_scalar));
+    points[0] = &pks[0];
+    CHECK(secp256k1_ecmult_multi(CTX, scratch, &out, points, scalars, 1, g_scalar) == 1);
+    secp256k1_scratch_space_destroy(CTX, scratch);
+}
+#undef N_POINTS
+
 /* --- Test registry --- */
 static const struct tf_test_entry tests_extrakeys[] = {
     /* xonly key test cases */
     CASE1(test_xonly_pubkey),
     CASE1(test_xonly_pubkey_tweak),
     CASE1(test_xonly_pubkey_tweak_check),
+    CASE1(test_xonly_pubkey_tweak_check_batch),
     CASE1(test_xonly_pubkey_tweak_recursive),
     CASE1(test_xonly_pubkey_comparison),
     /* keypair tests */
     CASE1(test_keypair),
     CASE1(test_keypair_add),
+    /* key arithmetic */
+    CASE1(test_ge_add_pairs),
+    CASE1(test_ec_pubkey_combine_tree),
+    CASE1(test_ec_pubkey_sort_scratch),
+    CASE1(test_ecmult_multi),
 };
 
 #endif
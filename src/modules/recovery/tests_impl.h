@@ -0,0 +1,259 @@
+/***********************************************************************
+ * Copyright (c) 2013-2015 Pieter Wuille                               *
+ * Distributed under the MIT software license, see the accompanying    *
+ * file COPYING or https://www.opensource.org/licenses/mit-license.php.*
+ ***********************************************************************/
+
+#ifndef SECP256K1_MODULE_RECOVERY_TESTS_H
+#define SECP256K1_MODULE_RECOVERY_TESTS_H
+
+#include "../../../include/secp256k1_recovery.h"
+#include "../../unit_test.h"
+
+static void test_ecdsa_recovery_api(void) {
+    secp256k1_pubkey pubkey;
+    secp256k1_pubkey recpubkey;
+    secp256k1_ecdsa_signature normal_sig;
+    secp256k1_ecdsa_recoverable_signature recsig;
+    unsigned char privkey[32] = { 1 };
+    unsigned char message[32] = { 2 };
+    int recid = 0;
+    unsigned char sig[74];
+    unsigned char zero_privkey[32] = { 0 };
+    unsigned char over_privkey[32] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                       0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+    /* Construct and verify corresponding public key. */
+    CHECK(secp256k1_ec_seckey_verify(CTX, privkey) == 1);
+    CHECK(secp256k1_ec_pubkey_create(CTX, &pubkey, privkey) == 1);
+
+    /* Check bad contexts and NULLs for signing */
+    CHECK(secp256k1_ecdsa_sign_recoverable(CTX, &recsig, message, privkey, NULL, NULL) == 1);
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_sign_recoverable(CTX, NULL, message, privkey, NULL, NULL));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_sign_recoverable(CTX, &recsig, NULL, privkey, NULL, NULL));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_sign_recoverable(CTX, &recsig, message, NULL, NULL, NULL));
+    CHECK_ILLEGAL(STATIC_CTX, secp256k1_ecdsa_sign_recoverable(STATIC_CTX, &recsig, message, privkey, NULL, NULL));
+    /* This will fail or succeed randomly, and in either case will not ARG_CHECK failure */
+    secp256k1_ecdsa_sign_recoverable(CTX, &recsig, message, privkey, secp256k1_nonce_function_default, NULL);
+    /* These will all fail, but not in ARG_CHECK way */
+    CHECK(secp256k1_ecdsa_sign_recoverable(CTX, &recsig, message, zero_privkey, NULL, NULL) == 0);
+    CHECK(secp256k1_ecdsa_sign_recoverable(CTX, &recsig, message, over_privkey, NULL, NULL) == 0);
+    /* This one will succeed. */
+    CHECK(secp256k1_ecdsa_sign_recoverable(CTX, &recsig, message, privkey, NULL, NULL) == 1);
+
+    /* Check bad contexts and NULLs for recovery */
+    CHECK(secp256k1_ecdsa_recover(CTX, &recpubkey, &recsig, message) == 1);
+    CHECK(secp256k1_memcmp_var(&pubkey, &recpubkey, sizeof(pubkey)) == 0);
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recover(CTX, NULL, &recsig, message));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recover(CTX, &recpubkey, NULL, message));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recover(CTX, &recpubkey, &recsig, NULL));
+    /* Recovery does not need the generator tables */
+    CHECK(secp256k1_ecdsa_recover(STATIC_CTX, &recpubkey, &recsig, message) == 1);
+    CHECK(secp256k1_memcmp_var(&pubkey, &recpubkey, sizeof(pubkey)) == 0);
+
+    /* Check NULLs for conversion */
+    CHECK(secp256k1_ecdsa_recoverable_signature_convert(CTX, &normal_sig, &recsig) == 1);
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_convert(CTX, NULL, &recsig));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_convert(CTX, &normal_sig, NULL));
+
+    /* Check NULLs for de/serialization */
+    CHECK(secp256k1_ecdsa_recoverable_signature_serialize_compact(CTX, sig, &recid, &recsig) == 1);
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_serialize_compact(CTX, NULL, &recid, &recsig));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_serialize_compact(CTX, sig, NULL, &recsig));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_serialize_compact(CTX, sig, &recid, NULL));
+
+    CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &recsig, sig, recid) == 1);
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, NULL, sig, recid));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &recsig, NULL, recid));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &recsig, sig, -1));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &recsig, sig, 4));
+    CHECK_ILLEGAL(CTX, secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &recsig, sig, 5));
+    /* overflow in signature will not result in calling illegal_callback */
+    memcpy(sig, over_privkey, 32);
+    CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &recsig, sig, recid) == 0);
+}
+
+static void test_ecdsa_recovery_end_to_end(void) {
+    unsigned char extra[32] = {0x00};
+    unsigned char privkey[32];
+    unsigned char message[32];
+    secp256k1_ecdsa_signature signature[5];
+    secp256k1_ecdsa_recoverable_signature rsignature[5];
+    unsigned char sig[74];
+    secp256k1_pubkey pubkey;
+    secp256k1_pubkey recpubkey;
+    int recid = 0;
+    int i;
+
+    /* Generate a random key and message. */
+    {
+        secp256k1_scalar msg, key;
+        testutil_random_scalar_order_test(&msg);
+        testutil_random_scalar_order_test(&key);
+        secp256k1_scalar_get_b32(privkey, &key);
+        secp256k1_scalar_get_b32(message, &msg);
+    }
+
+    /* Construct and verify corresponding public key. */
+    CHECK(secp256k1_ec_seckey_verify(CTX, privkey) == 1);
+    CHECK(secp256k1_ec_pubkey_create(CTX, &pubkey, privkey) == 1);
+
+    /* Serialize/parse compact and verify/recover. */
+    extra[0] = 0;
+    CHECK(secp256k1_ecdsa_sign_recoverable(CTX, &rsignature[0], message, privkey, NULL, NULL) == 1);
+    CHECK(secp256k1_ecdsa_sign(CTX, &signature[0], message, privkey, NULL, NULL) == 1);
+    CHECK(secp256k1_ecdsa_sign_recoverable(CTX, &rsignature[4], message, privkey, NULL, NULL) == 1);
+    CHECK(secp256k1_ecdsa_sign_recoverable(CTX, &rsignature[1], message, privkey, NULL, extra) == 1);
+    extra[31] = 1;
+    CHECK(secp256k1_ecdsa_sign_recoverable(CTX, &rsignature[2], message, privkey, NULL, extra) == 1);
+    extra[31] = 0;
+    extra[0] = 1;
+    CHECK(secp256k1_ecdsa_sign_recoverable(CTX, &rsignature[3], message, privkey, NULL, extra) == 1);
+    CHECK(secp256k1_ecdsa_recoverable_signature_serialize_compact(CTX, sig, &recid, &rsignature[4]) == 1);
+    CHECK(secp256k1_ecdsa_recoverable_signature_convert(CTX, &signature[4], &rsignature[4]) == 1);
+    CHECK(secp256k1_memcmp_var(&signature[4], &signature[0], 64) == 0);
+    CHECK(secp256k1_ecdsa_verify(CTX, &signature[4], message, &pubkey) == 1);
+    memset(&rsignature[4], 0, sizeof(rsignature[4]));
+    CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsignature[4], sig, recid) == 1);
+    CHECK(secp256k1_ecdsa_recoverable_signature_convert(CTX, &signature[4], &rsignature[4]) == 1);
+    CHECK(secp256k1_ecdsa_verify(CTX, &signature[4], message, &pubkey) == 1);
+    /* Parse compact (with recovery id) and recover. */
+    CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsignature[4], sig, recid) == 1);
+    CHECK(secp256k1_ecdsa_recover(CTX, &recpubkey, &rsignature[4], message) == 1);
+    CHECK(secp256k1_memcmp_var(&pubkey, &recpubkey, sizeof(pubkey)) == 0);
+    /* Every recoverable signature converts to one that verifies and recovers the key. */
+    for (i = 0; i < 4; i++) {
+        CHECK(secp256k1_ecdsa_recoverable_signature_convert(CTX, &signature[i], &rsignature[i]) == 1);
+        CHECK(secp256k1_ecdsa_verify(CTX, &signature[i], message, &pubkey) == 1);
+        CHECK(secp256k1_ecdsa_recover(CTX, &recpubkey, &rsignature[i], message) == 1);
+        CHECK(secp256k1_memcmp_var(&pubkey, &recpubkey, sizeof(pubkey)) == 0);
+    }
+    /* A wrong recovery id recovers a different key, or none. */
+    for (i = 1; i < 4; i++) {
+        CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsignature[4], sig, recid ^ i) == 1);
+        CHECK(secp256k1_ecdsa_recover(CTX, &recpubkey, &rsignature[4], message) == 0 ||
+              secp256k1_memcmp_var(&pubkey, &recpubkey, sizeof(pubkey)) != 0);
+    }
+    /* Serialize/destroy/parse signature and verify again. */
+    CHECK(secp256k1_ecdsa_recoverable_signature_serialize_compact(CTX, sig, &recid, &rsignature[4]) == 1);
+    sig[testrand_bits(6)] += 1 + testrand_int(255);
+    CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsignature[4], sig, recid) == 1);
+    CHECK(secp256k1_ecdsa_recoverable_signature_convert(CTX, &signature[4], &rsignature[4]) == 1);
+    CHECK(secp256k1_ecdsa_verify(CTX, &signature[4], message, &pubkey) == 0);
+    /* Recover again */
+    CHECK(secp256k1_ecdsa_recover(CTX, &recpubkey, &rsignature[4], message) == 0 ||
+          secp256k1_memcmp_var(&pubkey, &recpubkey, sizeof(pubkey)) != 0);
+}
+
+/* Signing almost never yields recovery id 2 or 3: they need the x coordinate
+ * of R to exceed the group order, which happens with probability about
+ * 2^-127. Build such signatures from a point R with x = r + n instead, and
+ * check that the key recovered for every recid verifies the signature and
+ * survives a serialize/parse round-trip. */
+static void test_ecdsa_recovery_recid(void) {
+    unsigned char message[32];
+    unsigned char sig[64];
+    unsigned char sig2[64];
+    secp256k1_ecdsa_recoverable_signature rsig;
+    secp256k1_ecdsa_signature nsig;
+    secp256k1_pubkey recpubkey[4];
+    secp256k1_scalar r, s;
+    secp256k1_fe x;
+    secp256k1_ge R;
+    unsigned char rb[32];
+    int recid, recid2, i, j;
+    unsigned int k;
+
+    testrand256_test(message);
+    /* Find the smallest r for which r + n is an X coordinate on the curve. */
+    for (k = 1; ; k++) {
+        secp256k1_scalar_set_int(&r, k);
+        secp256k1_scalar_get_b32(rb, &r);
+        CHECK(secp256k1_fe_set_b32_limit(&x, rb));
+        secp256k1_fe_add(&x, &secp256k1_ecdsa_const_order_as_fe);
+        if (secp256k1_ge_set_xo_var(&R, &x, 0)) {
+            break;
+        }
+    }
+    testutil_random_scalar_order_test(&s);
+    if (secp256k1_scalar_is_high(&s)) {
+        secp256k1_scalar_negate(&s, &s);
+    }
+    secp256k1_scalar_get_b32(&sig[0], &r);
+    secp256k1_scalar_get_b32(&sig[32], &s);
+
+    for (recid = 0; recid < 4; recid++) {
+        CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsig, sig, recid) == 1);
+        CHECK(secp256k1_ecdsa_recoverable_signature_serialize_compact(CTX, sig2, &recid2, &rsig) == 1);
+        CHECK(recid2 == recid);
+        CHECK(secp256k1_memcmp_var(sig, sig2, 64) == 0);
+        CHECK(secp256k1_ecdsa_recover(CTX, &recpubkey[recid], &rsig, message) == 1);
+        CHECK(secp256k1_ecdsa_recoverable_signature_convert(CTX, &nsig, &rsig) == 1);
+        CHECK(secp256k1_ecdsa_verify(CTX, &nsig, message, &recpubkey[recid]) == 1);
+    }
+    /* The four candidates for R give four different keys. */
+    for (i = 0; i < 4; i++) {
+        for (j = i + 1; j < 4; j++) {
+            CHECK(secp256k1_memcmp_var(&recpubkey[i], &recpubkey[j], sizeof(recpubkey[i])) != 0);
+        }
+    }
+
+    /* With r at or above p - n, r + n is not a field element, so recid 2 and 3 fail. */
+    secp256k1_scalar_set_int(&r, 1);
+    secp256k1_scalar_negate(&r, &r);
+    secp256k1_scalar_get_b32(&sig[0], &r);
+    for (recid = 2; recid < 4; recid++) {
+        CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsig, sig, recid) == 1);
+        CHECK(secp256k1_ecdsa_recover(CTX, &recpubkey[0], &rsig, message) == 0);
+    }
+}
+
+static void test_ecdsa_recovery_edge_cases(void) {
+    const unsigned char order[32] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+        0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b,
+        0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x41
+    };
+    unsigned char msg32[32] = { 1 };
+    unsigned char sig64[64];
+    secp256k1_ecdsa_recoverable_signature rsig;
+    secp256k1_pubkey pubkey;
+    int recid;
+
+    /* r or s equal to the order overflows, and parsing fails */
+    for (recid = 0; recid < 4; recid++) {
+        memcpy(sig64, order, 32);
+        memset(sig64 + 32, 0, 32);
+        sig64[63] = 1;
+        CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsig, sig64, recid) == 0);
+        memset(sig64, 0, 32);
+        sig64[31] = 1;
+        memcpy(sig64 + 32, order, 32);
+        CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsig, sig64, recid) == 0);
+        memset(sig64, 0xff, 64);
+        CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsig, sig64, recid) == 0);
+    }
+
+    /* r = 0 or s = 0 parses, but recovers nothing */
+    memset(sig64, 0, 64);
+    sig64[63] = 1;
+    CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsig, sig64, 0) == 1);
+    CHECK(secp256k1_ecdsa_recover(CTX, &pubkey, &rsig, msg32) == 0);
+    memset(sig64, 0, 64);
+    sig64[31] = 1;
+    CHECK(secp256k1_ecdsa_recoverable_signature_parse_compact(CTX, &rsig, sig64, 0) == 1);
+    CHECK(secp256k1_ecdsa_recover(CTX, &pubkey, &rsig, msg32) == 0);
+}
+
+/* --- Test registry --- */
+static const struct tf_test_entry tests_recovery[] = {
+    CASE1(test_ecdsa_recovery_api),
+    CASE1(test_ecdsa_recovery_end_to_end),
+    CASE1(test_ecdsa_recovery_recid),
+    CASE1(test_ecdsa_recovery_edge_cases),
+};
+
+#endif /* SECP256K1_MODULE_RECOVERY_TESTS_H */
@@ -19,6 +19,10 @@ typedef struct {
     const unsigned char **pk;
     const unsigned char **sigs;
     const unsigned char **msgs;
+
+    secp256k1_scratch_space *scratch;
+    const secp256k1_xonly_pubkey **xpks;
+    size_t *msglens;
 } bench_schnorrsig_data;
 
 static void bench_schnorrsig_sign(void* arg, int iters) {
@@ -45,6 +49,12 @@ static void bench_schnorrsig_verify(void* arg, int iters) {
     }
 }
 
+static void bench_schnorrsig_verify_batch(void* arg, int iters) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+
+    CHECK(secp256k1_schnorrsig_verify_batch(data->ctx, data->scratch, data->sigs, data->msgs, data->msglens, data->xpks, iters) == 1);
+}
+
 static void run_schnorrsig_bench(int iters, int argc, char** argv) {
     int i;
     bench_schnorrsig_data data;
@@ -55,6 +65,9 @@ static void run_schnorrsig_bench(int iters, int argc, char** argv) {
     data.pk = (const unsigned char **)malloc(iters * sizeof(unsigned char *));
     data.msgs = (const unsigned char **)malloc(iters * sizeof(unsigned char *));
     data.sigs = (const unsigned char **)malloc(iters * sizeof(unsigned char *));
+    data.xpks = (const secp256k1_xonly_pubkey **)malloc(iters * sizeof(secp256k1_xonly_pubkey *));
+    data.msglens = (size_t *)malloc(iters * sizeof(size_t));
+    data.scratch = secp256k1_scratch_space_create(data.ctx, 1024 * 1024);
 
     CHECK(MSGLEN >= 4);
     for (i = 0; i < iters; i++) {
@@ -63,6 +76,7 @@ static void run_schnorrsig_bench(int iters, int argc, char** argv) {
         unsigned char *sig = (unsigned char *)malloc(64);
         secp256k1_keypair *keypair = (secp256k1_keypair *)malloc(sizeof(*keypair));
         unsigned char *pk_char = (unsigned char *)malloc(32);
+        secp256k1_xonly_pubkey *xpk = (secp256k1_xonly_pubkey *)malloc(sizeof(*xpk));
         secp256k1_xonly_pubkey pk;
         msg[0] = sk[0] = i;
         msg[1] = sk[1] = i >> 8;
@@ -75,21 +89,26 @@ static void run_schnorrsig_bench(int iters, int argc, char** argv) {
         data.pk[i] = pk_char;
         data.msgs[i] = msg;
         data.sigs[i] = sig;
+        data.xpks[i] = xpk;
+        data.msglens[i] = MSGLEN;
 
         CHECK(secp256k1_keypair_create(data.ctx, keypair, sk));
         CHECK(secp256k1_schnorrsig_sign_custom(data.ctx, sig, msg, MSGLEN, keypair, NULL));
         CHECK(secp256k1_keypair_xonly_pub(data.ctx, &pk, NULL, keypair));
         CHECK(secp256k1_xonly_pubkey_serialize(data.ctx, pk_char, &pk) == 1);
+        *xpk = pk;
     }
 
     if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "sign") || have_flag(argc, argv, "schnorrsig_sign")) run_benchmark("schnorrsig_sign", bench_schnorrsig_sign, NULL, NULL, (void *) &data, 10, iters);
     if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "schnorrsig_verify")) run_benchmark("schnorrsig_verify", bench_schnorrsig_verify, NULL, NULL, (void *) &data, 10, iters);
+    if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "schnorrsig_verify_batch")) run_benchmark("schnorrsig_verify_batch", bench_schnorrsig_verify_batch, NULL, NULL, (void *) &data, 10, iters);
 
     for (i = 0; i < iters; i++) {
         free((void *)data.keypairs[i]);
         free((void *)data.pk[i]);
         free((void *)data.msgs[i]);
         free((void *)data.sigs[i]);
+        free((void *)data.xpks[i]);
     }
 
     /* Casting to (void *) avoids a stupid warning in MSVC. */
@@ -97,6 +116,10 @@ static void run_schnorrsig_bench(int iters, int argc, char** argv) {
     free((void *)data.pk);
     free((void *)data.msgs);
     free((void *)data.sigs);
+    free((void *)data.xpks);
+    free(data.msglens);
+
+    secp256k1_scratch_space_destroy(data.ctx, data.scratch);
 
     secp256k1_context_destroy(data.ctx);
 }
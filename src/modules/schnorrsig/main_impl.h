@@ -269,4 +269,273 @@ int secp256k1_schnorrsig_verify(const secp256k1_context* ctx, const unsigned cha
            secp256k1_fe_equal(&rx, &r.x);
 }
 
+typedef struct {
+    const secp256k1_context *ctx;
+    const unsigned char *const *sigs;
+    const unsigned char *const *msgs;
+    const size_t *msglens;
+    const secp256k1_xonly_pubkey *const *pubkeys;
+    unsigned char seed[32];
+} secp256k1_schnorrsig_verify_batch_data;
+
+/* Sets a to the randomizer of signature i: 1 for the first signature and
+ * SHA256(seed || i) for the others. */
+static void secp256k1_schnorrsig_batch_randomizer(secp256k1_scalar *a, const unsigned char *seed, size_t i) {
+    unsigned char buf[32];
+    secp256k1_sha256 sha;
+    int j;
+
+    if (i == 0) {
+        secp256k1_scalar_set_int(a, 1);
+        return;
+    }
+    for (j = 0; j < 8; j++) {
+        buf[j] = (unsigned char)((uint64_t)i >> (8 * (7 - j)));
+    }
+    secp256k1_sha256_initialize(&sha);
+    secp256k1_sha256_write(&sha, seed, 32);
+    secp256k1_sha256_write(&sha, buf, 8);
+    secp256k1_sha256_finalize(&sha, buf);
+    secp256k1_scalar_set_b32(a, buf, NULL);
+}
+
+/* Checks the inputs and derives the seed of the randomizers from all of
+ * them, so none of the signatures can be chosen after the randomizers. */
+static int secp256k1_schnorrsig_verify_batch_init(const secp256k1_context *ctx, secp256k1_schnorrsig_verify_batch_data *data, const unsigned char *const *sigs, const unsigned char *const *msgs, const size_t *msglens, const secp256k1_xonly_pubkey *const *pubkeys, size_t n) {
+    secp256k1_sha256 sha;
+    unsigned char buf[8];
+    size_t i;
+    int j;
+
+    ARG_CHECK(n == 0 || sigs != NULL);
+    ARG_CHECK(n == 0 || msgs != NULL);
+    ARG_CHECK(n == 0 || msglens != NULL);
+    ARG_CHECK(n == 0 || pubkeys != NULL);
+    /* Every signature contributes two points */
+    ARG_CHECK(n <= SIZE_MAX / 2);
+
+    secp256k1_sha256_initialize(&sha);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(sigs[i] != NULL);
+        ARG_CHECK(msgs[i] != NULL || msglens[i] == 0);
+        ARG_CHECK(pubkeys[i] != NULL);
+        for (j = 0; j < 8; j++) {
+            buf[j] = (unsigned char)((uint64_t)msglens[i] >> (8 * (7 - j)));
+        }
+        secp256k1_sha256_write(&sha, sigs[i], 64);
+        secp256k1_sha256_write(&sha, pubkeys[i]->data, sizeof(pubkeys[i]->data));
+        secp256k1_sha256_write(&sha, buf, 8);
+        secp256k1_sha256_write(&sha, msgs[i], msglens[i]);
+    }
+    secp256k1_sha256_finalize(&sha, data->seed);
+
+    data->ctx = ctx;
+    data->sigs = sigs;
+    data->msgs = msgs;
+    data->msglens = msglens;
+    data->pubkeys = pubkeys;
+    return 1;
+}
+
+/* A range of signatures lo <= i < hi of a batch. Running it sets sg to the
+ * range's share sum(a_i*s_i) of the scalar of G and r to the sum of its
+ * point terms, plus sg*G if with_g is set.
+ *
+ * The randomizers of the range are computed once into a, which is allocated
+ * on the scratch space, and the terms of R_i and P_i read them from there. If
+ * the scratch space has no room for them, a is NULL and the terms compute
+ * a_i again, once per signature; the point-by-point multiplication used
+ * without scratch space dwarfs that. */
+typedef struct {
+    const secp256k1_schnorrsig_verify_batch_data *data;
+    secp256k1_scratch *scratch;
+    size_t lo, hi;
+    int with_g;
+    secp256k1_scalar sg;
+    secp256k1_gej r;
+    int ret;
+    secp256k1_scalar *a;
+    secp256k1_scalar last_a;
+    size_t last_i;
+} secp256k1_schnorrsig_verify_batch_task;
+
+static void secp256k1_schnorrsig_verify_batch_task_randomizer(secp256k1_scalar *a, secp256k1_schnorrsig_verify_batch_task *task, size_t i) {
+    if (task->a != NULL) {
+        *a = task->a[i - task->lo];
+        return;
+    }
+    if (task->last_i != i) {
+        secp256k1_schnorrsig_batch_randomizer(&task->last_a, task->data->seed, i);
+        task->last_i = i;
+    }
+    *a = task->last_a;
+}
+
+/* Supplies the terms -a_i*R_i (even idx) and -a_i*e_i*P_i (odd idx) of the
+ * batch equation sum(a_i*s_i)*G - sum(a_i*R_i) - sum(a_i*e_i*P_i) = 0 for a
+ * task's range, which the multiplication indexes from 0. */
+static int secp256k1_schnorrsig_verify_batch_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    secp256k1_schnorrsig_verify_batch_task *task = (secp256k1_schnorrsig_verify_batch_task *)cbdata;
+    const secp256k1_schnorrsig_verify_batch_data *data = task->data;
+    size_t i = task->lo + idx / 2;
+    secp256k1_scalar a;
+
+    secp256k1_schnorrsig_verify_batch_task_randomizer(&a, task, i);
+    if (idx % 2 == 0) {
+        /* R_i is the point with even y and x coordinate r_i */
+        secp256k1_fe rx;
+        if (!secp256k1_fe_set_b32_limit(&rx, &data->sigs[i][0])) {
+            return 0;
+        }
+        if (!secp256k1_ge_set_xo_var(pt, &rx, 0)) {
+            return 0;
+        }
+        secp256k1_scalar_negate(sc, &a);
+    } else {
+        unsigned char buf[32];
+        secp256k1_scalar e;
+        if (!secp256k1_xonly_pubkey_load(data->ctx, pt, data->pubkeys[i])) {
+            return 0;
+        }
+        secp256k1_fe_get_b32(buf, &pt->x);
+        secp256k1_schnorrsig_challenge(&e, &data->sigs[i][0], data->msgs[i], data->msglens[i], buf);
+        secp256k1_scalar_mul(sc, &e, &a);
+        secp256k1_scalar_negate(sc, sc);
+    }
+    return 1;
+}
+
+/* Sets the task's sg = sum(a_i*s_i) over its range, storing the a_i if it
+ * has room for them, and fails if any s_i overflows. */
+static int secp256k1_schnorrsig_verify_batch_sg(secp256k1_schnorrsig_verify_batch_task *task) {
+    secp256k1_scalar s, a;
+    size_t i;
+    int overflow;
+
+    secp256k1_scalar_set_int(&task->sg, 0);
+    for (i = task->lo; i < task->hi; i++) {
+        secp256k1_scalar_set_b32(&s, &task->data->sigs[i][32], &overflow);
+        if (overflow) {
+            return 0;
+        }
+        secp256k1_schnorrsig_batch_randomizer(&a, task->data->seed, i);
+        if (task->a != NULL) {
+            task->a[i - task->lo] = a;
+        }
+        secp256k1_scalar_mul(&s, &s, &a);
+        secp256k1_scalar_add(&task->sg, &task->sg, &s);
+    }
+    return 1;
+}
+
+static void secp256k1_schnorrsig_verify_batch_task_init(secp256k1_schnorrsig_verify_batch_task *task, const secp256k1_schnorrsig_verify_batch_data *data, secp256k1_scratch *scratch, size_t lo, size_t hi, int with_g) {
+    task->data = data;
+    task->scratch = scratch;
+    task->lo = lo;
+    task->hi = hi;
+    task->with_g = with_g;
+    task->ret = 0;
+    task->a = NULL;
+    /* No signature has this index, as n <= SIZE_MAX / 2 */
+    task->last_i = SIZE_MAX;
+}
+
+static void secp256k1_schnorrsig_verify_batch_task_run(void *arg) {
+    secp256k1_schnorrsig_verify_batch_task *task = (secp256k1_schnorrsig_verify_batch_task *)arg;
+    const secp256k1_callback *error_callback = &task->data->ctx->error_callback;
+    size_t checkpoint = 0;
+
+    if (task->scratch != NULL && task->hi > task->lo) {
+        checkpoint = secp256k1_scratch_checkpoint(error_callback, task->scratch);
+        task->a = (secp256k1_scalar *)secp256k1_scratch_alloc(error_callback, task->scratch, (task->hi - task->lo) * sizeof(*task->a));
+    }
+    task->ret = secp256k1_schnorrsig_verify_batch_sg(task) &&
+                secp256k1_ecmult_multi_var(error_callback, task->scratch, &task->r, task->with_g ? &task->sg : NULL, secp256k1_schnorrsig_verify_batch_ecmult_callback, (void *)task, 2 * (task->hi - task->lo));
+    if (task->a != NULL) {
+        secp256k1_scratch_apply_checkpoint(error_callback, task->scratch, checkpoint);
+        task->a = NULL;
+    }
+}
+
+int secp256k1_schnorrsig_verify_batch(const secp256k1_context *ctx, secp256k1_scratch_space *scratch, const unsigned char *const *sigs, const unsigned char *const *msgs, const size_t *msglens, const secp256k1_xonly_pubkey *const *pubkeys, size_t n) {
+    secp256k1_schnorrsig_verify_batch_data data;
+    secp256k1_schnorrsig_verify_batch_task task;
+
+    VERIFY_CHECK(ctx != NULL);
+    if (!secp256k1_schnorrsig_verify_batch_init(ctx, &data, sigs, msgs, msglens, pubkeys, n)) {
+        return 0;
+    }
+    secp256k1_schnorrsig_verify_batch_task_init(&task, &data, scratch, 0, n, 1);
+    secp256k1_schnorrsig_verify_batch_task_run(&task);
+    return task.ret && secp256k1_gej_is_infinity(&task.r);
+}
+
+int secp256k1_schnorrsig_verify_batch_parallel(const secp256k1_context *ctx, size_t n_tasks, size_t scratch_size, secp256k1_batch_task_runner runner, void *runner_data, const unsigned char *const *sigs, const unsigned char *const *msgs, const size_t *msglens, const secp256k1_xonly_pubkey *const *pubkeys, size_t n) {
+    secp256k1_schnorrsig_verify_batch_data data;
+    secp256k1_schnorrsig_verify_batch_task *tasks;
+    void **args;
+    secp256k1_scalar sg;
+    secp256k1_gej rj;
+    size_t i, lo;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n_tasks > 0);
+    if (!secp256k1_schnorrsig_verify_batch_init(ctx, &data, sigs, msgs, msglens, pubkeys, n)) {
+        return 0;
+    }
+    if (n == 0) {
+        return 1;
+    }
+    if (n_tasks > n) {
+        n_tasks = n;
+    }
+
+    tasks = (secp256k1_schnorrsig_verify_batch_task *)checked_malloc(&ctx->error_callback, n_tasks * sizeof(*tasks));
+    args = (void **)checked_malloc(&ctx->error_callback, n_tasks * sizeof(*args));
+    if (tasks == NULL || args == NULL) {
+        free(tasks);
+        free(args);
+        return 0;
+    }
+    /* Task i takes the signatures [i*n/n_tasks, (i+1)*n/n_tasks) */
+    lo = 0;
+    for (i = 0; i < n_tasks; i++) {
+        size_t hi = n / n_tasks * (i + 1) + n % n_tasks * (i + 1) / n_tasks;
+        secp256k1_schnorrsig_verify_batch_task_init(&tasks[i], &data, scratch_size > 0 ? secp256k1_scratch_create(&ctx->error_callback, scratch_size) : NULL, lo, hi, 0);
+        lo = hi;
+        args[i] = &tasks[i];
+    }
+
+    if (runner != NULL) {
+        ret = runner(secp256k1_schnorrsig_verify_batch_task_run, (void *const *)args, n_tasks, runner_data);
+    } else {
+        for (i = 0; i < n_tasks; i++) {
+            secp256k1_schnorrsig_verify_batch_task_run(args[i]);
+        }
+        ret = 1;
+    }
+
+    /* Combine the partial sums: rj = sum(r_i) + sum(sg_i)*G */
+    secp256k1_scalar_set_int(&sg, 0);
+    secp256k1_gej_set_infinity(&rj);
+    for (i = 0; i < n_tasks; i++) {
+        ret = ret && tasks[i].ret;
+        if (ret) {
+            secp256k1_scalar_add(&sg, &sg, &tasks[i].sg);
+            secp256k1_gej_add_var(&rj, &rj, &tasks[i].r, NULL);
+        }
+        if (tasks[i].scratch != NULL) {
+            secp256k1_scratch_destroy(&ctx->error_callback, tasks[i].scratch);
+        }
+    }
+    free(tasks);
+    free(args);
+    if (!ret) {
+        return 0;
+    }
+    secp256k1_ecmult(&rj, &rj, &secp256k1_scalar_one, &sg);
+    return secp256k1_gej_is_infinity(&rj);
+}
+
 #endif
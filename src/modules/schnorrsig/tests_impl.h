@@ -930,6 +930,125 @@ static void test_schnorrsig_sign_verify_internal(void) {
 }
 #undef N_SIGS
 
+#define N_BATCH 20
+/* Verifies a batch of valid signatures with and without a scratch space, and
+ * checks that a single bad signature, message or key fails the batch. */
+static void test_schnorrsig_verify_batch(void) {
+    unsigned char sk[32];
+    unsigned char msg[N_BATCH][32];
+    unsigned char sig[N_BATCH][64];
+    secp256k1_xonly_pubkey pk[N_BATCH];
+    const unsigned char *sigs[N_BATCH];
+    const unsigned char *msgs[N_BATCH];
+    size_t msglens[N_BATCH];
+    const secp256k1_xonly_pubkey *pks[N_BATCH];
+    secp256k1_scratch_space *scratch;
+    secp256k1_keypair keypair;
+    size_t i;
+
+    for (i = 0; i < N_BATCH; i++) {
+        testrand256(sk);
+        testrand256(msg[i]);
+        CHECK(secp256k1_keypair_create(CTX, &keypair, sk));
+        CHECK(secp256k1_keypair_xonly_pub(CTX, &pk[i], NULL, &keypair));
+        CHECK(secp256k1_schnorrsig_sign32(CTX, sig[i], msg[i], &keypair, NULL));
+        sigs[i] = sig[i];
+        msgs[i] = msg[i];
+        msglens[i] = sizeof(msg[i]);
+        pks[i] = &pk[i];
+    }
+
+    scratch = secp256k1_scratch_space_create(CTX, 1024 * 1024);
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, scratch, sigs, msgs, msglens, pks, N_BATCH) == 1);
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, NULL, sigs, msgs, msglens, pks, N_BATCH) == 1);
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, scratch, NULL, NULL, NULL, NULL, 0) == 1);
+
+    for (i = 0; i < N_BATCH; i += 7) {
+        size_t byte = testrand_int(64);
+        unsigned char flip = 1 << testrand_int(8);
+        sig[i][byte] ^= flip;
+        CHECK(secp256k1_schnorrsig_verify_batch(CTX, scratch, sigs, msgs, msglens, pks, N_BATCH) == 0);
+        sig[i][byte] ^= flip;
+    }
+    pks[5] = &pk[6];
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, scratch, sigs, msgs, msglens, pks, N_BATCH) == 0);
+    pks[5] = &pk[5];
+
+    /* A signature swapped onto another message fails */
+    msgs[0] = msg[1];
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, scratch, sigs, msgs, msglens, pks, 1) == 0);
+
+    /* Subsets of a valid batch pass */
+    msgs[0] = msg[0];
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, scratch, sigs, msgs, msglens, pks, 1) == 1);
+    secp256k1_scratch_space_destroy(CTX, scratch);
+}
+
+/* Runs the tasks last to first, to check that their order does not matter */
+static int test_batch_runner_reverse(secp256k1_batch_task_function fn, void *const *args, size_t n_tasks, void *data) {
+    size_t *calls = (size_t *)data;
+    while (n_tasks > 0) {
+        fn(args[--n_tasks]);
+        (*calls)++;
+    }
+    return 1;
+}
+
+static int test_batch_runner_fail(secp256k1_batch_task_function fn, void *const *args, size_t n_tasks, void *data) {
+    (void)fn;
+    (void)args;
+    (void)n_tasks;
+    (void)data;
+    return 0;
+}
+
+/* Checks that secp256k1_schnorrsig_verify_batch_parallel agrees with
+ * secp256k1_schnorrsig_verify_batch for any number of tasks. */
+static void test_schnorrsig_verify_batch_parallel(void) {
+    unsigned char sk[32];
+    unsigned char msg[N_BATCH][32];
+    unsigned char sig[N_BATCH][64];
+    secp256k1_xonly_pubkey pk[N_BATCH];
+    const unsigned char *sigs[N_BATCH];
+    const unsigned char *msgs[N_BATCH];
+    size_t msglens[N_BATCH];
+    const secp256k1_xonly_pubkey *pks[N_BATCH];
+    secp256k1_keypair keypair;
+    size_t i, n_tasks, calls;
+
+    for (i = 0; i < N_BATCH; i++) {
+        testrand256(sk);
+        testrand256(msg[i]);
+        CHECK(secp256k1_keypair_create(CTX, &keypair, sk));
+        CHECK(secp256k1_keypair_xonly_pub(CTX, &pk[i], NULL, &keypair));
+        CHECK(secp256k1_schnorrsig_sign32(CTX, sig[i], msg[i], &keypair, NULL));
+        sigs[i] = sig[i];
+        msgs[i] = msg[i];
+        msglens[i] = sizeof(msg[i]);
+        pks[i] = &pk[i];
+    }
+
+    for (n_tasks = 1; n_tasks <= N_BATCH + 1; n_tasks += 3) {
+        calls = 0;
+        CHECK(secp256k1_schnorrsig_verify_batch_parallel(CTX, n_tasks, 1024 * 1024, test_batch_runner_reverse, &calls, sigs, msgs, msglens, pks, N_BATCH) == 1);
+        CHECK(calls == (n_tasks < N_BATCH ? n_tasks : N_BATCH));
+        CHECK(secp256k1_schnorrsig_verify_batch_parallel(CTX, n_tasks, 0, NULL, NULL, sigs, msgs, msglens, pks, N_BATCH) == 1);
+
+        /* A bad signature fails whichever task it lands in */
+        i = testrand_int(N_BATCH);
+        sig[i][63] ^= 1;
+        CHECK(secp256k1_schnorrsig_verify_batch_parallel(CTX, n_tasks, 1024 * 1024, test_batch_runner_reverse, &calls, sigs, msgs, msglens, pks, N_BATCH) == 0);
+        sig[i][63] ^= 1;
+        pks[i] = &pk[(i + 1) % N_BATCH];
+        CHECK(secp256k1_schnorrsig_verify_batch_parallel(CTX, n_tasks, 0, NULL, NULL, sigs, msgs, msglens, pks, N_BATCH) == 0);
+        pks[i] = &pk[i];
+    }
+
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(CTX, 4, 0, NULL, NULL, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(CTX, 4, 0, test_batch_runner_fail, NULL, sigs, msgs, msglens, pks, N_BATCH) == 0);
+}
+#undef N_BATCH
+
 static void test_schnorrsig_taproot(void) {
     unsigned char sk[32];
     secp256k1_keypair keypair;
@@ -977,6 +1096,8 @@ static const struct tf_test_entry tests_schnorrsig[] = {
     CASE1(test_schnorrsig_bip_vectors),
     CASE1(test_schnorrsig_sign),
     CASE1(test_schnorrsig_sign_verify),
+    CASE1(test_schnorrsig_verify_batch),
+    CASE1(test_schnorrsig_verify_batch_parallel),
     CASE1(test_schnorrsig_taproot),
 };
 
@@ -25,6 +25,7 @@
 #include "util.h"
 
 #include "field_impl.h"
+#include "field_lanes_impl.h"
 #include "scalar_impl.h"
 #include "group_impl.h"
 #include "ecmult_impl.h"
@@ -220,12 +221,12 @@ void secp256k1_context_set_error_callback(secp256k1_context* ctx, void (*fun)(co
     ctx->error_callback.data = data;
 }
 
-static secp256k1_scratch_space* secp256k1_scratch_space_create(const secp256k1_context* ctx, size_t max_size) {
+secp256k1_scratch_space* secp256k1_scratch_space_create(const secp256k1_context* ctx, size_t max_size) {
     VERIFY_CHECK(ctx != NULL);
     return secp256k1_scratch_create(&ctx->error_callback, max_size);
 }
 
-static void secp256k1_scratch_space_destroy(const secp256k1_context *ctx, secp256k1_scratch_space* scratch) {
+void secp256k1_scratch_space_destroy(const secp256k1_context *ctx, secp256k1_scratch_space* scratch) {
     VERIFY_CHECK(ctx != NULL);
     secp256k1_scratch_destroy(&ctx->error_callback, scratch);
 }
@@ -342,6 +343,92 @@ int secp256k1_ec_pubkey_sort(const secp256k1_context* ctx, const secp256k1_pubke
     return 1;
 }
 
+/* An entry of secp256k1_ec_pubkey_sort_scratch: the first 8 bytes of the
+ * compressed serialization as a big endian integer, and the key itself */
+typedef struct {
+    uint64_t prefix;
+    const secp256k1_pubkey *pk;
+} secp256k1_ec_pubkey_sort_entry;
+
+int secp256k1_ec_pubkey_sort_scratch(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, const secp256k1_pubkey **pubkeys, size_t n_pubkeys) {
+    secp256k1_ec_pubkey_sort_entry *a, *b, *tmp;
+    size_t checkpoint;
+    size_t i, j;
+    int byte;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(pubkeys != NULL);
+
+    if (n_pubkeys < 2) {
+        return 1;
+    }
+    if (scratch == NULL || n_pubkeys > SIZE_MAX / (2 * sizeof(*a))) {
+        return secp256k1_ec_pubkey_sort(ctx, pubkeys, n_pubkeys);
+    }
+    checkpoint = secp256k1_scratch_checkpoint(&ctx->error_callback, scratch);
+    a = (secp256k1_ec_pubkey_sort_entry *)secp256k1_scratch_alloc(&ctx->error_callback, scratch, n_pubkeys * sizeof(*a));
+    b = (secp256k1_ec_pubkey_sort_entry *)secp256k1_scratch_alloc(&ctx->error_callback, scratch, n_pubkeys * sizeof(*b));
+    if (a == NULL || b == NULL) {
+        secp256k1_scratch_apply_checkpoint(&ctx->error_callback, scratch, checkpoint);
+        return secp256k1_ec_pubkey_sort(ctx, pubkeys, n_pubkeys);
+    }
+
+    /* Serialize every key once. As in secp256k1_ec_pubkey_cmp, an invalid key
+     * sorts as all zeros. */
+    for (i = 0; i < n_pubkeys; i++) {
+        unsigned char out[33];
+        size_t out_size = sizeof(out);
+        if (!secp256k1_ec_pubkey_serialize(ctx, out, &out_size, pubkeys[i], SECP256K1_EC_COMPRESSED)) {
+            memset(out, 0, sizeof(out));
+        }
+        a[i].prefix = secp256k1_read_be64(out);
+        a[i].pk = pubkeys[i];
+    }
+
+    /* LSD radix sort on the prefixes, one byte per pass. Passes in which all
+     * entries share the same byte are skipped. */
+    for (byte = 0; byte < 8; byte++) {
+        size_t count[256] = {0};
+        size_t sum = 0;
+        int shift = 8 * byte;
+        for (i = 0; i < n_pubkeys; i++) {
+            count[(a[i].prefix >> shift) & 0xff]++;
+        }
+        if (count[(a[0].prefix >> shift) & 0xff] == n_pubkeys) {
+            continue;
+        }
+        for (j = 0; j < 256; j++) {
+            size_t c = count[j];
+            count[j] = sum;
+            sum += c;
+        }
+        for (i = 0; i < n_pubkeys; i++) {
+            b[count[(a[i].prefix >> shift) & 0xff]++] = a[i];
+        }
+        tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    /* Keys with equal prefixes are ordered by their full serializations. For
+     * distinct keys this is rare, so an insertion sort over each run is enough. */
+    for (i = 1; i < n_pubkeys; i++) {
+        secp256k1_ec_pubkey_sort_entry e = a[i];
+        j = i;
+        while (j > 0 && a[j-1].prefix == e.prefix && secp256k1_ec_pubkey_cmp(ctx, a[j-1].pk, e.pk) > 0) {
+            a[j] = a[j-1];
+            j--;
+        }
+        a[j] = e;
+    }
+
+    for (i = 0; i < n_pubkeys; i++) {
+        pubkeys[i] = a[i].pk;
+    }
+    secp256k1_scratch_apply_checkpoint(&ctx->error_callback, scratch, checkpoint);
+    return 1;
+}
+
 static void secp256k1_ecdsa_signature_load(const secp256k1_context* ctx, secp256k1_scalar* r, secp256k1_scalar* s, const secp256k1_ecdsa_signature* sig) {
     (void)ctx;
     if (sizeof(secp256k1_scalar) == 32) {
@@ -754,6 +841,54 @@ int secp256k1_context_randomize(secp256k1_context* ctx, const unsigned char *see
     return 1;
 }
 
+/* Combines of at least this many keys sum each chunk of EC_PUBKEY_COMBINE_CHUNK
+ * keys with a tree of batched affine additions; at every level of the tree all
+ * slopes share one field inversion. Smaller combines add the keys one at a time. */
+#define EC_PUBKEY_COMBINE_TREE_MIN 64
+#define EC_PUBKEY_COMBINE_CHUNK 128
+/* Tree levels stop once this few points are left, where an inversion no longer
+ * pays for itself */
+#define EC_PUBKEY_COMBINE_TREE_STOP 8
+
+static int secp256k1_ec_pubkey_combine_tree(const secp256k1_context* ctx, secp256k1_gej *r, const secp256k1_pubkey * const *pubnonces, size_t n) {
+    secp256k1_ge a[EC_PUBKEY_COMBINE_CHUNK], b[EC_PUBKEY_COMBINE_CHUNK / 2 + 1];
+    secp256k1_fe buf[EC_PUBKEY_COMBINE_CHUNK / 2];
+    size_t i, j;
+
+    secp256k1_gej_set_infinity(r);
+    for (i = 0; i < n; i += EC_PUBKEY_COMBINE_CHUNK) {
+        size_t m = n - i < EC_PUBKEY_COMBINE_CHUNK ? n - i : EC_PUBKEY_COMBINE_CHUNK;
+        secp256k1_ge *cur = a, *next = b, *tmp;
+
+        for (j = 0; j < m; j++) {
+            ARG_CHECK(pubnonces[i + j] != NULL);
+            if (!secp256k1_pubkey_load(ctx, &a[j], pubnonces[i + j])) {
+                return 0;
+            }
+        }
+        while (m > EC_PUBKEY_COMBINE_TREE_STOP) {
+            size_t k = m / 2, l = 0;
+            secp256k1_ge_add_pairs_var(next, cur, k, buf);
+            for (j = 0; j < k; j++) {
+                if (!next[j].infinity) {
+                    next[l++] = next[j];
+                }
+            }
+            if (m & 1) {
+                next[l++] = cur[m - 1];
+            }
+            m = l;
+            tmp = cur;
+            cur = next;
+            next = tmp;
+        }
+        for (j = 0; j < m; j++) {
+            secp256k1_gej_add_ge_var(r, r, &cur[j], NULL);
+        }
+    }
+    return 1;
+}
+
 int secp256k1_ec_pubkey_combine(const secp256k1_context* ctx, secp256k1_pubkey *pubnonce, const secp256k1_pubkey * const *pubnonces, size_t n) {
     size_t i;
     secp256k1_gej Qj;
@@ -767,10 +902,16 @@ int secp256k1_ec_pubkey_combine(const secp256k1_context* ctx, secp256k1_pubkey *
 
     secp256k1_gej_set_infinity(&Qj);
 
-    for (i = 0; i < n; i++) {
-        ARG_CHECK(pubnonces[i] != NULL);
-        secp256k1_pubkey_load(ctx, &Q, pubnonces[i]);
-        secp256k1_gej_add_ge(&Qj, &Qj, &Q);
+    if (n >= EC_PUBKEY_COMBINE_TREE_MIN) {
+        if (!secp256k1_ec_pubkey_combine_tree(ctx, &Qj, pubnonces, n)) {
+            return 0;
+        }
+    } else {
+        for (i = 0; i < n; i++) {
+            ARG_CHECK(pubnonces[i] != NULL);
+            secp256k1_pubkey_load(ctx, &Q, pubnonces[i]);
+            secp256k1_gej_add_ge(&Qj, &Qj, &Q);
+        }
     }
     if (secp256k1_gej_is_infinity(&Qj)) {
         return 0;
@@ -780,6 +921,63 @@ int secp256k1_ec_pubkey_combine(const secp256k1_context* ctx, secp256k1_pubkey *
     return 1;
 }
 
+typedef struct {
+    const secp256k1_context *ctx;
+    const secp256k1_pubkey * const *points;
+    const unsigned char * const *scalars;
+} secp256k1_ecmult_multi_data;
+
+static int secp256k1_ecmult_multi_cb(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    const secp256k1_ecmult_multi_data *data = (const secp256k1_ecmult_multi_data *)cbdata;
+    int overflow;
+
+    secp256k1_scalar_set_b32(sc, data->scalars[idx], &overflow);
+    if (overflow) {
+        return 0;
+    }
+    return secp256k1_pubkey_load(data->ctx, pt, data->points[idx]);
+}
+
+int secp256k1_ecmult_multi(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, secp256k1_pubkey *out, const secp256k1_pubkey * const *points, const unsigned char * const *scalars, size_t n, const unsigned char *g_scalar) {
+    secp256k1_ecmult_multi_data data;
+    secp256k1_scalar gs;
+    secp256k1_gej rj;
+    secp256k1_ge r;
+    size_t i;
+    int overflow;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(out != NULL);
+    memset(out, 0, sizeof(*out));
+    ARG_CHECK(n == 0 || points != NULL);
+    ARG_CHECK(n == 0 || scalars != NULL);
+    for (i = 0; i < n; i++) {
+        ARG_CHECK(points[i] != NULL);
+        ARG_CHECK(scalars[i] != NULL);
+    }
+
+    secp256k1_scalar_set_int(&gs, 0);
+    if (g_scalar != NULL) {
+        secp256k1_scalar_set_b32(&gs, g_scalar, &overflow);
+        if (overflow) {
+            return 0;
+        }
+    }
+
+    data.ctx = ctx;
+    data.points = points;
+    data.scalars = scalars;
+    if (!secp256k1_ecmult_multi_var(&ctx->error_callback, scratch, &rj, &gs, secp256k1_ecmult_multi_cb, (void *)&data, n)) {
+        return 0;
+    }
+    if (secp256k1_gej_is_infinity(&rj)) {
+        return 0;
+    }
+    secp256k1_ge_set_gej_var(&r, &rj);
+    secp256k1_pubkey_save(out, &r);
+    return 1;
+}
+
 int secp256k1_tagged_sha256(const secp256k1_context* ctx, unsigned char *hash32, const unsigned char *tag, size_t taglen, const unsigned char *msg, size_t msglen) {
     secp256k1_sha256 sha;
     VERIFY_CHECK(ctx != NULL);
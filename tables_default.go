@@ -0,0 +1,26 @@
+//go:build !p256k1small
+
+package p256k1
+
+import _ "embed"
+
+// Table profile of the default build; the p256k1small build tag selects the
+// compact tables of tables_small.go instead.
+const (
+	// windowG is the wNAF window of the generator in verification, as
+	// ECMULT_WINDOW_SIZE in src/ecmult.h. The odd multiples tables of G and
+	// 2^128*G hold ecmultTableSize(windowG) points each, 512 KiB together.
+	windowG = 14
+
+	// Default comb configuration, as in src/ecmult_gen.h: 11 blocks of 6
+	// teeth, with a 22 kB table
+	CombDefaultBlocks = 11
+	CombDefaultTeeth  = 6
+
+	// smallTables selects the comb for the variable-time generator
+	// multiplication in place of the 512 KiB byte points table
+	smallTables = false
+)
+
+//go:embed precomputed_tables.bin
+var precomputedTables string
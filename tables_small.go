@@ -0,0 +1,42 @@
+//go:build p256k1small
+
+package p256k1
+
+// Compact table profile, for WebAssembly and other memory-constrained
+// builds: build with -tags p256k1small. Verification uses a generator window
+// of 6 (ECMULT_WINDOW_SIZE=6), 2 KiB of tables instead of 512 KiB, and every
+// generator multiplication uses the comb with 2 blocks of 5 teeth
+// (COMB_BLOCKS=2, COMB_TEETH=5, ECMULT_GEN_KB=2 in src/ecmult_gen.h) instead
+// of the 512 KiB byte points table. No precomputed blob is embedded, which
+// takes 1 MiB off the binary; the compact tables are built on first use in
+// well under a millisecond.
+//
+// Sizes and timings on an Intel Xeon (amd64, go1.21) for the settings the
+// profile could use; the table sizes are the same on every platform:
+//
+//	windowG   tables    SchnorrVerify
+//	    4      512 B      42.0 µs
+//	    6      2 KiB      38.6 µs   p256k1small
+//	    8      8 KiB      37.6 µs
+//	   10     32 KiB      36.2 µs
+//	   14    512 KiB      34.4 µs   default
+//
+//	generator       table     ECPubkeyCreate
+//	comb 2/5         2 KiB      20.3 µs   p256k1small
+//	comb 11/6       22 KiB      18.0 µs   ContextConstantTime default
+//	comb 43/6       86 KiB      17.3 µs
+//	byte points    512 KiB       7.9 µs   default
+//
+// Other comb configurations can still be chosen per context with
+// ContextSetEcmultGenComb.
+const (
+	windowG = 6
+
+	CombDefaultBlocks = 2
+	CombDefaultTeeth  = 5
+
+	smallTables = true
+)
+
+// precomputedTables is empty, so the tables are computed
+var precomputedTables string
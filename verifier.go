@@ -0,0 +1,196 @@
+package p256k1
+
+import (
+	"runtime"
+	"sync"
+)
+
+// DefaultVerifierBatchSize is the number of jobs a Verifier worker gathers
+// into one batch verification when no batch size is given
+const DefaultVerifierBatchSize = 64
+
+// VerifyJob is one BIP-340 signature check submitted to a Verifier. ID is
+// not interpreted; it is returned with the result so callers can match
+// results to jobs.
+type VerifyJob struct {
+	ID     uint64
+	Sig    []byte
+	Msg    []byte
+	Pubkey *XOnlyPubkey
+}
+
+// VerifyResult is the outcome of a VerifyJob
+type VerifyResult struct {
+	ID    uint64
+	Valid bool
+}
+
+// Verifier verifies streams of Schnorr signatures on a fixed set of worker
+// goroutines. Each worker takes the jobs that are already queued, up to the
+// batch size, and checks them with a single SchnorrVerifyBatch call, falling
+// back to per-signature verification only when the batch fails. Under load
+// this amortizes the batch equation over many signatures, while a lone job is
+// verified as soon as a worker is free.
+//
+// Jobs are submitted with Submit and results are read from Results, in
+// completion order rather than submission order. Close must be called once
+// all jobs are submitted; Results is closed after the last result.
+type Verifier struct {
+	jobs      chan VerifyJob
+	results   chan VerifyResult
+	workers   int
+	batchSize int
+	wg        sync.WaitGroup
+}
+
+// NewVerifier starts a Verifier with the given number of workers and batch
+// size. workers <= 0 uses GOMAXPROCS and batchSize <= 0 uses
+// DefaultVerifierBatchSize.
+func NewVerifier(workers, batchSize int) *Verifier {
+	if workers <= 0 {
+		workers = runtime.GOMAXPROCS(0)
+	}
+	if batchSize <= 0 {
+		batchSize = DefaultVerifierBatchSize
+	}
+
+	v := &Verifier{
+		jobs:      make(chan VerifyJob, workers*batchSize),
+		results:   make(chan VerifyResult, workers*batchSize),
+		workers:   workers,
+		batchSize: batchSize,
+	}
+	v.wg.Add(workers)
+	for i := 0; i < workers; i++ {
+		go v.worker()
+	}
+	return v
+}
+
+// Submit queues a job. It blocks while the queue is full, so Results must be
+// drained concurrently. Submit must not be called after Close.
+func (v *Verifier) Submit(job VerifyJob) {
+	v.jobs <- job
+}
+
+// Results returns the channel on which the result of every submitted job is
+// delivered
+func (v *Verifier) Results() <-chan VerifyResult {
+	return v.results
+}
+
+// Close stops accepting jobs, waits for the queued ones to finish and then
+// closes Results
+func (v *Verifier) Close() {
+	close(v.jobs)
+	v.wg.Wait()
+	close(v.results)
+}
+
+// worker gathers queued jobs into batches until the job channel is closed
+func (v *Verifier) worker() {
+	defer v.wg.Done()
+
+	var s verifierScratch
+	batch := make([]VerifyJob, 0, v.batchSize)
+	valid := make([]bool, v.batchSize)
+
+	for job := range v.jobs {
+		batch = append(batch[:0], job)
+	fill:
+		for len(batch) < v.batchSize {
+			select {
+			case job, ok := <-v.jobs:
+				if !ok {
+					break fill
+				}
+				batch = append(batch, job)
+			default:
+				break fill
+			}
+		}
+
+		s.verify(batch, valid[:len(batch)])
+		for i := range batch {
+			v.results <- VerifyResult{ID: batch[i].ID, Valid: valid[i]}
+		}
+	}
+}
+
+// VerifyAll verifies jobs[i] into valid[i] for every i, sharding the slice
+// into batches across the Verifier's worker count. It does not use the job
+// queue and may be called concurrently with Submit. valid must be at least as
+// long as jobs.
+func (v *Verifier) VerifyAll(jobs []VerifyJob, valid []bool) {
+	n := len(jobs)
+	valid = valid[:n]
+
+	// Give every worker the same number of batches where possible
+	chunk := (n + v.workers - 1) / v.workers
+	if chunk > v.batchSize {
+		chunk = v.batchSize
+	}
+	if chunk == 0 {
+		return
+	}
+
+	var next int
+	var mu sync.Mutex
+	var wg sync.WaitGroup
+	for w := 0; w < v.workers && w*chunk < n; w++ {
+		wg.Add(1)
+		go func() {
+			defer wg.Done()
+			var s verifierScratch
+			for {
+				mu.Lock()
+				start := next
+				next += chunk
+				mu.Unlock()
+				if start >= n {
+					return
+				}
+				end := start + chunk
+				if end > n {
+					end = n
+				}
+				s.verify(jobs[start:end], valid[start:end])
+			}
+		}()
+	}
+	wg.Wait()
+}
+
+// verifierScratch holds a worker's reusable argument slices and batch
+// temporaries for SchnorrVerifyBatch
+type verifierScratch struct {
+	sigs    [][]byte
+	msgs    [][]byte
+	pubkeys []*XOnlyPubkey
+	scratch Scratch
+}
+
+// verify sets valid[i] to the result of jobs[i]
+func (s *verifierScratch) verify(jobs []VerifyJob, valid []bool) {
+	if len(jobs) == 1 {
+		valid[0] = SchnorrVerify(jobs[0].Sig, jobs[0].Msg, jobs[0].Pubkey)
+		return
+	}
+
+	s.sigs = s.sigs[:0]
+	s.msgs = s.msgs[:0]
+	s.pubkeys = s.pubkeys[:0]
+	for i := range jobs {
+		s.sigs = append(s.sigs, jobs[i].Sig)
+		s.msgs = append(s.msgs, jobs[i].Msg)
+		s.pubkeys = append(s.pubkeys, jobs[i].Pubkey)
+	}
+
+	_, failed := s.scratch.SchnorrVerifyBatch(s.sigs, s.msgs, s.pubkeys)
+	for i := range valid {
+		valid[i] = true
+	}
+	for _, i := range failed {
+		valid[i] = false
+	}
+}
@@ -0,0 +1,118 @@
+package p256k1
+
+import (
+	"fmt"
+	"runtime"
+	"testing"
+)
+
+// makeVerifyJobs returns n signed jobs where every job whose index is a
+// multiple of badEvery (if nonzero) has a corrupted signature
+func makeVerifyJobs(tb testing.TB, n, badEvery int) []VerifyJob {
+	sigs, msgs, pubkeys := makeSchnorrBatch(tb, n)
+	jobs := make([]VerifyJob, n)
+	for i := range jobs {
+		if badEvery != 0 && i%badEvery == 0 {
+			sigs[i][63] ^= 1
+		}
+		jobs[i] = VerifyJob{ID: uint64(i), Sig: sigs[i], Msg: msgs[i], Pubkey: pubkeys[i]}
+	}
+	return jobs
+}
+
+func TestVerifierStream(t *testing.T) {
+	jobs := makeVerifyJobs(t, 100, 7)
+
+	for _, cfg := range []struct{ workers, batch int }{{1, 1}, {1, 16}, {4, 8}, {0, 0}} {
+		v := NewVerifier(cfg.workers, cfg.batch)
+		go func() {
+			for _, job := range jobs {
+				v.Submit(job)
+			}
+			v.Close()
+		}()
+
+		seen := make([]bool, len(jobs))
+		for res := range v.Results() {
+			if seen[res.ID] {
+				t.Fatalf("workers=%d batch=%d: duplicate result for job %d", cfg.workers, cfg.batch, res.ID)
+			}
+			seen[res.ID] = true
+			if want := res.ID%7 != 0; res.Valid != want {
+				t.Errorf("workers=%d batch=%d: job %d valid = %v, want %v", cfg.workers, cfg.batch, res.ID, res.Valid, want)
+			}
+		}
+		for i, ok := range seen {
+			if !ok {
+				t.Fatalf("workers=%d batch=%d: no result for job %d", cfg.workers, cfg.batch, i)
+			}
+		}
+	}
+}
+
+func TestVerifierVerifyAll(t *testing.T) {
+	jobs := makeVerifyJobs(t, 50, 5)
+	jobs[3].Sig = jobs[3].Sig[:10]
+	jobs[4].Pubkey = nil
+
+	v := NewVerifier(3, 8)
+	defer v.Close()
+
+	valid := make([]bool, len(jobs))
+	v.VerifyAll(jobs, valid)
+	for i := range jobs {
+		want := i%5 != 0 && i != 3 && i != 4
+		if valid[i] != want {
+			t.Errorf("job %d valid = %v, want %v", i, valid[i], want)
+		}
+	}
+
+	v.VerifyAll(nil, nil)
+}
+
+// BenchmarkVerifier reports verification throughput per core, next to plain
+// SchnorrVerify on one goroutine as the per-core baseline
+func BenchmarkVerifier(b *testing.B) {
+	const n = 1024
+	jobs := makeVerifyJobs(b, n, 0)
+	valid := make([]bool, n)
+	procs := float64(runtime.GOMAXPROCS(0))
+
+	report := func(b *testing.B, cores float64) {
+		perSec := float64(b.N) * n / b.Elapsed().Seconds()
+		b.ReportMetric(perSec/cores, "verifs/s/core")
+	}
+
+	b.Run("SchnorrVerify", func(b *testing.B) {
+		for i := 0; i < b.N; i++ {
+			for j := range jobs {
+				valid[j] = SchnorrVerify(jobs[j].Sig, jobs[j].Msg, jobs[j].Pubkey)
+			}
+		}
+		report(b, 1)
+	})
+
+	for _, batch := range []int{1, 16, 64} {
+		v := NewVerifier(0, batch)
+		b.Run(fmt.Sprintf("VerifyAll/batch=%d", batch), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				v.VerifyAll(jobs, valid)
+			}
+			report(b, procs)
+		})
+		b.Run(fmt.Sprintf("stream/batch=%d", batch), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				go func() {
+					for _, job := range jobs {
+						v.Submit(job)
+					}
+				}()
+				for j := 0; j < n; j++ {
+					<-v.Results()
+				}
+			}
+			report(b, procs)
+		})
+		v.Close()
+	}
+}
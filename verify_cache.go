@@ -0,0 +1,229 @@
+package p256k1
+
+import (
+	"crypto/rand"
+	"encoding/binary"
+	"math/bits"
+)
+
+// verifyCacheShards is the number of independently locked shards of a
+// VerifyCache. It must be a power of two.
+const verifyCacheShards = 64
+
+// VerifyCache remembers BIP-340 signatures that verified, so a signature
+// seen again, such as a Nostr event relayed by many peers, is accepted
+// without the elliptic curve work. Only valid results are cached: an invalid
+// signature is verified every time, so it cannot push valid ones out.
+//
+// Each (signature, message, public key) is identified by its 128-bit
+// SipHash-2-4 under a random key drawn when the cache is made. The key is
+// secret, so matching a cached entry with different inputs would take about
+// 2^128 / Entries guesses, and the inputs cannot be chosen to collide or to
+// crowd one shard. The cache is bounded: each shard holds a fixed number of
+// entries and evicts with the CLOCK algorithm, as PubkeyCache.
+//
+// A VerifyCache is safe for concurrent use.
+type VerifyCache struct {
+	k0, k1 uint64
+	cache  clockCache[[2]uint64, struct{}]
+}
+
+// VerifyCacheStats reports the activity of a VerifyCache
+type VerifyCacheStats = CacheStats
+
+// NewVerifyCache returns a cache holding up to about capacity signatures;
+// the bound is rounded up to a multiple of the shard count.
+func NewVerifyCache(capacity int) *VerifyCache {
+	var seed [16]byte
+	if _, err := rand.Read(seed[:]); err != nil {
+		panic("p256k1: cannot seed verification cache: " + err.Error())
+	}
+	c := &VerifyCache{
+		k0: binary.LittleEndian.Uint64(seed[:8]),
+		k1: binary.LittleEndian.Uint64(seed[8:]),
+	}
+	c.cache.init(verifyCacheShards, capacity, nil)
+	return c
+}
+
+// key returns the cache key of a signature, which must be 64 bytes, of the
+// 32 byte msg32 by pk32
+func (c *VerifyCache) key(sig64, msg32 []byte, pk32 *[32]byte) [2]uint64 {
+	var in [128]byte
+	copy(in[:64], sig64)
+	copy(in[64:96], msg32)
+	copy(in[96:], pk32[:])
+	lo, hi := sipHash128(c.k0, c.k1, in[:])
+	return [2]uint64{lo, hi}
+}
+
+// lookup reports whether key is cached, counting a hit or a miss
+func (c *VerifyCache) lookup(key *[2]uint64) bool {
+	ok := c.cache.shard(key[0]).lookup(key, nil)
+	if ok {
+		metricsEvent(metricVerifyCacheHit)
+	} else {
+		metricsEvent(metricVerifyCacheMiss)
+	}
+	return ok
+}
+
+// add caches key as a valid signature
+func (c *VerifyCache) add(key *[2]uint64) {
+	c.cache.insert(c.cache.shard(key[0]), key, &struct{}{})
+}
+
+// Stats returns the hit and miss counts and the number of cached signatures
+func (c *VerifyCache) Stats() VerifyCacheStats {
+	return c.cache.stats()
+}
+
+// SchnorrVerify is SchnorrVerify answered from the cache when the signature
+// has verified before
+func (c *VerifyCache) SchnorrVerify(sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool {
+	return c.schnorrVerify(nil, sig64, msg32, xonlyPubkey)
+}
+
+// schnorrVerify is SchnorrVerify with the verification of a context, nil
+// for the package-level SchnorrVerify
+func (c *VerifyCache) schnorrVerify(ctx *Context, sig64 []byte, msg32 []byte, xonlyPubkey *XOnlyPubkey) bool {
+	if len(sig64) != 64 || len(msg32) != 32 || xonlyPubkey == nil {
+		return false
+	}
+	key := c.key(sig64, msg32, &xonlyPubkey.data)
+	if c.lookup(&key) {
+		return true
+	}
+
+	var ok bool
+	if ctx != nil {
+		ok = ctx.schnorrVerifyUncached(sig64, msg32, xonlyPubkey)
+	} else {
+		ok = SchnorrVerify(sig64, msg32, xonlyPubkey)
+	}
+	if ok {
+		c.add(&key)
+	}
+	return ok
+}
+
+// SchnorrVerifyBatch is SchnorrVerifyBatch checking with one batch only the
+// signatures that are not cached, and caching those that verify
+func (c *VerifyCache) SchnorrVerifyBatch(sigs [][]byte, msgs [][]byte, pubkeys []*XOnlyPubkey) (valid bool, failed []int) {
+	if len(pubkeys) != len(sigs) || len(msgs) != len(sigs) {
+		return false, nil
+	}
+	s := scratchPool.Get().(*Scratch)
+	defer scratchPool.Put(s)
+	return c.schnorrVerifyBatch(s, nil, sigs, msgs, pubkeys)
+}
+
+// schnorrVerifyBatch implements the batch APIs with the temporaries of s,
+// checking the misses through backend if it is not nil
+func (c *VerifyCache) schnorrVerifyBatch(s *Scratch, backend SchnorrBatchBackend, sigs [][]byte, msgs [][]byte, pubkeys []*XOnlyPubkey) (valid bool, failed []int) {
+	n := len(sigs)
+	if n == 0 {
+		return true, nil
+	}
+
+	cp := s.Checkpoint()
+	defer s.Rollback(cp)
+
+	// Gather the misses: idx[j] is the position in the batch of the j-th
+	// uncached signature. Malformed entries are passed on, so the batch
+	// rejects them.
+	idx := s.ints.alloc(n)[:0]
+	for i := 0; i < n; i++ {
+		if len(sigs[i]) == 64 && len(msgs[i]) == 32 && pubkeys[i] != nil {
+			key := c.key(sigs[i], msgs[i], &pubkeys[i].data)
+			if c.lookup(&key) {
+				continue
+			}
+		}
+		idx = append(idx, i)
+	}
+	if len(idx) == 0 {
+		return true, nil
+	}
+
+	missSigs := s.bytes.alloc(len(idx))
+	missMsgs := s.bytes.alloc(len(idx))
+	missPubkeys := s.xonly.alloc(len(idx))
+	for j, i := range idx {
+		missSigs[j], missMsgs[j], missPubkeys[j] = sigs[i], msgs[i], pubkeys[i]
+	}
+	valid, bad := schnorrVerifyBatchWith(s, backend, missSigs, missMsgs, missPubkeys)
+	if !valid && bad == nil {
+		return false, nil
+	}
+
+	// bad is ascending and idx is increasing, so failed is ascending too
+	b := 0
+	for j, i := range idx {
+		if b < len(bad) && bad[b] == j {
+			failed = append(failed, i)
+			b++
+			continue
+		}
+		key := c.key(sigs[i], msgs[i], &pubkeys[i].data)
+		c.add(&key)
+	}
+	return valid, failed
+}
+
+// sipHash128 returns the 128-bit SipHash-2-4 of m under the key (k0, k1) as
+// its little-endian low and high halves
+func sipHash128(k0, k1 uint64, m []byte) (lo, hi uint64) {
+	v0 := k0 ^ 0x736f6d6570736575
+	v1 := k1 ^ 0x646f72616e646f6d ^ 0xee
+	v2 := k0 ^ 0x6c7967656e657261
+	v3 := k1 ^ 0x7465646279746573
+
+	round := func() {
+		v0 += v1
+		v1 = bits.RotateLeft64(v1, 13)
+		v1 ^= v0
+		v0 = bits.RotateLeft64(v0, 32)
+		v2 += v3
+		v3 = bits.RotateLeft64(v3, 16)
+		v3 ^= v2
+		v0 += v3
+		v3 = bits.RotateLeft64(v3, 21)
+		v3 ^= v0
+		v2 += v1
+		v1 = bits.RotateLeft64(v1, 17)
+		v1 ^= v2
+		v2 = bits.RotateLeft64(v2, 32)
+	}
+
+	n := len(m)
+	for ; len(m) >= 8; m = m[8:] {
+		w := binary.LittleEndian.Uint64(m)
+		v3 ^= w
+		round()
+		round()
+		v0 ^= w
+	}
+	w := uint64(n) << 56
+	for i := range m {
+		w |= uint64(m[i]) << (8 * i)
+	}
+	v3 ^= w
+	round()
+	round()
+	v0 ^= w
+
+	v2 ^= 0xee
+	round()
+	round()
+	round()
+	round()
+	lo = v0 ^ v1 ^ v2 ^ v3
+	v1 ^= 0xdd
+	round()
+	round()
+	round()
+	round()
+	hi = v0 ^ v1 ^ v2 ^ v3
+	return lo, hi
+}
@@ -0,0 +1,211 @@
+package p256k1
+
+import (
+	"encoding/hex"
+	"sync"
+	"testing"
+)
+
+func TestSipHash128(t *testing.T) {
+	// Test vectors from the SipHash reference implementation, with the key
+	// 00 01 ... 0f and the messages 00 01 ... (n-1)
+	vectors := map[int]string{
+		0:  "a3817f04ba25a8e66df67214c7550293",
+		1:  "da87c1d86b99af44347659119b22fc45",
+		15: "5493e99933b0a8117e08ec0f97cfc3d9",
+		16: "6ee2a4ca67b054bbfd3315bf85230577",
+	}
+	k0, k1 := uint64(0x0706050403020100), uint64(0x0f0e0d0c0b0a0908)
+	var m [64]byte
+	for i := range m {
+		m[i] = byte(i)
+	}
+	for n, want := range vectors {
+		lo, hi := sipHash128(k0, k1, m[:n])
+		var got [16]byte
+		for i := 0; i < 8; i++ {
+			got[i] = byte(lo >> (8 * i))
+			got[8+i] = byte(hi >> (8 * i))
+		}
+		if hex.EncodeToString(got[:]) != want {
+			t.Errorf("length %d: got %x, want %s", n, got, want)
+		}
+	}
+}
+
+func TestVerifyCacheVerify(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 8)
+	c := NewVerifyCache(4096)
+
+	for round := 0; round < 3; round++ {
+		for i := range sigs {
+			if !c.SchnorrVerify(sigs[i], msgs[i], pubkeys[i]) {
+				t.Fatalf("round %d: valid signature %d rejected", round, i)
+			}
+			// Only the exact triple is cached
+			if c.SchnorrVerify(sigs[i], msgs[i], pubkeys[(i+1)%len(pubkeys)]) {
+				t.Fatalf("round %d: signature %d accepted under the wrong key", round, i)
+			}
+		}
+	}
+
+	st := c.Stats()
+	if st.Hits != 16 || st.Misses != 32 || st.Entries != 8 {
+		t.Errorf("stats = %+v, want 16 hits, 32 misses, 8 entries", st)
+	}
+	if r := st.HitRate(); r != 1.0/3 {
+		t.Errorf("hit rate = %v, want 1/3", r)
+	}
+
+	bad := append([]byte(nil), sigs[0]...)
+	bad[0] ^= 1
+	if c.SchnorrVerify(bad, msgs[0], pubkeys[0]) || c.SchnorrVerify(bad, msgs[0], pubkeys[0]) {
+		t.Error("corrupted signature accepted")
+	}
+	if c.SchnorrVerify(sigs[0][:63], msgs[0], pubkeys[0]) || c.SchnorrVerify(sigs[0], msgs[0], nil) {
+		t.Error("malformed input accepted")
+	}
+	if st := c.Stats(); st.Entries != 8 {
+		t.Errorf("invalid signatures were cached: %+v", st)
+	}
+}
+
+func TestVerifyCacheBatch(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 16)
+	c := NewVerifyCache(4096)
+
+	// Warm half of the batch
+	if valid, failed := c.SchnorrVerifyBatch(sigs[:8], msgs[:8], pubkeys[:8]); !valid || failed != nil {
+		t.Fatalf("valid batch rejected, failed = %v", failed)
+	}
+	if valid, failed := c.SchnorrVerifyBatch(sigs, msgs, pubkeys); !valid || failed != nil {
+		t.Fatalf("valid batch rejected, failed = %v", failed)
+	}
+	if st := c.Stats(); st.Hits != 8 || st.Entries != 16 {
+		t.Errorf("stats = %+v, want 8 hits and 16 entries", st)
+	}
+	if valid, failed := c.SchnorrVerifyBatch(sigs, msgs, pubkeys); !valid || failed != nil {
+		t.Fatalf("cached batch rejected, failed = %v", failed)
+	}
+
+	bad := append([]byte(nil), sigs[11]...)
+	bad[40] ^= 1
+	sigs = append(sigs, bad, sigs[0][:32])
+	msgs = append(msgs, msgs[11], msgs[0])
+	pubkeys = append(pubkeys, pubkeys[11], pubkeys[0])
+	valid, failed := c.SchnorrVerifyBatch(sigs, msgs, pubkeys)
+	if valid || len(failed) != 2 || failed[0] != 16 || failed[1] != 17 {
+		t.Errorf("valid = %v, failed = %v, want [16 17]", valid, failed)
+	}
+	if valid, _ := c.SchnorrVerifyBatch(sigs, msgs[:3], pubkeys); valid {
+		t.Error("batch with mismatched lengths accepted")
+	}
+
+	// With a warm scratch, a batch of misses does not allocate
+	if raceEnabled {
+		return
+	}
+	sigs, msgs, pubkeys = sigs[:16], msgs[:16], pubkeys[:16]
+	s := NewScratch()
+	c.schnorrVerifyBatch(s, nil, sigs, msgs, pubkeys)
+	if n := testing.AllocsPerRun(10, func() {
+		c.cache.clear()
+		c.schnorrVerifyBatch(s, nil, sigs, msgs, pubkeys)
+	}); n != 0 {
+		t.Errorf("warm batch of misses: %v allocs, want 0", n)
+	}
+}
+
+func TestVerifyCacheEviction(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 200)
+
+	c := NewVerifyCache(verifyCacheShards)
+	for round := 0; round < 2; round++ {
+		for i := range sigs {
+			if !c.SchnorrVerify(sigs[i], msgs[i], pubkeys[i]) {
+				t.Fatalf("round %d: signature %d rejected", round, i)
+			}
+		}
+	}
+	if st := c.Stats(); st.Entries > verifyCacheShards {
+		t.Errorf("cache holds %d entries, bound is %d", st.Entries, verifyCacheShards)
+	}
+}
+
+func TestVerifyCacheConcurrent(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 16)
+	c := NewVerifyCache(4096)
+
+	var wg sync.WaitGroup
+	for g := 0; g < 8; g++ {
+		wg.Add(1)
+		go func(g int) {
+			defer wg.Done()
+			for i := 0; i < 32; i++ {
+				j := (g + i) % len(sigs)
+				if !c.SchnorrVerify(sigs[j], msgs[j], pubkeys[j]) {
+					t.Errorf("signature %d rejected", j)
+					return
+				}
+			}
+		}(g)
+	}
+	wg.Wait()
+
+	if st := c.Stats(); st.Hits+st.Misses != 8*32 {
+		t.Errorf("stats = %+v, want %d lookups", st, 8*32)
+	}
+}
+
+func TestContextVerifyCache(t *testing.T) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(t, 8)
+	ctx := ContextCreate(ContextVerify)
+	defer ContextDestroy(ctx)
+	c := NewVerifyCache(4096)
+	if err := ContextSetVerifyCache(ctx, c); err != nil {
+		t.Fatal(err)
+	}
+
+	if valid, failed := ctx.SchnorrVerifyBatch(sigs, msgs, pubkeys); !valid || failed != nil {
+		t.Fatalf("context rejected a valid batch, failed = %v", failed)
+	}
+	clone := ContextClone(ctx)
+	for i := range sigs {
+		if !clone.SchnorrVerify(sigs[i], msgs[i], pubkeys[i]) {
+			t.Fatalf("context rejected valid signature %d", i)
+		}
+	}
+	if st := c.Stats(); st.Hits != 8 || st.Entries != 8 {
+		t.Errorf("stats = %+v, want 8 hits and 8 entries", st)
+	}
+	if err := ContextSetVerifyCache(ContextCreate(ContextSign), c); err == nil {
+		t.Error("signing-only context should not accept a verification cache")
+	}
+}
+
+func BenchmarkVerifyCache(b *testing.B) {
+	sigs, msgs, pubkeys := makeSchnorrBatch(b, 64)
+
+	b.Run("uncached", func(b *testing.B) {
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			SchnorrVerify(sigs[0], msgs[0], pubkeys[0])
+		}
+	})
+	b.Run("hit", func(b *testing.B) {
+		c := NewVerifyCache(1024)
+		c.SchnorrVerify(sigs[0], msgs[0], pubkeys[0])
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			c.SchnorrVerify(sigs[0], msgs[0], pubkeys[0])
+		}
+	})
+	b.Run("batch_hit", func(b *testing.B) {
+		c := NewVerifyCache(1024)
+		c.SchnorrVerifyBatch(sigs, msgs, pubkeys)
+		b.ReportAllocs()
+		for i := 0; i < b.N; i++ {
+			c.SchnorrVerifyBatch(sigs, msgs, pubkeys)
+		}
+	})
+}